@@ -0,0 +1,304 @@
+#ifndef FIXP_BENCH_HPP
+#define FIXP_BENCH_HPP
+
+#include <fixp/fixed_point.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fixp::bench {
+
+/**
+ * @brief Keeps a value alive so the compiler cannot drop the work behind it
+ */
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief A kernel's error against its reference, in units of the last place
+ */
+struct ErrorStats {
+    double max_ulp = 0;
+    double mean_ulp = 0;
+    double worst_input = 0; ///< An input with the error max_ulp
+    size_t samples = 0;
+};
+
+/**
+ * @brief One registered kernel
+ *
+ * body(n) runs the kernel n times. Each run is ops_per_run operations (the
+ * elements of an input block for scalar kernels, 1 for an FFT) covering
+ * samples_per_op samples each (N for an FFT, 1 for scalar kernels).
+ * Kernels with a reference also set accuracy, which sweeps their valid
+ * inputs; see sweep_inputs().
+ */
+struct Benchmark {
+    std::string name;
+    std::string format;
+    size_t ops_per_run = 1;
+    size_t samples_per_op = 1;
+    std::function<void(size_t)> body;
+    std::function<ErrorStats()> accuracy = {};
+};
+
+struct Result {
+    std::string name;
+    std::string format;
+    double ns_per_op = 0;
+    double ops_per_sec = 0;
+    double samples_per_sec = 0;
+    size_t runs = 0;
+    std::optional<ErrorStats> error = {};
+};
+
+class Registry {
+public:
+    void add(Benchmark b) { m_benchmarks.push_back(std::move(b)); }
+    const std::vector<Benchmark>& benchmarks() const { return m_benchmarks; }
+
+private:
+    std::vector<Benchmark> m_benchmarks;
+};
+
+/**
+ * @brief "Q15.16", "UQ16.16", with "/sat" for saturating formats
+ */
+template<typename FP>
+std::string format_name() {
+    std::string s = FP::is_signed ? "Q" : "UQ";
+    s += std::to_string(FP::integer_bits) + "." + std::to_string(FP::fractional_bits);
+    if (FP::overflow_policy == OverflowPolicy::Saturate) s += "/sat";
+    return s;
+}
+
+// Scalar kernels run over a block this long, so loads and stores are amortized
+// the same way for every format and the loop cannot be constant-folded
+inline constexpr size_t BLOCK = 1024;
+
+/**
+ * @brief Uniform random values in [lo, hi), the same sequence on every run
+ */
+template<typename FP>
+std::vector<FP> random_block(double lo, double hi, size_t n = BLOCK, uint64_t seed = 1) {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<FP> v(n);
+    for (auto& x : v) x = FP(dist(gen));
+    return v;
+}
+
+/**
+ * @brief Registers f(x) over a random block; one op is one element
+ */
+template<typename FP, typename F>
+void add_unary(Registry& r, std::string name, double lo, double hi, F f) {
+    r.add({std::move(name), format_name<FP>(), BLOCK, 1,
+           [in = random_block<FP>(lo, hi), f](size_t n) {
+               for (size_t run = 0; run < n; ++run) {
+                   for (const FP x : in) do_not_optimize(f(x));
+               }
+           }});
+}
+
+// Formats of up to this many bits are swept through every input
+inline constexpr int EXHAUSTIVE_BITS = 16;
+// Wider formats get about this many samples, half spread evenly over the
+// range and half over each binade of the raw value
+inline constexpr size_t DENSE_SAMPLES = size_t(1) << 18;
+
+/**
+ * @brief The inputs a kernel is defined on, [lo, hi] in the format's units;
+ *        the default is the whole format
+ */
+struct Domain {
+    double lo = -std::numeric_limits<double>::infinity();
+    double hi = std::numeric_limits<double>::infinity();
+};
+
+// Inputs from zero up
+inline constexpr Domain NON_NEGATIVE{0.0, std::numeric_limits<double>::infinity()};
+
+/**
+ * @brief The raw value of scaled, an integer in units of the LSB, clamped to the format
+ */
+template<typename FP>
+int64_t raw_clamped(double scaled) {
+    static_assert(FP::total_bits < 64 || (FP::total_bits == 64 && FP::is_signed));
+    const auto min_raw = static_cast<int64_t>(FP::min().raw());
+    const auto max_raw = static_cast<int64_t>(FP::max().raw());
+    // The range's ends are powers of two, exact in a double
+    if (!(scaled < std::ldexp(1.0, FP::total_bits - (FP::is_signed ? 1 : 0)))) return max_raw;
+    if (scaled <= static_cast<double>(min_raw)) return min_raw;
+    return static_cast<int64_t>(scaled);
+}
+
+// count values stratified over [first, last], one at random in each stratum
+inline void stratified(std::vector<int64_t>& v, int64_t first, int64_t last, size_t count,
+                       std::mt19937_64& gen) {
+    if (count == 0) return;
+    const uint64_t span = static_cast<uint64_t>(last) - static_cast<uint64_t>(first);
+    const uint64_t stratum = std::max<uint64_t>(span / count, 1);
+    std::uniform_int_distribution<uint64_t> dist(0, stratum - 1);
+    for (uint64_t offset = 0, i = 0; i < count && offset <= span; ++i, offset += stratum) {
+        const uint64_t pick = std::min(offset + dist(gen), span);
+        v.push_back(static_cast<int64_t>(static_cast<uint64_t>(first) + pick));
+    }
+}
+
+/**
+ * @brief The accuracy sweep's inputs in the domain d: all of them for formats
+ *        of up to EXHAUSTIVE_BITS, about DENSE_SAMPLES otherwise
+ *
+ * Wide formats are sampled both evenly over the domain and per binade of the
+ * raw value, so small magnitudes, where rsqrt, log2 and exp2 are hardest, get
+ * as many samples as large ones.
+ */
+template<typename FP>
+std::vector<FP> sweep_inputs(Domain d) {
+    using raw_type = typename FP::raw_type;
+    const int64_t first = raw_clamped<FP>(std::ceil(std::ldexp(d.lo, FP::fractional_bits)));
+    const int64_t last =
+        std::max(first, raw_clamped<FP>(std::floor(std::ldexp(d.hi, FP::fractional_bits))));
+    std::vector<int64_t> raws;
+    if constexpr (FP::total_bits <= EXHAUSTIVE_BITS) {
+        for (int64_t r = first; r <= last; ++r) raws.push_back(r);
+    } else {
+        std::mt19937_64 gen(4);
+        stratified(raws, first, last, DENSE_SAMPLES / 2, gen);
+        std::vector<std::pair<int64_t, int64_t>> binades;
+        for (int b = 0; b < FP::total_bits - 1; ++b) {
+            const int64_t lo = int64_t(1) << b;
+            const int64_t hi = static_cast<int64_t>((uint64_t(1) << (b + 1)) - 1);
+            for (auto [a, z] : {std::pair{lo, hi}, std::pair{-hi, -lo}}) {
+                a = std::max(a, first);
+                z = std::min(z, last);
+                if (a <= z) binades.emplace_back(a, z);
+            }
+        }
+        for (const auto& [a, z] : binades) {
+            stratified(raws, a, z, DENSE_SAMPLES / 2 / binades.size(), gen);
+        }
+        raws.push_back(first);
+        raws.push_back(last);
+        if (first <= 0 && last >= 0) raws.push_back(0);
+    }
+    std::vector<FP> v;
+    v.reserve(raws.size());
+    for (int64_t r : raws) v.push_back(FP::from_raw(static_cast<raw_type>(r)));
+    return v;
+}
+
+/**
+ * @brief |out[i] - ref(in[i])| in LSBs, with ref clamped to the format's range
+ *
+ * ref is called with double, or with long double for formats wider than a
+ * double's 53-bit mantissa, so the reference does not round away the error.
+ */
+template<typename FP, typename Ref>
+ErrorStats ulp_error(std::span<const FP> in, std::span<const FP> out, Ref ref) {
+    using Real = std::conditional_t<(FP::total_bits > 53), long double, double>;
+    const auto min_raw = static_cast<Real>(FP::min().raw());
+    const auto max_raw = static_cast<Real>(FP::max().raw());
+    ErrorStats e;
+    double sum = 0;
+    for (size_t i = 0; i < in.size(); ++i) {
+        const Real x = std::ldexp(static_cast<Real>(in[i].raw()), -FP::fractional_bits);
+        const Real y = static_cast<Real>(ref(x));
+        const Real expected = std::clamp(std::ldexp(y, FP::fractional_bits), min_raw, max_raw);
+        const auto err = static_cast<double>(std::abs(static_cast<Real>(out[i].raw()) - expected));
+        sum += err;
+        if (err > e.max_ulp) {
+            e.max_ulp = err;
+            e.worst_input = static_cast<double>(x);
+        }
+    }
+    e.samples = in.size();
+    e.mean_ulp = in.empty() ? 0 : sum / static_cast<double>(in.size());
+    return e;
+}
+
+/**
+ * @brief add_unary(), plus an accuracy sweep of f over its domain against ref
+ *
+ * The timing block stays in [lo, hi); the sweep covers all of valid.
+ */
+template<typename FP, typename F, typename Ref>
+void add_unary(Registry& r, std::string name, double lo, double hi, F f, Ref ref,
+               Domain valid = {}) {
+    r.add({std::move(name), format_name<FP>(), BLOCK, 1,
+           [in = random_block<FP>(lo, hi), f](size_t n) {
+               for (size_t run = 0; run < n; ++run) {
+                   for (const FP x : in) do_not_optimize(f(x));
+               }
+           },
+           [valid, f, ref] {
+               const auto in = sweep_inputs<FP>(valid);
+               std::vector<FP> out(in.size());
+               for (size_t i = 0; i < in.size(); ++i) out[i] = f(in[i]);
+               return ulp_error<FP>(in, out, ref);
+           }});
+}
+
+/**
+ * @brief Registers kernel(in, out) over a random block in [lo, hi) and sweeps
+ *        it over valid against ref; one op is one element
+ */
+template<typename FP, typename Kernel, typename Ref>
+void add_batch_unary(Registry& r, std::string name, double lo, double hi, Kernel kernel,
+                     Ref ref, Domain valid = {}) {
+    r.add({std::move(name), format_name<FP>(), BLOCK, 1,
+           [in = random_block<FP>(lo, hi), out = std::vector<FP>(BLOCK), kernel](size_t n) mutable {
+               for (size_t run = 0; run < n; ++run) {
+                   kernel(std::span<const FP>(in), std::span<FP>(out));
+                   do_not_optimize(out.data());
+               }
+           },
+           [valid, kernel, ref] {
+               const auto in = sweep_inputs<FP>(valid);
+               std::vector<FP> out(in.size());
+               kernel(std::span<const FP>(in), std::span<FP>(out));
+               return ulp_error<FP>(in, out, ref);
+           }});
+}
+
+/**
+ * @brief Registers f(a, b) over two random blocks; one op is one element pair
+ */
+template<typename FP, typename F>
+void add_binary(Registry& r, std::string name, double lo, double hi, F f) {
+    r.add({std::move(name), format_name<FP>(), BLOCK, 1,
+           [a = random_block<FP>(lo, hi, BLOCK, 1), b = random_block<FP>(lo, hi, BLOCK, 2),
+            f](size_t n) {
+               for (size_t run = 0; run < n; ++run) {
+                   for (size_t i = 0; i < BLOCK; ++i) do_not_optimize(f(a[i], b[i]));
+               }
+           }});
+}
+
+void register_arithmetic(Registry& r);
+void register_math(Registry& r);
+void register_dsp(Registry& r);
+void register_linalg(Registry& r);
+
+} // namespace fixp::bench
+
+#endif // FIXP_BENCH_HPP
@@ -0,0 +1,73 @@
+#include "bench.hpp"
+#include <fixp/batch.hpp>
+#include <fixp/divide.hpp>
+#include <span>
+
+namespace fixp::bench {
+
+namespace {
+
+template<typename FP>
+void scalar_ops(Registry& r) {
+    // Inputs stay well inside the range so wrap and saturate take the same path
+    add_binary<FP>(r, "add", -2.0, 2.0, [](FP a, FP b) { return a + b; });
+    add_binary<FP>(r, "sub", -2.0, 2.0, [](FP a, FP b) { return a - b; });
+    add_binary<FP>(r, "mul", -1.0, 1.0, [](FP a, FP b) { return a * b; });
+    add_binary<FP>(r, "div", 0.25, 1.0, [](FP a, FP b) { return a / b; });
+    add_unary<FP>(r, "div Divisor", -1.0, 1.0, [d = Divisor<FP>(FP(0.75))](FP x) { return x / d; });
+    add_unary<FP>(r, "divide_by<3>", -1.0, 1.0, [](FP x) { return divide_by<3>(x); });
+    add_unary<FP>(r, "reciprocal", 0.25, 1.0, [](FP x) { return reciprocal(x); });
+}
+
+// Element-wise batch kernels; one op is one output element
+template<typename FP, typename Kernel>
+void add_batch(Registry& reg, std::string name, Kernel kernel) {
+    reg.add({std::move(name), format_name<FP>(), BLOCK, 1,
+             [a = random_block<FP>(-1.0, 1.0, BLOCK, 1), b = random_block<FP>(-1.0, 1.0, BLOCK, 2),
+              out = std::vector<FP>(BLOCK), kernel](size_t n) mutable {
+                 for (size_t run = 0; run < n; ++run) {
+                     kernel(std::span<const FP>(a), std::span<const FP>(b), std::span<FP>(out));
+                     do_not_optimize(out.data());
+                 }
+             }});
+}
+
+template<typename FP>
+void batch_ops(Registry& r) {
+    add_batch<FP>(r, "batch::add", [](auto a, auto b, auto out) { batch::add(a, b, out); });
+    add_batch<FP>(r, "batch::mul", [](auto a, auto b, auto out) { batch::mul(a, b, out); });
+    add_batch<FP>(r, "batch::divide", [d = Divisor<FP>(FP(0.75))](auto a, auto, auto out) {
+        batch::divide(a, d, out);
+    });
+}
+
+// 128-bit storage has no Divisor or batch kernels, only the exact operators
+template<typename FP>
+void wide_ops(Registry& r) {
+    add_binary<FP>(r, "mul", -1.0, 1.0, [](FP a, FP b) { return a * b; });
+    add_binary<FP>(r, "div", 0.25, 1.0, [](FP a, FP b) { return a / b; });
+}
+
+template<typename FP>
+void both(Registry& r) {
+    scalar_ops<FP>(r);
+    batch_ops<FP>(r);
+}
+
+} // namespace
+
+void register_arithmetic(Registry& r) {
+    both<FixedPoint<16, 8>>(r);
+    both<FixedPoint<16, 8, true, OverflowPolicy::Saturate>>(r);
+    both<FixedPoint<32, 16>>(r);
+    both<FixedPoint<32, 16, true, OverflowPolicy::Saturate>>(r);
+    both<FixedPoint<32, 30>>(r);
+    both<FixedPoint<32, 30, true, OverflowPolicy::Saturate>>(r);
+    both<FixedPoint<32, 16, false>>(r);
+    both<FixedPoint<64, 32>>(r);
+#ifdef __SIZEOF_INT128__
+    wide_ops<FixedPoint<128, 32>>(r);
+#endif
+}
+
+} // namespace fixp::bench
@@ -0,0 +1,177 @@
+#include "bench.hpp"
+#include <fixp/dsp.hpp>
+#include <fixp/parallel.hpp>
+#include <memory>
+
+namespace fixp::bench {
+
+namespace {
+
+// A low-level signal so every transform and filter stays in range
+template<typename FP, size_t N>
+std::array<FP, N> signal() {
+    const auto v = random_block<FP>(-0.25, 0.25, N, 3);
+    std::array<FP, N> a{};
+    std::copy(v.begin(), v.end(), a.begin());
+    return a;
+}
+
+template<typename FP, size_t N>
+std::array<dsp::Complex<FP>, N> complex_signal() {
+    const auto re = signal<FP, N>();
+    std::array<dsp::Complex<FP>, N> a{};
+    for (size_t i = 0; i < N; ++i) a[i] = dsp::Complex<FP>(re[i], re[(i * 7) % N]);
+    return a;
+}
+
+// One op is one transform of N samples; the input is restored from a copy
+// before each run, which costs the same for every transform of that size
+template<typename FP, size_t N, typename Transform>
+void add_fft(Registry& r, std::string name, Transform transform) {
+    r.add({std::move(name) + " N=" + std::to_string(N), format_name<FP>(), 1, N,
+           [in = complex_signal<FP, N>(), transform](size_t n) {
+               auto data = in;
+               for (size_t run = 0; run < n; ++run) {
+                   data = in;
+                   transform(data);
+                   do_not_optimize(data.data());
+               }
+           }});
+}
+
+template<typename FP, size_t N>
+void ffts(Registry& r) {
+    add_fft<FP, N>(r, "fft_radix2", [](auto& d) { dsp::fft_radix2(d); });
+    add_fft<FP, N>(r, "FftPlan", [plan = dsp::FftPlan<FP, N>()](auto& d) {
+        plan.forward(std::span<dsp::Complex<FP>, N>(d));
+    });
+    if constexpr (FP::total_bits <= 32) {
+        add_fft<FP, N>(r, "Radix4FftPlan", [plan = dsp::Radix4FftPlan<FP, N>()](auto& d) {
+            do_not_optimize(plan.forward(std::span<dsp::Complex<FP>, N>(d)));
+        });
+    }
+    r.add({"rfft N=" + std::to_string(N), format_name<FP>(), 1, N,
+           [in = signal<FP, N>()](size_t n) {
+               std::array<dsp::Complex<FP>, N / 2 + 1> spectrum;
+               for (size_t run = 0; run < n; ++run) {
+                   dsp::rfft(in, spectrum);
+                   do_not_optimize(spectrum.data());
+               }
+           }});
+}
+
+// Filters process a block of BLOCK samples; one op is one sample
+template<typename FP, size_t Taps>
+void firs(Registry& r) {
+    const auto taps = signal<FP, Taps>();
+    r.add({"FirFilter taps=" + std::to_string(Taps), format_name<FP>(), BLOCK, 1,
+           [in = random_block<FP>(-0.5, 0.5), out = std::vector<FP>(BLOCK),
+            filter = dsp::FirFilter<FP, Taps>(taps)](size_t n) mutable {
+               for (size_t run = 0; run < n; ++run) {
+                   filter.process(in, out);
+                   do_not_optimize(out.data());
+               }
+           }});
+    r.add({"fir_filter taps=" + std::to_string(Taps), format_name<FP>(), BLOCK, 1,
+           [in = signal<FP, BLOCK>(), taps](size_t n) {
+               std::array<FP, BLOCK> out;
+               std::array<FP, Taps - 1> state{};
+               for (size_t run = 0; run < n; ++run) {
+                   dsp::fir_filter(in, out, taps, state);
+                   do_not_optimize(out.data());
+               }
+           }});
+}
+
+template<typename FP, size_t Sections, size_t Channels, dsp::BiquadForm Form>
+void biquads(Registry& r, const char* form) {
+    dsp::BiquadCascade<FP, Sections, Channels, Form> cascade;
+    // A gentle low-pass, stable in every section
+    const dsp::BiquadCoefficients<FP> c{FP(0.0675), FP(0.135), FP(0.0675), FP(-1.143),
+                                        FP(0.413)};
+    for (size_t s = 0; s < Sections; ++s) cascade.set_section(s, c);
+    r.add({"BiquadCascade " + std::string(form) + " " + std::to_string(Sections) + "x" +
+               std::to_string(Channels),
+           format_name<FP>(), BLOCK, 1,
+           [in = random_block<FP>(-0.5, 0.5), out = std::vector<FP>(BLOCK),
+            cascade](size_t n) mutable {
+               for (size_t run = 0; run < n; ++run) {
+                   cascade.process(in, out);
+                   do_not_optimize(out.data());
+               }
+           }});
+}
+
+// 256 channels per run on pools of one worker and of every hardware thread,
+// to show the scaling; one op is one frame or one channel block
+template<typename FP, size_t N>
+void parallel_batches(Registry& r) {
+    constexpr size_t Count = 256;
+    const auto frame = complex_signal<FP, N>();
+    std::vector<dsp::Complex<FP>> frames;
+    for (size_t i = 0; i < Count; ++i) frames.insert(frames.end(), frame.begin(), frame.end());
+    const auto taps = signal<FP, 64>();
+    std::vector<FP> block;
+    for (size_t i = 0; i < Count; ++i) {
+        const auto s = signal<FP, BLOCK>();
+        block.insert(block.end(), s.begin(), s.end());
+    }
+
+    std::vector<size_t> pools{1};
+    if (parallel::ThreadPool::default_workers() > 1) {
+        pools.push_back(parallel::ThreadPool::default_workers());
+    }
+    for (size_t workers : pools) {
+        const auto pool = std::make_shared<parallel::ThreadPool>(workers);
+        const std::string suffix = " threads=" + std::to_string(workers);
+        r.add({"parallel::fft " + std::to_string(Count) + "xN=" + std::to_string(N) + suffix,
+               format_name<FP>(), Count, N,
+               [pool, in = frames, plan = std::make_shared<dsp::FftPlan<FP, N>>()](size_t n) {
+                   auto data = in;
+                   for (size_t run = 0; run < n; ++run) {
+                       data = in;
+                       parallel::fft(*pool, *plan, std::span(data));
+                       do_not_optimize(data.data());
+                   }
+               }});
+        using Fir = dsp::FirFilter<FP, 64>;
+        r.add({"FilterBank " + std::to_string(Count) + "ch taps=64" + suffix, format_name<FP>(),
+               Count, BLOCK,
+               [pool, in = block, out = std::vector<FP>(block.size()),
+                bank = std::make_shared<parallel::FilterBank<Fir>>(Count, Fir(taps))](
+                   size_t n) mutable {
+                   for (size_t run = 0; run < n; ++run) {
+                       bank->process_interleaved(*pool, in, std::span(out));
+                       do_not_optimize(out.data());
+                   }
+               }});
+    }
+}
+
+} // namespace
+
+void register_dsp(Registry& r) {
+    using Q15_16 = FixedPoint<32, 16>;
+    using Q0_31 = FixedPoint<32, 31>;
+    using Q0_15 = FixedPoint<16, 15>;
+    using Q31_32 = FixedPoint<64, 32>;
+
+    ffts<Q15_16, 256>(r);
+    ffts<Q15_16, 1024>(r);
+    ffts<Q0_31, 1024>(r);
+    ffts<Q0_15, 1024>(r);
+    ffts<Q31_32, 1024>(r);
+
+    firs<Q15_16, 16>(r);
+    firs<Q15_16, 64>(r);
+    firs<Q0_15, 64>(r);
+    firs<Q0_31, 64>(r);
+
+    biquads<Q15_16, 4, 1, dsp::BiquadForm::DirectForm1>(r, "DF1");
+    biquads<Q15_16, 4, 1, dsp::BiquadForm::TransposedDirectForm2>(r, "DF2T");
+    biquads<Q15_16, 4, 8, dsp::BiquadForm::DirectForm1>(r, "DF1");
+
+    parallel_batches<Q15_16, 1024>(r);
+}
+
+} // namespace fixp::bench
@@ -0,0 +1,71 @@
+#include "bench.hpp"
+#include <fixp/linalg.hpp>
+
+namespace fixp::bench {
+
+namespace {
+
+// One op is one multiply-accumulate of an M x K by K x N product
+template<typename FP, size_t M, size_t K, size_t N>
+void gemms(Registry& r) {
+    r.add({"gemm " + std::to_string(M) + "x" + std::to_string(K) + "x" + std::to_string(N),
+           format_name<FP>(), M * K * N, 1,
+           [a = random_block<FP>(-0.5, 0.5, M * K, 1), b = random_block<FP>(-0.5, 0.5, K * N, 2),
+            c = std::vector<FP>(M * N)](size_t n) mutable {
+               for (size_t run = 0; run < n; ++run) {
+                   linalg::gemm(a, b, std::span(c), M, K, N);
+                   do_not_optimize(c.data());
+               }
+           }});
+}
+
+template<size_t M, size_t K, size_t N>
+void qgemms(Registry& r) {
+    std::vector<int8_t> x(M * K), w(K * N);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = static_cast<int8_t>(i * 37 % 255 - 127);
+    for (size_t i = 0; i < w.size(); ++i) w[i] = static_cast<int8_t>(i * 91 % 255 - 127);
+    r.add({"qgemm " + std::to_string(M) + "x" + std::to_string(K) + "x" + std::to_string(N),
+           "int8", M * K * N, 1,
+           [x, w = linalg::PackedMatrix::from_rows(w, K, N), y = std::vector<int8_t>(M * N),
+            q = linalg::Requantization::from_scale(1.0 / K)](size_t n) mutable {
+               for (size_t run = 0; run < n; ++run) {
+                   linalg::qgemm(x, M, w, {}, std::span(&q, 1), std::span(y));
+                   do_not_optimize(y.data());
+               }
+           }});
+}
+
+// One op is one vertex
+template<typename FP>
+void transforms(Registry& r) {
+    const auto coords = random_block<FP>(-100, 100, 4 * BLOCK, 3);
+    std::vector<linalg::Vec<FP, 4>> in(BLOCK);
+    for (size_t i = 0; i < BLOCK; ++i) std::copy_n(coords.data() + 4 * i, 4, in[i].data());
+    const auto m = linalg::translation(FP(3), FP(-2), FP(0.5)) *
+                   linalg::rotation_z(FP(0.3)) * linalg::scaling(FP(1.5), FP(1.5), FP(1));
+    r.add({"transform 4x4", format_name<FP>(), BLOCK, 1,
+           [in, m, out = std::vector<linalg::Vec<FP, 4>>(BLOCK)](size_t n) mutable {
+               for (size_t run = 0; run < n; ++run) {
+                   linalg::transform(m, in, std::span(out));
+                   do_not_optimize(out.data());
+               }
+           }});
+}
+
+} // namespace
+
+void register_linalg(Registry& r) {
+    using Q15_16 = FixedPoint<32, 16>;
+    using Q7_8 = FixedPoint<16, 8>;
+    using Q0_7 = FixedPoint<8, 7>;
+
+    qgemms<1, 1024, 1024>(r);
+    qgemms<64, 512, 512>(r);
+    gemms<Q0_7, 64, 512, 512>(r);
+    gemms<Q7_8, 64, 256, 256>(r);
+    gemms<Q15_16, 64, 256, 256>(r);
+
+    transforms<Q15_16>(r);
+}
+
+} // namespace fixp::bench
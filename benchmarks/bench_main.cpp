@@ -0,0 +1,193 @@
+#include "bench.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+using namespace fixp::bench;
+
+namespace {
+
+struct Options {
+    std::string filter;
+    bool json = false;
+    std::string json_path;  // empty for stdout
+    double min_time = 0.2;  // seconds per repetition
+    int repetitions = 3;
+    bool accuracy = true;
+    bool list = false;
+};
+
+void usage(const char* argv0) {
+    std::printf("Usage: %s [--filter=TEXT] [--min-time=SECONDS] [--repetitions=N]\n"
+                "          [--json[=FILE]] [--no-accuracy] [--list]\n\n"
+                "  --filter       run only benchmarks whose \"name format\" contains TEXT\n"
+                "  --min-time     minimum time per repetition (default 0.2 s)\n"
+                "  --repetitions  repetitions per benchmark; the fastest is reported (default 3)\n"
+                "  --json         write results as JSON to FILE, or stdout without one\n"
+                "  --no-accuracy  skip the ULP error sweeps of kernels with a reference\n"
+                "  --list         print the benchmark names and exit\n",
+                argv0);
+}
+
+bool parse(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto value = [&](std::string_view flag) {
+            return std::string(arg.substr(flag.size()));
+        };
+        if (arg.starts_with("--filter=")) {
+            o.filter = value("--filter=");
+        } else if (arg.starts_with("--min-time=")) {
+            o.min_time = std::atof(value("--min-time=").c_str());
+        } else if (arg.starts_with("--repetitions=")) {
+            o.repetitions = std::max(1, std::atoi(value("--repetitions=").c_str()));
+        } else if (arg == "--json") {
+            o.json = true;
+        } else if (arg.starts_with("--json=")) {
+            o.json = true;
+            o.json_path = value("--json=");
+        } else if (arg == "--no-accuracy") {
+            o.accuracy = false;
+        } else if (arg == "--list") {
+            o.list = true;
+        } else {
+            usage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Doubles the run count until one repetition takes min_time, then keeps the
+// fastest of the repetitions
+Result measure(const Benchmark& b, const Options& o) {
+    using clock = std::chrono::steady_clock;
+    const auto time = [&](size_t n) {
+        const auto start = clock::now();
+        b.body(n);
+        return std::chrono::duration<double>(clock::now() - start).count();
+    };
+    size_t n = 1;
+    double t = time(n);
+    while (t < o.min_time && n < (size_t(1) << 40)) {
+        const double scale = t > 0 ? std::min(10.0, 1.4 * o.min_time / t) : 10.0;
+        n = std::max(n + 1, static_cast<size_t>(static_cast<double>(n) * scale));
+        t = time(n);
+    }
+    for (int r = 1; r < o.repetitions; ++r) t = std::min(t, time(n));
+
+    const double ops = static_cast<double>(n) * static_cast<double>(b.ops_per_run);
+    Result res{b.name, b.format};
+    res.ns_per_op = t * 1e9 / ops;
+    res.ops_per_sec = ops / t;
+    res.samples_per_sec = res.ops_per_sec * static_cast<double>(b.samples_per_op);
+    res.runs = n;
+    return res;
+}
+
+std::string json_escape(const std::string& s) {
+    std::string out;
+    for (const char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void write_json(std::ostream& os, const std::vector<Result>& results, const Options& o) {
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    os << "{\n  \"context\": {\n"
+       << "    \"date\": \"" << date << "\",\n"
+#if defined(__clang__)
+       << "    \"compiler\": \"clang " << __clang_version__ << "\",\n"
+#elif defined(__GNUC__)
+       << "    \"compiler\": \"gcc " << __VERSION__ << "\",\n"
+#endif
+#if defined(NDEBUG)
+       << "    \"build\": \"release\",\n"
+#else
+       << "    \"build\": \"debug\",\n"
+#endif
+       << "    \"min_time\": " << o.min_time << ",\n"
+       << "    \"repetitions\": " << o.repetitions << "\n  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        os << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << json_escape(r.name)
+           << "\", \"format\": \"" << json_escape(r.format) << "\", \"ns_per_op\": " << r.ns_per_op
+           << ", \"ops_per_sec\": " << r.ops_per_sec
+           << ", \"samples_per_sec\": " << r.samples_per_sec << ", \"runs\": " << r.runs;
+        if (r.error) {
+            os << ", \"max_ulp\": " << r.error->max_ulp << ", \"mean_ulp\": " << r.error->mean_ulp
+               << ", \"worst_input\": " << r.error->worst_input
+               << ", \"error_samples\": " << r.error->samples;
+        }
+        os << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    if (!parse(argc, argv, o)) return 2;
+
+    Registry registry;
+    register_arithmetic(registry);
+    register_math(registry);
+    register_dsp(registry);
+    register_linalg(registry);
+
+    std::vector<const Benchmark*> selected;
+    for (const Benchmark& b : registry.benchmarks()) {
+        if ((b.name + " " + b.format).find(o.filter) != std::string::npos) selected.push_back(&b);
+    }
+    if (o.list) {
+        for (const Benchmark* b : selected) {
+            std::printf("%s %s\n", b->name.c_str(), b->format.c_str());
+        }
+        return 0;
+    }
+
+    // A table on stdout unless the JSON goes there
+    const bool table = !o.json || !o.json_path.empty();
+    if (table) {
+        std::printf("%-28s %-14s %12s %14s %16s %10s %10s\n", "benchmark", "format", "ns/op",
+                    "Mops/s", "Msamples/s", "max ulp", "mean ulp");
+    }
+    std::vector<Result> results;
+    for (const Benchmark* b : selected) {
+        results.push_back(measure(*b, o));
+        Result& r = results.back();
+        if (o.accuracy && b->accuracy) r.error = b->accuracy();
+        if (table) {
+            std::printf("%-28s %-14s %12.3f %14.2f %16.2f", r.name.c_str(), r.format.c_str(),
+                        r.ns_per_op, r.ops_per_sec / 1e6, r.samples_per_sec / 1e6);
+            if (r.error) {
+                std::printf(" %10.2f %10.3f\n", r.error->max_ulp, r.error->mean_ulp);
+            } else {
+                std::printf(" %10s %10s\n", "-", "-");
+            }
+            std::fflush(stdout);
+        }
+    }
+
+    if (o.json && o.json_path.empty()) {
+        write_json(std::cout, results, o);
+    } else if (o.json) {
+        std::ofstream file(o.json_path);
+        if (!file) {
+            std::fprintf(stderr, "cannot write %s\n", o.json_path.c_str());
+            return 1;
+        }
+        write_json(file, results, o);
+    }
+    return 0;
+}
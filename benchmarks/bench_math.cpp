@@ -0,0 +1,102 @@
+#include "bench.hpp"
+#include <fixp/math.hpp>
+#include <fixp/table.hpp>
+#include <cmath>
+
+namespace fixp::bench {
+
+namespace {
+
+// References take double, or long double for 64-bit formats
+const auto sqrt_ref = [](auto x) { return std::sqrt(x); };
+
+// Kernels are timed on a typical block and swept over every input they are
+// defined for; rsqrt(0) and log2(0) clamp like their references
+template<typename FP>
+void roots(Registry& r) {
+    add_unary<FP>(r, "sqrt", 0.0, 1.0, [](FP x) { return sqrt(x); }, sqrt_ref, NON_NEGATIVE);
+    add_unary<FP>(r, "sqrt_digits", 0.0, 1.0, [](FP x) { return sqrt_digits(x); }, sqrt_ref,
+                  NON_NEGATIVE);
+    add_unary<FP>(r, "rsqrt", 0.25, 1.0, [](FP x) { return rsqrt(x); },
+                  [](auto x) { return 1 / std::sqrt(x); }, NON_NEGATIVE);
+    add_binary<FP>(r, "hypot", -1.0, 1.0, [](FP a, FP b) { return hypot(a, b); });
+}
+
+template<typename FP>
+void trig(Registry& r) {
+    const auto ref = [](auto x) { return std::sin(x); };
+    add_unary<FP>(r, "sin (CORDIC)", -3.0, 3.0, [](FP x) { return sin(x); }, ref);
+    add_unary<FP>(r, "sincos (CORDIC)", -3.0, 3.0, [](FP x) { return sincos(x).sin; }, ref);
+    add_binary<FP>(r, "atan2 (CORDIC)", -1.0, 1.0, [](FP y, FP x) { return atan2(y, x); });
+    add_unary<FP>(r, "sin (table, Fast)", -3.0, 3.0,
+                  [](FP x) { return sin<Accuracy::Fast>(x); }, ref);
+    add_unary<FP>(r, "sin (table, Precise)", -3.0, 3.0,
+                  [](FP x) { return sin<Accuracy::Precise>(x); }, ref);
+}
+
+template<typename FP>
+void exponentials(Registry& r) {
+    const auto exp2_ref = [](auto x) { return std::exp2(x); };
+    const auto log2_ref = [](auto x) { return std::log2(x); };
+    add_unary<FP>(r, "exp2", -4.0, 4.0, [](FP x) { return exp2(x); }, exp2_ref);
+    add_unary<FP>(r, "exp2 (Fast)", -4.0, 4.0, [](FP x) { return exp2<Accuracy::Fast>(x); },
+                  exp2_ref);
+    add_batch_unary<FP>(r, "batch::exp2", -4.0, 4.0,
+                        [](auto in, auto out) { batch::exp2(in, out); }, exp2_ref);
+    add_unary<FP>(r, "log2", 0.01, 1.0, [](FP x) { return log2(x); }, log2_ref, NON_NEGATIVE);
+    add_unary<FP>(r, "log2 (Fast)", 0.01, 1.0, [](FP x) { return log2<Accuracy::Fast>(x); },
+                  log2_ref, NON_NEGATIVE);
+    add_batch_unary<FP>(r, "batch::log2", 0.01, 1.0,
+                        [](auto in, auto out) { batch::log2(in, out); }, log2_ref, NON_NEGATIVE);
+}
+
+// A tanh table per interpolation order, scalar and batched; one op is one element
+template<typename FP>
+void tables(Registry& r) {
+    using Linear = FunctionTable<FP, constexpr_math::tanh, 256, Interpolation::Linear, -4.0, 4.0>;
+    using Cubic = FunctionTable<FP, constexpr_math::tanh, 256, Interpolation::Cubic, -4.0, 4.0>;
+    const auto ref = [](auto x) { return std::tanh(x); };
+    // A table is defined on its own domain and clamps beyond it
+    const Domain domain{-4.0, 4.0};
+    add_unary<FP>(r, "tanh (table, Linear)", -4.0, 4.0, [](FP x) { return Linear::lookup(x); },
+                  ref, domain);
+    add_unary<FP>(r, "tanh (table, Cubic)", -4.0, 4.0, [](FP x) { return Cubic::lookup(x); },
+                  ref, domain);
+    add_batch_unary<FP>(r, "batch::tanh (table, Cubic)", -4.0, 4.0,
+                        [](auto in, auto out) { batch::lookup(in, Cubic{}, out); }, ref, domain);
+}
+
+} // namespace
+
+void register_math(Registry& r) {
+    using Q0_7 = FixedPoint<8, 7>;
+    using Q7_8 = FixedPoint<16, 8>;
+    using Q15_16 = FixedPoint<32, 16>;
+    using Q1_30 = FixedPoint<32, 30>;
+    using Q31_32 = FixedPoint<64, 32>;
+
+    add_unary<Q0_7>(r, "sqrt", 0.0, 1.0, [](Q0_7 x) { return sqrt(x); }, sqrt_ref,
+                    NON_NEGATIVE);
+    roots<Q7_8>(r);
+    roots<Q15_16>(r);
+    roots<Q1_30>(r);
+    roots<Q31_32>(r);
+
+    add_unary<Q0_7>(r, "sin (CORDIC)", -1.0, 1.0, [](Q0_7 x) { return sin(x); },
+                    [](auto x) { return std::sin(x); });
+    trig<Q15_16>(r);
+    trig<Q1_30>(r);
+    add_unary<Q31_32>(r, "sin (CORDIC)", -3.0, 3.0, [](Q31_32 x) { return sin(x); },
+                      [](auto x) { return std::sin(x); });
+    add_binary<Q31_32>(r, "atan2 (CORDIC)", -1.0, 1.0,
+                       [](Q31_32 y, Q31_32 x) { return atan2(y, x); });
+
+    exponentials<Q7_8>(r);
+    exponentials<Q15_16>(r);
+    exponentials<Q31_32>(r);
+
+    tables<Q7_8>(r);
+    tables<Q15_16>(r);
+}
+
+} // namespace fixp::bench
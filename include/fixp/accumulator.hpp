@@ -0,0 +1,134 @@
+#ifndef FIXP_ACCUMULATOR_HPP
+#define FIXP_ACCUMULATOR_HPP
+
+#include "fixed_point.hpp"
+#include "batch.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace fixp {
+
+/**
+ * @brief Multiply-accumulate with deferred rounding
+ *
+ * Keeps each raw product a.raw() * b.raw() at full precision (2F fractional
+ * bits) in a 64-bit accumulator for formats up to 32 bits and a 128-bit one
+ * above, and applies the >> F rounding and the overflow policy once, in
+ * result(). An N-term sum therefore costs one rounding shift instead of N and
+ * is exact up to that final rounding.
+ *
+ * The accumulator wraps modulo its width, so partial sums may overflow
+ * freely; only the final sum has to fit, i.e. |sum| < 2^(W - 1 - 2F) in value
+ * for a W-bit accumulator (2 for Q0.31, 2^31 for Q15.16). Span MACs on signed
+ * 16- and 32-bit formats run the SIMD dot kernels.
+ */
+template<FixedPointType FP>
+class Accumulator {
+public:
+    using value_type = FP;
+    using wide_type = storage_t<(FP::total_bits <= 32 ? 64 : 128), FP::is_signed>;
+
+    static constexpr int fractional_bits = 2 * FP::fractional_bits;
+
+    constexpr Accumulator() = default;
+
+    constexpr explicit Accumulator(FP init) { add(init); }
+
+    /**
+     * @brief Adds a * b without rounding
+     */
+    constexpr Accumulator& mac(FP a, FP b) {
+        m_bits += widen(a.raw()) * widen(b.raw());
+        return *this;
+    }
+
+    /**
+     * @brief Adds sum(a[i] * b[i]) without rounding; a and b must be the same length
+     */
+    constexpr Accumulator& mac(std::span<const FP> a, std::span<const FP> b) {
+        assert(a.size() == b.size());
+        const size_t n = a.size();
+        size_t i = 0;
+#if defined(FIXP_BATCH_HAS_SIMD)
+        if constexpr (batch::detail::simd_eligible<FP>) {
+            if !consteval {
+                int64_t lanes = 0;
+                i = batch::detail::kernels::dot(batch::detail::raw_ptr(a),
+                                                batch::detail::raw_ptr(b), n, &lanes);
+                m_bits += static_cast<bits_type>(lanes);
+            }
+        }
+#endif
+        // Pointer-bounded so GCC cannot assume the kernel's count is past n
+        for (const FP *pa = a.data() + i, *pb = b.data() + i, *end = a.data() + n; pa != end;
+             ++pa, ++pb) {
+            m_bits += widen(pa->raw()) * widen(pb->raw());
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Adds x, aligned to the product scale
+     */
+    constexpr Accumulator& add(FP x) {
+        m_bits += widen(x.raw()) << FP::fractional_bits;
+        return *this;
+    }
+
+    constexpr Accumulator& operator+=(const Accumulator& other) {
+        m_bits += other.m_bits;
+        return *this;
+    }
+
+    /**
+     * @brief Accumulated sum with 2F fractional bits
+     */
+    constexpr wide_type raw() const { return static_cast<wide_type>(m_bits); }
+
+    /**
+     * @brief Sum rounded to FP, wrapped, saturated or trapped per FP's policy
+     */
+    constexpr FP result() const {
+        using raw_type = typename FP::raw_type;
+        constexpr int F = FP::fractional_bits;
+        wide_type v = raw();
+        if constexpr (F > 0) {
+            v = static_cast<wide_type>(m_bits + (bits_type(1) << (F - 1))) >> F;
+        }
+        return FP::from_raw(overflow_cast<raw_type, FP::overflow_policy>(v, "Accumulator"));
+    }
+
+    constexpr void reset() { m_bits = 0; }
+
+private:
+    // Accumulate in the unsigned type so wrapping is well defined
+    using bits_type = storage_t<(FP::total_bits <= 32 ? 64 : 128), false>;
+
+    static constexpr bits_type widen(typename FP::raw_type v) {
+        return static_cast<bits_type>(static_cast<wide_type>(v));
+    }
+
+    bits_type m_bits = 0;
+};
+
+/**
+ * @brief sum(a[i] * b[i]) rounded once
+ *
+ * Takes any two contiguous ranges of the same FixedPoint type and length.
+ */
+template<std::ranges::contiguous_range A, std::ranges::contiguous_range B>
+    requires FixedPointType<std::ranges::range_value_t<A>> &&
+             std::is_same_v<std::ranges::range_value_t<A>, std::ranges::range_value_t<B>>
+constexpr auto dot(const A& a, const B& b) {
+    using FP = std::ranges::range_value_t<A>;
+    return Accumulator<FP>().mac(std::span<const FP>(a), std::span<const FP>(b)).result();
+}
+
+} // namespace fixp
+
+#endif // FIXP_ACCUMULATOR_HPP
@@ -0,0 +1,377 @@
+#ifndef FIXP_BATCH_HPP
+#define FIXP_BATCH_HPP
+
+#include "fixed_point.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace fixp {
+namespace batch {
+
+/**
+ * @brief Span-based batch arithmetic
+ *
+ * Each entry point applies the scalar FixedPoint operator element-wise and
+ * produces bit-identical results for the same OverflowPolicy. Signed 16- and
+ * 32-bit formats run on the widest SIMD kernel the compiler targets
+ * (AVX-512, AVX2, SSE4.1 or NEON); other formats and the tail of every span
+ * use the scalar operators directly.
+ *
+ * The element type is deduced from the output span; inputs convert from any
+ * contiguous container. Every input must hold at least out.size() elements,
+ * and inputs may alias the output. A Dynamic format's policy is read once per
+ * call, not per element.
+ */
+
+namespace detail {
+
+template<typename FP>
+inline constexpr bool simd_eligible =
+    FP::is_signed && FP::fractional_bits >= 1 &&
+    (std::is_same_v<typename FP::raw_type, int32_t> ||
+     std::is_same_v<typename FP::raw_type, int16_t>) &&
+    sizeof(FP) == sizeof(typename FP::raw_type) && std::is_standard_layout_v<FP>;
+
+// The kernels wrap or saturate; Undefined runs the wrapping ones. Trap, and
+// Saturate in builds with event counters, take the scalar loop, which checks
+// and counts element by element
+template<OverflowPolicy P>
+inline constexpr bool simd_policy =
+    P != OverflowPolicy::Trap && !(P == OverflowPolicy::Saturate && event_counters_enabled);
+
+template<OverflowPolicy P>
+inline constexpr bool saturates = P == OverflowPolicy::Saturate;
+
+// FixedPoint is standard-layout with the raw value as its only member, so an
+// array of FP can be handed to the kernels as an array of raw_type
+template<typename FP>
+const typename FP::raw_type* raw_ptr(std::span<const FP> s) {
+    return reinterpret_cast<const typename FP::raw_type*>(s.data());
+}
+
+template<typename FP>
+typename FP::raw_type* raw_ptr(std::span<FP> s) {
+    return reinterpret_cast<typename FP::raw_type*>(s.data());
+}
+
+// Compile-time selection of the widest kernel set the target supports
+#if defined(FIXP_SIMD_X86) && defined(__AVX512F__) && defined(__AVX512BW__)
+namespace kernels = ::fixp::simd::avx512;
+#define FIXP_BATCH_HAS_SIMD 1
+#elif defined(FIXP_SIMD_X86) && defined(__AVX2__)
+namespace kernels = ::fixp::simd::avx2;
+#define FIXP_BATCH_HAS_SIMD 1
+#elif defined(FIXP_SIMD_X86) && defined(__SSE4_1__)
+namespace kernels = ::fixp::simd::sse41;
+#define FIXP_BATCH_HAS_SIMD 1
+#elif defined(FIXP_SIMD_NEON)
+namespace kernels = ::fixp::simd::neon;
+#define FIXP_BATCH_HAS_SIMD 1
+#endif
+
+} // namespace detail
+
+template<typename FP>
+using input_span = std::span<const std::type_identity_t<FP>>;
+
+/**
+ * @brief Rounding of from_float and from_double
+ */
+enum class Rounding {
+    HalfEven,  // ties to even, as cvtps2dq and FCVTNS do natively
+    HalfAway   // ties away from zero, as the FixedPoint(float) constructor
+};
+
+namespace detail {
+
+template<typename Float>
+inline Float pow2(int e) {
+    return std::ldexp(Float(1), e);
+}
+
+// x * 2^F rounded, saturated to raw_type under either policy (a float outside
+// the format has no wrapped value) and NaN to zero, exactly as the kernels
+template<typename raw_type, typename Float>
+inline raw_type float_to_raw(Float x, Float scale, Rounding rounding) {
+    const Float scaled = x * scale;
+    if (scaled != scaled) return 0;
+    const Float v = rounding == Rounding::HalfEven ? std::nearbyint(scaled) : std::round(scaled);
+    const Float hi = pow2<Float>(std::numeric_limits<raw_type>::digits);
+    const bool below = std::is_signed_v<raw_type> ? v < -hi : v < 0;
+    if (v >= hi || below) {
+        count_event(FixedPointEvent::Saturation);
+        return v >= hi ? std::numeric_limits<raw_type>::max() : std::numeric_limits<raw_type>::min();
+    }
+    count_event(FixedPointEvent::PrecisionLoss, v != scaled);
+    return static_cast<raw_type>(v);
+}
+
+/**
+ * @brief The batch entry points over a kernel provider
+ *
+ * Kernels has static add, sub, mul, mul_add, scale, clamp, from_float and
+ * to_float with the fixp::simd signatures, or sets available to false to run
+ * the scalar loops only. fixp::batch binds the compile-time kernels and
+ * fixp::dispatch the run-time table, so both share one body per operation.
+ */
+template<class Kernels>
+struct batch_ops {
+    template<typename FP>
+    static constexpr bool vectorized = Kernels::available && simd_eligible<FP>;
+
+    template<FixedPointType FP>
+    static void add(input_span<FP> a, input_span<FP> b, std::span<FP> out) {
+        assert(a.size() >= out.size() && b.size() >= out.size());
+        resolve_policy<FP::overflow_policy>([&](auto policy) {
+            constexpr OverflowPolicy P = decltype(policy)::policy;
+            size_t i = 0;
+            if constexpr (vectorized<FP> && simd_policy<P>) {
+                i = Kernels::add(raw_ptr(a), raw_ptr(b), raw_ptr(out), out.size(), saturates<P>);
+            }
+            for (; i < out.size(); ++i) out[i] = FP::template add<P>(a[i], b[i]);
+        });
+    }
+
+    template<FixedPointType FP>
+    static void sub(input_span<FP> a, input_span<FP> b, std::span<FP> out) {
+        assert(a.size() >= out.size() && b.size() >= out.size());
+        resolve_policy<FP::overflow_policy>([&](auto policy) {
+            constexpr OverflowPolicy P = decltype(policy)::policy;
+            size_t i = 0;
+            if constexpr (vectorized<FP> && simd_policy<P>) {
+                i = Kernels::sub(raw_ptr(a), raw_ptr(b), raw_ptr(out), out.size(), saturates<P>);
+            }
+            for (; i < out.size(); ++i) out[i] = FP::template sub<P>(a[i], b[i]);
+        });
+    }
+
+    template<FixedPointType FP>
+    static void mul(input_span<FP> a, input_span<FP> b, std::span<FP> out) {
+        assert(a.size() >= out.size() && b.size() >= out.size());
+        resolve_policy<FP::overflow_policy>([&](auto policy) {
+            constexpr OverflowPolicy P = decltype(policy)::policy;
+            size_t i = 0;
+            if constexpr (vectorized<FP> && simd_policy<P>) {
+                i = Kernels::mul(raw_ptr(a), raw_ptr(b), raw_ptr(out), out.size(),
+                                 FP::fractional_bits, saturates<P>);
+            }
+            for (; i < out.size(); ++i) out[i] = FP::template mul<P>(a[i], b[i]);
+        });
+    }
+
+    template<FixedPointType FP>
+    static void mul_add(input_span<FP> a, input_span<FP> b, input_span<FP> c, std::span<FP> out) {
+        assert(a.size() >= out.size() && b.size() >= out.size() && c.size() >= out.size());
+        resolve_policy<FP::overflow_policy>([&](auto policy) {
+            constexpr OverflowPolicy P = decltype(policy)::policy;
+            size_t i = 0;
+            if constexpr (vectorized<FP> && simd_policy<P>) {
+                i = Kernels::mul_add(raw_ptr(a), raw_ptr(b), raw_ptr(c), raw_ptr(out),
+                                     out.size(), FP::fractional_bits, saturates<P>);
+            }
+            for (; i < out.size(); ++i) {
+                out[i] = FP::template add<P>(FP::template mul<P>(a[i], b[i]), c[i]);
+            }
+        });
+    }
+
+    template<FixedPointType FP>
+    static void scale(input_span<FP> a, FP s, std::span<FP> out) {
+        assert(a.size() >= out.size());
+        resolve_policy<FP::overflow_policy>([&](auto policy) {
+            constexpr OverflowPolicy P = decltype(policy)::policy;
+            size_t i = 0;
+            if constexpr (vectorized<FP> && simd_policy<P>) {
+                i = Kernels::scale(raw_ptr(a), s.raw(), raw_ptr(out), out.size(),
+                                   FP::fractional_bits, saturates<P>);
+            }
+            for (; i < out.size(); ++i) out[i] = FP::template mul<P>(a[i], s);
+        });
+    }
+
+    template<FixedPointType FP>
+    static void saturate(input_span<FP> a, std::span<FP> out, FP lo, FP hi) {
+        assert(a.size() >= out.size());
+        size_t i = 0;
+        if constexpr (vectorized<FP>) {
+            i = Kernels::clamp(raw_ptr(a), lo.raw(), hi.raw(), raw_ptr(out), out.size());
+        }
+        for (; i < out.size(); ++i) out[i] = std::min(std::max(a[i], lo), hi);
+    }
+
+    template<FixedPointType FP>
+    static void from_float(std::span<const float> in, std::span<FP> out, Rounding rounding) {
+        using raw_type = typename FP::raw_type;
+        assert(in.size() >= out.size());
+        size_t i = 0;
+        if constexpr (vectorized<FP> && !event_counters_enabled) {
+            i = Kernels::from_float(in.data(), raw_ptr(out), out.size(), FP::fractional_bits,
+                                    rounding == Rounding::HalfEven);
+        }
+        const float scale = pow2<float>(FP::fractional_bits);
+        for (; i < out.size(); ++i) {
+            out[i] = FP::from_raw(float_to_raw<raw_type>(in[i], scale, rounding));
+        }
+    }
+
+    template<FixedPointType FP>
+    static void to_float(std::span<const FP> in, std::span<float> out) {
+        assert(in.size() >= out.size());
+        size_t i = 0;
+        if constexpr (vectorized<FP> && !event_counters_enabled) {
+            i = Kernels::to_float(raw_ptr(in), out.data(), out.size(), FP::fractional_bits);
+        }
+        for (; i < out.size(); ++i) out[i] = static_cast<float>(in[i]);
+    }
+};
+
+// The kernels selected above, or none
+struct target_kernels {
+#if defined(FIXP_BATCH_HAS_SIMD)
+    static constexpr bool available = true;
+
+    template<typename... Args>
+    static size_t add(Args... args) { return kernels::add(args...); }
+    template<typename... Args>
+    static size_t sub(Args... args) { return kernels::sub(args...); }
+    template<typename... Args>
+    static size_t mul(Args... args) { return kernels::mul(args...); }
+    template<typename... Args>
+    static size_t mul_add(Args... args) { return kernels::mul_add(args...); }
+    template<typename... Args>
+    static size_t scale(Args... args) { return kernels::scale(args...); }
+    template<typename... Args>
+    static size_t clamp(Args... args) { return kernels::clamp(args...); }
+    template<typename... Args>
+    static size_t from_float(Args... args) { return kernels::from_float(args...); }
+    template<typename... Args>
+    static size_t to_float(Args... args) { return kernels::to_float(args...); }
+#else
+    static constexpr bool available = false;
+#endif
+};
+
+using ops = batch_ops<target_kernels>;
+
+} // namespace detail
+
+/**
+ * @brief out[i] = a[i] + b[i]
+ */
+template<FixedPointType FP>
+void add(input_span<FP> a, input_span<FP> b, std::span<FP> out) {
+    detail::ops::add<FP>(a, b, out);
+}
+
+/**
+ * @brief out[i] = a[i] - b[i]
+ */
+template<FixedPointType FP>
+void sub(input_span<FP> a, input_span<FP> b, std::span<FP> out) {
+    detail::ops::sub<FP>(a, b, out);
+}
+
+/**
+ * @brief out[i] = a[i] * b[i]
+ */
+template<FixedPointType FP>
+void mul(input_span<FP> a, input_span<FP> b, std::span<FP> out) {
+    detail::ops::mul<FP>(a, b, out);
+}
+
+/**
+ * @brief out[i] = a[i] * b[i] + c[i]
+ *
+ * The product is rounded back to FP before the addition, exactly as the
+ * scalar expression a * b + c.
+ */
+template<FixedPointType FP>
+void mul_add(input_span<FP> a, input_span<FP> b, input_span<FP> c, std::span<FP> out) {
+    detail::ops::mul_add<FP>(a, b, c, out);
+}
+
+/**
+ * @brief out[i] = a[i] * s
+ */
+template<FixedPointType FP>
+void scale(input_span<FP> a, std::type_identity_t<FP> s, std::span<FP> out) {
+    detail::ops::scale<FP>(a, s, out);
+}
+
+/**
+ * @brief out[i] = clamp(a[i], lo, hi)
+ *
+ * Saturates every element into [lo, hi]; the defaults clamp to the full
+ * range of FP, which is a copy.
+ */
+template<FixedPointType FP>
+void saturate(input_span<FP> a, std::span<FP> out,
+              std::type_identity_t<FP> lo = FP::min(), std::type_identity_t<FP> hi = FP::max()) {
+    detail::ops::saturate<FP>(a, out, lo, hi);
+}
+
+//-----------------------------------------------------------------------------
+// Floating-point conversion
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief out[i] = in[i] rounded to FP
+ *
+ * Out-of-range inputs saturate whatever FP's policy and NaN becomes zero.
+ * HalfEven assumes the default floating-point rounding mode. Signed 16- and
+ * 32-bit formats use the SIMD conversion instructions; the result is the
+ * same either way.
+ */
+template<FixedPointType FP>
+void from_float(std::span<const float> in, std::span<FP> out,
+                Rounding rounding = Rounding::HalfEven) {
+    detail::ops::from_float<FP>(in, out, rounding);
+}
+
+/**
+ * @brief out[i] = in[i] as float, rounded once to float's precision
+ *
+ * in is any contiguous range of a FixedPoint type, such as a vector or span.
+ */
+template<std::ranges::contiguous_range R>
+    requires FixedPointType<std::ranges::range_value_t<R>>
+void to_float(const R& range, std::span<float> out) {
+    using FP = std::ranges::range_value_t<R>;
+    detail::ops::to_float<FP>(std::span<const FP>(range), out);
+}
+
+/**
+ * @brief from_float for doubles; scalar, with the same saturation and rounding
+ */
+template<FixedPointType FP>
+void from_double(std::span<const double> in, std::span<FP> out,
+                 Rounding rounding = Rounding::HalfEven) {
+    using raw_type = typename FP::raw_type;
+    assert(in.size() >= out.size());
+    const double scale = detail::pow2<double>(FP::fractional_bits);
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = FP::from_raw(detail::float_to_raw<raw_type>(in[i], scale, rounding));
+    }
+}
+
+template<std::ranges::contiguous_range R>
+    requires FixedPointType<std::ranges::range_value_t<R>>
+void to_double(const R& range, std::span<double> out) {
+    using FP = std::ranges::range_value_t<R>;
+    const std::span<const FP> in(range);
+    assert(in.size() >= out.size());
+    for (size_t i = 0; i < out.size(); ++i) out[i] = static_cast<double>(in[i]);
+}
+
+} // namespace batch
+} // namespace fixp
+
+#endif // FIXP_BATCH_HPP
@@ -0,0 +1,250 @@
+#ifndef FIXP_CORDIC_HPP
+#define FIXP_CORDIC_HPP
+
+#include "fixed_point.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace fixp {
+
+namespace detail {
+    // 128-bit constants; everything else in the tables is derived from them at
+    // compile time. The table arithmetic runs at Q96 and is rounded once into
+    // the engine's working format.
+    constexpr uint128 u128(uint64_t hi, uint64_t lo) {
+        return (static_cast<uint128>(hi) << 64) | lo;
+    }
+
+    constexpr uint128 PI_Q126 = u128(0xC90FDAA22168C234ULL, 0xC4C6628B80DC1CD1ULL);
+    constexpr uint128 SQRT1_2_Q127 = u128(0x5A827999FCEF3242ULL, 0x2CBEC4D9BAA55F50ULL);
+    constexpr uint128 INV_TWO_PI_Q128 = u128(0x28BE60DB9391054AULL, 0x7F09D5F47D4D3770ULL);
+
+    constexpr int CORDIC_TABLE_BITS = 96;
+
+    // atan(2^-i) (or atanh when hyperbolic) in Q96 by the Taylor series; the
+    // terms 2^-i(2k+1) / (2k+1) are exact shifts and one integer division
+    constexpr int128 cordic_atan_q96(int i, bool hyperbolic) {
+        if (i == 0) return static_cast<int128>(PI_Q126 >> (126 - CORDIC_TABLE_BITS + 2));
+        int128 sum = 0;
+        for (int k = 0; i * (2 * k + 1) <= CORDIC_TABLE_BITS; ++k) {
+            const int128 term =
+                (int128(1) << (CORDIC_TABLE_BITS - i * (2 * k + 1))) / (2 * k + 1);
+            sum += (hyperbolic || k % 2 == 0) ? term : -term;
+        }
+        return sum;
+    }
+
+    // v * (1 + sign * 4^-i)^(inverse ? -1/2 : 1/2) by the binomial series
+    constexpr int128 cordic_gain_step(int128 v, int i, int sign, bool inverse) {
+        if (2 * i >= 127) return v;
+        const int128 unit = int128(1) << (2 * i);
+        int128 sum = v;
+        int128 term = v;
+        for (int k = 1; term != 0; ++k) {
+            term = term * (inverse ? 1 - 2 * k : 3 - 2 * k) / (2 * k) / unit;
+            if (sign < 0) term = -term;
+            sum += term;
+        }
+        return sum;
+    }
+
+    // Hyperbolic CORDIC only converges if iterations 4, 13, 40, ... run twice
+    constexpr bool cordic_repeats(int i) {
+        for (int r = 4; r <= i; r = 3 * r + 1) {
+            if (r == i) return true;
+        }
+        return false;
+    }
+
+    constexpr int cordic_hyperbolic_steps(int iterations) {
+        int steps = 0;
+        for (int i = 1; i <= iterations; ++i) steps += cordic_repeats(i) ? 2 : 1;
+        return steps;
+    }
+}
+
+/**
+ * @brief CORDIC engine for results with FracBits fractional bits
+ *
+ * Iterates at work_bits = FracBits + guard_bits fractional bits, with
+ * guard_bits growing with the iteration count so the per-step truncation
+ * stays below half an output LSB. The arctangent, hyperbolic arctangent and
+ * gain tables are generated at compile time for the exact iteration count, so
+ * any format from Q.1 to Q.62 gets full-precision tables instead of a Q16
+ * table truncated or padded with zeros.
+ *
+ * All values are raw work_type integers in Q(work_bits). rotate() and
+ * vector() are the circular modes (|z| and |atan(y/x)| up to about 1.74);
+ * rotate_hyperbolic() and vector_hyperbolic() are the hyperbolic modes
+ * (|z| and |atanh(y/x)| up to about 1.118). sincos() and sinhcosh() fold the
+ * gain into the initial vector, so they need no multiply at all.
+ */
+template<int FracBits>
+    requires (FracBits >= 1 && FracBits <= 62)
+struct Cordic {
+    static constexpr int fractional_bits = FracBits;
+    static constexpr int guard_bits = std::bit_width(static_cast<unsigned>(FracBits)) + 2;
+    static constexpr int work_bits = FracBits + guard_bits;
+    static constexpr int iterations = work_bits;
+    static constexpr int hyperbolic_iterations = detail::cordic_hyperbolic_steps(iterations);
+
+    // Magnitudes reach 2.33 in vectoring mode, so two integer bits plus sign
+    using work_type = storage_t<(work_bits <= 28 ? 32 : work_bits <= 60 ? 64 : 128), true>;
+
+    struct Vector {
+        work_type x;
+        work_type y;
+        work_type z;
+    };
+
+    using atan_array = std::array<work_type, static_cast<size_t>(iterations)>;
+    using atanh_array = std::array<work_type, static_cast<size_t>(hyperbolic_iterations)>;
+    using shift_array = std::array<int, static_cast<size_t>(hyperbolic_iterations)>;
+
+    static constexpr work_type from_q96(int128 v) {
+        constexpr int shift = detail::CORDIC_TABLE_BITS - work_bits;
+        return static_cast<work_type>((v + (int128(1) << (shift - 1))) >> shift);
+    }
+
+    static constexpr work_type one = work_type(1) << work_bits;
+
+    /// atan(2^-i) for i = 0 .. iterations - 1
+    static constexpr atan_array atan_table = [] {
+        atan_array t{};
+        for (int i = 0; i < iterations; ++i) {
+            t[static_cast<size_t>(i)] = from_q96(detail::cordic_atan_q96(i, false));
+        }
+        return t;
+    }();
+
+    /// Shift of each hyperbolic step: 1, 2, 3, 4, 4, 5, ..., 13, 13, ...
+    static constexpr shift_array hyperbolic_shifts = [] {
+        shift_array t{};
+        size_t n = 0;
+        for (int i = 1; i <= iterations; ++i) {
+            t[n++] = i;
+            if (detail::cordic_repeats(i)) t[n++] = i;
+        }
+        return t;
+    }();
+
+    /// atanh(2^-shift) for each hyperbolic step
+    static constexpr atanh_array atanh_table = [] {
+        atanh_array t{};
+        for (size_t n = 0; n < t.size(); ++n) {
+            t[n] = from_q96(detail::cordic_atan_q96(hyperbolic_shifts[n], true));
+        }
+        return t;
+    }();
+
+    /// Circular gain K = prod 1/sqrt(1 + 4^-i), about 0.60725
+    static constexpr work_type gain = [] {
+        int128 k = static_cast<int128>(
+            detail::SQRT1_2_Q127 >> (127 - detail::CORDIC_TABLE_BITS));
+        for (int i = 1; i < iterations; ++i) k = detail::cordic_gain_step(k, i, +1, true);
+        return from_q96(k);
+    }();
+
+    /// Hyperbolic gain prod sqrt(1 - 4^-shift), about 0.82816
+    static constexpr work_type hyperbolic_gain = [] {
+        int128 k = int128(1) << detail::CORDIC_TABLE_BITS;
+        for (int s : hyperbolic_shifts) k = detail::cordic_gain_step(k, s, -1, false);
+        return from_q96(k);
+    }();
+
+    /// 1 / hyperbolic_gain, about 1.20750
+    static constexpr work_type hyperbolic_gain_inverse = [] {
+        int128 k = int128(1) << detail::CORDIC_TABLE_BITS;
+        for (int s : hyperbolic_shifts) k = detail::cordic_gain_step(k, s, -1, true);
+        return from_q96(k);
+    }();
+
+    /**
+     * @brief Rotates (x, y) by z radians; the result is scaled by 1 / gain
+     */
+    static constexpr Vector rotate(work_type x, work_type y, work_type z) {
+        for (int i = 0; i < iterations; ++i) {
+            const work_type dx = y >> i;
+            const work_type dy = x >> i;
+            const work_type a = atan_table[static_cast<size_t>(i)];
+            const bool up = z >= 0;
+            x = up ? x - dx : x + dx;
+            y = up ? y + dy : y - dy;
+            z = up ? z - a : z + a;
+        }
+        return {x, y, z};
+    }
+
+    /**
+     * @brief {cos z, sin z, residual} for |z| <= ~1.74
+     */
+    static constexpr Vector sincos(work_type z) { return rotate(gain, 0, z); }
+
+    /**
+     * @brief Rotates (x, y) onto the positive x axis, x >= 0
+     *
+     * Returns {|(x, y)| / gain, ~0, z + atan(y / x)}.
+     */
+    static constexpr Vector vector(work_type x, work_type y, work_type z = 0) {
+        for (int i = 0; i < iterations; ++i) {
+            const work_type dx = y >> i;
+            const work_type dy = x >> i;
+            const work_type a = atan_table[static_cast<size_t>(i)];
+            const bool up = y < 0;
+            x = up ? x - dx : x + dx;
+            y = up ? y + dy : y - dy;
+            z = up ? z - a : z + a;
+        }
+        return {x, y, z};
+    }
+
+    /**
+     * @brief Hyperbolic rotation of (x, y) by z; the result is scaled by hyperbolic_gain
+     *
+     * The iterations shrink the vector, so sinhcosh() starts from
+     * hyperbolic_gain_inverse to come out unscaled.
+     */
+    static constexpr Vector rotate_hyperbolic(work_type x, work_type y, work_type z) {
+        for (size_t n = 0; n < hyperbolic_shifts.size(); ++n) {
+            const int s = hyperbolic_shifts[n];
+            const work_type dx = y >> s;
+            const work_type dy = x >> s;
+            const bool up = z >= 0;
+            x = up ? x + dx : x - dx;
+            y = up ? y + dy : y - dy;
+            z = up ? z - atanh_table[n] : z + atanh_table[n];
+        }
+        return {x, y, z};
+    }
+
+    /**
+     * @brief {cosh z, sinh z, residual} for |z| <= ~1.118
+     */
+    static constexpr Vector sinhcosh(work_type z) {
+        return rotate_hyperbolic(hyperbolic_gain_inverse, 0, z);
+    }
+
+    /**
+     * @brief Hyperbolic vectoring for x > |y|
+     *
+     * Returns {sqrt(x^2 - y^2) * hyperbolic_gain, ~0, z + atanh(y / x)}.
+     */
+    static constexpr Vector vector_hyperbolic(work_type x, work_type y, work_type z = 0) {
+        for (size_t n = 0; n < hyperbolic_shifts.size(); ++n) {
+            const int s = hyperbolic_shifts[n];
+            const work_type dx = y >> s;
+            const work_type dy = x >> s;
+            const bool up = y < 0;
+            x = up ? x + dx : x - dx;
+            y = up ? y + dy : y - dy;
+            z = up ? z - atanh_table[n] : z + atanh_table[n];
+        }
+        return {x, y, z};
+    }
+};
+
+} // namespace fixp
+
+#endif // FIXP_CORDIC_HPP
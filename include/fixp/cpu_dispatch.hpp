@@ -0,0 +1,266 @@
+#ifndef FIXP_CPU_DISPATCH_HPP
+#define FIXP_CPU_DISPATCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace fixp {
+
+namespace simd {
+struct TableSpec;
+}
+
+namespace dispatch {
+
+/**
+ * @brief Instruction sets the kernel table can be bound to
+ */
+enum class Isa {
+    Scalar,
+    SSE41,
+    AVX2,
+    AVX512,
+    NEON
+};
+
+/**
+ * @brief Printable name of an ISA ("scalar", "sse4.1", "avx2", "avx512", "neon")
+ */
+const char* isa_name(Isa isa);
+
+/**
+ * @brief Parses an ISA name as accepted by the LIBFIXP_ISA environment variable
+ */
+std::optional<Isa> parse_isa(std::string_view name);
+
+/**
+ * @brief Best ISA supported by this CPU and OS (probed once)
+ */
+Isa detected_isa();
+
+/**
+ * @brief ISA the kernel table is currently bound to
+ */
+Isa active_isa();
+
+/**
+ * @brief Rebinds every kernel to the given ISA
+ *
+ * Intended for benchmarking and reproducing issues; prefer calling it before
+ * worker threads start. Returns false, leaving the binding unchanged, if the
+ * CPU does not support the requested ISA.
+ */
+bool force_isa(Isa isa);
+
+/**
+ * @brief Restores the binding chosen at startup (LIBFIXP_ISA or detected)
+ */
+void reset_isa();
+
+/**
+ * @brief Function-pointer table for the raw SIMD kernels
+ *
+ * Every entry starts out pointing at a resolver that probes the CPU once,
+ * binds the whole table and forwards the call. After that each call is a
+ * single indirect call with no feature check. Kernels follow the fixp::simd
+ * contract: they process whole vectors only and return the number of
+ * elements consumed.
+ *
+ * The table holds the batch arithmetic and conversions, the dot products
+ * behind Accumulator::mac, the biquad section steps, the 4x4 transform and
+ * the FunctionTable lookup. The lookup gathers, so only AVX2 and AVX-512 bind
+ * a kernel for it and the other ISAs consume nothing. The int8 GEMM tiles
+ * are not in the table: they pack their operands per ISA, so the packing and
+ * the kernel are chosen together at compile time.
+ */
+struct KernelTable {
+    using add_i32_fn = size_t (*)(const int32_t*, const int32_t*, int32_t*, size_t, bool);
+    using mul_i32_fn = size_t (*)(const int32_t*, const int32_t*, int32_t*, size_t, int, bool);
+    using mul_add_i32_fn = size_t (*)(const int32_t*, const int32_t*, const int32_t*, int32_t*,
+                                      size_t, int, bool);
+    using scale_i32_fn = size_t (*)(const int32_t*, int32_t, int32_t*, size_t, int, bool);
+    using clamp_i32_fn = size_t (*)(const int32_t*, int32_t, int32_t, int32_t*, size_t);
+
+    using add_i16_fn = size_t (*)(const int16_t*, const int16_t*, int16_t*, size_t, bool);
+    using mul_i16_fn = size_t (*)(const int16_t*, const int16_t*, int16_t*, size_t, int, bool);
+    using mul_add_i16_fn = size_t (*)(const int16_t*, const int16_t*, const int16_t*, int16_t*,
+                                      size_t, int, bool);
+    using scale_i16_fn = size_t (*)(const int16_t*, int16_t, int16_t*, size_t, int, bool);
+    using clamp_i16_fn = size_t (*)(const int16_t*, int16_t, int16_t, int16_t*, size_t);
+
+    using from_float_i32_fn = size_t (*)(const float*, int32_t*, size_t, int, bool);
+    using from_float_i16_fn = size_t (*)(const float*, int16_t*, size_t, int, bool);
+    using to_float_i32_fn = size_t (*)(const int32_t*, float*, size_t, int);
+    using to_float_i16_fn = size_t (*)(const int16_t*, float*, size_t, int);
+
+    using dot_i32_fn = size_t (*)(const int32_t*, const int32_t*, size_t, int64_t*);
+    using dot_i16_fn = size_t (*)(const int16_t*, const int16_t*, size_t, int64_t*);
+    using biquad_df1_fn = size_t (*)(const int32_t*, int32_t*, int32_t*, size_t, int, bool);
+    using biquad_tdf2_fn = size_t (*)(const int32_t*, int64_t*, int32_t*, size_t, int, bool);
+    using transform4x4_fn = size_t (*)(const int32_t*, const int32_t*, int32_t*, size_t, int,
+                                       bool);
+    using table_lookup_i32_fn = size_t (*)(const int32_t*, int32_t*, size_t,
+                                           const simd::TableSpec&);
+    using table_lookup_i16_fn = size_t (*)(const int16_t*, int16_t*, size_t,
+                                           const simd::TableSpec&);
+
+    std::atomic<add_i32_fn> add_i32;
+    std::atomic<add_i32_fn> sub_i32;
+    std::atomic<mul_i32_fn> mul_i32;
+    std::atomic<mul_add_i32_fn> mul_add_i32;
+    std::atomic<scale_i32_fn> scale_i32;
+    std::atomic<clamp_i32_fn> clamp_i32;
+
+    std::atomic<add_i16_fn> add_i16;
+    std::atomic<add_i16_fn> sub_i16;
+    std::atomic<mul_i16_fn> mul_i16;
+    std::atomic<mul_add_i16_fn> mul_add_i16;
+    std::atomic<scale_i16_fn> scale_i16;
+    std::atomic<clamp_i16_fn> clamp_i16;
+
+    std::atomic<from_float_i32_fn> from_float_i32;
+    std::atomic<from_float_i16_fn> from_float_i16;
+    std::atomic<to_float_i32_fn> to_float_i32;
+    std::atomic<to_float_i16_fn> to_float_i16;
+
+    std::atomic<dot_i32_fn> dot_i32;
+    std::atomic<dot_i16_fn> dot_i16;
+    std::atomic<biquad_df1_fn> biquad_df1;
+    std::atomic<biquad_tdf2_fn> biquad_tdf2;
+    std::atomic<transform4x4_fn> transform4x4;
+    std::atomic<table_lookup_i32_fn> table_lookup_i32;
+    std::atomic<table_lookup_i16_fn> table_lookup_i16;
+};
+
+namespace detail {
+extern KernelTable table;
+}
+
+//
+// Raw-lane entry points through the bound table
+//
+namespace raw {
+
+inline size_t add(const int32_t* a, const int32_t* b, int32_t* out, size_t n, bool saturate) {
+    return detail::table.add_i32.load(std::memory_order_relaxed)(a, b, out, n, saturate);
+}
+
+inline size_t sub(const int32_t* a, const int32_t* b, int32_t* out, size_t n, bool saturate) {
+    return detail::table.sub_i32.load(std::memory_order_relaxed)(a, b, out, n, saturate);
+}
+
+inline size_t mul(const int32_t* a, const int32_t* b, int32_t* out, size_t n,
+                  int frac_bits, bool saturate) {
+    return detail::table.mul_i32.load(std::memory_order_relaxed)(a, b, out, n, frac_bits,
+                                                                 saturate);
+}
+
+inline size_t mul_add(const int32_t* a, const int32_t* b, const int32_t* c, int32_t* out,
+                      size_t n, int frac_bits, bool saturate) {
+    return detail::table.mul_add_i32.load(std::memory_order_relaxed)(a, b, c, out, n, frac_bits,
+                                                                     saturate);
+}
+
+inline size_t scale(const int32_t* a, int32_t s, int32_t* out, size_t n,
+                    int frac_bits, bool saturate) {
+    return detail::table.scale_i32.load(std::memory_order_relaxed)(a, s, out, n, frac_bits,
+                                                                   saturate);
+}
+
+inline size_t clamp(const int32_t* a, int32_t lo, int32_t hi, int32_t* out, size_t n) {
+    return detail::table.clamp_i32.load(std::memory_order_relaxed)(a, lo, hi, out, n);
+}
+
+inline size_t add(const int16_t* a, const int16_t* b, int16_t* out, size_t n, bool saturate) {
+    return detail::table.add_i16.load(std::memory_order_relaxed)(a, b, out, n, saturate);
+}
+
+inline size_t sub(const int16_t* a, const int16_t* b, int16_t* out, size_t n, bool saturate) {
+    return detail::table.sub_i16.load(std::memory_order_relaxed)(a, b, out, n, saturate);
+}
+
+inline size_t mul(const int16_t* a, const int16_t* b, int16_t* out, size_t n,
+                  int frac_bits, bool saturate) {
+    return detail::table.mul_i16.load(std::memory_order_relaxed)(a, b, out, n, frac_bits,
+                                                                 saturate);
+}
+
+inline size_t mul_add(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out,
+                      size_t n, int frac_bits, bool saturate) {
+    return detail::table.mul_add_i16.load(std::memory_order_relaxed)(a, b, c, out, n, frac_bits,
+                                                                     saturate);
+}
+
+inline size_t scale(const int16_t* a, int16_t s, int16_t* out, size_t n,
+                    int frac_bits, bool saturate) {
+    return detail::table.scale_i16.load(std::memory_order_relaxed)(a, s, out, n, frac_bits,
+                                                                   saturate);
+}
+
+inline size_t clamp(const int16_t* a, int16_t lo, int16_t hi, int16_t* out, size_t n) {
+    return detail::table.clamp_i16.load(std::memory_order_relaxed)(a, lo, hi, out, n);
+}
+
+inline size_t from_float(const float* in, int32_t* out, size_t n, int frac_bits, bool half_even) {
+    return detail::table.from_float_i32.load(std::memory_order_relaxed)(in, out, n, frac_bits,
+                                                                        half_even);
+}
+
+inline size_t from_float(const float* in, int16_t* out, size_t n, int frac_bits, bool half_even) {
+    return detail::table.from_float_i16.load(std::memory_order_relaxed)(in, out, n, frac_bits,
+                                                                        half_even);
+}
+
+inline size_t to_float(const int32_t* in, float* out, size_t n, int frac_bits) {
+    return detail::table.to_float_i32.load(std::memory_order_relaxed)(in, out, n, frac_bits);
+}
+
+inline size_t to_float(const int16_t* in, float* out, size_t n, int frac_bits) {
+    return detail::table.to_float_i16.load(std::memory_order_relaxed)(in, out, n, frac_bits);
+}
+
+inline size_t dot(const int32_t* a, const int32_t* b, size_t n, int64_t* acc) {
+    return detail::table.dot_i32.load(std::memory_order_relaxed)(a, b, n, acc);
+}
+
+inline size_t dot(const int16_t* a, const int16_t* b, size_t n, int64_t* acc) {
+    return detail::table.dot_i16.load(std::memory_order_relaxed)(a, b, n, acc);
+}
+
+inline size_t biquad_df1(const int32_t* c, int32_t* s, int32_t* x, size_t n,
+                         int frac_bits, bool saturate) {
+    return detail::table.biquad_df1.load(std::memory_order_relaxed)(c, s, x, n, frac_bits,
+                                                                    saturate);
+}
+
+inline size_t biquad_tdf2(const int32_t* c, int64_t* s, int32_t* x, size_t n,
+                          int frac_bits, bool saturate) {
+    return detail::table.biquad_tdf2.load(std::memory_order_relaxed)(c, s, x, n, frac_bits,
+                                                                     saturate);
+}
+
+inline size_t transform4x4(const int32_t* m, const int32_t* in, int32_t* out, size_t n,
+                           int frac_bits, bool saturate) {
+    return detail::table.transform4x4.load(std::memory_order_relaxed)(m, in, out, n, frac_bits,
+                                                                      saturate);
+}
+
+inline size_t table_lookup(const int32_t* in, int32_t* out, size_t n,
+                           const simd::TableSpec& spec) {
+    return detail::table.table_lookup_i32.load(std::memory_order_relaxed)(in, out, n, spec);
+}
+
+inline size_t table_lookup(const int16_t* in, int16_t* out, size_t n,
+                           const simd::TableSpec& spec) {
+    return detail::table.table_lookup_i16.load(std::memory_order_relaxed)(in, out, n, spec);
+}
+
+} // namespace raw
+
+} // namespace dispatch
+} // namespace fixp
+
+#endif // FIXP_CPU_DISPATCH_HPP
@@ -0,0 +1,100 @@
+#ifndef FIXP_DISPATCH_HPP
+#define FIXP_DISPATCH_HPP
+
+#include "batch.hpp"
+#include "cpu_dispatch.hpp"
+
+namespace fixp {
+namespace dispatch {
+
+/**
+ * @brief Runtime-dispatched batch arithmetic
+ *
+ * Same contract and bit-exact results as fixp::batch, but the SIMD kernel is
+ * chosen from the CPU the binary runs on rather than the compiler target.
+ * The LIBFIXP_ISA environment variable ("scalar", "sse4.1", "avx2",
+ * "avx512", "neon") or force_isa() overrides the probe. Requires linking
+ * libfixp::dispatch.
+ */
+
+using batch::input_span;
+using batch::Rounding;
+using batch::from_double;
+using batch::to_double;
+
+namespace detail {
+
+// The raw:: entry points as a batch_ops provider
+struct raw_kernels {
+    static constexpr bool available = true;
+
+    template<typename... Args>
+    static size_t add(Args... args) { return raw::add(args...); }
+    template<typename... Args>
+    static size_t sub(Args... args) { return raw::sub(args...); }
+    template<typename... Args>
+    static size_t mul(Args... args) { return raw::mul(args...); }
+    template<typename... Args>
+    static size_t mul_add(Args... args) { return raw::mul_add(args...); }
+    template<typename... Args>
+    static size_t scale(Args... args) { return raw::scale(args...); }
+    template<typename... Args>
+    static size_t clamp(Args... args) { return raw::clamp(args...); }
+    template<typename... Args>
+    static size_t from_float(Args... args) { return raw::from_float(args...); }
+    template<typename... Args>
+    static size_t to_float(Args... args) { return raw::to_float(args...); }
+};
+
+using ops = batch::detail::batch_ops<raw_kernels>;
+
+} // namespace detail
+
+template<FixedPointType FP>
+void add(input_span<FP> a, input_span<FP> b, std::span<FP> out) {
+    detail::ops::add<FP>(a, b, out);
+}
+
+template<FixedPointType FP>
+void sub(input_span<FP> a, input_span<FP> b, std::span<FP> out) {
+    detail::ops::sub<FP>(a, b, out);
+}
+
+template<FixedPointType FP>
+void mul(input_span<FP> a, input_span<FP> b, std::span<FP> out) {
+    detail::ops::mul<FP>(a, b, out);
+}
+
+template<FixedPointType FP>
+void mul_add(input_span<FP> a, input_span<FP> b, input_span<FP> c, std::span<FP> out) {
+    detail::ops::mul_add<FP>(a, b, c, out);
+}
+
+template<FixedPointType FP>
+void scale(input_span<FP> a, std::type_identity_t<FP> s, std::span<FP> out) {
+    detail::ops::scale<FP>(a, s, out);
+}
+
+template<FixedPointType FP>
+void saturate(input_span<FP> a, std::span<FP> out,
+              std::type_identity_t<FP> lo = FP::min(), std::type_identity_t<FP> hi = FP::max()) {
+    detail::ops::saturate<FP>(a, out, lo, hi);
+}
+
+template<FixedPointType FP>
+void from_float(std::span<const float> in, std::span<FP> out,
+                Rounding rounding = Rounding::HalfEven) {
+    detail::ops::from_float<FP>(in, out, rounding);
+}
+
+template<std::ranges::contiguous_range R>
+    requires FixedPointType<std::ranges::range_value_t<R>>
+void to_float(const R& range, std::span<float> out) {
+    using FP = std::ranges::range_value_t<R>;
+    detail::ops::to_float<FP>(std::span<const FP>(range), out);
+}
+
+} // namespace dispatch
+} // namespace fixp
+
+#endif // FIXP_DISPATCH_HPP
@@ -0,0 +1,268 @@
+#ifndef FIXP_DIVIDE_HPP
+#define FIXP_DIVIDE_HPP
+
+#include "fixed_point.hpp"
+#include "batch.hpp"
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace fixp {
+
+namespace detail {
+    template<typename U>
+    constexpr int unsigned_bit_width(U v) {
+        if constexpr (sizeof(U) > 8) {
+            const auto hi = static_cast<uint64_t>(v >> 64);
+            return hi != 0 ? 64 + static_cast<int>(std::bit_width(hi))
+                           : static_cast<int>(std::bit_width(static_cast<uint64_t>(v)));
+        } else {
+            return static_cast<int>(std::bit_width(static_cast<uint64_t>(v)));
+        }
+    }
+
+    // High half of a * b for 32-, 64- and 128-bit operands
+    template<typename U>
+    constexpr U mul_high(U a, U b) {
+        if constexpr (sizeof(U) == 4) {
+            return static_cast<U>((static_cast<uint64_t>(a) * b) >> 32);
+        } else {
+            return libfixp::detail::mul_wide(a, b).hi;
+        }
+    }
+
+    // The dividend raw << FracBits has up to this many magnitude bits
+    template<typename FP>
+    inline constexpr int dividend_bits =
+        FP::total_bits + FP::fractional_bits - (FP::is_signed ? 1 : 0);
+
+    template<typename FP>
+    using dividend_t = std::conditional_t<
+        dividend_bits<FP> <= 31, uint32_t,
+        std::conditional_t<dividend_bits<FP> <= 63, uint64_t, uint128>>;
+
+    // 1/m in Q31 at the midpoint of each 1/128 step of m in [1, 2):
+    // 2^31 / ((2i + 257) / 256) = 2^39 / (2i + 257), good to 8 bits
+    inline constexpr std::array<uint32_t, 128> RECIPROCAL_SEEDS = [] {
+        std::array<uint32_t, 128> t{};
+        for (size_t i = 0; i < t.size(); ++i) {
+            t[i] = static_cast<uint32_t>((uint64_t(1) << 39) / (2 * i + 257));
+        }
+        return t;
+    }();
+
+    /**
+     * @brief 1/m in Q63 for m in Q63, m in [1, 2)
+     *
+     * Table seed plus divide-free Newton steps y = y (2 - m y), each doubling
+     * the correct bits: 2 steps give 2^-32, 3 give 2^-61.
+     */
+    template<int Iterations>
+    constexpr uint128 reciprocal_q63(uint64_t m) {
+        uint128 y = uint128(RECIPROCAL_SEEDS[(m >> 56) - 128]) << 32;
+        for (int i = 0; i < Iterations; ++i) {
+            const uint128 my = (m * y) >> 63; // m y in Q63
+            y = (y * ((uint128(1) << 64) - my)) >> 63;
+        }
+        return y;
+    }
+}
+
+/**
+ * @brief A reusable divisor: x / d as a multiply and a shift
+ *
+ * The constructor does the one real division, computing a magic multiplier
+ * M = ceil(2^L / |d|) for the dividend width (the libdivide scheme), after
+ * which every divide() is a high-half multiply and a shift. Results are
+ * bit-identical to x / d, including the truncation toward zero, the
+ * overflow policy for quotients that do not fit and max() / min() for d == 0.
+ *
+ * The multiply is 32 x 32 -> 64 bits for 16-bit formats (one UMULL on a
+ * Cortex-M4), 64 x 64 -> 128 for 32-bit formats and four 64-bit products for
+ * 64-bit formats.
+ *
+ * @code
+ * const fixp::Divisor<Q15_16> d(gain);
+ * for (auto& x : samples) x = x / d;
+ * @endcode
+ */
+template<FixedPointType FP>
+    requires (detail::dividend_bits<FP> <= 127)
+class Divisor {
+public:
+    using operand_type = detail::dividend_t<FP>;
+    static constexpr int operand_bits = 8 * sizeof(operand_type);
+
+    constexpr explicit Divisor(FP d) : m_divisor(d) {
+        const operand_type a = magnitude(d.raw());
+        if (a == 0) return;
+        const int s = detail::unsigned_bit_width(operand_type(a - 1)); // ceil(log2 |d|)
+        if ((a & (a - 1)) == 0) {
+            m_shift = s;
+            return;
+        }
+        // M = ceil(2^L / |d|) with L = operand_bits - 1 + s, which fits operand_type.
+        // The error M |d| - 2^L < |d| <= 2^s times a dividend below 2^(operand_bits - 1)
+        // stays under 2^L, so the quotient is exact.
+        const int L = operand_bits - 1 + s;
+        if constexpr (operand_bits <= 64) {
+            m_magic = static_cast<operand_type>(((uint128(1) << L) / a) + 1);
+        } else {
+            // 2^L / |d| by long division; |d| < 2^64, so the remainder never overflows
+            operand_type q = 0;
+            operand_type r = 1;
+            for (int i = 0; i < L; ++i) {
+                r <<= 1;
+                q <<= 1;
+                if (r >= a) {
+                    r -= a;
+                    q |= 1;
+                }
+            }
+            m_magic = q + 1;
+        }
+        m_shift = s - 1;
+    }
+
+    constexpr FP divisor() const { return m_divisor; }
+
+    /**
+     * @brief x / divisor(), without a divide instruction
+     */
+    constexpr FP divide(FP x) const {
+        using raw_type = typename FP::raw_type;
+        if (m_divisor.raw() == 0) {
+            count_event(FixedPointEvent::DivideByZero);
+            return x.raw() >= 0 ? FP::max() : FP::min();
+        }
+        const operand_type n = magnitude(x.raw()) << FP::fractional_bits;
+        const operand_type q = (m_magic != 0 ? detail::mul_high(n, m_magic) : n) >> m_shift;
+
+        // Narrowed from two raw words as operator/ narrows its quotient
+        using U = libfixp::detail::unsigned_raw_t<raw_type>;
+        constexpr int W = libfixp::detail::word_bits<U>;
+        libfixp::detail::WideWord<U> w{U(0), static_cast<U>(q)};
+        if constexpr (operand_bits > W) w.hi = static_cast<U>(q >> W);
+        if constexpr (FP::is_signed) {
+            if ((x.raw() < 0) != (m_divisor.raw() < 0)) w = libfixp::detail::neg_wide(w);
+        }
+        return FP::from_raw(
+            libfixp::detail::overflow_cast_wide<raw_type, FP::overflow_policy>(w, "div"));
+    }
+
+    friend constexpr FP operator/(FP x, const Divisor& d) { return d.divide(x); }
+
+private:
+    static constexpr operand_type magnitude(typename FP::raw_type v) {
+        if constexpr (FP::is_signed) {
+            return v < 0 ? operand_type(0) - static_cast<operand_type>(v)
+                         : static_cast<operand_type>(v);
+        } else {
+            return static_cast<operand_type>(v);
+        }
+    }
+
+    FP m_divisor;
+    operand_type m_magic = 0; // 0 for powers of two, which only shift
+    int m_shift = 0;
+};
+
+namespace detail {
+    template<typename FP, auto D>
+    constexpr FP constant_divisor() {
+        if constexpr (std::integral<decltype(D)>) {
+            using raw_type = typename FP::raw_type;
+            return FP::from_raw(
+                static_cast<raw_type>(static_cast<raw_type>(D) << FP::fractional_bits));
+        } else {
+            return FP(static_cast<double>(D));
+        }
+    }
+
+    template<typename FP, auto D>
+    inline constexpr Divisor<FP> divisor_constant{constant_divisor<FP, D>()};
+}
+
+/**
+ * @brief x / D for a compile-time constant D, as a multiply and a shift
+ *
+ * D is an integer or floating-point constant, converted to FP once:
+ * divide_by<3>(x) == x / FP(3) and divide_by<1.5>(x) == x / FP(1.5), with the
+ * magic number folded into the code.
+ */
+template<auto D, FixedPointType FP>
+    requires (std::is_arithmetic_v<decltype(D)>)
+constexpr FP divide_by(FP x) {
+    return detail::divisor_constant<FP, D>.divide(x);
+}
+
+/**
+ * @brief 1/x by Newton-Raphson, without a divide instruction
+ *
+ * A table seed and two or three y = y (2 - m y) steps on the normalized
+ * mantissa, then an exact correction, so the result is 1/x truncated toward
+ * zero: the same bits as FP(1) / x wherever 1/x fits. Saturates where it does
+ * not, and returns max() for x == 0.
+ */
+template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires (TotalBits <= 64 && FracBits <= 62)
+constexpr auto reciprocal(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
+    using raw_type = typename FP::raw_type;
+    if (x.raw() == 0) {
+        count_event(FixedPointEvent::DivideByZero);
+        return FP::max();
+    }
+    const bool negative = x.raw() < 0;
+    const uint64_t a = negative ? uint64_t(0) - static_cast<uint64_t>(x.raw())
+                                : static_cast<uint64_t>(x.raw());
+    // a = m 2^(e - 63) with m in [1, 2) in Q63
+    const int e = static_cast<int>(std::bit_width(a)) - 1;
+    const uint128 y = detail::reciprocal_q63<(TotalBits <= 24 ? 2 : 3)>(a << (63 - e));
+
+    // 2^(2 FracBits) / a = y 2^(2 FracBits - e - 63)
+    const int shift = 63 + e - 2 * FracBits;
+    const uint128 n = uint128(1) << (2 * FracBits);
+    uint128 q = shift >= 0 ? y >> shift : y << -shift;
+    if constexpr (TotalBits > 32) {
+        // y carries 2^-61, a few units of a 64-bit quotient: one remainder step
+        const auto t = static_cast<int128>(n - q * a);
+        const auto y31 = static_cast<int128>(y >> 32);
+        q = static_cast<uint128>(static_cast<int128>(q) + ((t * y31) >> (31 + e)));
+    }
+    q = q * a > n ? q - 1 : q;
+    q = n - q * a >= a ? q + 1 : q;
+
+    const auto hi = static_cast<uint128>(FP::max().raw());
+    if constexpr (Signed) {
+        if (negative) {
+            count_event(FixedPointEvent::Saturation, q > hi + 1);
+            return q > hi + 1 ? FP::min()
+                              : FP::from_raw(static_cast<raw_type>(-static_cast<int128>(q)));
+        }
+    }
+    count_event(FixedPointEvent::Saturation, q > hi);
+    return q > hi ? FP::max() : FP::from_raw(static_cast<raw_type>(q));
+}
+
+namespace batch {
+
+/**
+ * @brief out[i] = in[i] / d, a multiply and a shift per element
+ */
+template<FixedPointType FP>
+void divide(input_span<FP> in, const Divisor<FP>& d, std::span<FP> out) {
+    assert(in.size() >= out.size());
+    for (size_t i = 0; i < out.size(); ++i) out[i] = d.divide(in[i]);
+}
+
+} // namespace batch
+
+} // namespace fixp
+
+#endif // FIXP_DIVIDE_HPP
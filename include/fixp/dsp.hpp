@@ -2,10 +2,20 @@
 #define FIXP_DSP_HPP
 
 #include "fixed_point.hpp"
+#include "accumulator.hpp"
+#include "batch.hpp"
 #include "math.hpp"
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cassert>
 #include <complex>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 namespace fixp {
 namespace dsp {
@@ -42,16 +52,188 @@ struct Complex {
         return real * real + imag * imag;
     }
     
-    FixedType magnitude() const {
-        return sqrt(magnitude_squared());
+    /// sqrt(real^2 + imag^2) without squaring overflow and without divides
+    constexpr FixedType magnitude() const {
+        return hypot(real, imag);
     }
 };
 
+/**
+ * @brief Precomputed radix-2 FFT plan
+ *
+ * Holds the twiddle factors W_N^k = e^(-2πik/N), k < N/2, and the bit-reversal
+ * permutation. Both are built once, at compile time when the plan is declared
+ * constexpr, and reused by every transform. Each butterfly reads its twiddle
+ * from the table, so there is no trigonometry per call and no rounding error
+ * accumulating through a w = w * wlen recurrence.
+ *
+ * Twiddles are raw integers with twiddle_bits fractional bits (Q30 for
+ * formats up to 32 bits, Q62 beyond), independent of FixedType, so W^0 = 1
+ * is exact even in Q0.x formats that cannot represent 1. Each twiddle
+ * product is rounded once and narrowed under the format's overflow policy;
+ * the butterfly sums use the format's own operators.
+ *
+ * @code
+ * static constexpr dsp::FftPlan<Q15_16, 1024> plan;
+ * plan.forward(buffer);
+ * @endcode
+ */
+template<typename FixedType, size_t N>
+    requires ((N & (N - 1)) == 0 && N >= 2)
+class FftPlan {
+public:
+    using value_type = Complex<FixedType>;
+    static constexpr size_t size = N;
+    static constexpr int log2_size = std::countr_zero(N);
+    static constexpr int twiddle_bits = FixedType::total_bits <= 32 ? 30 : 62;
+    using twiddle_raw = std::conditional_t<(FixedType::total_bits <= 32), int32_t, int64_t>;
+
+    /// W_N^k scaled by 2^twiddle_bits
+    struct Twiddle {
+        twiddle_raw real;
+        twiddle_raw imag;
+    };
+
+    constexpr FftPlan() {
+        for (size_t i = 0; i < N; ++i) {
+            size_t r = 0;
+            for (int b = 0; b < log2_size; ++b) {
+                r |= ((i >> b) & 1u) << (log2_size - 1 - b);
+            }
+            m_bitrev[i] = static_cast<uint32_t>(r);
+        }
+        for (size_t k = 0; k < N / 2; ++k) {
+            const auto [c, s] = unit_circle(k);
+            m_twiddles[k] = {to_twiddle(c), to_twiddle(-s)};
+        }
+    }
+
+    /**
+     * @brief In-place forward transform
+     */
+    constexpr void forward(std::span<value_type, N> data) const {
+        transform<false>(data);
+    }
+
+    /**
+     * @brief In-place inverse transform, scaled by 1/N
+     */
+    constexpr void inverse(std::span<value_type, N> data) const {
+        transform<true>(data);
+        for (auto& x : data) {
+            x.real = scale_down(x.real);
+            x.imag = scale_down(x.imag);
+        }
+    }
+
+    constexpr void execute(std::span<value_type, N> data, bool inverse_transform = false) const {
+        if (inverse_transform) {
+            inverse(data);
+        } else {
+            forward(data);
+        }
+    }
+
+    constexpr const std::array<Twiddle, N / 2>& twiddles() const { return m_twiddles; }
+    constexpr const std::array<uint32_t, N>& bit_reversal() const { return m_bitrev; }
+
+private:
+    template<bool Inverse>
+    constexpr void transform(std::span<value_type, N> data) const {
+        for (size_t i = 0; i < N; ++i) {
+            size_t j = m_bitrev[i];
+            if (i < j) {
+                std::swap(data[i], data[j]);
+            }
+        }
+
+        // Stage with butterflies of length len uses every (N/len)-th twiddle
+        for (size_t len = 2, stride = N / 2; len <= N; len <<= 1, stride >>= 1) {
+            const size_t half = len / 2;
+            for (size_t i = 0; i < N; i += len) {
+                for (size_t k = 0; k < half; ++k) {
+                    Twiddle w = m_twiddles[k * stride];
+                    if constexpr (Inverse) {
+                        w.imag = -w.imag;
+                    }
+                    const auto xr = data[i + k + half].real.raw();
+                    const auto xi = data[i + k + half].imag.raw();
+                    const value_type t(FixedType::from_raw(twiddle_dot(w.real, xr, w.imag, xi)),
+                                       FixedType::from_raw(twiddle_dot(w.real, xi, -w.imag, xr)));
+                    auto u = data[i + k];
+                    data[i + k] = u + t;
+                    data[i + k + half] = u - t;
+                }
+            }
+        }
+    }
+
+    using raw_type = typename FixedType::raw_type;
+
+    // cos and sin of 2πk/N for k <= N/2, reflected into the first octant so
+    // the points on the axes are exact even at Q62
+    static constexpr std::pair<double, double> unit_circle(size_t k) {
+        if (4 * k > N) {
+            const auto [c, s] = unit_circle(N / 2 - k);
+            return {-c, s};
+        }
+        if (8 * k > N) {
+            const auto [c, s] = unit_circle(N / 4 - k);
+            return {s, c};
+        }
+        const double x = 2.0 * fixp::detail::TRIG_PI * static_cast<double>(k) /
+                         static_cast<double>(N);
+        const double h = fixp::detail::constexpr_sin(x / 2);
+        return {1.0 - 2.0 * h * h, fixp::detail::constexpr_sin(x)};
+    }
+
+    static constexpr twiddle_raw to_twiddle(double v) {
+        double scaled = v * static_cast<double>(int64_t(1) << twiddle_bits);
+        return static_cast<twiddle_raw>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+    }
+
+    // a * x - b * y with twiddles a and b, rounded once to the data's scale
+    // and narrowed under the format's policy
+    static constexpr raw_type twiddle_dot(twiddle_raw a, raw_type x, twiddle_raw b, raw_type y) {
+        constexpr OverflowPolicy P = FixedType::overflow_policy;
+        if constexpr (FixedType::total_bits <= 32) {
+            constexpr int64_t half = int64_t(1) << (twiddle_bits - 1);
+            const int64_t v = int64_t(a) * int64_t(x) - int64_t(b) * int64_t(y);
+            return overflow_cast<raw_type, P>((v + half) >> twiddle_bits, "fft");
+        } else {
+            // Q62 twiddles make a two-word product; it stays exact through
+            // the difference and the rounding shift
+            namespace core = libfixp::detail;
+            using U = core::unsigned_raw_t<raw_type>;
+            const auto p = core::mul_wide_signed(static_cast<U>(a), static_cast<U>(x));
+            const auto q = core::mul_wide_signed(static_cast<U>(b), static_cast<U>(y));
+            const core::WideWord<U> v{static_cast<U>(p.hi - q.hi - U(p.lo < q.lo)),
+                                      static_cast<U>(p.lo - q.lo)};
+            return core::overflow_cast_wide<raw_type, P>(
+                core::round_shift_wide<twiddle_bits, true>(v), "fft");
+        }
+    }
+
+    // Rounding divide by N; unlike multiplying by FP(1)/FP(N) this works
+    // for formats that cannot represent N
+    static constexpr FixedType scale_down(FixedType x) {
+        using raw_type = typename FixedType::raw_type;
+        const auto raw = static_cast<int64_t>(x.raw());
+        const int64_t half = int64_t(1) << (log2_size - 1);
+        return FixedType::from_raw(static_cast<raw_type>((raw + half) >> log2_size));
+    }
+
+    std::array<Twiddle, N / 2> m_twiddles{};
+    std::array<uint32_t, N> m_bitrev{};
+};
+
 /**
  * @brief Radix-2 Decimation-in-Time FFT
  * 
  * Implements the Cooley-Tukey FFT algorithm for power-of-2 sizes.
  * Based on algorithms from CMSIS-DSP, libfixmath, and liquid-fpm.
+ * Uses a plan built on first call for each (FixedType, N); hold an FftPlan
+ * directly to control where the tables live.
  * 
  * @param data Input/output array of complex numbers (size must be power of 2)
  * @param N Size of the FFT (must be power of 2)
@@ -60,98 +242,519 @@ struct Complex {
 template<typename FixedType, size_t N>
     requires ((N & (N - 1)) == 0 && N >= 2) // N is power of 2
 void fft_radix2(std::array<Complex<FixedType>, N>& data, bool inverse = false) {
-    using FP = FixedType;
-    
-    // Bit-reversal permutation
-    size_t j = 0;
-    for (size_t i = 0; i < N - 1; ++i) {
-        if (i < j) {
-            std::swap(data[i], data[j]);
+    static const FftPlan<FixedType, N> plan;
+    plan.execute(data, inverse);
+}
+
+/**
+ * @brief Overflow handling for Radix4FftPlan
+ */
+enum class FftScaling {
+    None,              ///< No scaling; the caller must leave log2(N) bits of headroom
+    PerStage,          ///< Shift right every stage (2 bits per radix-4 stage, 1 per radix-2)
+    BlockFloatingPoint ///< Shift only when a stage could overflow; report the exponent
+};
+
+/**
+ * @brief Radix-4 FFT plan with selectable scaling
+ *
+ * Runs radix-4 decimation-in-time stages, plus one radix-2 stage when log2(N)
+ * is odd. That takes 3 twiddle multiplies per 4 points per two radix-2 ranks,
+ * about 25% fewer than fft_radix2. Butterflies run on raw integers with Q30
+ * twiddles and a 64-bit intermediate. A stage keeps its twiddle products
+ * unrounded, up to 30 bits below the data's LSB (29 for 32-bit data, to
+ * leave room for the sums), and rounds once, when it stores its outputs.
+ *
+ * forward() and inverse() return an exponent e: the exact transform equals the
+ * output times 2^e. inverse() includes the 1/N factor. With None, e is always
+ * 0. With PerStage, e is log2(N) for forward and 0 for inverse (CMSIS style).
+ * The input should then stay within unit magnitude, |x| <= max(). With
+ * BlockFloatingPoint, each stage checks the block's headroom and shifts only
+ * as far as needed, so low-level inputs keep their precision.
+ */
+template<typename FixedType, size_t N, FftScaling Scaling = FftScaling::BlockFloatingPoint>
+    requires ((N & (N - 1)) == 0 && N >= 4 &&
+              FixedType::is_signed && FixedType::total_bits <= 32)
+class Radix4FftPlan {
+public:
+    using value_type = Complex<FixedType>;
+    static constexpr size_t size = N;
+    static constexpr int log2_size = std::countr_zero(N);
+    static constexpr FftScaling scaling = Scaling;
+
+    constexpr Radix4FftPlan() {
+        for (size_t i = 0; i < N; ++i) {
+            size_t r = 0;
+            for (int b = 0; b < log2_size; ++b) {
+                r |= ((i >> b) & 1u) << (log2_size - 1 - b);
+            }
+            m_bitrev[i] = static_cast<uint32_t>(r);
         }
-        
-        // Add 1 in reversed bit order
-        size_t k = N >> 1;
-        while (k <= j) {
-            j -= k;
-            k >>= 1;
+        for (size_t k = 0; k < m_cos.size(); ++k) {
+            double angle = -2.0 * fixp::detail::TRIG_PI * static_cast<double>(k) /
+                           static_cast<double>(N);
+            m_cos[k] = to_q30(fixp::detail::constexpr_cos(angle));
+            m_sin[k] = to_q30(fixp::detail::constexpr_sin(angle));
         }
-        j += k;
     }
-    
-    // FFT computation
-    auto two_pi = constants::two_pi<FP>();
-    
-    for (size_t len = 2; len <= N; len <<= 1) {
-        // Twiddle factor: e^(-2πi/len) = cos(-2π/len) + i*sin(-2π/len)
-        FP angle = (inverse ? two_pi : -two_pi) / FP(static_cast<int>(len));
-        
-        Complex<FP> wlen(cos(angle), sin(angle));
-        
-        for (size_t i = 0; i < N; i += len) {
-            Complex<FP> w(FP(1), FP(0));
-            
-            for (size_t jj = 0; jj < len / 2; ++jj) {
-                // Butterfly operation
-                auto t = w * data[i + jj + len / 2];
-                auto u = data[i + jj];
-                
-                data[i + jj] = u + t;
-                data[i + jj + len / 2] = u - t;
-                
-                w = w * wlen;
+
+    /**
+     * @brief In-place forward transform; returns the block exponent
+     */
+    constexpr int forward(std::span<value_type, N> data) const {
+        return transform<false>(data);
+    }
+
+    /**
+     * @brief In-place inverse transform (with 1/N); returns the block exponent
+     */
+    constexpr int inverse(std::span<value_type, N> data) const {
+        if constexpr (Scaling == FftScaling::None) {
+            transform<true>(data);
+            for (auto& x : data) {
+                x.real = FixedType::from_raw(narrow(round_shift(x.real.raw(), log2_size)));
+                x.imag = FixedType::from_raw(narrow(round_shift(x.imag.raw(), log2_size)));
             }
+            return 0;
+        } else {
+            return transform<true>(data) - log2_size;
         }
     }
-    
-    // Normalize for IFFT
-    if (inverse) {
-        FP scale = FP(1) / FP(static_cast<int>(N));
+
+private:
+    using raw_type = typename FixedType::raw_type;
+    static constexpr int64_t RAW_MAX = static_cast<int64_t>(std::numeric_limits<raw_type>::max());
+    static constexpr int64_t RAW_MIN = static_cast<int64_t>(std::numeric_limits<raw_type>::min());
+
+    static constexpr int32_t to_q30(double v) {
+        double scaled = v * 1073741824.0;
+        return static_cast<int32_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+    }
+
+    static constexpr int64_t round_shift(int64_t v, int shift) {
+        return shift > 0 ? (v + (int64_t(1) << (shift - 1))) >> shift : v;
+    }
+
+    static constexpr raw_type narrow(int64_t v) {
+        if constexpr (FixedType::overflow_policy == OverflowPolicy::Saturate) {
+            count_event(FixedPointEvent::Saturation, v < RAW_MIN || v > RAW_MAX);
+            v = v < RAW_MIN ? RAW_MIN : (v > RAW_MAX ? RAW_MAX : v);
+        }
+        return static_cast<raw_type>(v);
+    }
+
+    // Bits a stage carries below the data's LSB. A radix-4 output is at most
+    // (1 + 3 sqrt(2)) < 2^2.4 times the largest input component, so
+    // total_bits + 1.4 + guard_bits must stay below 63.
+    static constexpr int guard_bits = std::min(30, 61 - FixedType::total_bits);
+
+    struct Wide {
+        int64_t re, im;
+    };
+
+    // x * W_N^k (conjugated for the inverse), with guard_bits below the data's LSB
+    template<bool Inverse>
+    constexpr Wide twiddle(const value_type& x, size_t k) const {
+        const int64_t c = m_cos[k];
+        const int64_t s = Inverse ? -int64_t(m_sin[k]) : int64_t(m_sin[k]);
+        const int64_t re = x.real.raw();
+        const int64_t im = x.imag.raw();
+        constexpr int drop = 30 - guard_bits;
+        return {round_shift(re * c - im * s, drop), round_shift(re * s + im * c, drop)};
+    }
+
+    static constexpr Wide load(const value_type& x) {
+        return {static_cast<int64_t>(x.real.raw()) << guard_bits,
+                static_cast<int64_t>(x.imag.raw()) << guard_bits};
+    }
+
+    // Bits of growth a stage can add: radix-2 sums two values; radix-4 sums
+    // four, and the twiddle can move up to sqrt(2) of a component into the other
+    static constexpr int stage_growth(bool radix4) {
+        return radix4 ? 3 : 1;
+    }
+
+    // Shift to apply before committing a stage's outputs
+    static constexpr int stage_shift(bool radix4, int headroom) {
+        if constexpr (Scaling == FftScaling::None) {
+            return 0;
+        } else if constexpr (Scaling == FftScaling::PerStage) {
+            return radix4 ? 2 : 1;
+        } else {
+            const int needed = stage_growth(radix4) - headroom;
+            return needed > 0 ? needed : 0;
+        }
+    }
+
+    // Redundant sign bits in the block, used by block floating point
+    static constexpr int headroom(std::span<const value_type, N> data) {
+        uint64_t bits = 0;
+        for (const auto& x : data) {
+            const int64_t re = x.real.raw();
+            const int64_t im = x.imag.raw();
+            bits |= static_cast<uint64_t>(re < 0 ? ~re : re);
+            bits |= static_cast<uint64_t>(im < 0 ? ~im : im);
+        }
+        return FixedType::total_bits - 1 - static_cast<int>(std::bit_width(bits));
+    }
+
+    template<bool Inverse>
+    constexpr int transform(std::span<value_type, N> data) const {
         for (size_t i = 0; i < N; ++i) {
-            data[i].real = data[i].real * scale;
-            data[i].imag = data[i].imag * scale;
+            size_t j = m_bitrev[i];
+            if (i < j) {
+                std::swap(data[i], data[j]);
+            }
+        }
+
+        int exponent = 0;
+        auto store = [](value_type& dst, Wide v, int shift) {
+            dst.real = FixedType::from_raw(narrow(round_shift(v.re, shift + guard_bits)));
+            dst.imag = FixedType::from_raw(narrow(round_shift(v.im, shift + guard_bits)));
+        };
+        auto block_headroom = [&data]() {
+            if constexpr (Scaling == FftScaling::BlockFloatingPoint) {
+                return headroom(data);
+            } else {
+                return 0;
+            }
+        };
+
+        size_t m = 1;
+        if constexpr (log2_size % 2 != 0) {
+            // Odd log2(N): one radix-2 stage of trivial butterflies first
+            const int shift = stage_shift(false, block_headroom());
+            for (size_t i = 0; i < N; i += 2) {
+                const Wide a = load(data[i]);
+                const Wide b = load(data[i + 1]);
+                store(data[i], {a.re + b.re, a.im + b.im}, shift);
+                store(data[i + 1], {a.re - b.re, a.im - b.im}, shift);
+            }
+            exponent += shift;
+            m = 2;
+        }
+
+        // Bit-reversed input order places the sub-transforms of x[4n], x[4n+2],
+        // x[4n+1], x[4n+3] at offsets 0, m, 2m, 3m of each block
+        for (; m < N; m *= 4) {
+            const int shift = stage_shift(true, block_headroom());
+            const size_t stride = N / (4 * m);
+            for (size_t base = 0; base < N; base += 4 * m) {
+                for (size_t k = 0; k < m; ++k) {
+                    value_type* p = &data[base + k];
+                    const Wide a0 = load(p[0]);
+                    const Wide a1 = twiddle<Inverse>(p[2 * m], k * stride);
+                    const Wide a2 = twiddle<Inverse>(p[m], 2 * k * stride);
+                    const Wide a3 = twiddle<Inverse>(p[3 * m], 3 * k * stride);
+
+                    const Wide s02 = {a0.re + a2.re, a0.im + a2.im};
+                    const Wide d02 = {a0.re - a2.re, a0.im - a2.im};
+                    const Wide s13 = {a1.re + a3.re, a1.im + a3.im};
+                    const Wide d13 = {a1.re - a3.re, a1.im - a3.im};
+
+                    // Multiply d13 by -j (forward) or +j (inverse)
+                    const Wide r13 = Inverse ? Wide{-d13.im, d13.re} : Wide{d13.im, -d13.re};
+
+                    store(p[0], {s02.re + s13.re, s02.im + s13.im}, shift);
+                    store(p[m], {d02.re + r13.re, d02.im + r13.im}, shift);
+                    store(p[2 * m], {s02.re - s13.re, s02.im - s13.im}, shift);
+                    store(p[3 * m], {d02.re - r13.re, d02.im - r13.im}, shift);
+                }
+            }
+            exponent += shift;
+        }
+        return exponent;
+    }
+
+    // W_N^k for k < 3N/4, the largest index a radix-4 stage uses
+    std::array<int32_t, 3 * N / 4> m_cos{};
+    std::array<int32_t, 3 * N / 4> m_sin{};
+    std::array<uint32_t, N> m_bitrev{};
+};
+
+/**
+ * @brief Real-input FFT plan using an N/2-point complex transform
+ *
+ * Packs x[2n] + j*x[2n+1] into N/2 complex points, runs an N/2-point FftPlan
+ * in place, and separates the even and odd spectra with one Q30 twiddle per
+ * bin pair. That halves the work and memory of transforming N zero-imaginary
+ * points. Both directions write into caller-provided buffers: forward() packs
+ * into the first N/2 entries of the output spectrum, and inverse() uses the
+ * spectrum it is given as scratch (like FFTW's c2r), so neither needs a
+ * temporary.
+ */
+template<typename FixedType, size_t N>
+    requires ((N & (N - 1)) == 0 && N >= 4)
+class RealFftPlan {
+public:
+    using value_type = Complex<FixedType>;
+    static constexpr size_t size = N;
+    static constexpr size_t bins = N / 2 + 1;
+
+    constexpr RealFftPlan() {
+        for (size_t k = 0; k < M; ++k) {
+            double angle = -2.0 * fixp::detail::TRIG_PI * static_cast<double>(k) /
+                           static_cast<double>(N);
+            m_cos[k] = to_q30(fixp::detail::constexpr_cos(angle));
+            m_sin[k] = to_q30(fixp::detail::constexpr_sin(angle));
+        }
+    }
+
+    /**
+     * @brief Spectrum X[0..N/2] of N real samples (the rest is conjugate symmetric)
+     */
+    constexpr void forward(std::span<const FixedType, N> input,
+                           std::span<value_type, N / 2 + 1> output) const {
+        for (size_t n = 0; n < M; ++n) {
+            output[n] = value_type(input[2 * n], input[2 * n + 1]);
+        }
+        m_fft.forward(output.template first<M>());
+
+        // X[k] = ((Z[k] + Z*[M-k]) - j W^k (Z[k] - Z*[M-k])) / 2, done for k
+        // and M-k together since both read the same two bins
+        const value_type z0 = output[0];
+        for (size_t k = 1; k <= M / 2; ++k) {
+            const value_type zk = output[k];
+            const value_type zm = output[M - k];
+            output[k] = split(zk, zm, k);
+            if (k != M - k) {
+                output[M - k] = split(zm, zk, M - k);
+            }
+        }
+        const wide re = z0.real.raw();
+        const wide im = z0.imag.raw();
+        output[0] = value_type(from_wide(re + im), FixedType(0));
+        output[M] = value_type(from_wide(re - im), FixedType(0));
+    }
+
+    /**
+     * @brief N real samples from the spectrum X[0..N/2], scaled by 1/N
+     *
+     * The spectrum is overwritten.
+     */
+    constexpr void inverse(std::span<value_type, N / 2 + 1> spectrum,
+                           std::span<FixedType, N> output) const {
+        // Z[k] = Xe[k] + j Xo[k], Xe = (X[k] + X*[M-k]) / 2,
+        // Xo = (X[k] - X*[M-k]) W^-k / 2
+        const value_type x0 = spectrum[0];
+        const value_type xm = spectrum[M];
+        for (size_t k = 1; k <= M / 2; ++k) {
+            const value_type xk = spectrum[k];
+            const value_type xc = spectrum[M - k];
+            spectrum[k] = merge(xk, xc, k);
+            if (k != M - k) {
+                spectrum[M - k] = merge(xc, xk, M - k);
+            }
+        }
+        const wide r0 = x0.real.raw();
+        const wide rm = xm.real.raw();
+        spectrum[0] = value_type(from_wide(halve(r0 + rm)), from_wide(halve(r0 - rm)));
+
+        auto packed = spectrum.template first<M>();
+        m_fft.inverse(packed);
+        for (size_t n = 0; n < M; ++n) {
+            output[2 * n] = packed[n].real;
+            output[2 * n + 1] = packed[n].imag;
         }
     }
+
+private:
+    static constexpr size_t M = N / 2;
+    using raw_type = typename FixedType::raw_type;
+    using wide = std::conditional_t<(FixedType::total_bits <= 32), int64_t, int128>;
+
+    static constexpr int32_t to_q30(double v) {
+        double scaled = v * 1073741824.0;
+        return static_cast<int32_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+    }
+
+    static constexpr wide halve(wide v) {
+        return (v + 1) >> 1;
+    }
+
+    static constexpr FixedType from_wide(wide v) {
+        if constexpr (FixedType::overflow_policy == OverflowPolicy::Saturate) {
+            constexpr wide lo = static_cast<wide>(std::numeric_limits<raw_type>::min());
+            constexpr wide hi = static_cast<wide>(std::numeric_limits<raw_type>::max());
+            count_event(FixedPointEvent::Saturation, v < lo || v > hi);
+            v = v < lo ? lo : (v > hi ? hi : v);
+        }
+        return FixedType::from_raw(static_cast<raw_type>(v));
+    }
+
+    // Forward un-twiddle of bin k from Z[k] and Z[M-k], rounded once
+    constexpr value_type split(const value_type& zk, const value_type& zm, size_t k) const {
+        const wide er = wide(zk.real.raw()) + zm.real.raw();
+        const wide ei = wide(zk.imag.raw()) - zm.imag.raw();
+        const wide dr = wide(zk.real.raw()) - zm.real.raw();
+        const wide di = wide(zk.imag.raw()) + zm.imag.raw();
+        const wide wr = m_cos[k];
+        const wide wi = m_sin[k];
+        // -j * W * D = (Im(WD), -Re(WD))
+        const wide p = wr * dr - wi * di;
+        const wide q = wr * di + wi * dr;
+        constexpr wide half = wide(1) << 30;
+        return value_type(from_wide(((er << 30) + q + half) >> 31),
+                          from_wide(((ei << 30) - p + half) >> 31));
+    }
+
+    // Inverse of split(): rebuilds Z[k] from X[k] and X[M-k]
+    constexpr value_type merge(const value_type& xk, const value_type& xc, size_t k) const {
+        const wide er = wide(xk.real.raw()) + xc.real.raw();
+        const wide ei = wide(xk.imag.raw()) - xc.imag.raw();
+        const wide dr = wide(xk.real.raw()) - xc.real.raw();
+        const wide di = wide(xk.imag.raw()) + xc.imag.raw();
+        const wide wr = m_cos[k];
+        const wide wi = m_sin[k];
+        // j * conj(W) * D = (-Im(conj(W)D), Re(conj(W)D))
+        const wide p = wr * dr + wi * di;
+        const wide q = wr * di - wi * dr;
+        constexpr wide half = wide(1) << 30;
+        return value_type(from_wide(((er << 30) - q + half) >> 31),
+                          from_wide(((ei << 30) + p + half) >> 31));
+    }
+
+    FftPlan<FixedType, M> m_fft{};
+    std::array<int32_t, M> m_cos{};
+    std::array<int32_t, M> m_sin{};
+};
+
+/**
+ * @brief Real-valued FFT into a caller-provided spectrum
+ *
+ * Computes the N/2+1 non-redundant bins with an N/2-point complex FFT.
+ */
+template<typename FixedType, size_t N>
+    requires ((N & (N - 1)) == 0 && N >= 4)
+void rfft(const std::array<FixedType, N>& real_data,
+          std::array<Complex<FixedType>, N/2 + 1>& spectrum) {
+    static const RealFftPlan<FixedType, N> plan;
+    plan.forward(real_data, spectrum);
 }
 
 /**
- * @brief Real-valued FFT (optimized for real inputs)
- * 
- * Computes FFT of real-valued signal, producing N/2+1 complex frequency bins.
- * More efficient than full complex FFT for real signals.
+ * @brief Inverse real FFT into a caller-provided buffer (spectrum is overwritten)
+ */
+template<typename FixedType, size_t N>
+    requires ((N & (N - 1)) == 0 && N >= 4)
+void irfft(std::array<Complex<FixedType>, N/2 + 1>& spectrum,
+           std::array<FixedType, N>& real_data) {
+    static const RealFftPlan<FixedType, N> plan;
+    plan.inverse(spectrum, real_data);
+}
+
+/**
+ * @brief Real-valued FFT returning the N/2+1 bins by value
  */
 template<typename FixedType, size_t N>
     requires ((N & (N - 1)) == 0 && N >= 2)
 std::array<Complex<FixedType>, N/2 + 1> rfft(const std::array<FixedType, N>& real_data) {
-    using FP = FixedType;
-    
-    // Pack real data into complex array (real in even, imag in odd conceptually)
-    std::array<Complex<FP>, N> packed;
-    for (size_t i = 0; i < N; ++i) {
-        packed[i] = Complex<FP>(real_data[i], FP(0));
-    }
-    
-    // Perform complex FFT
-    fft_radix2(packed, false);
-    
-    // Extract first N/2+1 bins (rest are conjugate symmetric)
-    std::array<Complex<FP>, N/2 + 1> result;
-    for (size_t i = 0; i <= N/2; ++i) {
-        result[i] = packed[i];
+    std::array<Complex<FixedType>, N/2 + 1> result;
+    if constexpr (N == 2) {
+        result[0] = Complex<FixedType>(real_data[0] + real_data[1]);
+        result[1] = Complex<FixedType>(real_data[0] - real_data[1]);
+    } else {
+        rfft(real_data, result);
     }
-    
     return result;
 }
 
+/**
+ * @brief out[k] = |spectrum[k]|, e.g. the magnitudes of an rfft() result
+ */
+template<typename FixedType>
+void magnitude(std::span<const Complex<std::type_identity_t<FixedType>>> spectrum,
+               std::span<FixedType> out) {
+    assert(spectrum.size() >= out.size());
+    for (size_t k = 0; k < out.size(); ++k) out[k] = spectrum[k].magnitude();
+}
+
+/**
+ * @brief Stateful direct-form FIR filter
+ *
+ * y[n] = sum(b[k] * x[n-k]) for k in [0, NumTaps). Each input sample is
+ * written into a double-length circular delay line twice, NumTaps apart, so
+ * the newest NumTaps samples always form one contiguous window and the inner
+ * loop is a plain dot product with no modulo or wrap check. Coefficients are
+ * stored time-reversed to line up with that window.
+ *
+ * Each output is one Accumulator dot product: products are summed at full
+ * precision and rounded once, then wrapped or saturated per the format's
+ * policy (see Accumulator for the headroom). Signed 16- and 32-bit formats
+ * run the SIMD dot kernels.
+ */
+template<typename FixedType, size_t NumTaps>
+    requires (NumTaps >= 1)
+class FirFilter {
+public:
+    using value_type = FixedType;
+
+    FirFilter() = default;
+
+    explicit FirFilter(const std::array<FixedType, NumTaps>& coeffs) {
+        set_coefficients(coeffs);
+    }
+
+    /**
+     * @brief Replaces the coefficients (b0 first), keeping the delay line
+     */
+    void set_coefficients(const std::array<FixedType, NumTaps>& coeffs) {
+        for (size_t k = 0; k < NumTaps; ++k) m_taps[k] = coeffs[NumTaps - 1 - k];
+    }
+
+    std::array<FixedType, NumTaps> coefficients() const {
+        std::array<FixedType, NumTaps> coeffs;
+        for (size_t k = 0; k < NumTaps; ++k) coeffs[k] = m_taps[NumTaps - 1 - k];
+        return coeffs;
+    }
+
+    /**
+     * @brief Clears the delay line
+     */
+    void reset() {
+        m_delay.fill(FixedType(0));
+        m_pos = NumTaps - 1;
+    }
+
+    /**
+     * @brief Filters one sample
+     */
+    FixedType process(FixedType x) {
+        m_pos = (m_pos + 1 == NumTaps) ? 0 : m_pos + 1;
+        m_delay[m_pos] = x;
+        m_delay[m_pos + NumTaps] = x;
+        return Accumulator<FixedType>()
+            .mac(m_taps, std::span<const FixedType>(m_delay).subspan(m_pos + 1, NumTaps))
+            .result();
+    }
+
+    /**
+     * @brief Filters a block of any length, continuing from the previous block
+     *
+     * out must hold at least in.size() samples and may alias in.
+     */
+    void process(std::span<const FixedType> in, std::span<FixedType> out) {
+        assert(out.size() >= in.size());
+        for (size_t i = 0; i < in.size(); ++i) out[i] = process(in[i]);
+    }
+
+private:
+    std::array<FixedType, NumTaps> m_taps{};
+    std::array<FixedType, 2 * NumTaps> m_delay{};
+    size_t m_pos = NumTaps - 1;
+};
+
 /**
  * @brief FIR filter (Finite Impulse Response)
  * 
- * Implements direct-form FIR filtering.
+ * Implements direct-form FIR filtering on a block with the same full-precision
+ * accumulation as FirFilter.
  * Based on CMSIS-DSP arm_fir_q31 and similar implementations.
  * 
  * @param input Input samples
  * @param output Output samples  
  * @param coeffs Filter coefficients (b0, b1, ..., bN)
- * @param state Filter state (must be initialized to zero initially)
+ * @param state Previous inputs, newest first (must be initialized to zero initially)
  */
 template<typename FixedType, size_t InputSize, size_t NumTaps>
 void fir_filter(
@@ -160,28 +763,26 @@ void fir_filter(
     const std::array<FixedType, NumTaps>& coeffs,
     std::array<FixedType, NumTaps - 1>& state)
 {
-    using FP = FixedType;
-    
-    // Process each input sample
+    constexpr size_t H = NumTaps - 1;
+
+    // Reversed taps against oldest-first history: the window for output n is
+    // history[n, H) followed by input[0, n], both contiguous
+    std::array<FixedType, NumTaps> taps;
+    for (size_t k = 0; k < NumTaps; ++k) taps[k] = coeffs[NumTaps - 1 - k];
+    std::array<FixedType, H> history;
+    for (size_t i = 0; i < H; ++i) history[i] = state[H - 1 - i];
+
     for (size_t n = 0; n < InputSize; ++n) {
-        // Shift state buffer (move old samples down)
-        for (size_t i = NumTaps - 1; i > 1; --i) {
-            state[i - 1] = state[i - 2];
-        }
-        // Insert new input at the beginning
-        if (NumTaps > 1) {
-            state[0] = input[n];
-        }
-        
-        // Compute output: y[n] = sum(b[k] * x[n-k])
-        FP acc = coeffs[0] * input[n];
-        for (size_t k = 1; k < NumTaps; ++k) {
-            if (k - 1 < state.size()) {
-                acc = acc + coeffs[k] * state[k - 1];
-            }
-        }
-        
-        output[n] = acc;
+        const size_t split = n < H ? H - n : 0;
+        const std::span<const FixedType> t(taps), hist(history), in(input);
+        Accumulator<FixedType> acc;
+        if (split > 0) acc.mac(t.first(split), hist.subspan(n, split));
+        acc.mac(t.subspan(split), in.subspan(n + split - H, NumTaps - split));
+        output[n] = acc.result();
+    }
+
+    for (size_t k = 0; k < H; ++k) {
+        state[k] = k < InputSize ? input[InputSize - 1 - k] : history[H - 1 - (k - InputSize)];
     }
 }
 
@@ -229,57 +830,298 @@ struct BiquadFilter {
 };
 
 /**
- * @brief Window functions for spectral analysis
+ * @brief Biquad realisations accepted by BiquadCascade
  */
-template<typename FixedType, size_t N>
-std::array<FixedType, N> hann_window() {
-    using FP = FixedType;
-    std::array<FP, N> window;
-    auto two_pi = constants::two_pi<FP>();
-    
-    for (size_t n = 0; n < N; ++n) {
-        // w[n] = 0.5 * (1 - cos(2*pi*n/(N-1)))
-        FP angle = two_pi * FP(static_cast<int>(n)) / FP(static_cast<int>(N - 1));
-        window[n] = FP(0.5) * (FP(1) - cos(angle));
+enum class BiquadForm {
+    DirectForm1,           // x1, x2, y1, y2 held in the data format
+    TransposedDirectForm2  // two full-precision partial sums per section
+};
+
+/**
+ * @brief One biquad section: (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+ */
+template<typename CoeffType>
+struct BiquadCoefficients {
+    CoeffType b0, b1, b2;
+    CoeffType a1, a2;
+};
+
+/**
+ * @brief Cascade of Sections biquads over Channels independent channels
+ *
+ * Samples are interleaved frames, in[n * Channels + c] for channel c. State
+ * and coefficients are kept structure-of-arrays, one row of Channels values
+ * per quantity, so each section step works across all channels at once with
+ * one SIMD lane per channel.
+ *
+ * Each section sums its five products at full precision (F_x + F_c
+ * fractional bits) in 64 bits and rounds once to the data format, then wraps
+ * or saturates per FixedType's policy. CoeffType sets the coefficient format
+ * independently of the data, e.g. Q1.30 coefficients (|a1| < 2) for Q0.31
+ * samples. Direct Form 1 keeps its history in the data format; Transposed
+ * Direct Form II carries its two states at full precision, which keeps more
+ * of the low-order bits in narrow-band sections. Coefficients start at zero.
+ *
+ * Signed 32-bit data with signed 32-bit coefficients runs the SIMD biquad
+ * kernels; other formats take the scalar path with the same results.
+ */
+template<typename FixedType, size_t Sections, size_t Channels,
+         BiquadForm Form = BiquadForm::DirectForm1, typename CoeffType = FixedType>
+    requires (FixedType::is_signed && CoeffType::is_signed &&
+              FixedType::total_bits <= 32 && CoeffType::total_bits <= 32 &&
+              Sections >= 1 && Channels >= 1)
+class BiquadCascade {
+public:
+    using value_type = FixedType;
+    using coefficient_type = CoeffType;
+    static constexpr size_t sections = Sections;
+    static constexpr size_t channels = Channels;
+    static constexpr BiquadForm form = Form;
+
+    BiquadCascade() = default;
+
+    /**
+     * @brief Sets one section's coefficients for every channel
+     */
+    void set_section(size_t section, const BiquadCoefficients<CoeffType>& c) {
+        for (size_t ch = 0; ch < Channels; ++ch) set_section(section, ch, c);
     }
-    
-    return window;
+
+    /**
+     * @brief Sets one section's coefficients for one channel
+     */
+    void set_section(size_t section, size_t channel, const BiquadCoefficients<CoeffType>& c) {
+        assert(section < Sections && channel < Channels);
+        CoeffRaw* row = m_coeffs.data() + section * 5 * Channels + channel;
+        row[0] = c.b0.raw();
+        row[Channels] = c.b1.raw();
+        row[2 * Channels] = c.b2.raw();
+        row[3 * Channels] = c.a1.raw();
+        row[4 * Channels] = c.a2.raw();
+    }
+
+    BiquadCoefficients<CoeffType> coefficients(size_t section, size_t channel) const {
+        assert(section < Sections && channel < Channels);
+        const CoeffRaw* row = m_coeffs.data() + section * 5 * Channels + channel;
+        return {CoeffType::from_raw(row[0]), CoeffType::from_raw(row[Channels]),
+                CoeffType::from_raw(row[2 * Channels]), CoeffType::from_raw(row[3 * Channels]),
+                CoeffType::from_raw(row[4 * Channels])};
+    }
+
+    /**
+     * @brief Clears every section's state
+     */
+    void reset() { m_state.fill(StateRaw(0)); }
+
+    /**
+     * @brief Filters whole frames, continuing from the previous call
+     *
+     * in.size() must be a multiple of Channels; out must hold at least as
+     * many samples and may alias in.
+     */
+    void process(std::span<const FixedType> in, std::span<FixedType> out) {
+        assert(in.size() % Channels == 0 && out.size() >= in.size());
+        for (size_t f = 0; f < in.size(); f += Channels) {
+            // Copy first so every section runs in place on out
+            if (out.data() != in.data()) {
+                std::copy_n(in.begin() + static_cast<std::ptrdiff_t>(f), Channels,
+                            out.begin() + static_cast<std::ptrdiff_t>(f));
+            }
+            DataRaw* x = reinterpret_cast<DataRaw*>(out.data() + f);
+            for (size_t s = 0; s < Sections; ++s) step(s, x);
+        }
+    }
+
+private:
+    using DataRaw = typename FixedType::raw_type;
+    using CoeffRaw = typename CoeffType::raw_type;
+    using StateRaw = std::conditional_t<Form == BiquadForm::DirectForm1, DataRaw, int64_t>;
+
+    static constexpr int F = CoeffType::fractional_bits;
+    static constexpr size_t StateRows = Form == BiquadForm::DirectForm1 ? 4 : 2;
+    static constexpr bool Saturate = FixedType::overflow_policy == OverflowPolicy::Saturate;
+
+    static_assert(sizeof(FixedType) == sizeof(DataRaw) && std::is_standard_layout_v<FixedType>);
+
+    // Products and sums modulo 2^64, matching the SIMD kernels lane for lane
+    static constexpr uint64_t product(int64_t a, int64_t b) {
+        return static_cast<uint64_t>(a * b);
+    }
+
+    static constexpr DataRaw narrow(uint64_t acc) {
+        int64_t v = static_cast<int64_t>(acc);
+        if constexpr (F > 0) v = static_cast<int64_t>(acc + (uint64_t{1} << (F - 1))) >> F;
+        if constexpr (Saturate) {
+            const int64_t clamped = std::clamp<int64_t>(v, std::numeric_limits<DataRaw>::min(),
+                                                        std::numeric_limits<DataRaw>::max());
+            count_event(FixedPointEvent::Saturation, clamped != v);
+            v = clamped;
+        }
+        return static_cast<DataRaw>(v);
+    }
+
+    void step(size_t section, DataRaw* x) {
+        const CoeffRaw* c = m_coeffs.data() + section * 5 * Channels;
+        StateRaw* st = m_state.data() + section * StateRows * Channels;
+        size_t i = 0;
+#if defined(FIXP_BATCH_HAS_SIMD)
+        // Counted builds run saturating sections in the scalar loop, which counts
+        if constexpr (std::is_same_v<DataRaw, int32_t> && std::is_same_v<CoeffRaw, int32_t> &&
+                      F >= 1 && !(Saturate && event_counters_enabled)) {
+            if constexpr (Form == BiquadForm::DirectForm1) {
+                i = batch::detail::kernels::biquad_df1(c, st, x, Channels, F, Saturate);
+            } else {
+                i = batch::detail::kernels::biquad_tdf2(c, st, x, Channels, F, Saturate);
+            }
+        }
+#endif
+        constexpr size_t N = Channels;
+        // Walk pointers to a fixed end so GCC cannot assume the kernel's count is past N
+        const DataRaw* const end = x + N;
+        for (c += i, st += i, x += i; x != end; ++x, ++c, ++st) {
+            const int64_t in = *x;
+            if constexpr (Form == BiquadForm::DirectForm1) {
+                const int64_t x1 = st[0], x2 = st[N], y1 = st[2 * N], y2 = st[3 * N];
+                const uint64_t acc = product(c[0], in) + product(c[N], x1) +
+                                     product(c[2 * N], x2) - product(c[3 * N], y1) -
+                                     product(c[4 * N], y2);
+                const DataRaw y = narrow(acc);
+                st[N] = static_cast<DataRaw>(x1);
+                st[0] = static_cast<DataRaw>(in);
+                st[3 * N] = static_cast<DataRaw>(y1);
+                st[2 * N] = y;
+                *x = y;
+            } else {
+                const DataRaw y = narrow(product(c[0], in) + static_cast<uint64_t>(st[0]));
+                const uint64_t s1 = product(c[N], in) - product(c[3 * N], y) +
+                                    static_cast<uint64_t>(st[N]);
+                const uint64_t s2 = product(c[2 * N], in) - product(c[4 * N], y);
+                st[0] = static_cast<int64_t>(s1);
+                st[N] = static_cast<int64_t>(s2);
+                *x = y;
+            }
+        }
+    }
+
+    std::array<CoeffRaw, Sections * 5 * Channels> m_coeffs{};
+    std::array<StateRaw, Sections * StateRows * Channels> m_state{};
+};
+
+/**
+ * @brief Window shapes for make_window, window_table and apply_window
+ */
+enum class Window {
+    Hann,     // 0.5 - 0.5 cos(2 pi n / (N - 1))
+    Hamming,  // 0.54 - 0.46 cos(2 pi n / (N - 1))
+    Blackman  // 0.42 - 0.5 cos(2 pi n / (N - 1)) + 0.08 cos(4 pi n / (N - 1))
+};
+
+namespace detail {
+
+// Rounded to nearest and clamped, since the peak of 1.0 may not fit FP
+template<typename FP>
+constexpr FP window_sample(double w) {
+    using raw_type = typename FP::raw_type;
+    double scale = 1.0;
+    for (int i = 0; i < FP::fractional_bits; ++i) scale *= 2.0;
+    const double scaled = w * scale;
+    if (scaled >= static_cast<double>(FP::max().raw())) return FP::max();
+    if (scaled <= static_cast<double>(FP::min().raw())) return FP::min();
+    return FP::from_raw(static_cast<raw_type>(scaled < 0 ? scaled - 0.5 : scaled + 0.5));
 }
 
-template<typename FixedType, size_t N>
-std::array<FixedType, N> hamming_window() {
-    using FP = FixedType;
-    std::array<FP, N> window;
-    auto two_pi = constants::two_pi<FP>();
-    
+} // namespace detail
+
+/**
+ * @brief Symmetric window of length N, evaluated in double and quantised once
+ *
+ * constexpr: the cosines come from a compile-time series rather than CORDIC,
+ * so a window used in a constant expression costs nothing at run time. Each
+ * sample is within half an LSB of the exact window, clamped to FixedType's
+ * range. A one-point window is 1.0.
+ */
+template<Window W, typename FixedType, size_t N>
+    requires (N >= 1)
+constexpr std::array<FixedType, N> make_window() {
+    std::array<FixedType, N> window{};
     for (size_t n = 0; n < N; ++n) {
-        // w[n] = 0.54 - 0.46 * cos(2*pi*n/(N-1))
-        FP angle = two_pi * FP(static_cast<int>(n)) / FP(static_cast<int>(N - 1));
-        window[n] = FP(0.54) - FP(0.46) * cos(angle);
+        double w = 1.0;
+        if constexpr (N > 1) {
+            const double angle = 2.0 * ::fixp::detail::TRIG_PI * static_cast<double>(n) /
+                                 static_cast<double>(N - 1);
+            const double c = ::fixp::detail::constexpr_cos(angle);
+            if constexpr (W == Window::Hann) {
+                w = 0.5 - 0.5 * c;
+            } else if constexpr (W == Window::Hamming) {
+                w = 0.54 - 0.46 * c;
+            } else {
+                w = 0.42 - 0.5 * c + 0.08 * ::fixp::detail::constexpr_cos(2.0 * angle);
+            }
+        }
+        window[n] = detail::window_sample<FixedType>(w);
     }
-    
     return window;
 }
 
+/**
+ * @brief One read-only table per window, format and length, built at compile time
+ */
+template<Window W, typename FixedType, size_t N>
+inline constexpr std::array<FixedType, N> window_table = make_window<W, FixedType, N>();
+
 template<typename FixedType, size_t N>
-std::array<FixedType, N> blackman_window() {
-    using FP = FixedType;
-    std::array<FP, N> window;
-    auto two_pi = constants::two_pi<FP>();
-    
-    for (size_t n = 0; n < N; ++n) {
-        // w[n] = 0.42 - 0.5*cos(2*pi*n/(N-1)) + 0.08*cos(4*pi*n/(N-1))
-        FP angle = two_pi * FP(static_cast<int>(n)) / FP(static_cast<int>(N - 1));
-        window[n] = FP(0.42) - FP(0.5) * cos(angle) + FP(0.08) * cos(FP(2) * angle);
-    }
-    
-    return window;
+constexpr std::array<FixedType, N> hann_window() {
+    return make_window<Window::Hann, FixedType, N>();
+}
+
+template<typename FixedType, size_t N>
+constexpr std::array<FixedType, N> hamming_window() {
+    return make_window<Window::Hamming, FixedType, N>();
+}
+
+template<typename FixedType, size_t N>
+constexpr std::array<FixedType, N> blackman_window() {
+    return make_window<Window::Blackman, FixedType, N>();
+}
+
+/**
+ * @brief data[i] *= window[i], in place
+ *
+ * window must hold at least data.size() samples. Runs the batch multiply, so
+ * results are bit-exact with the scalar operator*.
+ */
+template<typename FixedType>
+void apply_window(std::span<FixedType> data,
+                  std::span<const std::type_identity_t<FixedType>> window) {
+    batch::mul(std::span<const FixedType>(data), window, data);
+}
+
+/**
+ * @brief out[i] = in[i] * window[i], e.g. straight into an FFT input buffer
+ */
+template<typename FixedType>
+void apply_window(std::span<const std::type_identity_t<FixedType>> in,
+                  std::span<const std::type_identity_t<FixedType>> window,
+                  std::span<FixedType> out) {
+    batch::mul(in, window, out);
+}
+
+/**
+ * @brief Multiplies a frame in place by the cached window_table of its length
+ *
+ * Usage: apply_window<Window::Hann>(frame).
+ */
+template<Window W, typename FixedType, size_t N>
+void apply_window(std::array<FixedType, N>& data) {
+    apply_window(std::span<FixedType>(data),
+                 std::span<const FixedType>(window_table<W, FixedType, N>));
 }
 
 /**
  * @brief Convolution
  * 
- * Computes discrete convolution: y[n] = sum(x[k] * h[n-k])
+ * Computes discrete convolution: y[n] = sum(x[k] * h[n-k]), each output
+ * accumulated at full precision and rounded once.
  */
 template<typename FixedType, size_t XSize, size_t HSize>
 std::array<FixedType, XSize + HSize - 1> convolve(
@@ -289,17 +1131,22 @@ std::array<FixedType, XSize + HSize - 1> convolve(
     using FP = FixedType;
     constexpr size_t OutSize = XSize + HSize - 1;
     std::array<FP, OutSize> result{};
-    
+
+    // With h reversed, output n is a contiguous dot product against x
+    std::array<FP, HSize> h_rev;
+    for (size_t k = 0; k < HSize; ++k) h_rev[k] = h[HSize - 1 - k];
+
     for (size_t n = 0; n < OutSize; ++n) {
-        FP sum = FP(0);
-        for (size_t k = 0; k < HSize; ++k) {
-            if (n >= k && (n - k) < XSize) {
-                sum = sum + x[n - k] * h[k];
-            }
-        }
-        result[n] = sum;
+        const size_t k_lo = n + 1 > XSize ? n + 1 - XSize : 0;
+        const size_t k_hi = n < HSize ? n + 1 : HSize;
+        const size_t j = HSize - k_hi;
+        const size_t len = k_hi - k_lo;
+        result[n] = Accumulator<FP>()
+                        .mac(std::span<const FP>(h_rev).subspan(j, len),
+                             std::span<const FP>(x).subspan(n - (k_hi - 1), len))
+                        .result();
     }
-    
+
     return result;
 }
 
@@ -307,7 +1154,8 @@ std::array<FixedType, XSize + HSize - 1> convolve(
  * @brief Correlation
  * 
  * Computes discrete correlation: R[lag] = sum(x[n] * y[n+lag])
- * For lag in range [-(YSize-1), XSize-1]
+ * For lag in range [-(YSize-1), XSize-1], each output accumulated at full
+ * precision and rounded once.
  */
 template<typename FixedType, size_t XSize, size_t YSize>
 std::array<FixedType, XSize + YSize - 1> correlate(
@@ -317,24 +1165,344 @@ std::array<FixedType, XSize + YSize - 1> correlate(
     using FP = FixedType;
     constexpr size_t OutSize = XSize + YSize - 1;
     std::array<FP, OutSize> result{};
-    
+
     for (size_t i = 0; i < OutSize; ++i) {
-        FP sum = FP(0);
-        // lag = i - (YSize - 1), ranges from -(YSize-1) to XSize-1
-        int lag = static_cast<int>(i) - static_cast<int>(YSize - 1);
-        
-        for (size_t n = 0; n < XSize; ++n) {
-            int y_idx = static_cast<int>(n) + lag;
-            if (y_idx >= 0 && y_idx < static_cast<int>(YSize)) {
-                sum = sum + x[n] * y[y_idx];
+        // lag = i - (YSize - 1); x[n] overlaps y[n + lag] for n in [n_lo, n_hi)
+        const size_t n_lo = i < YSize - 1 ? YSize - 1 - i : 0;
+        const size_t y_lo = i < YSize - 1 ? 0 : i - (YSize - 1);
+        if (n_lo >= XSize || y_lo >= YSize) continue;
+        const size_t len = std::min(XSize - n_lo, YSize - y_lo);
+        result[i] = Accumulator<FP>()
+                        .mac(std::span<const FP>(x).subspan(n_lo, len),
+                             std::span<const FP>(y).subspan(y_lo, len))
+                        .result();
+    }
+
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// FFT convolution
+//-----------------------------------------------------------------------------
+
+namespace detail {
+
+/**
+ * @brief Spectrum of a real kernel zero-padded to N, for fast convolution
+ *
+ * apply() convolves two real blocks at once: one in the real parts of the
+ * buffer and one in the imaginary parts. Because the kernel is real,
+ * IFFT(FFT(a + jb) * H) = (a * h) + j(b * h). Transforms use block floating
+ * point, and the spectrum product is renormalised to the full raw range
+ * before the inverse. The exponents of the three steps are added up and
+ * applied in one rounding shift at the end, so precision tracks the signal
+ * level rather than the format's range.
+ */
+template<typename FixedType, size_t N>
+class FftKernel {
+public:
+    using value_type = Complex<FixedType>;
+    using plan_type = Radix4FftPlan<FixedType, N, FftScaling::BlockFloatingPoint>;
+
+    explicit FftKernel(std::span<const FixedType> h) {
+        assert(h.size() <= N);
+        for (size_t i = 0; i < h.size(); ++i) m_spectrum[i] = value_type(h[i], FixedType(0));
+        m_exponent = plan().forward(m_spectrum);
+    }
+
+    /**
+     * @brief In place; returns e such that the convolutions are data * 2^e
+     */
+    int apply(std::span<value_type, N> data) const {
+        int exponent = plan().forward(data) + m_exponent;
+
+        // First pass sizes the products; they are cheap enough to redo in the second
+        uint64_t bits = 0;
+        for (size_t k = 0; k < N; ++k) {
+            const Wide p = product(data[k], m_spectrum[k]);
+            bits |= static_cast<uint64_t>(p.re < 0 ? ~p.re : p.re);
+            bits |= static_cast<uint64_t>(p.im < 0 ? ~p.im : p.im);
+        }
+
+        // Keep one bit of headroom for the rounding; the inverse scales itself
+        const int shift = static_cast<int>(std::bit_width(bits)) - (FixedType::total_bits - 2);
+        for (size_t k = 0; k < N; ++k) {
+            const Wide p = product(data[k], m_spectrum[k]);
+            data[k] = value_type(FixedType::from_raw(narrow(p.re, shift)),
+                                 FixedType::from_raw(narrow(p.im, shift)));
+        }
+        exponent += shift + 1 - FixedType::fractional_bits;
+
+        return exponent + plan().inverse(data);
+    }
+
+    /**
+     * @brief x * 2^e, rounded and wrapped or saturated per the format's policy
+     */
+    static FixedType scale(FixedType x, int e) {
+        const int64_t v = x.raw();
+        if (e <= 0) return FixedType::from_raw(narrow(v, -e));
+        if (v == 0) return x;
+        const int64_t limit = int64_t(1) << (FixedType::total_bits - 1);
+        if constexpr (FixedType::overflow_policy == OverflowPolicy::Saturate) {
+            if (e >= FixedType::total_bits || v >= (limit >> e) || v < -(limit >> e)) {
+                count_event(FixedPointEvent::Saturation);
+                return v > 0 ? FixedType::max() : FixedType::min();
             }
+        } else if (e >= FixedType::total_bits) {
+            return FixedType::from_raw(0);
+        }
+        return FixedType::from_raw(static_cast<raw_type>(
+            static_cast<int64_t>(static_cast<uint64_t>(v) << e)));
+    }
+
+private:
+    using raw_type = typename FixedType::raw_type;
+
+    struct Wide {
+        int64_t re, im;
+    };
+
+    // a * b at 2F fractional bits, halved so both parts fit in 64 bits
+    static Wide product(const value_type& a, const value_type& b) {
+        const int64_t ar = a.real.raw(), ai = a.imag.raw();
+        const int64_t br = b.real.raw(), bi = b.imag.raw();
+        return {((ar * br) >> 1) - ((ai * bi) >> 1), ((ar * bi) >> 1) + ((ai * br) >> 1)};
+    }
+
+    static const plan_type& plan() {
+        static const plan_type p;
+        return p;
+    }
+
+    // Rounding shift by s (left when negative) and narrow to raw_type
+    static raw_type narrow(int64_t v, int s) {
+        if (s >= 63) {
+            v = 0;
+        } else if (s > 0) {
+            v = (v >> s) + ((v >> (s - 1)) & 1);
+        } else if (s < 0) {
+            v = static_cast<int64_t>(static_cast<uint64_t>(v) << -s);
+        }
+        if constexpr (FixedType::overflow_policy == OverflowPolicy::Saturate) {
+            constexpr int64_t lo = std::numeric_limits<raw_type>::min();
+            constexpr int64_t hi = std::numeric_limits<raw_type>::max();
+            count_event(FixedPointEvent::Saturation, v < lo || v > hi);
+            v = v < lo ? lo : (v > hi ? hi : v);
+        }
+        return static_cast<raw_type>(v);
+    }
+
+    std::array<value_type, N> m_spectrum{};
+    int m_exponent = 0;
+};
+
+// FFT size for convolving x_size samples with an h_size kernel: large enough
+// for the whole output when that is short, otherwise about four times the
+// kernel. Work per output sample goes as N log N / (N - H + 1), which still
+// falls noticeably from 2H to 4H; beyond that the transforms leave the cache.
+constexpr size_t fft_convolution_size(size_t x_size, size_t h_size) {
+    const size_t whole = std::bit_ceil(x_size + h_size - 1);
+    const size_t blocked = std::bit_ceil(4 * h_size);
+    return std::max<size_t>(4, std::min(whole, blocked));
+}
+
+// Cost estimates in units of one SIMD multiply-add of the direct form,
+// measured on x86: the scalar direct form is about 6 units per tap, and a
+// radix-4 butterfly point with block floating point about 64
+constexpr double direct_convolution_cost(size_t x_size, size_t h_size, bool simd) {
+    return static_cast<double>(x_size) * static_cast<double>(h_size) * (simd ? 1.0 : 6.0);
+}
+
+constexpr double fft_convolution_cost(size_t x_size, size_t h_size) {
+    const size_t n = fft_convolution_size(x_size, h_size);
+    const size_t block = n - h_size + 1;
+    const size_t pairs = (x_size + 2 * block - 1) / (2 * block);
+    const double log2n = static_cast<double>(std::countr_zero(n));
+    const double nd = static_cast<double>(n);
+    // Kernel spectrum once, then forward + inverse + spectrum product per pair
+    return 64.0 * (nd * log2n + static_cast<double>(pairs) * (2.0 * nd * log2n + 4.0 * nd));
+}
+
+} // namespace detail
+
+/**
+ * @brief Convolution by overlap-add FFT
+ *
+ * Same output as convolve() to within a few LSB of the output's peak, in
+ * O((X + H) log H) instead of O(X * H). The input is cut into blocks of
+ * N - H + 1 samples, where N is the FFT size. Two blocks go through each
+ * complex transform, one in the real part and one in the imaginary part.
+ * Requires a signed format of at most 32 bits (Radix4FftPlan).
+ */
+template<typename FixedType, size_t XSize, size_t HSize>
+    requires (FixedType::is_signed && FixedType::total_bits <= 32)
+std::array<FixedType, XSize + HSize - 1> fft_convolve(
+    const std::array<FixedType, XSize>& x,
+    const std::array<FixedType, HSize>& h)
+{
+    using FP = FixedType;
+    constexpr size_t N = detail::fft_convolution_size(XSize, HSize);
+    constexpr size_t Block = N - HSize + 1;
+    using Kernel = detail::FftKernel<FP, N>;
+
+    const Kernel kernel{std::span<const FP>(h)};
+    std::array<FP, XSize + HSize - 1> result{};
+    std::array<Complex<FP>, N> data;
+
+    for (size_t start = 0; start < XSize; start += 2 * Block) {
+        const size_t second = start + Block;
+        const size_t len_a = std::min(Block, XSize - start);
+        const size_t len_b = second < XSize ? std::min(Block, XSize - second) : 0;
+        data.fill(Complex<FP>());
+        for (size_t i = 0; i < len_a; ++i) data[i].real = x[start + i];
+        for (size_t i = 0; i < len_b; ++i) data[i].imag = x[second + i];
+
+        const int e = kernel.apply(data);
+        for (size_t i = 0; i < len_a + HSize - 1; ++i) {
+            result[start + i] = result[start + i] + Kernel::scale(data[i].real, e);
+        }
+        for (size_t i = 0; len_b > 0 && i < len_b + HSize - 1; ++i) {
+            result[second + i] = result[second + i] + Kernel::scale(data[i].imag, e);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Correlation by FFT, with the same layout as correlate()
+ *
+ * R[lag] = sum(x[n] * y[n+lag]) is the convolution of the reversed x with
+ * y, so y plays the kernel: put the shorter sequence (the template of a
+ * matched filter) in y.
+ */
+template<typename FixedType, size_t XSize, size_t YSize>
+    requires (FixedType::is_signed && FixedType::total_bits <= 32)
+std::array<FixedType, XSize + YSize - 1> fft_correlate(
+    const std::array<FixedType, XSize>& x,
+    const std::array<FixedType, YSize>& y)
+{
+    std::array<FixedType, XSize> x_rev;
+    for (size_t n = 0; n < XSize; ++n) x_rev[n] = x[XSize - 1 - n];
+    const auto conv = fft_convolve(x_rev, y);
+
+    // R[i] = conv[i + X - Y]; lags past either end have no overlap
+    std::array<FixedType, XSize + YSize - 1> result{};
+    for (size_t i = 0; i < result.size(); ++i) {
+        if (i + XSize >= YSize && i + XSize - YSize < conv.size()) {
+            result[i] = conv[i + XSize - YSize];
         }
-        result[i] = sum;
     }
-    
     return result;
 }
 
+/**
+ * @brief Whether fast_convolve() takes the FFT path for these sizes
+ *
+ * Compares the direct form, X * H multiply-adds, against two N-point
+ * transforms per 2(N - H + 1) samples. The SIMD dot kernels make the direct
+ * form cheap, so with them the FFT only pays for kernels of a few thousand
+ * taps; on scalar builds it pays from a few hundred.
+ */
+template<typename FixedType>
+constexpr bool use_fft_convolution(size_t x_size, size_t h_size) {
+    if constexpr (!FixedType::is_signed || FixedType::total_bits > 32) {
+        return false;
+    } else {
+#if defined(FIXP_BATCH_HAS_SIMD)
+        constexpr bool simd = batch::detail::simd_eligible<FixedType>;
+#else
+        constexpr bool simd = false;
+#endif
+        return detail::fft_convolution_cost(x_size, h_size) <
+               detail::direct_convolution_cost(x_size, h_size, simd);
+    }
+}
+
+/**
+ * @brief convolve() or fft_convolve(), whichever is cheaper for the sizes
+ */
+template<typename FixedType, size_t XSize, size_t HSize>
+std::array<FixedType, XSize + HSize - 1> fast_convolve(
+    const std::array<FixedType, XSize>& x,
+    const std::array<FixedType, HSize>& h)
+{
+    if constexpr (use_fft_convolution<FixedType>(XSize, HSize)) {
+        return fft_convolve(x, h);
+    } else {
+        return convolve(x, h);
+    }
+}
+
+/**
+ * @brief correlate() or fft_correlate(), whichever is cheaper for the sizes
+ */
+template<typename FixedType, size_t XSize, size_t YSize>
+std::array<FixedType, XSize + YSize - 1> fast_correlate(
+    const std::array<FixedType, XSize>& x,
+    const std::array<FixedType, YSize>& y)
+{
+    if constexpr (use_fft_convolution<FixedType>(XSize, YSize)) {
+        return fft_correlate(x, y);
+    } else {
+        return correlate(x, y);
+    }
+}
+
+/**
+ * @brief Streaming FIR filter by overlap-add FFT
+ *
+ * Produces FirFilter's output to within a few LSB, block by block, with the
+ * convolution tail of each block carried into the next. The cost per
+ * sample is O(log N) instead of O(NumTaps), where N is the smallest power of
+ * two >= BlockSize + NumTaps - 1. There is no added latency: each call returns
+ * the BlockSize outputs of its own BlockSize inputs.
+ */
+template<typename FixedType, size_t NumTaps, size_t BlockSize>
+    requires (FixedType::is_signed && FixedType::total_bits <= 32 &&
+              NumTaps >= 1 && BlockSize >= 1)
+class OverlapAddFilter {
+public:
+    using value_type = FixedType;
+    static constexpr size_t fft_size = std::max<size_t>(4, std::bit_ceil(BlockSize + NumTaps - 1));
+
+    explicit OverlapAddFilter(const std::array<FixedType, NumTaps>& coeffs)
+        : m_kernel(std::span<const FixedType>(coeffs)) {}
+
+    /**
+     * @brief Clears the carried overlap
+     */
+    void reset() { m_tail.fill(FixedType(0)); }
+
+    /**
+     * @brief Filters one block; out may alias in
+     */
+    void process(std::span<const FixedType, BlockSize> in, std::span<FixedType, BlockSize> out) {
+        m_data.fill(Complex<FixedType>());
+        for (size_t i = 0; i < BlockSize; ++i) m_data[i].real = in[i];
+        const int e = m_kernel.apply(m_data);
+
+        for (size_t i = 0; i < BlockSize; ++i) {
+            FixedType y = Kernel::scale(m_data[i].real, e);
+            out[i] = i < Tail ? y + m_tail[i] : y;
+        }
+        // New tail: this block's spill plus whatever of the old tail reaches past it
+        for (size_t i = 0; i < Tail; ++i) {
+            FixedType y = Kernel::scale(m_data[BlockSize + i].real, e);
+            m_tail[i] = i + BlockSize < Tail ? y + m_tail[i + BlockSize] : y;
+        }
+    }
+
+private:
+    using Kernel = detail::FftKernel<FixedType, fft_size>;
+    static constexpr size_t Tail = NumTaps - 1;
+
+    Kernel m_kernel;
+    std::array<FixedType, Tail> m_tail{};
+    std::array<Complex<FixedType>, fft_size> m_data{};
+};
+
 } // namespace dsp
 } // namespace fixp
 
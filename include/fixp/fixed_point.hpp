@@ -0,0 +1,17 @@
+#ifndef FIXP_FIXED_POINT_HPP
+#define FIXP_FIXED_POINT_HPP
+
+#include <libfixp/fixed_point.hpp>
+
+/**
+ * @brief The fixp headers build on the core library
+ *
+ * FixedPoint, the overflow policies and the rest of libfixp are visible in
+ * fixp unqualified. fixp::detail is its own namespace; the core's helpers are
+ * libfixp::detail.
+ */
+namespace fixp {
+using namespace libfixp;
+}
+
+#endif // FIXP_FIXED_POINT_HPP
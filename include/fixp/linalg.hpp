@@ -0,0 +1,555 @@
+#ifndef FIXP_LINALG_HPP
+#define FIXP_LINALG_HPP
+
+#include "fixed_point.hpp"
+#include "accumulator.hpp"
+#include "batch.hpp"
+#include "math.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace fixp {
+namespace linalg {
+
+/**
+ * @brief Small vectors, matrices and quantized matrix products
+ *
+ * Vec and Mat are fixed-size value types. Every product sums its terms in an
+ * Accumulator and rounds once, so m * v equals dot() of each row with v and
+ * does not depend on the kernel that computed it. transform() runs 4 x 4
+ * products on the SIMD kernels for signed 32-bit formats.
+ *
+ * qgemm() multiplies int8 activations (q0_7_t, or any int8 quantization) by
+ * weights packed once into a PackedMatrix, with 32-bit accumulation, an
+ * optional int32 bias and per-tensor or per-channel requantization. It runs
+ * VNNI vpdpbusd on x86 targets that have it, AVX2 vpmaddwd otherwise, and
+ * SDOT (or vmull_s8) on AArch64. The int32 sums wrap modulo 2^32 the same
+ * way on every path; they are exact while k * 2^14 fits, i.e. k < 131072.
+ */
+
+/**
+ * @brief N elements of FP
+ */
+template<FixedPointType FP, size_t N>
+struct Vec {
+    std::array<FP, N> elements{};
+
+    static constexpr size_t size() { return N; }
+
+    constexpr FP& operator[](size_t i) { return elements[i]; }
+    constexpr const FP& operator[](size_t i) const { return elements[i]; }
+
+    constexpr FP* data() { return elements.data(); }
+    constexpr const FP* data() const { return elements.data(); }
+    constexpr auto begin() { return elements.begin(); }
+    constexpr auto begin() const { return elements.begin(); }
+    constexpr auto end() { return elements.end(); }
+    constexpr auto end() const { return elements.end(); }
+
+    constexpr Vec& operator+=(const Vec& other) {
+        for (size_t i = 0; i < N; ++i) elements[i] = elements[i] + other.elements[i];
+        return *this;
+    }
+
+    constexpr Vec& operator-=(const Vec& other) {
+        for (size_t i = 0; i < N; ++i) elements[i] = elements[i] - other.elements[i];
+        return *this;
+    }
+
+    constexpr Vec& operator*=(FP s) {
+        for (auto& e : elements) e = e * s;
+        return *this;
+    }
+
+    friend constexpr Vec operator+(Vec a, const Vec& b) { return a += b; }
+    friend constexpr Vec operator-(Vec a, const Vec& b) { return a -= b; }
+    friend constexpr Vec operator*(Vec a, FP s) { return a *= s; }
+    friend constexpr Vec operator*(FP s, Vec a) { return a *= s; }
+
+    friend constexpr Vec operator-(Vec a) {
+        for (auto& e : a.elements) e = -e;
+        return a;
+    }
+
+    friend constexpr bool operator==(const Vec&, const Vec&) = default;
+};
+
+/**
+ * @brief R x C matrix of FP, stored row-major
+ */
+template<FixedPointType FP, size_t R, size_t C>
+struct Mat {
+    std::array<FP, R * C> elements{};
+
+    static constexpr size_t rows() { return R; }
+    static constexpr size_t cols() { return C; }
+
+    static constexpr Mat identity()
+        requires(R == C)
+    {
+        Mat m;
+        for (size_t i = 0; i < R; ++i) m(i, i) = FP::one();
+        return m;
+    }
+
+    constexpr FP& operator()(size_t r, size_t c) { return elements[r * C + c]; }
+    constexpr const FP& operator()(size_t r, size_t c) const { return elements[r * C + c]; }
+
+    constexpr std::span<const FP, C> row(size_t r) const {
+        return std::span<const FP, C>(elements.data() + r * C, C);
+    }
+
+    friend constexpr Mat operator+(Mat a, const Mat& b) {
+        for (size_t i = 0; i < R * C; ++i) a.elements[i] = a.elements[i] + b.elements[i];
+        return a;
+    }
+
+    friend constexpr Mat operator-(Mat a, const Mat& b) {
+        for (size_t i = 0; i < R * C; ++i) a.elements[i] = a.elements[i] - b.elements[i];
+        return a;
+    }
+
+    friend constexpr bool operator==(const Mat&, const Mat&) = default;
+};
+
+template<FixedPointType FP, size_t R, size_t C>
+constexpr Mat<FP, C, R> transpose(const Mat<FP, R, C>& m) {
+    Mat<FP, C, R> t;
+    for (size_t r = 0; r < R; ++r) {
+        for (size_t c = 0; c < C; ++c) t(c, r) = m(r, c);
+    }
+    return t;
+}
+
+/**
+ * @brief m * v, each element rounded once
+ */
+template<FixedPointType FP, size_t R, size_t C>
+constexpr Vec<FP, R> operator*(const Mat<FP, R, C>& m, const Vec<FP, C>& v) {
+    Vec<FP, R> out;
+    for (size_t r = 0; r < R; ++r) {
+        out[r] = Accumulator<FP>().mac(m.row(r), std::span<const FP>(v.elements)).result();
+    }
+    return out;
+}
+
+/**
+ * @brief a * b, each element rounded once
+ */
+template<FixedPointType FP, size_t R, size_t K, size_t C>
+constexpr Mat<FP, R, C> operator*(const Mat<FP, R, K>& a, const Mat<FP, K, C>& b) {
+    const auto bt = transpose(b);
+    Mat<FP, R, C> out;
+    for (size_t r = 0; r < R; ++r) {
+        for (size_t c = 0; c < C; ++c) {
+            out(r, c) = Accumulator<FP>().mac(a.row(r), bt.row(c)).result();
+        }
+    }
+    return out;
+}
+
+//-----------------------------------------------------------------------------
+// 4 x 4 transforms
+//
+// Homogeneous transforms act on column vectors (x, y, z, w): m * v applies
+// m, and a * b applies b first.
+//-----------------------------------------------------------------------------
+
+template<FixedPointType FP>
+constexpr Mat<FP, 4, 4> translation(FP x, FP y, FP z) {
+    auto m = Mat<FP, 4, 4>::identity();
+    m(0, 3) = x;
+    m(1, 3) = y;
+    m(2, 3) = z;
+    return m;
+}
+
+template<FixedPointType FP>
+constexpr Mat<FP, 4, 4> scaling(FP x, FP y, FP z) {
+    auto m = Mat<FP, 4, 4>::identity();
+    m(0, 0) = x;
+    m(1, 1) = y;
+    m(2, 2) = z;
+    return m;
+}
+
+/**
+ * @brief Rotation by angle radians about the z axis, x toward y
+ */
+template<FixedPointType FP>
+    requires requires(FP a) { fixp::sincos(a); }
+constexpr Mat<FP, 4, 4> rotation_z(FP angle) {
+    const auto sc = fixp::sincos(angle);
+    auto m = Mat<FP, 4, 4>::identity();
+    m(0, 0) = sc.cos;
+    m(0, 1) = -sc.sin;
+    m(1, 0) = sc.sin;
+    m(1, 1) = sc.cos;
+    return m;
+}
+
+/**
+ * @brief out[i] = m * in[i], e.g. every vertex of a mesh or corner of a layer
+ *
+ * Bit-identical to m * in[i]; in may alias out.
+ */
+template<FixedPointType FP>
+void transform(const Mat<FP, 4, 4>& m, std::span<const std::type_identity_t<Vec<FP, 4>>> in,
+               std::span<Vec<FP, 4>> out) {
+    assert(in.size() >= out.size());
+    size_t i = 0;
+#if defined(FIXP_BATCH_HAS_SIMD)
+    if constexpr (batch::detail::simd_eligible<FP> &&
+                  std::is_same_v<typename FP::raw_type, int32_t> &&
+                  sizeof(Vec<FP, 4>) == 4 * sizeof(FP) && std::is_standard_layout_v<Vec<FP, 4>>) {
+        i = resolve_policy<FP::overflow_policy>([&](auto policy) -> size_t {
+            constexpr OverflowPolicy P = decltype(policy)::policy;
+            if constexpr (batch::detail::simd_policy<P>) {
+                // Vec is its array of FP, so the vectors are 4n consecutive raw values
+                return batch::detail::kernels::transform4x4(
+                    batch::detail::raw_ptr(std::span<const FP>(m.elements)),
+                    reinterpret_cast<const int32_t*>(in.data()),
+                    reinterpret_cast<int32_t*>(out.data()), out.size(), FP::fractional_bits,
+                    batch::detail::saturates<P>);
+            }
+            return 0;
+        });
+    }
+#endif
+    for (; i < out.size(); ++i) out[i] = m * in[i];
+}
+
+//-----------------------------------------------------------------------------
+// Quantized int8 GEMM
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief int32 accumulator to int8: acc * multiplier / 2^(31 + shift), rounded, saturated
+ *
+ * multiplier / 2^31 is a Q0.31 fraction, normally in [0.5, 1), and
+ * 31 + shift must be in [1, 62]. Rounding is to nearest, ties toward
+ * +infinity, as FixedPoint's products round. The defaults are the identity.
+ */
+struct Requantization {
+    int32_t multiplier = int32_t{1} << 30;
+    int shift = -1;
+
+    /**
+     * @brief The multiplier and shift nearest to a real scale in [2^-32, 2^30)
+     *
+     * Powers of two are exact: 2^-7 gives multiplier 2^30, shift 6.
+     */
+    static Requantization from_scale(double scale) {
+        assert(scale > 0 && std::isfinite(scale));
+        int exponent = 0;
+        const double fraction = std::frexp(scale, &exponent);
+        int64_t multiplier = std::llround(std::ldexp(fraction, 31));
+        if (multiplier == int64_t{1} << 31) {
+            multiplier >>= 1;
+            ++exponent;
+        }
+        assert(exponent >= -31 && exponent <= 30);
+        return Requantization{static_cast<int32_t>(multiplier), -exponent};
+    }
+
+    constexpr int8_t apply(int32_t acc) const {
+        const int total = 31 + shift;
+        assert(total >= 1 && total <= 62);
+        const int64_t p = int64_t{acc} * multiplier + (int64_t{1} << (total - 1));
+        return static_cast<int8_t>(std::clamp<int64_t>(p >> total, INT8_MIN, INT8_MAX));
+    }
+};
+
+/**
+ * @brief k x n int8 weights, packed once for qgemm()
+ *
+ * Panels of 16 columns, k padded with zeros to a multiple of 4, in the
+ * layout the gemm_s8_tile kernels read, plus each column's sum.
+ */
+class PackedMatrix {
+public:
+    static constexpr size_t panel_width = 16;
+
+    PackedMatrix() = default;
+
+    /**
+     * @brief Packs the row-major k x n matrix w
+     */
+    static PackedMatrix from_rows(std::span<const int8_t> w, size_t k, size_t n) {
+        assert(w.size() >= k * n);
+        return PackedMatrix(k, n, [&](size_t kk, size_t j) { return w[kk * n + j]; });
+    }
+
+    /**
+     * @brief Packs the k x n matrix stored as its n x k transpose, one output channel per row
+     */
+    static PackedMatrix from_columns(std::span<const int8_t> wt, size_t k, size_t n) {
+        assert(wt.size() >= k * n);
+        return PackedMatrix(k, n, [&](size_t kk, size_t j) { return wt[j * k + kk]; });
+    }
+
+    size_t rows() const { return m_rows; }
+    size_t cols() const { return m_cols; }
+
+    /**
+     * @brief Number of groups of 4 rows, k / 4 rounded up
+     */
+    size_t groups() const { return m_groups; }
+
+    size_t panels() const { return (m_cols + panel_width - 1) / panel_width; }
+
+    const int8_t* panel(size_t p) const { return m_data.data() + p * m_groups * 4 * panel_width; }
+
+    /**
+     * @brief Sum of each column, zero for the padding columns of the last panel
+     */
+    std::span<const int32_t> column_sums() const { return m_sums; }
+
+private:
+    template<typename At>
+    PackedMatrix(size_t k, size_t n, At at)
+        : m_rows(k), m_cols(n), m_groups((k + 3) / 4),
+          m_data(panels() * m_groups * 4 * panel_width), m_sums(panels() * panel_width) {
+        for (size_t j = 0; j < n; ++j) {
+            int8_t* column = m_data.data() + (j / panel_width) * m_groups * 4 * panel_width +
+                             (j % panel_width) * 4;
+            for (size_t kk = 0; kk < k; ++kk) {
+                const int8_t v = at(kk, j);
+                column[(kk / 4) * 4 * panel_width + kk % 4] = v;
+                m_sums[j] += v;
+            }
+        }
+    }
+
+    size_t m_rows = 0;
+    size_t m_cols = 0;
+    size_t m_groups = 0;
+    std::vector<int8_t> m_data;
+    std::vector<int32_t> m_sums;
+};
+
+namespace detail {
+
+// Compile-time selection, as for the batch kernels
+#if defined(FIXP_SIMD_X86) && defined(__AVX512VNNI__) && defined(__AVX512BW__)
+namespace gemm_kernels = ::fixp::simd::avx512vnni;
+#elif defined(FIXP_SIMD_X86) && defined(__AVXVNNI__)
+namespace gemm_kernels = ::fixp::simd::avxvnni;
+#elif defined(FIXP_SIMD_X86) && defined(__AVX2__)
+namespace gemm_kernels = ::fixp::simd::avx2;
+#elif defined(FIXP_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+namespace gemm_kernels = ::fixp::simd::neon;
+#else
+namespace gemm_kernels {
+
+inline constexpr int gemm_a_offset = 0;
+
+inline void gemm_s8_tile(const int8_t* a, size_t a_stride, const int8_t* b, size_t k4,
+                         int32_t* acc) {
+    uint32_t sum[64];
+    for (size_t t = 0; t < 64; ++t) sum[t] = static_cast<uint32_t>(acc[t]);
+    for (size_t k = 0; k < 4 * k4; ++k) {
+        const int8_t* bk = b + (k / 4) * 64 + k % 4;
+        for (size_t r = 0; r < 4; ++r) {
+            const int ak = a[r * a_stride + k];
+            for (size_t j = 0; j < 16; ++j) sum[16 * r + j] += static_cast<uint32_t>(ak * bk[4 * j]);
+        }
+    }
+    for (size_t t = 0; t < 64; ++t) acc[t] = static_cast<int32_t>(sum[t]);
+}
+
+} // namespace gemm_kernels
+#endif
+
+inline constexpr size_t gemm_mr = 4;
+// Groups of 4 k per pass: 4 KiB of each panel, which stays in L1 while
+// every row block of x streams past it
+inline constexpr size_t gemm_kc = 64;
+
+// x (m x w.rows()) times w, starting every column at bias[j] (or 0), then
+// emit(i, j, sum) for every element
+template<typename Emit>
+void gemm_s8(const int8_t* x, size_t m, const PackedMatrix& w, const int32_t* bias, Emit emit) {
+    constexpr size_t MR = gemm_mr, NR = PackedMatrix::panel_width;
+    constexpr size_t Tile = MR * NR;
+    const size_t k = w.rows(), n = w.cols(), panels = w.panels();
+    const size_t stride = 4 * w.groups();
+    const size_t blocks = (m + MR - 1) / MR;
+
+    // x with each row padded to whole groups and whole row blocks, offset
+    // as the kernels read it
+    constexpr int offset = gemm_kernels::gemm_a_offset;
+    std::vector<int8_t> a(blocks * MR * stride, static_cast<int8_t>(offset));
+    for (size_t i = 0; i < m; ++i) {
+        std::transform(x + i * k, x + (i + 1) * k, a.data() + i * stride,
+                       [](int8_t v) { return static_cast<int8_t>(v ^ offset); });
+    }
+
+    const auto sums = w.column_sums();
+    std::vector<int32_t> tiles(blocks * panels * Tile);
+    for (size_t t = 0; t < blocks * panels; ++t) {
+        const size_t j0 = (t % panels) * NR;
+        for (size_t r = 0; r < MR; ++r) {
+            for (size_t j = 0; j < NR; ++j) {
+                const uint32_t start = bias && j0 + j < n ? static_cast<uint32_t>(bias[j0 + j]) : 0;
+                tiles[t * Tile + r * NR + j] = static_cast<int32_t>(
+                    start - uint32_t{offset} * static_cast<uint32_t>(sums[j0 + j]));
+            }
+        }
+    }
+
+    for (size_t g0 = 0; g0 < w.groups(); g0 += gemm_kc) {
+        const size_t groups = std::min(gemm_kc, w.groups() - g0);
+        for (size_t p = 0; p < panels; ++p) {
+            const int8_t* b = w.panel(p) + g0 * 4 * NR;
+            for (size_t blk = 0; blk < blocks; ++blk) {
+                gemm_kernels::gemm_s8_tile(a.data() + blk * MR * stride + 4 * g0, stride, b,
+                                           groups, tiles.data() + (blk * panels + p) * Tile);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            emit(i, j, tiles[((i / MR) * panels + j / NR) * Tile + (i % MR) * NR + j % NR]);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief acc = x * w
+ *
+ * x is m x w.rows() and acc m x w.cols(), both row-major.
+ */
+inline void qgemm(std::span<const int8_t> x, size_t m, const PackedMatrix& w,
+                  std::span<int32_t> acc) {
+    assert(x.size() >= m * w.rows() && acc.size() >= m * w.cols());
+    const size_t n = w.cols();
+    detail::gemm_s8(x.data(), m, w, nullptr,
+                    [&](size_t i, size_t j, int32_t sum) { acc[i * n + j] = sum; });
+}
+
+/**
+ * @brief y = requantized x * w + bias
+ *
+ * bias is empty or holds one int32 per column, at the accumulator's scale;
+ * requant holds one Requantization for the whole tensor or one per column.
+ */
+inline void qgemm(std::span<const int8_t> x, size_t m, const PackedMatrix& w,
+                  std::span<const int32_t> bias, std::span<const Requantization> requant,
+                  std::span<int8_t> y) {
+    const size_t n = w.cols();
+    assert(x.size() >= m * w.rows() && y.size() >= m * n);
+    assert(bias.empty() || bias.size() == n);
+    assert(requant.size() == 1 || requant.size() == n);
+    const size_t per_channel = requant.size() == 1 ? 0 : 1;
+    detail::gemm_s8(x.data(), m, w, bias.empty() ? nullptr : bias.data(),
+                    [&](size_t i, size_t j, int32_t sum) {
+                        y[i * n + j] = requant[j * per_channel].apply(sum);
+                    });
+}
+
+/**
+ * @brief y = requantized x * w + bias for a single row x
+ */
+inline void qgemv(std::span<const int8_t> x, const PackedMatrix& w, std::span<const int32_t> bias,
+                  std::span<const Requantization> requant, std::span<int8_t> y) {
+    qgemm(x, 1, w, bias, requant, y);
+}
+
+//-----------------------------------------------------------------------------
+// FixedPoint GEMM and GEMV
+//-----------------------------------------------------------------------------
+
+namespace detail {
+
+template<typename FP>
+inline constexpr bool int8_format =
+    FP::is_signed && std::is_same_v<typename FP::raw_type, int8_t> && sizeof(FP) == 1 &&
+    std::is_standard_layout_v<FP>;
+
+// Largest k whose int32 sum of int8 products cannot wrap
+inline constexpr size_t exact_int8_depth = (size_t{1} << 17) - 1;
+
+} // namespace detail
+
+/**
+ * @brief c = a * b, row-major with a m x k, b k x n and c m x n
+ *
+ * Every element is the Accumulator sum of its row and column, rounded once,
+ * so gemm() agrees with dot() bit for bit. Signed 8-bit formats run on the
+ * int8 GEMM kernels; other formats tile the SIMD dot products over blocks
+ * of b's columns.
+ */
+template<FixedPointType FP>
+void gemm(batch::input_span<FP> a, batch::input_span<FP> b, std::span<FP> c, size_t m, size_t k,
+          size_t n) {
+    assert(a.size() >= m * k && b.size() >= k * n && c.size() >= m * n);
+    using batch::detail::raw_ptr;
+    if constexpr (detail::int8_format<FP>) {
+        if (k <= detail::exact_int8_depth) {
+            const auto w = PackedMatrix::from_rows(std::span(raw_ptr(b), k * n), k, n);
+            resolve_policy<FP::overflow_policy>([&](auto policy) {
+                constexpr OverflowPolicy P = decltype(policy)::policy;
+                constexpr int F = FP::fractional_bits;
+                detail::gemm_s8(raw_ptr(a), m, w, nullptr, [&](size_t i, size_t j, int32_t sum) {
+                    int64_t v = sum;
+                    if constexpr (F > 0) v = (v + (int64_t{1} << (F - 1))) >> F;
+                    c[i * n + j] = FP::from_raw(overflow_cast<int8_t, P>(v, "gemm"));
+                });
+            });
+            return;
+        }
+    }
+
+    constexpr size_t KC = 256, NC = 32;
+    std::vector<FP> bt(k * n);
+    for (size_t kk = 0; kk < k; ++kk) {
+        for (size_t j = 0; j < n; ++j) bt[j * k + kk] = b[kk * n + j];
+    }
+    std::vector<Accumulator<FP>> acc(m * NC);
+    for (size_t j0 = 0; j0 < n; j0 += NC) {
+        const size_t cols = std::min(NC, n - j0);
+        for (auto& s : acc) s.reset();
+        for (size_t k0 = 0; k0 < k; k0 += KC) {
+            const size_t depth = std::min(KC, k - k0);
+            for (size_t i = 0; i < m; ++i) {
+                const auto row = a.subspan(i * k + k0, depth);
+                for (size_t j = 0; j < cols; ++j) {
+                    acc[i * NC + j].mac(row, std::span<const FP>(bt).subspan((j0 + j) * k + k0,
+                                                                            depth));
+                }
+            }
+        }
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < cols; ++j) c[i * n + j0 + j] = acc[i * NC + j].result();
+        }
+    }
+}
+
+/**
+ * @brief y = a * x, with a m x k row-major; each element is dot() of a row and x
+ */
+template<FixedPointType FP>
+void gemv(batch::input_span<FP> a, batch::input_span<FP> x, std::span<FP> y) {
+    const size_t k = x.size();
+    assert(a.size() >= y.size() * k);
+    for (size_t i = 0; i < y.size(); ++i) {
+        y[i] = Accumulator<FP>().mac(a.subspan(i * k, k), x).result();
+    }
+}
+
+} // namespace linalg
+} // namespace fixp
+
+#endif // FIXP_LINALG_HPP
@@ -2,9 +2,15 @@
 #define FIXP_MATH_HPP
 
 #include "fixed_point.hpp"
+#include "batch.hpp"
+#include "cordic.hpp"
+#include <array>
 #include <cstdint>
 #include <bit>
 #include <cassert>
+#include <span>
+#include <utility>
+#include <type_traits>
 
 namespace fixp {
 
@@ -152,323 +158,1039 @@ inline auto round(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
 }
 
 //
-// Square root using Newton-Raphson iteration
+// Square root and reciprocal square root
 //
-template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-inline auto sqrt(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
-    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    using raw_type = typename FP::raw_type;
-    
-    if (x <= FP::zero()) {
-        return FP::zero();
+namespace detail {
+    template<typename U>
+    constexpr int wide_bit_width(U v) {
+        if constexpr (sizeof(U) > 8) {
+            const auto hi = static_cast<uint64_t>(v >> 64);
+            return hi != 0 ? 64 + static_cast<int>(std::bit_width(hi))
+                           : static_cast<int>(std::bit_width(static_cast<uint64_t>(v)));
+        } else {
+            return static_cast<int>(std::bit_width(static_cast<uint64_t>(v)));
+        }
     }
-    
-    auto raw = x.raw();
-    
-    // Find highest bit position
-    int bit_pos = std::bit_width(static_cast<std::make_unsigned_t<raw_type>>(raw)) - 1;
-    
-    // Initial guess: 2^((bit_pos + FracBits)/2 - FracBits) = 2^((bit_pos - FracBits)/2)
-    // This gives us sqrt(2^bit_pos) in fixed-point
-    raw_type guess = raw_type(1) << ((bit_pos + FracBits) / 2);
-    
-    // Newton-Raphson: x_new = (x_old + N/x_old) / 2
-    // In fixed-point: x_new = (x_old + (N << FracBits) / x_old) >> 1
-    for (int i = 0; i < 5; ++i) {
-        if (guess == 0) break;
-        using wide_type = storage_t<(TotalBits <= 32 ? TotalBits * 2 : 128), Signed>;
-        wide_type num = static_cast<wide_type>(raw) << FracBits;
-        raw_type div = static_cast<raw_type>(num / guess);
-        guess = (guess + div) >> 1;
+
+    /**
+     * @brief round(sqrt(v)) one result bit per step
+     *
+     * Shifts, adds and compares only, for cores where even multiplies are
+     * slow. The remainder left in v decides the rounding.
+     */
+    template<typename U>
+    constexpr U isqrt_digits(U v) {
+        U r = 0;
+        for (U bit = v == 0 ? U(0) : U(1) << ((wide_bit_width(v) - 1) & ~1); bit != 0; bit >>= 2) {
+            const bool take = v >= r + bit;
+            v = take ? v - (r + bit) : v;
+            r = take ? (r >> 1) + bit : r >> 1;
+        }
+        // v > r means the input exceeds (r + 1/2)^2
+        return v > r ? r + 1 : r;
     }
-    
-    return FP::from_raw(guess);
-}
 
-//
-// CORDIC-based trigonometric functions
-//
-namespace detail {
-    // CORDIC constants for 32-bit with 16 fractional bits
-    // K ≈ 0.60725293500888 (CORDIC gain)
-    constexpr int32_t CORDIC_K_Q16 = 39797; // K * 2^16
-    
-    // Arctangent table: atan(2^-i) for i = 0 to 15
-    constexpr int32_t CORDIC_ATAN_TABLE_Q16[] = {
-        51472,  // atan(2^0)  ≈ 0.7854 rad (45°)
-        30386,  // atan(2^-1) ≈ 0.4636 rad
-        16055,  // atan(2^-2) ≈ 0.2450 rad
-        8150,   // atan(2^-3) ≈ 0.1244 rad
-        4091,   // atan(2^-4)
-        2047,   // atan(2^-5)
-        1024,   // atan(2^-6)
-        512,    // atan(2^-7)
-        256,    // atan(2^-8)
-        128,    // atan(2^-9)
-        64,     // atan(2^-10)
-        32,     // atan(2^-11)
-        16,     // atan(2^-12)
-        8,      // atan(2^-13)
-        4,      // atan(2^-14)
-        2       // atan(2^-15)
-    };
-    
-    // CORDIC rotation mode: compute sin and cos
-    template<typename raw_type>
-    void cordic_rotation(raw_type& x, raw_type& y, raw_type z, int iterations) {
-        x = CORDIC_K_Q16;
-        y = 0;
-        
-        for (int i = 0; i < iterations && i < 16; ++i) {
-            raw_type x_new, y_new, z_new;
-            
-            if (z >= 0) {
-                x_new = x - (y >> i);
-                y_new = y + (x >> i);
-                z_new = z - CORDIC_ATAN_TABLE_Q16[i];
-            } else {
-                x_new = x + (y >> i);
-                y_new = y - (x >> i);
-                z_new = z + CORDIC_ATAN_TABLE_Q16[i];
-            }
-            
-            x = x_new;
-            y = y_new;
-            z = z_new;
+    // 1/sqrt(m) in Q31 at the midpoint of each 1/64 step of m in [1, 4):
+    // 2^31 / sqrt((2i + 1) / 128) = sqrt(2^69 / (2i + 1)), good to 8 bits
+    inline constexpr std::array<uint32_t, 192> RSQRT_SEEDS = [] {
+        std::array<uint32_t, 192> t{};
+        for (size_t i = 0; i < t.size(); ++i) {
+            t[i] = static_cast<uint32_t>(
+                isqrt_digits((uint128(1) << 69) / (2 * (i + 64) + 1)));
+        }
+        return t;
+    }();
+
+    /**
+     * @brief 1/sqrt(m) in Q63 for m in Q62, m in [1, 4)
+     *
+     * Table seed plus divide-free Newton steps y = y (3 - m y^2) / 2, each
+     * doubling the correct bits: 2 steps give 2^-30, 3 give 2^-59. Every
+     * product is 64 x 64 -> 128 bits.
+     */
+    template<int Iterations>
+    constexpr uint128 rsqrt_q63(uint64_t m) {
+        uint128 y = uint128(RSQRT_SEEDS[(m >> 56) - 64]) << 32;
+        for (int i = 0; i < Iterations; ++i) {
+            const uint128 u = (m * ((y * y) >> 63)) >> 63; // m y^2 in Q62
+            y = (y * ((uint128(3) << 62) - u)) >> 63;
         }
+        return y;
     }
-    
-    // CORDIC vectoring mode: compute atan2
-    template<typename raw_type>
-    raw_type cordic_vectoring(raw_type x, raw_type y, int iterations) {
-        raw_type z = 0;
-        
-        for (int i = 0; i < iterations && i < 16; ++i) {
-            raw_type x_new, y_new, z_new;
-            
-            if (y < 0) {
-                x_new = x - (y >> i);
-                y_new = y + (x >> i);
-                z_new = z - CORDIC_ATAN_TABLE_Q16[i];
-            } else {
-                x_new = x + (y >> i);
-                y_new = y - (x >> i);
-                z_new = z + CORDIC_ATAN_TABLE_Q16[i];
-            }
-            
-            x = x_new;
-            y = y_new;
-            z = z_new;
+
+    /**
+     * @brief round(sqrt(v)) as v * rsqrt(v), without divides
+     *
+     * The estimate is within one of the root, so a single exact square
+     * fixes the last bit and the result matches isqrt_digits(). Two Newton
+     * steps are enough for v < 2^56.
+     */
+    template<int Iterations, typename U>
+    constexpr U isqrt_newton(U v) {
+        if (v == 0) return 0;
+        // v = m 2^e with m in [1, 4)
+        const int e = (wide_bit_width(v) - 1) & ~1;
+        const auto m = static_cast<uint64_t>(e >= 62 ? v >> (e - 62) : v << (62 - e));
+        const uint128 y = rsqrt_q63<Iterations>(m);
+        U s = static_cast<U>((m * y) >> (125 - e / 2));
+        constexpr U limit = (U(1) << (4 * sizeof(U))) - 1;
+        if constexpr (sizeof(U) > 8) {
+            // m dropped bits and y carries 2^-59, so s is off by up to 2^(e/2 - 58):
+            // one Newton step s += (v - s^2) / (2s) with 1/s from y
+            s = s > limit ? limit : s;
+            const auto d = static_cast<int128>(v - s * s);
+            const auto y31 = static_cast<int128>(y >> 32);
+            s = static_cast<U>(static_cast<int128>(s) + ((d * y31) >> (32 + e / 2)));
         }
-        
-        return z;
+        s = s > limit ? limit : s;
+        s = s * s > v ? s - 1 : s;
+        s = v - s * s > 2 * s ? s + 1 : s; // (s + 1)^2 <= v
+        return v - s * s > s ? s + 1 : s;
+    }
+
+    /**
+     * @brief rsqrt_q63<3>(m) refined by one more Newton step, in Q64
+     *
+     * y is good to 2^-59, a few LSBs short of a 64-bit result. The residual
+     * 1 - m y^2 is under 2^-57, so it is formed modulo 2^128 from the low
+     * product bits, and the step lands within one unit of Q64.
+     */
+    constexpr uint128 rsqrt_q64(uint64_t m, uint128 y) {
+        const uint128 y2 = (y * y) >> 60; // Q66
+        const auto d = static_cast<int128>(-(m * y2)) >> 40; // 1 - m y^2 in Q88
+        const int128 step = (static_cast<int128>(y) * d + (int128(1) << 87)) >> 88;
+        return static_cast<uint128>(static_cast<int128>(y << 1) + step);
+    }
+
+    template<int OperandBits>
+    inline constexpr int newton_steps = OperandBits <= 56 ? 2 : 3;
+
+    template<typename FP>
+    using sqrt_operand_t = std::conditional_t<FP::total_bits + FP::fractional_bits <= 64,
+                                              uint64_t, uint128>;
+
+    template<typename FP, typename U>
+    constexpr FP saturate_root(U r) {
+        const auto hi = static_cast<U>(FP::max().raw());
+        count_event(FixedPointEvent::Saturation, r > hi);
+        return FP::from_raw(static_cast<typename FP::raw_type>(r > hi ? hi : r));
     }
 }
 
-// Sin and Cos for Q15_16 format (32-bit, 16 fractional)
-// Input angle in radians
+/**
+ * @brief Square root, rounded to nearest; 0 for x <= 0
+ *
+ * Computed as x * rsqrt(x) on the integer raw * 2^FracBits: a table seed
+ * and two or three Newton steps, all multiplies, then one exact correction.
+ * There are no divides, and the result is correctly rounded.
+ */
 template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-    requires (TotalBits == 32 && FracBits == 16)
-inline auto sin(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
+    requires (TotalBits + FracBits <= 128)
+constexpr auto sqrt(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
     using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    using raw_type = typename FP::raw_type;
-    
-    // Range reduction to [-π, π]
-    auto pi = constants::pi<FP>();
-    auto two_pi_val = constants::two_pi<FP>();
-    
-    // Normalize to [-π, π]
-    while (angle > pi) angle = angle - two_pi_val;
-    while (angle < -pi) angle = angle + two_pi_val;
-    
-    raw_type z = angle.raw();
-    raw_type x, y;
-    
-    // Handle quadrants
-    bool negate = false;
-    if (z < 0) {
-        z = -z;
-        negate = true;
-    }
-    
-    detail::cordic_rotation(x, y, z, 16);
-    
-    auto result = FP::from_raw(y);
-    return negate ? -result : result;
+    using U = detail::sqrt_operand_t<FP>;
+    if (x <= FP::zero()) return FP::zero();
+    constexpr int steps = detail::newton_steps<TotalBits + FracBits>;
+    return detail::saturate_root<FP>(
+        detail::isqrt_newton<steps>(static_cast<U>(x.raw()) << FracBits));
 }
 
+/**
+ * @brief sqrt() by the digit-by-digit shift/subtract method
+ *
+ * One result bit per step and no multiplies or divides, for cores where
+ * those are slow. Bit-identical to sqrt().
+ */
 template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-    requires (TotalBits == 32 && FracBits == 16)
-inline auto cos(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
+    requires (TotalBits + FracBits <= 128)
+constexpr auto sqrt_digits(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
     using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    using raw_type = typename FP::raw_type;
-    
-    // Range reduction to [-π, π]
-    auto pi = constants::pi<FP>();
-    auto two_pi_val = constants::two_pi<FP>();
-    
-    while (angle > pi) angle = angle - two_pi_val;
-    while (angle < -pi) angle = angle + two_pi_val;
-    
-    raw_type z = angle.raw();
-    raw_type x, y;
-    
-    // Handle negative angles (cos is even function, so cos(-x) = cos(x))
-    if (z < 0) {
-        z = -z;
-    }
-    
-    detail::cordic_rotation(x, y, z, 16);
-    
-    // x contains cos(|angle|)
-    return FP::from_raw(x);
+    using U = detail::sqrt_operand_t<FP>;
+    if (x <= FP::zero()) return FP::zero();
+    return detail::saturate_root<FP>(detail::isqrt_digits(static_cast<U>(x.raw()) << FracBits));
 }
 
+/**
+ * @brief 1/sqrt(x); max() for x <= 0 and wherever the result does not fit
+ *
+ * Divide-free: the Newton kernel behind sqrt() with the exponent applied as
+ * a shift. 64-bit formats take one more, wider Newton step, so the result
+ * is within one LSB for every format. Use it to normalize, e.g.
+ * v * rsqrt(dot(v, v)).
+ */
 template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-    requires (TotalBits == 32 && FracBits == 16)
-inline auto tan(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
-    auto s = sin(angle);
-    auto c = cos(angle);
-    return s / c;
+    requires (TotalBits <= 64)
+constexpr auto rsqrt(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
+    if (x <= FP::zero()) return FP::max();
+    // raw = m 2^e with m in [1, 4) and e - FracBits even
+    const auto raw = static_cast<uint64_t>(x.raw());
+    const int top = static_cast<int>(std::bit_width(raw)) - 1;
+    const int e = top - ((top - FracBits) & 1);
+    const uint64_t m = e >= 62 ? raw >> (e - 62) : raw << (62 - e);
+    uint128 y = detail::rsqrt_q63<detail::newton_steps<2 * TotalBits>>(m);
+    // 1/sqrt(x) = y 2^-63 2^-(e - F) / 2, in Q(FracBits)
+    int shift = 63 + (e - FracBits) / 2 - FracBits;
+    if constexpr (TotalBits > 32) {
+        // Results reach 2^63 raw, past what y's 2^-59 carries
+        y = detail::rsqrt_q64(m, y);
+        ++shift;
+    }
+    const uint128 r = shift > 0 ? (y + (uint128(1) << (shift - 1))) >> shift
+                                    : y << -shift;
+    return detail::saturate_root<FP>(r);
 }
 
+/**
+ * @brief sqrt(a^2 + b^2) without overflow, rounded to nearest
+ *
+ * The squares are summed exactly in twice the width, so there is no
+ * intermediate overflow or loss for any inputs; only a result above max()
+ * saturates.
+ */
 template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-    requires (TotalBits == 32 && FracBits == 16)
-inline auto atan2(FixedPoint<TotalBits, FracBits, Signed, Policy> y,
-                  FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    requires (TotalBits < 64 || (TotalBits == 64 && Signed))
+constexpr auto hypot(FixedPoint<TotalBits, FracBits, Signed, Policy> a,
+                     FixedPoint<TotalBits, FracBits, Signed, Policy> b) {
     using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    using raw_type = typename FP::raw_type;
-    
-    if (x == FP::zero() && y == FP::zero()) {
-        return FP::zero();
+    using U = std::conditional_t<2 * TotalBits + 1 <= 64, uint64_t, uint128>;
+    const auto abs = [](typename FP::raw_type v) {
+        return v < 0 ? U(0) - static_cast<U>(v) : static_cast<U>(v);
+    };
+    const U ua = abs(a.raw());
+    const U ub = abs(b.raw());
+    // Both squares carry 2 * FracBits fractional bits, so the root is already in Q(FracBits)
+    constexpr int steps = detail::newton_steps<2 * TotalBits + 1>;
+    return detail::saturate_root<FP>(detail::isqrt_newton<steps>(ua * ua + ub * ub));
+}
+
+//
+// Table-driven trigonometry
+//
+
+/**
+ * @brief Backend selector for the table-driven sin/cos/sincos overloads
+ *
+ * Both backends index one constexpr sine table (Q1.30, TableSize entries per
+ * turn) with the angle converted to a 32-bit phase, so cos is the same lookup
+ * a quarter turn later. Worst-case interpolation error, before rounding to the
+ * result format:
+ *
+ *   TableSize   Fast (linear)   Precise (quadratic)
+ *   256         7.6e-5          9.5e-7
+ *   1024        4.8e-6          1.5e-8
+ *   4096        3.0e-7          2.3e-10
+ *
+ * Rounding the phase to 32 bits and the table to Q1.30 adds at most 2e-9,
+ * which only shows in formats with more than 28 fractional bits. Precise
+ * costs one extra load and two extra multiplies per value.
+ */
+enum class Accuracy {
+    Fast,    ///< Linear interpolation; lower-degree exp2/log2 polynomials
+    Precise  ///< Quadratic interpolation; exp2/log2 polynomials within 1 LSB
+};
+
+/**
+ * @brief Result of sincos()
+ */
+template<typename FixedType>
+struct SinCos {
+    FixedType sin;
+    FixedType cos;
+};
+
+namespace detail {
+    constexpr double TRIG_PI = 3.14159265358979323846;
+
+    // Taylor series on [-pi/2, pi/2]; only used to build tables at compile time
+    constexpr double constexpr_sin(double x) {
+        while (x > TRIG_PI) x -= 2.0 * TRIG_PI;
+        while (x < -TRIG_PI) x += 2.0 * TRIG_PI;
+        if (x > TRIG_PI / 2) x = TRIG_PI - x;
+        if (x < -TRIG_PI / 2) x = -TRIG_PI - x;
+
+        double term = x;
+        double sum = x;
+        for (int n = 1; n < 15; ++n) {
+            term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
     }
-    
-    raw_type result = detail::cordic_vectoring(x.raw(), y.raw(), 16);
-    
-    // Adjust for quadrants
-    auto pi = constants::pi<FP>();
-    if (x < FP::zero()) {
-        if (y >= FP::zero()) {
-            result = pi.raw() - result;
+
+    constexpr double constexpr_cos(double x) {
+        return constexpr_sin(x + TRIG_PI / 2);
+    }
+
+    // One turn of sin in Q1.30 plus two guard entries for interpolation
+    template<int TableSize>
+    constexpr std::array<int32_t, static_cast<size_t>(TableSize) + 2> make_sine_table() {
+        std::array<int32_t, static_cast<size_t>(TableSize) + 2> table{};
+        for (int i = 0; i < TableSize + 2; ++i) {
+            double s = constexpr_sin(2.0 * TRIG_PI * i / TableSize) * 1073741824.0;
+            table[static_cast<size_t>(i)] = static_cast<int32_t>(s < 0 ? s - 0.5 : s + 0.5);
+        }
+        return table;
+    }
+
+    template<int TableSize>
+    inline constexpr auto sine_table = make_sine_table<TableSize>();
+
+    template<int TableSize>
+    concept valid_table_size = TableSize >= 16 && TableSize <= (1 << 16) &&
+                               (TableSize & (TableSize - 1)) == 0;
+
+    // Radians to a 32-bit phase (2^32 per turn). K is 1/(2π) in Q0.64; the
+    // product wraps modulo whole turns, so this is also the range reduction.
+    template<typename FP>
+    constexpr uint32_t radians_to_phase(FP angle) {
+        constexpr uint64_t K = 0x28BE60DB9391054AULL;
+        const auto raw = static_cast<uint128>(static_cast<int128>(angle.raw()));
+        constexpr uint128 half = uint128(1) << (FP::fractional_bits + 31);
+        return static_cast<uint32_t>((raw * K + half) >> (FP::fractional_bits + 32));
+    }
+
+    // sin/cos of quadrant * π/2 + z from cos(z) and sin(z), as selects
+    // rather than a data-dependent branch
+    template<typename FP>
+    constexpr SinCos<FP> unfold_quadrant(uint32_t quadrant, FP c, FP s) {
+        const bool swap = quadrant & 1u;
+        const FP sin_val = swap ? c : s;
+        const FP cos_val = swap ? s : c;
+        return {(quadrant & 2u) ? -sin_val : sin_val, ((quadrant + 1) & 2u) ? -cos_val : cos_val};
+    }
+
+    // sin(phase) in Q2.30 (the quadratic fit can overshoot 1.0 by a few LSB)
+    template<Accuracy A, int TableSize>
+    constexpr int64_t sine_lookup(uint32_t phase) {
+        constexpr int index_bits = std::countr_zero(static_cast<unsigned>(TableSize));
+        constexpr int frac_bits = 32 - index_bits;
+        const auto& table = sine_table<TableSize>;
+
+        const uint32_t index = phase >> frac_bits;
+        const int64_t t = phase & ((uint32_t(1) << frac_bits) - 1);
+        const int64_t y0 = table[index];
+        const int64_t y1 = table[index + 1];
+        const int64_t half = int64_t(1) << (frac_bits - 1);
+
+        if constexpr (A == Accuracy::Fast) {
+            return y0 + (((y1 - y0) * t + half) >> frac_bits);
         } else {
-            result = -pi.raw() + result;
+            // Newton forward form: y0 + t*d1 + t*(t-1)/2 * d2
+            const int64_t y2 = table[index + 2];
+            const int64_t d1 = y1 - y0;
+            const int64_t d2 = y2 - 2 * y1 + y0;
+            const int64_t c = (t * (t - (int64_t(1) << frac_bits))) >> (frac_bits + 1);
+            return y0 + ((d1 * t + c * d2 + half) >> frac_bits);
         }
     }
-    
-    return FP::from_raw(result);
+
+    // Q2.30 to the caller's format, rounded and clamped (1.0 may not fit)
+    template<typename FP>
+    constexpr FP from_q30(int64_t v) {
+        using raw_type = typename FP::raw_type;
+        constexpr int F = FP::fractional_bits;
+        int64_t r;
+        if constexpr (F < 30) {
+            r = (v + (int64_t(1) << (29 - F))) >> (30 - F);
+        } else {
+            r = v * (int64_t(1) << (F - 30));
+        }
+        const int64_t lo = static_cast<int64_t>(FP::min().raw());
+        const int64_t hi = static_cast<int64_t>(FP::max().raw());
+        return FP::from_raw(static_cast<raw_type>(r < lo ? lo : (r > hi ? hi : r)));
+    }
+
+    template<typename FP>
+    concept lut_trig_format = FP::is_signed && FP::fractional_bits >= 1 &&
+                              FP::total_bits <= 64;
 }
 
-template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-    requires (TotalBits == 32 && FracBits == 16)
-inline auto atan(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+/**
+ * @brief Table-driven sine and cosine in one evaluation
+ *
+ * Accepts any signed format with up to 64 bits. The angle is in radians and
+ * may be arbitrarily large; range reduction is a single multiply. Select the
+ * backend per call site: sincos<Accuracy::Fast>(x) or
+ * sincos<Accuracy::Precise, 4096>(x).
+ */
+template<Accuracy A, int TableSize = 1024,
+         int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::valid_table_size<TableSize> &&
+             detail::lut_trig_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto sincos(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
+    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
+    const uint32_t phase = detail::radians_to_phase(angle);
+    return SinCos<FP>{
+        detail::from_q30<FP>(detail::sine_lookup<A, TableSize>(phase)),
+        detail::from_q30<FP>(detail::sine_lookup<A, TableSize>(phase + (uint32_t(1) << 30)))};
+}
+
+template<Accuracy A, int TableSize = 1024,
+         int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::valid_table_size<TableSize> &&
+             detail::lut_trig_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto sin(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
+    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
+    return detail::from_q30<FP>(detail::sine_lookup<A, TableSize>(detail::radians_to_phase(angle)));
+}
+
+template<Accuracy A, int TableSize = 1024,
+         int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::valid_table_size<TableSize> &&
+             detail::lut_trig_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto cos(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
     using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    return atan2(x, FP::one());
+    const uint32_t phase = detail::radians_to_phase(angle) + (uint32_t(1) << 30);
+    return detail::from_q30<FP>(detail::sine_lookup<A, TableSize>(phase));
+}
+
+/**
+ * @brief Angle in turns: 2^32 raw units per revolution
+ *
+ * Phase accumulators held as a BinaryAngle wrap modulo one turn for free, so
+ * the table-driven overloads below need no range reduction at all.
+ */
+using BinaryAngle = FixedPoint<32, 32, false>;
+
+/**
+ * @brief Converts an angle in radians to a BinaryAngle
+ */
+template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::lut_trig_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr BinaryAngle to_binary_angle(FixedPoint<TotalBits, FracBits, Signed, Policy> radians) {
+    return BinaryAngle::from_raw(detail::radians_to_phase(radians));
+}
+
+/**
+ * @brief Table-driven sine and cosine of a BinaryAngle, returned in format FP
+ *
+ * Usage: sincos<Q15_16>(phase) or sincos<Q0_15, Accuracy::Fast>(phase).
+ */
+template<typename FP, Accuracy A = Accuracy::Precise, int TableSize = 1024>
+    requires detail::valid_table_size<TableSize> && detail::lut_trig_format<FP>
+constexpr SinCos<FP> sincos(BinaryAngle angle) {
+    const uint32_t phase = angle.raw();
+    return SinCos<FP>{
+        detail::from_q30<FP>(detail::sine_lookup<A, TableSize>(phase)),
+        detail::from_q30<FP>(detail::sine_lookup<A, TableSize>(phase + (uint32_t(1) << 30)))};
+}
+
+template<typename FP, Accuracy A = Accuracy::Precise, int TableSize = 1024>
+    requires detail::valid_table_size<TableSize> && detail::lut_trig_format<FP>
+constexpr FP sin(BinaryAngle angle) {
+    return detail::from_q30<FP>(detail::sine_lookup<A, TableSize>(angle.raw()));
+}
+
+template<typename FP, Accuracy A = Accuracy::Precise, int TableSize = 1024>
+    requires detail::valid_table_size<TableSize> && detail::lut_trig_format<FP>
+constexpr FP cos(BinaryAngle angle) {
+    const uint32_t phase = angle.raw() + (uint32_t(1) << 30);
+    return detail::from_q30<FP>(detail::sine_lookup<A, TableSize>(phase));
 }
 
 //
-// Exponential and logarithmic functions (simplified implementations)
-// Full implementations would use more sophisticated algorithms
+// CORDIC-based trigonometric functions
 //
+namespace detail {
+    template<typename FP>
+    concept cordic_format = FP::is_signed && FP::fractional_bits >= 1 &&
+                            FP::fractional_bits <= 62 && FP::total_bits <= 64;
 
-template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-inline auto exp2(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
-    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    using raw_type = typename FP::raw_type;
-    
-    // Extract integer and fractional parts
-    auto integer_part = static_cast<int>(x);
-    auto frac_part = x - FP(integer_part);
-    
-    // Check overflow/underflow
-    if (integer_part >= (TotalBits - FracBits - 1)) {
-        return FP::max();
+    constexpr uint64_t unsigned_abs(int64_t v) {
+        return v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
     }
-    if (integer_part < -FracBits) {
-        return FP::zero();
+
+    // Radians to a 64-bit phase (2^64 per turn). 1/(2π) is carried in two
+    // words so the reduction stays exact to 2^-64 turns for Q31.32 inputs up
+    // to 2^31 radians; like the 32-bit version it wraps modulo whole turns.
+    template<typename FP>
+    constexpr uint64_t radians_to_phase64(FP angle) {
+        constexpr int F = FP::fractional_bits;
+        const auto raw = static_cast<int64_t>(angle.raw());
+        const uint64_t mag = unsigned_abs(raw);
+        const uint128 hi = static_cast<uint128>(mag) *
+                           static_cast<uint64_t>(INV_TWO_PI_Q128 >> 64);
+        const uint128 lo = static_cast<uint128>(mag) *
+                           static_cast<uint64_t>(INV_TWO_PI_Q128);
+        // Only bits F .. F + 63 survive, so the sum may wrap
+        const uint128 sum = hi + (lo >> 64) + (uint128(1) << (F - 1));
+        const auto phase = static_cast<uint64_t>(sum >> F);
+        return raw < 0 ? 0 - phase : phase;
     }
-    
-    // Compute 2^integer_part by shifting
-    raw_type int_result = FP::one().raw();
-    if (integer_part > 0) {
-        int_result <<= integer_part;
-    } else if (integer_part < 0) {
-        int_result >>= -integer_part;
+
+    // Splits a phase into the nearest quadrant and the remainder in the
+    // engine's working format, so that angle = quadrant * π/2 + z with
+    // |z| <= π/4
+    template<int FracBits>
+    struct QuadrantAngle {
+        uint32_t quadrant;
+        typename Cordic<FracBits>::work_type z;
+    };
+
+    template<int FracBits>
+    constexpr QuadrantAngle<FracBits> fold_quadrant(uint64_t phase) {
+        using work_type = typename Cordic<FracBits>::work_type;
+        constexpr auto TWO_PI_Q61 =
+            static_cast<int128>((PI_Q126 + (uint128(1) << 63)) >> 64);
+        constexpr int shift = 125 - Cordic<FracBits>::work_bits;
+        const uint64_t quadrant = (phase + (uint64_t(1) << 61)) >> 62;
+        const auto r = static_cast<int64_t>(phase - (quadrant << 62)); // [-2^61, 2^61)
+        const int128 z = (r * TWO_PI_Q61 + (int128(1) << (shift - 1))) >> shift;
+        return {static_cast<uint32_t>(quadrant & 3u), static_cast<work_type>(z)};
+    }
+
+    // Working format to FP, rounded and clamped (1.0 and π may not fit)
+    template<typename FP, typename W>
+    constexpr FP from_cordic(W v) {
+        using raw_type = typename FP::raw_type;
+        using wide = std::conditional_t<(sizeof(W) > sizeof(raw_type)), W, raw_type>;
+        constexpr int G = Cordic<FP::fractional_bits>::guard_bits;
+        const auto r = static_cast<wide>((v + (W(1) << (G - 1))) >> G);
+        const auto lo = static_cast<wide>(FP::min().raw());
+        const auto hi = static_cast<wide>(FP::max().raw());
+        return FP::from_raw(static_cast<raw_type>(r < lo ? lo : (r > hi ? hi : r)));
+    }
+
+    // num / den in format FP, rounded to nearest and saturated
+    template<typename FP>
+    constexpr FP cordic_divide(int128 num, int128 den) {
+        constexpr int F = FP::fractional_bits;
+        constexpr int W = Cordic<F>::work_bits;
+        // Keep num * 2^(F + 1) within 127 bits
+        constexpr int drop = W + F + 3 > 127 ? W + F + 3 - 127 : 0;
+        num >>= drop;
+        den >>= drop;
+        const auto lo = static_cast<int128>(FP::min().raw());
+        const auto hi = static_cast<int128>(FP::max().raw());
+        if (den == 0) return FP::from_raw(static_cast<typename FP::raw_type>(num < 0 ? lo : hi));
+        const int128 q2 = num * (int128(1) << (F + 1)) / den;
+        const int128 q = (q2 + (q2 < 0 ? -1 : 1)) / 2;
+        return FP::from_raw(static_cast<typename FP::raw_type>(q < lo ? lo : (q > hi ? hi : q)));
+    }
+
+    // atan2 on raw values of format FP. Both inputs are normalized to the
+    // working format first (the angle only depends on their ratio) and the
+    // left half-plane is folded onto the right one with a ±π offset.
+    template<typename FP>
+    constexpr FP cordic_atan2(int64_t y, int64_t x) {
+        using Engine = Cordic<FP::fractional_bits>;
+        using work_type = typename Engine::work_type;
+        constexpr int W = Engine::work_bits;
+        constexpr auto PI = static_cast<work_type>(
+            (PI_Q126 + (uint128(1) << (125 - W))) >> (126 - W));
+
+        if (x == 0 && y == 0) return FP::zero();
+
+        const uint64_t ux = unsigned_abs(x);
+        const uint64_t uy = unsigned_abs(y);
+        const int m = static_cast<int>(std::bit_width(ux > uy ? ux : uy));
+        const auto norm = [m](uint64_t v) {
+            return static_cast<work_type>(m > W ? v >> (m - W)
+                                                : static_cast<uint128>(v) << (W - m));
+        };
+
+        const work_type wx = norm(ux);
+        const work_type wy = ((y < 0) != (x < 0)) ? -norm(uy) : norm(uy);
+        const work_type offset = x >= 0 ? work_type(0) : (y >= 0 ? PI : -PI);
+        return from_cordic<FP>(Engine::vector(wx, wy, offset).z);
     }
-    
-    // Approximate 2^frac using polynomial (for frac in [0,1])
-    // 2^x ≈ 1 + x*ln(2) + (x*ln(2))^2/2 + (x*ln(2))^3/6
-    auto ln2 = FP(0.693147180559945);
-    auto term = frac_part * ln2;
-    auto result = FP::one() + term;
-    term = term * term / FP(2);
-    result = result + term;
-    term = term * frac_part * ln2 / FP(3);
-    result = result + term;
-    
-    return FP::from_raw(static_cast<raw_type>((static_cast<int64_t>(int_result) * result.raw()) >> FracBits));
 }
 
+/**
+ * @brief CORDIC sine and cosine in one evaluation
+ *
+ * Accepts any signed format with 1 to 62 fractional bits and up to 64 bits
+ * in total; the engine, its tables and iteration count come from
+ * Cordic<FracBits>, so Q1.30 and Q31.32 are as exact as Q15.16 (within 0.61
+ * output LSB). The angle is in radians and may be arbitrarily large; range
+ * reduction is a two-word multiply by 1/(2π), so latency does not depend on
+ * the angle. It yields a phase in 2^-64 turns, whose rounding adds up to
+ * π 2^(F - 64) LSB beyond 58 fractional bits: 0.8 LSB in all at 60, 1.0 at
+ * 61 and 1.4 at 62.
+ */
 template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-inline auto exp(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    requires detail::cordic_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto sincos(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
     using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    // e^x = 2^(x * log2(e))
-    // log2(e) ≈ 1.442695
-    auto log2e = FP(1.442695);
-    return exp2(x * log2e);
+    const auto [quadrant, z] = detail::fold_quadrant<FracBits>(detail::radians_to_phase64(angle));
+    const auto v = Cordic<FracBits>::sincos(z);
+    return detail::unfold_quadrant(quadrant, detail::from_cordic<FP>(v.x),
+                                   detail::from_cordic<FP>(v.y));
 }
 
 template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-inline auto log2(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    requires detail::cordic_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto sin(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
+    return sincos(angle).sin;
+}
+
+template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::cordic_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto cos(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
+    return sincos(angle).cos;
+}
+
+/**
+ * @brief CORDIC tangent, divided at working precision and saturated near the poles
+ */
+template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::cordic_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto tan(FixedPoint<TotalBits, FracBits, Signed, Policy> angle) {
     using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    using raw_type = typename FP::raw_type;
-    
-    if (x <= FP::zero()) {
-        return -FP::max(); // log of non-positive is -infinity
-    }
-    
-    // Find highest bit position
-    auto raw = x.raw();
-    int bit_pos = std::bit_width(static_cast<std::make_unsigned_t<raw_type>>(raw)) - 1;
-    
-    // Integer part: bit_pos - FracBits
-    int integer_part = bit_pos - FracBits;
-    
-    // Normalize to [1, 2)
-    raw_type normalized;
-    if (bit_pos >= FracBits) {
-        normalized = raw >> (bit_pos - FracBits);
-    } else {
-        normalized = raw << (FracBits - bit_pos);
-    }
-    
-    // Approximate log2 of normalized value in [1, 2) using polynomial
-    // log2(1+x) ≈ x/ln(2) for small x
-    auto frac = FP::from_raw(normalized) - FP::one();
-    auto log_frac = frac / FP(0.693147); // divide by ln(2)
-    
-    return FP(integer_part) + log_frac;
+    const auto [quadrant, z] = detail::fold_quadrant<FracBits>(detail::radians_to_phase64(angle));
+    const auto v = Cordic<FracBits>::sincos(z);
+    // tan(z + π/2) = -cos(z) / sin(z); the sign flip of the odd half-turn cancels
+    const bool odd = quadrant & 1u;
+    return detail::cordic_divide<FP>(odd ? v.x : v.y, odd ? -v.y : v.x);
 }
 
+/**
+ * @brief CORDIC four-quadrant arctangent of y / x in (-π, π], 0 for (0, 0)
+ */
 template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-inline auto log(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    requires detail::cordic_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto atan2(FixedPoint<TotalBits, FracBits, Signed, Policy> y,
+                     FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
     using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    // ln(x) = log2(x) * ln(2)
-    return log2(x) * FP(0.693147);
+    return detail::cordic_atan2<FP>(static_cast<int64_t>(y.raw()), static_cast<int64_t>(x.raw()));
 }
 
 template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
-inline auto pow(FixedPoint<TotalBits, FracBits, Signed, Policy> base,
-                FixedPoint<TotalBits, FracBits, Signed, Policy> exponent) {
+    requires detail::cordic_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto atan(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
     using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
-    
-    if (base <= FP::zero()) {
-        return FP::zero();
+    // 1.0 need not be representable in FP; the ratio is all that matters
+    return detail::cordic_atan2<FP>(static_cast<int64_t>(x.raw()), int64_t(1) << FracBits);
+}
+
+//
+// Exponential and logarithmic functions
+//
+namespace detail {
+    constexpr uint128 LN2_Q127 = u128(0x58B90BFBE8E7BCD5ULL, 0xE4F1D9CC01F97B58ULL);
+    constexpr uint128 LOG2E_Q126 = u128(0x5C551D94AE0BF85DULL, 0xDF43FF68348E9F44ULL);
+
+    // Rounds a 128-bit constant from Q(from) down to Q(to)
+    constexpr uint128 requantize(uint128 v, int from, int to) {
+        return (v + (uint128(1) << (from - to - 1))) >> (from - to);
+    }
+
+    constexpr long double POLY_LN2 = 0.693147180559945309417232121458176568L;
+
+    enum class PolyKind { Exp2, Log2 };
+
+    // Only used to build the coefficient tables at compile time. The pinned
+    // constant term is divided out analytically, so there is no cancellation:
+    //   Exp2: (2^x - 1) / x on [0, 1)
+    //   Log2: log2(1 + x) / x on [sqrt(1/2) - 1, sqrt(2) - 1)
+    constexpr long double poly_reduced(PolyKind kind, long double x) {
+        long double sum = 0;
+        if (kind == PolyKind::Exp2) {
+            long double term = POLY_LN2;
+            for (int n = 2; n < 40; ++n) {
+                sum += term;
+                term *= x * POLY_LN2 / n;
+            }
+        } else {
+            // ln(1 + x) = 2 atanh(s), s = x / (2 + x)
+            const long double s = x / (2 + x);
+            long double term = 1;
+            for (int k = 0; k < 40; ++k) {
+                sum += term / (2 * k + 1);
+                term *= s * s;
+            }
+            sum = 2 * sum / ((2 + x) * POLY_LN2);
+        }
+        return sum;
+    }
+
+    constexpr int MAX_POLY_DEGREE = 24;
+
+    struct PolyFit {
+        std::array<int64_t, MAX_POLY_DEGREE + 1> coeffs{}; // Q(work_bits), lowest order first
+        int degree = 0;
+        long double error = 0;
+    };
+
+    // Lowest-degree Chebyshev interpolant whose error, with the coefficients
+    // rounded to work_bits, stays below 2^-target_bits. Interpolating at the
+    // Chebyshev nodes lands within a few percent of the minimax error for the
+    // same degree, and pinning the constant term makes exp2(0) and log2(1)
+    // exact.
+    constexpr PolyFit fit_polynomial(PolyKind kind, int target_bits, int work_bits) {
+        const bool exp2 = kind == PolyKind::Exp2;
+        const long double lo = exp2 ? 0.0L : 0.70710678118654752440L - 1;
+        const long double hi = exp2 ? 1.0L : 1.41421356237309504880L - 1;
+        const long double scale = static_cast<long double>(int64_t(1) << (work_bits - 1)) * 2;
+        const auto quantize = [scale](long double v) {
+            const long double s = v * scale;
+            return static_cast<int64_t>(s < 0 ? s - 0.5L : s + 0.5L);
+        };
+
+        PolyFit fit;
+        for (int degree = 1; degree <= MAX_POLY_DEGREE; ++degree) {
+            // Interpolate the reduced function with degree - 1 at n nodes
+            const int n = degree;
+            std::array<std::array<long double, MAX_POLY_DEGREE + 1>, MAX_POLY_DEGREE> rows{};
+            for (int k = 0; k < n; ++k) {
+                const long double x = (lo + hi) / 2 + (hi - lo) / 2 *
+                    static_cast<long double>(constexpr_cos(TRIG_PI * (2 * k + 1) / (2 * n)));
+                long double power = 1;
+                for (int j = 0; j < n; ++j) {
+                    rows[static_cast<size_t>(k)][static_cast<size_t>(j)] = power;
+                    power *= x;
+                }
+                rows[static_cast<size_t>(k)][static_cast<size_t>(n)] = poly_reduced(kind, x);
+            }
+            // Gaussian elimination with partial pivoting
+            for (int col = 0; col < n; ++col) {
+                auto& pivot_row = rows[static_cast<size_t>(col)];
+                for (int r = col + 1; r < n; ++r) {
+                    const long double a = rows[static_cast<size_t>(r)][static_cast<size_t>(col)];
+                    const long double b = pivot_row[static_cast<size_t>(col)];
+                    if ((a < 0 ? -a : a) > (b < 0 ? -b : b)) {
+                        std::swap(rows[static_cast<size_t>(r)], pivot_row);
+                    }
+                }
+                for (int r = 0; r < n; ++r) {
+                    if (r == col) continue;
+                    auto& row = rows[static_cast<size_t>(r)];
+                    const long double f = row[static_cast<size_t>(col)] /
+                                          pivot_row[static_cast<size_t>(col)];
+                    for (int j = col; j <= n; ++j) {
+                        row[static_cast<size_t>(j)] -= f * pivot_row[static_cast<size_t>(j)];
+                    }
+                }
+            }
+
+            fit = PolyFit{};
+            fit.degree = degree;
+            fit.coeffs[0] = exp2 ? quantize(1) : 0;
+            for (int j = 0; j < n; ++j) {
+                const auto& row = rows[static_cast<size_t>(j)];
+                fit.coeffs[static_cast<size_t>(j + 1)] =
+                    quantize(row[static_cast<size_t>(n)] / row[static_cast<size_t>(j)]);
+            }
+
+            for (int i = 0; i <= 256; ++i) {
+                const long double x = lo + (hi - lo) * i / 256;
+                long double acc = 0;
+                for (int j = degree; j >= 0; --j) {
+                    acc = acc * x + static_cast<long double>(fit.coeffs[static_cast<size_t>(j)]) /
+                                        scale;
+                }
+                const long double want = (exp2 ? 1 : 0) + x * poly_reduced(kind, x);
+                const long double e = acc > want ? acc - want : want - acc;
+                if (e > fit.error) fit.error = e;
+            }
+            long double bound = 1;
+            for (int i = 0; i < target_bits; ++i) bound /= 2;
+            if (fit.error < bound) break;
+        }
+        return fit;
+    }
+
+    /**
+     * @brief Coefficients and evaluation for one polynomial and error target
+     *
+     * WorkBits is 30 (64-bit products, which the compiler can vectorize) or
+     * 62 (128-bit products). Targets are capped at 2^-(WorkBits - 2).
+     */
+    template<PolyKind Kind, int TargetBits, int WorkBits>
+    struct PolyBackend {
+        static constexpr int work_bits = WorkBits;
+        using wide_type = storage_t<(work_bits == 30 ? 64 : 128), true>;
+        static constexpr wide_type one = wide_type(1) << work_bits;
+
+        static constexpr PolyFit fit = fit_polynomial(
+            Kind, TargetBits < work_bits - 2 ? TargetBits : work_bits - 2, work_bits);
+
+        static constexpr auto coeffs = [] {
+            std::array<int64_t, static_cast<size_t>(fit.degree) + 1> c{};
+            for (size_t j = 0; j < c.size(); ++j) c[j] = fit.coeffs[j];
+            return c;
+        }();
+
+        // Horner in Q(work_bits), no divides
+        static constexpr wide_type eval(wide_type t) {
+            wide_type acc = coeffs.back();
+            for (size_t j = coeffs.size() - 1; j-- > 0;) acc = ((acc * t) >> work_bits) + coeffs[j];
+            return acc;
+        }
+    };
+
+    // Q30 when both the target and the input fraction fit with two guard bits
+    constexpr int poly_work_bits(int target_bits, int frac_bits) {
+        return target_bits + 2 <= 30 && frac_bits + 2 <= 30 ? 30 : 62;
+    }
+
+    // exp2 needs its error relative to the result: 2^-(F + I + 1) covers a
+    // result of up to 2^I. Precise stays within one LSB, Fast within 16 LSB,
+    // until PolyBackend's 2^-60 cap: formats wider than 60 bits get 2^-60.
+    template<typename FP, Accuracy A>
+    inline constexpr int exp2_target_bits =
+        FP::total_bits - (FP::is_signed ? 1 : 0) + 1 - (A == Accuracy::Fast ? 4 : 0);
+
+    template<typename FP, Accuracy A>
+    using Exp2Poly = PolyBackend<PolyKind::Exp2, exp2_target_bits<FP, A>,
+                                 poly_work_bits(exp2_target_bits<FP, A>, FP::fractional_bits)>;
+
+    // log2 is e + log2(mantissa), so its error is absolute: 2^-(F + 2)
+    template<typename FP, Accuracy A>
+    inline constexpr int log2_target_bits =
+        A == Accuracy::Precise ? FP::fractional_bits + 2
+                               : (FP::fractional_bits > 8 ? FP::fractional_bits - 4 : 4);
+
+    template<typename FP, Accuracy A>
+    using Log2Poly = PolyBackend<PolyKind::Log2, log2_target_bits<FP, A>,
+                                 poly_work_bits(FP::fractional_bits + 2, FP::fractional_bits)>;
+
+    // v / 2^s rounded to nearest for s > 0, v * 2^-s otherwise
+    template<typename W>
+    constexpr W round_shift(W v, int s) {
+        return s > 0 ? (v + (W(1) << (s - 1))) >> s : v << -s;
+    }
+
+    template<typename FP>
+    concept poly_format = FP::fractional_bits >= 0 && FP::fractional_bits <= 62 &&
+                          (FP::total_bits < 64 || (FP::total_bits == 64 && FP::is_signed));
+
+    // 2^(k + f / 2^work_bits), rounded into FP and saturated
+    template<typename FP, Accuracy A>
+    constexpr FP exp2_split(typename Exp2Poly<FP, A>::wide_type k,
+                            typename Exp2Poly<FP, A>::wide_type f) {
+        using P = Exp2Poly<FP, A>;
+        using W = typename P::wide_type;
+        constexpr int F = FP::fractional_bits;
+        constexpr int I = FP::total_bits - F - (FP::is_signed ? 1 : 0);
+        // Selects rather than early returns, so batch loops stay vectorizable
+        constexpr W k_max = I - 1;
+        constexpr W k_min = -F - 1;
+        const int shift = P::work_bits - F -
+                          static_cast<int>(k > k_max ? k_max : (k < k_min ? k_min : k));
+
+        const W p = P::eval(f); // [1, 2)
+        W r;
+        if constexpr (F + I - 1 >= P::work_bits) {
+            r = round_shift(p, shift);
+        } else {
+            r = (p + (W(1) << (shift - 1))) >> shift;
+        }
+        const auto hi = static_cast<W>(FP::max().raw());
+        r = k > k_max ? hi : (k < k_min ? W(0) : (r > hi ? hi : r));
+        return FP::from_raw(static_cast<typename FP::raw_type>(r));
+    }
+
+    // log2(x) = e + p / 2^work_bits with p in [-1/2, 1/2), for x > 0
+    template<typename FP, Accuracy A>
+    struct Log2Split {
+        int e;
+        typename Log2Poly<FP, A>::wide_type p;
+    };
+
+    template<typename FP, Accuracy A>
+    constexpr Log2Split<FP, A> log2_split(FP x) {
+        using P = Log2Poly<FP, A>;
+        constexpr auto SQRT2 = static_cast<typename P::wide_type>(
+            requantize(SQRT1_2_Q127, 127, P::work_bits + 1));
+        using W = typename P::wide_type;
+        constexpr int WB = P::work_bits;
+        const auto v = static_cast<uint64_t>(x.raw());
+        const int b = static_cast<int>(std::bit_width(v)) - 1;
+        // v / 2^b in Q(work_bits), i.e. the mantissa in [1, 2)
+        const auto normalize = [v](int bit) {
+            return bit >= WB ? static_cast<W>(v >> (bit - WB)) : static_cast<W>(v) << (WB - bit);
+        };
+        // Mantissa in [sqrt(1/2), sqrt(2)) keeps the polynomial coefficients small
+        W m = normalize(b);
+        const bool up = m >= SQRT2;
+        m = up ? normalize(b + 1) : m;
+        return {b - FP::fractional_bits + (up ? 1 : 0), P::eval(m - P::one)};
+    }
+
+    template<typename FP, typename W>
+    constexpr FP saturate_raw(W r) {
+        const auto lo = static_cast<W>(FP::min().raw());
+        const auto hi = static_cast<W>(FP::max().raw());
+        return FP::from_raw(static_cast<typename FP::raw_type>(r < lo ? lo : (r > hi ? hi : r)));
     }
-    
-    // x^y = 2^(y * log2(x))
-    return exp2(exponent * log2(base));
 }
 
+/**
+ * @brief 2^x by a per-format polynomial
+ *
+ * The integer part of x is a shift and the fraction goes through a Horner
+ * polynomial with constexpr-generated coefficients, so there are no divides.
+ * Accuracy::Precise (the default) is within one LSB; Accuracy::Fast is within
+ * 16 LSB and saves about one multiply. Results above max() saturate.
+ *
+ * Formats wider than 60 bits are the exception: their polynomial works in
+ * Q62, which caps the error at one LSB plus 2^-59 of the result for both
+ * tiers. That is up to 12 LSB for results near max() of a 64-bit format
+ * (Q31.32 near 2^31, Q3.60 near 8), and within one LSB for results below
+ * 2^(59 - F).
+ */
+template<Accuracy A = Accuracy::Precise,
+         int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::poly_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto exp2(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
+    using P = detail::Exp2Poly<FP, A>;
+    using W = typename P::wide_type;
+    const auto raw = static_cast<int64_t>(x.raw());
+    const W frac = static_cast<W>(raw & ((int64_t(1) << FracBits) - 1));
+    return detail::exp2_split<FP, A>(raw >> FracBits, frac << (P::work_bits - FracBits));
+}
+
+/**
+ * @brief e^x = 2^(x log2(e)), with log2(e) carried to 61 or 62 bits
+ *
+ * Accuracy as for exp2(), including the 2^-59 relative cap of 64-bit formats.
+ */
+template<Accuracy A = Accuracy::Precise,
+         int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::poly_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto exp(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
+    using P = detail::Exp2Poly<FP, A>;
+    using W = typename P::wide_type;
+    const auto raw = static_cast<int64_t>(x.raw());
+    constexpr W mask = P::one - 1;
+    if constexpr (P::work_bits == 30) {
+        // Q61 constant in two halves keeps the products in 64 bits:
+        // t = x log2(e) in Q(F + 30)
+        constexpr auto L = static_cast<int64_t>(detail::requantize(detail::LOG2E_Q126, 126, 61));
+        const int64_t t = raw * (L >> 31) + ((raw * (L & 0x7FFFFFFF)) >> 31);
+        return detail::exp2_split<FP, A>(t >> (FracBits + 30), (t >> FracBits) & mask);
+    } else {
+        constexpr auto L = static_cast<int128>(detail::requantize(detail::LOG2E_Q126, 126, 62));
+        const int128 t = raw * L; // Q(F + 62)
+        const int128 k = t >> (FracBits + 62);
+        const auto f = static_cast<W>((t >> (FracBits + 62 - P::work_bits)) & mask);
+        return detail::exp2_split<FP, A>(static_cast<W>(k), f);
+    }
+}
+
+/**
+ * @brief log2(x) by a per-format polynomial; min() for x <= 0
+ *
+ * The exponent comes from the bit width and the mantissa goes through a
+ * Horner polynomial, so there are no divides. Accuracy as for exp2().
+ */
+template<Accuracy A = Accuracy::Precise,
+         int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::poly_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto log2(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
+    using P = detail::Log2Poly<FP, A>;
+    using W = typename P::wide_type;
+    if (x <= FP::from_raw(0)) return FP::min();
+    const auto [e, p] = detail::log2_split<FP, A>(x);
+    const W r = static_cast<W>(e) * (W(1) << FracBits) +
+                detail::round_shift(p, P::work_bits - FracBits);
+    return detail::saturate_raw<FP>(r);
+}
+
+/**
+ * @brief ln(x) = log2(x) ln(2); min() for x <= 0
+ */
+template<Accuracy A = Accuracy::Precise,
+         int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::poly_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto log(FixedPoint<TotalBits, FracBits, Signed, Policy> x) {
+    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
+    using P = detail::Log2Poly<FP, A>;
+    using W = typename P::wide_type;
+    if (x <= FP::from_raw(0)) return FP::min();
+    const auto [e, p] = detail::log2_split<FP, A>(x);
+    // e ln(2) + p ln(2) in Q(2 * work_bits - 4), which still fits W for |e| <= 64
+    constexpr int S = 2 * P::work_bits - 4;
+    constexpr auto LN2_S = static_cast<W>(detail::requantize(detail::LN2_Q127, 127, S));
+    constexpr auto LN2_W = static_cast<W>(detail::requantize(detail::LN2_Q127, 127, P::work_bits));
+    const W sum = static_cast<W>(e) * LN2_S + ((p * LN2_W) >> 4);
+    return detail::saturate_raw<FP>(detail::round_shift(sum, S - FracBits));
+}
+
+/**
+ * @brief base^exponent = 2^(exponent log2(base)); 0 for base <= 0
+ *
+ * Exact for integral results such as pow(2, 3). Otherwise the log2 error is
+ * scaled by the exponent, so large exponents cost a few LSB.
+ */
+template<Accuracy A = Accuracy::Precise,
+         int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+    requires detail::poly_format<FixedPoint<TotalBits, FracBits, Signed, Policy>>
+constexpr auto pow(FixedPoint<TotalBits, FracBits, Signed, Policy> base,
+                   FixedPoint<TotalBits, FracBits, Signed, Policy> exponent) {
+    using FP = FixedPoint<TotalBits, FracBits, Signed, Policy>;
+    using L = detail::Log2Poly<FP, A>;
+    using E = detail::Exp2Poly<FP, A>;
+    using W = typename E::wide_type;
+    if (base <= FP::from_raw(0)) return FP::from_raw(0);
+    const auto [e, p] = detail::log2_split<FP, A>(base);
+    // log2(base) in Q(work_bits - g), times the exponent in Q(F + work_bits - g)
+    constexpr int g = L::work_bits == 62 ? 8 : 0;
+    const int128 l = (static_cast<int128>(e) * L::one + p) >> g;
+    const int128 t = static_cast<int128>(exponent.raw()) * l;
+    constexpr int shift = FracBits + L::work_bits - g;
+    const int128 k = t >> shift;
+    const int128 frac = t & ((int128(1) << shift) - 1);
+    const auto f = static_cast<W>(shift >= E::work_bits ? frac >> (shift - E::work_bits)
+                                                        : frac << (E::work_bits - shift));
+    // Anything past +-256 saturates or underflows the same way
+    const auto k_clamped = static_cast<W>(k < -256 ? -256 : (k > 256 ? 256 : k));
+    return detail::exp2_split<FP, A>(k_clamped, f);
+}
+
+//
+// Batch exponential and logarithm
+//
+namespace batch {
+
+/**
+ * @brief out[i] = exp2(in[i])
+ *
+ * The element loops are branch-free integer arithmetic with no divides.
+ * log2() and log() of formats with up to 26 fractional bits run their
+ * polynomial in Q30 with only 64-bit products, so the compiler vectorizes
+ * them against the target ISA (64-bit multiplies need AVX-512DQ on x86).
+ */
+template<Accuracy A = Accuracy::Precise, FixedPointType FP>
+void exp2(input_span<FP> in, std::span<FP> out) {
+    assert(in.size() >= out.size());
+    for (size_t i = 0; i < out.size(); ++i) out[i] = fixp::exp2<A>(in[i]);
+}
+
+/**
+ * @brief out[i] = exp(in[i])
+ */
+template<Accuracy A = Accuracy::Precise, FixedPointType FP>
+void exp(input_span<FP> in, std::span<FP> out) {
+    assert(in.size() >= out.size());
+    for (size_t i = 0; i < out.size(); ++i) out[i] = fixp::exp<A>(in[i]);
+}
+
+/**
+ * @brief out[i] = log2(in[i])
+ */
+template<Accuracy A = Accuracy::Precise, FixedPointType FP>
+void log2(input_span<FP> in, std::span<FP> out) {
+    assert(in.size() >= out.size());
+    for (size_t i = 0; i < out.size(); ++i) out[i] = fixp::log2<A>(in[i]);
+}
+
+/**
+ * @brief out[i] = log(in[i])
+ */
+template<Accuracy A = Accuracy::Precise, FixedPointType FP>
+void log(input_span<FP> in, std::span<FP> out) {
+    assert(in.size() >= out.size());
+    for (size_t i = 0; i < out.size(); ++i) out[i] = fixp::log<A>(in[i]);
+}
+
+} // namespace batch
+
 } // namespace fixp
 
 #endif // FIXP_MATH_HPP
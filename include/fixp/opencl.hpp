@@ -0,0 +1,553 @@
+#ifndef FIXP_OPENCL_HPP
+#define FIXP_OPENCL_HPP
+
+#include "fixed_point.hpp"
+#include "batch.hpp"
+#include "dsp.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef CL_TARGET_OPENCL_VERSION
+#define CL_TARGET_OPENCL_VERSION 120
+#endif
+#if defined(__APPLE__)
+#include <OpenCL/opencl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+namespace fixp {
+namespace opencl {
+
+//-----------------------------------------------------------------------------
+// OpenCL Offload
+//
+// Engine<FP> runs the kernels that scripts/generate_opencl_kernels.py writes
+// for FP's format. Every result is bit-identical to the CPU path: the
+// FixedPoint operators, batch::from_float/to_float and FftPlan. Link
+// libfixp::opencl, which generates the programs for LIBFIXP_OPENCL_FORMATS
+// and puts qM_N_cl.h on the include path. Each call splits its arrays into
+// chunks and alternates them between two in-order queues, so one chunk's
+// transfers overlap the previous chunk's kernel. Calls block until the
+// results are back in host memory.
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief An OpenCL call that failed, with its status code
+ */
+class Error : public std::runtime_error {
+public:
+    Error(const std::string& what, cl_int code)
+        : std::runtime_error(what + " (OpenCL error " + std::to_string(code) + ")"),
+          m_code(code) {}
+
+    cl_int code() const { return m_code; }
+
+private:
+    cl_int m_code;
+};
+
+namespace detail {
+
+inline void check(cl_int status, const char* what) {
+    if (status != CL_SUCCESS) throw Error(what, status);
+}
+
+/**
+ * @brief Owns one OpenCL object and releases it with Release
+ */
+template<typename T, auto Release>
+class Handle {
+public:
+    Handle() = default;
+    explicit Handle(T object) : m_object(object) {}
+    Handle(Handle&& other) noexcept : m_object(std::exchange(other.m_object, nullptr)) {}
+    Handle& operator=(Handle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_object = std::exchange(other.m_object, nullptr);
+        }
+        return *this;
+    }
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+    ~Handle() { reset(); }
+
+    T get() const { return m_object; }
+    explicit operator bool() const { return m_object != nullptr; }
+
+    void reset() {
+        if (m_object) Release(std::exchange(m_object, nullptr));
+    }
+
+private:
+    T m_object = nullptr;
+};
+
+using ContextHandle = Handle<cl_context, clReleaseContext>;
+using QueueHandle = Handle<cl_command_queue, clReleaseCommandQueue>;
+using ProgramHandle = Handle<cl_program, clReleaseProgram>;
+using KernelHandle = Handle<cl_kernel, clReleaseKernel>;
+using BufferHandle = Handle<cl_mem, clReleaseMemObject>;
+
+/**
+ * @brief The "// libfixp-format: prefix=qM_N storage=BITS frac=N" line of a program
+ */
+struct Format {
+    std::string prefix;
+    int storage_bits = 0;
+    int fractional_bits = 0;
+};
+
+inline int format_field(std::string_view line, std::string_view key) {
+    const size_t at = line.find(key);
+    if (at == std::string_view::npos) return -1;
+    int value = 0;
+    for (size_t i = at + key.size(); i < line.size() && line[i] >= '0' && line[i] <= '9'; ++i) {
+        value = value * 10 + (line[i] - '0');
+    }
+    return value;
+}
+
+inline Format parse_format(std::string_view source) {
+    constexpr std::string_view tag = "// libfixp-format: prefix=";
+    if (!source.starts_with(tag)) {
+        throw std::invalid_argument("OpenCL source lacks the libfixp-format line of "
+                                    "generate_opencl_kernels.py");
+    }
+    const std::string_view line = source.substr(0, source.find('\n'));
+    Format format;
+    format.prefix = std::string(line.substr(tag.size(), line.find(' ', tag.size()) - tag.size()));
+    format.storage_bits = format_field(line, " storage=");
+    format.fractional_bits = format_field(line, " frac=");
+    return format;
+}
+
+} // namespace detail
+
+/**
+ * @brief A device and its context
+ */
+class Context {
+public:
+    /**
+     * @brief The first device of this type on any platform; throws Error if there is none
+     */
+    explicit Context(cl_device_type type = CL_DEVICE_TYPE_DEFAULT) {
+        cl_uint count = 0;
+        detail::check(clGetPlatformIDs(0, nullptr, &count), "clGetPlatformIDs");
+        std::vector<cl_platform_id> platforms(count);
+        detail::check(clGetPlatformIDs(count, platforms.data(), nullptr), "clGetPlatformIDs");
+        for (cl_platform_id platform : platforms) {
+            cl_device_id device = nullptr;
+            if (clGetDeviceIDs(platform, type, 1, &device, nullptr) == CL_SUCCESS) {
+                create(platform, device);
+                return;
+            }
+        }
+        throw Error("no OpenCL device of the requested type", CL_DEVICE_NOT_FOUND);
+    }
+
+    Context(cl_platform_id platform, cl_device_id device) { create(platform, device); }
+
+    cl_context get() const { return m_context.get(); }
+    cl_device_id device() const { return m_device; }
+
+    std::string device_name() const {
+        size_t size = 0;
+        detail::check(clGetDeviceInfo(m_device, CL_DEVICE_NAME, 0, nullptr, &size),
+                      "clGetDeviceInfo");
+        std::string name(size, '\0');
+        detail::check(clGetDeviceInfo(m_device, CL_DEVICE_NAME, size, name.data(), nullptr),
+                      "clGetDeviceInfo");
+        while (!name.empty() && name.back() == '\0') name.pop_back();
+        return name;
+    }
+
+private:
+    void create(cl_platform_id platform, cl_device_id device) {
+        const cl_context_properties properties[] = {
+            CL_CONTEXT_PLATFORM, reinterpret_cast<cl_context_properties>(platform), 0};
+        cl_int status = CL_SUCCESS;
+        m_context = detail::ContextHandle(
+            clCreateContext(properties, 1, &device, nullptr, nullptr, &status));
+        detail::check(status, "clCreateContext");
+        m_device = device;
+    }
+
+    detail::ContextHandle m_context;
+    cl_device_id m_device = nullptr;
+};
+
+/**
+ * @brief FP's generated kernels built for one device
+ *
+ * source is FP's program, qM_N_cl_source from the generated qM_N_cl.h; its
+ * format line must name FP's storage width and fractional bits. chunk is
+ * the number of elements (or complex samples) per transfer. Saturate
+ * formats run the _sat kernels, Wrap and Undefined the _wrap ones, and
+ * Dynamic the one dynamic_overflow_policy() selects at each call. Trap has
+ * no device equivalent: it is rejected at compile time, and a Dynamic
+ * format under Trap throws std::domain_error. The context must outlive the
+ * engine. An engine is not safe to call from two threads at once.
+ */
+template<FixedPointType FP>
+    requires(std::is_signed_v<typename FP::raw_type> && sizeof(typename FP::raw_type) <= 4)
+class Engine {
+public:
+    using raw_type = typename FP::raw_type;
+    static_assert(FP::overflow_policy != OverflowPolicy::Trap,
+                  "Trap arithmetic cannot run on an OpenCL device");
+
+    Engine(const Context& context, std::string_view source, size_t chunk = size_t(1) << 20)
+        : m_context(context), m_chunk(chunk) {
+        assert(chunk > 0);
+        const detail::Format format = detail::parse_format(source);
+        if (format.storage_bits != static_cast<int>(sizeof(raw_type) * 8) ||
+            format.fractional_bits != FP::fractional_bits) {
+            throw std::invalid_argument("OpenCL program " + format.prefix +
+                                        " is for another format");
+        }
+
+        const char* text = source.data();
+        const size_t length = source.size();
+        cl_int status = CL_SUCCESS;
+        m_program = detail::ProgramHandle(
+            clCreateProgramWithSource(context.get(), 1, &text, &length, &status));
+        detail::check(status, "clCreateProgramWithSource");
+        cl_device_id device = context.device();
+        status = clBuildProgram(m_program.get(), 1, &device, "-cl-std=CL1.2", nullptr, nullptr);
+        if (status != CL_SUCCESS) throw Error("clBuildProgram:\n" + build_log(), status);
+
+        const std::string& p = format.prefix;
+        for (size_t sat = 0; sat < 2; ++sat) {
+            const std::string suffix = sat ? "_sat" : "_wrap";
+            m_ops[sat].add = kernel(p + "_add" + suffix);
+            m_ops[sat].sub = kernel(p + "_sub" + suffix);
+            m_ops[sat].mul = kernel(p + "_mul" + suffix);
+            m_ops[sat].mul_add = kernel(p + "_mul_add" + suffix);
+            m_ops[sat].scale = kernel(p + "_scale" + suffix);
+            m_ops[sat].fft_stage = kernel(p + "_fft_stage" + suffix);
+        }
+        m_from_float = kernel(p + "_from_float");
+        m_to_float = kernel(p + "_to_float");
+        m_fft_bitrev = kernel(p + "_fft_bitrev");
+        m_fft_scale = kernel(p + "_fft_scale");
+
+        for (auto& lane : m_lanes) {
+            lane.queue = detail::QueueHandle(
+                clCreateCommandQueue(context.get(), device, 0, &status));
+            detail::check(status, "clCreateCommandQueue");
+        }
+    }
+
+    /**
+     * @brief out[i] = a[i] + b[i], a[i] - b[i] and a[i] * b[i]
+     */
+    void add(std::span<const FP> a, std::span<const FP> b, std::span<FP> out) {
+        binary(ops().add, a, b, out);
+    }
+
+    void sub(std::span<const FP> a, std::span<const FP> b, std::span<FP> out) {
+        binary(ops().sub, a, b, out);
+    }
+
+    void mul(std::span<const FP> a, std::span<const FP> b, std::span<FP> out) {
+        binary(ops().mul, a, b, out);
+    }
+
+    /**
+     * @brief out[i] = a[i] * b[i] + c[i], the product rounded first
+     */
+    void mul_add(std::span<const FP> a, std::span<const FP> b, std::span<const FP> c,
+                 std::span<FP> out) {
+        assert(a.size() >= out.size() && b.size() >= out.size() && c.size() >= out.size());
+        stream(ops().mul_add.get(), out.size(), {array(a), array(b), array(c)}, {}, out);
+    }
+
+    /**
+     * @brief out[i] = a[i] * s
+     */
+    void scale(std::span<const FP> a, FP s, std::span<FP> out) {
+        assert(a.size() >= out.size());
+        const raw_type raw = s.raw();
+        stream(ops().scale.get(), out.size(), {array(a)}, Scalar{&raw, sizeof(raw)}, out);
+    }
+
+    /**
+     * @brief out[i] = in[i] rounded to FP, saturating and NaN to zero, as batch::from_float
+     */
+    void from_float(std::span<const float> in, std::span<FP> out,
+                    batch::Rounding rounding = batch::Rounding::HalfEven) {
+        assert(in.size() >= out.size());
+        const cl_int even = rounding == batch::Rounding::HalfEven ? 1 : 0;
+        stream(m_from_float.get(), out.size(), {array(in)}, Scalar{&even, sizeof(even)}, out);
+    }
+
+    /**
+     * @brief out[i] = in[i] as float, as batch::to_float
+     */
+    void to_float(std::span<const FP> in, std::span<float> out) {
+        assert(in.size() >= out.size());
+        stream(m_to_float.get(), out.size(), {array(in)}, {}, out);
+    }
+
+    /**
+     * @brief plan's transform of every N-sample frame of frames, in place
+     *
+     * The same result as plan.forward() or plan.inverse() on each frame.
+     * frames.size() must be a multiple of N. The plan's tables are uploaded
+     * on the first transform of each size and kept.
+     */
+    template<size_t N>
+    void fft(const dsp::FftPlan<FP, N>& plan, std::span<dsp::Complex<FP>> frames,
+             bool inverse = false) {
+        static_assert(sizeof(dsp::Complex<FP>) == 2 * sizeof(raw_type));
+        assert(frames.size() % N == 0);
+        const Tables& tables = fft_tables(plan);
+        const cl_kernel stage = ops().fft_stage.get();
+        const size_t count = frames.size() / N;
+        const size_t per_chunk = std::max<size_t>(1, m_chunk / N);
+        const cl_uint n = static_cast<cl_uint>(N);
+        const cl_int backward = inverse ? 1 : 0;
+
+        Drain drain{m_lanes};
+        for (size_t first = 0, c = 0; first < count; first += per_chunk, ++c) {
+            Lane& lane = m_lanes[c % m_lanes.size()];
+            const cl_uint chunk_frames = static_cast<cl_uint>(std::min(per_chunk, count - first));
+            const size_t bytes = size_t(chunk_frames) * N * sizeof(dsp::Complex<FP>);
+            cl_mem data = lane.buffer(m_context, 0, bytes);
+            auto* host = frames.data() + first * N;
+            detail::check(clEnqueueWriteBuffer(lane.queue.get(), data, CL_FALSE, 0, bytes, host,
+                                               0, nullptr, nullptr),
+                          "clEnqueueWriteBuffer");
+
+            const cl_mem bitrev = tables.bitrev.get();
+            set_args(m_fft_bitrev.get(), data, bitrev, n, chunk_frames);
+            launch(lane, m_fft_bitrev.get(), size_t(N) * chunk_frames);
+            const cl_mem twiddles = tables.twiddles.get();
+            for (cl_uint half = 1, stride = n / 2; half < n; half <<= 1, stride >>= 1) {
+                set_args(stage, data, twiddles, n, half, stride, chunk_frames, backward);
+                launch(lane, stage, size_t(N / 2) * chunk_frames);
+            }
+            if (inverse) {
+                const cl_uint log2n = static_cast<cl_uint>(dsp::FftPlan<FP, N>::log2_size);
+                const cl_uint values = static_cast<cl_uint>(2 * N * chunk_frames);
+                set_args(m_fft_scale.get(), data, log2n, values);
+                launch(lane, m_fft_scale.get(), values);
+            }
+
+            detail::check(clEnqueueReadBuffer(lane.queue.get(), data, CL_FALSE, 0, bytes, host,
+                                              0, nullptr, nullptr),
+                          "clEnqueueReadBuffer");
+        }
+        drain.finish();
+    }
+
+private:
+    struct PolicyKernels {
+        detail::KernelHandle add, sub, mul, mul_add, scale, fft_stage;
+    };
+
+    // An in-order queue and the device buffers of the chunks it runs
+    struct Lane {
+        detail::QueueHandle queue;
+        std::array<detail::BufferHandle, 4> buffers;
+        std::array<size_t, 4> capacity{};
+
+        cl_mem buffer(const Context& context, size_t slot, size_t bytes) {
+            if (capacity[slot] < bytes) {
+                // Earlier commands on this queue may still use the old buffer
+                detail::check(clFinish(queue.get()), "clFinish");
+                cl_int status = CL_SUCCESS;
+                buffers[slot] = detail::BufferHandle(
+                    clCreateBuffer(context.get(), CL_MEM_READ_WRITE, bytes, nullptr, &status));
+                detail::check(status, "clCreateBuffer");
+                capacity[slot] = bytes;
+            }
+            return buffers[slot].get();
+        }
+    };
+
+    // Waits for every lane, even when an enqueue throws, so no transfer is
+    // left writing to the caller's memory
+    struct Drain {
+        std::array<Lane, 2>& lanes;
+        bool done = false;
+
+        void finish() {
+            done = true;
+            for (auto& lane : lanes) detail::check(clFinish(lane.queue.get()), "clFinish");
+        }
+
+        ~Drain() {
+            if (!done) {
+                for (auto& lane : lanes) clFinish(lane.queue.get());
+            }
+        }
+    };
+
+    struct Array {
+        const void* data = nullptr;
+        size_t item_bytes = 0;
+    };
+
+    struct Scalar {
+        const void* data = nullptr;
+        size_t bytes = 0;
+    };
+
+    struct Tables {
+        detail::BufferHandle twiddles, bitrev;
+    };
+
+    template<typename T>
+    static Array array(std::span<const T> s) {
+        return Array{s.data(), sizeof(T)};
+    }
+
+    const PolicyKernels& ops() const {
+        if constexpr (FP::overflow_policy == OverflowPolicy::Saturate) {
+            return m_ops[1];
+        } else if constexpr (FP::overflow_policy == OverflowPolicy::Dynamic) {
+            switch (dynamic_overflow_policy()) {
+            case OverflowPolicy::Saturate:
+                return m_ops[1];
+            case OverflowPolicy::Trap:
+                throw std::domain_error("Trap arithmetic cannot run on an OpenCL device");
+            default:
+                return m_ops[0];
+            }
+        } else {
+            return m_ops[0];
+        }
+    }
+
+    void binary(const detail::KernelHandle& k, std::span<const FP> a, std::span<const FP> b,
+                std::span<FP> out) {
+        assert(a.size() >= out.size() && b.size() >= out.size());
+        stream(k.get(), out.size(), {array(a), array(b)}, {}, out);
+    }
+
+    // Runs an element kernel(inputs..., [scalar], out, uint n) over count
+    // elements, chunk by chunk, alternating lanes
+    template<typename Out>
+    void stream(cl_kernel k, size_t count, std::initializer_list<Array> inputs, Scalar scalar,
+                std::span<Out> out) {
+        Drain drain{m_lanes};
+        for (size_t first = 0, c = 0; first < count; first += m_chunk, ++c) {
+            Lane& lane = m_lanes[c % m_lanes.size()];
+            const size_t items = std::min(m_chunk, count - first);
+            cl_uint arg = 0;
+            size_t slot = 0;
+            for (const Array& in : inputs) {
+                cl_mem buffer = lane.buffer(m_context, slot++, items * in.item_bytes);
+                detail::check(clEnqueueWriteBuffer(lane.queue.get(), buffer, CL_FALSE, 0,
+                                                   items * in.item_bytes,
+                                                   static_cast<const unsigned char*>(in.data) +
+                                                       first * in.item_bytes,
+                                                   0, nullptr, nullptr),
+                              "clEnqueueWriteBuffer");
+                set_arg(k, arg++, sizeof(cl_mem), &buffer);
+            }
+            if (scalar.data) set_arg(k, arg++, scalar.bytes, scalar.data);
+            cl_mem result = lane.buffer(m_context, slot, items * sizeof(Out));
+            set_arg(k, arg++, sizeof(cl_mem), &result);
+            const cl_uint n = static_cast<cl_uint>(items);
+            set_arg(k, arg, sizeof(n), &n);
+            launch(lane, k, items);
+            detail::check(clEnqueueReadBuffer(lane.queue.get(), result, CL_FALSE, 0,
+                                              items * sizeof(Out), out.data() + first, 0,
+                                              nullptr, nullptr),
+                          "clEnqueueReadBuffer");
+        }
+        drain.finish();
+    }
+
+    template<size_t N>
+    const Tables& fft_tables(const dsp::FftPlan<FP, N>& plan) {
+        auto [it, inserted] = m_fft_tables.try_emplace(N);
+        if (inserted) {
+            try {
+                it->second.twiddles = upload(plan.twiddles().data(),
+                                             sizeof(plan.twiddles()));
+                it->second.bitrev = upload(plan.bit_reversal().data(),
+                                           sizeof(plan.bit_reversal()));
+            } catch (...) {
+                m_fft_tables.erase(it);
+                throw;
+            }
+        }
+        return it->second;
+    }
+
+    detail::BufferHandle upload(const void* data, size_t bytes) {
+        cl_int status = CL_SUCCESS;
+        detail::BufferHandle buffer(clCreateBuffer(m_context.get(),
+                                                   CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, bytes,
+                                                   const_cast<void*>(data), &status));
+        detail::check(status, "clCreateBuffer");
+        return buffer;
+    }
+
+    detail::KernelHandle kernel(const std::string& name) {
+        cl_int status = CL_SUCCESS;
+        detail::KernelHandle k(clCreateKernel(m_program.get(), name.c_str(), &status));
+        if (status != CL_SUCCESS) throw Error("clCreateKernel " + name, status);
+        return k;
+    }
+
+    std::string build_log() const {
+        size_t size = 0;
+        clGetProgramBuildInfo(m_program.get(), m_context.device(), CL_PROGRAM_BUILD_LOG, 0,
+                              nullptr, &size);
+        std::string log(size, '\0');
+        clGetProgramBuildInfo(m_program.get(), m_context.device(), CL_PROGRAM_BUILD_LOG, size,
+                              log.data(), nullptr);
+        while (!log.empty() && log.back() == '\0') log.pop_back();
+        return log;
+    }
+
+    static void set_arg(cl_kernel k, cl_uint index, size_t bytes, const void* value) {
+        detail::check(clSetKernelArg(k, index, bytes, value), "clSetKernelArg");
+    }
+
+    template<typename... Args>
+    static void set_args(cl_kernel k, const Args&... args) {
+        cl_uint index = 0;
+        (set_arg(k, index++, sizeof(Args), &args), ...);
+    }
+
+    // Work-items rounded up to whole groups of 64; the kernels skip the excess
+    static void launch(Lane& lane, cl_kernel k, size_t items) {
+        const size_t global = (items + 63) / 64 * 64;
+        detail::check(clEnqueueNDRangeKernel(lane.queue.get(), k, 1, nullptr, &global, nullptr,
+                                             0, nullptr, nullptr),
+                      "clEnqueueNDRangeKernel");
+    }
+
+    const Context& m_context;
+    size_t m_chunk;
+    detail::ProgramHandle m_program;
+    std::array<PolicyKernels, 2> m_ops; // wrap, saturate
+    detail::KernelHandle m_from_float, m_to_float, m_fft_bitrev, m_fft_scale;
+    std::array<Lane, 2> m_lanes;
+    std::map<size_t, Tables> m_fft_tables;
+};
+
+} // namespace opencl
+} // namespace fixp
+
+#endif // FIXP_OPENCL_HPP
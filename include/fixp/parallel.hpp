@@ -0,0 +1,623 @@
+#ifndef FIXP_PARALLEL_HPP
+#define FIXP_PARALLEL_HPP
+
+#include "fixed_point.hpp"
+#include "dsp.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <version>
+#if defined(__cpp_lib_execution)
+#include <execution>
+#endif
+
+namespace fixp {
+namespace parallel {
+
+//-----------------------------------------------------------------------------
+// Executors
+//
+// An executor runs bulk(count, grain, f): f(begin, end, worker) over
+// consecutive [begin, end) slices of [0, count), at most grain items each,
+// every item exactly once. worker is below workers() and no two calls with
+// the same worker run at once, so it can index per-worker scratch.
+//-----------------------------------------------------------------------------
+
+using BulkFunction = void (*)(size_t, size_t, size_t);
+
+template<typename E>
+concept Executor = requires(E& e, size_t n, BulkFunction f) {
+    { e.workers() } -> std::convertible_to<size_t>;
+    e.bulk(n, n, f);
+};
+
+/**
+ * @brief Runs every slice on the calling thread, in order
+ */
+struct SerialExecutor {
+    static constexpr size_t workers() { return 1; }
+
+    template<typename F>
+    void bulk(size_t count, size_t grain, F&& f) const {
+        grain = std::max<size_t>(grain, 1);
+        for (size_t b = 0; b < count; b += grain) f(b, std::min(count, b + grain), size_t(0));
+    }
+};
+
+/**
+ * @brief Work-stealing pool of worker threads
+ *
+ * bulk() splits the range into chunks of grain items and deals each worker
+ * one contiguous run of them, so a worker streams through neighbouring memory
+ * and keeps the pages it touched first. A worker that runs out steals the
+ * far half of the next unfinished run and carries on from there. The calling
+ * thread is worker 0 and takes part; bulk() returns once every chunk is done
+ * and rethrows the first exception a chunk threw, skipping the chunks that had
+ * not started. A bulk() called from inside a chunk runs serially in place.
+ *
+ * Concurrent bulk() calls from different threads are serialized.
+ *
+ * @code
+ * parallel::ThreadPool pool;  // one worker per hardware thread
+ * parallel::fft(pool, plan, frames);
+ * @endcode
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief A pool of workers workers, the caller included (at least 1)
+     */
+    explicit ThreadPool(size_t workers = default_workers())
+        : m_queues(std::max<size_t>(workers, 1)) {
+        m_threads.reserve(m_queues.size() - 1);
+        for (size_t w = 1; w < m_queues.size(); ++w) {
+            m_threads.emplace_back([this, w] { worker_loop(w); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& t : m_threads) t.join();
+    }
+
+    /**
+     * @brief One worker per hardware thread
+     */
+    static size_t default_workers() {
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    size_t workers() const { return m_queues.size(); }
+
+    template<typename F>
+    void bulk(size_t count, size_t grain, F&& f) {
+        grain = std::max<size_t>(grain, 1);
+        const size_t chunks = count / grain + (count % grain != 0);
+        if (chunks == 0) return;
+        if (t_current == this) {
+            // Nested inside one of our chunks: stay on this worker
+            run_serial(count, grain, f, t_worker);
+            return;
+        }
+        std::lock_guard submit(m_submit);
+        if (chunks == 1 || workers() == 1) {
+            run_serial(count, grain, f, 0);
+            return;
+        }
+        assert(chunks <= UINT32_MAX);
+
+        using Fn = std::remove_reference_t<F>;
+        Job job(const_cast<void*>(static_cast<const void*>(std::addressof(f))),
+                [](void* ctx, size_t b, size_t e, size_t w) { (*static_cast<Fn*>(ctx))(b, e, w); },
+                count, grain);
+
+        {
+            std::unique_lock lock(m_mutex);
+            // Stragglers of the last job may still be scanning the queues
+            m_idle.wait(lock, [&] { return m_active == 0; });
+            const size_t n = workers();
+            for (size_t w = 0; w < n; ++w) {
+                m_queues[w].range.store(pack(chunks * w / n, chunks * (w + 1) / n),
+                                        std::memory_order_relaxed);
+            }
+            m_job = &job;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        t_current = this;
+        t_worker = 0;
+        work(0, job);
+        t_current = nullptr;
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_idle.wait(lock, [&] { return m_active == 0; });
+            m_job = nullptr;
+        }
+        if (job.error) std::rethrow_exception(job.error);
+    }
+
+private:
+    struct Job {
+        Job(void* c, void (*fn)(void*, size_t, size_t, size_t), size_t n, size_t g)
+            : ctx(c), call(fn), count(n), grain(g) {}
+
+        void* ctx;
+        void (*call)(void*, size_t, size_t, size_t);
+        size_t count;
+        size_t grain;
+        std::atomic<bool> cancelled{false};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    // Unclaimed chunks [begin, end) of one worker, packed into one word so the
+    // owner and thieves claim them with a single compare-exchange
+    struct alignas(64) Queue {
+        std::atomic<uint64_t> range{0};
+    };
+
+    template<typename F>
+    static void run_serial(size_t count, size_t grain, F& f, size_t worker) {
+        for (size_t b = 0; b < count; b += grain) f(b, std::min(count, b + grain), worker);
+    }
+
+    static constexpr uint64_t pack(size_t begin, size_t end) {
+        return (static_cast<uint64_t>(begin) << 32) | static_cast<uint64_t>(end);
+    }
+    static constexpr size_t begin_of(uint64_t r) { return static_cast<size_t>(r >> 32); }
+    static constexpr size_t end_of(uint64_t r) { return static_cast<size_t>(r & 0xffffffffu); }
+
+    // The front chunk of the worker's own run
+    bool pop(size_t w, size_t& chunk) {
+        auto& q = m_queues[w].range;
+        uint64_t r = q.load(std::memory_order_relaxed);
+        while (begin_of(r) < end_of(r)) {
+            if (q.compare_exchange_weak(r, pack(begin_of(r) + 1, end_of(r)),
+                                        std::memory_order_acq_rel)) {
+                chunk = begin_of(r);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Half of another worker's run, from its end; w runs the first chunk and
+    // queues the rest as its own
+    bool steal(size_t w, size_t& chunk) {
+        const size_t n = workers();
+        for (size_t k = 1; k < n; ++k) {
+            auto& q = m_queues[(w + k) % n].range;
+            uint64_t r = q.load(std::memory_order_relaxed);
+            while (begin_of(r) < end_of(r)) {
+                const size_t b = begin_of(r), e = end_of(r);
+                const size_t take = (e - b + 1) / 2;
+                if (q.compare_exchange_weak(r, pack(b, e - take), std::memory_order_acq_rel)) {
+                    chunk = e - take;
+                    m_queues[w].range.store(pack(e - take + 1, e), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void work(size_t w, Job& job) {
+        size_t chunk = 0;
+        while (pop(w, chunk) || steal(w, chunk)) {
+            if (job.cancelled.load(std::memory_order_relaxed)) continue;
+            const size_t b = chunk * job.grain;
+            try {
+                job.call(job.ctx, b, std::min(job.count, b + job.grain), w);
+            } catch (...) {
+                std::lock_guard lock(job.error_mutex);
+                if (!job.error) job.error = std::current_exception();
+                job.cancelled.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void worker_loop(size_t w) {
+        t_current = this;
+        t_worker = w;
+        uint64_t seen = 0;
+        for (;;) {
+            Job* job = nullptr;
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen = m_generation;
+                job = m_job;
+                if (job == nullptr) continue;
+                ++m_active;
+            }
+            work(w, *job);
+            {
+                std::lock_guard lock(m_mutex);
+                --m_active;
+            }
+            m_idle.notify_all();
+        }
+    }
+
+    std::vector<Queue> m_queues;
+    std::vector<std::thread> m_threads;
+    std::mutex m_submit;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    Job* m_job = nullptr;
+    uint64_t m_generation = 0;
+    size_t m_active = 0;
+    bool m_stop = false;
+
+    // The pool and worker index of the chunk running on this thread
+    static inline thread_local ThreadPool* t_current = nullptr;
+    static inline thread_local size_t t_worker = 0;
+};
+
+/**
+ * @brief A process-wide pool with one worker per hardware thread, started on first use
+ */
+inline ThreadPool& default_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+#if defined(__cpp_lib_execution)
+/**
+ * @brief Runs bulk() through a standard execution policy
+ *
+ * The range is cut into workers() contiguous parts, one per worker index, and
+ * std::for_each runs the parts under the policy; load balancing is left to
+ * the standard library. With libstdc++, std::execution::par needs TBB.
+ *
+ * @code
+ * parallel::PolicyExecutor exec(std::execution::par);
+ * @endcode
+ */
+template<typename Policy>
+    requires std::is_execution_policy_v<Policy>
+class PolicyExecutor {
+public:
+    explicit PolicyExecutor(Policy policy, size_t workers = ThreadPool::default_workers())
+        : m_policy(policy), m_parts(std::max<size_t>(workers, 1)) {
+        for (size_t w = 0; w < m_parts.size(); ++w) m_parts[w] = w;
+    }
+
+    size_t workers() const { return m_parts.size(); }
+
+    template<typename F>
+    void bulk(size_t count, size_t grain, F&& f) const {
+        grain = std::max<size_t>(grain, 1);
+        const size_t chunks = count / grain + (count % grain != 0);
+        const size_t n = m_parts.size();
+        std::for_each(m_policy, m_parts.begin(), m_parts.end(), [&](size_t w) {
+            for (size_t c = chunks * w / n; c < chunks * (w + 1) / n; ++c) {
+                f(c * grain, std::min(count, (c + 1) * grain), w);
+            }
+        });
+    }
+
+private:
+    Policy m_policy;
+    std::vector<size_t> m_parts;
+};
+#endif
+
+//-----------------------------------------------------------------------------
+// Chunking and scratch
+//-----------------------------------------------------------------------------
+
+namespace detail {
+
+inline constexpr size_t cache_line = 64;
+
+// Smallest chunk worth scheduling on its own, in bytes of data touched
+inline constexpr size_t min_chunk_bytes = 16 * 1024;
+
+} // namespace detail
+
+/**
+ * @brief Items per chunk for count items of item_bytes each over workers
+ *
+ * Aims for four chunks per worker so stealing can even out uneven workers,
+ * but keeps a chunk at least 16 KiB so scheduling stays cheap, and rounds it
+ * to whole cache lines so two workers never write the same line.
+ */
+constexpr size_t chunk_size(size_t count, size_t item_bytes, size_t workers) {
+    item_bytes = std::max<size_t>(item_bytes, 1);
+    size_t grain = count / (4 * std::max<size_t>(workers, 1));
+    grain = std::max(grain, (detail::min_chunk_bytes + item_bytes - 1) / item_bytes);
+    if (item_bytes < detail::cache_line && detail::cache_line % item_bytes == 0) {
+        const size_t per_line = detail::cache_line / item_bytes;
+        grain = (grain + per_line - 1) / per_line * per_line;
+    }
+    return std::max<size_t>(grain, 1);
+}
+
+/**
+ * @brief One scratch buffer per worker, each on its own cache lines
+ *
+ * @code
+ * parallel::Scratch<Complex<Q15_16>> scratch(pool.workers(), N);
+ * pool.bulk(count, 1, [&](size_t b, size_t e, size_t w) { auto buf = scratch[w]; ... });
+ * @endcode
+ */
+template<typename T>
+    requires std::is_trivially_destructible_v<T>
+class Scratch {
+public:
+    Scratch() = default;
+
+    Scratch(size_t workers, size_t size) { resize(workers, size); }
+
+    /**
+     * @brief Makes room for at least workers buffers of size elements; contents are not kept
+     */
+    void resize(size_t workers, size_t size) {
+        if (workers <= m_workers && size <= m_size) return;
+        m_workers = std::max(workers, m_workers);
+        m_size = std::max(size, m_size);
+        const size_t bytes = (m_size * sizeof(T) + detail::cache_line - 1) / detail::cache_line *
+                             detail::cache_line;
+        m_stride = bytes / sizeof(T);
+        m_data.reset(static_cast<T*>(::operator new(m_workers * bytes, align)));
+        std::uninitialized_value_construct_n(m_data.get(), m_workers * m_stride);
+    }
+
+    size_t workers() const { return m_workers; }
+    size_t size() const { return m_size; }
+
+    std::span<T> operator[](size_t worker) const {
+        assert(worker < m_workers);
+        return std::span<T>(m_data.get() + worker * m_stride, m_size);
+    }
+
+private:
+    static constexpr std::align_val_t align{detail::cache_line};
+
+    struct Free {
+        void operator()(T* p) const { ::operator delete(p, align); }
+    };
+
+    std::unique_ptr<T, Free> m_data;
+    size_t m_workers = 0;
+    size_t m_size = 0;
+    size_t m_stride = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Batched transforms
+//
+// frames holds count transforms back to back, frame i at [i * N, (i + 1) * N).
+// The plans are read-only, so one plan serves every worker.
+//-----------------------------------------------------------------------------
+
+namespace detail {
+
+template<typename Plan>
+concept InPlacePlan = requires(const Plan& p, std::span<typename Plan::value_type, Plan::size> s) {
+    p.forward(s);
+    p.inverse(s);
+};
+
+template<Executor E, typename F>
+void for_frames(E& exec, size_t count, size_t frame_bytes, F&& f) {
+    exec.bulk(count, chunk_size(count, frame_bytes, exec.workers()),
+              [&](size_t b, size_t e, size_t) {
+                  for (size_t i = b; i < e; ++i) f(i);
+              });
+}
+
+} // namespace detail
+
+/**
+ * @brief plan.forward on every frame, e.g. an FftPlan or Radix4FftPlan
+ */
+template<Executor E, detail::InPlacePlan Plan>
+void fft(E& exec, const Plan& plan, std::span<typename Plan::value_type> frames) {
+    constexpr size_t N = Plan::size;
+    assert(frames.size() % N == 0);
+    detail::for_frames(exec, frames.size() / N, N * sizeof(typename Plan::value_type),
+                       [&](size_t i) {
+                           (void)plan.forward(frames.subspan(i * N).template first<N>());
+                       });
+}
+
+/**
+ * @brief plan.inverse on every frame
+ */
+template<Executor E, detail::InPlacePlan Plan>
+void ifft(E& exec, const Plan& plan, std::span<typename Plan::value_type> frames) {
+    constexpr size_t N = Plan::size;
+    assert(frames.size() % N == 0);
+    detail::for_frames(exec, frames.size() / N, N * sizeof(typename Plan::value_type),
+                       [&](size_t i) {
+                           (void)plan.inverse(frames.subspan(i * N).template first<N>());
+                       });
+}
+
+/**
+ * @brief Block-floating-point forward transforms, keeping each frame's exponent
+ */
+template<Executor E, detail::InPlacePlan Plan>
+    requires requires(const Plan& p, std::span<typename Plan::value_type, Plan::size> s) {
+        { p.forward(s) } -> std::same_as<int>;
+    }
+void fft(E& exec, const Plan& plan, std::span<typename Plan::value_type> frames,
+         std::span<int> exponents) {
+    constexpr size_t N = Plan::size;
+    assert(frames.size() % N == 0 && exponents.size() >= frames.size() / N);
+    detail::for_frames(exec, frames.size() / N, N * sizeof(typename Plan::value_type),
+                       [&](size_t i) {
+                           exponents[i] = plan.forward(frames.subspan(i * N).template first<N>());
+                       });
+}
+
+/**
+ * @brief Block-floating-point inverse transforms, keeping each frame's exponent
+ */
+template<Executor E, detail::InPlacePlan Plan>
+    requires requires(const Plan& p, std::span<typename Plan::value_type, Plan::size> s) {
+        { p.inverse(s) } -> std::same_as<int>;
+    }
+void ifft(E& exec, const Plan& plan, std::span<typename Plan::value_type> frames,
+          std::span<int> exponents) {
+    constexpr size_t N = Plan::size;
+    assert(frames.size() % N == 0 && exponents.size() >= frames.size() / N);
+    detail::for_frames(exec, frames.size() / N, N * sizeof(typename Plan::value_type),
+                       [&](size_t i) {
+                           exponents[i] = plan.inverse(frames.subspan(i * N).template first<N>());
+                       });
+}
+
+/**
+ * @brief Real FFTs: frame i of N samples to bins i of N/2 + 1
+ */
+template<Executor E, typename FixedType, size_t N>
+void rfft(E& exec, const dsp::RealFftPlan<FixedType, N>& plan,
+          std::span<const std::type_identity_t<FixedType>> input,
+          std::span<dsp::Complex<std::type_identity_t<FixedType>>> spectra) {
+    constexpr size_t Bins = N / 2 + 1;
+    assert(input.size() % N == 0 && spectra.size() >= input.size() / N * Bins);
+    detail::for_frames(exec, input.size() / N, N * sizeof(FixedType), [&](size_t i) {
+        plan.forward(input.subspan(i * N).template first<N>(),
+                     spectra.subspan(i * Bins).template first<Bins>());
+    });
+}
+
+//-----------------------------------------------------------------------------
+// Filter banks
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief One independent filter per channel, run across an executor
+ *
+ * Filter is any filter with process(std::span<const T>, std::span<T>) and
+ * reset(), such as FirFilter or a single-channel BiquadCascade. Each channel
+ * keeps its own state across calls and sits on its own cache lines, so the
+ * workers never share one.
+ *
+ * @code
+ * parallel::FilterBank<dsp::FirFilter<Q15_16, 64>> bank(256, dsp::FirFilter<Q15_16, 64>(taps));
+ * bank.process(pool, in, out);              // in[c * frames + n]
+ * bank.process_interleaved(pool, in, out);  // in[n * 256 + c]
+ * @endcode
+ */
+template<typename Filter>
+    requires requires(Filter& f, std::span<const typename Filter::value_type> in,
+                      std::span<typename Filter::value_type> out) {
+        f.process(in, out);
+        f.reset();
+    }
+class FilterBank {
+public:
+    using filter_type = Filter;
+    using value_type = typename Filter::value_type;
+
+    explicit FilterBank(size_t channels, const Filter& prototype = Filter())
+        : m_channels(channels, Slot{prototype}) {}
+
+    size_t channels() const { return m_channels.size(); }
+
+    Filter& channel(size_t c) { return m_channels[c].filter; }
+    const Filter& channel(size_t c) const { return m_channels[c].filter; }
+
+    /**
+     * @brief Clears every channel's state
+     */
+    void reset() {
+        for (auto& s : m_channels) s.filter.reset();
+    }
+
+    /**
+     * @brief Filters planar blocks: channel c's frames at in[c * frames, (c + 1) * frames)
+     *
+     * out must be as large as in and may alias it.
+     */
+    template<Executor E>
+    void process(E& exec, std::span<const value_type> in, std::span<value_type> out) {
+        const size_t n = m_channels.size();
+        if (n == 0) return;
+        assert(in.size() % n == 0 && out.size() >= in.size());
+        const size_t frames = in.size() / n;
+        exec.bulk(n, chunk_size(n, frames * sizeof(value_type), exec.workers()),
+                  [&](size_t b, size_t e, size_t) {
+                      for (size_t c = b; c < e; ++c) {
+                          m_channels[c].filter.process(in.subspan(c * frames, frames),
+                                                       out.subspan(c * frames, frames));
+                      }
+                  });
+    }
+
+    /**
+     * @brief Filters interleaved frames: sample n of channel c at in[n * channels() + c]
+     *
+     * Each worker gathers its chunk of channels into its own scratch buffer
+     * row by row, filters every channel there and scatters them back, so the
+     * filters see contiguous samples. Chunks are whole cache lines of
+     * channels, so two workers never write the same line of a 64-byte aligned
+     * out. out may alias in. The scratch grows on the first call and is reused
+     * afterwards.
+     */
+    template<Executor E>
+    void process_interleaved(E& exec, std::span<const value_type> in, std::span<value_type> out) {
+        const size_t n = m_channels.size();
+        if (n == 0) return;
+        assert(in.size() % n == 0 && out.size() >= in.size());
+        const size_t frames = in.size() / n;
+        const size_t per_line = std::max<size_t>(detail::cache_line / sizeof(value_type), 1);
+        const size_t grain = (chunk_size(n, frames * sizeof(value_type), exec.workers()) +
+                              per_line - 1) / per_line * per_line;
+        m_scratch.resize(exec.workers(), std::min(grain, n) * frames);
+        exec.bulk(n, grain, [&](size_t b, size_t e, size_t w) {
+            const auto buf = m_scratch[w];
+            const size_t k = e - b;
+            for (size_t i = 0; i < frames; ++i) {
+                for (size_t j = 0; j < k; ++j) buf[j * frames + i] = in[i * n + b + j];
+            }
+            for (size_t j = 0; j < k; ++j) {
+                const auto x = buf.subspan(j * frames, frames);
+                m_channels[b + j].filter.process(x, x);
+            }
+            for (size_t i = 0; i < frames; ++i) {
+                for (size_t j = 0; j < k; ++j) out[i * n + b + j] = buf[j * frames + i];
+            }
+        });
+    }
+
+private:
+    struct alignas(detail::cache_line) Slot {
+        Filter filter;
+    };
+
+    std::vector<Slot> m_channels;
+    Scratch<value_type> m_scratch;
+};
+
+} // namespace parallel
+} // namespace fixp
+
+#endif // FIXP_PARALLEL_HPP
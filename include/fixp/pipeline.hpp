@@ -0,0 +1,450 @@
+#ifndef FIXP_PIPELINE_HPP
+#define FIXP_PIPELINE_HPP
+
+#include "fixed_point.hpp"
+#include "dsp.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace fixp {
+namespace dsp {
+
+//-----------------------------------------------------------------------------
+// Pipeline stages
+//
+// A stage names its input_type and output_type and maps an input block size
+// to its output size, std::dynamic_extent for sizes it does not accept.
+// Element-wise stages (elementwise = true) provide apply(x, i), the output
+// for input x at index i; the pipeline fuses runs of them into one pass.
+// Block stages provide process(in, out), and set in_place when out may alias
+// in, so the pipeline can run them on the buffer they read.
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief x * gain for every sample
+ */
+template<typename FixedType>
+class GainStage {
+public:
+    using input_type = FixedType;
+    using output_type = FixedType;
+    static constexpr bool elementwise = true;
+
+    constexpr explicit GainStage(FixedType gain = FixedType::one()) : m_gain(gain) {}
+
+    static constexpr size_t output_size(size_t n) { return n; }
+
+    constexpr void set_gain(FixedType gain) { m_gain = gain; }
+    constexpr FixedType gain() const { return m_gain; }
+
+    constexpr output_type apply(input_type x, size_t) const { return x * m_gain; }
+
+private:
+    FixedType m_gain;
+};
+
+/**
+ * @brief x[i] * window_table<W, FixedType, N>[i] over frames of exactly N samples
+ */
+template<Window W, typename FixedType, size_t N>
+class WindowStage {
+public:
+    using input_type = FixedType;
+    using output_type = FixedType;
+    static constexpr bool elementwise = true;
+
+    static constexpr size_t output_size(size_t n) { return n == N ? n : std::dynamic_extent; }
+
+    constexpr output_type apply(input_type x, size_t i) const {
+        return x * window_table<W, FixedType, N>[i];
+    }
+};
+
+/**
+ * @brief |X[k]| of every bin, e.g. after a RealFftStage
+ */
+template<typename FixedType>
+class MagnitudeStage {
+public:
+    using input_type = Complex<FixedType>;
+    using output_type = FixedType;
+    static constexpr bool elementwise = true;
+
+    static constexpr size_t output_size(size_t n) { return n; }
+
+    constexpr output_type apply(const input_type& x, size_t) const { return x.magnitude(); }
+};
+
+/**
+ * @brief f(x) for every sample, for element-wise steps the library does not provide
+ *
+ * @code
+ * dsp::MapStage<Q15_16, decltype(clip)> limiter(clip);
+ * @endcode
+ */
+template<typename In, typename F>
+    requires std::is_invocable_v<const F&, In>
+class MapStage {
+public:
+    using input_type = In;
+    using output_type = std::invoke_result_t<const F&, In>;
+    static constexpr bool elementwise = true;
+
+    constexpr explicit MapStage(F f) : m_f(std::move(f)) {}
+
+    static constexpr size_t output_size(size_t n) { return n; }
+
+    constexpr output_type apply(const input_type& x, size_t) const { return std::invoke(m_f, x); }
+
+private:
+    F m_f;
+};
+
+/**
+ * @brief A FirFilter as a pipeline stage; the delay line carries across blocks
+ */
+template<typename FixedType, size_t NumTaps>
+class FirStage : public FirFilter<FixedType, NumTaps> {
+public:
+    using input_type = FixedType;
+    using output_type = FixedType;
+    static constexpr bool elementwise = false;
+    static constexpr bool in_place = true;
+
+    using FirFilter<FixedType, NumTaps>::FirFilter;
+
+    static constexpr size_t output_size(size_t n) { return n; }
+};
+
+/**
+ * @brief A single-channel BiquadCascade as a pipeline stage
+ */
+template<typename FixedType, size_t Sections, BiquadForm Form = BiquadForm::DirectForm1,
+         typename CoeffType = FixedType>
+class BiquadStage : public BiquadCascade<FixedType, Sections, 1, Form, CoeffType> {
+public:
+    using input_type = FixedType;
+    using output_type = FixedType;
+    static constexpr bool elementwise = false;
+    static constexpr bool in_place = true;
+
+    static constexpr size_t output_size(size_t n) { return n; }
+};
+
+/**
+ * @brief Forward N-point complex FFT of each frame, in place
+ */
+template<typename FixedType, size_t N>
+class FftStage {
+public:
+    using input_type = Complex<FixedType>;
+    using output_type = Complex<FixedType>;
+    static constexpr bool elementwise = false;
+    static constexpr bool in_place = true;
+
+    static constexpr size_t output_size(size_t n) { return n == N ? n : std::dynamic_extent; }
+
+    void process(std::span<const input_type> in, std::span<output_type> out) const {
+        if (out.data() != in.data()) std::copy_n(in.begin(), N, out.begin());
+        m_plan.forward(out.template first<N>());
+    }
+
+private:
+    FftPlan<FixedType, N> m_plan;
+};
+
+/**
+ * @brief Spectrum X[0..N/2] of each frame of N real samples
+ */
+template<typename FixedType, size_t N>
+class RealFftStage {
+public:
+    using input_type = FixedType;
+    using output_type = Complex<FixedType>;
+    static constexpr bool elementwise = false;
+    static constexpr bool in_place = false;
+
+    static constexpr size_t output_size(size_t n) {
+        return n == N ? N / 2 + 1 : std::dynamic_extent;
+    }
+
+    void process(std::span<const input_type> in, std::span<output_type> out) const {
+        m_plan.forward(in.template first<N>(), out.template first<N / 2 + 1>());
+    }
+
+private:
+    RealFftPlan<FixedType, N> m_plan;
+};
+
+namespace detail {
+
+template<typename T>
+concept ElementwiseStage = T::elementwise && requires(const T& s, typename T::input_type x) {
+    { s.apply(x, size_t(0)) } -> std::convertible_to<typename T::output_type>;
+};
+
+template<typename T>
+concept BlockStage = !T::elementwise && requires(T& s, std::span<const typename T::input_type> in,
+                                                 std::span<typename T::output_type> out) {
+    { T::in_place } -> std::convertible_to<bool>;
+    s.process(in, out);
+};
+
+// Whether a stage allows out to alias in
+template<typename S>
+constexpr bool stage_in_place() {
+    if constexpr (S::elementwise) {
+        return true;
+    } else {
+        return S::in_place;
+    }
+}
+
+// One pass over memory: stages [first, last), reading buffer src and
+// writing dst, where -1 is the caller's input or output
+struct PipelinePass {
+    size_t first, last;
+    int src, dst;
+};
+
+} // namespace detail
+
+template<typename T>
+concept PipelineStage = requires {
+    typename T::input_type;
+    typename T::output_type;
+    { T::output_size(size_t(1)) } -> std::convertible_to<size_t>;
+} && (detail::ElementwiseStage<T> || detail::BlockStage<T>);
+
+/**
+ * @brief A fixed chain of stages over blocks of N samples, with no allocation per block
+ *
+ * Stage types and block sizes are checked at compile time. Adjacent
+ * element-wise stages are fused into one pass, each sample going through the
+ * whole run while it is in a register. Block stages that allow it run in
+ * place; the rest ping-pong between two arenas held inside the pipeline and
+ * sized for the largest intermediate block, so nothing is copied between
+ * stages and nothing is allocated after construction. The first pass reads
+ * the caller's input and the last writes the caller's output.
+ *
+ * @code
+ * dsp::Pipeline<1024, dsp::WindowStage<dsp::Window::Hann, Q15_16, 1024>,
+ *               dsp::RealFftStage<Q15_16, 1024>, dsp::MagnitudeStage<Q15_16>> analyzer;
+ * analyzer.run(frame, magnitudes); // one window pass, one FFT, one magnitude pass
+ * @endcode
+ */
+template<size_t N, PipelineStage... Stages>
+    requires (sizeof...(Stages) >= 1 && N >= 1)
+class Pipeline {
+    using stage_tuple = std::tuple<Stages...>;
+    using Pass = detail::PipelinePass;
+
+    template<size_t I>
+    using stage_t = std::tuple_element_t<I, stage_tuple>;
+
+    static constexpr size_t stage_count = sizeof...(Stages);
+
+    // sizes[i] is stage i's input block size, sizes[stage_count] the output's
+    static constexpr std::array<size_t, stage_count + 1> sizes = [] {
+        std::array<size_t, stage_count + 1> s{N};
+        size_t i = 0;
+        ((s[i + 1] = s[i] == std::dynamic_extent ? s[i] : Stages::output_size(s[i]), ++i), ...);
+        return s;
+    }();
+
+    static constexpr bool types_chain = []<size_t... I>(std::index_sequence<I...>) {
+        return (std::is_same_v<typename stage_t<I>::output_type,
+                               typename stage_t<I + 1>::input_type> && ... && true);
+    }(std::make_index_sequence<stage_count - 1>{});
+
+    static_assert(types_chain, "each stage's input_type must be the previous stage's output_type");
+    static_assert(std::ranges::none_of(sizes, [](size_t s) { return s == std::dynamic_extent; }),
+                  "a stage does not accept the block size it is given");
+
+    static constexpr std::array<bool, stage_count> elementwise{Stages::elementwise...};
+
+    // Whether stage i may write the buffer it reads
+    static constexpr std::array<bool, stage_count> reuses_input = [] {
+        std::array<bool, stage_count> r{};
+        size_t i = 0;
+        ((r[i] = std::is_same_v<typename Stages::input_type, typename Stages::output_type> &&
+                 sizes[i] == sizes[i + 1] && detail::stage_in_place<Stages>(),
+          ++i),
+         ...);
+        return r;
+    }();
+
+    // Bytes of stage i's output block
+    static constexpr std::array<size_t, stage_count> output_bytes = [] {
+        std::array<size_t, stage_count> b{};
+        size_t i = 0;
+        ((b[i] = sizeof(typename Stages::output_type) * sizes[i + 1], ++i), ...);
+        return b;
+    }();
+
+    static constexpr size_t pass_total = [] {
+        size_t n = 0;
+        for (size_t i = 0; i < stage_count; ++i) {
+            if (i == 0 || !elementwise[i] || !elementwise[i - 1]) ++n;
+        }
+        return n;
+    }();
+
+    static constexpr std::array<Pass, pass_total> passes = [] {
+        std::array<Pass, pass_total> p{};
+        size_t n = 0;
+        for (size_t i = 0; i < stage_count; ++i) {
+            if (i == 0 || !elementwise[i] || !elementwise[i - 1]) {
+                p[n++] = Pass{i, i + 1, -1, -1};
+            } else {
+                p[n - 1].last = i + 1;
+            }
+        }
+        // Each pass writes where it reads if all its stages allow it, else
+        // the other arena; the last pass writes the caller's output
+        int current = -1;
+        for (size_t k = 0; k + 1 < n; ++k) {
+            p[k].src = current;
+            bool in_place = current >= 0;
+            for (size_t i = p[k].first; i < p[k].last; ++i) in_place = in_place && reuses_input[i];
+            p[k].dst = in_place ? current : (current == 0 ? 1 : 0);
+            current = p[k].dst;
+        }
+        p[n - 1].src = current;
+        return p;
+    }();
+
+    static constexpr std::array<size_t, 2> arena_sizes = [] {
+        std::array<size_t, 2> a{};
+        for (const Pass& p : passes) {
+            if (p.dst < 0) continue;
+            size_t& bytes = a[static_cast<size_t>(p.dst)];
+            bytes = std::max(bytes, output_bytes[p.last - 1]);
+        }
+        return a;
+    }();
+
+public:
+    using input_type = typename stage_t<0>::input_type;
+    using output_type = typename stage_t<stage_count - 1>::output_type;
+    static constexpr size_t input_size = N;
+    static constexpr size_t output_size = sizes[stage_count];
+
+    /// Passes over memory per block after fusing element-wise stages
+    static constexpr size_t pass_count = pass_total;
+    /// Bytes of intermediate storage held inside the pipeline
+    static constexpr size_t arena_bytes = arena_sizes[0] + arena_sizes[1];
+
+    Pipeline() = default;
+
+    explicit Pipeline(Stages... stages) : m_stages(std::move(stages)...) {}
+
+    template<size_t I>
+    stage_t<I>& stage() {
+        return std::get<I>(m_stages);
+    }
+
+    template<size_t I>
+    const stage_t<I>& stage() const {
+        return std::get<I>(m_stages);
+    }
+
+    /**
+     * @brief Clears the state of every stage that has a reset()
+     */
+    void reset() {
+        std::apply([](auto&... s) { (reset_stage(s), ...); }, m_stages);
+    }
+
+    /**
+     * @brief Runs one block through every stage
+     *
+     * out may alias in when the two have the same type and size.
+     */
+    void run(std::span<const input_type, N> in, std::span<output_type, output_size> out) {
+        [&]<size_t... K>(std::index_sequence<K...>) {
+            (run_pass<K>(in, out), ...);
+        }(std::make_index_sequence<pass_count>{});
+    }
+
+    /**
+     * @brief run() with the output replacing the block it was computed from
+     */
+    void run_in_place(std::span<input_type, N> block)
+        requires (std::is_same_v<input_type, output_type> && output_size == N)
+    {
+        run(std::span<const input_type, N>(block), block);
+    }
+
+private:
+    template<typename S>
+    static void reset_stage(S& s) {
+        if constexpr (requires { s.reset(); }) s.reset();
+    }
+
+    // The arenas hold only trivially copyable samples, created implicitly in
+    // the byte storage
+    template<typename T, size_t Count>
+    std::span<T, Count> arena(int index) {
+        std::byte* storage = index == 0 ? m_arena0.data() : m_arena1.data();
+        return std::span<T, Count>(std::launder(reinterpret_cast<T*>(storage)), Count);
+    }
+
+    template<size_t K>
+    void run_pass(std::span<const input_type, N> in, std::span<output_type, output_size> out) {
+        constexpr Pass pass = passes[K];
+        using In = typename stage_t<pass.first>::input_type;
+        using Out = typename stage_t<pass.last - 1>::output_type;
+        constexpr size_t in_size = sizes[pass.first];
+        constexpr size_t out_size = sizes[pass.last];
+        static_assert(std::is_trivially_copyable_v<In> && std::is_trivially_copyable_v<Out>);
+
+        const std::span<const In, in_size> src = [&] {
+            if constexpr (pass.src < 0) {
+                return in;
+            } else {
+                return std::span<const In, in_size>(arena<In, in_size>(pass.src));
+            }
+        }();
+        const std::span<Out, out_size> dst = [&] {
+            if constexpr (pass.dst < 0) {
+                return out;
+            } else {
+                return arena<Out, out_size>(pass.dst);
+            }
+        }();
+
+        if constexpr (stage_t<pass.first>::elementwise) {
+            for (size_t i = 0; i < out_size; ++i) dst[i] = apply<pass.first, pass.last>(src[i], i);
+        } else {
+            std::get<pass.first>(m_stages).process(std::span<const In>(src), std::span<Out>(dst));
+        }
+    }
+
+    // Stages [I, Last) applied to one sample
+    template<size_t I, size_t Last, typename T>
+    auto apply(const T& x, size_t i) const {
+        if constexpr (I == Last) {
+            return x;
+        } else {
+            return apply<I + 1, Last>(std::get<I>(m_stages).apply(x, i), i);
+        }
+    }
+
+    stage_tuple m_stages;
+    alignas(64) std::array<std::byte, arena_sizes[0]> m_arena0;
+    alignas(64) std::array<std::byte, arena_sizes[1]> m_arena1;
+};
+
+} // namespace dsp
+} // namespace fixp
+
+#endif // FIXP_PIPELINE_HPP
@@ -0,0 +1,1847 @@
+#ifndef FIXP_SIMD_HPP
+#define FIXP_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//
+// Architecture detection
+//
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FIXP_SIMD_X86 1
+// GCC 12's AVX-512 headers self-initialise their "undefined" vectors, which
+// trips -W(maybe-)uninitialized once the intrinsics are inlined. Its
+// unaligned loads also trip -Warray-bounds on arrays shorter than one vector,
+// even inside loops that cannot run for them.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define FIXP_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Kernels are compiled for their ISA through target attributes rather than
+// global -m flags, so every x86 kernel is always available and a runtime
+// dispatcher can select between them in a single translation unit.
+#if defined(__GNUC__) || defined(__clang__)
+#define FIXP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FIXP_TARGET(isa)
+#endif
+
+#define FIXP_TARGET_SSE41  FIXP_TARGET("sse4.1")
+#define FIXP_TARGET_AVX2   FIXP_TARGET("avx2")
+#define FIXP_TARGET_AVX512 FIXP_TARGET("avx512f,avx512bw")
+#define FIXP_TARGET_AVXVNNI FIXP_TARGET("avx2,avxvnni")
+#define FIXP_TARGET_AVX512VNNI FIXP_TARGET("avx512f,avx512bw,avx512vnni")
+
+namespace fixp {
+namespace simd {
+
+/**
+ * @brief Raw-lane SIMD kernels for the batch API
+ *
+ * Every kernel works on the raw integer representation of a signed Q format
+ * and mirrors FixedPoint's scalar operators bit for bit:
+ *
+ *   mul:  (a * b + 2^(F-1)) >> F, truncated (Wrap) or clamped (Saturate)
+ *   add:  a + b, wrapped or clamped toward the sign of the overflow
+ *   sub:  a - b, wrapped or clamped toward the sign of the overflow
+ *   mul_add: mul(a, b) followed by add(., c), each step in the same policy
+ *   clamp: min(max(a, lo), hi)
+ *   dot:  *acc += sum(a[i] * b[i]) on full-precision products, modulo 2^64
+ *   biquad_df1, biquad_tdf2: one biquad step on n independent channels, in
+ *         place on x, at full precision with one rounding per output
+ *   from_float: in[i] * 2^F rounded to nearest (ties even at the default
+ *         rounding mode, or away from zero), saturated, NaN to zero
+ *   to_float: in[i] * 2^-F, exact up to float's own rounding
+ *   transform4x4: out[4i + r] = sum(m[4r + c] * in[4i + c]) over c, rounded
+ *         once and narrowed like mul, for n row-major 4x4 products
+ *   gemm_s8_tile: one 4 x 16 tile of an int8 matrix product, accumulated
+ *         into int32 modulo 2^32 (see below)
+ *   table_lookup: out[i] = a function table's segment polynomial at in[i],
+ *         gathered per lane (see TableSpec); x86 AVX2 and AVX-512 only
+ *
+ * Kernels only process whole vectors and return the number of elements
+ * consumed; the caller finishes the tail with the scalar operators. F is the
+ * number of fractional bits and must be in [1, bits - 1] (the conversions
+ * also accept 0). dot does no rounding
+ * at all, so a whole dot product is rounded once by the caller; the sum is
+ * exact modulo 2^64 regardless of the order lanes are added in.
+ *
+ * The biquad kernels take structure-of-arrays rows of n values: c holds
+ * b0, b1, b2, a1, a2, and s the state (x1, x2, y1, y2 for Direct Form 1;
+ * 64-bit s1, s2 at 2F fractional bits for Transposed Direct Form II). Each
+ * output is (sum + 2^(F-1)) >> F, truncated or clamped, with F the
+ * coefficients' fractional bits, and y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2.
+ *
+ * gemm_s8_tile(a, a_stride, b, k4, acc) multiplies 4 rows of a, a_stride
+ * bytes apart, by a packed panel of 16 columns and adds to the row-major
+ * 4 x 16 int32 tile acc:
+ *
+ *   acc[16r + j] += sum(a[r][k] * b[k][j]) over 4 * k4 values of k
+ *
+ * The panel holds 4 consecutive k of column 0, then of column 1 and so on,
+ * 64 bytes per group of 4 k. vpdpbusd multiplies unsigned bytes by signed
+ * ones, so the VNNI kernels read a as unsigned, and gemm_a_offset is 128:
+ * the caller stores a[r][k] + 128 (its sign bit flipped) and starts acc at
+ * -128 times b's column sums. Every other kernel set has gemm_a_offset 0 and
+ * signed a. The sums are exact modulo 2^32 on every path.
+ */
+
+namespace detail {
+
+inline int64_t wrap_add(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+
+// Four bytes of an int8 row, as broadcast by the GEMM kernels
+inline uint32_t load_i8x4(const int8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+} // namespace detail
+
+/**
+ * @brief A piecewise polynomial table as table_lookup reads it
+ *
+ * An input is clamped to [lo, hi] and its segment position, in Q31 segments,
+ * is ((x - lo) * scale) >> shift as a 64-bit product; the last segment also
+ * takes x == hi, at t just below 1. Each segment holds degree + 1
+ * coefficients, lowest order first, with c[k] scaled by 2^k so that one
+ * Horner step is acc = c[k] + ((acc * t) >> 32) in 32 bits. The result is
+ * rounded by guard_bits and clamped to [out_min, out_max].
+ */
+struct TableSpec {
+    const int32_t* coefficients;
+    int32_t lo;
+    int32_t hi;
+    uint32_t scale;
+    int shift;
+    int32_t segments;
+    int degree;
+    int guard_bits;
+    int32_t out_min;
+    int32_t out_max;
+};
+
+#if defined(FIXP_SIMD_X86)
+
+//-----------------------------------------------------------------------------
+// SSE4.1 (4 x int32, 8 x int16)
+//-----------------------------------------------------------------------------
+namespace sse41 {
+
+FIXP_TARGET_SSE41 inline __m128i add_i32(__m128i a, __m128i b, bool saturate) {
+    __m128i s = _mm_add_epi32(a, b);
+    if (!saturate) return s;
+    __m128i ovf = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, s), _mm_xor_si128(b, s)), 31);
+    __m128i sat = _mm_xor_si128(_mm_srai_epi32(b, 31), _mm_set1_epi32(INT32_MAX));
+    return _mm_blendv_epi8(s, sat, ovf);
+}
+
+FIXP_TARGET_SSE41 inline __m128i sub_i32(__m128i a, __m128i b, bool saturate) {
+    __m128i s = _mm_sub_epi32(a, b);
+    if (!saturate) return s;
+    __m128i ovf = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, s)), 31);
+    __m128i sat = _mm_xor_si128(_mm_srai_epi32(b, 31), _mm_set1_epi32(INT32_MIN));
+    return _mm_blendv_epi8(s, sat, ovf);
+}
+
+// Narrows rounded 64-bit products to the low dword of each lane
+FIXP_TARGET_SSE41 inline __m128i narrow_i64(__m128i q, int frac_bits, bool saturate) {
+    __m128i lo = _mm_srl_epi64(q, _mm_cvtsi32_si128(frac_bits));
+    if (!saturate) return lo;
+    // Fits iff every bit from F+31 upward equals the sign bit
+    __m128i top = _mm_srl_epi64(q, _mm_cvtsi32_si128(frac_bits + 31));
+    __m128i ones = _mm_set1_epi64x((int64_t{1} << (33 - frac_bits)) - 1);
+    __m128i fits = _mm_or_si128(_mm_cmpeq_epi64(top, _mm_setzero_si128()),
+                                _mm_cmpeq_epi64(top, ones));
+    __m128i neg = _mm_shuffle_epi32(_mm_srai_epi32(q, 31), _MM_SHUFFLE(3, 3, 1, 1));
+    __m128i sat = _mm_xor_si128(neg, _mm_set1_epi64x(INT32_MAX));
+    return _mm_blendv_epi8(sat, lo, fits);
+}
+
+FIXP_TARGET_SSE41 inline __m128i mul_i32(__m128i a, __m128i b, int frac_bits, bool saturate) {
+    const __m128i rnd = _mm_set1_epi64x(int64_t{1} << (frac_bits - 1));
+    __m128i pe = _mm_add_epi64(_mm_mul_epi32(a, b), rnd);
+    __m128i po = _mm_add_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), rnd);
+    __m128i re = narrow_i64(pe, frac_bits, saturate);
+    __m128i ro = narrow_i64(po, frac_bits, saturate);
+    return _mm_blend_epi16(re, _mm_slli_epi64(ro, 32), 0xCC);
+}
+
+FIXP_TARGET_SSE41 inline __m128i mul_i16(__m128i a, __m128i b, int frac_bits, bool saturate) {
+    if (frac_bits == 15 && !saturate) {
+        return _mm_mulhrs_epi16(a, b);
+    }
+    __m128i lo = _mm_mullo_epi16(a, b);
+    __m128i hi = _mm_mulhi_epi16(a, b);
+    const __m128i rnd = _mm_set1_epi32(1 << (frac_bits - 1));
+    const __m128i cnt = _mm_cvtsi32_si128(frac_bits);
+    __m128i p0 = _mm_sra_epi32(_mm_add_epi32(_mm_unpacklo_epi16(lo, hi), rnd), cnt);
+    __m128i p1 = _mm_sra_epi32(_mm_add_epi32(_mm_unpackhi_epi16(lo, hi), rnd), cnt);
+    if (saturate) return _mm_packs_epi32(p0, p1);
+    const __m128i mask = _mm_set1_epi32(0xFFFF);
+    return _mm_packus_epi32(_mm_and_si128(p0, mask), _mm_and_si128(p1, mask));
+}
+
+FIXP_TARGET_SSE41 inline __m128i add_i16(__m128i a, __m128i b, bool saturate) {
+    return saturate ? _mm_adds_epi16(a, b) : _mm_add_epi16(a, b);
+}
+
+FIXP_TARGET_SSE41 inline __m128i sub_i16(__m128i a, __m128i b, bool saturate) {
+    return saturate ? _mm_subs_epi16(a, b) : _mm_sub_epi16(a, b);
+}
+
+FIXP_TARGET_SSE41 inline __m128i load(const void* p) {
+    return _mm_loadu_si128(static_cast<const __m128i*>(p));
+}
+
+FIXP_TARGET_SSE41 inline void store(void* p, __m128i v) {
+    _mm_storeu_si128(static_cast<__m128i*>(p), v);
+}
+
+FIXP_TARGET_SSE41 inline int64_t hsum_i64(__m128i v) {
+    alignas(16) int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+    return detail::wrap_add(lanes[0], lanes[1]);
+}
+
+FIXP_TARGET_SSE41 inline size_t add(const int32_t* a, const int32_t* b, int32_t* out,
+                                    size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) store(out + i, add_i32(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t sub(const int32_t* a, const int32_t* b, int32_t* out,
+                                    size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) store(out + i, sub_i32(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t mul(const int32_t* a, const int32_t* b, int32_t* out,
+                                    size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        store(out + i, mul_i32(load(a + i), load(b + i), frac_bits, saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t mul_add(const int32_t* a, const int32_t* b, const int32_t* c,
+                                        int32_t* out, size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i p = mul_i32(load(a + i), load(b + i), frac_bits, saturate);
+        store(out + i, add_i32(p, load(c + i), saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t scale(const int32_t* a, int32_t s, int32_t* out,
+                                      size_t n, int frac_bits, bool saturate) {
+    const __m128i vs = _mm_set1_epi32(s);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) store(out + i, mul_i32(load(a + i), vs, frac_bits, saturate));
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t clamp(const int32_t* a, int32_t lo, int32_t hi, int32_t* out,
+                                      size_t n) {
+    const __m128i vlo = _mm_set1_epi32(lo);
+    const __m128i vhi = _mm_set1_epi32(hi);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        store(out + i, _mm_min_epi32(_mm_max_epi32(load(a + i), vlo), vhi));
+    }
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t add(const int16_t* a, const int16_t* b, int16_t* out,
+                                    size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) store(out + i, add_i16(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t sub(const int16_t* a, const int16_t* b, int16_t* out,
+                                    size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) store(out + i, sub_i16(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t mul(const int16_t* a, const int16_t* b, int16_t* out,
+                                    size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        store(out + i, mul_i16(load(a + i), load(b + i), frac_bits, saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t mul_add(const int16_t* a, const int16_t* b, const int16_t* c,
+                                        int16_t* out, size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i p = mul_i16(load(a + i), load(b + i), frac_bits, saturate);
+        store(out + i, add_i16(p, load(c + i), saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t scale(const int16_t* a, int16_t s, int16_t* out,
+                                      size_t n, int frac_bits, bool saturate) {
+    const __m128i vs = _mm_set1_epi16(s);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) store(out + i, mul_i16(load(a + i), vs, frac_bits, saturate));
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t clamp(const int16_t* a, int16_t lo, int16_t hi, int16_t* out,
+                                      size_t n) {
+    const __m128i vlo = _mm_set1_epi16(lo);
+    const __m128i vhi = _mm_set1_epi16(hi);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        store(out + i, _mm_min_epi16(_mm_max_epi16(load(a + i), vlo), vhi));
+    }
+    return i;
+}
+
+// Sum of a[i] * b[i] over the consumed elements, added to *acc modulo 2^64
+FIXP_TARGET_SSE41 inline size_t dot(const int32_t* a, const int32_t* b, size_t n, int64_t* acc) {
+    __m128i sum = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = load(a + i);
+        __m128i vb = load(b + i);
+        sum = _mm_add_epi64(sum, _mm_mul_epi32(va, vb));
+        sum = _mm_add_epi64(sum, _mm_mul_epi32(_mm_srli_epi64(va, 32), _mm_srli_epi64(vb, 32)));
+    }
+    *acc = detail::wrap_add(*acc, hsum_i64(sum));
+    return i;
+}
+
+// madd wraps only for a pair of INT16_MIN products (2^31 -> INT32_MIN); those
+// lanes are counted and the missing 2^32 added back at the end
+FIXP_TARGET_SSE41 inline size_t dot(const int16_t* a, const int16_t* b, size_t n, int64_t* acc) {
+    const __m128i wrapped = _mm_set1_epi32(INT32_MIN);
+    __m128i sum = _mm_setzero_si128();
+    __m128i fix = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i p = _mm_madd_epi16(load(a + i), load(b + i));
+        fix = _mm_sub_epi32(fix, _mm_cmpeq_epi32(p, wrapped));
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(p));
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(_mm_srli_si128(p, 8)));
+    }
+    sum = _mm_add_epi64(sum, _mm_slli_epi64(_mm_cvtepu32_epi64(fix), 32));
+    sum = _mm_add_epi64(sum, _mm_slli_epi64(_mm_cvtepu32_epi64(_mm_srli_si128(fix, 8)), 32));
+    *acc = detail::wrap_add(*acc, hsum_i64(sum));
+    return i;
+}
+
+// Two int32 lanes sign-extended to int64, and the low dwords of two int64 lanes
+FIXP_TARGET_SSE41 inline __m128i load_i32x2(const int32_t* p) {
+    return _mm_cvtepi32_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+}
+
+FIXP_TARGET_SSE41 inline void store_i32x2(int32_t* p, __m128i v) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+FIXP_TARGET_SSE41 inline size_t biquad_df1(const int32_t* c, int32_t* s, int32_t* x, size_t n,
+                                           int frac_bits, bool saturate) {
+    const __m128i rnd = _mm_set1_epi64x(int64_t{1} << (frac_bits - 1));
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128i vx = load_i32x2(x + i);
+        const __m128i x1 = load_i32x2(s + i);
+        const __m128i y1 = load_i32x2(s + 2 * n + i);
+        __m128i acc = _mm_add_epi64(rnd, _mm_mul_epi32(vx, load_i32x2(c + i)));
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(x1, load_i32x2(c + n + i)));
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(load_i32x2(s + n + i), load_i32x2(c + 2 * n + i)));
+        acc = _mm_sub_epi64(acc, _mm_mul_epi32(y1, load_i32x2(c + 3 * n + i)));
+        acc = _mm_sub_epi64(acc, _mm_mul_epi32(load_i32x2(s + 3 * n + i),
+                                               load_i32x2(c + 4 * n + i)));
+        const __m128i y = narrow_i64(acc, frac_bits, saturate);
+        store_i32x2(s + n + i, x1);
+        store_i32x2(s + i, vx);
+        store_i32x2(s + 3 * n + i, y1);
+        store_i32x2(s + 2 * n + i, y);
+        store_i32x2(x + i, y);
+    }
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t biquad_tdf2(const int32_t* c, int64_t* s, int32_t* x, size_t n,
+                                            int frac_bits, bool saturate) {
+    const __m128i rnd = _mm_set1_epi64x(int64_t{1} << (frac_bits - 1));
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128i vx = load_i32x2(x + i);
+        const __m128i s1 = load(s + i);
+        const __m128i s2 = load(s + n + i);
+        const __m128i acc = _mm_add_epi64(_mm_add_epi64(rnd, s1),
+                                          _mm_mul_epi32(vx, load_i32x2(c + i)));
+        const __m128i y = narrow_i64(acc, frac_bits, saturate);
+        __m128i n1 = _mm_sub_epi64(_mm_mul_epi32(vx, load_i32x2(c + n + i)),
+                                   _mm_mul_epi32(y, load_i32x2(c + 3 * n + i)));
+        __m128i n2 = _mm_sub_epi64(_mm_mul_epi32(vx, load_i32x2(c + 2 * n + i)),
+                                   _mm_mul_epi32(y, load_i32x2(c + 4 * n + i)));
+        store(s + i, _mm_add_epi64(n1, s2));
+        store(s + n + i, n2);
+        store_i32x2(x + i, y);
+    }
+    return i;
+}
+
+// Floats to int32 at the current (default nearest-even) rounding mode or ties
+// away from zero, saturating; NaN converts to zero
+FIXP_TARGET_SSE41 inline __m128i cvt_ps_i32(__m128 v, bool half_even) {
+    if (!half_even) {
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        const __m128 t = _mm_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        const __m128 frac = _mm_andnot_ps(sign_mask, _mm_sub_ps(v, t));
+        const __m128 step = _mm_or_ps(_mm_and_ps(v, sign_mask), _mm_set1_ps(1.0f));
+        v = _mm_add_ps(t, _mm_and_ps(_mm_cmpge_ps(frac, _mm_set1_ps(0.5f)), step));
+    }
+    // Overflow converts to INT32_MIN; flip the positive side to INT32_MAX
+    __m128i r = _mm_cvtps_epi32(v);
+    r = _mm_xor_si128(r, _mm_castps_si128(_mm_cmpge_ps(v, _mm_set1_ps(2147483648.0f))));
+    return _mm_and_si128(r, _mm_castps_si128(_mm_cmpord_ps(v, v)));
+}
+
+FIXP_TARGET_SSE41 inline size_t from_float(const float* in, int32_t* out, size_t n,
+                                           int frac_bits, bool half_even) {
+    const __m128 scale = _mm_set1_ps(static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        store(out + i, cvt_ps_i32(_mm_mul_ps(_mm_loadu_ps(in + i), scale), half_even));
+    }
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t from_float(const float* in, int16_t* out, size_t n,
+                                           int frac_bits, bool half_even) {
+    const __m128 scale = _mm_set1_ps(static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo = cvt_ps_i32(_mm_mul_ps(_mm_loadu_ps(in + i), scale), half_even);
+        __m128i hi = cvt_ps_i32(_mm_mul_ps(_mm_loadu_ps(in + i + 4), scale), half_even);
+        store(out + i, _mm_packs_epi32(lo, hi));
+    }
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t to_float(const int32_t* in, float* out, size_t n, int frac_bits) {
+    const __m128 scale = _mm_set1_ps(1.0f / static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(load(in + i)), scale));
+    }
+    return i;
+}
+
+FIXP_TARGET_SSE41 inline size_t to_float(const int16_t* in, float* out, size_t n, int frac_bits) {
+    const __m128 scale = _mm_set1_ps(1.0f / static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i v = _mm_cvtepi16_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i)));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+    return i;
+}
+
+// Rows 0-1 and 2-3 of m times one vector, one 64-bit lane per row
+FIXP_TARGET_SSE41 inline size_t transform4x4(const int32_t* m, const int32_t* in, int32_t* out,
+                                             size_t n, int frac_bits, bool saturate) {
+    const __m128i rnd = _mm_set1_epi64x(int64_t{1} << (frac_bits - 1));
+    __m128i lo[4], hi[4];
+    for (int c = 0; c < 4; ++c) {
+        lo[c] = _mm_set_epi64x(m[4 + c], m[c]);
+        hi[c] = _mm_set_epi64x(m[12 + c], m[8 + c]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        __m128i r01 = rnd, r23 = rnd;
+        for (int c = 0; c < 4; ++c) {
+            const __m128i v = _mm_set1_epi32(in[4 * i + static_cast<size_t>(c)]);
+            r01 = _mm_add_epi64(r01, _mm_mul_epi32(lo[c], v));
+            r23 = _mm_add_epi64(r23, _mm_mul_epi32(hi[c], v));
+        }
+        r01 = _mm_shuffle_epi32(narrow_i64(r01, frac_bits, saturate), _MM_SHUFFLE(3, 1, 2, 0));
+        r23 = _mm_shuffle_epi32(narrow_i64(r23, frac_bits, saturate), _MM_SHUFFLE(3, 1, 2, 0));
+        store(out + 4 * i, _mm_unpacklo_epi64(r01, r23));
+    }
+    return n;
+}
+
+} // namespace sse41
+
+//-----------------------------------------------------------------------------
+// AVX2 (8 x int32, 16 x int16)
+//-----------------------------------------------------------------------------
+namespace avx2 {
+
+FIXP_TARGET_AVX2 inline __m256i add_i32(__m256i a, __m256i b, bool saturate) {
+    __m256i s = _mm256_add_epi32(a, b);
+    if (!saturate) return s;
+    __m256i ovf = _mm256_srai_epi32(
+        _mm256_and_si256(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s)), 31);
+    __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(b, 31), _mm256_set1_epi32(INT32_MAX));
+    return _mm256_blendv_epi8(s, sat, ovf);
+}
+
+FIXP_TARGET_AVX2 inline __m256i sub_i32(__m256i a, __m256i b, bool saturate) {
+    __m256i s = _mm256_sub_epi32(a, b);
+    if (!saturate) return s;
+    __m256i ovf = _mm256_srai_epi32(
+        _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, s)), 31);
+    __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(b, 31), _mm256_set1_epi32(INT32_MIN));
+    return _mm256_blendv_epi8(s, sat, ovf);
+}
+
+FIXP_TARGET_AVX2 inline __m256i narrow_i64(__m256i q, int frac_bits, bool saturate) {
+    __m256i lo = _mm256_srl_epi64(q, _mm_cvtsi32_si128(frac_bits));
+    if (!saturate) return lo;
+    __m256i top = _mm256_srl_epi64(q, _mm_cvtsi32_si128(frac_bits + 31));
+    __m256i ones = _mm256_set1_epi64x((int64_t{1} << (33 - frac_bits)) - 1);
+    __m256i fits = _mm256_or_si256(_mm256_cmpeq_epi64(top, _mm256_setzero_si256()),
+                                   _mm256_cmpeq_epi64(top, ones));
+    __m256i neg = _mm256_shuffle_epi32(_mm256_srai_epi32(q, 31), _MM_SHUFFLE(3, 3, 1, 1));
+    __m256i sat = _mm256_xor_si256(neg, _mm256_set1_epi64x(INT32_MAX));
+    return _mm256_blendv_epi8(sat, lo, fits);
+}
+
+FIXP_TARGET_AVX2 inline __m256i mul_i32(__m256i a, __m256i b, int frac_bits, bool saturate) {
+    const __m256i rnd = _mm256_set1_epi64x(int64_t{1} << (frac_bits - 1));
+    __m256i pe = _mm256_add_epi64(_mm256_mul_epi32(a, b), rnd);
+    __m256i po = _mm256_add_epi64(
+        _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), rnd);
+    __m256i re = narrow_i64(pe, frac_bits, saturate);
+    __m256i ro = narrow_i64(po, frac_bits, saturate);
+    return _mm256_blend_epi32(re, _mm256_slli_epi64(ro, 32), 0xAA);
+}
+
+FIXP_TARGET_AVX2 inline __m256i mul_i16(__m256i a, __m256i b, int frac_bits, bool saturate) {
+    if (frac_bits == 15 && !saturate) {
+        return _mm256_mulhrs_epi16(a, b);
+    }
+    __m256i lo = _mm256_mullo_epi16(a, b);
+    __m256i hi = _mm256_mulhi_epi16(a, b);
+    const __m256i rnd = _mm256_set1_epi32(1 << (frac_bits - 1));
+    const __m128i cnt = _mm_cvtsi32_si128(frac_bits);
+    // unpack/pack both work within 128-bit lanes, so element order survives
+    __m256i p0 = _mm256_sra_epi32(_mm256_add_epi32(_mm256_unpacklo_epi16(lo, hi), rnd), cnt);
+    __m256i p1 = _mm256_sra_epi32(_mm256_add_epi32(_mm256_unpackhi_epi16(lo, hi), rnd), cnt);
+    if (saturate) return _mm256_packs_epi32(p0, p1);
+    const __m256i mask = _mm256_set1_epi32(0xFFFF);
+    return _mm256_packus_epi32(_mm256_and_si256(p0, mask), _mm256_and_si256(p1, mask));
+}
+
+FIXP_TARGET_AVX2 inline __m256i add_i16(__m256i a, __m256i b, bool saturate) {
+    return saturate ? _mm256_adds_epi16(a, b) : _mm256_add_epi16(a, b);
+}
+
+FIXP_TARGET_AVX2 inline __m256i sub_i16(__m256i a, __m256i b, bool saturate) {
+    return saturate ? _mm256_subs_epi16(a, b) : _mm256_sub_epi16(a, b);
+}
+
+FIXP_TARGET_AVX2 inline __m256i load(const void* p) {
+    return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+}
+
+FIXP_TARGET_AVX2 inline void store(void* p, __m256i v) {
+    _mm256_storeu_si256(static_cast<__m256i*>(p), v);
+}
+
+FIXP_TARGET_AVX2 inline int64_t hsum_i64(__m256i v) {
+    alignas(16) int64_t lanes[2];
+    __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), s);
+    return detail::wrap_add(lanes[0], lanes[1]);
+}
+
+FIXP_TARGET_AVX2 inline size_t add(const int32_t* a, const int32_t* b, int32_t* out,
+                                   size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) store(out + i, add_i32(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t sub(const int32_t* a, const int32_t* b, int32_t* out,
+                                   size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) store(out + i, sub_i32(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t mul(const int32_t* a, const int32_t* b, int32_t* out,
+                                   size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        store(out + i, mul_i32(load(a + i), load(b + i), frac_bits, saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t mul_add(const int32_t* a, const int32_t* b, const int32_t* c,
+                                       int32_t* out, size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i p = mul_i32(load(a + i), load(b + i), frac_bits, saturate);
+        store(out + i, add_i32(p, load(c + i), saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t scale(const int32_t* a, int32_t s, int32_t* out,
+                                     size_t n, int frac_bits, bool saturate) {
+    const __m256i vs = _mm256_set1_epi32(s);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) store(out + i, mul_i32(load(a + i), vs, frac_bits, saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t clamp(const int32_t* a, int32_t lo, int32_t hi, int32_t* out,
+                                     size_t n) {
+    const __m256i vlo = _mm256_set1_epi32(lo);
+    const __m256i vhi = _mm256_set1_epi32(hi);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        store(out + i, _mm256_min_epi32(_mm256_max_epi32(load(a + i), vlo), vhi));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t add(const int16_t* a, const int16_t* b, int16_t* out,
+                                   size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) store(out + i, add_i16(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t sub(const int16_t* a, const int16_t* b, int16_t* out,
+                                   size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) store(out + i, sub_i16(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t mul(const int16_t* a, const int16_t* b, int16_t* out,
+                                   size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        store(out + i, mul_i16(load(a + i), load(b + i), frac_bits, saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t mul_add(const int16_t* a, const int16_t* b, const int16_t* c,
+                                       int16_t* out, size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i p = mul_i16(load(a + i), load(b + i), frac_bits, saturate);
+        store(out + i, add_i16(p, load(c + i), saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t scale(const int16_t* a, int16_t s, int16_t* out,
+                                     size_t n, int frac_bits, bool saturate) {
+    const __m256i vs = _mm256_set1_epi16(s);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) store(out + i, mul_i16(load(a + i), vs, frac_bits, saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t clamp(const int16_t* a, int16_t lo, int16_t hi, int16_t* out,
+                                     size_t n) {
+    const __m256i vlo = _mm256_set1_epi16(lo);
+    const __m256i vhi = _mm256_set1_epi16(hi);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        store(out + i, _mm256_min_epi16(_mm256_max_epi16(load(a + i), vlo), vhi));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t dot(const int32_t* a, const int32_t* b, size_t n, int64_t* acc) {
+    __m256i sum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = load(a + i);
+        __m256i vb = load(b + i);
+        sum = _mm256_add_epi64(sum, _mm256_mul_epi32(va, vb));
+        sum = _mm256_add_epi64(sum, _mm256_mul_epi32(_mm256_srli_epi64(va, 32),
+                                                     _mm256_srli_epi64(vb, 32)));
+    }
+    *acc = detail::wrap_add(*acc, hsum_i64(sum));
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t dot(const int16_t* a, const int16_t* b, size_t n, int64_t* acc) {
+    const __m256i wrapped = _mm256_set1_epi32(INT32_MIN);
+    __m256i sum = _mm256_setzero_si256();
+    __m256i fix = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i p = _mm256_madd_epi16(load(a + i), load(b + i));
+        fix = _mm256_sub_epi32(fix, _mm256_cmpeq_epi32(p, wrapped));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(p)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(p, 1)));
+    }
+    __m256i lo = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(fix));
+    __m256i hi = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(fix, 1));
+    sum = _mm256_add_epi64(sum, _mm256_slli_epi64(_mm256_add_epi64(lo, hi), 32));
+    *acc = detail::wrap_add(*acc, hsum_i64(sum));
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline __m256i load_i32x4(const int32_t* p) {
+    return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+FIXP_TARGET_AVX2 inline void store_i32x4(int32_t* p, __m256i v) {
+    const __m256i even = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p),
+                     _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, even)));
+}
+
+FIXP_TARGET_AVX2 inline size_t biquad_df1(const int32_t* c, int32_t* s, int32_t* x, size_t n,
+                                          int frac_bits, bool saturate) {
+    const __m256i rnd = _mm256_set1_epi64x(int64_t{1} << (frac_bits - 1));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i vx = load_i32x4(x + i);
+        const __m256i x1 = load_i32x4(s + i);
+        const __m256i y1 = load_i32x4(s + 2 * n + i);
+        __m256i acc = _mm256_add_epi64(rnd, _mm256_mul_epi32(vx, load_i32x4(c + i)));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(x1, load_i32x4(c + n + i)));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(load_i32x4(s + n + i),
+                                                     load_i32x4(c + 2 * n + i)));
+        acc = _mm256_sub_epi64(acc, _mm256_mul_epi32(y1, load_i32x4(c + 3 * n + i)));
+        acc = _mm256_sub_epi64(acc, _mm256_mul_epi32(load_i32x4(s + 3 * n + i),
+                                                     load_i32x4(c + 4 * n + i)));
+        const __m256i y = narrow_i64(acc, frac_bits, saturate);
+        store_i32x4(s + n + i, x1);
+        store_i32x4(s + i, vx);
+        store_i32x4(s + 3 * n + i, y1);
+        store_i32x4(s + 2 * n + i, y);
+        store_i32x4(x + i, y);
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t biquad_tdf2(const int32_t* c, int64_t* s, int32_t* x, size_t n,
+                                           int frac_bits, bool saturate) {
+    const __m256i rnd = _mm256_set1_epi64x(int64_t{1} << (frac_bits - 1));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i vx = load_i32x4(x + i);
+        const __m256i s1 = load(s + i);
+        const __m256i s2 = load(s + n + i);
+        const __m256i acc = _mm256_add_epi64(_mm256_add_epi64(rnd, s1),
+                                             _mm256_mul_epi32(vx, load_i32x4(c + i)));
+        const __m256i y = narrow_i64(acc, frac_bits, saturate);
+        __m256i n1 = _mm256_sub_epi64(_mm256_mul_epi32(vx, load_i32x4(c + n + i)),
+                                      _mm256_mul_epi32(y, load_i32x4(c + 3 * n + i)));
+        __m256i n2 = _mm256_sub_epi64(_mm256_mul_epi32(vx, load_i32x4(c + 2 * n + i)),
+                                      _mm256_mul_epi32(y, load_i32x4(c + 4 * n + i)));
+        store(s + i, _mm256_add_epi64(n1, s2));
+        store(s + n + i, n2);
+        store_i32x4(x + i, y);
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline __m256i cvt_ps_i32(__m256 v, bool half_even) {
+    if (!half_even) {
+        const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+        const __m256 t = _mm256_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        const __m256 frac = _mm256_andnot_ps(sign_mask, _mm256_sub_ps(v, t));
+        const __m256 step = _mm256_or_ps(_mm256_and_ps(v, sign_mask), _mm256_set1_ps(1.0f));
+        const __m256 up = _mm256_cmp_ps(frac, _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+        v = _mm256_add_ps(t, _mm256_and_ps(up, step));
+    }
+    __m256i r = _mm256_cvtps_epi32(v);
+    const __m256 over = _mm256_cmp_ps(v, _mm256_set1_ps(2147483648.0f), _CMP_GE_OQ);
+    r = _mm256_xor_si256(r, _mm256_castps_si256(over));
+    return _mm256_and_si256(r, _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_ORD_Q)));
+}
+
+FIXP_TARGET_AVX2 inline size_t from_float(const float* in, int32_t* out, size_t n,
+                                          int frac_bits, bool half_even) {
+    const __m256 scale = _mm256_set1_ps(static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        store(out + i, cvt_ps_i32(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), half_even));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t from_float(const float* in, int16_t* out, size_t n,
+                                          int frac_bits, bool half_even) {
+    const __m256 scale = _mm256_set1_ps(static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i lo = cvt_ps_i32(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), half_even);
+        __m256i hi = cvt_ps_i32(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8), scale), half_even);
+        // packs works per 128-bit lane; restore element order across lanes
+        store(out + i, _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t to_float(const int32_t* in, float* out, size_t n, int frac_bits) {
+    const __m256 scale = _mm256_set1_ps(1.0f / static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(load(in + i)), scale));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t to_float(const int16_t* in, float* out, size_t n, int frac_bits) {
+    const __m256 scale = _mm256_set1_ps(1.0f / static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_cvtepi16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t transform4x4(const int32_t* m, const int32_t* in, int32_t* out,
+                                            size_t n, int frac_bits, bool saturate) {
+    const __m256i rnd = _mm256_set1_epi64x(int64_t{1} << (frac_bits - 1));
+    __m256i col[4];
+    for (int c = 0; c < 4; ++c) col[c] = _mm256_setr_epi64x(m[c], m[4 + c], m[8 + c], m[12 + c]);
+    for (size_t i = 0; i < n; ++i) {
+        __m256i r = rnd;
+        for (int c = 0; c < 4; ++c) {
+            const __m256i v = _mm256_set1_epi32(in[4 * i + static_cast<size_t>(c)]);
+            r = _mm256_add_epi64(r, _mm256_mul_epi32(col[c], v));
+        }
+        store_i32x4(out + 4 * i, narrow_i64(r, frac_bits, saturate));
+    }
+    return n;
+}
+
+inline constexpr int gemm_a_offset = 0;
+
+// vpmaddwd adds pairs of k and vphaddd the pairs, which leaves each half's
+// columns in the order 0, 1, 4, 5, 2, 3, 6, 7; the accumulators keep that
+// order until they are stored, and the permute is its own inverse
+FIXP_TARGET_AVX2 inline void gemm_s8_row(__m256i b0, __m256i b1, __m256i b2, __m256i b3,
+                                         const int8_t* a, __m256i& lo, __m256i& hi) {
+    const int32_t bytes = static_cast<int32_t>(detail::load_i8x4(a));
+    const __m256i va = _mm256_cvtepi8_epi16(_mm_set1_epi32(bytes));
+    lo = _mm256_add_epi32(lo, _mm256_hadd_epi32(_mm256_madd_epi16(b0, va),
+                                                _mm256_madd_epi16(b1, va)));
+    hi = _mm256_add_epi32(hi, _mm256_hadd_epi32(_mm256_madd_epi16(b2, va),
+                                                _mm256_madd_epi16(b3, va)));
+}
+
+FIXP_TARGET_AVX2 inline __m256i load_i8x16_i16(const int8_t* p) {
+    return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+FIXP_TARGET_AVX2 inline void gemm_s8_tile(const int8_t* a, size_t a_stride, const int8_t* b,
+                                          size_t k4, int32_t* acc) {
+    const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    __m256i c00 = _mm256_permutevar8x32_epi32(load(acc), order);
+    __m256i c01 = _mm256_permutevar8x32_epi32(load(acc + 8), order);
+    __m256i c10 = _mm256_permutevar8x32_epi32(load(acc + 16), order);
+    __m256i c11 = _mm256_permutevar8x32_epi32(load(acc + 24), order);
+    __m256i c20 = _mm256_permutevar8x32_epi32(load(acc + 32), order);
+    __m256i c21 = _mm256_permutevar8x32_epi32(load(acc + 40), order);
+    __m256i c30 = _mm256_permutevar8x32_epi32(load(acc + 48), order);
+    __m256i c31 = _mm256_permutevar8x32_epi32(load(acc + 56), order);
+    for (size_t kk = 0; kk < k4; ++kk, a += 4, b += 64) {
+        const __m256i b0 = load_i8x16_i16(b), b1 = load_i8x16_i16(b + 16);
+        const __m256i b2 = load_i8x16_i16(b + 32), b3 = load_i8x16_i16(b + 48);
+        gemm_s8_row(b0, b1, b2, b3, a, c00, c01);
+        gemm_s8_row(b0, b1, b2, b3, a + a_stride, c10, c11);
+        gemm_s8_row(b0, b1, b2, b3, a + 2 * a_stride, c20, c21);
+        gemm_s8_row(b0, b1, b2, b3, a + 3 * a_stride, c30, c31);
+    }
+    store(acc, _mm256_permutevar8x32_epi32(c00, order));
+    store(acc + 8, _mm256_permutevar8x32_epi32(c01, order));
+    store(acc + 16, _mm256_permutevar8x32_epi32(c10, order));
+    store(acc + 24, _mm256_permutevar8x32_epi32(c11, order));
+    store(acc + 32, _mm256_permutevar8x32_epi32(c20, order));
+    store(acc + 40, _mm256_permutevar8x32_epi32(c21, order));
+    store(acc + 48, _mm256_permutevar8x32_epi32(c30, order));
+    store(acc + 56, _mm256_permutevar8x32_epi32(c31, order));
+}
+
+
+// (a * b) >> 32 per signed 32-bit lane
+FIXP_TARGET_AVX2 inline __m256i mulhi_i32(__m256i a, __m256i b) {
+    const __m256i even = _mm256_mul_epi32(a, b);
+    const __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+FIXP_TARGET_AVX2 inline __m256i table_eval(__m256i x, const TableSpec& s) {
+    const __m256i lo = _mm256_set1_epi32(s.lo);
+    x = _mm256_min_epi32(_mm256_max_epi32(x, lo), _mm256_set1_epi32(s.hi));
+    const __m256i d = _mm256_sub_epi32(x, lo);
+    const __m256i scale = _mm256_set1_epi64x(s.scale);
+    const __m128i shift = _mm_cvtsi32_si128(s.shift);
+    const __m256i even = _mm256_srl_epi64(_mm256_mul_epu32(d, scale), shift);
+    const __m256i odd = _mm256_srl_epi64(_mm256_mul_epu32(_mm256_srli_epi64(d, 32), scale), shift);
+    const __m256i frac = _mm256_set1_epi64x(0x7FFFFFFF);
+    __m256i index = _mm256_blend_epi32(_mm256_srli_epi64(even, 31),
+                                       _mm256_slli_epi64(_mm256_srli_epi64(odd, 31), 32), 0xAA);
+    __m256i t = _mm256_blend_epi32(_mm256_and_si256(even, frac),
+                                   _mm256_slli_epi64(_mm256_and_si256(odd, frac), 32), 0xAA);
+    const __m256i last = _mm256_set1_epi32(s.segments - 1);
+    t = _mm256_blendv_epi8(t, _mm256_set1_epi32(INT32_MAX), _mm256_cmpgt_epi32(index, last));
+    index = _mm256_mullo_epi32(_mm256_min_epi32(index, last), _mm256_set1_epi32(s.degree + 1));
+
+    const int* c = reinterpret_cast<const int*>(s.coefficients);
+    __m256i acc = _mm256_i32gather_epi32(c + s.degree, index, 4);
+    for (int k = s.degree - 1; k >= 0; --k) {
+        acc = _mm256_add_epi32(_mm256_i32gather_epi32(c + k, index, 4), mulhi_i32(acc, t));
+    }
+    if (s.guard_bits > 0) {
+        acc = _mm256_sra_epi32(_mm256_add_epi32(acc, _mm256_set1_epi32(1 << (s.guard_bits - 1))),
+                               _mm_cvtsi32_si128(s.guard_bits));
+    }
+    return _mm256_min_epi32(_mm256_max_epi32(acc, _mm256_set1_epi32(s.out_min)),
+                            _mm256_set1_epi32(s.out_max));
+}
+
+FIXP_TARGET_AVX2 inline size_t table_lookup(const int32_t* in, int32_t* out, size_t n,
+                                            const TableSpec& s) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) store(out + i, table_eval(load(in + i), s));
+    return i;
+}
+
+FIXP_TARGET_AVX2 inline size_t table_lookup(const int16_t* in, int16_t* out, size_t n,
+                                            const TableSpec& s) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i x = _mm256_cvtepi16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        const __m256i r = table_eval(x, s);
+        // The results are clamped to int16 already, so the pack only reorders
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(r, r), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(packed));
+    }
+    return i;
+}
+
+} // namespace avx2
+
+//-----------------------------------------------------------------------------
+// AVX-512 F/BW (16 x int32, 32 x int16)
+//-----------------------------------------------------------------------------
+namespace avx512 {
+
+FIXP_TARGET_AVX512 inline __m512i add_i32(__m512i a, __m512i b, bool saturate) {
+    __m512i s = _mm512_add_epi32(a, b);
+    if (!saturate) return s;
+    __m512i t = _mm512_and_si512(_mm512_xor_si512(a, s), _mm512_xor_si512(b, s));
+    __mmask16 ovf = _mm512_cmplt_epi32_mask(t, _mm512_setzero_si512());
+    __m512i sat = _mm512_xor_si512(_mm512_srai_epi32(b, 31), _mm512_set1_epi32(INT32_MAX));
+    return _mm512_mask_blend_epi32(ovf, s, sat);
+}
+
+FIXP_TARGET_AVX512 inline __m512i sub_i32(__m512i a, __m512i b, bool saturate) {
+    __m512i s = _mm512_sub_epi32(a, b);
+    if (!saturate) return s;
+    __m512i t = _mm512_and_si512(_mm512_xor_si512(a, b), _mm512_xor_si512(a, s));
+    __mmask16 ovf = _mm512_cmplt_epi32_mask(t, _mm512_setzero_si512());
+    __m512i sat = _mm512_xor_si512(_mm512_srai_epi32(b, 31), _mm512_set1_epi32(INT32_MIN));
+    return _mm512_mask_blend_epi32(ovf, s, sat);
+}
+
+// Eight lanes at a time: sign-extend, multiply, round, then narrow with
+// vpmovqd (wrap) or vpmovsqd (saturate)
+FIXP_TARGET_AVX512 inline __m256i mul_i32x8(__m256i a, __m256i b, int frac_bits, bool saturate) {
+    const __m512i rnd = _mm512_set1_epi64(int64_t{1} << (frac_bits - 1));
+    __m512i p = _mm512_mul_epi32(_mm512_cvtepi32_epi64(a), _mm512_cvtepi32_epi64(b));
+    __m512i q = _mm512_sra_epi64(_mm512_add_epi64(p, rnd), _mm_cvtsi32_si128(frac_bits));
+    return saturate ? _mm512_cvtsepi64_epi32(q) : _mm512_cvtepi64_epi32(q);
+}
+
+FIXP_TARGET_AVX512 inline __m512i mul_i32(__m512i a, __m512i b, int frac_bits, bool saturate) {
+    __m256i lo = mul_i32x8(_mm512_castsi512_si256(a), _mm512_castsi512_si256(b),
+                           frac_bits, saturate);
+    __m256i hi = mul_i32x8(_mm512_extracti64x4_epi64(a, 1), _mm512_extracti64x4_epi64(b, 1),
+                           frac_bits, saturate);
+    return _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1);
+}
+
+FIXP_TARGET_AVX512 inline __m512i mul_i16(__m512i a, __m512i b, int frac_bits, bool saturate) {
+    if (frac_bits == 15 && !saturate) {
+        return _mm512_mulhrs_epi16(a, b);
+    }
+    __m512i lo = _mm512_mullo_epi16(a, b);
+    __m512i hi = _mm512_mulhi_epi16(a, b);
+    const __m512i rnd = _mm512_set1_epi32(1 << (frac_bits - 1));
+    const __m128i cnt = _mm_cvtsi32_si128(frac_bits);
+    __m512i p0 = _mm512_sra_epi32(_mm512_add_epi32(_mm512_unpacklo_epi16(lo, hi), rnd), cnt);
+    __m512i p1 = _mm512_sra_epi32(_mm512_add_epi32(_mm512_unpackhi_epi16(lo, hi), rnd), cnt);
+    if (saturate) return _mm512_packs_epi32(p0, p1);
+    const __m512i mask = _mm512_set1_epi32(0xFFFF);
+    return _mm512_packus_epi32(_mm512_and_si512(p0, mask), _mm512_and_si512(p1, mask));
+}
+
+FIXP_TARGET_AVX512 inline __m512i add_i16(__m512i a, __m512i b, bool saturate) {
+    return saturate ? _mm512_adds_epi16(a, b) : _mm512_add_epi16(a, b);
+}
+
+FIXP_TARGET_AVX512 inline __m512i sub_i16(__m512i a, __m512i b, bool saturate) {
+    return saturate ? _mm512_subs_epi16(a, b) : _mm512_sub_epi16(a, b);
+}
+
+FIXP_TARGET_AVX512 inline __m512i load(const void* p) {
+    return _mm512_loadu_si512(p);
+}
+
+FIXP_TARGET_AVX512 inline void store(void* p, __m512i v) {
+    _mm512_storeu_si512(p, v);
+}
+
+FIXP_TARGET_AVX512 inline size_t add(const int32_t* a, const int32_t* b, int32_t* out,
+                                     size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) store(out + i, add_i32(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t sub(const int32_t* a, const int32_t* b, int32_t* out,
+                                     size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) store(out + i, sub_i32(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t mul(const int32_t* a, const int32_t* b, int32_t* out,
+                                     size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        store(out + i, mul_i32(load(a + i), load(b + i), frac_bits, saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t mul_add(const int32_t* a, const int32_t* b, const int32_t* c,
+                                         int32_t* out, size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i p = mul_i32(load(a + i), load(b + i), frac_bits, saturate);
+        store(out + i, add_i32(p, load(c + i), saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t scale(const int32_t* a, int32_t s, int32_t* out,
+                                       size_t n, int frac_bits, bool saturate) {
+    const __m512i vs = _mm512_set1_epi32(s);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        store(out + i, mul_i32(load(a + i), vs, frac_bits, saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t clamp(const int32_t* a, int32_t lo, int32_t hi, int32_t* out,
+                                       size_t n) {
+    const __m512i vlo = _mm512_set1_epi32(lo);
+    const __m512i vhi = _mm512_set1_epi32(hi);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        store(out + i, _mm512_min_epi32(_mm512_max_epi32(load(a + i), vlo), vhi));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t add(const int16_t* a, const int16_t* b, int16_t* out,
+                                     size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) store(out + i, add_i16(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t sub(const int16_t* a, const int16_t* b, int16_t* out,
+                                     size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) store(out + i, sub_i16(load(a + i), load(b + i), saturate));
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t mul(const int16_t* a, const int16_t* b, int16_t* out,
+                                     size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        store(out + i, mul_i16(load(a + i), load(b + i), frac_bits, saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t mul_add(const int16_t* a, const int16_t* b, const int16_t* c,
+                                         int16_t* out, size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512i p = mul_i16(load(a + i), load(b + i), frac_bits, saturate);
+        store(out + i, add_i16(p, load(c + i), saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t scale(const int16_t* a, int16_t s, int16_t* out,
+                                       size_t n, int frac_bits, bool saturate) {
+    const __m512i vs = _mm512_set1_epi16(s);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        store(out + i, mul_i16(load(a + i), vs, frac_bits, saturate));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t clamp(const int16_t* a, int16_t lo, int16_t hi, int16_t* out,
+                                       size_t n) {
+    const __m512i vlo = _mm512_set1_epi16(lo);
+    const __m512i vhi = _mm512_set1_epi16(hi);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        store(out + i, _mm512_min_epi16(_mm512_max_epi16(load(a + i), vlo), vhi));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t dot(const int32_t* a, const int32_t* b, size_t n,
+                                     int64_t* acc) {
+    __m512i sum = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i va = load(a + i);
+        __m512i vb = load(b + i);
+        sum = _mm512_add_epi64(sum, _mm512_mul_epi32(va, vb));
+        sum = _mm512_add_epi64(sum, _mm512_mul_epi32(_mm512_srli_epi64(va, 32),
+                                                     _mm512_srli_epi64(vb, 32)));
+    }
+    *acc = detail::wrap_add(*acc, static_cast<int64_t>(_mm512_reduce_add_epi64(sum)));
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t dot(const int16_t* a, const int16_t* b, size_t n,
+                                     int64_t* acc) {
+    const __m512i wrapped = _mm512_set1_epi32(INT32_MIN);
+    const __m512i one = _mm512_set1_epi32(1);
+    __m512i sum = _mm512_setzero_si512();
+    __m512i fix = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512i p = _mm512_madd_epi16(load(a + i), load(b + i));
+        fix = _mm512_mask_add_epi32(fix, _mm512_cmpeq_epi32_mask(p, wrapped), fix, one);
+        // Sign-extend both int32 halves of each 64-bit lane in place
+        sum = _mm512_add_epi64(sum, _mm512_srai_epi64(_mm512_slli_epi64(p, 32), 32));
+        sum = _mm512_add_epi64(sum, _mm512_srai_epi64(p, 32));
+    }
+    // Only the counts modulo 2^32 matter once they are shifted into the high word
+    sum = _mm512_add_epi64(sum, _mm512_slli_epi64(fix, 32));
+    sum = _mm512_add_epi64(sum, _mm512_slli_epi64(_mm512_srli_epi64(fix, 32), 32));
+    *acc = detail::wrap_add(*acc, static_cast<int64_t>(_mm512_reduce_add_epi64(sum)));
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline __m512i load_i32x8(const int32_t* p) {
+    return _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+}
+
+FIXP_TARGET_AVX512 inline void store_i32x8(int32_t* p, __m512i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtepi64_epi32(v));
+}
+
+// Rounded 64-bit sums to int32 with vpmovqd (wrap) or vpmovsqd (saturate)
+FIXP_TARGET_AVX512 inline __m512i narrow_i64(__m512i q, int frac_bits, bool saturate) {
+    __m512i r = _mm512_sra_epi64(q, _mm_cvtsi32_si128(frac_bits));
+    return saturate ? _mm512_cvtepi32_epi64(_mm512_cvtsepi64_epi32(r)) : r;
+}
+
+FIXP_TARGET_AVX512 inline size_t biquad_df1(const int32_t* c, int32_t* s, int32_t* x, size_t n,
+                                            int frac_bits, bool saturate) {
+    const __m512i rnd = _mm512_set1_epi64(int64_t{1} << (frac_bits - 1));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512i vx = load_i32x8(x + i);
+        const __m512i x1 = load_i32x8(s + i);
+        const __m512i y1 = load_i32x8(s + 2 * n + i);
+        __m512i acc = _mm512_add_epi64(rnd, _mm512_mul_epi32(vx, load_i32x8(c + i)));
+        acc = _mm512_add_epi64(acc, _mm512_mul_epi32(x1, load_i32x8(c + n + i)));
+        acc = _mm512_add_epi64(acc, _mm512_mul_epi32(load_i32x8(s + n + i),
+                                                     load_i32x8(c + 2 * n + i)));
+        acc = _mm512_sub_epi64(acc, _mm512_mul_epi32(y1, load_i32x8(c + 3 * n + i)));
+        acc = _mm512_sub_epi64(acc, _mm512_mul_epi32(load_i32x8(s + 3 * n + i),
+                                                     load_i32x8(c + 4 * n + i)));
+        const __m512i y = narrow_i64(acc, frac_bits, saturate);
+        store_i32x8(s + n + i, x1);
+        store_i32x8(s + i, vx);
+        store_i32x8(s + 3 * n + i, y1);
+        store_i32x8(s + 2 * n + i, y);
+        store_i32x8(x + i, y);
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t biquad_tdf2(const int32_t* c, int64_t* s, int32_t* x, size_t n,
+                                             int frac_bits, bool saturate) {
+    const __m512i rnd = _mm512_set1_epi64(int64_t{1} << (frac_bits - 1));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512i vx = load_i32x8(x + i);
+        const __m512i s1 = load(s + i);
+        const __m512i s2 = load(s + n + i);
+        const __m512i acc = _mm512_add_epi64(_mm512_add_epi64(rnd, s1),
+                                             _mm512_mul_epi32(vx, load_i32x8(c + i)));
+        const __m512i y = narrow_i64(acc, frac_bits, saturate);
+        __m512i n1 = _mm512_sub_epi64(_mm512_mul_epi32(vx, load_i32x8(c + n + i)),
+                                      _mm512_mul_epi32(y, load_i32x8(c + 3 * n + i)));
+        __m512i n2 = _mm512_sub_epi64(_mm512_mul_epi32(vx, load_i32x8(c + 2 * n + i)),
+                                      _mm512_mul_epi32(y, load_i32x8(c + 4 * n + i)));
+        store(s + i, _mm512_add_epi64(n1, s2));
+        store(s + n + i, n2);
+        store_i32x8(x + i, y);
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline __m512i cvt_ps_i32(__m512 v, bool half_even) {
+    if (!half_even) {
+        // Sign transfer through integer ops: the float logic ops need AVX512DQ
+        // Truncate through int32 where v can have a fraction (|v| < 2^23); GCC
+        // 12's roundscale macro does not build cleanly with -Wsign-conversion
+        const __m512i bits = _mm512_castps_si512(v);
+        const __mmask16 small = _mm512_cmp_ps_mask(_mm512_abs_ps(v), _mm512_set1_ps(8388608.0f),
+                                                   _CMP_LT_OQ);
+        const __m512 t = _mm512_mask_mov_ps(v, small, _mm512_cvtepi32_ps(_mm512_cvttps_epi32(v)));
+        const __m512 step = _mm512_castsi512_ps(_mm512_or_si512(
+            _mm512_and_si512(bits, _mm512_set1_epi32(INT32_MIN)), _mm512_set1_epi32(0x3F800000)));
+        const __mmask16 up = _mm512_cmp_ps_mask(_mm512_abs_ps(_mm512_sub_ps(v, t)),
+                                                _mm512_set1_ps(0.5f), _CMP_GE_OQ);
+        v = _mm512_mask_add_ps(t, up, t, step);
+    }
+    __m512i r = _mm512_cvtps_epi32(v);
+    const __mmask16 over = _mm512_cmp_ps_mask(v, _mm512_set1_ps(2147483648.0f), _CMP_GE_OQ);
+    r = _mm512_mask_mov_epi32(r, over, _mm512_set1_epi32(INT32_MAX));
+    return _mm512_maskz_mov_epi32(_mm512_cmp_ps_mask(v, v, _CMP_ORD_Q), r);
+}
+
+FIXP_TARGET_AVX512 inline size_t from_float(const float* in, int32_t* out, size_t n,
+                                            int frac_bits, bool half_even) {
+    const __m512 scale = _mm512_set1_ps(static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        store(out + i, cvt_ps_i32(_mm512_mul_ps(_mm512_loadu_ps(in + i), scale), half_even));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t from_float(const float* in, int16_t* out, size_t n,
+                                            int frac_bits, bool half_even) {
+    const __m512 scale = _mm512_set1_ps(static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512i r = cvt_ps_i32(_mm512_mul_ps(_mm512_loadu_ps(in + i), scale), half_even);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvtsepi32_epi16(r));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t to_float(const int32_t* in, float* out, size_t n,
+                                          int frac_bits) {
+    const __m512 scale = _mm512_set1_ps(1.0f / static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_cvtepi32_ps(load(in + i)), scale));
+    }
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t to_float(const int16_t* in, float* out, size_t n,
+                                          int frac_bits) {
+    const __m512 scale = _mm512_set1_ps(1.0f / static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512i v = _mm512_cvtepi16_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_cvtepi32_ps(v), scale));
+    }
+    return i;
+}
+
+// Two vectors per iteration, one in each 256-bit half
+FIXP_TARGET_AVX512 inline size_t transform4x4(const int32_t* m, const int32_t* in, int32_t* out,
+                                              size_t n, int frac_bits, bool saturate) {
+    const __m512i rnd = _mm512_set1_epi64(int64_t{1} << (frac_bits - 1));
+    __m512i col[4], pick[4];
+    for (int c = 0; c < 4; ++c) {
+        col[c] = _mm512_setr_epi64(m[c], m[4 + c], m[8 + c], m[12 + c],
+                                   m[c], m[4 + c], m[8 + c], m[12 + c]);
+        pick[c] = _mm512_setr_epi32(c, 0, c, 0, c, 0, c, 0,
+                                    4 + c, 0, 4 + c, 0, 4 + c, 0, 4 + c, 0);
+    }
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m512i v = _mm512_castsi256_si512(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 4 * i)));
+        __m512i r = rnd;
+        for (int c = 0; c < 4; ++c) {
+            r = _mm512_add_epi64(r, _mm512_mul_epi32(col[c], _mm512_permutexvar_epi32(pick[c], v)));
+        }
+        store_i32x8(out + 4 * i, narrow_i64(r, frac_bits, saturate));
+    }
+    return i;
+}
+
+
+// (a * b) >> 32 per signed 32-bit lane
+FIXP_TARGET_AVX512 inline __m512i mulhi_i32(__m512i a, __m512i b) {
+    const __m512i even = _mm512_mul_epi32(a, b);
+    const __m512i odd = _mm512_mul_epi32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+    return _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+}
+
+// Without optimization GCC 12's gather intrinsics are macros that pass the
+// all-ones __mmask16 on as a short
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#endif
+FIXP_TARGET_AVX512 inline __m512i table_eval(__m512i x, const TableSpec& s) {
+    const __m512i lo = _mm512_set1_epi32(s.lo);
+    x = _mm512_min_epi32(_mm512_max_epi32(x, lo), _mm512_set1_epi32(s.hi));
+    const __m512i d = _mm512_sub_epi32(x, lo);
+    const __m512i scale = _mm512_set1_epi64(s.scale);
+    const __m128i shift = _mm_cvtsi32_si128(s.shift);
+    const __m512i even = _mm512_srl_epi64(_mm512_mul_epu32(d, scale), shift);
+    const __m512i odd = _mm512_srl_epi64(_mm512_mul_epu32(_mm512_srli_epi64(d, 32), scale), shift);
+    const __m512i frac = _mm512_set1_epi64(0x7FFFFFFF);
+    __m512i index = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 31),
+                                            _mm512_slli_epi64(_mm512_srli_epi64(odd, 31), 32));
+    __m512i t = _mm512_mask_blend_epi32(0xAAAA, _mm512_and_si512(even, frac),
+                                        _mm512_slli_epi64(_mm512_and_si512(odd, frac), 32));
+    const __m512i last = _mm512_set1_epi32(s.segments - 1);
+    t = _mm512_mask_mov_epi32(t, _mm512_cmpgt_epi32_mask(index, last), _mm512_set1_epi32(INT32_MAX));
+    index = _mm512_mullo_epi32(_mm512_min_epi32(index, last), _mm512_set1_epi32(s.degree + 1));
+
+    const int* c = reinterpret_cast<const int*>(s.coefficients);
+    __m512i acc = _mm512_i32gather_epi32(index, c + s.degree, 4);
+    for (int k = s.degree - 1; k >= 0; --k) {
+        acc = _mm512_add_epi32(_mm512_i32gather_epi32(index, c + k, 4), mulhi_i32(acc, t));
+    }
+    if (s.guard_bits > 0) {
+        acc = _mm512_sra_epi32(_mm512_add_epi32(acc, _mm512_set1_epi32(1 << (s.guard_bits - 1))),
+                               _mm_cvtsi32_si128(s.guard_bits));
+    }
+    return _mm512_min_epi32(_mm512_max_epi32(acc, _mm512_set1_epi32(s.out_min)),
+                            _mm512_set1_epi32(s.out_max));
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+FIXP_TARGET_AVX512 inline size_t table_lookup(const int32_t* in, int32_t* out, size_t n,
+                                              const TableSpec& s) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) store(out + i, table_eval(load(in + i), s));
+    return i;
+}
+
+FIXP_TARGET_AVX512 inline size_t table_lookup(const int16_t* in, int16_t* out, size_t n,
+                                              const TableSpec& s) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512i x = _mm512_cvtepi16_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm512_cvtepi32_epi16(table_eval(x, s)));
+    }
+    return i;
+}
+
+} // namespace avx512
+
+//-----------------------------------------------------------------------------
+// AVX-VNNI and AVX-512 VNNI (int8 GEMM only)
+//-----------------------------------------------------------------------------
+namespace avxvnni {
+
+inline constexpr int gemm_a_offset = 128;
+
+FIXP_TARGET_AVXVNNI inline void gemm_s8_row(__m256i b0, __m256i b1, const int8_t* a,
+                                            __m256i& lo, __m256i& hi) {
+    const __m256i va = _mm256_set1_epi32(static_cast<int32_t>(detail::load_i8x4(a)));
+    lo = _mm256_dpbusd_avx_epi32(lo, va, b0);
+    hi = _mm256_dpbusd_avx_epi32(hi, va, b1);
+}
+
+FIXP_TARGET_AVXVNNI inline void gemm_s8_tile(const int8_t* a, size_t a_stride, const int8_t* b,
+                                             size_t k4, int32_t* acc) {
+    __m256i c00 = avx2::load(acc), c01 = avx2::load(acc + 8);
+    __m256i c10 = avx2::load(acc + 16), c11 = avx2::load(acc + 24);
+    __m256i c20 = avx2::load(acc + 32), c21 = avx2::load(acc + 40);
+    __m256i c30 = avx2::load(acc + 48), c31 = avx2::load(acc + 56);
+    for (size_t kk = 0; kk < k4; ++kk, a += 4, b += 64) {
+        const __m256i b0 = avx2::load(b), b1 = avx2::load(b + 32);
+        gemm_s8_row(b0, b1, a, c00, c01);
+        gemm_s8_row(b0, b1, a + a_stride, c10, c11);
+        gemm_s8_row(b0, b1, a + 2 * a_stride, c20, c21);
+        gemm_s8_row(b0, b1, a + 3 * a_stride, c30, c31);
+    }
+    avx2::store(acc, c00);
+    avx2::store(acc + 8, c01);
+    avx2::store(acc + 16, c10);
+    avx2::store(acc + 24, c11);
+    avx2::store(acc + 32, c20);
+    avx2::store(acc + 40, c21);
+    avx2::store(acc + 48, c30);
+    avx2::store(acc + 56, c31);
+}
+
+} // namespace avxvnni
+
+namespace avx512vnni {
+
+inline constexpr int gemm_a_offset = 128;
+
+FIXP_TARGET_AVX512VNNI inline __m512i gemm_s8_row(__m512i c, __m512i b, const int8_t* a) {
+    return _mm512_dpbusd_epi32(c, _mm512_set1_epi32(static_cast<int32_t>(detail::load_i8x4(a))), b);
+}
+
+FIXP_TARGET_AVX512VNNI inline void gemm_s8_tile(const int8_t* a, size_t a_stride,
+                                                const int8_t* b, size_t k4, int32_t* acc) {
+    __m512i c0 = avx512::load(acc), c1 = avx512::load(acc + 16);
+    __m512i c2 = avx512::load(acc + 32), c3 = avx512::load(acc + 48);
+    for (size_t kk = 0; kk < k4; ++kk, a += 4, b += 64) {
+        const __m512i vb = avx512::load(b);
+        c0 = gemm_s8_row(c0, vb, a);
+        c1 = gemm_s8_row(c1, vb, a + a_stride);
+        c2 = gemm_s8_row(c2, vb, a + 2 * a_stride);
+        c3 = gemm_s8_row(c3, vb, a + 3 * a_stride);
+    }
+    avx512::store(acc, c0);
+    avx512::store(acc + 16, c1);
+    avx512::store(acc + 32, c2);
+    avx512::store(acc + 48, c3);
+}
+
+} // namespace avx512vnni
+
+#endif // FIXP_SIMD_X86
+
+#if defined(FIXP_SIMD_NEON)
+
+//-----------------------------------------------------------------------------
+// NEON (4 x int32, 8 x int16)
+//-----------------------------------------------------------------------------
+namespace neon {
+
+inline int32x4_t mul_i32(int32x4_t a, int32x4_t b, int frac_bits, bool saturate) {
+    if (frac_bits == 31) {
+        // vqrdmulh is exactly (a * b + 2^30) >> 31 with saturation; only
+        // MIN * MIN saturates, which Wrap must turn back into MIN
+        int32x4_t r = vqrdmulhq_s32(a, b);
+        if (saturate) return r;
+        const int32x4_t vmin = vdupq_n_s32(INT32_MIN);
+        uint32x4_t both = vandq_u32(vceqq_s32(a, vmin), vceqq_s32(b, vmin));
+        return vbslq_s32(both, vmin, r);
+    }
+    // vrshl by a negative count is a rounding arithmetic shift right
+    const int64x2_t shift = vdupq_n_s64(-frac_bits);
+    int64x2_t p0 = vrshlq_s64(vmull_s32(vget_low_s32(a), vget_low_s32(b)), shift);
+    int64x2_t p1 = vrshlq_s64(vmull_s32(vget_high_s32(a), vget_high_s32(b)), shift);
+    if (saturate) return vcombine_s32(vqmovn_s64(p0), vqmovn_s64(p1));
+    return vcombine_s32(vmovn_s64(p0), vmovn_s64(p1));
+}
+
+inline int16x8_t mul_i16(int16x8_t a, int16x8_t b, int frac_bits, bool saturate) {
+    if (frac_bits == 15) {
+        int16x8_t r = vqrdmulhq_s16(a, b);
+        if (saturate) return r;
+        const int16x8_t vmin = vdupq_n_s16(INT16_MIN);
+        uint16x8_t both = vandq_u16(vceqq_s16(a, vmin), vceqq_s16(b, vmin));
+        return vbslq_s16(both, vmin, r);
+    }
+    const int32x4_t shift = vdupq_n_s32(-frac_bits);
+    int32x4_t p0 = vrshlq_s32(vmull_s16(vget_low_s16(a), vget_low_s16(b)), shift);
+    int32x4_t p1 = vrshlq_s32(vmull_s16(vget_high_s16(a), vget_high_s16(b)), shift);
+    if (saturate) return vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1));
+    return vcombine_s16(vmovn_s32(p0), vmovn_s32(p1));
+}
+
+inline int32x4_t add_i32(int32x4_t a, int32x4_t b, bool saturate) {
+    return saturate ? vqaddq_s32(a, b) : vaddq_s32(a, b);
+}
+
+inline int32x4_t sub_i32(int32x4_t a, int32x4_t b, bool saturate) {
+    return saturate ? vqsubq_s32(a, b) : vsubq_s32(a, b);
+}
+
+inline int16x8_t add_i16(int16x8_t a, int16x8_t b, bool saturate) {
+    return saturate ? vqaddq_s16(a, b) : vaddq_s16(a, b);
+}
+
+inline int16x8_t sub_i16(int16x8_t a, int16x8_t b, bool saturate) {
+    return saturate ? vqsubq_s16(a, b) : vsubq_s16(a, b);
+}
+
+inline size_t add(const int32_t* a, const int32_t* b, int32_t* out, size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(out + i, add_i32(vld1q_s32(a + i), vld1q_s32(b + i), saturate));
+    }
+    return i;
+}
+
+inline size_t sub(const int32_t* a, const int32_t* b, int32_t* out, size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(out + i, sub_i32(vld1q_s32(a + i), vld1q_s32(b + i), saturate));
+    }
+    return i;
+}
+
+inline size_t mul(const int32_t* a, const int32_t* b, int32_t* out, size_t n,
+                  int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(out + i, mul_i32(vld1q_s32(a + i), vld1q_s32(b + i), frac_bits, saturate));
+    }
+    return i;
+}
+
+inline size_t mul_add(const int32_t* a, const int32_t* b, const int32_t* c, int32_t* out,
+                      size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t p = mul_i32(vld1q_s32(a + i), vld1q_s32(b + i), frac_bits, saturate);
+        vst1q_s32(out + i, add_i32(p, vld1q_s32(c + i), saturate));
+    }
+    return i;
+}
+
+inline size_t scale(const int32_t* a, int32_t s, int32_t* out, size_t n,
+                    int frac_bits, bool saturate) {
+    const int32x4_t vs = vdupq_n_s32(s);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(out + i, mul_i32(vld1q_s32(a + i), vs, frac_bits, saturate));
+    }
+    return i;
+}
+
+inline size_t clamp(const int32_t* a, int32_t lo, int32_t hi, int32_t* out, size_t n) {
+    const int32x4_t vlo = vdupq_n_s32(lo);
+    const int32x4_t vhi = vdupq_n_s32(hi);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(out + i, vminq_s32(vmaxq_s32(vld1q_s32(a + i), vlo), vhi));
+    }
+    return i;
+}
+
+inline size_t add(const int16_t* a, const int16_t* b, int16_t* out, size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(out + i, add_i16(vld1q_s16(a + i), vld1q_s16(b + i), saturate));
+    }
+    return i;
+}
+
+inline size_t sub(const int16_t* a, const int16_t* b, int16_t* out, size_t n, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(out + i, sub_i16(vld1q_s16(a + i), vld1q_s16(b + i), saturate));
+    }
+    return i;
+}
+
+inline size_t mul(const int16_t* a, const int16_t* b, int16_t* out, size_t n,
+                  int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(out + i, mul_i16(vld1q_s16(a + i), vld1q_s16(b + i), frac_bits, saturate));
+    }
+    return i;
+}
+
+inline size_t mul_add(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out,
+                      size_t n, int frac_bits, bool saturate) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t p = mul_i16(vld1q_s16(a + i), vld1q_s16(b + i), frac_bits, saturate);
+        vst1q_s16(out + i, add_i16(p, vld1q_s16(c + i), saturate));
+    }
+    return i;
+}
+
+inline size_t scale(const int16_t* a, int16_t s, int16_t* out, size_t n,
+                    int frac_bits, bool saturate) {
+    const int16x8_t vs = vdupq_n_s16(s);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(out + i, mul_i16(vld1q_s16(a + i), vs, frac_bits, saturate));
+    }
+    return i;
+}
+
+inline size_t clamp(const int16_t* a, int16_t lo, int16_t hi, int16_t* out, size_t n) {
+    const int16x8_t vlo = vdupq_n_s16(lo);
+    const int16x8_t vhi = vdupq_n_s16(hi);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(out + i, vminq_s16(vmaxq_s16(vld1q_s16(a + i), vlo), vhi));
+    }
+    return i;
+}
+
+inline size_t dot(const int32_t* a, const int32_t* b, size_t n, int64_t* acc) {
+    int64x2_t sum = vdupq_n_s64(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t va = vld1q_s32(a + i);
+        int32x4_t vb = vld1q_s32(b + i);
+        sum = vmlal_s32(sum, vget_low_s32(va), vget_low_s32(vb));
+        sum = vmlal_s32(sum, vget_high_s32(va), vget_high_s32(vb));
+    }
+    *acc = detail::wrap_add(*acc, vgetq_lane_s64(sum, 0));
+    *acc = detail::wrap_add(*acc, vgetq_lane_s64(sum, 1));
+    return i;
+}
+
+inline size_t dot(const int16_t* a, const int16_t* b, size_t n, int64_t* acc) {
+    int64x2_t sum = vdupq_n_s64(0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        sum = vpadalq_s32(sum, vmull_s16(vget_low_s16(va), vget_low_s16(vb)));
+        sum = vpadalq_s32(sum, vmull_s16(vget_high_s16(va), vget_high_s16(vb)));
+    }
+    *acc = detail::wrap_add(*acc, vgetq_lane_s64(sum, 0));
+    *acc = detail::wrap_add(*acc, vgetq_lane_s64(sum, 1));
+    return i;
+}
+
+// Rounded 64-bit sums to int32; the shift is arithmetic and does not round
+inline int32x2_t narrow_i64(int64x2_t q, int frac_bits, bool saturate) {
+    const int64x2_t r = vshlq_s64(q, vdupq_n_s64(-frac_bits));
+    return saturate ? vqmovn_s64(r) : vmovn_s64(r);
+}
+
+inline size_t biquad_df1(const int32_t* c, int32_t* s, int32_t* x, size_t n,
+                         int frac_bits, bool saturate) {
+    const int64x2_t rnd = vdupq_n_s64(int64_t{1} << (frac_bits - 1));
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const int32x2_t vx = vld1_s32(x + i);
+        const int32x2_t x1 = vld1_s32(s + i);
+        const int32x2_t y1 = vld1_s32(s + 2 * n + i);
+        int64x2_t acc = vmlal_s32(rnd, vx, vld1_s32(c + i));
+        acc = vmlal_s32(acc, x1, vld1_s32(c + n + i));
+        acc = vmlal_s32(acc, vld1_s32(s + n + i), vld1_s32(c + 2 * n + i));
+        acc = vmlsl_s32(acc, y1, vld1_s32(c + 3 * n + i));
+        acc = vmlsl_s32(acc, vld1_s32(s + 3 * n + i), vld1_s32(c + 4 * n + i));
+        const int32x2_t y = narrow_i64(acc, frac_bits, saturate);
+        vst1_s32(s + n + i, x1);
+        vst1_s32(s + i, vx);
+        vst1_s32(s + 3 * n + i, y1);
+        vst1_s32(s + 2 * n + i, y);
+        vst1_s32(x + i, y);
+    }
+    return i;
+}
+
+inline size_t biquad_tdf2(const int32_t* c, int64_t* s, int32_t* x, size_t n,
+                          int frac_bits, bool saturate) {
+    const int64x2_t rnd = vdupq_n_s64(int64_t{1} << (frac_bits - 1));
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const int32x2_t vx = vld1_s32(x + i);
+        const int64x2_t s2 = vld1q_s64(s + n + i);
+        const int64x2_t acc = vmlal_s32(vaddq_s64(rnd, vld1q_s64(s + i)), vx, vld1_s32(c + i));
+        const int32x2_t y = narrow_i64(acc, frac_bits, saturate);
+        int64x2_t n1 = vmlal_s32(s2, vx, vld1_s32(c + n + i));
+        n1 = vmlsl_s32(n1, y, vld1_s32(c + 3 * n + i));
+        int64x2_t n2 = vmull_s32(vx, vld1_s32(c + 2 * n + i));
+        n2 = vmlsl_s32(n2, y, vld1_s32(c + 4 * n + i));
+        vst1q_s64(s + i, n1);
+        vst1q_s64(s + n + i, n2);
+        vst1_s32(x + i, y);
+    }
+    return i;
+}
+
+// FCVTNS and FCVTAS round to nearest (ties even or away), saturate and send
+// NaN to zero, which is the whole conversion contract; they are AArch64-only
+inline size_t from_float(const float* in, int32_t* out, size_t n, int frac_bits,
+                         bool half_even) {
+    size_t i = 0;
+#if defined(__aarch64__) || defined(_M_ARM64)
+    const float32x4_t scale = vdupq_n_f32(static_cast<float>(uint64_t{1} << frac_bits));
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t v = vmulq_f32(vld1q_f32(in + i), scale);
+        vst1q_s32(out + i, half_even ? vcvtnq_s32_f32(v) : vcvtaq_s32_f32(v));
+    }
+#else
+    (void)in; (void)out; (void)n; (void)frac_bits; (void)half_even;
+#endif
+    return i;
+}
+
+inline size_t from_float(const float* in, int16_t* out, size_t n, int frac_bits,
+                         bool half_even) {
+    size_t i = 0;
+#if defined(__aarch64__) || defined(_M_ARM64)
+    const float32x4_t scale = vdupq_n_f32(static_cast<float>(uint64_t{1} << frac_bits));
+    for (; i + 8 <= n; i += 8) {
+        const float32x4_t lo = vmulq_f32(vld1q_f32(in + i), scale);
+        const float32x4_t hi = vmulq_f32(vld1q_f32(in + i + 4), scale);
+        const int32x4_t rlo = half_even ? vcvtnq_s32_f32(lo) : vcvtaq_s32_f32(lo);
+        const int32x4_t rhi = half_even ? vcvtnq_s32_f32(hi) : vcvtaq_s32_f32(hi);
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(rlo), vqmovn_s32(rhi)));
+    }
+#else
+    (void)in; (void)out; (void)n; (void)frac_bits; (void)half_even;
+#endif
+    return i;
+}
+
+inline size_t to_float(const int32_t* in, float* out, size_t n, int frac_bits) {
+    const float32x4_t scale = vdupq_n_f32(1.0f / static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(vld1q_s32(in + i)), scale));
+    }
+    return i;
+}
+
+inline size_t to_float(const int16_t* in, float* out, size_t n, int frac_bits) {
+    const float32x4_t scale = vdupq_n_f32(1.0f / static_cast<float>(uint64_t{1} << frac_bits));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const int32x4_t v = vmovl_s16(vld1_s16(in + i));
+        vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(v), scale));
+    }
+    return i;
+}
+
+inline size_t transform4x4(const int32_t* m, const int32_t* in, int32_t* out, size_t n,
+                           int frac_bits, bool saturate) {
+    const int64x2_t rnd = vdupq_n_s64(int64_t{1} << (frac_bits - 1));
+    int32x2_t lo[4], hi[4];
+    for (int c = 0; c < 4; ++c) {
+        const int32_t l[2] = {m[c], m[4 + c]}, h[2] = {m[8 + c], m[12 + c]};
+        lo[c] = vld1_s32(l);
+        hi[c] = vld1_s32(h);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        int64x2_t r01 = rnd, r23 = rnd;
+        for (int c = 0; c < 4; ++c) {
+            const int32_t v = in[4 * i + static_cast<size_t>(c)];
+            r01 = vmlal_n_s32(r01, lo[c], v);
+            r23 = vmlal_n_s32(r23, hi[c], v);
+        }
+        vst1q_s32(out + 4 * i, vcombine_s32(narrow_i64(r01, frac_bits, saturate),
+                                            narrow_i64(r23, frac_bits, saturate)));
+    }
+    return n;
+}
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+inline constexpr int gemm_a_offset = 0;
+
+// SDOT where the target has it; otherwise vmull_s8 products, whose 16-bit
+// lanes cannot overflow, summed pairwise into each column
+inline int32x4_t gemm_s8_dot(int32x4_t c, int8x16_t b, int8x16_t a) {
+#if defined(__ARM_FEATURE_DOTPROD)
+    return vdotq_s32(c, b, a);
+#else
+    const int16x8_t lo = vmull_s8(vget_low_s8(b), vget_low_s8(a));
+    const int16x8_t hi = vmull_high_s8(b, a);
+    return vaddq_s32(c, vpaddq_s32(vpaddlq_s16(lo), vpaddlq_s16(hi)));
+#endif
+}
+
+inline void gemm_s8_row(int8x16_t b0, int8x16_t b1, int8x16_t b2, int8x16_t b3,
+                        const int8_t* a, int32x4_t& c0, int32x4_t& c1, int32x4_t& c2,
+                        int32x4_t& c3) {
+    const int8x16_t va = vreinterpretq_s8_u32(vdupq_n_u32(detail::load_i8x4(a)));
+    c0 = gemm_s8_dot(c0, b0, va);
+    c1 = gemm_s8_dot(c1, b1, va);
+    c2 = gemm_s8_dot(c2, b2, va);
+    c3 = gemm_s8_dot(c3, b3, va);
+}
+
+inline void gemm_s8_tile(const int8_t* a, size_t a_stride, const int8_t* b, size_t k4,
+                         int32_t* acc) {
+    int32x4_t c00 = vld1q_s32(acc), c01 = vld1q_s32(acc + 4);
+    int32x4_t c02 = vld1q_s32(acc + 8), c03 = vld1q_s32(acc + 12);
+    int32x4_t c10 = vld1q_s32(acc + 16), c11 = vld1q_s32(acc + 20);
+    int32x4_t c12 = vld1q_s32(acc + 24), c13 = vld1q_s32(acc + 28);
+    int32x4_t c20 = vld1q_s32(acc + 32), c21 = vld1q_s32(acc + 36);
+    int32x4_t c22 = vld1q_s32(acc + 40), c23 = vld1q_s32(acc + 44);
+    int32x4_t c30 = vld1q_s32(acc + 48), c31 = vld1q_s32(acc + 52);
+    int32x4_t c32 = vld1q_s32(acc + 56), c33 = vld1q_s32(acc + 60);
+    for (size_t kk = 0; kk < k4; ++kk, a += 4, b += 64) {
+        const int8x16_t b0 = vld1q_s8(b), b1 = vld1q_s8(b + 16);
+        const int8x16_t b2 = vld1q_s8(b + 32), b3 = vld1q_s8(b + 48);
+        gemm_s8_row(b0, b1, b2, b3, a, c00, c01, c02, c03);
+        gemm_s8_row(b0, b1, b2, b3, a + a_stride, c10, c11, c12, c13);
+        gemm_s8_row(b0, b1, b2, b3, a + 2 * a_stride, c20, c21, c22, c23);
+        gemm_s8_row(b0, b1, b2, b3, a + 3 * a_stride, c30, c31, c32, c33);
+    }
+    vst1q_s32(acc, c00);
+    vst1q_s32(acc + 4, c01);
+    vst1q_s32(acc + 8, c02);
+    vst1q_s32(acc + 12, c03);
+    vst1q_s32(acc + 16, c10);
+    vst1q_s32(acc + 20, c11);
+    vst1q_s32(acc + 24, c12);
+    vst1q_s32(acc + 28, c13);
+    vst1q_s32(acc + 32, c20);
+    vst1q_s32(acc + 36, c21);
+    vst1q_s32(acc + 40, c22);
+    vst1q_s32(acc + 44, c23);
+    vst1q_s32(acc + 48, c30);
+    vst1q_s32(acc + 52, c31);
+    vst1q_s32(acc + 56, c32);
+    vst1q_s32(acc + 60, c33);
+}
+
+#endif
+
+} // namespace neon
+
+#endif // FIXP_SIMD_NEON
+
+} // namespace simd
+} // namespace fixp
+
+#endif // FIXP_SIMD_HPP
@@ -0,0 +1,346 @@
+#ifndef FIXP_TABLE_HPP
+#define FIXP_TABLE_HPP
+
+#include "fixed_point.hpp"
+#include "batch.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace fixp {
+
+/**
+ * @brief How a FunctionTable joins its samples within a segment
+ *
+ * Linear fits the segment's two ends, Quadratic adds its midpoint and Cubic
+ * its thirds. Each piece passes through the function at both segment ends,
+ * so the table is continuous; the error falls as 1/Size^2, ^3 and ^4.
+ */
+enum class Interpolation { Linear, Quadratic, Cubic };
+
+/**
+ * @brief The worst error of a table against its function
+ */
+template<typename FP>
+struct TableError {
+    double max_abs = 0.0; ///< In the format's units
+    double max_lsb = 0.0; ///< In units of the last place
+    FP worst_input{};     ///< An input with the error max_abs
+};
+
+/**
+ * @brief constexpr double functions for building tables at compile time
+ *
+ * Good to a few ulp of double, far below any fixed-point format's step.
+ */
+namespace constexpr_math {
+
+constexpr double exp(double x) {
+    if (x > 709.0) return std::numeric_limits<double>::infinity();
+    if (x < -745.0) return 0.0;
+    // x = k ln2 + r with |r| <= ln2 / 2, then the series for e^r
+    constexpr double LN2 = 0.69314718055994530942;
+    const double kd = x / LN2;
+    const auto k = static_cast<int>(kd >= 0 ? kd + 0.5 : kd - 0.5);
+    const double r = x - k * LN2;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 20; ++n) {
+        term *= r / n;
+        sum += term;
+    }
+    for (int i = 0; i < k; ++i) sum *= 2.0;
+    for (int i = 0; i > k; --i) sum *= 0.5;
+    return sum;
+}
+
+constexpr double tanh(double x) {
+    if (x > 20.0) return 1.0;
+    if (x < -20.0) return -1.0;
+    return 1.0 - 2.0 / (exp(2.0 * x) + 1.0);
+}
+
+constexpr double sigmoid(double x) {
+    return 1.0 / (1.0 + exp(-x));
+}
+
+} // namespace constexpr_math
+
+namespace detail {
+    // A real value as the nearest raw value of FP, clamped to its range
+    template<typename FP>
+    constexpr int64_t table_raw(double x) {
+        const double scaled = x * static_cast<double>(uint64_t(1) << FP::fractional_bits);
+        const auto lo = static_cast<double>(FP::min().raw());
+        const auto hi = static_cast<double>(FP::max().raw());
+        if (scaled <= lo) return static_cast<int64_t>(FP::min().raw());
+        if (scaled >= hi) return static_cast<int64_t>(FP::max().raw());
+        return static_cast<int64_t>(scaled >= 0 ? scaled + 0.5 : scaled - 0.5);
+    }
+
+    // Func at x, in output LSBs and clamped to FP's range
+    template<typename FP, auto Func>
+    constexpr double table_reference(double x) {
+        const double y = static_cast<double>(Func(x)) *
+                         static_cast<double>(uint64_t(1) << FP::fractional_bits);
+        return std::clamp(y, static_cast<double>(FP::min().raw()),
+                          static_cast<double>(FP::max().raw()));
+    }
+
+    // Segment polynomials in output LSBs, lowest order first with c[k] scaled
+    // by 2^k, from samples shared between neighbouring segments
+    template<typename FP, auto Func, int Size, int Degree>
+    constexpr std::array<double, size_t(Size) * (Degree + 1)> table_fit(int64_t lo, int64_t hi) {
+        std::array<double, size_t(Size) * Degree + 1> y{};
+        const double step = static_cast<double>(hi - lo) / (double(Size) * Degree);
+        const double unit = 1.0 / static_cast<double>(uint64_t(1) << FP::fractional_bits);
+        for (size_t m = 0; m < y.size(); ++m) {
+            const double x = static_cast<double>(lo) + static_cast<double>(m) * step;
+            y[m] = table_reference<FP, Func>(x * unit);
+        }
+        std::array<double, size_t(Size) * (Degree + 1)> c{};
+        for (size_t s = 0; s < size_t(Size); ++s) {
+            const double* v = y.data() + s * Degree;
+            double* p = c.data() + s * (Degree + 1);
+            p[0] = v[0];
+            if constexpr (Degree == 1) {
+                p[1] = 2.0 * (v[1] - v[0]);
+            } else if constexpr (Degree == 2) {
+                p[1] = 2.0 * (-3.0 * v[0] + 4.0 * v[1] - v[2]);
+                p[2] = 4.0 * (2.0 * v[0] - 4.0 * v[1] + 2.0 * v[2]);
+            } else {
+                p[1] = 2.0 * (-5.5 * v[0] + 9.0 * v[1] - 4.5 * v[2] + v[3]);
+                p[2] = 4.0 * (9.0 * v[0] - 22.5 * v[1] + 18.0 * v[2] - 4.5 * v[3]);
+                p[3] = 8.0 * (-4.5 * v[0] + 13.5 * v[1] - 13.5 * v[2] + 4.5 * v[3]);
+            }
+        }
+        return c;
+    }
+
+    // The most guard bits that keep every Horner accumulator, plus slack for
+    // coefficient rounding, within limit; -1 if none do
+    template<size_t N>
+    constexpr int table_guard_bits(const std::array<double, N>& c, int degree, double limit) {
+        double bound = 0.0;
+        const auto stride = static_cast<size_t>(degree + 1);
+        for (size_t s = 0; s < N; s += stride) {
+            double acc = 0.0;
+            for (int k = degree; k >= 0; --k) {
+                const double v = c[s + static_cast<size_t>(k)];
+                acc = (v < 0 ? -v : v) + acc / 2;
+                bound = std::max(bound, acc);
+            }
+        }
+        int g = 30;
+        while (g >= 0 && bound * static_cast<double>(uint64_t(1) << g) + 16.0 > limit) --g;
+        return g;
+    }
+} // namespace detail
+
+/**
+ * @brief A function sampled at compile time into a piecewise polynomial table
+ *
+ * Func is any constexpr callable from double to double, such as a lambda,
+ * constexpr_math::tanh or a soft clipper. The domain [Lo, Hi], rounded to
+ * FP, is split into Size equal segments; each holds the coefficients of the
+ * polynomial through the function at Interpolation's nodes, scaled to int32
+ * with as many guard bits as the largest Horner step leaves room for (int64
+ * when the values need more than 30 bits, evaluated scalar only). The
+ * coefficients are a 64-byte aligned constexpr array, so they land in
+ * .rodata with nothing to initialize at startup.
+ *
+ * Inputs outside the domain clamp to its ends; results clamp to FP's range.
+ * A lookup is a multiply for the segment, then Degree multiplies and adds.
+ * measure_error() reports the error against Func itself.
+ *
+ * @code
+ * using Q = FixedPoint<16, 12>;
+ * constexpr FunctionTable<Q, constexpr_math::tanh, 256, Interpolation::Cubic, -4.0, 4.0> t;
+ * Q y = t(Q(0.5));
+ * @endcode
+ *
+ * @tparam Size Segments, at most 65536; compile time grows with it
+ */
+template<typename FP, auto Func, int Size, Interpolation I = Interpolation::Linear,
+         double Lo = static_cast<double>(FP::min()), double Hi = static_cast<double>(FP::max())>
+class FunctionTable {
+    static_assert(FP::total_bits <= 32, "Tables cover formats of up to 32 bits");
+    static_assert(Size >= 1 && Size <= 65536, "Size must be in [1, 65536]");
+
+    using raw_type = typename FP::raw_type;
+
+public:
+    using value_type = FP;
+
+    static constexpr int degree = I == Interpolation::Linear ? 1
+                                : I == Interpolation::Quadratic ? 2 : 3;
+    static constexpr int64_t lo_raw = detail::table_raw<FP>(Lo);
+    static constexpr int64_t hi_raw = detail::table_raw<FP>(Hi);
+
+    static_assert(lo_raw < hi_raw, "The domain is empty in this format");
+    static_assert(static_cast<uint64_t>(hi_raw - lo_raw) >= static_cast<uint64_t>(Size),
+                  "More segments than representable inputs");
+
+private:
+    static constexpr int64_t out_min = static_cast<int64_t>(FP::min().raw());
+    static constexpr int64_t out_max = static_cast<int64_t>(FP::max().raw());
+    static constexpr uint64_t span = static_cast<uint64_t>(hi_raw - lo_raw);
+    static constexpr size_t stride = degree + 1;
+
+    static constexpr auto m_fit = detail::table_fit<FP, Func, Size, degree>(lo_raw, hi_raw);
+    static constexpr bool wide = detail::table_guard_bits(m_fit, degree, 1073741824.0) < 0;
+
+public:
+    using entry_type = std::conditional_t<wide, int64_t, int32_t>;
+
+    static constexpr int guard_bits =
+        detail::table_guard_bits(m_fit, degree, wide ? 4611686018427387904.0 : 1073741824.0);
+    static_assert(guard_bits >= 0, "The function's values overflow a 62-bit accumulator");
+
+    /**
+     * @brief c[k] * 2^(k + guard_bits) of each segment, lowest order first
+     */
+    alignas(64) static constexpr std::array<entry_type, Size * stride> coefficients = [] {
+        std::array<entry_type, Size * stride> q{};
+        const double scale = static_cast<double>(uint64_t(1) << guard_bits);
+        for (size_t i = 0; i < q.size(); ++i) {
+            const double v = m_fit[i] * scale;
+            q[i] = static_cast<entry_type>(v >= 0 ? v + 0.5 : v - 0.5);
+        }
+        return q;
+    }();
+
+    // Segment position in Q31 = (x - lo) * position_scale >> position_shift,
+    // with the largest shift that keeps the scale in 32 bits
+    static constexpr int position_shift = [] {
+        int s = 32;
+        while (s > 0 && ((uint128(Size) << (31 + s)) + span / 2) / span >= (uint128(1) << 32)) {
+            --s;
+        }
+        return s;
+    }();
+    static constexpr uint32_t position_scale =
+        static_cast<uint32_t>(((uint128(Size) << (31 + position_shift)) + span / 2) / span);
+
+    /**
+     * @brief Whether batch::lookup can run this table on SIMD kernels
+     */
+    static constexpr bool simd_eligible =
+        !wide && FP::is_signed && batch::detail::simd_eligible<FP>;
+
+    /**
+     * @brief The table as the simd::table_lookup kernels read it
+     */
+    static constexpr simd::TableSpec spec() requires simd_eligible {
+        return {coefficients.data(),  static_cast<int32_t>(lo_raw),
+                static_cast<int32_t>(hi_raw), position_scale,
+                position_shift,       Size,
+                degree,               guard_bits,
+                static_cast<int32_t>(out_min), static_cast<int32_t>(out_max)};
+    }
+
+    /**
+     * @brief The table's value at x
+     */
+    static constexpr FP lookup(FP x) {
+        const int64_t v = std::clamp(static_cast<int64_t>(x.raw()), lo_raw, hi_raw);
+        const uint64_t p = (static_cast<uint64_t>(v - lo_raw) * position_scale) >> position_shift;
+        uint64_t index = p >> 31;
+        auto t = static_cast<int64_t>(p & 0x7FFFFFFF);
+        if (index >= uint64_t(Size)) {
+            index = Size - 1;
+            t = std::numeric_limits<int32_t>::max();
+        }
+        const entry_type* c = coefficients.data() + index * stride;
+        entry_type acc = c[degree];
+        for (int k = degree - 1; k >= 0; --k) {
+            if constexpr (wide) {
+                acc = c[k] + static_cast<entry_type>((int128(acc) * t) >> 32);
+            } else {
+                acc = c[k] + static_cast<entry_type>((int64_t(acc) * t) >> 32);
+            }
+        }
+        if constexpr (guard_bits > 0) {
+            acc = (acc + (entry_type(1) << (guard_bits - 1))) >> guard_bits;
+        }
+        return FP::from_raw(static_cast<raw_type>(std::clamp<int64_t>(acc, out_min, out_max)));
+    }
+
+    constexpr FP operator()(FP x) const { return lookup(x); }
+
+    /**
+     * @brief The worst error against Func over the domain
+     *
+     * Every input for formats of up to 16 bits, otherwise 64 points per
+     * segment plus both ends. Func's values are clamped to FP's range first,
+     * as the table's are.
+     */
+    static constexpr TableError<FP> measure_error() {
+        TableError<FP> e{};
+        const double unit = 1.0 / static_cast<double>(uint64_t(1) << FP::fractional_bits);
+        auto probe = [&](int64_t r) {
+            const FP x = FP::from_raw(static_cast<raw_type>(r));
+            const double ref = detail::table_reference<FP, Func>(static_cast<double>(r) * unit);
+            double err = static_cast<double>(lookup(x).raw()) - ref;
+            err = err < 0 ? -err : err;
+            if (err > e.max_lsb) {
+                e.max_lsb = err;
+                e.worst_input = x;
+            }
+        };
+        if constexpr (FP::total_bits <= 16) {
+            for (int64_t r = lo_raw; r <= hi_raw; ++r) probe(r);
+        } else {
+            constexpr uint64_t samples = uint64_t(Size) * 64;
+            for (uint64_t i = 0; i < samples; ++i) {
+                probe(lo_raw + static_cast<int64_t>(static_cast<uint128>(span) * i / samples));
+            }
+            probe(hi_raw);
+        }
+        e.max_abs = e.max_lsb * unit;
+        return e;
+    }
+};
+
+namespace batch {
+
+namespace detail {
+// Gathers need AVX2; narrower targets run the scalar lookup
+#if defined(FIXP_SIMD_X86) && defined(__AVX512F__) && defined(__AVX512BW__)
+namespace table_kernels = ::fixp::simd::avx512;
+#define FIXP_TABLE_HAS_SIMD 1
+#elif defined(FIXP_SIMD_X86) && defined(__AVX2__)
+namespace table_kernels = ::fixp::simd::avx2;
+#define FIXP_TABLE_HAS_SIMD 1
+#endif
+} // namespace detail
+
+/**
+ * @brief out[i] = table(in[i]), gathering the coefficients of 8 or 16 inputs at once
+ *
+ * Bit-identical to the scalar lookup.
+ */
+template<FixedPointType FP, auto Func, int Size, Interpolation I, double Lo, double Hi>
+void lookup(input_span<FP> in, const FunctionTable<FP, Func, Size, I, Lo, Hi>& table,
+            std::span<FP> out) {
+    assert(in.size() >= out.size());
+    size_t i = 0;
+#if defined(FIXP_TABLE_HAS_SIMD)
+    if constexpr (FunctionTable<FP, Func, Size, I, Lo, Hi>::simd_eligible) {
+        i = detail::table_kernels::table_lookup(detail::raw_ptr(in), detail::raw_ptr(out),
+                                                out.size(), table.spec());
+    }
+#endif
+    for (; i < out.size(); ++i) out[i] = table(in[i]);
+}
+
+} // namespace batch
+
+} // namespace fixp
+
+#endif // FIXP_TABLE_HPP
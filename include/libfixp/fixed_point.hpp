@@ -1,22 +1,57 @@
 #ifndef LIBFIXP_FIXED_POINT_HPP
 #define LIBFIXP_FIXED_POINT_HPP
 
+#include <algorithm>
 #include <cstdint>
 #include <concepts>
 #include <type_traits>
+#include <utility>
 #include <limits>
 #include <compare>
 #include <bit>
 #include <cmath>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+#if defined(LIBFIXP_EVENT_COUNTERS)
+#include <array>
+#include <mutex>
+#include <vector>
+#endif
+
+#if defined(__ARM_FEATURE_DSP) || defined(__ARM_FEATURE_SAT)
+#include <arm_acle.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 128-bit integers are the compiler's __int128 where it has one, and the
+// two-limb detail::WideInt elsewhere or when LIBFIXP_NO_INT128 asks for it
+#if defined(__SIZEOF_INT128__) && !defined(LIBFIXP_NO_INT128)
+#define LIBFIXP_HAS_INT128 1
+#endif
 
 namespace libfixp {
 
 /**
  * @brief Overflow policies for fixed-point arithmetic
+ *
+ * Trap calls the overflow handler (report and abort by default) and, should
+ * it return, wraps. Undefined tells the optimizer overflow cannot happen, for
+ * loops whose range is proven; an overflow during constant evaluation is a
+ * compile error. Dynamic is Wrap, Saturate or Trap as selected at run time
+ * by set_dynamic_overflow_policy() or ScopedOverflowPolicy.
  */
 enum class OverflowPolicy {
     Wrap,
-    Saturate
+    Saturate,
+    Trap,
+    Undefined,
+    Dynamic
 };
 
 /**
@@ -41,15 +76,1161 @@ template<int Bits, bool Signed>
     requires (Bits > 32 && Bits <= 64)
 struct StorageType<Bits, Signed> { using type = std::conditional_t<Signed, int64_t, uint64_t>; };
 
-#ifdef __SIZEOF_INT128__
+#if defined(LIBFIXP_HAS_INT128)
 template<int Bits, bool Signed>
     requires (Bits > 64 && Bits <= 128)
 struct StorageType<Bits, Signed> { using type = std::conditional_t<Signed, __int128_t, __uint128_t>; };
+#else
+namespace detail {
+template<bool Signed>
+class WideInt;
+}
+
+template<int Bits, bool Signed>
+    requires (Bits > 64 && Bits <= 128)
+struct StorageType<Bits, Signed> { using type = detail::WideInt<Signed>; };
 #endif
 
 template<int Bits, bool Signed>
 using storage_t = typename StorageType<Bits, Signed>::type;
 
+/**
+ * @brief The 128-bit integers behind 128-bit storage and wide intermediates
+ */
+using int128 = storage_t<128, true>;
+using uint128 = storage_t<128, false>;
+
+//
+// Branch-free saturation
+//
+// Every saturating path computes its result unconditionally and then picks
+// between it and the limit with sign masks or min/max selects, so noisy data
+// costs no mispredictions and the operators stay vectorizable inside loops. ARM cores
+// with the DSP extension use QADD/QSUB and SSAT/USAT directly; the packed
+// x86 instructions (PADDS and friends) are used by the batch kernels.
+//
+namespace detail {
+
+// Raw-type traits that also cover __int128, which std::is_signed and
+// std::make_unsigned do not in strict ISO mode
+template<typename T>
+inline constexpr bool is_signed_raw = T(-1) < T(0);
+
+template<typename T>
+using unsigned_raw_t = storage_t<8 * sizeof(T), false>;
+
+// Wrapping arithmetic through the unsigned type, defined for every input
+template<typename T>
+constexpr T wrapping_add(T a, T b) {
+    using U = unsigned_raw_t<T>;
+    return static_cast<T>(static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+}
+
+template<typename T>
+constexpr T wrapping_sub(T a, T b) {
+    using U = unsigned_raw_t<T>;
+    return static_cast<T>(static_cast<U>(static_cast<U>(a) - static_cast<U>(b)));
+}
+
+template<typename T>
+constexpr T wrapping_neg(T a) {
+    return wrapping_sub(T(0), a);
+}
+
+/**
+ * @brief The low bits of the integer part of v, as a wrapping conversion; 0 for NaN and inf
+ */
+template<typename T>
+constexpr T wrapping_from_double(double v) {
+    using U = unsigned_raw_t<T>;
+    constexpr int bits = 8 * sizeof(U);
+    if (v != v || v - v != 0.0) return T(0);
+    const bool negative = v < 0;
+    double m = negative ? -v : v;
+    // Doubles from 2^53 up are even integers, so halving them is exact
+    int shift = 0;
+    while (m >= 9007199254740992.0) {
+        m /= 2;
+        ++shift;
+    }
+    const U low = shift >= bits ? U(0) : static_cast<U>(U(static_cast<uint64_t>(m)) << shift);
+    return static_cast<T>(negative ? static_cast<U>(U(0) - low) : low);
+}
+
+/**
+ * @brief v clamped to T's range with two selects; W is any wider integer
+ */
+template<typename T, typename W>
+constexpr T saturate_to(W v) {
+#if defined(__ARM_FEATURE_SAT)
+    if !consteval {
+        if constexpr (sizeof(W) == 4 && sizeof(T) < 4) {
+            if constexpr (is_signed_raw<T>) {
+                return static_cast<T>(__ssat(static_cast<int32_t>(v), 8 * sizeof(T)));
+            } else if constexpr (is_signed_raw<W>) {
+                return static_cast<T>(__usat(static_cast<int32_t>(v), 8 * sizeof(T)));
+            }
+        }
+    }
+#endif
+    constexpr auto hi = static_cast<W>(std::numeric_limits<T>::max());
+    constexpr auto lo = static_cast<W>(std::numeric_limits<T>::min());
+    v = v > hi ? hi : v;
+    if constexpr (is_signed_raw<W>) v = v < lo ? lo : v;
+    return static_cast<T>(v);
+}
+
+// The limit a signed overflow of a + b or a - b runs into: it has a's sign
+template<typename T>
+constexpr T overflow_limit(T a) {
+    return static_cast<T>((a >> (8 * sizeof(T) - 1)) ^ std::numeric_limits<T>::max());
+}
+
+// All ones when the sign bit of v (as T) is set, else zero
+template<typename T, typename U>
+constexpr U overflow_mask(U v) {
+    return static_cast<U>(static_cast<T>(v) >> (8 * sizeof(T) - 1));
+}
+
+template<typename T>
+constexpr T saturating_add(T a, T b) {
+    if constexpr (sizeof(T) < sizeof(int)) {
+        return saturate_to<T>(static_cast<int>(a) + static_cast<int>(b));
+    } else {
+#if defined(__ARM_FEATURE_DSP)
+        if constexpr (std::is_same_v<T, int32_t>) {
+            if !consteval { return __qadd(a, b); }
+        }
+#endif
+        using U = unsigned_raw_t<T>;
+        const U sum = static_cast<U>(static_cast<U>(a) + static_cast<U>(b));
+        if constexpr (is_signed_raw<T>) {
+            // Only same-sign operands overflow, leaving a sum of the other sign;
+            // the mask is all ones exactly then and selects a's limit
+            const U mask = overflow_mask<T>((static_cast<U>(a) ^ sum) & (static_cast<U>(b) ^ sum));
+            return static_cast<T>(sum ^ ((sum ^ static_cast<U>(overflow_limit(a))) & mask));
+        } else {
+            return static_cast<T>(sum | static_cast<U>(U(0) - U(sum < a)));
+        }
+    }
+}
+
+template<typename T>
+constexpr T saturating_sub(T a, T b) {
+    if constexpr (sizeof(T) < sizeof(int)) {
+        return saturate_to<T>(static_cast<int>(a) - static_cast<int>(b));
+    } else {
+#if defined(__ARM_FEATURE_DSP)
+        if constexpr (std::is_same_v<T, int32_t>) {
+            if !consteval { return __qsub(a, b); }
+        }
+#endif
+        using U = unsigned_raw_t<T>;
+        const U diff = static_cast<U>(static_cast<U>(a) - static_cast<U>(b));
+        if constexpr (is_signed_raw<T>) {
+            // a - b overflows only when b has the opposite sign and the
+            // difference does not have a's
+            const U mask = overflow_mask<T>((static_cast<U>(a) ^ static_cast<U>(b)) &
+                                            (static_cast<U>(a) ^ diff));
+            return static_cast<T>(diff ^ ((diff ^ static_cast<U>(overflow_limit(a))) & mask));
+        } else {
+            return static_cast<T>(diff & static_cast<U>(U(0) - U(a >= b)));
+        }
+    }
+}
+
+template<typename T>
+constexpr T saturating_neg(T a) {
+    if constexpr (is_signed_raw<T>) {
+        return a == std::numeric_limits<T>::min() ? std::numeric_limits<T>::max()
+                                                  : wrapping_neg(a);
+    } else {
+        return T(0);
+    }
+}
+
+// Whether v has at most Digits significant bits, so a float type with a
+// Digits-bit mantissa holds it exactly
+template<int Digits, typename T>
+constexpr bool fits_mantissa(T v) {
+    using U = unsigned_raw_t<T>;
+    if constexpr (8 * sizeof(T) <= Digits) {
+        return true;
+    } else {
+        U u = static_cast<U>(v);
+        if (v < T(0)) u = static_cast<U>(U(0) - u);
+        if (u == 0) return true;
+        u = static_cast<U>(u / (u & static_cast<U>(U(0) - u))); // drop trailing zeros
+        return (u >> Digits) == 0;
+    }
+}
+
+} // namespace detail
+
+//
+// Two-word products and quotients
+//
+// Formats wider than 32 bits multiply and divide in two words of their raw
+// type rather than in one integer of twice the width. A 64-bit format thus
+// needs no 128-bit division (on x86-64 a quotient is one DIVQ once the high
+// word is reduced) and builds without __int128, while 128-bit storage gets
+// exact 256-bit intermediates. One 64x64-bit product is a single MUL, IMUL
+// or MULX through __int128, _umul128 or __umulh on MSVC, and four 32-bit
+// products elsewhere; 128-bit words are built from 64-bit halves the same way.
+//
+namespace detail {
+
+/**
+ * @brief An unsigned integer of twice U's width as its high and low words
+ */
+template<typename U>
+struct WideWord {
+    U hi;
+    U lo;
+};
+
+template<typename U>
+inline constexpr int word_bits = 8 * sizeof(U);
+
+// std::countl_zero does not take unsigned __int128 in strict ISO mode
+template<typename U>
+constexpr int leading_zeros(U v) {
+    if constexpr (sizeof(U) > 8) {
+        const auto hi = static_cast<uint64_t>(v >> 64);
+        return hi != 0 ? std::countl_zero(hi) : 64 + std::countl_zero(static_cast<uint64_t>(v));
+    } else {
+        return std::countl_zero(v);
+    }
+}
+
+/**
+ * @brief a * b from the four products of their half words
+ */
+template<typename U>
+constexpr WideWord<U> mul_halves(U a, U b) {
+    constexpr int h = word_bits<U> / 2;
+    constexpr U mask = (U(1) << h) - 1;
+    const U a0 = a & mask, a1 = a >> h, b0 = b & mask, b1 = b >> h;
+    const U p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    const U mid = (p00 >> h) + (p01 & mask) + (p10 & mask);
+    return {p11 + (p01 >> h) + (p10 >> h) + (mid >> h), (mid << h) | (p00 & mask)};
+}
+
+/**
+ * @brief The full unsigned product a * b
+ */
+template<typename U>
+constexpr WideWord<U> mul_wide(U a, U b) {
+    if constexpr (sizeof(U) == 8) {
+#if defined(LIBFIXP_HAS_INT128)
+        const __uint128_t p = static_cast<__uint128_t>(a) * b;
+        return {static_cast<U>(p >> 64), static_cast<U>(p)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+        if !consteval {
+            U hi;
+            const U lo = _umul128(a, b, &hi);
+            return {hi, lo};
+        }
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+        if !consteval { return {__umulh(a, b), a * b}; }
+#endif
+    }
+    return mul_halves(a, b);
+}
+
+/**
+ * @brief The full product of a and b read as two's complement, in two's complement
+ *
+ * The unsigned product less b << W for negative a and a << W for negative b.
+ */
+template<typename U>
+constexpr WideWord<U> mul_wide_signed(U a, U b) {
+#if defined(LIBFIXP_HAS_INT128)
+    if constexpr (sizeof(U) == 8) {
+        const __int128_t p = static_cast<__int128_t>(static_cast<int64_t>(a)) *
+                             static_cast<int64_t>(b);
+        return {static_cast<U>(static_cast<__uint128_t>(p) >> 64), static_cast<U>(p)};
+    }
+#endif
+    constexpr int top = word_bits<U> - 1;
+    WideWord<U> p = mul_wide(a, b);
+    p.hi -= (U(0) - (a >> top)) & b;
+    p.hi -= (U(0) - (b >> top)) & a;
+    return p;
+}
+
+/**
+ * @brief (hi:lo) / d for hi < d, by long division in half-word digits
+ *
+ * Knuth's algorithm D for a two-digit divisor (Hacker's Delight, divlu):
+ * each quotient digit is estimated from the divisor's normalized top digit
+ * and corrected at most twice.
+ */
+template<typename U>
+constexpr U div_halves(U hi, U lo, U d) {
+    constexpr int h = word_bits<U> / 2;
+    constexpr U base = U(1) << h;
+    const int s = leading_zeros(d);
+    d = static_cast<U>(d << s);
+    const U d1 = d >> h, d0 = d & (base - 1);
+    const U n32 = s == 0 ? hi : static_cast<U>((hi << s) | (lo >> (word_bits<U> - s)));
+    const U n10 = static_cast<U>(lo << s);
+    const U n1 = n10 >> h, n0 = n10 & (base - 1);
+
+    U q1 = n32 / d1;
+    U r = n32 - q1 * d1;
+    while (q1 >= base || q1 * d0 > base * r + n1) {
+        --q1;
+        r += d1;
+        if (r >= base) break;
+    }
+    // The partial remainder is below d, so the wrapped arithmetic is exact
+    const U n21 = n32 * base + n1 - q1 * d;
+    U q0 = n21 / d1;
+    r = n21 - q0 * d1;
+    while (q0 >= base || q0 * d0 > base * r + n0) {
+        --q0;
+        r += d1;
+        if (r >= base) break;
+    }
+    return q1 * base + q0;
+}
+
+/**
+ * @brief The low word of (hi:lo) / d for d != 0
+ */
+template<typename U>
+constexpr U div_wide(U hi, U lo, U d) {
+    if (hi >= d) hi %= d; // drops the quotient's high word, which cannot fault
+    if constexpr (sizeof(U) == 8) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+        if !consteval {
+            U q, r;
+            __asm__("divq %4" : "=a"(q), "=d"(r) : "a"(lo), "d"(hi), "rm"(d));
+            return q;
+        }
+#elif defined(_MSC_VER) && defined(_M_X64)
+        if !consteval {
+            U r;
+            return _udiv128(hi, lo, d, &r);
+        }
+#endif
+    }
+    return div_halves(hi, lo, d);
+}
+
+/**
+ * @brief -v in two's complement across both words
+ */
+template<typename U>
+constexpr WideWord<U> neg_wide(WideWord<U> v) {
+    return {static_cast<U>(~v.hi + U(v.lo == U(0))), static_cast<U>(U(0) - v.lo)};
+}
+
+/**
+ * @brief (a << F) / b in two words of T's width, truncated toward zero, for b != 0
+ *
+ * What dividing a in an integer twice T's width would give, with no such
+ * integer: the magnitudes are divided and the sign applied to the quotient.
+ * The quotient does not fit T when the high word is more than the low
+ * word's sign extension.
+ */
+template<typename T, int F>
+constexpr WideWord<unsigned_raw_t<T>> div_shifted(T a, T b) {
+    using U = unsigned_raw_t<T>;
+    constexpr int W = word_bits<U>;
+    const bool negative = is_signed_raw<T> && ((a < T(0)) != (b < T(0)));
+    const U ua = is_signed_raw<T> && a < T(0) ? U(0) - static_cast<U>(a) : static_cast<U>(a);
+    const U ub = is_signed_raw<T> && b < T(0) ? U(0) - static_cast<U>(b) : static_cast<U>(b);
+    WideWord<U> q{U(0), U(0)};
+    if constexpr (F == 0) {
+        q.lo = ua / ub;
+    } else if constexpr (F == W) {
+        q = {static_cast<U>(ua / ub), div_wide(ua, U(0), ub)};
+    } else {
+        const U hi = static_cast<U>(ua >> (W - F));
+        q = {static_cast<U>(hi / ub), div_wide(hi, static_cast<U>(ua << F), ub)};
+    }
+    return negative ? neg_wide(q) : q;
+}
+
+} // namespace detail
+
+//
+// Portable 128-bit integers
+//
+// Without __int128 (MSVC, most 32-bit targets) 128-bit storage and every
+// 128-bit intermediate in the fixp headers use WideInt. It stores two 64-bit
+// limbs and has the built-in integer operators, with built-in semantics. It
+// is usable in constant expressions. Its products and quotients come from
+// the two-word kernels above, so a 128-bit format costs the same handful of
+// 64-bit operations that __int128 lowers to.
+//
+namespace detail {
+
+// Built-in integers WideInt converts from and to, __int128 included so that
+// LIBFIXP_NO_INT128 builds still interoperate with it
+template<typename T>
+inline constexpr bool is_builtin_integer = std::is_integral_v<T>
+#if defined(__SIZEOF_INT128__)
+    || std::is_same_v<T, __int128_t> || std::is_same_v<T, __uint128_t>
+#endif
+    ;
+
+/**
+ * @brief A 128-bit two's complement integer in two 64-bit limbs
+ *
+ * Converts implicitly from the built-in integers and from the signed to the
+ * unsigned form, and explicitly to anything else. Arithmetic wraps, signed
+ * shifts are arithmetic, division truncates toward zero, and integer to
+ * floating-point conversions round to nearest, all as for __int128.
+ */
+template<bool Signed>
+class WideInt {
+public:
+    constexpr WideInt() = default;
+
+    template<typename T>
+        requires is_builtin_integer<T>
+    constexpr WideInt(T v) : m_lo(static_cast<uint64_t>(v)), m_hi(0) {
+        if constexpr (sizeof(T) > 8) {
+            m_hi = static_cast<uint64_t>(v >> 64);
+        } else if constexpr (is_signed_raw<T>) {
+            m_hi = v < 0 ? ~uint64_t(0) : 0;
+        }
+    }
+
+    template<bool S>
+        requires (S != Signed)
+    constexpr explicit(Signed) WideInt(WideInt<S> v) : m_lo(v.lo()), m_hi(v.hi()) {}
+
+    // Truncates toward zero; v must be in range
+    template<std::floating_point T>
+    constexpr explicit WideInt(T v) : m_lo(0), m_hi(0) {
+        constexpr T limb = T(18446744073709551616.0);
+        const T m = v < 0 ? -v : v;
+        const auto hi = static_cast<uint64_t>(m / limb);
+        *this = from_limbs(hi, static_cast<uint64_t>(m - static_cast<T>(hi) * limb));
+        if (v < 0) *this = -*this;
+    }
+
+    static constexpr WideInt from_limbs(uint64_t hi, uint64_t lo) {
+        WideInt v;
+        v.m_hi = hi;
+        v.m_lo = lo;
+        return v;
+    }
+
+    constexpr uint64_t hi() const { return m_hi; }
+    constexpr uint64_t lo() const { return m_lo; }
+
+    template<typename T>
+        requires is_builtin_integer<T>
+    constexpr explicit operator T() const {
+        if constexpr (std::is_same_v<T, bool>) {
+            return (m_hi | m_lo) != 0;
+#if defined(__SIZEOF_INT128__)
+        } else if constexpr (sizeof(T) > 8) {
+            return static_cast<T>((static_cast<__uint128_t>(m_hi) << 64) | m_lo);
+#endif
+        } else {
+            return static_cast<T>(m_lo);
+        }
+    }
+
+    template<std::floating_point T>
+    constexpr explicit operator T() const {
+        if (Signed && (m_hi >> 63) != 0) {
+            const WideInt<false> magnitude = -*this;
+            return -static_cast<T>(magnitude);
+        }
+        if (m_hi == 0) return static_cast<T>(m_lo);
+        // The top 64 bits scaled by 2^s, plus the s bits below them
+        const int s = 64 - std::countl_zero(m_hi);
+        const uint64_t top = s == 64 ? m_hi : (m_hi << (64 - s)) | (m_lo >> s);
+        const uint64_t rest = s == 64 ? m_lo : m_lo & ((uint64_t(1) << s) - 1);
+        const T scale = static_cast<T>(uint64_t(1) << (s - 1)) * 2;
+        if constexpr (std::numeric_limits<T>::digits >= 64) {
+            // Both terms are exact, so the sum rounds once
+            return static_cast<T>(top) * scale + static_cast<T>(rest);
+        } else {
+            // A sticky bit for the rest keeps the one rounding of top correct
+            return static_cast<T>(top | uint64_t(rest != 0)) * scale;
+        }
+    }
+
+    friend constexpr WideInt operator+(WideInt a, WideInt b) {
+        const uint64_t lo = a.m_lo + b.m_lo;
+        return from_limbs(a.m_hi + b.m_hi + uint64_t(lo < a.m_lo), lo);
+    }
+
+    friend constexpr WideInt operator-(WideInt a, WideInt b) {
+        return from_limbs(a.m_hi - b.m_hi - uint64_t(a.m_lo < b.m_lo), a.m_lo - b.m_lo);
+    }
+
+    friend constexpr WideInt operator*(WideInt a, WideInt b) {
+        const WideWord<uint64_t> p = mul_wide(a.m_lo, b.m_lo);
+        return from_limbs(p.hi + a.m_lo * b.m_hi + a.m_hi * b.m_lo, p.lo);
+    }
+
+    friend constexpr WideInt operator/(WideInt a, WideInt b) {
+        WideInt<false> r;
+        const WideInt q(divide(magnitude(a), magnitude(b), r));
+        return Signed && (a < 0) != (b < 0) ? -q : q;
+    }
+
+    friend constexpr WideInt operator%(WideInt a, WideInt b) {
+        WideInt<false> remainder;
+        divide(magnitude(a), magnitude(b), remainder);
+        const WideInt r(remainder);
+        return Signed && a < 0 ? -r : r;
+    }
+
+    friend constexpr WideInt operator&(WideInt a, WideInt b) {
+        return from_limbs(a.m_hi & b.m_hi, a.m_lo & b.m_lo);
+    }
+
+    friend constexpr WideInt operator|(WideInt a, WideInt b) {
+        return from_limbs(a.m_hi | b.m_hi, a.m_lo | b.m_lo);
+    }
+
+    friend constexpr WideInt operator^(WideInt a, WideInt b) {
+        return from_limbs(a.m_hi ^ b.m_hi, a.m_lo ^ b.m_lo);
+    }
+
+    template<std::integral S>
+    friend constexpr WideInt operator<<(WideInt a, S shift) {
+        const int s = static_cast<int>(shift);
+        if (s == 0) return a;
+        if (s >= 64) return from_limbs(a.m_lo << (s - 64), 0);
+        return from_limbs((a.m_hi << s) | (a.m_lo >> (64 - s)), a.m_lo << s);
+    }
+
+    template<std::integral S>
+    friend constexpr WideInt operator>>(WideInt a, S shift) {
+        const int s = static_cast<int>(shift);
+        if (s == 0) return a;
+        const uint64_t fill = Signed && (a.m_hi >> 63) != 0 ? ~uint64_t(0) : 0;
+        if (s >= 64) return from_limbs(fill, shift_high(a.m_hi, s - 64));
+        return from_limbs(shift_high(a.m_hi, s), (a.m_lo >> s) | (a.m_hi << (64 - s)));
+    }
+
+    friend constexpr bool operator==(WideInt a, WideInt b) {
+        return a.m_hi == b.m_hi && a.m_lo == b.m_lo;
+    }
+
+    friend constexpr std::strong_ordering operator<=>(WideInt a, WideInt b) {
+        if (a.m_hi == b.m_hi) return a.m_lo <=> b.m_lo;
+        if constexpr (Signed) {
+            return static_cast<int64_t>(a.m_hi) <=> static_cast<int64_t>(b.m_hi);
+        } else {
+            return a.m_hi <=> b.m_hi;
+        }
+    }
+
+    constexpr WideInt operator+() const { return *this; }
+    constexpr WideInt operator-() const { return WideInt(0) - *this; }
+    constexpr WideInt operator~() const { return from_limbs(~m_hi, ~m_lo); }
+
+    constexpr WideInt& operator+=(WideInt b) { return *this = *this + b; }
+    constexpr WideInt& operator-=(WideInt b) { return *this = *this - b; }
+    constexpr WideInt& operator*=(WideInt b) { return *this = *this * b; }
+    constexpr WideInt& operator/=(WideInt b) { return *this = *this / b; }
+    constexpr WideInt& operator%=(WideInt b) { return *this = *this % b; }
+    constexpr WideInt& operator&=(WideInt b) { return *this = *this & b; }
+    constexpr WideInt& operator|=(WideInt b) { return *this = *this | b; }
+    constexpr WideInt& operator^=(WideInt b) { return *this = *this ^ b; }
+
+    template<std::integral S>
+    constexpr WideInt& operator<<=(S shift) { return *this = *this << shift; }
+
+    template<std::integral S>
+    constexpr WideInt& operator>>=(S shift) { return *this = *this >> shift; }
+
+    constexpr WideInt& operator++() { return *this += 1; }
+    constexpr WideInt& operator--() { return *this -= 1; }
+
+    constexpr WideInt operator++(int) {
+        const WideInt old = *this;
+        ++*this;
+        return old;
+    }
+
+    constexpr WideInt operator--(int) {
+        const WideInt old = *this;
+        --*this;
+        return old;
+    }
+
+private:
+    static constexpr uint64_t shift_high(uint64_t hi, int s) {
+        return Signed ? static_cast<uint64_t>(static_cast<int64_t>(hi) >> s) : hi >> s;
+    }
+
+    static constexpr WideInt<false> magnitude(WideInt v) {
+        return Signed && v < 0 ? -WideInt<false>(v) : WideInt<false>(v);
+    }
+
+    // n / d for d != 0 (Hacker's Delight, divlu2): a divisor with a high limb
+    // leaves a one-limb quotient, estimated from the divisor's top 64 bits
+    // and off by at most one
+    static constexpr WideInt<false> divide(WideInt<false> n, WideInt<false> d,
+                                           WideInt<false>& r) {
+        using U = WideInt<false>;
+        if (d.hi() == 0) {
+            const uint64_t q1 = n.hi() / d.lo();
+            const uint64_t q0 = div_wide(n.hi() % d.lo(), n.lo(), d.lo());
+            r = U(n.lo() - q0 * d.lo());
+            return U::from_limbs(q1, q0);
+        }
+        const int s = std::countl_zero(d.hi());
+        const U n1 = n >> 1;
+        uint64_t q = div_wide(n1.hi(), n1.lo(), (d << s).hi());
+        q >>= 63 - s;
+        if (q != 0) --q;
+        r = n - U(q) * d;
+        if (r >= d) {
+            ++q;
+            r -= d;
+        }
+        return U(q);
+    }
+
+    uint64_t m_lo;
+    uint64_t m_hi;
+};
+
+} // namespace detail
+
+} // namespace libfixp
+
+template<bool Signed>
+struct std::numeric_limits<libfixp::detail::WideInt<Signed>> {
+    using T = libfixp::detail::WideInt<Signed>;
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = Signed;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr bool is_bounded = true;
+    static constexpr bool is_modulo = !Signed;
+    static constexpr int radix = 2;
+    static constexpr int digits = Signed ? 127 : 128;
+    static constexpr int digits10 = 38;
+    static constexpr T min() noexcept {
+        return Signed ? T::from_limbs(uint64_t(1) << 63, 0) : T(0);
+    }
+    static constexpr T lowest() noexcept { return min(); }
+    static constexpr T max() noexcept { return ~min(); }
+};
+
+namespace libfixp {
+
+//
+// Run-time overflow policy
+//
+// Dynamic formats read a process-wide policy that any thread may change at
+// any time (it applies from the next operation), unless the calling thread
+// overrides it with ScopedOverflowPolicy. The first read takes the initial
+// value from LIBFIXP_OVERFLOW ("wrap", "saturate" or "trap"), defaulting to
+// Saturate. Scalar operators look the policy up on every call, a predictable
+// branch; batch calls resolve it once and run one specialized loop.
+//
+
+/**
+ * @brief Called by Trap arithmetic on overflow with the operation's name
+ *
+ * If the handler returns, the operation yields its wrapped result, so a
+ * handler can log or count overflows without stopping the program.
+ */
+using OverflowHandler = void (*)(const char* operation);
+
+namespace detail {
+
+inline void default_overflow_handler(const char* operation) {
+    std::fprintf(stderr, "libfixp: fixed-point overflow in %s\n", operation);
+    std::abort();
+}
+
+inline std::atomic<OverflowHandler> overflow_handler{default_overflow_handler};
+
+[[gnu::cold, gnu::noinline]] inline void overflow_trap(const char* operation) {
+    overflow_handler.load(std::memory_order_relaxed)(operation);
+}
+
+// Dynamic here means "not read from the environment yet"
+constinit inline std::atomic<OverflowPolicy> process_policy{OverflowPolicy::Dynamic};
+constinit inline thread_local OverflowPolicy thread_policy = OverflowPolicy::Dynamic;
+
+constexpr bool is_runtime_policy(OverflowPolicy p) {
+    return p == OverflowPolicy::Wrap || p == OverflowPolicy::Saturate ||
+           p == OverflowPolicy::Trap;
+}
+
+inline OverflowPolicy policy_from_environment() {
+#if defined(_MSC_VER)
+    char* value = nullptr;
+    size_t len = 0;
+    if (_dupenv_s(&value, &len, "LIBFIXP_OVERFLOW") != 0 || value == nullptr) {
+        return OverflowPolicy::Saturate;
+    }
+    const std::string_view name(value);
+#else
+    const char* value = std::getenv("LIBFIXP_OVERFLOW");
+    const std::string_view name(value != nullptr ? value : "");
+#endif
+    OverflowPolicy p = OverflowPolicy::Saturate;
+    if (name == "wrap") p = OverflowPolicy::Wrap;
+    if (name == "trap") p = OverflowPolicy::Trap;
+#if defined(_MSC_VER)
+    std::free(value);
+#endif
+    return p;
+}
+
+[[gnu::cold, gnu::noinline]] inline OverflowPolicy initial_process_policy() {
+    OverflowPolicy expected = OverflowPolicy::Dynamic;
+    process_policy.compare_exchange_strong(expected, policy_from_environment(),
+                                           std::memory_order_relaxed);
+    return process_policy.load(std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+/**
+ * @brief The policy Dynamic formats use on the calling thread right now
+ */
+inline OverflowPolicy dynamic_overflow_policy() {
+    if (detail::thread_policy != OverflowPolicy::Dynamic) return detail::thread_policy;
+    const OverflowPolicy p = detail::process_policy.load(std::memory_order_relaxed);
+    return p != OverflowPolicy::Dynamic ? p : detail::initial_process_policy();
+}
+
+/**
+ * @brief Sets the process-wide policy of Dynamic formats: Wrap, Saturate or Trap
+ *
+ * Safe from any thread; other values are ignored.
+ */
+inline void set_dynamic_overflow_policy(OverflowPolicy p) {
+    if (detail::is_runtime_policy(p)) detail::process_policy.store(p, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Installs the Trap handler and returns the previous one; nullptr restores the default
+ */
+inline OverflowHandler set_overflow_handler(OverflowHandler handler) {
+    return detail::overflow_handler.exchange(
+        handler != nullptr ? handler : detail::default_overflow_handler);
+}
+
+/**
+ * @brief Overrides the Dynamic policy on this thread for the guard's lifetime
+ *
+ * @code
+ * {
+ *     libfixp::ScopedOverflowPolicy trap(libfixp::OverflowPolicy::Trap);
+ *     process(block); // Dynamic arithmetic on this thread traps
+ * }
+ * @endcode
+ */
+class ScopedOverflowPolicy {
+public:
+    explicit ScopedOverflowPolicy(OverflowPolicy p) : m_previous(detail::thread_policy) {
+        if (detail::is_runtime_policy(p)) detail::thread_policy = p;
+    }
+    ~ScopedOverflowPolicy() { detail::thread_policy = m_previous; }
+
+    ScopedOverflowPolicy(const ScopedOverflowPolicy&) = delete;
+    ScopedOverflowPolicy& operator=(const ScopedOverflowPolicy&) = delete;
+
+private:
+    OverflowPolicy m_previous;
+};
+
+//
+// Event counters
+//
+// With LIBFIXP_EVENT_COUNTERS defined (the CMake option of that name) the
+// library counts saturations, divisions by zero and float conversions that
+// lose precision. Each thread owns a cache line of counters that only it
+// writes, with plain loads and stores rather than atomic read-modify-writes,
+// and event_counts() sums them. Without the macro count_event() is empty and
+// the checks feeding it compile away. All translation units of a program
+// must agree on the macro.
+//
+
+#if defined(LIBFIXP_EVENT_COUNTERS)
+inline constexpr bool event_counters_enabled = true;
+#else
+inline constexpr bool event_counters_enabled = false;
+#endif
+
+enum class FixedPointEvent {
+    Saturation,    // a result clamped to min() or max()
+    DivideByZero,  // a quotient replaced by min() or max()
+    PrecisionLoss  // a float conversion that rounded
+};
+
+/**
+ * @brief Events counted across all threads since the last reset_event_counts()
+ */
+struct EventCounts {
+    uint64_t saturations = 0;
+    uint64_t divisions_by_zero = 0;
+    uint64_t precision_losses = 0;
+};
+
+#if defined(LIBFIXP_EVENT_COUNTERS)
+namespace detail {
+
+inline constexpr size_t event_kinds = 3;
+
+// Only the owning thread writes counts; reset moves baseline instead, under
+// the registry mutex, so the owner's increments are never lost
+struct alignas(64) EventSlot {
+    std::array<std::atomic<uint64_t>, event_kinds> counts{};
+    std::array<uint64_t, event_kinds> baseline{};
+};
+
+struct EventRegistry {
+    std::mutex mutex;
+    std::vector<EventSlot*> live;
+    std::array<uint64_t, event_kinds> retired{}; // from threads that have exited
+};
+
+inline EventRegistry& event_registry() {
+    static EventRegistry registry;
+    return registry;
+}
+
+inline uint64_t slot_count(const EventSlot& slot, size_t i) {
+    return slot.counts[i].load(std::memory_order_relaxed) - slot.baseline[i];
+}
+
+class ThreadEvents {
+public:
+    ThreadEvents() {
+        EventRegistry& r = event_registry();
+        const std::lock_guard lock(r.mutex);
+        r.live.push_back(&m_slot);
+    }
+
+    ~ThreadEvents() {
+        EventRegistry& r = event_registry();
+        const std::lock_guard lock(r.mutex);
+        for (size_t i = 0; i < event_kinds; ++i) r.retired[i] += slot_count(m_slot, i);
+        std::erase(r.live, &m_slot);
+    }
+
+    ThreadEvents(const ThreadEvents&) = delete;
+    ThreadEvents& operator=(const ThreadEvents&) = delete;
+
+    void record(FixedPointEvent e) {
+        std::atomic<uint64_t>& c = m_slot.counts[static_cast<size_t>(e)];
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+private:
+    EventSlot m_slot;
+};
+
+[[gnu::cold, gnu::noinline]] inline void record_event(FixedPointEvent e) {
+    thread_local ThreadEvents events;
+    events.record(e);
+}
+
+} // namespace detail
+#endif
+
+/**
+ * @brief Counts e on the calling thread if happened
+ *
+ * A no-op without LIBFIXP_EVENT_COUNTERS and during constant evaluation.
+ * Public so that code clamping or dividing outside the operators can report
+ * the same events.
+ */
+constexpr void count_event([[maybe_unused]] FixedPointEvent e,
+                           [[maybe_unused]] bool happened = true) {
+#if defined(LIBFIXP_EVENT_COUNTERS)
+    if !consteval {
+        if (happened) detail::record_event(e);
+    }
+#endif
+}
+
+/**
+ * @brief A snapshot of the event counters; all zero without LIBFIXP_EVENT_COUNTERS
+ *
+ * Counts from threads still running are read without stopping them, so a
+ * snapshot may miss their latest events, never more.
+ */
+inline EventCounts event_counts() {
+    EventCounts counts;
+#if defined(LIBFIXP_EVENT_COUNTERS)
+    detail::EventRegistry& r = detail::event_registry();
+    const std::lock_guard lock(r.mutex);
+    std::array<uint64_t, detail::event_kinds> sum = r.retired;
+    for (const detail::EventSlot* slot : r.live) {
+        for (size_t i = 0; i < detail::event_kinds; ++i) sum[i] += detail::slot_count(*slot, i);
+    }
+    counts.saturations = sum[static_cast<size_t>(FixedPointEvent::Saturation)];
+    counts.divisions_by_zero = sum[static_cast<size_t>(FixedPointEvent::DivideByZero)];
+    counts.precision_losses = sum[static_cast<size_t>(FixedPointEvent::PrecisionLoss)];
+#endif
+    return counts;
+}
+
+/**
+ * @brief Restarts every counter from zero, e.g. after exporting event_counts()
+ */
+inline void reset_event_counts() {
+#if defined(LIBFIXP_EVENT_COUNTERS)
+    detail::EventRegistry& r = detail::event_registry();
+    const std::lock_guard lock(r.mutex);
+    r.retired = {};
+    for (detail::EventSlot* slot : r.live) {
+        for (size_t i = 0; i < detail::event_kinds; ++i) {
+            slot->baseline[i] = slot->counts[i].load(std::memory_order_relaxed);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Per-operation overflow policy, e.g. add(a, b, saturating)
+ *
+ * Overrides the format's own policy for one operation, so a loop can wrap
+ * in its inner steps and saturate only the value it stores.
+ */
+template<OverflowPolicy P>
+struct PolicyTag {
+    static constexpr OverflowPolicy policy = P;
+};
+
+inline constexpr PolicyTag<OverflowPolicy::Wrap> wrapping{};
+inline constexpr PolicyTag<OverflowPolicy::Saturate> saturating{};
+inline constexpr PolicyTag<OverflowPolicy::Trap> trapping{};
+inline constexpr PolicyTag<OverflowPolicy::Undefined> unchecked{};
+
+/**
+ * @brief f(PolicyTag<Q>{}) for the static policy Q that P stands for now
+ *
+ * Returns f(PolicyTag<P>{}) for a static P. For Dynamic it reads the policy
+ * once, so a kernel can hoist the lookup out of its loop:
+ *
+ * @code
+ * resolve_policy<FP::overflow_policy>([&](auto policy) {
+ *     constexpr auto P = decltype(policy)::policy;
+ *     for (size_t i = 0; i < n; ++i) out[i] = FP::template add<P>(a[i], b[i]);
+ * });
+ * @endcode
+ *
+ * Constant evaluation resolves Dynamic to Trap, so constants are never
+ * silently wrapped or clamped.
+ */
+template<OverflowPolicy P, typename F>
+constexpr decltype(auto) resolve_policy(F&& f) {
+    if constexpr (P != OverflowPolicy::Dynamic) {
+        return f(PolicyTag<P>{});
+    } else {
+        if consteval {
+            return f(PolicyTag<OverflowPolicy::Trap>{});
+        } else {
+            switch (dynamic_overflow_policy()) {
+            case OverflowPolicy::Saturate:
+                return f(PolicyTag<OverflowPolicy::Saturate>{});
+            case OverflowPolicy::Trap:
+                return f(PolicyTag<OverflowPolicy::Trap>{});
+            default:
+                return f(PolicyTag<OverflowPolicy::Wrap>{});
+            }
+        }
+    }
+}
+
+namespace detail {
+
+// a + b, a - b and -a under a static policy P
+template<OverflowPolicy P, typename T>
+constexpr T policy_add(T a, T b) {
+    if constexpr (P == OverflowPolicy::Saturate) {
+        const T sum = saturating_add(a, b);
+        if constexpr (event_counters_enabled) {
+            count_event(FixedPointEvent::Saturation, sum != wrapping_add(a, b));
+        }
+        return sum;
+    } else if constexpr (P == OverflowPolicy::Wrap) {
+        return wrapping_add(a, b);
+    } else {
+        T sum;
+        const bool overflow = __builtin_add_overflow(a, b, &sum);
+        if constexpr (P == OverflowPolicy::Trap) {
+            if (overflow) overflow_trap("add");
+        } else if (overflow) {
+            __builtin_unreachable();
+        }
+        return sum;
+    }
+}
+
+template<OverflowPolicy P, typename T>
+constexpr T policy_sub(T a, T b) {
+    if constexpr (P == OverflowPolicy::Saturate) {
+        const T diff = saturating_sub(a, b);
+        if constexpr (event_counters_enabled) {
+            count_event(FixedPointEvent::Saturation, diff != wrapping_sub(a, b));
+        }
+        return diff;
+    } else if constexpr (P == OverflowPolicy::Wrap) {
+        return wrapping_sub(a, b);
+    } else {
+        T diff;
+        const bool overflow = __builtin_sub_overflow(a, b, &diff);
+        if constexpr (P == OverflowPolicy::Trap) {
+            if (overflow) overflow_trap("sub");
+        } else if (overflow) {
+            __builtin_unreachable();
+        }
+        return diff;
+    }
+}
+
+template<OverflowPolicy P, typename T>
+constexpr T policy_neg(T a) {
+    if constexpr (P == OverflowPolicy::Saturate) {
+        const T neg = saturating_neg(a);
+        if constexpr (event_counters_enabled) {
+            count_event(FixedPointEvent::Saturation, neg != wrapping_neg(a));
+        }
+        return neg;
+    } else if constexpr (P == OverflowPolicy::Wrap) {
+        return wrapping_neg(a);
+    } else {
+        T neg;
+        const bool overflow = __builtin_sub_overflow(T(0), a, &neg);
+        if constexpr (P == OverflowPolicy::Trap) {
+            if (overflow) overflow_trap("neg");
+        } else if (overflow) {
+            __builtin_unreachable();
+        }
+        return neg;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Integer v narrowed to the raw type T under policy P, which may be Dynamic
+ *
+ * The one narrowing step behind products, fixed_cast and Accumulator::result:
+ * clamps (Saturate), keeps the low bits (Wrap), reports out-of-range values
+ * to the overflow handler as operation (Trap) or assumes they cannot occur
+ * (Undefined).
+ */
+template<typename T, OverflowPolicy P, typename W>
+constexpr T overflow_cast(W v, const char* operation = "overflow_cast") {
+    return resolve_policy<P>([&](auto policy) -> T {
+        constexpr OverflowPolicy Q = decltype(policy)::policy;
+        if constexpr (Q == OverflowPolicy::Saturate) {
+            const T r = detail::saturate_to<T>(v);
+            if constexpr (event_counters_enabled) {
+                count_event(FixedPointEvent::Saturation, static_cast<W>(r) != v);
+            }
+            return r;
+        } else if constexpr (Q == OverflowPolicy::Wrap) {
+            return static_cast<T>(v);
+        } else {
+            const bool overflow = static_cast<W>(static_cast<T>(v)) != v;
+            if constexpr (Q == OverflowPolicy::Trap) {
+                if (overflow) detail::overflow_trap(operation);
+            } else if (overflow) {
+                __builtin_unreachable();
+            }
+            return static_cast<T>(v);
+        }
+    });
+}
+
+namespace detail {
+
+/**
+ * @brief The two-word v narrowed to T under policy P, as overflow_cast does for one word
+ */
+template<typename T, OverflowPolicy P, typename U>
+constexpr T overflow_cast_wide(WideWord<U> v, const char* operation) {
+    constexpr int top = word_bits<U> - 1;
+    // v fits T when its high word only extends the low word's sign
+    const bool fits = is_signed_raw<T> ? v.hi == static_cast<U>(U(0) - (v.lo >> top))
+                                       : v.hi == U(0);
+    return resolve_policy<P>([&](auto policy) -> T {
+        constexpr OverflowPolicy Q = decltype(policy)::policy;
+        if constexpr (Q == OverflowPolicy::Saturate) {
+            if constexpr (event_counters_enabled) {
+                count_event(FixedPointEvent::Saturation, !fits);
+            }
+            const T limit = is_signed_raw<T> ? overflow_limit(static_cast<T>(v.hi))
+                                             : std::numeric_limits<T>::max();
+            return fits ? static_cast<T>(v.lo) : limit;
+        } else if constexpr (Q == OverflowPolicy::Wrap) {
+            return static_cast<T>(v.lo);
+        } else {
+            if constexpr (Q == OverflowPolicy::Trap) {
+                if (!fits) overflow_trap(operation);
+            } else if (!fits) {
+                __builtin_unreachable();
+            }
+            return static_cast<T>(v.lo);
+        }
+    });
+}
+
+/**
+ * @brief The two-word p shifted right by F bits, ties rounded toward +infinity
+ *
+ * Signed values shift arithmetically, as the one-word products do.
+ */
+template<int F, bool Signed, typename U>
+constexpr WideWord<U> round_shift_wide(WideWord<U> p) {
+    constexpr int W = word_bits<U>;
+    static_assert(F > 0 && F <= W);
+    constexpr U half = U(1) << (F - 1);
+    p.lo += half;
+    p.hi += U(p.lo < half);
+    const U fill = Signed ? U(0) - (p.hi >> (W - 1)) : U(0);
+    if constexpr (F == W) {
+        return {fill, p.hi};
+    } else {
+        return {static_cast<U>((p.hi >> F) | (fill << (W - F))),
+                static_cast<U>((p.lo >> F) | (p.hi << (W - F)))};
+    }
+}
+
+/**
+ * @brief a * b rounded to F fractional bits (ties toward +infinity) under policy P
+ *
+ * The product, the rounding carry and the shift all stay in two words of
+ * T's width, so the result is exact before it is narrowed.
+ */
+template<typename T, int F, OverflowPolicy P>
+constexpr T mul_rounded(T a, T b) {
+#if defined(LIBFIXP_HAS_INT128)
+    // A 64-bit product is one register pair already, rounded with ADD/ADC
+    // and shifted with SHRD; the words below would only obscure that
+    if constexpr (sizeof(T) == 8) {
+        using W = storage_t<128, is_signed_raw<T>>;
+        auto p = static_cast<W>(static_cast<W>(a) * static_cast<W>(b));
+        if constexpr (F > 0) p = static_cast<W>((p + (W(1) << (F - 1))) >> F);
+        return overflow_cast<T, P>(p, "mul");
+    }
+#endif
+    using U = unsigned_raw_t<T>;
+    const U ua = static_cast<U>(a), ub = static_cast<U>(b);
+    WideWord<U> p = is_signed_raw<T> ? mul_wide_signed(ua, ub) : mul_wide(ua, ub);
+    if constexpr (F > 0) p = round_shift_wide<F, is_signed_raw<T>>(p);
+    return overflow_cast_wide<T, P>(p, "mul");
+}
+
+} // namespace detail
+
 /**
  * @brief Universal Fixed-Point Template
  *
@@ -62,8 +1243,11 @@ template<int TotalBits, int FracBits, bool Signed = true, OverflowPolicy Policy
 class FixedPoint {
 public:
     using raw_type = storage_t<TotalBits, Signed>;
+    static constexpr int total_bits = TotalBits;
     static constexpr int integer_bits = TotalBits - FracBits - (Signed ? 1 : 0);
     static constexpr int fractional_bits = FracBits;
+    static constexpr bool is_signed = Signed;
+    static constexpr OverflowPolicy overflow_policy = Policy;
 
     // Check invariants
     static_assert(TotalBits > 0, "Total bits must be positive");
@@ -80,47 +1264,32 @@ public:
         return FixedPoint(raw, RawTag{});
     }
 
-    // Construction from arithmetic types
-    constexpr FixedPoint(float f) {
-        if constexpr (Policy == OverflowPolicy::Saturate) {
-            double scaled = static_cast<double>(f) * (1ULL << FracBits);
-            if (scaled >= std::numeric_limits<raw_type>::max()) m_value = std::numeric_limits<raw_type>::max();
-            else if (scaled <= std::numeric_limits<raw_type>::min()) m_value = std::numeric_limits<raw_type>::min();
-            else m_value = static_cast<raw_type>(scaled + (f >= 0 ? 0.5 : -0.5));
-        } else {
-             m_value = static_cast<raw_type>(f * (1ULL << FracBits) + (f >= 0 ? 0.5f : -0.5f));
-        }
-    }
+    // Construction from arithmetic types, rounded half away from zero. An
+    // out-of-range value is narrowed under the policy as the operators do:
+    // clamped, wrapped, trapped as "convert" or assumed not to occur. NaN
+    // converts to zero.
+    constexpr FixedPoint(float f) : FixedPoint(static_cast<double>(f)) {}
 
-    constexpr FixedPoint(double d) {
-        if constexpr (Policy == OverflowPolicy::Saturate) {
-            double scaled = d * (1ULL << FracBits);
-            if (scaled >= std::numeric_limits<raw_type>::max()) m_value = std::numeric_limits<raw_type>::max();
-            else if (scaled <= std::numeric_limits<raw_type>::min()) m_value = std::numeric_limits<raw_type>::min();
-            else m_value = static_cast<raw_type>(scaled + (d >= 0 ? 0.5 : -0.5));
-        } else {
-            m_value = static_cast<raw_type>(d * (1ULL << FracBits) + (d >= 0 ? 0.5 : -0.5));
-        }
+    constexpr FixedPoint(double d) : m_value(from_scaled(d * (1ULL << FracBits))) {
+        count_rounding(d * (1ULL << FracBits));
     }
 
-    constexpr FixedPoint(int i) {
-        // Saturation check for integer conversion?
-        // Shift can overflow
-        if constexpr (Policy == OverflowPolicy::Saturate) {
-             // Logic to check if i << FracBits fits
-             // simplified for now
-             m_value = static_cast<raw_type>(i) << FracBits;
-        } else {
-            m_value = static_cast<raw_type>(i) << FracBits;
-        }
-    }
+    constexpr FixedPoint(int i) : m_value(from_integer(i)) {}
 
     // Conversion
     constexpr explicit operator float() const {
+        if constexpr (event_counters_enabled) {
+            count_event(FixedPointEvent::PrecisionLoss,
+                        !detail::fits_mantissa<std::numeric_limits<float>::digits>(m_value));
+        }
         return static_cast<float>(m_value) / (1ULL << FracBits);
     }
 
     constexpr explicit operator double() const {
+        if constexpr (event_counters_enabled) {
+            count_event(FixedPointEvent::PrecisionLoss,
+                        !detail::fits_mantissa<std::numeric_limits<double>::digits>(m_value));
+        }
         return static_cast<double>(m_value) / (1ULL << FracBits);
     }
 
@@ -132,68 +1301,92 @@ public:
 
     // Arithmetic Operators
     constexpr FixedPoint operator+(const FixedPoint& other) const {
-        if constexpr (Policy == OverflowPolicy::Saturate) {
-            raw_type res;
-            if (__builtin_add_overflow(m_value, other.m_value, &res)) {
-                return (other.m_value > 0) ? max() : min();
-            }
-            return FixedPoint(res, RawTag{});
-        } else {
-            return FixedPoint(m_value + other.m_value, RawTag{});
-        }
+        return add<Policy>(*this, other);
     }
 
     constexpr FixedPoint operator-(const FixedPoint& other) const {
-        if constexpr (Policy == OverflowPolicy::Saturate) {
-             raw_type res;
-             if (__builtin_sub_overflow(m_value, other.m_value, &res)) {
-                 return (other.m_value < 0) ? max() : min();
-             }
-             return FixedPoint(res, RawTag{});
-        } else {
-            return FixedPoint(m_value - other.m_value, RawTag{});
-        }
+        return sub<Policy>(*this, other);
     }
 
     constexpr FixedPoint operator*(const FixedPoint& other) const {
-        // Simple widening multiply
-        // Determine wide type
-        using wide_type = storage_t<(TotalBits <= 32 ? TotalBits * 2 : 128), Signed>;
-
-        wide_type product = static_cast<wide_type>(m_value) * static_cast<wide_type>(other.m_value);
-
-        if constexpr (Policy == OverflowPolicy::Saturate) {
-             // Check if result >> FracBits fits in raw_type
-             wide_type rounding = (wide_type)1 << (FracBits - 1);
-             wide_type res = (product + rounding) >> FracBits;
-             if (res > std::numeric_limits<raw_type>::max()) return max();
-             if (res < std::numeric_limits<raw_type>::min()) return min();
-             return FixedPoint(static_cast<raw_type>(res), RawTag{});
-        } else {
-            wide_type rounding = (wide_type)1 << (FracBits - 1);
-            return FixedPoint(static_cast<raw_type>((product + rounding) >> FracBits), RawTag{});
-        }
+        return mul<Policy>(*this, other);
     }
 
     constexpr FixedPoint operator/(const FixedPoint& other) const {
-        using wide_type = storage_t<(TotalBits <= 32 ? TotalBits * 2 : 128), Signed>;
+        return div<Policy>(*this, other);
+    }
 
-        if (other.m_value == 0) {
-            // Division by zero
-            return (m_value >= 0) ? max() : min();
-        }
+    constexpr FixedPoint operator-() const { return neg<Policy>(*this); }
 
-        wide_type dividend = static_cast<wide_type>(m_value) << FracBits;
+    /**
+     * @brief a + b, a - b, a * b, a / b and -a under policy P rather than the format's
+     *
+     * The operators forward here with Policy; the PolicyTag overloads below
+     * forward with the tag's. Products round to nearest (ties toward
+     * +infinity) and quotients truncate toward zero, both in a double-width
+     * intermediate. A Dynamic P is looked up per call; loops should resolve
+     * it once with resolve_policy().
+     */
+    template<OverflowPolicy P>
+    static constexpr FixedPoint add(FixedPoint a, FixedPoint b) {
+        return resolve_policy<P>([&](auto policy) {
+            return from_raw(detail::policy_add<decltype(policy)::policy>(a.m_value, b.m_value));
+        });
+    }
 
-        // Add half divisor for rounding? simplified for now.
-        return FixedPoint(static_cast<raw_type>(dividend / other.m_value), RawTag{});
+    template<OverflowPolicy P>
+    static constexpr FixedPoint sub(FixedPoint a, FixedPoint b) {
+        return resolve_policy<P>([&](auto policy) {
+            return from_raw(detail::policy_sub<decltype(policy)::policy>(a.m_value, b.m_value));
+        });
     }
 
-    constexpr FixedPoint operator-() const {
-        if constexpr (Policy == OverflowPolicy::Saturate) {
-            if (m_value == std::numeric_limits<raw_type>::min()) return max();
+    template<OverflowPolicy P>
+    static constexpr FixedPoint mul(FixedPoint a, FixedPoint b) {
+        // Formats up to 16 bits multiply in 32 bits, where SSAT applies, and
+        // those wider than 32 bits in two words of their own width
+        if constexpr (TotalBits > 32) {
+            return from_raw(detail::mul_rounded<raw_type, FracBits, P>(a.m_value, b.m_value));
+        } else {
+            using mul_type = std::conditional_t<(TotalBits <= 16), storage_t<32, Signed>,
+                                                storage_t<64, Signed>>;
+            auto rounded = static_cast<mul_type>(static_cast<mul_type>(a.m_value) *
+                                                 static_cast<mul_type>(b.m_value));
+            if constexpr (FracBits > 0) {
+                constexpr mul_type half = mul_type(1) << (FracBits - 1);
+                rounded = static_cast<mul_type>((rounded + half) >> FracBits);
+            }
+            return from_raw(overflow_cast<raw_type, P>(rounded, "mul"));
         }
-        return FixedPoint(-m_value, RawTag{});
+    }
+
+    /**
+     * @brief A division by zero is counted and returns max() or min() by the sign of a,
+     * whatever P
+     */
+    template<OverflowPolicy P>
+    static constexpr FixedPoint div(FixedPoint a, FixedPoint b) {
+        if (b.m_value == 0) {
+            count_event(FixedPointEvent::DivideByZero);
+            return a.m_value >= 0 ? max() : min();
+        }
+        if constexpr (TotalBits > 32) {
+            return from_raw(detail::overflow_cast_wide<raw_type, P>(
+                detail::div_shifted<raw_type, FracBits>(a.m_value, b.m_value), "div"));
+        } else {
+            using wide_type = storage_t<TotalBits * 2, Signed>;
+            const auto dividend = static_cast<wide_type>(static_cast<wide_type>(a.m_value)
+                                                         << FracBits);
+            return from_raw(overflow_cast<raw_type, P>(
+                static_cast<wide_type>(dividend / static_cast<wide_type>(b.m_value)), "div"));
+        }
+    }
+
+    template<OverflowPolicy P>
+    static constexpr FixedPoint neg(FixedPoint a) {
+        return resolve_policy<P>([&](auto policy) {
+            return from_raw(detail::policy_neg<decltype(policy)::policy>(a.m_value));
+        });
     }
 
     constexpr auto operator<=>(const FixedPoint&) const = default;
@@ -206,9 +1399,316 @@ public:
     static constexpr FixedPoint one() { return FixedPoint(1ULL << FracBits, RawTag{}); }
 
 private:
+    static constexpr raw_type from_scaled(double scaled) {
+        using limits = std::numeric_limits<raw_type>;
+        if (scaled != scaled) return raw_type(0);
+        // Doubles from 2^52 up are integers; adding 0.5 could round them up
+        const bool integral = scaled >= 4503599627370496.0 || scaled <= -4503599627370496.0;
+        const double rounded = integral ? scaled : scaled + (scaled >= 0 ? 0.5 : -0.5);
+        return resolve_policy<Policy>([&](auto policy) -> raw_type {
+            constexpr OverflowPolicy Q = decltype(policy)::policy;
+            if constexpr (Q == OverflowPolicy::Saturate) {
+                if (scaled >= static_cast<double>(limits::max())) {
+                    return clamped(limits::max(), scaled);
+                }
+                if (scaled <= static_cast<double>(limits::min())) {
+                    return clamped(limits::min(), scaled);
+                }
+            } else {
+                // The range as powers of two, exact in a double: the rounded
+                // value fits when it truncates into [bottom, top)
+                constexpr double top = static_cast<double>(limits::max() / 2 + 1) * 2.0;
+                constexpr double bottom = Signed ? -top : 0.0;
+                const bool fits = rounded < top && (rounded >= bottom || rounded > bottom - 1.0);
+                if (!fits) {
+                    if constexpr (Q == OverflowPolicy::Trap) {
+                        detail::overflow_trap("convert");
+                    } else if constexpr (Q == OverflowPolicy::Undefined) {
+                        __builtin_unreachable();
+                    }
+                    return detail::wrapping_from_double<raw_type>(rounded);
+                }
+            }
+            return static_cast<raw_type>(rounded);
+        });
+    }
+
+    static constexpr raw_type from_integer(int i) {
+        using limits = std::numeric_limits<raw_type>;
+        using U = detail::unsigned_raw_t<raw_type>;
+        const auto shifted = static_cast<raw_type>(static_cast<U>(static_cast<U>(i) << FracBits));
+        const bool fits = std::cmp_greater_equal(i, limits::min() >> FracBits) &&
+                          std::cmp_less_equal(i, limits::max() >> FracBits);
+        return resolve_policy<Policy>([&](auto policy) -> raw_type {
+            constexpr OverflowPolicy Q = decltype(policy)::policy;
+            if constexpr (Q == OverflowPolicy::Saturate) {
+                if constexpr (event_counters_enabled) {
+                    count_event(FixedPointEvent::Saturation, !fits);
+                }
+                if (!fits) return i < 0 ? limits::min() : limits::max();
+            } else if constexpr (Q == OverflowPolicy::Trap) {
+                if (!fits) detail::overflow_trap("convert");
+            } else if constexpr (Q == OverflowPolicy::Undefined) {
+                if (!fits) __builtin_unreachable();
+            }
+            return shifted;
+        });
+    }
+
+    // Counts the clamp of a scaled input beyond the limit, not one equal to it
+    static constexpr raw_type clamped(raw_type limit, [[maybe_unused]] double scaled) {
+        if constexpr (event_counters_enabled) {
+            count_event(FixedPointEvent::Saturation, static_cast<double>(limit) != scaled);
+        }
+        return limit;
+    }
+
+    // Counts a conversion whose exactly scaled input was not an integer
+    constexpr void count_rounding([[maybe_unused]] double scaled) const {
+        if constexpr (event_counters_enabled) {
+            count_event(FixedPointEvent::PrecisionLoss,
+                        scaled == scaled && static_cast<double>(m_value) != scaled &&
+                            m_value != std::numeric_limits<raw_type>::max() &&
+                            m_value != std::numeric_limits<raw_type>::min());
+        }
+    }
+
     raw_type m_value;
 };
 
+/**
+ * @brief Trait identifying FixedPoint instantiations
+ */
+template<typename T>
+struct is_fixed_point : std::false_type {};
+
+template<int TotalBits, int FracBits, bool Signed, OverflowPolicy Policy>
+struct is_fixed_point<FixedPoint<TotalBits, FracBits, Signed, Policy>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_fixed_point_v = is_fixed_point<T>::value;
+
+template<typename T>
+concept FixedPointType = is_fixed_point_v<T>;
+
+/**
+ * @brief a + b under the tag's policy: add(a, b, saturating), add(a, b, wrapping)
+ */
+template<FixedPointType FP, OverflowPolicy P>
+constexpr FP add(FP a, std::type_identity_t<FP> b, PolicyTag<P>) {
+    return FP::template add<P>(a, b);
+}
+
+template<FixedPointType FP, OverflowPolicy P>
+constexpr FP sub(FP a, std::type_identity_t<FP> b, PolicyTag<P>) {
+    return FP::template sub<P>(a, b);
+}
+
+template<FixedPointType FP, OverflowPolicy P>
+constexpr FP mul(FP a, std::type_identity_t<FP> b, PolicyTag<P>) {
+    return FP::template mul<P>(a, b);
+}
+
+template<FixedPointType FP, OverflowPolicy P>
+constexpr FP div(FP a, std::type_identity_t<FP> b, PolicyTag<P>) {
+    return FP::template div<P>(a, b);
+}
+
+template<FixedPointType FP, OverflowPolicy P>
+constexpr FP neg(FP a, PolicyTag<P>) {
+    return FP::template neg<P>(a);
+}
+
+//
+// Mixed-format arithmetic
+//
+// Operators between two different FixedPoint instantiations return a type
+// wide enough for the exact result, deduced at compile time: a product
+// Q<I1.F1> * Q<I2.F2> is Q<(I1+I2+1).(F1+F2)> in T1 + T2 bits, a sum has
+// max(F1, F2) fractional bits and one more integer bit than the wider
+// operand. Nothing is rounded or saturated until fixed_cast brings the
+// result back to a working format. Same-format operators are the members
+// above and keep rounding to their own format.
+//
+namespace detail {
+
+inline constexpr int max_storage_bits = 128;
+
+// The stricter of two policies: Trap, Saturate, Dynamic, Wrap, Undefined
+constexpr int policy_strictness(OverflowPolicy p) {
+    switch (p) {
+    case OverflowPolicy::Trap: return 4;
+    case OverflowPolicy::Saturate: return 3;
+    case OverflowPolicy::Dynamic: return 2;
+    case OverflowPolicy::Wrap: return 1;
+    default: return 0;
+    }
+}
+
+template<typename A, typename B>
+inline constexpr OverflowPolicy common_policy =
+    policy_strictness(A::overflow_policy) >= policy_strictness(B::overflow_policy)
+        ? A::overflow_policy : B::overflow_policy;
+
+template<typename A, typename B>
+concept mixed_formats = FixedPointType<A> && FixedPointType<B> && !std::is_same_v<A, B>;
+
+template<typename A, typename B, bool Signed>
+struct sum_format {
+    static constexpr int frac_bits = std::max(A::fractional_bits, B::fractional_bits);
+    static constexpr int int_bits = std::max(A::integer_bits, B::integer_bits) + 1;
+    static constexpr int bits = int_bits + frac_bits + (Signed ? 1 : 0);
+};
+
+template<typename A, typename B>
+using product_t = FixedPoint<A::total_bits + B::total_bits,
+                             A::fractional_bits + B::fractional_bits,
+                             A::is_signed || B::is_signed, common_policy<A, B>>;
+
+template<typename A, typename B>
+using sum_t = FixedPoint<sum_format<A, B, A::is_signed || B::is_signed>::bits,
+                         sum_format<A, B, A::is_signed || B::is_signed>::frac_bits,
+                         A::is_signed || B::is_signed, common_policy<A, B>>;
+
+// Differences are signed even when both operands are not
+template<typename A, typename B>
+using difference_t = FixedPoint<sum_format<A, B, true>::bits, sum_format<A, B, true>::frac_bits,
+                                true, common_policy<A, B>>;
+
+// a / b ranges up to 2^(I1 + F2) and resolves down to 2^-(F1 + I2); the
+// extra integer bit for two signed operands holds min / -1
+template<typename A, typename B>
+struct quotient_format {
+    static constexpr bool is_signed = A::is_signed || B::is_signed;
+    static constexpr int frac_bits = A::fractional_bits + B::integer_bits;
+    static constexpr int int_bits = A::integer_bits + B::fractional_bits +
+                                    (A::is_signed && B::is_signed ? 1 : 0);
+    static constexpr int bits = int_bits + frac_bits + (is_signed ? 1 : 0);
+};
+
+template<typename A, typename B>
+using quotient_t = FixedPoint<quotient_format<A, B>::bits, quotient_format<A, B>::frac_bits,
+                              quotient_format<A, B>::is_signed, common_policy<A, B>>;
+
+// Unsigned types narrower than int would promote to int and could overflow
+template<typename T>
+using promoted_t = std::conditional_t<std::is_unsigned_v<T> && (sizeof(T) < sizeof(unsigned)),
+                                      unsigned, T>;
+
+// Exact re-expression of x in the wider format To
+template<typename To, typename From>
+constexpr typename To::raw_type widen_to(From x) {
+    using raw_type = typename To::raw_type;
+    return static_cast<raw_type>(static_cast<raw_type>(x.raw())
+                                 << (To::fractional_bits - From::fractional_bits));
+}
+
+} // namespace detail
+
+/**
+ * @brief Converts between formats with one rounding shift and To's overflow policy
+ *
+ * Narrowing the fraction rounds to nearest (ties toward +infinity, as the
+ * same-format multiply does); widening it is exact. Out-of-range values
+ * clamp when To saturates, keep the low bits when it wraps and trap when it
+ * traps.
+ */
+template<FixedPointType To, FixedPointType From>
+constexpr To fixed_cast(From x) {
+    constexpr int shift = To::fractional_bits - From::fractional_bits;
+    // Signed and wide enough for the shifted value, the rounding carry and To's range
+    constexpr int bits = std::max(From::total_bits + (From::is_signed ? 0 : 1) +
+                                      (shift > 0 ? shift : 1),
+                                  To::total_bits + (To::is_signed ? 0 : 1));
+    static_assert(bits <= detail::max_storage_bits, "fixed_cast needs a wider intermediate");
+    using wide_type = storage_t<(bits <= 64 ? 64 : 128), true>;
+    using raw_type = typename To::raw_type;
+
+    wide_type v = static_cast<wide_type>(x.raw());
+    if constexpr (shift > 0) {
+        v = static_cast<wide_type>(v << shift);
+    } else if constexpr (shift < 0) {
+        v = (v + (wide_type(1) << (-shift - 1))) >> -shift;
+    }
+    return To::from_raw(overflow_cast<raw_type, To::overflow_policy>(v, "fixed_cast"));
+}
+
+/**
+ * @brief Full-precision product of two formats; never rounds or overflows
+ */
+template<typename A, typename B>
+    requires detail::mixed_formats<A, B> &&
+             (A::total_bits + B::total_bits <= detail::max_storage_bits)
+constexpr detail::product_t<A, B> operator*(A a, B b) {
+    using R = detail::product_t<A, B>;
+    using raw_type = typename R::raw_type;
+    using mul_type = detail::promoted_t<raw_type>;
+    return R::from_raw(static_cast<raw_type>(static_cast<mul_type>(a.raw()) *
+                                             static_cast<mul_type>(b.raw())));
+}
+
+/**
+ * @brief Exact sum of two formats, aligned to the finer fraction
+ */
+template<typename A, typename B>
+    requires detail::mixed_formats<A, B> &&
+             (detail::sum_t<A, B>::total_bits <= detail::max_storage_bits)
+constexpr detail::sum_t<A, B> operator+(A a, B b) {
+    using R = detail::sum_t<A, B>;
+    return R::from_raw(static_cast<typename R::raw_type>(detail::widen_to<R>(a) +
+                                                         detail::widen_to<R>(b)));
+}
+
+/**
+ * @brief Exact difference of two formats, always signed
+ */
+template<typename A, typename B>
+    requires detail::mixed_formats<A, B> &&
+             (detail::difference_t<A, B>::total_bits <= detail::max_storage_bits)
+constexpr detail::difference_t<A, B> operator-(A a, B b) {
+    using R = detail::difference_t<A, B>;
+    return R::from_raw(static_cast<typename R::raw_type>(detail::widen_to<R>(a) -
+                                                         detail::widen_to<R>(b)));
+}
+
+/**
+ * @brief Quotient of two formats, truncated toward zero at F1 + I2 fractional bits
+ *
+ * Division by zero returns the result type's max() or min() by the sign of a.
+ */
+template<typename A, typename B>
+    requires detail::mixed_formats<A, B> &&
+             (detail::quotient_t<A, B>::total_bits <= detail::max_storage_bits)
+constexpr detail::quotient_t<A, B> operator/(A a, B b) {
+    using R = detail::quotient_t<A, B>;
+    using raw_type = typename R::raw_type;
+    if (b.raw() == 0) {
+        count_event(FixedPointEvent::DivideByZero);
+        return a.raw() >= 0 ? R::max() : R::min();
+    }
+    constexpr int shift = B::integer_bits + B::fractional_bits;
+    const auto dividend = static_cast<raw_type>(static_cast<raw_type>(a.raw()) << shift);
+    return R::from_raw(static_cast<raw_type>(dividend / static_cast<raw_type>(b.raw())));
+}
+
+/**
+ * @brief Compares values across formats exactly
+ */
+template<typename A, typename B>
+    requires detail::mixed_formats<A, B> &&
+             (detail::difference_t<A, B>::total_bits <= detail::max_storage_bits)
+constexpr std::strong_ordering operator<=>(A a, B b) {
+    using R = detail::difference_t<A, B>;
+    return detail::widen_to<R>(a) <=> detail::widen_to<R>(b);
+}
+
+template<typename A, typename B>
+    requires detail::mixed_formats<A, B> &&
+             (detail::difference_t<A, B>::total_bits <= detail::max_storage_bits)
+constexpr bool operator==(A a, B b) {
+    return (a <=> b) == 0;
+}
+
 // Common Aliases
 using Q15_16 = FixedPoint<32, 16>;
 using Q16_16 = FixedPoint<32, 16>; // Often synonymous
@@ -9,6 +9,7 @@
 #ifndef LIBFIXP_GEN_Q0_7_H
 #define LIBFIXP_GEN_Q0_7_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -27,9 +28,23 @@ typedef int8_t q0_7_t;
 #define Q0_7_RAW(x) (x)
 
 #define Q0_7_FRAC_BITS 7
+// Guarded: the qM_N_math.h headers define the same constants
+#ifndef Q0_7_ONE
 #define Q0_7_ONE Q0_7_WRAP(128)
+#endif
+#ifndef Q0_7_MAX
 #define Q0_7_MAX Q0_7_WRAP(INT8_MAX)
+#endif
+#ifndef Q0_7_MIN
 #define Q0_7_MIN Q0_7_WRAP(INT8_MIN)
+#endif
+
+#ifndef LIBFIXP_CVT_FLAGS
+#define LIBFIXP_CVT_FLAGS
+/* Flags for the *_from_float_array / *_from_double_array converters */
+#define LIBFIXP_CVT_SATURATE 1u      /* clamp out-of-range inputs, NaN -> 0 */
+#define LIBFIXP_CVT_NEAREST_EVEN 2u  /* round ties to even instead of away from zero */
+#endif
 
 static inline q0_7_t q0_7_add(q0_7_t a, q0_7_t b) {
     // Use unsigned arithmetic to avoid signed overflow UB
@@ -59,6 +74,47 @@ static inline double q0_7_to_double(q0_7_t a) {
     return (double)a / 128.0;
 }
 
+/**
+ * @brief Rounds d * 2^7 to q0_7_t according to LIBFIXP_CVT_* flags
+ *
+ * Without LIBFIXP_CVT_SATURATE out-of-range inputs are undefined, as for
+ * q0_7_from_double. Ties-to-even uses the 2^52 trick and needs the default
+ * rounding mode (no -ffast-math).
+ */
+static inline q0_7_t q0_7_from_double_rnd(double d, unsigned flags) {
+    double v = d * 0x1p7;
+    if (flags & LIBFIXP_CVT_NEAREST_EVEN) {
+        double m = v < 0 ? -0x1p52 : 0x1p52;
+        if ((v < 0 ? -v : v) < 0x1p52) v = (v + m) - m;
+    } else {
+        v += v < 0 ? -0.5 : 0.5;
+    }
+    if (flags & LIBFIXP_CVT_SATURATE) {
+        if (v != v) return Q0_7_WRAP(0);
+        if (v >= (double)INT8_MAX + 1.0) return Q0_7_MAX;
+        if (v <= (double)INT8_MIN - 1.0) return Q0_7_MIN;
+    }
+    return Q0_7_WRAP((int8_t)v);
+}
+
+static inline void q0_7_from_float_array(const float* in, q0_7_t* out, size_t n,
+                                         unsigned flags) {
+    for (size_t i = 0; i < n; ++i) out[i] = q0_7_from_double_rnd((double)in[i], flags);
+}
+
+static inline void q0_7_from_double_array(const double* in, q0_7_t* out, size_t n,
+                                          unsigned flags) {
+    for (size_t i = 0; i < n; ++i) out[i] = q0_7_from_double_rnd(in[i], flags);
+}
+
+static inline void q0_7_to_float_array(const q0_7_t* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = (float)Q0_7_RAW(in[i]) * 0x1p-7f;
+}
+
+static inline void q0_7_to_double_array(const q0_7_t* in, double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = (double)Q0_7_RAW(in[i]) * 0x1p-7;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,7 @@
 #ifndef LIBFIXP_GEN_Q15_16_H
 #define LIBFIXP_GEN_Q15_16_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -27,9 +28,23 @@ typedef int32_t q15_16_t;
 #define Q15_16_RAW(x) (x)
 
 #define Q15_16_FRAC_BITS 16
+// Guarded: the qM_N_math.h headers define the same constants
+#ifndef Q15_16_ONE
 #define Q15_16_ONE Q15_16_WRAP(65536)
+#endif
+#ifndef Q15_16_MAX
 #define Q15_16_MAX Q15_16_WRAP(INT32_MAX)
+#endif
+#ifndef Q15_16_MIN
 #define Q15_16_MIN Q15_16_WRAP(INT32_MIN)
+#endif
+
+#ifndef LIBFIXP_CVT_FLAGS
+#define LIBFIXP_CVT_FLAGS
+/* Flags for the *_from_float_array / *_from_double_array converters */
+#define LIBFIXP_CVT_SATURATE 1u      /* clamp out-of-range inputs, NaN -> 0 */
+#define LIBFIXP_CVT_NEAREST_EVEN 2u  /* round ties to even instead of away from zero */
+#endif
 
 static inline q15_16_t q15_16_add(q15_16_t a, q15_16_t b) {
     return Q15_16_WRAP((int32_t)((uint32_t)a + (uint32_t)b));
@@ -58,6 +73,47 @@ static inline double q15_16_to_double(q15_16_t a) {
     return (double)a / 65536.0;
 }
 
+/**
+ * @brief Rounds d * 2^16 to q15_16_t according to LIBFIXP_CVT_* flags
+ *
+ * Without LIBFIXP_CVT_SATURATE out-of-range inputs are undefined, as for
+ * q15_16_from_double. Ties-to-even uses the 2^52 trick and needs the default
+ * rounding mode (no -ffast-math).
+ */
+static inline q15_16_t q15_16_from_double_rnd(double d, unsigned flags) {
+    double v = d * 0x1p16;
+    if (flags & LIBFIXP_CVT_NEAREST_EVEN) {
+        double m = v < 0 ? -0x1p52 : 0x1p52;
+        if ((v < 0 ? -v : v) < 0x1p52) v = (v + m) - m;
+    } else {
+        v += v < 0 ? -0.5 : 0.5;
+    }
+    if (flags & LIBFIXP_CVT_SATURATE) {
+        if (v != v) return Q15_16_WRAP(0);
+        if (v >= (double)INT32_MAX + 1.0) return Q15_16_MAX;
+        if (v <= (double)INT32_MIN - 1.0) return Q15_16_MIN;
+    }
+    return Q15_16_WRAP((int32_t)v);
+}
+
+static inline void q15_16_from_float_array(const float* in, q15_16_t* out, size_t n,
+                                           unsigned flags) {
+    for (size_t i = 0; i < n; ++i) out[i] = q15_16_from_double_rnd((double)in[i], flags);
+}
+
+static inline void q15_16_from_double_array(const double* in, q15_16_t* out, size_t n,
+                                            unsigned flags) {
+    for (size_t i = 0; i < n; ++i) out[i] = q15_16_from_double_rnd(in[i], flags);
+}
+
+static inline void q15_16_to_float_array(const q15_16_t* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = (float)Q15_16_RAW(in[i]) * 0x1p-16f;
+}
+
+static inline void q15_16_to_double_array(const q15_16_t* in, double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = (double)Q15_16_RAW(in[i]) * 0x1p-16;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,7 @@
 #ifndef LIBFIXP_GEN_Q16_16_H
 #define LIBFIXP_GEN_Q16_16_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -27,9 +28,23 @@ typedef int64_t q16_16_t;
 #define Q16_16_RAW(x) (x)
 
 #define Q16_16_FRAC_BITS 16
+// Guarded: the qM_N_math.h headers define the same constants
+#ifndef Q16_16_ONE
 #define Q16_16_ONE Q16_16_WRAP(65536)
+#endif
+#ifndef Q16_16_MAX
 #define Q16_16_MAX Q16_16_WRAP(INT64_MAX)
+#endif
+#ifndef Q16_16_MIN
 #define Q16_16_MIN Q16_16_WRAP(INT64_MIN)
+#endif
+
+#ifndef LIBFIXP_CVT_FLAGS
+#define LIBFIXP_CVT_FLAGS
+/* Flags for the *_from_float_array / *_from_double_array converters */
+#define LIBFIXP_CVT_SATURATE 1u      /* clamp out-of-range inputs, NaN -> 0 */
+#define LIBFIXP_CVT_NEAREST_EVEN 2u  /* round ties to even instead of away from zero */
+#endif
 
 static inline q16_16_t q16_16_add(q16_16_t a, q16_16_t b) {
     // Use unsigned arithmetic to avoid signed overflow UB
@@ -59,6 +74,47 @@ static inline double q16_16_to_double(q16_16_t a) {
     return (double)a / 65536.0;
 }
 
+/**
+ * @brief Rounds d * 2^16 to q16_16_t according to LIBFIXP_CVT_* flags
+ *
+ * Without LIBFIXP_CVT_SATURATE out-of-range inputs are undefined, as for
+ * q16_16_from_double. Ties-to-even uses the 2^52 trick and needs the default
+ * rounding mode (no -ffast-math).
+ */
+static inline q16_16_t q16_16_from_double_rnd(double d, unsigned flags) {
+    double v = d * 0x1p16;
+    if (flags & LIBFIXP_CVT_NEAREST_EVEN) {
+        double m = v < 0 ? -0x1p52 : 0x1p52;
+        if ((v < 0 ? -v : v) < 0x1p52) v = (v + m) - m;
+    } else {
+        v += v < 0 ? -0.5 : 0.5;
+    }
+    if (flags & LIBFIXP_CVT_SATURATE) {
+        if (v != v) return Q16_16_WRAP(0);
+        if (v >= (double)INT64_MAX + 1.0) return Q16_16_MAX;
+        if (v <= (double)INT64_MIN - 1.0) return Q16_16_MIN;
+    }
+    return Q16_16_WRAP((int64_t)v);
+}
+
+static inline void q16_16_from_float_array(const float* in, q16_16_t* out, size_t n,
+                                           unsigned flags) {
+    for (size_t i = 0; i < n; ++i) out[i] = q16_16_from_double_rnd((double)in[i], flags);
+}
+
+static inline void q16_16_from_double_array(const double* in, q16_16_t* out, size_t n,
+                                            unsigned flags) {
+    for (size_t i = 0; i < n; ++i) out[i] = q16_16_from_double_rnd(in[i], flags);
+}
+
+static inline void q16_16_to_float_array(const q16_16_t* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = (float)Q16_16_RAW(in[i]) * 0x1p-16f;
+}
+
+static inline void q16_16_to_double_array(const q16_16_t* in, double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = (double)Q16_16_RAW(in[i]) * 0x1p-16;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,7 @@
 #ifndef LIBFIXP_GEN_Q8_8_H
 #define LIBFIXP_GEN_Q8_8_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -27,9 +28,23 @@ typedef int32_t q8_8_t;
 #define Q8_8_RAW(x) (x)
 
 #define Q8_8_FRAC_BITS 8
+// Guarded: the qM_N_math.h headers define the same constants
+#ifndef Q8_8_ONE
 #define Q8_8_ONE Q8_8_WRAP(256)
+#endif
+#ifndef Q8_8_MAX
 #define Q8_8_MAX Q8_8_WRAP(INT32_MAX)
+#endif
+#ifndef Q8_8_MIN
 #define Q8_8_MIN Q8_8_WRAP(INT32_MIN)
+#endif
+
+#ifndef LIBFIXP_CVT_FLAGS
+#define LIBFIXP_CVT_FLAGS
+/* Flags for the *_from_float_array / *_from_double_array converters */
+#define LIBFIXP_CVT_SATURATE 1u      /* clamp out-of-range inputs, NaN -> 0 */
+#define LIBFIXP_CVT_NEAREST_EVEN 2u  /* round ties to even instead of away from zero */
+#endif
 
 static inline q8_8_t q8_8_add(q8_8_t a, q8_8_t b) {
     return Q8_8_WRAP(a + b);
@@ -58,6 +73,47 @@ static inline double q8_8_to_double(q8_8_t a) {
     return (double)a / 256.0;
 }
 
+/**
+ * @brief Rounds d * 2^8 to q8_8_t according to LIBFIXP_CVT_* flags
+ *
+ * Without LIBFIXP_CVT_SATURATE out-of-range inputs are undefined, as for
+ * q8_8_from_double. Ties-to-even uses the 2^52 trick and needs the default
+ * rounding mode (no -ffast-math).
+ */
+static inline q8_8_t q8_8_from_double_rnd(double d, unsigned flags) {
+    double v = d * 0x1p8;
+    if (flags & LIBFIXP_CVT_NEAREST_EVEN) {
+        double m = v < 0 ? -0x1p52 : 0x1p52;
+        if ((v < 0 ? -v : v) < 0x1p52) v = (v + m) - m;
+    } else {
+        v += v < 0 ? -0.5 : 0.5;
+    }
+    if (flags & LIBFIXP_CVT_SATURATE) {
+        if (v != v) return Q8_8_WRAP(0);
+        if (v >= (double)INT32_MAX + 1.0) return Q8_8_MAX;
+        if (v <= (double)INT32_MIN - 1.0) return Q8_8_MIN;
+    }
+    return Q8_8_WRAP((int32_t)v);
+}
+
+static inline void q8_8_from_float_array(const float* in, q8_8_t* out, size_t n,
+                                         unsigned flags) {
+    for (size_t i = 0; i < n; ++i) out[i] = q8_8_from_double_rnd((double)in[i], flags);
+}
+
+static inline void q8_8_from_double_array(const double* in, q8_8_t* out, size_t n,
+                                          unsigned flags) {
+    for (size_t i = 0; i < n; ++i) out[i] = q8_8_from_double_rnd(in[i], flags);
+}
+
+static inline void q8_8_to_float_array(const q8_8_t* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = (float)Q8_8_RAW(in[i]) * 0x1p-8f;
+}
+
+static inline void q8_8_to_double_array(const q8_8_t* in, double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = (double)Q8_8_RAW(in[i]) * 0x1p-8;
+}
+
 #ifdef __cplusplus
 }
 #endif
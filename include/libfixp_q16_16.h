@@ -12,6 +12,10 @@
     #include "libfixp/gen/q15_16.h"
 #endif
 
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
 // Typedef map
 typedef q15_16_t q16_16_t;
 
@@ -54,69 +58,75 @@ static inline int32_t q16_16_to_int(q16_16_t q) {
 }
 
 // Saturating Arithmetic (Legacy)
+//
+// Branch-free: the result is computed unconditionally and the limit picked
+// with a select, so noisy inputs cost no mispredictions. ARM cores with the
+// DSP extension use QADD/QSUB.
+
+// The limit an overflowing a + b or a - b runs into: INT32_MAX for a >= 0,
+// INT32_MIN for a < 0
+static inline int32_t q16_16_overflow_limit(int32_t a) {
+    return (int32_t)((uint32_t)(a >> 31) ^ 0x7FFFFFFFu);
+}
+
 static inline q16_16_t q16_16_add_sat(q16_16_t a, q16_16_t b) {
+#if defined(__ARM_FEATURE_DSP)
+    return Q16_16_WRAP(__qadd(Q16_16_RAW(a), Q16_16_RAW(b)));
+#else
     int32_t res;
-    if (__builtin_add_overflow(Q16_16_RAW(a), Q16_16_RAW(b), &res)) {
-        return (Q16_16_RAW(a) > 0) ? Q16_16_MAX : Q16_16_MIN;
-    }
-    return Q16_16_WRAP(res);
+    int overflow = __builtin_add_overflow(Q16_16_RAW(a), Q16_16_RAW(b), &res);
+    return Q16_16_WRAP(overflow ? q16_16_overflow_limit(Q16_16_RAW(a)) : res);
+#endif
 }
 
 static inline q16_16_t q16_16_sub_sat(q16_16_t a, q16_16_t b) {
+#if defined(__ARM_FEATURE_DSP)
+    return Q16_16_WRAP(__qsub(Q16_16_RAW(a), Q16_16_RAW(b)));
+#else
+    /* a - b overflows only when b has the opposite sign, toward a's sign */
     int32_t res;
-    int32_t ra = Q16_16_RAW(a);
-    int32_t rb = Q16_16_RAW(b);
-    if (__builtin_sub_overflow(ra, rb, &res)) {
-        /* For a - b:
-         * - If a >= 0 and b < 0, the result overflows positively -> clamp to MAX.
-         * - If a < 0 and b > 0, the result overflows negatively -> clamp to MIN.
-         * In all other (unexpected) overflow cases, saturate toward the sign of a - b,
-         * which is consistent with these two primary cases.
-         */
-        if (ra >= 0 && rb < 0) {
-            return Q16_16_MAX;
-        } else {
-            return Q16_16_MIN;
-        }
-    }
-    return Q16_16_WRAP(res);
+    int overflow = __builtin_sub_overflow(Q16_16_RAW(a), Q16_16_RAW(b), &res);
+    return Q16_16_WRAP(overflow ? q16_16_overflow_limit(Q16_16_RAW(a)) : res);
+#endif
 }
 
 static inline q16_16_t q16_16_mul_sat(q16_16_t a, q16_16_t b) {
     int64_t product = (int64_t)Q16_16_RAW(a) * (int64_t)Q16_16_RAW(b);
     int64_t result = (product + 0x8000) >> 16;
-    if (result > 2147483647) return Q16_16_MAX;
-    if (result < -2147483648LL) return Q16_16_MIN;
+    result = result > INT32_MAX ? INT32_MAX : result;
+    result = result < INT32_MIN ? INT32_MIN : result;
     return Q16_16_WRAP((int32_t)result);
 }
 
 static inline q16_16_t q16_16_neg_sat(q16_16_t a) {
-    if (Q16_16_RAW(a) == (int32_t)0x80000000u) return Q16_16_MAX;
-    return Q16_16_WRAP(-Q16_16_RAW(a));
+    int32_t ra = Q16_16_RAW(a);
+    return Q16_16_WRAP(ra == INT32_MIN ? INT32_MAX : (int32_t)(0u - (uint32_t)ra));
 }
 
 static inline q16_16_t q16_16_floor(q16_16_t q) {
-    return Q16_16_WRAP(Q16_16_RAW(q) & 0xFFFF0000);
+    return Q16_16_WRAP(Q16_16_RAW(q) & ~INT32_C(0xFFFF));
 }
 
 // CORDIC and Math implementation
 static inline q16_16_t q16_16_sqrt(q16_16_t x) {
     int32_t val = Q16_16_RAW(x);
     if (val <= 0) return Q16_16_ZERO;
-    if (val == 0x10000) return Q16_16_ONE;
-
-    uint32_t uval = (uint32_t)val;
-    int leading_zeros = __builtin_clz(uval);
-    int shift = (16 - leading_zeros) / 2;
-    uint32_t guess = uval >> shift;
-
-    uint64_t val64 = (uint64_t)val << 16;
-    uint32_t root = guess;
-    for (int i = 0; i < 8; i++) {
-        if (root == 0) break;
-        uint32_t quotient = (uint32_t)(val64 / root);
-        root = (root + quotient) >> 1;
+
+    // isqrt(val * 2^16) digit by digit: shifts and compares, no divides
+    uint64_t v = (uint64_t)val << 16;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << (62 - (__builtin_clzll(v) & ~1));
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
     }
+    // Round to nearest
+    if (v > root) root++;
     return Q16_16_WRAP((int32_t)root);
 }
 
@@ -130,21 +140,16 @@ static const int32_t _q16_16_cordic_angles[16] = {
 #define _Q16_16_CORDIC_K_INV  0x00009B74
 
 static inline void q16_16_sincos(q16_16_t angle, q16_16_t* sin_out, q16_16_t* cos_out) {
-    int32_t z = Q16_16_RAW(angle);
-    const int32_t pi = 0x0003243F;
-    const int32_t two_pi = 0x0006487F;
-
-    while (z > pi) z -= two_pi;
-    while (z < -pi) z += two_pi;
-
-    int negate_cos = 0;
-    if (z > (pi >> 1)) {
-        z = pi - z;
-        negate_cos = 1;
-    } else if (z < -(pi >> 1)) {
-        z = -pi - z;
-        negate_cos = 1;
-    }
+    // Constant-time range reduction: multiply by 1/(2*pi) into a 32-bit phase
+    // that wraps modulo one turn, then split off the nearest quadrant so the
+    // CORDIC input stays within [-pi/4, pi/4]
+    const uint64_t inv_two_pi = 0x28BE60DB9391ULL; // 2^48 / (2*pi)
+    const int64_t pi_2_q30 = 1686629713;            // pi/2 * 2^30
+    uint32_t phase = (uint32_t)(((uint64_t)(int64_t)Q16_16_RAW(angle) * inv_two_pi +
+                                 0x80000000u) >> 32);
+    uint32_t quadrant = (phase + 0x20000000u) >> 30;
+    int32_t r = (int32_t)(phase - (quadrant << 30));
+    int32_t z = (int32_t)(((int64_t)r * pi_2_q30 + (1LL << 43)) >> 44);
 
     int32_t x = _Q16_16_CORDIC_K_INV;
     int32_t y = 0;
@@ -164,10 +169,16 @@ static inline void q16_16_sincos(q16_16_t angle, q16_16_t* sin_out, q16_16_t* co
         y = y_new;
     }
 
-    if (negate_cos) x = -x;
+    int32_t s, c;
+    switch (quadrant & 3u) {
+        case 0:  s = y;  c = x;  break;
+        case 1:  s = x;  c = -y; break;
+        case 2:  s = -y; c = -x; break;
+        default: s = -x; c = y;  break;
+    }
 
-    if (cos_out) *cos_out = Q16_16_WRAP(x);
-    if (sin_out) *sin_out = Q16_16_WRAP(y);
+    if (cos_out) *cos_out = Q16_16_WRAP(c);
+    if (sin_out) *sin_out = Q16_16_WRAP(s);
 }
 
 static inline q16_16_t q16_16_sin(q16_16_t angle) {
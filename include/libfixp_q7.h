@@ -8,6 +8,10 @@
     #include "libfixp/gen/q0_7.h"
 #endif
 
+#if defined(__ARM_FEATURE_SAT)
+#include <arm_acle.h>
+#endif
+
 // Map legacy names to generated names
 // Legacy: q7_t (int8_t)
 // Generated: q0_7_t (int8_t)
@@ -30,11 +34,17 @@ static inline q7_t q7_mul(q7_t a, q7_t b) { return q0_7_mul(a, b); }
 // q0_7_div exists
 
 // Add back saturation functions (not in generator yet)
+// Branch-free: SSAT on ARM cores that have it, two selects elsewhere
+
 static inline q7_t q7_add_sat(q7_t a, q7_t b) {
-    int16_t sum = (int16_t)a + (int16_t)b;
-    if (sum > 127) return Q7_MAX;
-    if (sum < -128) return Q7_MIN;
+    int sum = (int)a + (int)b;
+#if defined(__ARM_FEATURE_SAT)
+    return (q7_t)__ssat(sum, 8);
+#else
+    sum = sum > 127 ? 127 : sum;
+    sum = sum < -128 ? -128 : sum;
     return (q7_t)sum;
+#endif
 }
 
 static inline q7_t q7_from_double(double d) { return q0_7_from_double(d); }
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""
+Compare two fixp_bench --json runs and report regressions.
+
+Benchmarks are matched on (name, format). A benchmark regresses when its
+ns/op grew by more than the threshold percentage, or when its max_ulp error
+grew by more than the ULP tolerance; the script then exits 1, so it can gate
+CI. The accuracy sweeps are seeded, so max_ulp only moves when the kernel's
+results do. Benchmarks present in only one run are listed but never fail the
+comparison.
+
+Usage: compare_benchmarks.py BASELINE CURRENT [--threshold PERCENT]
+                             [--ulp-tolerance ULP]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return {(b["name"], b["format"]): b for b in data["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two fixp_bench JSON runs")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed ns/op increase in percent (default 10)")
+    parser.add_argument("--ulp-tolerance", type=float, default=0.0,
+                        help="allowed max_ulp increase (default 0)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    accuracy_regressions = 0
+    print(f"{'benchmark':<28} {'format':<14} {'base ns/op':>12} {'ns/op':>12} {'change':>9}"
+          f" {'base ulp':>10} {'max ulp':>10}")
+    for key in sorted(baseline.keys() & current.keys()):
+        old = baseline[key]["ns_per_op"]
+        new = current[key]["ns_per_op"]
+        change = (new - old) / old * 100.0 if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        ulps = ""
+        old_ulp = baseline[key].get("max_ulp")
+        new_ulp = current[key].get("max_ulp")
+        if old_ulp is not None and new_ulp is not None:
+            ulps = f" {old_ulp:>10.2f} {new_ulp:>10.2f}"
+            if new_ulp > old_ulp + args.ulp_tolerance:
+                flag += "  ACCURACY"
+                accuracy_regressions += 1
+        print(f"{key[0]:<28} {key[1]:<14} {old:>12.3f} {new:>12.3f} {change:>+8.1f}%{ulps}{flag}")
+
+    for key in sorted(baseline.keys() - current.keys()):
+        print(f"missing from current: {key[0]} {key[1]}")
+    for key in sorted(current.keys() - baseline.keys()):
+        print(f"new: {key[0]} {key[1]}")
+
+    if regressions:
+        print(f"\n{regressions} benchmark(s) slower by more than {args.threshold:g}%")
+    if accuracy_regressions:
+        print(f"\n{accuracy_regressions} benchmark(s) less accurate by more than "
+              f"{args.ulp_tolerance:g} ULP")
+    if regressions or accuracy_regressions:
+        return 1
+    print("\nNo regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
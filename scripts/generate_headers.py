@@ -2,40 +2,89 @@
 import os
 import sys
 
+def array_converters(m, n, type_name, storage_type, storage_max, storage_min):
+    """Span converters; plain counted loops over an inline kernel so they auto-vectorize."""
+    p = f"q{m}_{n}"
+
+    def pad(name):
+        return " " * len(f"static inline void {p}_{name}(")
+    return f"""
+/**
+ * @brief Rounds d * 2^{n} to {type_name} according to LIBFIXP_CVT_* flags
+ *
+ * Without LIBFIXP_CVT_SATURATE out-of-range inputs are undefined, as for
+ * {p}_from_double. Ties-to-even uses the 2^52 trick and needs the default
+ * rounding mode (no -ffast-math).
+ */
+static inline {type_name} {p}_from_double_rnd(double d, unsigned flags) {{
+    double v = d * 0x1p{n};
+    if (flags & LIBFIXP_CVT_NEAREST_EVEN) {{
+        double m = v < 0 ? -0x1p52 : 0x1p52;
+        if ((v < 0 ? -v : v) < 0x1p52) v = (v + m) - m;
+    }} else {{
+        v += v < 0 ? -0.5 : 0.5;
+    }}
+    if (flags & LIBFIXP_CVT_SATURATE) {{
+        if (v != v) return {p.upper()}_WRAP(0);
+        if (v >= (double){storage_max} + 1.0) return {p.upper()}_MAX;
+        if (v <= (double){storage_min} - 1.0) return {p.upper()}_MIN;
+    }}
+    return {p.upper()}_WRAP(({storage_type})v);
+}}
+
+static inline void {p}_from_float_array(const float* in, {type_name}* out, size_t n,
+{pad("from_float_array")}unsigned flags) {{
+    for (size_t i = 0; i < n; ++i) out[i] = {p}_from_double_rnd((double)in[i], flags);
+}}
+
+static inline void {p}_from_double_array(const double* in, {type_name}* out, size_t n,
+{pad("from_double_array")}unsigned flags) {{
+    for (size_t i = 0; i < n; ++i) out[i] = {p}_from_double_rnd(in[i], flags);
+}}
+
+static inline void {p}_to_float_array(const {type_name}* in, float* out, size_t n) {{
+    for (size_t i = 0; i < n; ++i) out[i] = (float){p.upper()}_RAW(in[i]) * 0x1p-{n}f;
+}}
+
+static inline void {p}_to_double_array(const {type_name}* in, double* out, size_t n) {{
+    for (size_t i = 0; i < n; ++i) out[i] = (double){p.upper()}_RAW(in[i]) * 0x1p-{n};
+}}
+"""
+
+# Signed storage by width: (bits, type, unsigned type, wide type, max, min).
+# generate_opencl_kernels.py picks its storage from the same table.
+STORAGE_TYPES = [
+    (8, "int8_t", "uint8_t", "int16_t", "INT8_MAX", "INT8_MIN"),
+    (16, "int16_t", "uint16_t", "int32_t", "INT16_MAX", "INT16_MIN"),
+    (32, "int32_t", "uint32_t", "int64_t", "INT32_MAX", "INT32_MIN"),
+    (64, "int64_t", "uint64_t", "__int128_t", "INT64_MAX", "INT64_MIN"),
+]
+
+# Formats written by main(), as (m, n)
+DEFAULT_FORMATS = [
+    (15, 16),  # Q15.16 (32-bit standard "Q16.16")
+    (16, 16),  # Literal Q16.16 (33-bit -> 64-bit)
+    (0, 7),    # Q0.7 (Standard 8-bit)
+    (7, 8),    # Q8.8 (Standard 16-bit) -> m=7, n=8
+    (23, 8),   # Q24.8 (32-bit). 1 sign + 23 int + 8 frac.
+    (1, 30),   # Q2.30 (32-bit). 1 sign + 1 int + 30 frac.
+]
+
+def storage_for(total_bits):
+    """Smallest STORAGE_TYPES entry holding total_bits, or None when none does"""
+    for entry in STORAGE_TYPES:
+        if total_bits <= entry[0]:
+            return entry
+    return None
+
 def generate_header(m, n, output_dir, filename_override=None):
     total_bits = m + n + 1 # +1 for sign
     # Round up to nearest standard size
-    if total_bits <= 8:
-        storage_bits = 8
-        storage_type = "int8_t"
-        unsigned_type = "uint8_t"
-        wide_type = "int16_t"
-        storage_max = "INT8_MAX"
-        storage_min = "INT8_MIN"
-    elif total_bits <= 16:
-        storage_bits = 16
-        storage_type = "int16_t"
-        unsigned_type = "uint16_t"
-        wide_type = "int32_t"
-        storage_max = "INT16_MAX"
-        storage_min = "INT16_MIN"
-    elif total_bits <= 32:
-        storage_bits = 32
-        storage_type = "int32_t"
-        unsigned_type = "uint32_t"
-        wide_type = "int64_t"
-        storage_max = "INT32_MAX"
-        storage_min = "INT32_MIN"
-    elif total_bits <= 64:
-        storage_bits = 64
-        storage_type = "int64_t"
-        unsigned_type = "uint64_t"
-        wide_type = "__int128_t"
-        storage_max = "INT64_MAX"
-        storage_min = "INT64_MIN"
-    else:
+    storage = storage_for(total_bits)
+    if storage is None:
         print(f"Skipping Q{m}.{n}: Too large ({total_bits} bits needed)")
         return
+    storage_bits, storage_type, unsigned_type, wide_type, storage_max, storage_min = storage
 
     if filename_override:
         filename = filename_override
@@ -63,6 +112,7 @@ def generate_header(m, n, output_dir, filename_override=None):
 #ifndef {guard}
 #define {guard}
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -81,9 +131,23 @@ typedef {storage_type} {type_name};
 #define {macro_prefix}_RAW(x) (x)
 
 #define {macro_prefix}_FRAC_BITS {n}
+// Guarded: the qM_N_math.h headers define the same constants
+#ifndef {macro_prefix}_ONE
 #define {macro_prefix}_ONE {macro_prefix}_WRAP({one_val})
+#endif
+#ifndef {macro_prefix}_MAX
 #define {macro_prefix}_MAX {macro_prefix}_WRAP({storage_max})
+#endif
+#ifndef {macro_prefix}_MIN
 #define {macro_prefix}_MIN {macro_prefix}_WRAP({storage_min})
+#endif
+
+#ifndef LIBFIXP_CVT_FLAGS
+#define LIBFIXP_CVT_FLAGS
+/* Flags for the *_from_float_array / *_from_double_array converters */
+#define LIBFIXP_CVT_SATURATE 1u      /* clamp out-of-range inputs, NaN -> 0 */
+#define LIBFIXP_CVT_NEAREST_EVEN 2u  /* round ties to even instead of away from zero */
+#endif
 
 static inline {type_name} q{m}_{n}_add({type_name} a, {type_name} b) {{
     // Use unsigned arithmetic to avoid signed overflow UB
@@ -112,7 +176,7 @@ static inline {type_name} q{m}_{n}_from_double(double d) {{
 static inline double q{m}_{n}_to_double({type_name} a) {{
     return (double)a / {float(1<<n)};
 }}
-
+{array_converters(m, n, type_name, storage_type, storage_max, storage_min)}
 #ifdef __cplusplus
 }}
 #endif
@@ -127,23 +191,8 @@ def main():
     output_dir = "include/fixp/gen"
     os.makedirs(output_dir, exist_ok=True)
 
-    # Q15.16 (32-bit standard "Q16.16")
-    generate_header(15, 16, output_dir)
-
-    # Literal Q16.16 (33-bit -> 64-bit)
-    generate_header(16, 16, output_dir)
-
-    # Q0.7 (Standard 8-bit)
-    generate_header(0, 7, output_dir)
-
-    # Q8.8 (Standard 16-bit) -> m=7, n=8
-    generate_header(7, 8, output_dir)
-
-    # Q24.8 (32-bit). 1 sign + 23 int + 8 frac.
-    generate_header(23, 8, output_dir)
-
-    # Q2.30 (32-bit). 1 sign + 1 int + 30 frac.
-    generate_header(1, 30, output_dir)
+    for m, n in DEFAULT_FORMATS:
+        generate_header(m, n, output_dir)
 
     print(f"Generated key headers in {output_dir}")
 
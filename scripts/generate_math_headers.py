@@ -1,30 +1,151 @@
 #!/usr/bin/env python3
 """
-Generate C23 fixed-point math function headers.
+Generate C23 fixed-point math headers and implementations.
 Clean-room implementation generating wrappers around core algorithms.
+
+Each Qm.n format gets its own CORDIC tables, iteration count and polynomial
+degrees, sized from n and the storage width, so narrow formats run short
+kernels and wide ones keep full precision. The polynomials work in Q30 for
+formats up to 32 bits and Q61 for 64-bit ones; CORDIC runs in Q30, or in Q40
+on 64-bit integers once n leaves fewer than 8 guard bits. Every result is
+rounded once into the destination format.
+
+Usage: generate_math_headers.py [--output-dir DIR] [M.N ...]
 """
 
-import sys
+import argparse
+import math
+from decimal import Decimal, getcontext
 from pathlib import Path
 
+getcontext().prec = 60
+
+# Constants are computed in Decimal: 61-bit working scales outrun double precision
+PI = Decimal("3.14159265358979323846264338327950288419716939937510582097494")
+LN2 = Decimal(2).ln()
+
+
+def fixed(value, frac_bits):
+    """round(value * 2^frac_bits) for a Decimal value"""
+    return int((value * (1 << frac_bits)).to_integral_value())
+
+
+def atan_decimal(x):
+    """arctan for 0 < x <= 1/2 by its Taylor series"""
+    term, total, k = x, Decimal(0), 0
+    while abs(term) > Decimal(10) ** -58:
+        total += term / (2 * k + 1)
+        term *= -x * x
+        k += 1
+    return total
+
+
+DEFAULT_FORMATS = [
+    (15, 16),  # Q15.16 (32-bit)
+    (8, 8),    # Q8.8 (32-bit: 17 bits needed)
+    (7, 8),    # Q7.8 (16-bit)
+    (0, 7),    # Q0.7 (8-bit)
+    (0, 15),   # Q0.15 (16-bit)
+    (23, 8),   # Q23.8 (32-bit, "Q24.8")
+    (1, 30),   # Q1.30 (32-bit, "Q2.30")
+    (31, 0),   # Q31.0 (32-bit integer)
+]
+
+
+class Format:
+    """Storage and working-precision parameters for one Qm.n format"""
+
+    def __init__(self, m_bits, n_bits):
+        self.m = m_bits
+        self.n = n_bits
+        self.total_bits = m_bits + n_bits + 1  # +1 for sign bit
+        self.prefix = f"q{m_bits}_{n_bits}"
+        self.macro = f"Q{m_bits}_{n_bits}"
+        self.type_name = f"{self.prefix}_t"
+
+        for bits in (8, 16, 32, 64):
+            if self.total_bits <= bits:
+                self.storage_bits = bits
+                break
+        else:
+            raise ValueError(f"Total bits {self.total_bits} exceeds 64")
+        self.base_type = f"int{self.storage_bits}_t"
+
+        if self.storage_bits <= 32:
+            self.work_frac = 30
+            self.wide_bits = 64
+            if n_bits <= 22:
+                self.cordic_frac, self.cordic_type = 30, "int32_t"
+            else:
+                self.cordic_frac, self.cordic_type = 40, "int64_t"
+        else:
+            self.work_frac = 61
+            self.wide_bits = 128
+            self.cordic_frac, self.cordic_type = 61, "int64_t"
+        if n_bits > self.work_frac + 1:
+            raise ValueError(f"Fractional bits {n_bits} exceed {self.work_frac + 1}")
+
+    def literal(self, value):
+        """Integer literal that keeps its value in a 64-bit context"""
+        if -(1 << 31) <= value < (1 << 31):
+            return str(value)
+        return f"INT64_C({value})"
+
+    def fits(self, value):
+        return -(1 << (self.total_bits - 1)) <= value < (1 << (self.total_bits - 1))
+
+
 def generate_math_header(m_bits, n_bits):
     """Generate math functions for Qm.n format"""
-    total_bits = m_bits + n_bits + 1  # +1 for sign bit
-    type_name = f"q{m_bits}_{n_bits}_t"
-    
-    if total_bits <= 8:
-        base_type = "int8_t"
-    elif total_bits <= 16:
-        base_type = "int16_t"
-    elif total_bits <= 32:
-        base_type = "int32_t"
-    elif total_bits <= 64:
-        base_type = "int64_t"
+    fmt = Format(m_bits, n_bits)
+    p, M, T, n = fmt.prefix, fmt.macro, fmt.type_name, fmt.n
+
+    constants = []
+    for name, value in (("PI", PI), ("E", Decimal(1).exp()), ("ONE", Decimal(1)),
+                        ("HALF", Decimal("0.5"))):
+        raw = fixed(value, n)
+        if fmt.fits(raw) and raw != 0:
+            constants.append(f"#ifndef {M}_{name}\n"
+                             f"#define {M}_{name:<8}(({T}){fmt.literal(raw)})\n"
+                             f"#endif")
+    for name in ("MAX", "MIN"):
+        constants.append(f"#ifndef {M}_{name}\n"
+                         f"#define {M}_{name:<8}(({T})INT{fmt.storage_bits}_{name})\n"
+                         f"#endif")
+    constants = "\n".join(constants)
+
+    if n == 0:
+        rounding = f"""static inline {T} {p}_floor({T} x) {{ return x; }}
+static inline {T} {p}_ceil({T} x) {{ return x; }}
+static inline {T} {p}_round({T} x) {{ return x; }}
+static inline {T} {p}_trunc({T} x) {{ return x; }}"""
     else:
-        raise ValueError(f"Total bits {total_bits} exceeds 64")
-    
-    header = f"""#ifndef FIXP_Q{m_bits}_{n_bits}_MATH_H
-#define FIXP_Q{m_bits}_{n_bits}_MATH_H
+        mask = fmt.literal((1 << n) - 1)
+        half = fmt.literal(1 << (n - 1))
+        one = fmt.literal(1 << n)
+        rounding = f"""static inline {T} {p}_floor({T} x) {{
+    return ({T})(x & ~({T}){mask});
+}}
+
+static inline {T} {p}_ceil({T} x) {{
+    if (x > ({T})({M}_MAX - {mask})) return {M}_MAX;
+    return ({T})((x + {mask}) & ~({T}){mask});
+}}
+
+// Ties away from zero
+static inline {T} {p}_round({T} x) {{
+    if (x > ({T})({M}_MAX - {half})) return {M}_MAX;
+    {T} r = ({T})((x + {half}) & ~({T}){mask});
+    if (x < 0 && (x & {mask}) == {half}) r = ({T})(r - {one});
+    return r;
+}}
+
+static inline {T} {p}_trunc({T} x) {{
+    return (x < 0) ? ({T})((x + {mask}) & ~({T}){mask}) : ({T})(x & ~({T}){mask});
+}}"""
+
+    header = f"""#ifndef FIXP_{M}_MATH_H
+#define FIXP_{M}_MATH_H
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -33,381 +154,539 @@ def generate_math_header(m_bits, n_bits):
 extern "C" {{
 #endif
 
-// Q{m_bits}.{n_bits} format: {total_bits}-bit signed fixed-point
+// Q{m_bits}.{n_bits} format: {fmt.total_bits}-bit signed fixed-point in {fmt.base_type}
 // {m_bits} integer bits, {n_bits} fractional bits
-typedef {base_type} {type_name};
+typedef {fmt.base_type} {T};
 
-// Constants
-#define Q{m_bits}_{n_bits}_PI       (({type_name})(3.14159265358979323846 * (1LL << {n_bits})))
-#define Q{m_bits}_{n_bits}_E        (({type_name})(2.71828182845904523536 * (1LL << {n_bits})))
-#define Q{m_bits}_{n_bits}_ONE      (({type_name})(1LL << {n_bits}))
-#define Q{m_bits}_{n_bits}_HALF     (({type_name})(1LL << ({n_bits} - 1)))
-#define Q{m_bits}_{n_bits}_MAX      (({type_name})((1LL << ({total_bits} - 1)) - 1))
-#define Q{m_bits}_{n_bits}_MIN      (({type_name})(-(1LL << ({total_bits} - 1))))
+// Constants (those the format cannot represent are omitted)
+{constants}
 
 // Basic operations
-static inline {type_name} q{m_bits}_{n_bits}_abs({type_name} x) {{
-    return (x < 0) ? -x : x;
+static inline {T} {p}_abs({T} x) {{
+    if (x == {M}_MIN) return {M}_MAX;
+    return (x < 0) ? ({T})-x : x;
 }}
 
-static inline {type_name} q{m_bits}_{n_bits}_min({type_name} a, {type_name} b) {{
+static inline {T} {p}_min({T} a, {T} b) {{
     return (a < b) ? a : b;
 }}
 
-static inline {type_name} q{m_bits}_{n_bits}_max({type_name} a, {type_name} b) {{
+static inline {T} {p}_max({T} a, {T} b) {{
     return (a > b) ? a : b;
 }}
 
-static inline {type_name} q{m_bits}_{n_bits}_clamp({type_name} x, {type_name} lo, {type_name} hi) {{
-    return q{m_bits}_{n_bits}_min(q{m_bits}_{n_bits}_max(x, lo), hi);
-}}
-
-// Rounding functions
-static inline {type_name} q{m_bits}_{n_bits}_floor({type_name} x) {{
-    const {type_name} frac_mask = Q{m_bits}_{n_bits}_ONE - 1;
-    if (x >= 0) {{
-        return x & ~frac_mask;
-    }} else {{
-        return (x & frac_mask) ? ((x & ~frac_mask) - Q{m_bits}_{n_bits}_ONE) : x;
-    }}
-}}
-
-static inline {type_name} q{m_bits}_{n_bits}_ceil({type_name} x) {{
-    const {type_name} frac_mask = Q{m_bits}_{n_bits}_ONE - 1;
-    if (x >= 0) {{
-        return (x & frac_mask) ? ((x & ~frac_mask) + Q{m_bits}_{n_bits}_ONE) : x;
-    }} else {{
-        return x & ~frac_mask;
-    }}
-}}
-
-static inline {type_name} q{m_bits}_{n_bits}_round({type_name} x) {{
-    if (x >= 0) {{
-        return (x + Q{m_bits}_{n_bits}_HALF) & ~(Q{m_bits}_{n_bits}_ONE - 1);
-    }} else {{
-        return (x - Q{m_bits}_{n_bits}_HALF) & ~(Q{m_bits}_{n_bits}_ONE - 1);
-    }}
+static inline {T} {p}_clamp({T} x, {T} lo, {T} hi) {{
+    return {p}_min({p}_max(x, lo), hi);
 }}
 
-static inline {type_name} q{m_bits}_{n_bits}_trunc({type_name} x) {{
-    return x & ~(Q{m_bits}_{n_bits}_ONE - 1);
-}}
+// Rounding functions (saturate where the result is out of range)
+{rounding}
 
-// Square root (Newton-Raphson)
-{type_name} q{m_bits}_{n_bits}_sqrt({type_name} x);
+// Square root (exact digit-by-digit, rounded to nearest)
+{T} {p}_sqrt({T} x);
 
-// Trigonometric functions (CORDIC-based)
-{type_name} q{m_bits}_{n_bits}_sin({type_name} angle);
-{type_name} q{m_bits}_{n_bits}_cos({type_name} angle);
-{type_name} q{m_bits}_{n_bits}_tan({type_name} angle);
-{type_name} q{m_bits}_{n_bits}_atan({type_name} x);
-{type_name} q{m_bits}_{n_bits}_atan2({type_name} y, {type_name} x);
+// Trigonometric functions (CORDIC-based, constant-time range reduction)
+void {p}_sincos({T} angle, {T}* sin_out, {T}* cos_out);
+{T} {p}_sin({T} angle);
+{T} {p}_cos({T} angle);
+{T} {p}_tan({T} angle);
+{T} {p}_atan({T} x);
+{T} {p}_atan2({T} y, {T} x);
 
-// Exponential and logarithmic
-{type_name} q{m_bits}_{n_bits}_exp({type_name} x);
-{type_name} q{m_bits}_{n_bits}_log({type_name} x);
-{type_name} q{m_bits}_{n_bits}_exp2({type_name} x);
-{type_name} q{m_bits}_{n_bits}_log2({type_name} x);
-{type_name} q{m_bits}_{n_bits}_pow({type_name} base, {type_name} exponent);
+// Exponential and logarithmic (polynomial, saturating; log of x <= 0 is MIN)
+{T} {p}_exp({T} x);
+{T} {p}_log({T} x);
+{T} {p}_exp2({T} x);
+{T} {p}_log2({T} x);
+{T} {p}_pow({T} base, {T} exponent);
 
 #ifdef __cplusplus
 }}
 #endif
 
-#endif // FIXP_Q{m_bits}_{n_bits}_MATH_H
+#endif // FIXP_{M}_MATH_H
 """
     return header
 
-def generate_cordic_tables(n_bits):
-    """Generate CORDIC tables for given fractional bits"""
-    import math
-    
-    k = 0.60725293500888  # CORDIC gain
-    k_fixed = int(k * (1 << n_bits))
-    
-    atan_table = []
-    for i in range(min(n_bits, 32)):
-        atan_val = math.atan(2.0 ** -i)
-        atan_fixed = int(atan_val * (1 << n_bits))
-        atan_table.append(atan_fixed)
-    
-    return k_fixed, atan_table
+
+def cordic_iterations(fmt):
+    """Rotations needed to bring the residual angle below half an output LSB"""
+    return max(2, min(fmt.cordic_frac, fmt.n + 3))
+
+
+def generate_cordic_tables(fmt):
+    """arctan(2^-i) table and 1/gain for the format's iteration count, in the working scale"""
+    iterations = cordic_iterations(fmt)
+    angles = [PI / 4] + [atan_decimal(Decimal(2) ** -i) for i in range(1, iterations)]
+    gain = Decimal(1)
+    for i in range(iterations):
+        gain *= (1 + Decimal(4) ** -i).sqrt()
+    return fixed(1 / gain, fmt.cordic_frac), [fixed(a, fmt.cordic_frac) for a in angles]
+
+
+def fit_polynomial(func, lo, hi, target_bits, work_frac, max_degree=24):
+    """
+    Lowest-degree Chebyshev interpolant of func on [lo, hi] whose error, with
+    coefficients rounded to work_frac bits, stays below 2^-target_bits.
+    The constant term is pinned to func(0), so exp2(0) and log2(1) are exact.
+    Returns (integer coefficients, lowest order first; max error).
+    """
+    lo, hi = Decimal(lo), Decimal(hi)
+    c0 = func(Decimal(0))
+    samples = [lo + (hi - lo) * Decimal(k) / 1024 for k in range(1025)]
+    exact = [func(x) for x in samples]
+    scale = Decimal(1 << work_frac)
+    best = None
+    for degree in range(1, max_degree + 1):
+        # Interpolate (func(x) - c0) / x with degree - 1 at Chebyshev nodes
+        size = degree
+        nodes = [(lo + hi) / 2 + (hi - lo) / 2 *
+                 Decimal(math.cos(math.pi * (2 * k + 1) / (2 * size)))
+                 for k in range(size)]
+        # Vandermonde solve by Gaussian elimination with partial pivoting
+        rows = [[x ** j for j in range(size)] + [(func(x) - c0) / x] for x in nodes]
+        for col in range(size):
+            pivot = max(range(col, size), key=lambda r: abs(rows[r][col]))
+            rows[col], rows[pivot] = rows[pivot], rows[col]
+            for r in range(size):
+                if r != col:
+                    f = rows[r][col] / rows[col][col]
+                    rows[r] = [a - f * b for a, b in zip(rows[r], rows[col])]
+        coeffs = [int((c0 * scale).to_integral_value())]
+        coeffs += [int((rows[j][size] / rows[j][j] * scale).to_integral_value())
+                   for j in range(size)]
+        error = Decimal(0)
+        for x, y in zip(samples, exact):
+            acc = Decimal(0)
+            for c in reversed(coeffs):
+                acc = acc * x + Decimal(c) / scale
+            error = max(error, abs(acc - y))
+        best = (coeffs, float(error))
+        if error < Decimal(2) ** -target_bits:
+            break
+    return best
+
+
+def exp2_func(x):
+    return (x * LN2).exp()
+
+
+def log2_func(t):
+    return (1 + t).ln() / LN2
+
+
+def generate_reduction_code(fmt):
+    """Body of reduce_angle: quadrant and the residual angle in Q(cordic_frac)"""
+    n, C = fmt.n, fmt.cordic_frac
+    if fmt.storage_bits <= 32:
+        # 2^(64-n) / (2*pi): the 64-bit product wraps modulo whole turns
+        k = fixed(1 / (2 * PI), 64 - n)
+        z = shift_expr(f"r * {fixed(PI / 2, 30)}", C - 62)
+        return f"""// Phase in 2^-64 turns
+    uint64_t phase = (uint64_t)(int64_t)angle * UINT64_C({k:#x});
+    uint64_t q = (phase + (UINT64_C(1) << 61)) >> 62;
+    int64_t r = (int64_t)(phase - (q << 62)) >> 30;  // 2^-34 turns
+    *quadrant = (uint32_t)q & 3u;
+    return (cordic_t)({z});"""
+    # 2^128 / (2*pi) split over two words keeps the phase exact for any 64-bit angle
+    k = fixed(1 / (2 * PI), 128)
+    k_hi, k_lo = k >> 64, k & ((1 << 64) - 1)
+    product = (f"(wide_t)angle * (wide_t)UINT64_C({k_hi:#x}) + "
+               f"(((wide_t)angle * (wide_t)UINT64_C({k_lo:#x})) >> 64)")
+    phase = f"({product}) >> {n}" if n else product
+    z = shift_expr(f"(wide_t)r * {fmt.literal(fixed(PI / 2, 62))}", C - 62 - 62)
+    return f"""// Phase in 2^-64 turns
+    uint64_t phase = (uint64_t)({phase});
+    uint64_t q = (phase + (UINT64_C(1) << 61)) >> 62;
+    int64_t r = (int64_t)(phase - (q << 62));
+    *quadrant = (uint32_t)q & 3u;
+    return (cordic_t)({z});"""
+
+
+def shift_expr(expr, shift):
+    """expr * 2^shift, rounding to nearest when shifting right"""
+    if shift > 0:
+        return f"({expr}) * ((wide_t)1 << {shift})"
+    if shift < 0:
+        return f"(({expr}) + ((wide_t)1 << {-shift - 1})) >> {-shift}"
+    return expr
+
+
+def table(values, per_line=4):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append(", ".join(values[i:i + per_line]))
+    return ",\n    ".join(lines)
+
 
 def generate_cordic_c_file(m_bits, n_bits):
-    """Generate C implementation file with CORDIC algorithms"""
-    total_bits = m_bits + n_bits + 1
-    type_name = f"q{m_bits}_{n_bits}_t"
-    
-    if total_bits <= 8:
-        base_type = "int8_t"
-    elif total_bits <= 16:
-        base_type = "int16_t"
-    elif total_bits <= 32:
-        base_type = "int32_t"
-    elif total_bits <= 64:
-        base_type = "int64_t"
+    """Generate C implementation file with CORDIC and polynomial kernels"""
+    fmt = Format(m_bits, n_bits)
+    p, M, T, n = fmt.prefix, fmt.macro, fmt.type_name, fmt.n
+    W, C, S = fmt.work_frac, fmt.cordic_frac, fmt.storage_bits
+    lit = fmt.literal
+
+    iterations = cordic_iterations(fmt)
+    gain_inv, atan_table = generate_cordic_tables(fmt)
+    reduction_code = generate_reduction_code(fmt)
+
+    # exp2 feeds results up to the full storage width, so it needs relative
+    # precision; log2 only needs to resolve the output LSB
+    exp2_bits = min(W, S - 1) + 1
+    log2_bits = min(W, n + 2)
+    exp2_poly, exp2_err = fit_polynomial(exp2_func, 0, 1, exp2_bits, W)
+    log2_poly, log2_err = fit_polynomial(log2_func, math.sqrt(0.5) - 1, math.sqrt(2) - 1,
+                                         log2_bits, W)
+
+    sqrt2_w = fixed(Decimal(2).sqrt(), W)
+    ln2_w = fixed(LN2, W)
+    # log2(e) carried to 2W bits so x * log2(e) keeps the precision exp needs
+    log2e_hi = fixed(1 / LN2, W)
+    log2e_lo = fixed(1 / LN2 * (1 << W) - log2e_hi, W)
+    pi_c = fixed(PI, C)
+
+    if fmt.wide_bits == 64:
+        types = f"""typedef {fmt.cordic_type} cordic_t;
+typedef int64_t wide_t;
+typedef uint64_t uwide_t;"""
+    else:
+        types = """typedef int64_t cordic_t;
+__extension__ typedef __int128 wide_t;
+__extension__ typedef unsigned __int128 uwide_t;"""
+
+    if C + n < fmt.wide_bits - 1:
+        tan_code = f"""if (c == 0) return (s >= 0) ? {M}_MAX : {M}_MIN;
+    return saturate((wide_t)s * ((wide_t)1 << {n}) / c);"""
+    else:
+        # s * 2^n would overflow: divide at Q30
+        tan_code = f"""wide_t s30 = {shift_expr("(wide_t)s", 30 - C)};
+    wide_t c30 = {shift_expr("(wide_t)c", 30 - C)};
+    if (c30 == 0) return (s30 >= 0) ? {M}_MAX : {M}_MIN;
+    return saturate(s30 * ((wide_t)1 << {n}) / c30);"""
+    # Fraction of a Qn value into the working scale, truncated so it stays below one
+    if n <= W:
+        exp2_frac = f"(wide_t)(x & {lit((1 << n) - 1)}) * ((wide_t)1 << {W - n})" if n else "0"
+    else:
+        exp2_frac = f"(wide_t)(x & {lit((1 << n) - 1)}) >> {n - W}"
+    exp2_int = f"(wide_t)x >> {n}" if n else "(wide_t)x"
+
+    # pow: drop guard bits from log2 so log2(base) * exponent fits the wide type
+    log_bits = W + max(1, math.ceil(math.log2(S))) + 1
+    pow_guard = max(0, log_bits + S - 1 - (fmt.wide_bits - 1))
+
+    def frac_to_work(frac_bits, var):
+        # Truncating extraction of the fraction of `var` (frac_bits) into Q(W)
+        mask = f"(((wide_t)1 << {frac_bits}) - 1)"
+        if frac_bits >= W:
+            return f"({var} & {mask}) >> {frac_bits - W}"
+        return f"({var} & {mask}) * ((wide_t)1 << {W - frac_bits})"
+
+    if fmt.wide_bits == 64:
+        sqrt_top = 62
     else:
-        raise ValueError(f"Total bits {total_bits} exceeds 64")
-    
-    k_fixed, atan_table = generate_cordic_tables(n_bits)
-    
-    atan_table_str = ",\n    ".join(str(x) for x in atan_table)
-    
-    impl = f"""#include "q{m_bits}_{n_bits}_math.h"
+        sqrt_top = 126
+
+    impl = f"""#include "{p}_math.h"
 #include <stdint.h>
 
-// CORDIC constants
-#define CORDIC_K_{n_bits} (({type_name}){k_fixed})
-#define CORDIC_ITERATIONS {min(n_bits, 16)}
+// Polynomials in Q{W}, CORDIC in Q{C} ({fmt.cordic_type}), products in {fmt.wide_bits}-bit integers
+{types}
+#define WORK_FRAC {W}
+#define WORK_ONE ((wide_t)1 << WORK_FRAC)
+#define CORDIC_FRAC {C}
+
+static {T} saturate(wide_t v) {{
+    if (v > {M}_MAX) return {M}_MAX;
+    if (v < {M}_MIN) return {M}_MIN;
+    return ({T})v;
+}}
+
+// Q{W} to Q{n}, rounded to nearest and saturated
+static {T} from_work(wide_t v) {{
+    return saturate({shift_expr("v", n - W)});
+}}
+
+// Q{C} to Q{n}, rounded to nearest and saturated
+static {T} from_cordic(wide_t v) {{
+    return saturate({shift_expr("v", n - C)});
+}}
+
+// Index of the highest set bit; v must be non-zero
+static int msb(uint64_t v) {{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int r = 0;
+    while (v >>= 1) r++;
+    return r;
+#endif
+}}
+
+// CORDIC constants: {iterations} rotations resolve the Q{n} LSB
+#define CORDIC_ITERATIONS {iterations}
+#define CORDIC_K ((cordic_t){lit(gain_inv)})
 
-static const {type_name} cordic_atan_table[CORDIC_ITERATIONS] = {{
-    {atan_table_str}
+static const cordic_t cordic_atan_table[CORDIC_ITERATIONS] = {{
+    {table([lit(v) for v in atan_table])}
 }};
 
-// CORDIC rotation mode
-static void cordic_rotate({type_name}* x, {type_name}* y, {type_name} z) {{
-    {type_name} x_val = CORDIC_K_{n_bits};
-    {type_name} y_val = 0;
-    
+// CORDIC rotation mode: (K, 0) rotated by z, |z| <= pi/4
+static void cordic_rotate(cordic_t z, cordic_t* x, cordic_t* y) {{
+    cordic_t x_val = CORDIC_K;
+    cordic_t y_val = 0;
+
     for (int i = 0; i < CORDIC_ITERATIONS; i++) {{
-        {type_name} x_new, y_new, z_new;
-        
+        cordic_t x_new, y_new;
         if (z >= 0) {{
             x_new = x_val - (y_val >> i);
             y_new = y_val + (x_val >> i);
-            z_new = z - cordic_atan_table[i];
+            z -= cordic_atan_table[i];
         }} else {{
             x_new = x_val + (y_val >> i);
             y_new = y_val - (x_val >> i);
-            z_new = z + cordic_atan_table[i];
+            z += cordic_atan_table[i];
         }}
-        
         x_val = x_new;
         y_val = y_new;
-        z = z_new;
     }}
-    
+
     *x = x_val;
     *y = y_val;
 }}
 
-// CORDIC vectoring mode
-static {type_name} cordic_vector({type_name} x, {type_name} y) {{
-    {type_name} z = 0;
-    
+// CORDIC vectoring mode: angle of (x, y) for x >= 0, |x|, |y| < 2^(CORDIC_FRAC - 1)
+static cordic_t cordic_vector(cordic_t x, cordic_t y) {{
+    cordic_t z = 0;
+
     for (int i = 0; i < CORDIC_ITERATIONS; i++) {{
-        {type_name} x_new, y_new, z_new;
-        
+        cordic_t x_new, y_new;
         if (y < 0) {{
             x_new = x - (y >> i);
             y_new = y + (x >> i);
-            z_new = z - cordic_atan_table[i];
+            z -= cordic_atan_table[i];
         }} else {{
             x_new = x + (y >> i);
             y_new = y - (x >> i);
-            z_new = z + cordic_atan_table[i];
+            z += cordic_atan_table[i];
         }}
-        
         x = x_new;
         y = y_new;
-        z = z_new;
     }}
-    
+
     return z;
 }}
 
-{type_name} q{m_bits}_{n_bits}_sin({type_name} angle) {{
-    // Range reduction to [-π, π]
-    while (angle > Q{m_bits}_{n_bits}_PI) angle -= 2 * Q{m_bits}_{n_bits}_PI;
-    while (angle < -Q{m_bits}_{n_bits}_PI) angle += 2 * Q{m_bits}_{n_bits}_PI;
-    
-    {type_name} x, y;
-    bool negate = false;
-    
-    if (angle < 0) {{
-        angle = -angle;
-        negate = true;
-    }}
-    
-    cordic_rotate(&x, &y, angle);
-    
-    return negate ? -y : y;
-}}
-
-{type_name} q{m_bits}_{n_bits}_cos({type_name} angle) {{
-    // Range reduction to [-π, π]
-    while (angle > Q{m_bits}_{n_bits}_PI) angle -= 2 * Q{m_bits}_{n_bits}_PI;
-    while (angle < -Q{m_bits}_{n_bits}_PI) angle += 2 * Q{m_bits}_{n_bits}_PI;
-    
-    {type_name} x, y;
-    
-    if (angle < 0) {{
-        angle = -angle;
-    }}
-    
-    cordic_rotate(&x, &y, angle);
-    
-    return x;
+// Constant-time range reduction: angle = quadrant * pi/2 + z with |z| <= pi/4.
+// Multiplying by 1/(2*pi) gives a 64-bit phase that wraps modulo one turn.
+static cordic_t reduce_angle({T} angle, uint32_t* quadrant) {{
+    {reduction_code}
 }}
 
-{type_name} q{m_bits}_{n_bits}_tan({type_name} angle) {{
-    {type_name} s = q{m_bits}_{n_bits}_sin(angle);
-    {type_name} c = q{m_bits}_{n_bits}_cos(angle);
-    
-    if (c == 0) return Q{m_bits}_{n_bits}_MAX;
-    
-    // Division: (s << n_bits) / c
-    return (({base_type})s << {n_bits}) / c;
+static void sincos_cordic({T} angle, cordic_t* s, cordic_t* c) {{
+    uint32_t quadrant;
+    cordic_t x, y;
+    cordic_rotate(reduce_angle(angle, &quadrant), &x, &y);
+
+    switch (quadrant) {{
+        case 0:  *s = y;  *c = x;  break;
+        case 1:  *s = x;  *c = -y; break;
+        case 2:  *s = -y; *c = -x; break;
+        default: *s = -x; *c = y;  break;
+    }}
 }}
 
-{type_name} q{m_bits}_{n_bits}_atan2({type_name} y, {type_name} x) {{
+// atan2 in Q{C} for arbitrary-magnitude inputs
+static wide_t atan2_cordic(wide_t y, wide_t x) {{
     if (x == 0 && y == 0) return 0;
-    
-    {type_name} result = cordic_vector(x, y);
-    
-    // Quadrant adjustment
+
+    // Fold the left half-plane onto the right: atan2(y, x) = atan2(-y, -x) +- pi
+    wide_t offset = 0;
     if (x < 0) {{
-        if (y >= 0) {{
-            result = Q{m_bits}_{n_bits}_PI - result;
-        }} else {{
-            result = -Q{m_bits}_{n_bits}_PI + result;
-        }}
+        offset = (y >= 0) ? {lit(pi_c)} : -{lit(pi_c)};
+        x = -x;
+        y = -y;
+    }}
+
+    // Normalize so the larger component sits just below 2^(CORDIC_FRAC - 1)
+    uint64_t ax = (uint64_t)x;
+    uint64_t ay = (uint64_t)(y < 0 ? -y : y);
+    int shift = (CORDIC_FRAC - 2) - msb(ax > ay ? ax : ay);
+    if (shift >= 0) {{
+        x *= (wide_t)1 << shift;
+        y *= (wide_t)1 << shift;
+    }} else {{
+        x >>= -shift;
+        y >>= -shift;
     }}
-    
-    return result;
+
+    return (wide_t)cordic_vector((cordic_t)x, (cordic_t)y) + offset;
+}}
+
+void {p}_sincos({T} angle, {T}* sin_out, {T}* cos_out) {{
+    cordic_t s, c;
+    sincos_cordic(angle, &s, &c);
+
+    if (sin_out) *sin_out = from_cordic(s);
+    if (cos_out) *cos_out = from_cordic(c);
+}}
+
+{T} {p}_sin({T} angle) {{
+    {T} s;
+    {p}_sincos(angle, &s, 0);
+    return s;
+}}
+
+{T} {p}_cos({T} angle) {{
+    {T} c;
+    {p}_sincos(angle, 0, &c);
+    return c;
+}}
+
+{T} {p}_tan({T} angle) {{
+    cordic_t s, c;
+    sincos_cordic(angle, &s, &c);
+
+    {tan_code}
 }}
 
-{type_name} q{m_bits}_{n_bits}_atan({type_name} x) {{
-    return q{m_bits}_{n_bits}_atan2(x, Q{m_bits}_{n_bits}_ONE);
+{T} {p}_atan2({T} y, {T} x) {{
+    return from_cordic(atan2_cordic(y, x));
 }}
 
-{type_name} q{m_bits}_{n_bits}_sqrt({type_name} x) {{
+{T} {p}_atan({T} x) {{
+    return from_cordic(atan2_cordic(x, (wide_t)1 << {n}));
+}}
+
+{T} {p}_sqrt({T} x) {{
     if (x <= 0) return 0;
-    
-    // Find highest bit
-    {type_name} bit = 1;
-    {type_name} val = x;
-    while (val > 0) {{
-        val >>= 1;
-        bit <<= 1;
-    }}
-    
-    // Initial guess
-    {type_name} guess = bit >> 1;
-    if (guess < Q{m_bits}_{n_bits}_ONE) guess = Q{m_bits}_{n_bits}_ONE;
-    
-    // Newton-Raphson iterations
-    for (int i = 0; i < 4; i++) {{
-        {type_name} div = (({base_type})x << {n_bits}) / guess;
-        guess = (guess + div) >> 1;
+
+    // isqrt(x * 2^{n}), one result bit per step
+    uwide_t v = (uwide_t)x << {n};
+    uwide_t r = 0;
+    uwide_t bit = (uwide_t)1 << {sqrt_top};
+    while (bit > v) bit >>= 2;
+    while (bit != 0) {{
+        if (v >= r + bit) {{
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        }} else {{
+            r >>= 1;
+        }}
+        bit >>= 2;
     }}
-    
-    return guess;
-}}
-
-{type_name} q{m_bits}_{n_bits}_exp2({type_name} x) {{
-    // Extract integer part
-    int int_part = x >> {n_bits};
-    {type_name} frac_part = x & (Q{m_bits}_{n_bits}_ONE - 1);
-    
-    // Check overflow
-    if (int_part >= {m_bits}) return Q{m_bits}_{n_bits}_MAX;
-    if (int_part < -{n_bits}) return 0;
-    
-    // Compute 2^int_part
-    {type_name} int_result = Q{m_bits}_{n_bits}_ONE << int_part;
-    
-    // Approximate 2^frac using polynomial
-    // 2^x ≈ 1 + x*ln(2) + (x*ln(2))^2/2
-    {type_name} ln2 = ({type_name})(0.693147 * (1LL << {n_bits}));
-    {type_name} term = (({base_type})frac_part * ln2) >> {n_bits};
-    {type_name} result = Q{m_bits}_{n_bits}_ONE + term;
-    term = (({base_type})term * term) >> ({n_bits} + 1);
-    result += term;
-    
-    return (({base_type})int_result * result) >> {n_bits};
-}}
-
-{type_name} q{m_bits}_{n_bits}_exp({type_name} x) {{
-    // e^x = 2^(x * log2(e))
-    {type_name} log2e = ({type_name})(1.442695 * (1LL << {n_bits}));
-    {type_name} scaled = (({base_type})x * log2e) >> {n_bits};
-    return q{m_bits}_{n_bits}_exp2(scaled);
-}}
-
-{type_name} q{m_bits}_{n_bits}_log2({type_name} x) {{
-    if (x <= 0) return Q{m_bits}_{n_bits}_MIN;
-    
-    // Find highest bit
-    int bit_pos = 0;
-    {type_name} val = x;
-    while (val > 0) {{
-        val >>= 1;
-        bit_pos++;
+    // Remainder above r means x * 2^{n} > (r + 1/2)^2
+    if (v > r) r++;
+
+    return saturate((wide_t)r);
+}}
+
+// 2^f on [0, 1], degree {len(exp2_poly) - 1}, max error {exp2_err:.2e}
+static const int64_t exp2_poly[] = {{
+    {table([lit(c) for c in exp2_poly])}
+}};
+
+// log2(1 + t) on [sqrt(1/2) - 1, sqrt(2) - 1], degree {len(log2_poly) - 1}, max error {log2_err:.2e}
+static const int64_t log2_poly[] = {{
+    {table([lit(c) for c in log2_poly])}
+}};
+
+static wide_t horner(const int64_t* c, int degree, wide_t t) {{
+    wide_t acc = c[degree];
+    for (int i = degree - 1; i >= 0; i--) {{
+        acc = ((acc * t + (WORK_ONE >> 1)) >> WORK_FRAC) + c[i];
     }}
-    bit_pos--;
-    
-    int int_part = bit_pos - {n_bits};
-    
-    // Normalize to [1, 2)
-    {type_name} normalized;
-    if (bit_pos >= {n_bits}) {{
-        normalized = x >> (bit_pos - {n_bits});
-    }} else {{
-        normalized = x << ({n_bits} - bit_pos);
+    return acc;
+}}
+
+// 2^(k + f) in Q{n}, f in [0, 1) in the working scale
+static {T} exp2_split(wide_t k, wide_t f) {{
+    wide_t p = horner(exp2_poly, {len(exp2_poly) - 1}, f);
+    wide_t s = k + ({n} - WORK_FRAC);
+    if (s > {S - 2 - W}) return {M}_MAX;
+    if (s >= 0) return saturate(p << s);
+    if (s < -{fmt.wide_bits - 2}) return 0;
+    int r = (int)-s;
+    return saturate((p + ((wide_t)1 << (r - 1))) >> r);
+}}
+
+// x = 2^e * (1 + t) with t in [sqrt(1/2) - 1, sqrt(2) - 1); returns e, log2(1 + t) in *frac
+static int log2_split({T} x, wide_t* frac) {{
+    int top = msb((uint64_t)x);
+    wide_t m = (top <= WORK_FRAC) ? (wide_t)x << (WORK_FRAC - top)
+                                 : (wide_t)x >> (top - WORK_FRAC);
+    int e = top - {n};
+    if (m > {lit(sqrt2_w)}) {{
+        m >>= 1;
+        e++;
     }}
-    
-    // Approximate log2(normalized) for normalized in [1,2)
-    {type_name} frac = normalized - Q{m_bits}_{n_bits}_ONE;
-    {type_name} inv_ln2 = ({type_name})(1.442695 * (1LL << {n_bits}));
-    {type_name} log_frac = (({base_type})frac * inv_ln2) >> {n_bits};
-    
-    return (int_part << {n_bits}) + log_frac;
+    *frac = horner(log2_poly, {len(log2_poly) - 1}, m - WORK_ONE);
+    return e;
 }}
 
-{type_name} q{m_bits}_{n_bits}_log({type_name} x) {{
-    {type_name} log2_val = q{m_bits}_{n_bits}_log2(x);
-    {type_name} ln2 = ({type_name})(0.693147 * (1LL << {n_bits}));
-    return (({base_type})log2_val * ln2) >> {n_bits};
+{T} {p}_exp2({T} x) {{
+    return exp2_split({exp2_int}, {exp2_frac});
 }}
 
-{type_name} q{m_bits}_{n_bits}_pow({type_name} base, {type_name} exponent) {{
+{T} {p}_exp({T} x) {{
+    // e^x = 2^(x * log2(e)), with x * log2(e) kept at {n + W} fractional bits
+    wide_t t = (wide_t)x * {lit(log2e_hi)} + (((wide_t)x * {lit(log2e_lo)}) >> {W});
+    return exp2_split(t >> {n + W}, {frac_to_work(n + W, "t")});
+}}
+
+{T} {p}_log2({T} x) {{
+    if (x <= 0) return {M}_MIN;
+    wide_t frac;
+    int e = log2_split(x, &frac);
+    return from_work((wide_t)e * WORK_ONE + frac);
+}}
+
+{T} {p}_log({T} x) {{
+    if (x <= 0) return {M}_MIN;
+    wide_t frac;
+    int e = log2_split(x, &frac);
+    // ln(x) = (e + log2(1 + t)) * ln(2)
+    const wide_t ln2 = {lit(ln2_w)};
+    return from_work((wide_t)e * ln2 + ((frac * ln2 + (WORK_ONE >> 1)) >> WORK_FRAC));
+}}
+
+{T} {p}_pow({T} base, {T} exponent) {{
     if (base <= 0) return 0;
-    // x^y = 2^(y * log2(x))
-    {type_name} log_base = q{m_bits}_{n_bits}_log2(base);
-    {type_name} scaled = (({base_type})exponent * log_base) >> {n_bits};
-    return q{m_bits}_{n_bits}_exp2(scaled);
+    // x^y = 2^(y * log2(x)), log2(x) at {W - pow_guard} fractional bits
+    wide_t frac;
+    int e = log2_split(base, &frac);
+    wide_t l = ((wide_t)e * WORK_ONE + frac) >> {pow_guard};
+    wide_t t = l * exponent;
+    return exp2_split(t >> {W - pow_guard + n}, {frac_to_work(W - pow_guard + n, "t")});
 }}
 """
     return impl
 
+
+def parse_format(text):
+    m_text, _, n_text = text.partition(".")
+    return int(m_text), int(n_text)
+
+
 def main():
-    output_dir = Path(__file__).parent.parent / "include" / "fixp" / "gen"
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--output-dir", type=Path,
+                        default=Path(__file__).parent.parent / "include" / "fixp" / "gen")
+    parser.add_argument("formats", nargs="*", type=parse_format,
+                        help="formats as M.N (integer and fractional bits, sign excluded)")
+    args = parser.parse_args()
+
+    output_dir = args.output_dir
     output_dir.mkdir(parents=True, exist_ok=True)
-    
-    # Generate for common formats
-    formats = [
-        (15, 16),  # Q15.16 (32-bit)
-        (8, 8),    # Q8.8 (16-bit)
-        (7, 8),    # Q7.8 (16-bit)
-        (0, 7),    # Q0.7 (8-bit)
-        (0, 15),   # Q0.15 (16-bit)
-        (23, 8),   # Q23.8 (32-bit)
-        (31, 0),   # Q31.0 (32-bit integer)
-    ]
-    
-    for m, n in formats:
-        # Generate header
-        header_content = generate_math_header(m, n)
-        header_file = output_dir / f"q{m}_{n}_math.h"
-        header_file.write_text(header_content)
-        print(f"Generated {header_file}")
-        
-        # Generate implementation
-        impl_content = generate_cordic_c_file(m, n)
-        impl_file = output_dir / f"q{m}_{n}_math.c"
-        impl_file.write_text(impl_content)
-        print(f"Generated {impl_file}")
+
+    for m, n in args.formats or DEFAULT_FORMATS:
+        # Only rewrite changed files so dependent objects are not rebuilt needlessly
+        for suffix, content in ((".h", generate_math_header(m, n)),
+                                (".c", generate_cordic_c_file(m, n))):
+            path = output_dir / f"q{m}_{n}_math{suffix}"
+            if not path.exists() or path.read_text() != content:
+                path.write_text(content)
+                print(f"Generated {path}")
+
 
 if __name__ == "__main__":
     main()
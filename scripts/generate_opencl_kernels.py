@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""
+Generate OpenCL C kernels for fixed-point formats.
+
+Each Qm.n format gets qM_N.cl, an OpenCL C 1.2 program, and qM_N_cl.h, the
+same source as a C string for clCreateProgramWithSource. The storage type
+comes from the table in generate_headers.py, and the range is the whole
+storage type, as in FixedPoint<storage bits, n>. The kernels compute exactly
+what the C++ FixedPoint operators, batch::from_float/to_float and FftPlan
+compute on the CPU, bit for bit:
+
+- add, sub, mul, mul_add and scale, each as _wrap and _sat
+- from_float (ties to even or away from zero, always saturating, NaN to 0)
+  and to_float
+- fft_bitrev, fft_stage_wrap/_sat and fft_scale, the passes of an FftPlan
+  transform, fed with the plan's own twiddle and bit-reversal tables
+
+Signed results never rely on overflow or on shifting negative values, and
+floats are only multiplied by powers of two, rounded with rint/round and
+compared, all exact in OpenCL C. Do not build the programs with
+-cl-fast-relaxed-math or -cl-finite-math-only.
+
+The first line of every program reads
+"// libfixp-format: prefix=qM_N storage=BITS frac=N", which the host API in
+fixp/opencl.hpp checks against the FixedPoint type it is used with.
+
+Usage: generate_opencl_kernels.py [--output-dir DIR] [M.N ...]
+"""
+
+import argparse
+from pathlib import Path
+
+from generate_headers import DEFAULT_FORMATS, storage_for
+
+# OpenCL C names for each storage width: (signed, unsigned, product type)
+OPENCL_TYPES = {
+    8: ("char", "uchar", "int"),
+    16: ("short", "ushort", "int"),
+    32: ("int", "uint", "long"),
+}
+
+
+def kernel(name, params, body):
+    """A __kernel definition, its parameters wrapped at 100 columns under the parenthesis"""
+    head = f"__kernel void {name}("
+    lines, line = [], head
+    for i, param in enumerate(params):
+        piece = param + (", " if i + 1 < len(params) else ") {")
+        if line != head and len(line) + len(piece.rstrip()) > 100:
+            lines.append(line.rstrip())
+            line = " " * len(head)
+        line += piece
+    return "\n".join(lines + [line]) + "\n" + body + "}\n"
+
+
+def generate_kernels(m, n):
+    """OpenCL C source for Qm.n"""
+    bits = storage_for(m + n + 1)[0]
+    if bits not in OPENCL_TYPES:
+        raise ValueError(f"Q{m}.{n} needs {bits}-bit storage; the kernels stop at 32 bits")
+    T, U, W = OPENCL_TYPES[bits]
+    p = f"q{m}_{n}"
+    M = p.upper()
+    hi = 1 << (bits - 1)
+    # Products round to nearest, ties toward +infinity, as FixedPoint::mul
+    rounded = f"{p}_asr(p + (({p}_wide_t)1 << {n - 1}), {n})" if n > 0 else "p"
+    element = "    const size_t i = get_global_id(0);\n"
+    a, b, c, out = (f"__global const {T}* a", f"__global const {T}* b",
+                    f"__global const {T}* c", f"__global {T}* out")
+
+    src = f"""// libfixp-format: prefix={p} storage={bits} frac={n}
+/*
+ * Q{m}.{n} OpenCL kernels (generated by scripts/generate_opencl_kernels.py)
+ *
+ * Format: 1 sign bit, {m} integer bits, {n} fractional bits in {T}.
+ * Element kernels take their arrays, any scalar, the output and the element
+ * count, and ignore work-items past the count.
+ */
+
+typedef {T} {p}_t;
+typedef {W} {p}_wide_t;
+
+#define {M}_MAX (({T}){hi - 1})
+#define {M}_MIN (({T})(-{hi - 1} - 1))
+
+// Floor shift without shifting a negative value
+static inline {p}_wide_t {p}_asr({p}_wide_t v, uint s) {{
+    return v >= 0 ? v >> s : ~(~v >> s);
+}}
+
+// Wrap: two's complement in the unsigned type
+static inline {T} {p}_add_wrap_({T} a, {T} b) {{ return ({T})(({U})a + ({U})b); }}
+static inline {T} {p}_sub_wrap_({T} a, {T} b) {{ return ({T})(({U})a - ({U})b); }}
+static inline {T} {p}_neg_wrap_({T} a) {{ return ({T})(({U})0 - ({U})a); }}
+static inline {T} {p}_narrow_wrap_({p}_wide_t v) {{ return ({T})v; }}
+
+// Saturate: exact in the wide type, then clamped
+static inline {T} {p}_narrow_sat_({p}_wide_t v) {{
+    return v > {M}_MAX ? {M}_MAX : v < {M}_MIN ? {M}_MIN : ({T})v;
+}}
+static inline {T} {p}_add_sat_({T} a, {T} b) {{
+    return {p}_narrow_sat_(({p}_wide_t)a + ({p}_wide_t)b);
+}}
+static inline {T} {p}_sub_sat_({T} a, {T} b) {{
+    return {p}_narrow_sat_(({p}_wide_t)a - ({p}_wide_t)b);
+}}
+static inline {T} {p}_neg_sat_({T} a) {{ return a == {M}_MIN ? {M}_MAX : ({T})-a; }}
+
+// a * x - b * y for Q30 twiddles a and b, rounded once to the data's scale
+static inline {p}_wide_t {p}_twiddle_dot_(int a, {T} x, int b, {T} y) {{
+    const long v = (long)a * x - (long)b * y + ((long)1 << 29);
+    return ({p}_wide_t)(v >= 0 ? v >> 30 : ~(~v >> 30));
+}}
+"""
+    for policy in ("wrap", "sat"):
+        mul, add, sub = (f"{p}_{op}_{policy}_" for op in ("mul", "add", "sub"))
+        src += f"""
+static inline {T} {mul}({T} a, {T} b) {{
+    const {p}_wide_t p = ({p}_wide_t)a * ({p}_wide_t)b;
+    return {p}_narrow_{policy}_({rounded});
+}}
+
+"""
+        src += kernel(f"{p}_add_{policy}", [a, b, out, "uint n"],
+                      element + f"    if (i < n) out[i] = {add}(a[i], b[i]);\n")
+        src += "\n" + kernel(f"{p}_sub_{policy}", [a, b, out, "uint n"],
+                             element + f"    if (i < n) out[i] = {sub}(a[i], b[i]);\n")
+        src += "\n" + kernel(f"{p}_mul_{policy}", [a, b, out, "uint n"],
+                             element + f"    if (i < n) out[i] = {mul}(a[i], b[i]);\n")
+        src += "\n// a * b + c, the product rounded first as with the scalar operators\n"
+        src += kernel(f"{p}_mul_add_{policy}", [a, b, c, out, "uint n"],
+                      element + f"    if (i < n) out[i] = {add}({mul}(a[i], b[i]), c[i]);\n")
+        src += "\n" + kernel(f"{p}_scale_{policy}", [a, f"{T} s", out, "uint n"],
+                             element + f"    if (i < n) out[i] = {mul}(a[i], s);\n")
+        src += f"""
+// One radix-2 butterfly of one frame per work-item, as a stage of
+// FftPlan::transform: frames of n interleaved (real, imag) pairs, butterflies
+// of length 2 * half, every stride-th of the plan's interleaved Q30 twiddles
+"""
+        src += kernel(f"{p}_fft_stage_{policy}",
+                      [f"__global {T}* data", "__global const int* twiddles", "uint n",
+                       "uint half", "uint stride", "uint frames", "int inverse"], f"""\
+    const size_t g = get_global_id(0);
+    const uint butterflies = n / 2;
+    if (g >= (size_t)butterflies * frames) return;
+    const uint j = (uint)(g % butterflies);
+    __global {T}* d = data + (g / butterflies) * 2 * (size_t)n;
+    const uint k = j % half;
+    const uint top = (j / half) * 2 * half + k;
+    const uint bottom = top + half;
+
+    const int wr = twiddles[2 * (k * stride)];
+    const int wi = inverse ? -twiddles[2 * (k * stride) + 1] : twiddles[2 * (k * stride) + 1];
+    const {T} xr = d[2 * bottom], xi = d[2 * bottom + 1];
+    const {T} tr = {p}_narrow_{policy}_({p}_twiddle_dot_(wr, xr, wi, xi));
+    const {T} ti = {p}_narrow_{policy}_({p}_twiddle_dot_(wr, xi, -wi, xr));
+    const {T} ur = d[2 * top], ui = d[2 * top + 1];
+    d[2 * top] = {add}(ur, tr);
+    d[2 * top + 1] = {add}(ui, ti);
+    d[2 * bottom] = {sub}(ur, tr);
+    d[2 * bottom + 1] = {sub}(ui, ti);
+""")
+
+    src += f"""
+// x * 2^{n} rounded, saturated and NaN to zero, as batch::from_float
+static inline {T} {p}_from_float_(float x, int even) {{
+    const float scaled = x * 0x1p{n}f;
+    if (isnan(scaled)) return 0;
+    const float v = even ? rint(scaled) : round(scaled);
+    if (v >= 0x1p{bits - 1}f) return {M}_MAX;
+    if (v < -0x1p{bits - 1}f) return {M}_MIN;
+    return ({T})v;
+}}
+
+"""
+    src += kernel(f"{p}_from_float", ["__global const float* in", "int even", out, "uint n"],
+                  element + f"    if (i < n) out[i] = {p}_from_float_(in[i], even);\n")
+    src += "\n// Exact scaling; the conversion rounds once, to nearest even\n"
+    src += kernel(f"{p}_to_float", [f"__global const {T}* in", "__global float* out", "uint n"],
+                  element + f"    if (i < n) out[i] = (float)in[i] * 0x1p-{n}f;\n")
+    src += "\n// The bit-reversal permutation of every frame; the lower index of a pair swaps\n"
+    src += kernel(f"{p}_fft_bitrev",
+                  [f"__global {T}* data", "__global const uint* bitrev", "uint n", "uint frames"],
+                  f"""\
+    const size_t g = get_global_id(0);
+    if (g >= (size_t)n * frames) return;
+    const uint i = (uint)(g % n);
+    const uint j = bitrev[i];
+    if (i >= j) return;
+    __global {T}* d = data + (g - i) * 2;
+    const {T} r = d[2 * i], im = d[2 * i + 1];
+    d[2 * i] = d[2 * j];
+    d[2 * i + 1] = d[2 * j + 1];
+    d[2 * j] = r;
+    d[2 * j + 1] = im;
+""")
+    src += "\n// Rounding divide of n raw values by 2^log2n, after an inverse transform\n"
+    src += kernel(f"{p}_fft_scale", [f"__global {T}* data", "uint log2n", "uint n"],
+                  element + f"""\
+    if (i < n) {{
+        const long v = (long)data[i] + ((long)1 << (log2n - 1));
+        data[i] = ({T})(v >= 0 ? v >> log2n : ~(~v >> log2n));
+    }}
+""")
+    return src
+
+def c_string_header(m, n, source):
+    """source as a C string constant, qM_N_cl_source"""
+    p = f"q{m}_{n}"
+    guard = f"FIXP_GEN_{p.upper()}_CL_H"
+    lines = []
+    for line in source.splitlines():
+        escaped = line.replace("\\", "\\\\").replace('"', '\\"')
+        lines.append(f'    "{escaped}\\n"')
+    body = "\n".join(lines)
+    return f"""/**
+ * @file {p}_cl.h
+ * @brief Q{m}.{n} OpenCL program source (generated from {p}.cl)
+ */
+
+#ifndef {guard}
+#define {guard}
+
+static const char {p}_cl_source[] =
+{body};
+
+#endif // {guard}
+"""
+
+
+def parse_format(text):
+    m_text, _, n_text = text.partition(".")
+    return int(m_text), int(n_text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--output-dir", type=Path,
+                        default=Path(__file__).parent.parent / "include" / "fixp" / "gen")
+    parser.add_argument("formats", nargs="*", type=parse_format,
+                        help="formats as M.N (integer and fractional bits, sign excluded)")
+    args = parser.parse_args()
+
+    output_dir = args.output_dir
+    output_dir.mkdir(parents=True, exist_ok=True)
+
+    formats = args.formats
+    if not formats:
+        formats = [(m, n) for m, n in DEFAULT_FORMATS if storage_for(m + n + 1)[0] <= 32]
+    for m, n in formats:
+        source = generate_kernels(m, n)
+        # Only rewrite changed files so dependent objects are not rebuilt needlessly
+        for name, content in ((f"q{m}_{n}.cl", source),
+                              (f"q{m}_{n}_cl.h", c_string_header(m, n, source))):
+            path = output_dir / name
+            if not path.exists() or path.read_text() != content:
+                path.write_text(content)
+                print(f"Generated {path}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""
+Pick the fastest backend of each function that meets an error budget.
+
+Reads a fixp_bench --json run and groups the benchmarks that have an
+accuracy sweep by (function, format). The function is the benchmark name
+without a "batch::" prefix or a parenthesised backend, so "sin (CORDIC)",
+"sin (table, Fast)" and "batch::sin (...)" compete. For each group it
+prints the fastest benchmark whose max_ulp is within the budget, or notes
+that none is.
+
+Usage: select_backends.py RESULTS [--max-ulp ULP] [--filter TEXT]
+"""
+
+import argparse
+import json
+import re
+import sys
+
+
+def function_of(name):
+    name = name.removeprefix("batch::")
+    return re.sub(r"\s*\(.*\)$", "", name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fastest backend within an error budget")
+    parser.add_argument("results")
+    parser.add_argument("--max-ulp", type=float, default=1.0,
+                        help="largest acceptable max_ulp error (default 1)")
+    parser.add_argument("--filter", default="",
+                        help="only groups whose \"function format\" contains TEXT")
+    args = parser.parse_args()
+
+    with open(args.results) as f:
+        data = json.load(f)
+
+    groups = {}
+    for b in data["benchmarks"]:
+        if "max_ulp" not in b:
+            continue
+        key = (function_of(b["name"]), b["format"])
+        if args.filter in f"{key[0]} {key[1]}":
+            groups.setdefault(key, []).append(b)
+
+    print(f"{'function':<16} {'format':<14} {'fastest within budget':<34} {'ns/op':>10}"
+          f" {'max ulp':>10} {'mean ulp':>10}")
+    unmet = 0
+    for key in sorted(groups):
+        within = [b for b in groups[key] if b["max_ulp"] <= args.max_ulp]
+        if not within:
+            best = min(groups[key], key=lambda b: b["max_ulp"])
+            print(f"{key[0]:<16} {key[1]:<14} {'none; closest ' + best['name']:<34}"
+                  f" {best['ns_per_op']:>10.3f} {best['max_ulp']:>10.2f} {best['mean_ulp']:>10.3f}")
+            unmet += 1
+            continue
+        best = min(within, key=lambda b: b["ns_per_op"])
+        print(f"{key[0]:<16} {key[1]:<14} {best['name']:<34} {best['ns_per_op']:>10.3f}"
+              f" {best['max_ulp']:>10.2f} {best['mean_ulp']:>10.3f}")
+
+    if unmet:
+        print(f"\n{unmet} function(s) have no backend within {args.max_ulp:g} ULP")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
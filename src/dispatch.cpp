@@ -0,0 +1,392 @@
+#include "fixp/cpu_dispatch.hpp"
+#include "fixp/simd.hpp"
+
+#include <cstdlib>
+#include <mutex>
+#include <string>
+
+#if defined(FIXP_SIMD_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace fixp {
+namespace dispatch {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// CPU feature probe
+//-----------------------------------------------------------------------------
+#if defined(FIXP_SIMD_X86)
+struct CpuidRegs {
+    unsigned eax, ebx, ecx, edx;
+};
+
+CpuidRegs cpuid(unsigned leaf, unsigned subleaf) {
+    CpuidRegs r{};
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    r = {static_cast<unsigned>(regs[0]), static_cast<unsigned>(regs[1]),
+         static_cast<unsigned>(regs[2]), static_cast<unsigned>(regs[3])};
+#else
+    if (!__get_cpuid_count(leaf, subleaf, &r.eax, &r.ebx, &r.ecx, &r.edx)) r = {};
+#endif
+    return r;
+}
+
+// XCR0: which register states the OS saves on context switch
+uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+
+Isa probe() {
+    const CpuidRegs leaf0 = cpuid(0, 0);
+    const CpuidRegs leaf1 = cpuid(1, 0);
+    const bool sse41 = (leaf1.ecx >> 19) & 1u;
+    const bool osxsave = (leaf1.ecx >> 27) & 1u;
+    if (!sse41) return Isa::Scalar;
+    if (!osxsave || leaf0.eax < 7) return Isa::SSE41;
+
+    const uint64_t xcr0 = xgetbv0();
+    const bool ymm_state = (xcr0 & 0x6) == 0x6;
+    const bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+    const CpuidRegs leaf7 = cpuid(7, 0);
+    const bool avx2 = (leaf7.ebx >> 5) & 1u;
+    const bool avx512f = (leaf7.ebx >> 16) & 1u;
+    const bool avx512bw = (leaf7.ebx >> 30) & 1u;
+
+    if (zmm_state && avx512f && avx512bw) return Isa::AVX512;
+    if (ymm_state && avx2) return Isa::AVX2;
+    return Isa::SSE41;
+}
+#elif defined(FIXP_SIMD_NEON)
+// Advanced SIMD is mandatory on AArch64 and is assumed by the compiler
+// whenever __ARM_NEON is defined, so there is nothing to probe
+Isa probe() {
+    return Isa::NEON;
+}
+#else
+Isa probe() {
+    return Isa::Scalar;
+}
+#endif
+
+int isa_rank(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return 0;
+        case Isa::SSE41:  return 1;
+        case Isa::AVX2:   return 2;
+        case Isa::AVX512: return 3;
+        case Isa::NEON:   return 1;
+    }
+    return 0;
+}
+
+bool is_supported(Isa isa, Isa detected) {
+    if (isa == Isa::Scalar) return true;
+    const bool detected_arm = detected == Isa::NEON;
+    const bool wanted_arm = isa == Isa::NEON;
+    if (detected_arm != wanted_arm) return false;
+    return isa_rank(isa) <= isa_rank(detected);
+}
+
+//-----------------------------------------------------------------------------
+// Kernel sets
+//-----------------------------------------------------------------------------
+size_t scalar_add_i32(const int32_t*, const int32_t*, int32_t*, size_t, bool) { return 0; }
+size_t scalar_mul_i32(const int32_t*, const int32_t*, int32_t*, size_t, int, bool) { return 0; }
+size_t scalar_mul_add_i32(const int32_t*, const int32_t*, const int32_t*, int32_t*, size_t, int,
+                          bool) {
+    return 0;
+}
+size_t scalar_scale_i32(const int32_t*, int32_t, int32_t*, size_t, int, bool) { return 0; }
+size_t scalar_clamp_i32(const int32_t*, int32_t, int32_t, int32_t*, size_t) { return 0; }
+size_t scalar_add_i16(const int16_t*, const int16_t*, int16_t*, size_t, bool) { return 0; }
+size_t scalar_mul_i16(const int16_t*, const int16_t*, int16_t*, size_t, int, bool) { return 0; }
+size_t scalar_mul_add_i16(const int16_t*, const int16_t*, const int16_t*, int16_t*, size_t, int,
+                          bool) {
+    return 0;
+}
+size_t scalar_scale_i16(const int16_t*, int16_t, int16_t*, size_t, int, bool) { return 0; }
+size_t scalar_clamp_i16(const int16_t*, int16_t, int16_t, int16_t*, size_t) { return 0; }
+size_t scalar_from_float_i32(const float*, int32_t*, size_t, int, bool) { return 0; }
+size_t scalar_from_float_i16(const float*, int16_t*, size_t, int, bool) { return 0; }
+size_t scalar_to_float_i32(const int32_t*, float*, size_t, int) { return 0; }
+size_t scalar_to_float_i16(const int16_t*, float*, size_t, int) { return 0; }
+size_t scalar_dot_i32(const int32_t*, const int32_t*, size_t, int64_t*) { return 0; }
+size_t scalar_dot_i16(const int16_t*, const int16_t*, size_t, int64_t*) { return 0; }
+size_t scalar_biquad_df1(const int32_t*, int32_t*, int32_t*, size_t, int, bool) { return 0; }
+size_t scalar_biquad_tdf2(const int32_t*, int64_t*, int32_t*, size_t, int, bool) { return 0; }
+size_t scalar_transform4x4(const int32_t*, const int32_t*, int32_t*, size_t, int, bool) {
+    return 0;
+}
+size_t scalar_table_lookup_i32(const int32_t*, int32_t*, size_t, const simd::TableSpec&) {
+    return 0;
+}
+size_t scalar_table_lookup_i16(const int16_t*, int16_t*, size_t, const simd::TableSpec&) {
+    return 0;
+}
+
+struct KernelSet {
+    KernelTable::add_i32_fn add_i32 = scalar_add_i32;
+    KernelTable::add_i32_fn sub_i32 = scalar_add_i32;
+    KernelTable::mul_i32_fn mul_i32 = scalar_mul_i32;
+    KernelTable::mul_add_i32_fn mul_add_i32 = scalar_mul_add_i32;
+    KernelTable::scale_i32_fn scale_i32 = scalar_scale_i32;
+    KernelTable::clamp_i32_fn clamp_i32 = scalar_clamp_i32;
+    KernelTable::add_i16_fn add_i16 = scalar_add_i16;
+    KernelTable::add_i16_fn sub_i16 = scalar_add_i16;
+    KernelTable::mul_i16_fn mul_i16 = scalar_mul_i16;
+    KernelTable::mul_add_i16_fn mul_add_i16 = scalar_mul_add_i16;
+    KernelTable::scale_i16_fn scale_i16 = scalar_scale_i16;
+    KernelTable::clamp_i16_fn clamp_i16 = scalar_clamp_i16;
+    KernelTable::from_float_i32_fn from_float_i32 = scalar_from_float_i32;
+    KernelTable::from_float_i16_fn from_float_i16 = scalar_from_float_i16;
+    KernelTable::to_float_i32_fn to_float_i32 = scalar_to_float_i32;
+    KernelTable::to_float_i16_fn to_float_i16 = scalar_to_float_i16;
+    KernelTable::dot_i32_fn dot_i32 = scalar_dot_i32;
+    KernelTable::dot_i16_fn dot_i16 = scalar_dot_i16;
+    KernelTable::biquad_df1_fn biquad_df1 = scalar_biquad_df1;
+    KernelTable::biquad_tdf2_fn biquad_tdf2 = scalar_biquad_tdf2;
+    KernelTable::transform4x4_fn transform4x4 = scalar_transform4x4;
+    KernelTable::table_lookup_i32_fn table_lookup_i32 = scalar_table_lookup_i32;
+    KernelTable::table_lookup_i16_fn table_lookup_i16 = scalar_table_lookup_i16;
+};
+
+#define FIXP_KERNEL_SET(ns)                                                   \
+    KernelSet {                                                               \
+        static_cast<KernelTable::add_i32_fn>(&ns::add),                       \
+        static_cast<KernelTable::add_i32_fn>(&ns::sub),                       \
+        static_cast<KernelTable::mul_i32_fn>(&ns::mul),                       \
+        static_cast<KernelTable::mul_add_i32_fn>(&ns::mul_add),               \
+        static_cast<KernelTable::scale_i32_fn>(&ns::scale),                   \
+        static_cast<KernelTable::clamp_i32_fn>(&ns::clamp),                   \
+        static_cast<KernelTable::add_i16_fn>(&ns::add),                       \
+        static_cast<KernelTable::add_i16_fn>(&ns::sub),                       \
+        static_cast<KernelTable::mul_i16_fn>(&ns::mul),                       \
+        static_cast<KernelTable::mul_add_i16_fn>(&ns::mul_add),               \
+        static_cast<KernelTable::scale_i16_fn>(&ns::scale),                   \
+        static_cast<KernelTable::clamp_i16_fn>(&ns::clamp),                   \
+        static_cast<KernelTable::from_float_i32_fn>(&ns::from_float),         \
+        static_cast<KernelTable::from_float_i16_fn>(&ns::from_float),         \
+        static_cast<KernelTable::to_float_i32_fn>(&ns::to_float),             \
+        static_cast<KernelTable::to_float_i16_fn>(&ns::to_float),             \
+        static_cast<KernelTable::dot_i32_fn>(&ns::dot),                       \
+        static_cast<KernelTable::dot_i16_fn>(&ns::dot),                       \
+        &ns::biquad_df1,                                                      \
+        &ns::biquad_tdf2,                                                     \
+        &ns::transform4x4,                                                    \
+    }
+
+// The table lookup gathers, so only the AVX2 and AVX-512 sets have one
+template<typename Lookup32, typename Lookup16>
+KernelSet with_table_lookup(KernelSet k, Lookup32 lookup32, Lookup16 lookup16) {
+    k.table_lookup_i32 = lookup32;
+    k.table_lookup_i16 = lookup16;
+    return k;
+}
+
+KernelSet kernel_set(Isa isa) {
+    switch (isa) {
+#if defined(FIXP_SIMD_X86)
+        case Isa::SSE41:  return FIXP_KERNEL_SET(simd::sse41);
+        case Isa::AVX2:
+            return with_table_lookup(
+                FIXP_KERNEL_SET(simd::avx2),
+                static_cast<KernelTable::table_lookup_i32_fn>(&simd::avx2::table_lookup),
+                static_cast<KernelTable::table_lookup_i16_fn>(&simd::avx2::table_lookup));
+        case Isa::AVX512:
+            return with_table_lookup(
+                FIXP_KERNEL_SET(simd::avx512),
+                static_cast<KernelTable::table_lookup_i32_fn>(&simd::avx512::table_lookup),
+                static_cast<KernelTable::table_lookup_i16_fn>(&simd::avx512::table_lookup));
+#endif
+#if defined(FIXP_SIMD_NEON)
+        case Isa::NEON:   return FIXP_KERNEL_SET(simd::neon);
+#endif
+        default:          return KernelSet{};
+    }
+}
+
+#undef FIXP_KERNEL_SET
+
+//-----------------------------------------------------------------------------
+// Binding
+//-----------------------------------------------------------------------------
+std::once_flag bind_flag;
+Isa g_detected = Isa::Scalar;
+Isa g_startup = Isa::Scalar;
+std::atomic<Isa> g_active{Isa::Scalar};
+
+void publish(Isa isa) {
+    const KernelSet k = kernel_set(isa);
+    KernelTable& t = detail::table;
+    constexpr auto order = std::memory_order_relaxed;
+    t.add_i32.store(k.add_i32, order);
+    t.sub_i32.store(k.sub_i32, order);
+    t.mul_i32.store(k.mul_i32, order);
+    t.mul_add_i32.store(k.mul_add_i32, order);
+    t.scale_i32.store(k.scale_i32, order);
+    t.clamp_i32.store(k.clamp_i32, order);
+    t.add_i16.store(k.add_i16, order);
+    t.sub_i16.store(k.sub_i16, order);
+    t.mul_i16.store(k.mul_i16, order);
+    t.mul_add_i16.store(k.mul_add_i16, order);
+    t.scale_i16.store(k.scale_i16, order);
+    t.clamp_i16.store(k.clamp_i16, order);
+    t.from_float_i32.store(k.from_float_i32, order);
+    t.from_float_i16.store(k.from_float_i16, order);
+    t.to_float_i32.store(k.to_float_i32, order);
+    t.to_float_i16.store(k.to_float_i16, order);
+    t.dot_i32.store(k.dot_i32, order);
+    t.dot_i16.store(k.dot_i16, order);
+    t.biquad_df1.store(k.biquad_df1, order);
+    t.biquad_tdf2.store(k.biquad_tdf2, order);
+    t.transform4x4.store(k.transform4x4, order);
+    t.table_lookup_i32.store(k.table_lookup_i32, order);
+    t.table_lookup_i16.store(k.table_lookup_i16, order);
+    g_active.store(isa, std::memory_order_release);
+}
+
+std::optional<std::string> isa_from_environment() {
+#if defined(_MSC_VER)
+    char* value = nullptr;
+    size_t len = 0;
+    if (_dupenv_s(&value, &len, "LIBFIXP_ISA") != 0 || value == nullptr) return std::nullopt;
+    std::string result(value);
+    std::free(value);
+    return result;
+#else
+    const char* value = std::getenv("LIBFIXP_ISA");
+    if (value == nullptr) return std::nullopt;
+    return std::string(value);
+#endif
+}
+
+void bind() {
+    g_detected = probe();
+    g_startup = g_detected;
+    if (auto name = isa_from_environment()) {
+        // Unknown or unsupported overrides fall back to the detected ISA
+        if (auto forced = parse_isa(*name); forced && is_supported(*forced, g_detected)) {
+            g_startup = *forced;
+        }
+    }
+    publish(g_startup);
+}
+
+void bind_once() {
+    std::call_once(bind_flag, bind);
+}
+
+// First call through any entry binds the whole table, then forwards
+template<auto Member, typename Fn>
+struct Resolver;
+
+template<auto Member, typename R, typename... Args>
+struct Resolver<Member, R (*)(Args...)> {
+    static R call(Args... args) {
+        bind_once();
+        return (detail::table.*Member).load(std::memory_order_relaxed)(args...);
+    }
+};
+
+template<auto Member>
+constexpr auto resolver() {
+    using Fn = typename std::remove_reference_t<decltype(detail::table.*Member)>::value_type;
+    return &Resolver<Member, Fn>::call;
+}
+
+// Bind at startup so steady-state calls never reach a resolver
+[[maybe_unused]] const bool bound_at_startup = (bind_once(), true);
+
+} // namespace
+
+namespace detail {
+
+constinit KernelTable table{
+    resolver<&KernelTable::add_i32>(),
+    resolver<&KernelTable::sub_i32>(),
+    resolver<&KernelTable::mul_i32>(),
+    resolver<&KernelTable::mul_add_i32>(),
+    resolver<&KernelTable::scale_i32>(),
+    resolver<&KernelTable::clamp_i32>(),
+    resolver<&KernelTable::add_i16>(),
+    resolver<&KernelTable::sub_i16>(),
+    resolver<&KernelTable::mul_i16>(),
+    resolver<&KernelTable::mul_add_i16>(),
+    resolver<&KernelTable::scale_i16>(),
+    resolver<&KernelTable::clamp_i16>(),
+    resolver<&KernelTable::from_float_i32>(),
+    resolver<&KernelTable::from_float_i16>(),
+    resolver<&KernelTable::to_float_i32>(),
+    resolver<&KernelTable::to_float_i16>(),
+    resolver<&KernelTable::dot_i32>(),
+    resolver<&KernelTable::dot_i16>(),
+    resolver<&KernelTable::biquad_df1>(),
+    resolver<&KernelTable::biquad_tdf2>(),
+    resolver<&KernelTable::transform4x4>(),
+    resolver<&KernelTable::table_lookup_i32>(),
+    resolver<&KernelTable::table_lookup_i16>(),
+};
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+// Public API
+//-----------------------------------------------------------------------------
+const char* isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::SSE41:  return "sse4.1";
+        case Isa::AVX2:   return "avx2";
+        case Isa::AVX512: return "avx512";
+        case Isa::NEON:   return "neon";
+    }
+    return "unknown";
+}
+
+std::optional<Isa> parse_isa(std::string_view name) {
+    if (name == "scalar") return Isa::Scalar;
+    if (name == "sse4.1" || name == "sse41") return Isa::SSE41;
+    if (name == "avx2") return Isa::AVX2;
+    if (name == "avx512") return Isa::AVX512;
+    if (name == "neon") return Isa::NEON;
+    return std::nullopt;
+}
+
+Isa detected_isa() {
+    bind_once();
+    return g_detected;
+}
+
+Isa active_isa() {
+    bind_once();
+    return g_active.load(std::memory_order_acquire);
+}
+
+bool force_isa(Isa isa) {
+    bind_once();
+    if (!is_supported(isa, g_detected)) return false;
+    publish(isa);
+    return true;
+}
+
+void reset_isa() {
+    bind_once();
+    publish(g_startup);
+}
+
+} // namespace dispatch
+} // namespace fixp
@@ -0,0 +1,173 @@
+#include <fixp/accumulator.hpp>
+#include <fixp/dsp.hpp>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+template<typename FP>
+std::vector<FP> random_values(size_t n, uint32_t seed, int shift) {
+    using raw_type = typename FP::raw_type;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<raw_type>::min(),
+                                                std::numeric_limits<raw_type>::max());
+    std::vector<FP> v(n);
+    for (auto& x : v) {
+        switch (gen() % 8) {
+            case 0: x = FP::from_raw(static_cast<raw_type>(std::numeric_limits<raw_type>::min() >> shift)); break;
+            case 1: x = FP::from_raw(static_cast<raw_type>(std::numeric_limits<raw_type>::max() >> shift)); break;
+            default: x = FP::from_raw(static_cast<raw_type>(dist(gen) >> shift)); break;
+        }
+    }
+    return v;
+}
+
+// 128-bit sum of raw products, rounded once and narrowed per policy
+template<typename FP>
+FP reference_dot(const FP* a, const FP* b, size_t n) {
+    using raw_type = typename FP::raw_type;
+    __int128_t acc = 0;
+    for (size_t i = 0; i < n; ++i) {
+        acc += static_cast<__int128_t>(a[i].raw()) * static_cast<__int128_t>(b[i].raw());
+    }
+    acc = (acc + (__int128_t(1) << (FP::fractional_bits - 1))) >> FP::fractional_bits;
+    if constexpr (FP::overflow_policy == OverflowPolicy::Saturate) {
+        acc = std::min<__int128_t>(acc, std::numeric_limits<raw_type>::max());
+        acc = std::max<__int128_t>(acc, std::numeric_limits<raw_type>::min());
+    }
+    return FP::from_raw(static_cast<raw_type>(acc));
+}
+
+template<typename FP>
+void test_dot(const char* name, int shift) {
+    std::cout << name << ":\n";
+
+    bool ok = true;
+    for (size_t n : {0u, 1u, 3u, 8u, 31u, 64u, 257u, 1000u}) {
+        auto a = random_values<FP>(n, static_cast<uint32_t>(n) + 1, shift);
+        auto b = random_values<FP>(n, static_cast<uint32_t>(n) + 2, 0);
+        ok &= dot(a, b).raw() == reference_dot(a.data(), b.data(), n).raw();
+    }
+    check("dot matches 128-bit reference", ok);
+
+    // Element-wise and span MACs accumulate the same bits
+    auto a = random_values<FP>(100, 7, shift);
+    auto b = random_values<FP>(100, 8, 0);
+    Accumulator<FP> one, many;
+    for (size_t i = 0; i < a.size(); ++i) one.mac(a[i], b[i]);
+    many.mac(std::span<const FP>(a).first(37), std::span<const FP>(b).first(37));
+    many.mac(std::span<const FP>(a).subspan(37), std::span<const FP>(b).subspan(37));
+    check("scalar and span mac agree", one.raw() == many.raw());
+}
+
+void test_rounding() {
+    std::cout << "Deferred rounding:\n";
+    using Q15_16 = FixedPoint<32, 16>;
+    using Q0_31S = FixedPoint<32, 31, true, OverflowPolicy::Saturate>;
+
+    // Each product is half an LSB: rounding per term gives 4 LSB, once gives 2
+    std::array<Q15_16, 4> a, b;
+    a.fill(Q15_16::from_raw(1));
+    b.fill(Q15_16::from_raw(1 << 15));
+    Q15_16 naive(0);
+    for (size_t i = 0; i < a.size(); ++i) naive = naive + a[i] * b[i];
+    check("per-term rounding drifts", naive.raw() == 4);
+    check("dot rounds once", dot(a, b).raw() == 2);
+
+    // Partial sums above 2^63 wrap back once the negative terms arrive
+    std::array<Q0_31S, 4> big_a = {Q0_31S::min(), Q0_31S::min(), Q0_31S::min(), Q0_31S::max()};
+    std::array<Q0_31S, 4> big_b = {Q0_31S::min(), Q0_31S::min(), Q0_31S::max(), Q0_31S::min()};
+    check("wrapped partial sums are exact",
+          dot(big_a, big_b).raw() == reference_dot(big_a.data(), big_b.data(), 4).raw());
+
+    Accumulator<Q0_31S> acc(Q0_31S(0.75));
+    acc.mac(Q0_31S(0.5), Q0_31S(0.5));
+    check("saturates once at the end", acc.result() == Q0_31S::max());
+    Accumulator<Q0_31S> other;
+    other.mac(Q0_31S(-0.5), Q0_31S(0.5));
+    acc += other;
+    check("initial value and += combine", acc.result() == Q0_31S(0.75));
+
+    constexpr std::array<Q15_16, 3> ca = {Q15_16(1.5), Q15_16(-2.0), Q15_16(0.25)};
+    constexpr std::array<Q15_16, 3> cb = {Q15_16(2.0), Q15_16(0.5), Q15_16(4.0)};
+    static_assert(dot(ca, cb) == Q15_16(3.0));
+    check("constexpr dot", true);
+}
+
+template<typename FP, size_t XSize, size_t YSize>
+void test_convolution(const char* name) {
+    std::cout << name << " convolve/correlate " << XSize << "x" << YSize << ":\n";
+    auto xv = random_values<FP>(XSize, 11, 3);
+    auto yv = random_values<FP>(YSize, 12, 3);
+    std::array<FP, XSize> x;
+    std::array<FP, YSize> y;
+    std::copy(xv.begin(), xv.end(), x.begin());
+    std::copy(yv.begin(), yv.end(), y.begin());
+
+    auto conv = dsp::convolve(x, y);
+    bool conv_ok = true;
+    for (size_t n = 0; n < conv.size(); ++n) {
+        std::vector<FP> a, b;
+        for (size_t k = 0; k < YSize; ++k) {
+            if (n >= k && n - k < XSize) {
+                a.push_back(x[n - k]);
+                b.push_back(y[k]);
+            }
+        }
+        conv_ok &= conv[n].raw() == reference_dot(a.data(), b.data(), a.size()).raw();
+    }
+    check("convolve", conv_ok);
+
+    auto corr = dsp::correlate(x, y);
+    bool corr_ok = true;
+    for (size_t i = 0; i < corr.size(); ++i) {
+        const auto lag = static_cast<std::ptrdiff_t>(i) - static_cast<std::ptrdiff_t>(YSize - 1);
+        std::vector<FP> a, b;
+        for (size_t n = 0; n < XSize; ++n) {
+            const auto j = static_cast<std::ptrdiff_t>(n) + lag;
+            if (j >= 0 && j < static_cast<std::ptrdiff_t>(YSize)) {
+                a.push_back(x[n]);
+                b.push_back(y[static_cast<size_t>(j)]);
+            }
+        }
+        corr_ok &= corr[i].raw() == reference_dot(a.data(), b.data(), a.size()).raw();
+    }
+    check("correlate", corr_ok);
+}
+
+int main() {
+    std::cout << "Testing Accumulator\n";
+    std::cout << "===================\n\n";
+
+    using Q15_16 = FixedPoint<32, 16, true, OverflowPolicy::Wrap>;
+    using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+    using Q0_31S = FixedPoint<32, 31, true, OverflowPolicy::Saturate>;
+    using Q0_15S = FixedPoint<16, 15, true, OverflowPolicy::Saturate>;
+    using Q7_8 = FixedPoint<16, 8, true, OverflowPolicy::Wrap>;
+    using Q0_7S = FixedPoint<8, 7, true, OverflowPolicy::Saturate>;
+    using Q31_32S = FixedPoint<64, 32, true, OverflowPolicy::Saturate>;
+
+    test_dot<Q15_16>("Q15.16 Wrap", 0);
+    test_dot<Q15_16S>("Q15.16 Saturate", 8);
+    // Q0.31 has one integer bit of headroom in 64 bits: keep sum(|a|) < 1
+    test_dot<Q0_31S>("Q0.31 Saturate", 10);
+    test_dot<Q0_15S>("Q0.15 Saturate", 0);
+    test_dot<Q7_8>("Q7.8 Wrap", 0);
+    test_dot<Q0_7S>("Q0.7 Saturate", 0);
+    test_dot<Q31_32S>("Q31.32 Saturate", 0);
+
+    test_rounding();
+
+    test_convolution<Q15_16S, 40, 9>("Q15.16");
+    test_convolution<Q15_16S, 5, 12>("Q15.16");
+    test_convolution<Q0_15S, 33, 17>("Q0.15");
+
+    std::cout << "\n" << (failures == 0 ? "All accumulator tests passed!" : "Accumulator tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
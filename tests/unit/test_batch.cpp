@@ -0,0 +1,101 @@
+#include <fixp/batch.hpp>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+// Random raw values with the extremes mixed in so the overflow paths are hit
+template<typename FP>
+std::vector<FP> make_input(size_t n, uint32_t seed) {
+    using raw_type = typename FP::raw_type;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<raw_type>::min(),
+                                                std::numeric_limits<raw_type>::max());
+    std::vector<FP> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        switch (gen() % 8) {
+            case 0: v[i] = FP::max(); break;
+            case 1: v[i] = FP::min(); break;
+            case 2: v[i] = FP::from_raw(static_cast<raw_type>(dist(gen) >> 8)); break;
+            default: v[i] = FP::from_raw(static_cast<raw_type>(dist(gen))); break;
+        }
+    }
+    return v;
+}
+
+template<typename FP>
+bool same(const std::vector<FP>& a, const std::vector<FP>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].raw() != b[i].raw()) return false;
+    }
+    return true;
+}
+
+template<typename FP>
+void test_format(const char* name) {
+    std::cout << name << ":\n";
+
+    // Odd length so the scalar tail runs after the vector body
+    constexpr size_t N = 1027;
+    auto a = make_input<FP>(N, 1);
+    auto b = make_input<FP>(N, 2);
+    auto c = make_input<FP>(N, 3);
+    std::vector<FP> out(N), ref(N);
+
+    batch::add(a, b, std::span(out));
+    for (size_t i = 0; i < N; ++i) ref[i] = a[i] + b[i];
+    check("add", same(out, ref));
+
+    batch::sub(a, b, std::span(out));
+    for (size_t i = 0; i < N; ++i) ref[i] = a[i] - b[i];
+    check("sub", same(out, ref));
+
+    batch::mul(a, b, std::span(out));
+    for (size_t i = 0; i < N; ++i) ref[i] = a[i] * b[i];
+    check("mul", same(out, ref));
+
+    batch::mul_add(a, b, c, std::span(out));
+    for (size_t i = 0; i < N; ++i) ref[i] = a[i] * b[i] + c[i];
+    check("mul_add", same(out, ref));
+
+    batch::scale(a, FP::min(), std::span(out));
+    for (size_t i = 0; i < N; ++i) ref[i] = a[i] * FP::min();
+    check("scale", same(out, ref));
+
+    FP lo = FP::from_raw(static_cast<typename FP::raw_type>(FP::min().raw() / 4));
+    FP hi = FP::from_raw(static_cast<typename FP::raw_type>(FP::max().raw() / 4));
+    batch::saturate(a, std::span(out), lo, hi);
+    for (size_t i = 0; i < N; ++i) ref[i] = (a[i] < lo) ? lo : (a[i] > hi ? hi : a[i]);
+    check("saturate", same(out, ref));
+
+    // In-place use
+    out = a;
+    batch::mul(out, b, std::span(out));
+    for (size_t i = 0; i < N; ++i) ref[i] = a[i] * b[i];
+    check("mul in place", same(out, ref));
+}
+
+template<int TotalBits, int FracBits>
+void test_both_policies(const char* wrap_name, const char* sat_name) {
+    test_format<FixedPoint<TotalBits, FracBits, true, OverflowPolicy::Wrap>>(wrap_name);
+    test_format<FixedPoint<TotalBits, FracBits, true, OverflowPolicy::Saturate>>(sat_name);
+}
+
+int main() {
+    std::cout << "Testing Batch Arithmetic\n";
+    std::cout << "========================\n\n";
+
+    test_both_policies<32, 16>("Q15.16 Wrap", "Q15.16 Saturate");
+    test_both_policies<32, 31>("Q0.31 Wrap", "Q0.31 Saturate");
+    test_both_policies<32, 1>("Q30.1 Wrap", "Q30.1 Saturate");
+    test_both_policies<16, 15>("Q0.15 Wrap", "Q0.15 Saturate");
+    test_both_policies<16, 8>("Q7.8 Wrap", "Q7.8 Saturate");
+    test_both_policies<8, 7>("Q0.7 Wrap", "Q0.7 Saturate");
+
+    std::cout << "\n" << (failures == 0 ? "All batch tests passed!" : "Batch tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+#include <fixp/dsp.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::dsp;
+
+// RBJ cookbook section normalised to a0 = 1; peaking if gain_db != 0, else lowpass
+static std::array<double, 5> design(double f0, double q, double gain_db) {
+    const double w = 2.0 * std::numbers::pi * f0;
+    const double alpha = std::sin(w) / (2.0 * q);
+    const double cw = std::cos(w);
+    std::array<double, 6> c;
+    if (gain_db == 0.0) {
+        c = {(1 - cw) / 2, 1 - cw, (1 - cw) / 2, 1 + alpha, -2 * cw, 1 - alpha};
+    } else {
+        const double a = std::pow(10.0, gain_db / 40.0);
+        c = {1 + alpha * a, -2 * cw, 1 - alpha * a, 1 + alpha / a, -2 * cw, 1 - alpha / a};
+    }
+    return {c[0] / c[3], c[1] / c[3], c[2] / c[3], c[4] / c[3], c[5] / c[3]};
+}
+
+template<typename CT>
+BiquadCoefficients<CT> quantize(const std::array<double, 5>& c) {
+    return {CT(c[0]), CT(c[1]), CT(c[2]), CT(c[3]), CT(c[4])};
+}
+
+// Per-channel reference with 128-bit sums, rounded once per section output
+template<typename FP, typename CT, BiquadForm Form>
+struct Reference {
+    using raw_type = typename FP::raw_type;
+    static constexpr int F = CT::fractional_bits;
+
+    std::vector<BiquadCoefficients<CT>> coeffs;
+    std::vector<std::array<__int128_t, 4>> state;
+
+    static raw_type narrow(__int128_t acc) {
+        acc = (acc + (__int128_t(1) << (F - 1))) >> F;
+        if constexpr (FP::overflow_policy == OverflowPolicy::Saturate) {
+            if (acc > std::numeric_limits<raw_type>::max()) acc = std::numeric_limits<raw_type>::max();
+            if (acc < std::numeric_limits<raw_type>::min()) acc = std::numeric_limits<raw_type>::min();
+        }
+        return static_cast<raw_type>(acc);
+    }
+
+    raw_type process(raw_type x) {
+        for (size_t s = 0; s < coeffs.size(); ++s) {
+            const __int128_t b0 = coeffs[s].b0.raw(), b1 = coeffs[s].b1.raw();
+            const __int128_t b2 = coeffs[s].b2.raw(), a1 = coeffs[s].a1.raw();
+            const __int128_t a2 = coeffs[s].a2.raw();
+            auto& st = state[s];
+            if constexpr (Form == BiquadForm::DirectForm1) {
+                const raw_type y = narrow(b0 * x + b1 * st[0] + b2 * st[1] - a1 * st[2] - a2 * st[3]);
+                st = {x, st[0], y, st[2]};
+                x = y;
+            } else {
+                const raw_type y = narrow(b0 * x + st[0]);
+                st[0] = b1 * x - a1 * y + st[1];
+                st[1] = b2 * x - a2 * y;
+                x = y;
+            }
+        }
+        return x;
+    }
+};
+
+template<typename FP, typename CT, size_t Sections, size_t Channels, BiquadForm Form>
+struct Harness {
+    BiquadCascade<FP, Sections, Channels, Form, CT> cascade;
+    std::vector<Reference<FP, CT, Form>> reference;
+
+    explicit Harness(double gain_db) : reference(Channels) {
+        for (size_t c = 0; c < Channels; ++c) {
+            for (size_t s = 0; s < Sections; ++s) {
+                const double f0 = 0.02 + 0.37 * static_cast<double>((c * 7 + s * 3) % 11) / 10.0;
+                const auto q = quantize<CT>(design(f0, 0.6 + 0.2 * static_cast<double>(s),
+                                                   gain_db));
+                cascade.set_section(s, c, q);
+                reference[c].coeffs.push_back(q);
+                reference[c].state.push_back({});
+            }
+        }
+    }
+
+    std::vector<FP> run_reference(const std::vector<FP>& x) {
+        std::vector<FP> y(x.size());
+        for (size_t i = 0; i < x.size(); ++i) {
+            y[i] = FP::from_raw(reference[i % Channels].process(x[i].raw()));
+        }
+        return y;
+    }
+};
+
+template<typename FP>
+std::vector<FP> random_signal(std::mt19937& gen, size_t n, double amplitude) {
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::vector<FP> x(n);
+    for (auto& v : x) v = FP(dist(gen));
+    return x;
+}
+
+template<typename FP>
+bool same(const std::vector<FP>& a, const std::vector<FP>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].raw() != b[i].raw()) return false;
+    }
+    return true;
+}
+
+// Whole signal in one call, then in frames of varying length, against the reference
+template<typename FP, typename CT, size_t Sections, size_t Channels, BiquadForm Form>
+bool matches_reference(std::mt19937& gen, double amplitude, double gain_db) {
+    const size_t frames = 257;
+    const auto x = random_signal<FP>(gen, frames * Channels, amplitude);
+
+    Harness<FP, CT, Sections, Channels, Form> h(gain_db);
+    const auto expected = h.run_reference(x);
+    std::vector<FP> y(x.size());
+    h.cascade.process(x, y);
+    bool ok = same(y, expected);
+
+    h.cascade.reset();
+    std::vector<FP> z(x.size());
+    for (size_t f = 0, len = 1; f < frames; f += len, len = len % 5 + 1) {
+        const size_t count = std::min(len, frames - f) * Channels;
+        h.cascade.process(std::span<const FP>(x).subspan(f * Channels, count),
+                          std::span<FP>(z).subspan(f * Channels, count));
+    }
+    ok = ok && same(z, expected);
+
+    // In place
+    h.cascade.reset();
+    std::vector<FP> w = x;
+    h.cascade.process(w, w);
+    return ok && same(w, expected);
+}
+
+// Worst error against a double-precision cascade, in units of full scale
+template<typename FP, typename CT, BiquadForm Form>
+double error_vs_double(std::mt19937& gen) {
+    constexpr size_t Sections = 3, Channels = 4;
+    const auto x = random_signal<FP>(gen, 2000 * Channels, 0.25);
+    Harness<FP, CT, Sections, Channels, Form> h(0.0);
+    std::vector<FP> y(x.size());
+    h.cascade.process(x, y);
+
+    std::array<std::array<std::array<double, 4>, Sections>, Channels> st{};
+    double worst = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        const size_t c = i % Channels;
+        double v = static_cast<double>(x[i]);
+        for (size_t s = 0; s < Sections; ++s) {
+            const auto& q = h.reference[c].coeffs[s];
+            auto& d = st[c][s];
+            const double out = static_cast<double>(q.b0) * v + static_cast<double>(q.b1) * d[0] +
+                               static_cast<double>(q.b2) * d[1] - static_cast<double>(q.a1) * d[2] -
+                               static_cast<double>(q.a2) * d[3];
+            d = {v, d[0], out, d[2]};
+            v = out;
+        }
+        worst = std::max(worst, std::abs(v - static_cast<double>(y[i])));
+    }
+    return worst;
+}
+
+int main() {
+    std::cout << "=== BiquadCascade Tests ===\n\n";
+    std::mt19937 gen(1234);
+
+    using Q31 = FixedPoint<32, 31>;
+    using Q31S = FixedPoint<32, 31, true, OverflowPolicy::Saturate>;
+    using Q30 = FixedPoint<32, 30>;
+    using Q16 = FixedPoint<32, 16>;
+    using Q16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+    using Q15 = FixedPoint<16, 15>;
+    using Q15S = FixedPoint<16, 15, true, OverflowPolicy::Saturate>;
+    using Q14 = FixedPoint<16, 14>;
+    constexpr auto DF1 = BiquadForm::DirectForm1;
+    constexpr auto TDF2 = BiquadForm::TransposedDirectForm2;
+
+    std::cout << "Bit-exact against a 128-bit reference:\n";
+    check("Q0.31 data, Q1.30 coeffs, DF1, 1 channel",
+          matches_reference<Q31, Q30, 2, 1, DF1>(gen, 0.5, 0.0));
+    check("Q0.31 data, Q1.30 coeffs, DF1, 3 channels",
+          matches_reference<Q31, Q30, 3, 3, DF1>(gen, 0.5, 0.0));
+    check("Q0.31 data, Q1.30 coeffs, DF1, 13 channels",
+          matches_reference<Q31, Q30, 4, 13, DF1>(gen, 0.5, 0.0));
+    check("Q0.31 data, Q1.30 coeffs, TDF2, 5 channels",
+          matches_reference<Q31, Q30, 3, 5, TDF2>(gen, 0.5, 0.0));
+    check("Q0.31 data, Q1.30 coeffs, TDF2, 16 channels",
+          matches_reference<Q31, Q30, 2, 16, TDF2>(gen, 0.5, 0.0));
+    check("Q15.16 data and coeffs, DF1, 6 channels",
+          matches_reference<Q16, Q16, 2, 6, DF1>(gen, 100.0, 0.0));
+    check("Q15.16 data and coeffs, TDF2, 9 channels",
+          matches_reference<Q16, Q16, 2, 9, TDF2>(gen, 100.0, 0.0));
+    check("Q0.15 data, Q1.14 coeffs, DF1, 7 channels",
+          matches_reference<Q15, Q14, 2, 7, DF1>(gen, 0.5, 0.0));
+    check("Q0.15 data, Q1.14 coeffs, TDF2, 7 channels",
+          matches_reference<Q15, Q14, 2, 7, TDF2>(gen, 0.5, 0.0));
+
+    std::cout << "\nSaturation (+12 dB peaking sections on full-scale input):\n";
+    check("Q0.31 Saturate, DF1, 11 channels",
+          matches_reference<Q31S, Q30, 2, 11, DF1>(gen, 0.99, 12.0));
+    check("Q0.31 Saturate, TDF2, 11 channels",
+          matches_reference<Q31S, Q30, 2, 11, TDF2>(gen, 0.99, 12.0));
+    check("Q15.16 Saturate, DF1, 4 channels",
+          matches_reference<Q16S, Q16, 1, 4, DF1>(gen, 30000.0, 12.0));
+    check("Q0.15 Saturate, TDF2, 3 channels",
+          matches_reference<Q15S, Q14, 2, 3, TDF2>(gen, 0.99, 12.0));
+
+    std::cout << "\nAgainst a double-precision cascade:\n";
+    const double df1 = error_vs_double<Q31, Q30, DF1>(gen);
+    const double tdf2 = error_vs_double<Q31, Q30, TDF2>(gen);
+    std::cout << "  DF1 worst error " << df1 << ", TDF2 worst error " << tdf2 << "\n";
+    // The coefficients are quantised identically, so only rounding differs
+    check("DF1 within 2^-24 of double", df1 < std::ldexp(1.0, -24));
+    check("TDF2 within 2^-24 of double", tdf2 < std::ldexp(1.0, -24));
+
+    std::cout << "\nState handling:\n";
+    {
+        BiquadCascade<Q31, 1, 2, DF1, Q30> c;
+        c.set_section(0, BiquadCoefficients<Q30>{Q30(0.5), Q30(0.25), Q30(0.0), Q30(0.0),
+                                                 Q30(0.0)});
+        c.set_section(0, 1, BiquadCoefficients<Q30>{Q30(0.0), Q30(0.0), Q30(1.0), Q30(0.0),
+                                                    Q30(0.0)});
+        std::vector<Q31> x = {Q31(0.5), Q31(-0.5), Q31(0.0), Q31(0.0), Q31(0.0), Q31(0.0)};
+        std::vector<Q31> y(x.size());
+        c.process(x, y);
+        check("per-channel coefficients",
+              y[0] == Q31(0.25) && y[2] == Q31(0.125) && y[4] == Q31(0.0) &&
+              y[1] == Q31(0.0) && y[3] == Q31(0.0) && y[5] == Q31(-0.5));
+        const auto back = c.coefficients(0, 1);
+        check("coefficients round-trip", back.b2 == Q30(1.0) && back.b0 == Q30(0.0));
+        c.reset();
+        std::vector<Q31> z(x.size());
+        c.process(x, z);
+        check("reset restarts from zero state", same(y, z));
+    }
+
+    std::cout << "\n=== Summary ===\n";
+    if (failures == 0) {
+        std::cout << "All tests passed!\n";
+        return 0;
+    }
+    std::cout << failures << " test(s) failed\n";
+    return 1;
+}
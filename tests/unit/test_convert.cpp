@@ -0,0 +1,150 @@
+#include <fixp/batch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+// Independent reference in long double: exact for every float and double input here
+template<typename FP>
+typename FP::raw_type reference_raw(long double x, batch::Rounding rounding) {
+    using raw_type = typename FP::raw_type;
+    if (std::isnan(x)) return 0;
+    long double v = std::ldexp(x, FP::fractional_bits);
+    if (rounding == batch::Rounding::HalfEven) {
+        v = std::nearbyint(v);
+    } else {
+        v = std::round(v);
+    }
+    if (v >= static_cast<long double>(std::numeric_limits<raw_type>::max())) {
+        return std::numeric_limits<raw_type>::max();
+    }
+    if (v <= static_cast<long double>(std::numeric_limits<raw_type>::min())) {
+        return std::numeric_limits<raw_type>::min();
+    }
+    return static_cast<raw_type>(v);
+}
+
+// Random values across and beyond the format's range, plus exact ties and
+// the special values; odd length so the scalar tail runs
+template<typename FP, typename Float>
+std::vector<Float> make_input(uint32_t seed) {
+    const double range = std::ldexp(1.0, FP::integer_bits + 1);
+    const double lsb = std::ldexp(1.0, -FP::fractional_bits);
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-range, range);
+    std::vector<Float> v(1031);
+    for (size_t i = 0; i < v.size(); ++i) {
+        const double tie = std::floor(dist(gen) / lsb) * lsb + 0.5 * lsb;
+        switch (gen() % 6) {
+            case 0: v[i] = static_cast<Float>(tie); break;
+            case 1: v[i] = static_cast<Float>(dist(gen) * 1e-3); break;
+            default: v[i] = static_cast<Float>(dist(gen)); break;
+        }
+    }
+    const Float specials[] = {
+        std::numeric_limits<Float>::quiet_NaN(), std::numeric_limits<Float>::infinity(),
+        -std::numeric_limits<Float>::infinity(), Float(0), -Float(0),
+        static_cast<Float>(0.5 * lsb), static_cast<Float>(-0.5 * lsb),
+        static_cast<Float>(1.5 * lsb), static_cast<Float>(-2.5 * lsb),
+        std::nextafter(static_cast<Float>(0.5 * lsb), Float(0)),
+        static_cast<Float>(std::ldexp(1.0, FP::integer_bits)),
+        static_cast<Float>(-std::ldexp(1.0, FP::integer_bits)),
+        std::numeric_limits<Float>::max(), std::numeric_limits<Float>::lowest(),
+    };
+    for (size_t i = 0; i < std::size(specials); ++i) v[i * 37] = specials[i];
+    return v;
+}
+
+template<typename FP>
+bool from_float_matches(batch::Rounding rounding) {
+    const auto in = make_input<FP, float>(11);
+    std::vector<FP> out(in.size());
+    batch::from_float(in, std::span(out), rounding);
+    for (size_t i = 0; i < in.size(); ++i) {
+        if (out[i].raw() != reference_raw<FP>(in[i], rounding)) return false;
+    }
+    return true;
+}
+
+template<typename FP>
+bool from_double_matches(batch::Rounding rounding) {
+    const auto in = make_input<FP, double>(12);
+    std::vector<FP> out(in.size());
+    batch::from_double(in, std::span(out), rounding);
+    for (size_t i = 0; i < in.size(); ++i) {
+        if (out[i].raw() != reference_raw<FP>(in[i], rounding)) return false;
+    }
+    return true;
+}
+
+template<typename FP>
+bool to_float_matches() {
+    using raw_type = typename FP::raw_type;
+    std::mt19937 gen(13);
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<raw_type>::min(),
+                                                std::numeric_limits<raw_type>::max());
+    std::vector<FP> in(1031);
+    for (auto& x : in) x = FP::from_raw(static_cast<raw_type>(dist(gen)));
+    in[0] = FP::min();
+    in[1] = FP::max();
+    std::vector<float> f(in.size());
+    std::vector<double> d(in.size());
+    batch::to_float(in, std::span(f));
+    batch::to_double(in, std::span(d));
+    for (size_t i = 0; i < in.size(); ++i) {
+        const long double exact = std::ldexp(static_cast<long double>(in[i].raw()),
+                                             -FP::fractional_bits);
+        if (f[i] != static_cast<float>(exact) || d[i] != static_cast<double>(exact)) return false;
+    }
+    return true;
+}
+
+template<typename FP>
+void test_format(const char* name) {
+    std::cout << name << ":\n";
+    check("from_float, ties to even", from_float_matches<FP>(batch::Rounding::HalfEven));
+    check("from_float, ties away", from_float_matches<FP>(batch::Rounding::HalfAway));
+    check("from_double, ties to even", from_double_matches<FP>(batch::Rounding::HalfEven));
+    check("from_double, ties away", from_double_matches<FP>(batch::Rounding::HalfAway));
+    check("to_float and to_double", to_float_matches<FP>());
+}
+
+int main() {
+    std::cout << "=== Float Conversion Tests ===\n\n";
+
+    test_format<FixedPoint<32, 16>>("Q15.16");
+    test_format<FixedPoint<32, 16, true, OverflowPolicy::Saturate>>("Q15.16 Saturate");
+    test_format<FixedPoint<32, 31>>("Q0.31");
+    test_format<FixedPoint<32, 0>>("Q31.0");
+    test_format<FixedPoint<16, 15>>("Q0.15");
+    test_format<FixedPoint<16, 8, true, OverflowPolicy::Saturate>>("Q7.8 Saturate");
+    test_format<FixedPoint<8, 7>>("Q0.7 (scalar)");
+    test_format<FixedPoint<16, 12, false>>("UQ4.12 (scalar)");
+    test_format<FixedPoint<64, 32>>("Q31.32 (scalar)");
+
+    std::cout << "Round trip:\n";
+    {
+        using Q15 = FixedPoint<16, 15>;
+        std::vector<Q15> all(65536), back(65536);
+        for (size_t i = 0; i < all.size(); ++i) {
+            all[i] = Q15::from_raw(static_cast<int16_t>(i));
+        }
+        std::vector<float> f(all.size());
+        batch::to_float(all, std::span(f));
+        batch::from_float(f, std::span(back));
+        check("every Q0.15 value survives float", all == back);
+    }
+
+    std::cout << "\n=== Summary ===\n";
+    if (failures == 0) {
+        std::cout << "All tests passed!\n";
+        return 0;
+    }
+    std::cout << failures << " test(s) failed\n";
+    return 1;
+}
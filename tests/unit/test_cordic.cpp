@@ -0,0 +1,172 @@
+#include <fixp/math.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+using Q7_8 = FixedPoint<16, 8>;
+using Q1_30 = FixedPoint<32, 30>;
+using Q0_31 = FixedPoint<32, 31>;
+using Q31_32 = FixedPoint<64, 32>;
+using Q3_60 = FixedPoint<64, 60>;
+
+// The engine and the functions built on it are usable in constant expressions
+static_assert(sin(Q15_16(0.0)) == Q15_16(0.0));
+static_assert(cos(Q15_16(0.0)) == Q15_16(1.0));
+static_assert(cos(Q0_31(0.0)) == Q0_31::max());
+static_assert(Cordic<16>::iterations == Cordic<16>::work_bits);
+static_assert(Cordic<30>::hyperbolic_iterations == Cordic<30>::iterations + 2);  // 4, 13 repeat
+
+// Exact value of a CORDIC work-format integer
+template<int F>
+long double work_value(typename Cordic<F>::work_type v) {
+    return std::ldexp(static_cast<long double>(v), -Cordic<F>::work_bits);
+}
+
+struct Errors {
+    long double sin = 0, cos = 0, tan = 0, atan2 = 0, atan = 0;
+};
+
+// Largest errors in output LSBs over random raw inputs in [-range, range]
+template<typename FP>
+Errors measure(long double range) {
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<long double> dist(-range, range);
+    const long double lsb = std::ldexp(1.0L, -FP::fractional_bits);
+    Errors e;
+    for (int i = 0; i < 20000; ++i) {
+        const FP a(static_cast<double>(dist(gen)));
+        const FP b(static_cast<double>(dist(gen)));
+        const long double x = value(a);
+        const long double y = value(b);
+
+        const auto sc = sincos(a);
+        e.sin = std::max(e.sin, std::abs(value(sc.sin) - clamp_to<FP>(std::sin(x))) / lsb);
+        e.cos = std::max(e.cos, std::abs(value(sc.cos) - clamp_to<FP>(std::cos(x))) / lsb);
+        if (sc.sin != sin(a) || sc.cos != cos(a)) e.sin = 1e9;
+
+        // tan amplifies the argument error by sec^2, so measure it in units of that
+        const long double t = std::tan(x);
+        if (std::abs(t) < value(FP::max()) / 2) {
+            e.tan = std::max(e.tan, std::abs(value(tan(a)) - t) / lsb / (1 + t * t));
+        }
+
+        const long double want = clamp_to<FP>(std::atan2(y, x));
+        e.atan2 = std::max(e.atan2, std::abs(value(atan2(b, a)) - want) / lsb);
+        e.atan = std::max(e.atan, std::abs(value(atan(a)) - clamp_to<FP>(std::atan(x))) / lsb);
+    }
+    return e;
+}
+
+template<typename FP>
+void test_format(const char* name, long double range, long double lsb_bound) {
+    std::cout << name << ":\n";
+    const Errors e = measure<FP>(range);
+    std::cout << "  max LSB error: sin " << static_cast<double>(e.sin) << ", cos "
+              << static_cast<double>(e.cos) << ", tan " << static_cast<double>(e.tan)
+              << ", atan2 " << static_cast<double>(e.atan2) << ", atan "
+              << static_cast<double>(e.atan) << "\n";
+    check("sin/cos within bound", e.sin <= lsb_bound && e.cos <= lsb_bound);
+    check("tan within bound", e.tan <= lsb_bound + 1);
+    check("atan2/atan within bound", e.atan2 <= lsb_bound && e.atan <= lsb_bound);
+}
+
+template<int F>
+void test_gains(const char* name) {
+    std::cout << name << " tables:\n";
+    using C = Cordic<F>;
+    long double k = 1, kh = 1;
+    for (int i = 0; i < C::iterations; ++i) k /= std::sqrt(1 + std::ldexp(1.0L, -2 * i));
+    for (int s : C::hyperbolic_shifts) kh *= std::sqrt(1 - std::ldexp(1.0L, -2 * s));
+    const long double ulp = std::ldexp(1.0L, -std::min(C::work_bits, 60));
+    check("circular gain", std::abs(work_value<F>(C::gain) - k) <= ulp);
+    check("hyperbolic gain", std::abs(work_value<F>(C::hyperbolic_gain) - kh) <= ulp);
+    check("inverse hyperbolic gain",
+          std::abs(work_value<F>(C::hyperbolic_gain_inverse) - 1 / kh) <= 2 * ulp);
+
+    bool tables = true;
+    for (int i = 0; i < C::iterations; ++i) {
+        tables = tables && std::abs(work_value<F>(C::atan_table[static_cast<size_t>(i)]) -
+                                    std::atan(std::ldexp(1.0L, -i))) <= ulp;
+    }
+    for (size_t n = 0; n < C::atanh_table.size(); ++n) {
+        tables = tables && std::abs(work_value<F>(C::atanh_table[n]) -
+                                    std::atanh(std::ldexp(1.0L, -C::hyperbolic_shifts[n]))) <= ulp;
+    }
+    check("atan/atanh tables", tables);
+}
+
+template<int F>
+void test_hyperbolic(const char* name) {
+    std::cout << name << " hyperbolic modes:\n";
+    using C = Cordic<F>;
+    using work_type = typename C::work_type;
+    const long double lsb = std::ldexp(1.0L, -F);
+    long double rot = 0, vec = 0;
+    for (int i = -100; i <= 100; ++i) {
+        const long double z = 1.1L * i / 100;
+        const auto v = C::sinhcosh(static_cast<work_type>(std::ldexp(z, C::work_bits)));
+        rot = std::max({rot, std::abs(work_value<F>(v.x) - std::cosh(z)) / lsb,
+                        std::abs(work_value<F>(v.y) - std::sinh(z)) / lsb});
+
+        // atanh(y / x) for |y / x| <= 0.8
+        const long double r = 0.8L * i / 100;
+        const auto w = C::vector_hyperbolic(
+            C::one / 2, static_cast<work_type>(std::ldexp(r / 2, C::work_bits)));
+        vec = std::max(vec, std::abs(work_value<F>(w.z) - std::atanh(r)) / lsb);
+    }
+    std::cout << "  max LSB error: sinh/cosh " << static_cast<double>(rot) << ", atanh "
+              << static_cast<double>(vec) << "\n";
+    check("sinh/cosh", rot <= 0.5);
+    check("atanh", vec <= 0.5);
+}
+
+void test_special_values() {
+    std::cout << "Special values:\n";
+    check("atan2(0, 0) is 0", atan2(Q15_16(0.0), Q15_16(0.0)) == Q15_16(0.0));
+    check("atan2(0, -1) is +pi", atan2(Q31_32(0.0), Q31_32(-1.0)) == Q31_32(3.14159265358979));
+    check("atan2 with the largest magnitudes", std::abs(static_cast<double>(
+        atan2(Q31_32::min(), Q31_32::min())) + 3 * M_PI / 4) < 1e-9);
+    check("atan2 saturates -3pi/4 in Q1.30", atan2(Q1_30::min(), Q1_30::min()) == Q1_30::min());
+    check("atan saturates pi/2 in Q0.15", atan(FixedPoint<16, 15>::max()) ==
+                                           FixedPoint<16, 15>(std::atan(32767.0 / 32768.0)));
+    // The nearest Q15.16 values to π/2 sit either side of the pole
+    check("tan saturates at the pole", tan(Q15_16::from_raw(102943)) == Q15_16::max() &&
+                                       tan(Q15_16::from_raw(102944)) == Q15_16::min());
+    check("Q31.32 reduction far from zero",
+          std::abs(static_cast<double>(sin(Q31_32(1e9))) - std::sin(1e9)) < 1e-9);
+}
+
+int main() {
+    std::cout << "Testing the Generic CORDIC Engine\n";
+    std::cout << "=================================\n\n";
+
+    test_gains<8>("Q.8");
+    test_gains<16>("Q.16");
+    test_gains<30>("Q.30");
+    test_gains<32>("Q.32");
+    test_gains<60>("Q.60");
+
+    test_format<Q7_8>("Q7.8", 100.0L, 1.0L);
+    test_format<Q15_16>("Q15.16", 30000.0L, 1.0L);
+    test_format<FixedPoint<16, 15>>("Q0.15", 1.0L, 1.0L);
+    test_format<Q1_30>("Q1.30", 2.0L, 1.0L);
+    test_format<Q0_31>("Q0.31", 1.0L, 1.0L);
+    test_format<Q31_32>("Q31.32", 1e6L, 1.0L);
+    test_format<Q3_60>("Q3.60", 7.0L, 1.0L);
+    // The 2^-64-turn phase costs up to 0.8 LSB here, plus the long double reference
+    test_format<FixedPoint<64, 62>>("Q1.62", 1.9L, 1.5L);
+
+    test_hyperbolic<16>("Q.16");
+    test_hyperbolic<30>("Q.30");
+    test_hyperbolic<32>("Q.32");
+
+    test_special_values();
+
+    std::cout << "\n" << (failures == 0 ? "All CORDIC tests passed!" : "CORDIC tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+#include <fixp/dispatch.hpp>
+#include <fixp/linalg.hpp>
+#include <fixp/table.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+template<typename FP>
+std::vector<FP> make_input(size_t n, uint32_t seed) {
+    using raw_type = typename FP::raw_type;
+    std::mt19937 gen(seed);
+    std::vector<FP> v(n);
+    for (auto& x : v) x = FP::from_raw(static_cast<raw_type>(gen()));
+    v[0] = FP::min();
+    v[1] = FP::max();
+    return v;
+}
+
+template<typename FP>
+bool matches_scalar() {
+    constexpr size_t N = 515;
+    auto a = make_input<FP>(N, 7);
+    auto b = make_input<FP>(N, 8);
+    auto c = make_input<FP>(N, 9);
+    std::vector<FP> out(N);
+
+    bool ok = true;
+    dispatch::add(a, b, std::span(out));
+    for (size_t i = 0; i < N; ++i) ok = ok && out[i] == a[i] + b[i];
+    dispatch::sub(a, b, std::span(out));
+    for (size_t i = 0; i < N; ++i) ok = ok && out[i] == a[i] - b[i];
+    dispatch::mul(a, b, std::span(out));
+    for (size_t i = 0; i < N; ++i) ok = ok && out[i] == a[i] * b[i];
+    dispatch::mul_add(a, b, c, std::span(out));
+    for (size_t i = 0; i < N; ++i) ok = ok && out[i] == a[i] * b[i] + c[i];
+    dispatch::scale(a, b[5], std::span(out));
+    for (size_t i = 0; i < N; ++i) ok = ok && out[i] == a[i] * b[5];
+    dispatch::saturate(a, std::span(out), FP(-0.25), FP(0.25));
+    for (size_t i = 0; i < N; ++i) {
+        ok = ok && out[i] == std::min(std::max(a[i], FP(-0.25)), FP(0.25));
+    }
+
+    std::vector<float> f(N), g(N);
+    batch::to_float(a, std::span(f));
+    dispatch::to_float(a, std::span(g));
+    ok = ok && f == g;
+    for (size_t i = 0; i < N; ++i) f[i] *= 1.75f;
+    std::vector<FP> ref(N);
+    for (auto rounding : {dispatch::Rounding::HalfEven, dispatch::Rounding::HalfAway}) {
+        batch::from_float(f, std::span(ref), rounding);
+        dispatch::from_float(f, std::span(out), rounding);
+        ok = ok && out == ref;
+    }
+    return ok;
+}
+
+// Products and sums modulo 2^64, rounded and narrowed as the kernels do
+static uint64_t product(int64_t a, int64_t b) {
+    return static_cast<uint64_t>(a * b);
+}
+
+static int32_t narrow(uint64_t acc, int frac_bits, bool saturate) {
+    const int64_t v = static_cast<int64_t>(acc + (uint64_t{1} << (frac_bits - 1))) >> frac_bits;
+    return static_cast<int32_t>(saturate ? std::clamp<int64_t>(v, INT32_MIN, INT32_MAX) : v);
+}
+
+template<typename T>
+static std::vector<T> random_vector(size_t n, std::mt19937& gen) {
+    std::vector<T> v(n);
+    for (auto& x : v) x = static_cast<T>(gen());
+    return v;
+}
+
+template<typename T>
+static bool dot_matches(std::mt19937& gen) {
+    constexpr size_t N = 515;
+    const auto a = random_vector<T>(N, gen);
+    const auto b = random_vector<T>(N, gen);
+    uint64_t ref = 0;
+    for (size_t i = 0; i < N; ++i) ref += product(a[i], b[i]);
+    int64_t acc = 0;
+    size_t i = dispatch::raw::dot(a.data(), b.data(), N, &acc);
+    uint64_t sum = static_cast<uint64_t>(acc);
+    for (; i < N; ++i) sum += product(a[i], b[i]);
+    return sum == ref;
+}
+
+// One channel j of an n-channel section, coefficients and state in rows of n
+static void df1_step(const int32_t* c, int32_t* s, int32_t* x, size_t j, size_t n,
+                     bool saturate) {
+    const int64_t in = x[j];
+    const int32_t y = narrow(product(c[j], in) + product(c[n + j], s[j]) +
+                                 product(c[2 * n + j], s[n + j]) -
+                                 product(c[3 * n + j], s[2 * n + j]) -
+                                 product(c[4 * n + j], s[3 * n + j]),
+                             30, saturate);
+    s[n + j] = s[j];
+    s[j] = static_cast<int32_t>(in);
+    s[3 * n + j] = s[2 * n + j];
+    s[2 * n + j] = y;
+    x[j] = y;
+}
+
+static void tdf2_step(const int32_t* c, int64_t* s, int32_t* x, size_t j, size_t n,
+                      bool saturate) {
+    const int64_t in = x[j];
+    const int32_t y = narrow(product(c[j], in) + static_cast<uint64_t>(s[j]), 30, saturate);
+    s[j] = static_cast<int64_t>(product(c[n + j], in) - product(c[3 * n + j], y) +
+                                static_cast<uint64_t>(s[n + j]));
+    s[n + j] = static_cast<int64_t>(product(c[2 * n + j], in) - product(c[4 * n + j], y));
+    x[j] = y;
+}
+
+// Three steps of 13 Q1.30 channels against the scalar model
+static bool biquad_matches(std::mt19937& gen, bool saturate) {
+    constexpr size_t N = 13;
+    const auto c = random_vector<int32_t>(5 * N, gen);
+    auto df1 = random_vector<int32_t>(4 * N, gen), df1_ref = df1;
+    auto tdf2 = random_vector<int64_t>(2 * N, gen), tdf2_ref = tdf2;
+    bool ok = true;
+    for (int step = 0; step < 3; ++step) {
+        const auto x = random_vector<int32_t>(N, gen);
+        auto y = x, y_ref = x;
+        size_t j = dispatch::raw::biquad_df1(c.data(), df1.data(), y.data(), N, 30, saturate);
+        for (; j < N; ++j) df1_step(c.data(), df1.data(), y.data(), j, N, saturate);
+        for (j = 0; j < N; ++j) df1_step(c.data(), df1_ref.data(), y_ref.data(), j, N, saturate);
+        ok = ok && y == y_ref && df1 == df1_ref;
+
+        y = x;
+        y_ref = x;
+        j = dispatch::raw::biquad_tdf2(c.data(), tdf2.data(), y.data(), N, 30, saturate);
+        for (; j < N; ++j) tdf2_step(c.data(), tdf2.data(), y.data(), j, N, saturate);
+        for (j = 0; j < N; ++j) tdf2_step(c.data(), tdf2_ref.data(), y_ref.data(), j, N, saturate);
+        ok = ok && y == y_ref && tdf2 == tdf2_ref;
+    }
+    return ok;
+}
+
+template<typename FP>
+static bool transform_matches(std::mt19937& gen) {
+    constexpr size_t N = 37;
+    linalg::Mat<FP, 4, 4> m;
+    for (auto& e : m.elements) e = FP::from_raw(static_cast<int32_t>(gen()) >> 12);
+    std::vector<linalg::Vec<FP, 4>> in(N), out(N);
+    for (auto& v : in) {
+        for (auto& e : v) e = FP::from_raw(static_cast<int32_t>(gen()) >> 8);
+    }
+    size_t i = dispatch::raw::transform4x4(
+        reinterpret_cast<const int32_t*>(m.elements.data()),
+        reinterpret_cast<const int32_t*>(in.data()), reinterpret_cast<int32_t*>(out.data()), N,
+        FP::fractional_bits, FP::overflow_policy == OverflowPolicy::Saturate);
+    for (; i < N; ++i) out[i] = m * in[i];
+    bool ok = true;
+    for (size_t k = 0; k < N; ++k) ok = ok && out[k] == m * in[k];
+    return ok;
+}
+
+template<typename Table>
+static bool lookup_matches(std::mt19937& gen) {
+    using FP = typename Table::value_type;
+    using raw_type = typename FP::raw_type;
+    constexpr size_t N = 101;
+    std::vector<FP> in(N), out(N);
+    for (auto& x : in) x = FP::from_raw(static_cast<raw_type>(gen()));
+    in[0] = FP::min();
+    in[1] = FP::max();
+    constexpr auto spec = Table::spec();
+    size_t i = dispatch::raw::table_lookup(batch::detail::raw_ptr(std::span<const FP>(in)),
+                                           batch::detail::raw_ptr(std::span<FP>(out)), N, spec);
+    for (; i < N; ++i) out[i] = Table::lookup(in[i]);
+    bool ok = true;
+    for (size_t k = 0; k < N; ++k) ok = ok && out[k] == Table::lookup(in[k]);
+    return ok;
+}
+
+bool kernels_match() {
+    std::mt19937 gen(11);
+    using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+    using Tanh = FunctionTable<FixedPoint<16, 12>, constexpr_math::tanh, 64,
+                               Interpolation::Cubic>;
+    using Sigmoid = FunctionTable<FixedPoint<32, 16>, constexpr_math::sigmoid, 1024,
+                                  Interpolation::Cubic, -16.0, 16.0>;
+    return dot_matches<int32_t>(gen) && dot_matches<int16_t>(gen) &&
+           biquad_matches(gen, false) && biquad_matches(gen, true) &&
+           transform_matches<FixedPoint<32, 16>>(gen) && transform_matches<Q15_16S>(gen) &&
+           lookup_matches<Tanh>(gen) && lookup_matches<Sigmoid>(gen);
+}
+
+bool all_formats_match() {
+    return matches_scalar<FixedPoint<32, 16>>() &&
+           matches_scalar<FixedPoint<32, 16, true, OverflowPolicy::Saturate>>() &&
+           matches_scalar<FixedPoint<32, 31, true, OverflowPolicy::Saturate>>() &&
+           matches_scalar<FixedPoint<16, 15>>() &&
+           matches_scalar<FixedPoint<16, 12, true, OverflowPolicy::Saturate>>();
+}
+
+int main() {
+    std::cout << "Testing Runtime Dispatch\n";
+    std::cout << "========================\n\n";
+
+    const dispatch::Isa detected = dispatch::detected_isa();
+    std::cout << "Detected ISA: " << dispatch::isa_name(detected) << "\n";
+    std::cout << "Active ISA:   " << dispatch::isa_name(dispatch::active_isa()) << "\n\n";
+
+    check("parse_isa round-trips", dispatch::parse_isa("avx2") == dispatch::Isa::AVX2 &&
+                                       dispatch::parse_isa("sse41") == dispatch::Isa::SSE41 &&
+                                       !dispatch::parse_isa("mmx").has_value());
+
+    const dispatch::Isa all[] = {dispatch::Isa::Scalar, dispatch::Isa::SSE41, dispatch::Isa::AVX2,
+                                 dispatch::Isa::AVX512, dispatch::Isa::NEON};
+    for (dispatch::Isa isa : all) {
+        if (!dispatch::force_isa(isa)) {
+            std::cout << "  " << dispatch::isa_name(isa) << ": not supported, skipped\n";
+            continue;
+        }
+        check(dispatch::isa_name(isa), dispatch::active_isa() == isa && all_formats_match());
+        check("  dot, biquad, transform and table kernels", kernels_match());
+    }
+
+    check("scalar is always supported", dispatch::force_isa(dispatch::Isa::Scalar));
+    dispatch::reset_isa();
+
+    std::cout << "\n" << (failures == 0 ? "All dispatch tests passed!" : "Dispatch tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
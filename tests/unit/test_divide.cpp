@@ -0,0 +1,132 @@
+#include <fixp/divide.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+using Q7_8 = FixedPoint<16, 8>;
+using UQ8_8 = FixedPoint<16, 8, false>;
+using Q1_30 = FixedPoint<32, 30>;
+using UQ16_16 = FixedPoint<32, 16, false>;
+using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+using Q31_32 = FixedPoint<64, 32>;
+using Q3_60 = FixedPoint<64, 60>;
+using UQ32_32 = FixedPoint<64, 32, false>;
+
+static_assert(std::is_same_v<Divisor<Q7_8>::operand_type, uint32_t>);
+static_assert(std::is_same_v<Divisor<Q15_16>::operand_type, uint64_t>);
+static_assert(std::is_same_v<Divisor<Q31_32>::operand_type, uint128>);
+static_assert(divide_by<3>(Q15_16(9.0)) == Q15_16(3.0));
+static_assert(Q15_16(1.0) / Divisor<Q15_16>(Q15_16(4.0)) == Q15_16(0.25));
+static_assert(reciprocal(Q15_16(-8.0)) == Q15_16(-0.125));
+
+// Random raw values with a uniformly distributed bit width, plus the extremes
+template<typename FP>
+std::vector<FP> samples(int count, uint64_t seed) {
+    using raw_type = typename FP::raw_type;
+    std::mt19937_64 gen(seed);
+    std::vector<FP> out{FP::from_raw(0), FP::from_raw(1), FP::max(), FP::min(),
+                        FP::from_raw(static_cast<raw_type>(FP::max().raw() - 1))};
+    if constexpr (FP::is_signed) out.push_back(FP::from_raw(-1));
+    const int magnitude_bits = FP::total_bits - (FP::is_signed ? 1 : 0);
+    for (int i = 0; i < count; ++i) {
+        const int bits = static_cast<int>(gen() % static_cast<uint64_t>(magnitude_bits)) + 1;
+        const uint64_t raw = bits == 64 ? gen() : gen() & ((uint64_t(1) << bits) - 1);
+        auto r = static_cast<raw_type>(raw);
+        if (FP::is_signed && gen() % 2 == 0) r = static_cast<raw_type>(-r);
+        out.push_back(FP::from_raw(r));
+    }
+    return out;
+}
+
+template<typename FP>
+void test_format(const char* name) {
+    std::cout << name << ":\n";
+    const auto xs = samples<FP>(2000, 1);
+    auto ds = samples<FP>(300, 2);
+    for (int k = 0; k < FP::total_bits - (FP::is_signed ? 1 : 0); ++k) {
+        ds.push_back(FP::from_raw(static_cast<typename FP::raw_type>(uint64_t(1) << k)));
+    }
+
+    bool same = true;
+    for (const FP d : ds) {
+        const Divisor<FP> divisor(d);
+        for (const FP x : xs) same = same && x / divisor == x / d;
+    }
+    check("Divisor matches operator/", same);
+
+    std::vector<FP> out(xs.size());
+    const Divisor<FP> divisor(ds[7]);
+    batch::divide(std::span<const FP>(xs), divisor, std::span<FP>(out));
+    bool batch_same = true;
+    for (size_t i = 0; i < xs.size(); ++i) batch_same = batch_same && out[i] == xs[i] / ds[7];
+    check("batch::divide matches operator/", batch_same);
+
+    bool constants = true;
+    for (const FP x : xs) {
+        constants = constants && divide_by<3>(x) == x / FP(3) && divide_by<2>(x) == x / FP(2) &&
+                    divide_by<7>(x) == x / FP(7) && divide_by<1.5>(x) == x / FP(1.5);
+        if constexpr (FP::is_signed) constants = constants && divide_by<-5>(x) == x / FP(-5);
+    }
+    check("divide_by matches operator/", constants);
+
+    // reciprocal is 1/x truncated toward zero, saturated where that does not fit
+    const long double scale = std::ldexp(1.0L, FP::fractional_bits);
+    const auto lo = static_cast<long double>(FP::min().raw());
+    const auto hi = static_cast<long double>(FP::max().raw());
+    bool reciprocals = true;
+    for (const FP x : xs) {
+        if (x.raw() == 0) continue;
+        const long double exact = std::trunc(scale * scale / static_cast<long double>(x.raw()));
+        const long double want = std::clamp(exact, lo, hi);
+        // long double holds 64 bits, so compare the 64-bit formats within one unit
+        const long double got = static_cast<long double>(reciprocal(x).raw());
+        reciprocals = reciprocals && std::abs(got - want) <= (FP::total_bits < 64 ? 0 : 1);
+        // and exactly against operator/ wherever 1 and 1/x are representable
+        if constexpr (FP::integer_bits >= 1) {
+            if (exact == want) reciprocals = reciprocals && reciprocal(x) == FP(1) / x;
+        }
+    }
+    check("reciprocal is 1/x truncated and saturated", reciprocals);
+}
+
+void test_special_values() {
+    std::cout << "Special values:\n";
+    const Divisor<Q15_16> zero(Q15_16(0.0));
+    check("division by zero saturates by the dividend sign",
+          Q15_16(2.0) / zero == Q15_16::max() && Q15_16(-2.0) / zero == Q15_16::min() &&
+          Q15_16(0.0) / zero == Q15_16::max());
+    check("reciprocal of zero is max()", reciprocal(Q15_16(0.0)) == Q15_16::max());
+    check("reciprocal saturates", reciprocal(Q15_16::from_raw(1)) == Q15_16::max() &&
+                                  reciprocal(Q15_16::from_raw(-1)) == Q15_16::min());
+    check("reciprocal matches FP(1) / x",
+          reciprocal(Q15_16(3.0)) == Q15_16(1.0) / Q15_16(3.0) &&
+          reciprocal(Q31_32(-7.0)) == Q31_32(1.0) / Q31_32(-7.0));
+    check("reciprocal of the most negative value", reciprocal(Q1_30::min()) == Q1_30(-0.5));
+    check("Divisor keeps its divisor", Divisor<Q31_32>(Q31_32(2.5)).divisor() == Q31_32(2.5));
+}
+
+int main() {
+    std::cout << "Testing Divide-Free Division\n";
+    std::cout << "============================\n\n";
+
+    test_format<Q7_8>("Q7.8");
+    test_format<UQ8_8>("UQ8.8");
+    test_format<Q15_16>("Q15.16");
+    test_format<Q15_16S>("Q15.16 saturating");
+    test_format<UQ16_16>("UQ16.16");
+    test_format<Q1_30>("Q1.30");
+    test_format<Q31_32>("Q31.32");
+    test_format<Q3_60>("Q3.60");
+    test_format<UQ32_32>("UQ32.32");
+
+    test_special_values();
+
+    std::cout << "\n" << (failures == 0 ? "All division tests passed!" : "Division tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+// Counters are opt-in; this test always builds with them
+#ifndef LIBFIXP_EVENT_COUNTERS
+#define LIBFIXP_EVENT_COUNTERS 1
+#endif
+
+#include <fixp/accumulator.hpp>
+#include <fixp/batch.hpp>
+#include <fixp/divide.hpp>
+#include <fixp/dsp.hpp>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+using Q7_8S = FixedPoint<16, 8, true, OverflowPolicy::Saturate>;
+using Q0_15S = FixedPoint<16, 15, true, OverflowPolicy::Saturate>;
+using Q31_32 = FixedPoint<64, 32>;
+
+static_assert(event_counters_enabled);
+// Constant evaluation counts nothing, so clamping constants stay constexpr
+static_assert(Q15_16S::max() + Q15_16S(1.0) == Q15_16S::max());
+
+// The counts f() adds, starting from zero
+template<typename F>
+EventCounts events(F f) {
+    reset_event_counts();
+    f();
+    return event_counts();
+}
+
+static bool only_saturations(const EventCounts& c, uint64_t n) {
+    return c.saturations == n && c.divisions_by_zero == 0 && c.precision_losses == 0;
+}
+
+void test_arithmetic() {
+    std::cout << "Arithmetic:\n";
+    const Q15_16S big(30000.0), one(1.0);
+    check("in-range arithmetic counts nothing", only_saturations(events([&] {
+              (void)(one + one - one * Q15_16S(3.0));
+              (void)(-one);
+          }), 0));
+    check("add, sub, mul and neg count saturations", only_saturations(events([&] {
+              (void)(big + big);
+              (void)(-big - big);
+              (void)(big * big);
+              (void)(-Q15_16S::min());
+          }), 4));
+    check("16-bit formats", only_saturations(events([] {
+              (void)(Q7_8S(100.0) + Q7_8S(100.0));
+              (void)(Q0_15S(-1.0) * Q0_15S(-1.0));
+          }), 2));
+    check("wrapping formats count nothing", only_saturations(events([] {
+              (void)(Q15_16(30000.0) + Q15_16(30000.0));
+          }), 0));
+    check("a saturating tag counts", only_saturations(events([] {
+              (void)add(Q15_16(30000.0), Q15_16(30000.0), saturating);
+          }), 1));
+    check("fixed_cast counts", only_saturations(events([] {
+              (void)fixed_cast<Q7_8S>(Q15_16(1000.0));
+              (void)fixed_cast<Q7_8S>(Q15_16(100.0));
+          }), 1));
+    check("Accumulator::result counts", only_saturations(events([] {
+              Accumulator<Q7_8S> acc;
+              for (int i = 0; i < 10; ++i) acc.mac(Q7_8S(10.0), Q7_8S(10.0));
+              (void)acc.result();
+          }), 1));
+}
+
+void test_division() {
+    std::cout << "Division:\n";
+    const auto c = events([] {
+        (void)(Q15_16(1.0) / Q15_16(0.0));
+        (void)(Q15_16(1.0) / Q15_16(2.0));
+        (void)(Q7_8S(1.0) / Q15_16(0.0)); // mixed formats
+        (void)(Q15_16(3.0) / Divisor<Q15_16>(Q15_16(0.0)));
+        (void)reciprocal(Q15_16(0.0));
+    });
+    check("division by zero", c.divisions_by_zero == 4 && c.saturations == 0);
+    check("reciprocal saturation", only_saturations(events([] {
+              (void)reciprocal(Q15_16::from_raw(1));
+              (void)reciprocal(Q15_16::from_raw(-1));
+              (void)reciprocal(Q15_16(4.0));
+          }), 2));
+}
+
+void test_conversions() {
+    std::cout << "Float conversions:\n";
+    const auto exact = events([] {
+        (void)Q15_16(0.5);
+        (void)Q15_16S(-3.25f);
+        (void)static_cast<float>(Q15_16(100.75));
+        (void)static_cast<double>(Q31_32(1e9));
+    });
+    check("exact conversions count nothing", only_saturations(exact, 0));
+    const auto lossy = events([] {
+        (void)Q15_16(0.1);
+        (void)Q7_8S(0.3f);
+        (void)static_cast<float>(Q15_16::from_raw(0x12345679));
+        (void)static_cast<double>(Q31_32::from_raw(0x123456789abcdef1));
+    });
+    check("rounding conversions count precision loss",
+          lossy.precision_losses == 4 && lossy.saturations == 0);
+    check("out-of-range input counts a saturation", only_saturations(events([] {
+              (void)Q15_16S(1e6);
+              (void)Q15_16S(-1e6f);
+          }), 2));
+
+    const std::vector<float> in{0.5f, 0.1f, 1e6f, -1e6f, 2.0f};
+    std::vector<Q15_16> out(in.size());
+    const auto from = events([&] { batch::from_float(in, std::span(out)); });
+    check("batch::from_float", from.saturations == 2 && from.precision_losses == 1);
+    const std::vector<Q15_16> raw{Q15_16::from_raw(0x12345679), Q15_16(2.5)};
+    std::vector<float> floats(raw.size());
+    const auto to = events([&] { batch::to_float(raw, std::span(floats)); });
+    check("batch::to_float", to.precision_losses == 1 && to.saturations == 0);
+}
+
+void test_batch_and_dsp() {
+    std::cout << "Batch and DSP:\n";
+    std::vector<Q15_16S> a(100, Q15_16S(30000.0)), b(100, Q15_16S(1.0)), out(100);
+    a[10] = Q15_16S(1.0);
+    check("batch::add counts every clamped element", only_saturations(events([&] {
+              batch::add(a, a, std::span(out));
+          }), 99));
+    check("batch::mul_add", only_saturations(events([&] {
+              batch::mul_add(a, b, a, std::span(out));
+          }), 99));
+
+    // Eight channels, which would take the SIMD kernels in an uncounted build
+    dsp::BiquadCascade<Q15_16S, 1, 8> loud;
+    loud.set_section(0, {Q15_16S(8.0), Q15_16S(0.0), Q15_16S(0.0), Q15_16S(0.0), Q15_16S(0.0)});
+    std::vector<Q15_16S> signal(8, Q15_16S(10000.0));
+    check("a clipping biquad cascade", only_saturations(events([&] {
+              loud.process(signal, std::span(signal));
+          }), 8));
+}
+
+void test_threads() {
+    std::cout << "Threads:\n";
+    reset_event_counts();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            const Q15_16S big(30000.0);
+            for (int i = 0; i < 1000; ++i) (void)(big + big);
+        });
+    }
+    for (auto& t : threads) t.join();
+    check("exited threads are kept", event_counts().saturations == 4000);
+
+    (void)(Q15_16S::max() + Q15_16S::max());
+    check("and added to live ones", event_counts().saturations == 4001);
+    reset_event_counts();
+    check("reset clears both", event_counts().saturations == 0);
+    (void)(Q15_16S::max() + Q15_16S::max());
+    check("counting resumes after a reset", event_counts().saturations == 1);
+}
+
+int main() {
+    std::cout << "Testing Event Counters\n";
+    std::cout << "======================\n\n";
+
+    test_arithmetic();
+    test_division();
+    test_conversions();
+    test_batch_and_dsp();
+    test_threads();
+
+    std::cout << "\n" << (failures == 0 ? "All event counter tests passed!"
+                                        : "Event counter tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
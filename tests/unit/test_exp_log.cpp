@@ -0,0 +1,182 @@
+#include <fixp/math.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+using Q7_8 = FixedPoint<16, 8>;
+using Q0_15 = FixedPoint<16, 15>;
+using Q7_24 = FixedPoint<32, 24>;
+using Q1_30 = FixedPoint<32, 30>;
+using UQ16_16 = FixedPoint<32, 16, false>;
+using Q31_32 = FixedPoint<64, 32>;
+
+// The polynomials are generated and evaluated in constant expressions
+static_assert(exp2(Q15_16(0.0)) == Q15_16(1.0));
+static_assert(log2(Q15_16(1.0)) == Q15_16(0.0));
+static_assert(exp2(Q15_16(3.0)) == Q15_16(8.0));
+static_assert(fixp::detail::Log2Poly<Q15_16, Accuracy::Precise>::work_bits == 30);
+static_assert(fixp::detail::Exp2Poly<Q7_8, Accuracy::Precise>::work_bits == 30);
+static_assert(fixp::detail::Log2Poly<Q31_32, Accuracy::Precise>::work_bits == 62);
+
+struct Errors {
+    long double exp2 = 0, exp = 0, log2 = 0, log = 0;
+};
+
+// Largest errors in output LSBs over random raw inputs in [-range, range].
+// exp2/exp are measured relative to 2^-(total_bits - 1) of the result, the
+// precision of the storage.
+template<typename FP, Accuracy A>
+Errors measure(long double range) {
+    std::mt19937_64 gen(11);
+    using raw_type = typename FP::raw_type;
+    const long double lo = std::max(-range, value(FP::min()));
+    const long double hi = std::min(range, value(FP::max()));
+    std::uniform_int_distribution<int64_t> dist(
+        static_cast<int64_t>(std::ldexp(lo, FP::fractional_bits)),
+        static_cast<int64_t>(std::ldexp(hi, FP::fractional_bits)));
+    const long double lsb = std::ldexp(1.0L, -FP::fractional_bits);
+    const long double top = std::ldexp(1.0L, FP::total_bits - 1);
+    const auto relative = [&](long double got, long double want) {
+        return std::abs(got - want) / lsb / std::max(1.0L, want / lsb / top);
+    };
+    Errors e;
+    for (int i = 0; i < 20000; ++i) {
+        const FP x = FP::from_raw(static_cast<raw_type>(dist(gen)));
+        const long double v = value(x);
+        e.exp2 = std::max(e.exp2, relative(value(exp2<A>(x)), clamp_to<FP>(std::exp2(v))));
+        e.exp = std::max(e.exp, relative(value(exp<A>(x)), clamp_to<FP>(std::exp(v))));
+        if (v > 0) {
+            e.log2 = std::max(e.log2, std::abs(value(log2<A>(x)) - clamp_to<FP>(std::log2(v))) / lsb);
+            e.log = std::max(e.log, std::abs(value(log<A>(x)) - clamp_to<FP>(std::log(v))) / lsb);
+        }
+    }
+    return e;
+}
+
+// 64-bit formats: the Q62 polynomial caps exp2 and exp at one LSB plus 2^-59
+// of the result, swept over every exponent with a representable result
+template<typename FP>
+void test_wide_bound(const char* name) {
+    std::cout << name << " (64-bit bound):\n";
+    std::mt19937_64 gen(17);
+    using raw_type = typename FP::raw_type;
+    constexpr int F = FP::fractional_bits;
+    const long double top = value(FP::max());
+    const auto excess = [](long double got, long double want) {
+        // Error beyond one LSB, as a fraction of the result
+        const long double lsb_error = std::abs(got - want) * std::ldexp(1.0L, F);
+        return lsb_error <= 1 ? 0.0L : (lsb_error - 1) / (want * std::ldexp(1.0L, F));
+    };
+    long double worst_exp2 = 0, worst_exp = 0, worst_lsb = 0, small_lsb = 0;
+    const int lowest = std::max(-F, -(1 << FP::integer_bits));
+    for (int k = lowest; k < FP::integer_bits; ++k) {
+        std::uniform_int_distribution<int64_t> dist(0, (int64_t(1) << F) - 1);
+        for (int i = 0; i < 2000; ++i) {
+            const auto raw = static_cast<raw_type>(static_cast<int64_t>(k) * (int64_t(1) << F) +
+                                                   dist(gen));
+            const FP x = FP::from_raw(raw);
+            const long double v = value(x);
+            const long double want2 = clamp_to<FP>(std::exp2(v));
+            const long double got2 = value(exp2(x));
+            worst_exp2 = std::max(worst_exp2, excess(got2, want2));
+            worst_lsb = std::max(worst_lsb, std::abs(got2 - want2) * std::ldexp(1.0L, F));
+            if (want2 < std::ldexp(1.0L, 59 - F)) {
+                small_lsb = std::max(small_lsb, std::abs(got2 - want2) * std::ldexp(1.0L, F));
+            }
+            const long double want = std::exp(v);
+            if (want < top) worst_exp = std::max(worst_exp, excess(value(exp(x)), want));
+        }
+    }
+    std::cout << "  max exp2 error " << static_cast<double>(worst_lsb) << " LSB\n";
+    const long double cap = std::ldexp(1.0L, -59);
+    check("exp2 within 1 LSB + 2^-59 of the result", worst_exp2 <= cap);
+    check("exp within 1 LSB + 2^-59 of the result", worst_exp <= cap);
+    check("exp2 within 1 LSB below 2^(59 - F)", small_lsb <= 1);
+}
+
+template<typename FP>
+void test_format(const char* name, long double range, long double exp_bound,
+                 long double log_bound) {
+    std::cout << name << ":\n";
+    const Errors p = measure<FP, Accuracy::Precise>(range);
+    const Errors f = measure<FP, Accuracy::Fast>(range);
+    std::cout << "  max LSB error: exp2 " << static_cast<double>(p.exp2) << ", exp "
+              << static_cast<double>(p.exp) << ", log2 " << static_cast<double>(p.log2)
+              << ", log " << static_cast<double>(p.log) << " (Fast: "
+              << static_cast<double>(f.exp2) << ", " << static_cast<double>(f.exp) << ", "
+              << static_cast<double>(f.log2) << ", " << static_cast<double>(f.log) << ")\n";
+    check("Precise exp2/exp", p.exp2 <= exp_bound && p.exp <= exp_bound);
+    check("Precise log2/log", p.log2 <= log_bound && p.log <= log_bound);
+    check("Fast within 16 LSB", f.exp2 <= 16 && f.exp <= 16 && f.log2 <= 16 && f.log <= 16);
+}
+
+void test_special_values() {
+    std::cout << "Special values:\n";
+    check("pow(2, 3) is exact", pow(Q15_16(2.0), Q15_16(3.0)) == Q15_16(8.0));
+    check("pow(9, 0.5) is 3", std::abs(static_cast<double>(pow(Q15_16(9.0), Q15_16(0.5))) - 3) <
+                                  2.0 / 65536);
+    check("pow of a non-positive base is 0", pow(Q15_16(-2.0), Q15_16(2.0)) == Q15_16(0.0));
+    check("exp2 saturates", exp2(Q15_16(15.0)) == Q15_16::max() &&
+                            exp(Q15_16(20.0)) == Q15_16::max());
+    check("exp2 underflows to 0", exp2(Q15_16(-17.5)) == Q15_16(0.0) &&
+                                  exp(Q15_16(-20.0)) == Q15_16(0.0));
+    check("log of non-positive values is min()", log2(Q15_16(0.0)) == Q15_16::min() &&
+                                                  log(Q15_16(-1.0)) == Q15_16::min());
+    check("log2 of powers of two is exact", log2(Q31_32(1024.0)) == Q31_32(10.0) &&
+                                            log2(Q7_8(0.25)) == Q7_8(-2.0));
+    check("exp(1) in Q1.30", exp(Q1_30(1.0)) == Q1_30::max());
+}
+
+template<typename FP>
+void test_batch(const char* name) {
+    std::cout << name << " batch:\n";
+    std::mt19937_64 gen(3);
+    std::uniform_int_distribution<int64_t> dist(static_cast<int64_t>(FP::min().raw()),
+                                                static_cast<int64_t>(FP::max().raw()));
+    std::vector<FP> in(1003), e2(in.size()), e(in.size()), l2(in.size()), l(in.size());
+    for (auto& x : in) x = FP::from_raw(static_cast<typename FP::raw_type>(dist(gen)));
+    const std::span<const FP> input(in);
+    batch::exp2(input, std::span<FP>(e2));
+    batch::exp<Accuracy::Fast>(input, std::span<FP>(e));
+    batch::log2(input, std::span<FP>(l2));
+    batch::log<Accuracy::Fast>(input, std::span<FP>(l));
+    bool same = true;
+    for (size_t i = 0; i < in.size(); ++i) {
+        same = same && e2[i] == exp2(in[i]) && e[i] == exp<Accuracy::Fast>(in[i]) &&
+               l2[i] == log2(in[i]) && l[i] == log<Accuracy::Fast>(in[i]);
+    }
+    check("matches the scalar functions", same);
+}
+
+int main() {
+    std::cout << "Testing Exponential and Logarithm Polynomials\n";
+    std::cout << "=============================================\n\n";
+
+    test_format<Q7_8>("Q7.8", 128.0L, 1.0L, 1.0L);
+    test_format<Q0_15>("Q0.15", 1.0L, 1.0L, 1.0L);
+    test_format<Q15_16>("Q15.16", 32768.0L, 1.0L, 1.0L);
+    test_format<UQ16_16>("UQ16.16", 65536.0L, 1.0L, 1.0L);
+    test_format<Q7_24>("Q7.24", 128.0L, 1.0L, 1.0L);
+    test_format<Q1_30>("Q1.30", 2.0L, 1.0L, 1.0L);
+    // 64-bit formats: the polynomial is capped at 2^-59 relative error, a few
+    // LSB for the largest exp2 results
+    test_format<Q31_32>("Q31.32", 40.0L, 16.0L, 1.0L);
+    test_wide_bound<Q31_32>("Q31.32");
+    test_wide_bound<FixedPoint<64, 48>>("Q15.48");
+    test_wide_bound<FixedPoint<64, 60>>("Q3.60");
+
+    test_special_values();
+
+    test_batch<Q7_8>("Q7.8");
+    test_batch<Q15_16>("Q15.16");
+    test_batch<Q31_32>("Q31.32");
+
+    std::cout << "\n" << (failures == 0 ? "All exp/log tests passed!" : "Exp/log tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+#include <fixp/dsp.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::dsp;
+
+template<typename FP, size_t N>
+std::array<FP, N> random_signal(uint32_t seed, double amplitude) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::array<FP, N> x;
+    for (auto& v : x) v = FP(dist(gen));
+    return x;
+}
+
+// Largest deviation from the exact result, in units of the exact result's
+// peak; a few LSB are allowed on top for outputs near the format's resolution
+template<typename FP, size_t N>
+double relative_error(const std::array<FP, N>& got, const std::array<FP, N>& exact) {
+    const double lsb = static_cast<double>(FP::from_raw(1));
+    double peak = 0, err = 0;
+    for (size_t i = 0; i < N; ++i) {
+        peak = std::max(peak, std::abs(static_cast<double>(exact[i])));
+        err = std::max(err, std::abs(static_cast<double>(got[i]) - static_cast<double>(exact[i])));
+    }
+    err = std::max(0.0, err - 4 * lsb);
+    return peak > 0 ? err / peak : err;
+}
+
+template<typename FP, size_t X, size_t H>
+void test_sizes(const char* name, double amp_x, double amp_h, double bound) {
+    std::cout << name << " " << X << " x " << H << ":\n";
+    const auto x = random_signal<FP, X>(X, amp_x);
+    const auto h = random_signal<FP, H>(H + 1, amp_h);
+
+    double conv_err = relative_error(fft_convolve(x, h), convolve(x, h));
+    double corr_err = relative_error(fft_correlate(x, h), correlate(x, h));
+    std::cout << "    convolve error " << conv_err << ", correlate error " << corr_err << "\n";
+    check("fft_convolve close to convolve", conv_err < bound);
+    check("fft_correlate close to correlate", corr_err < bound);
+}
+
+template<typename FP, size_t NumTaps, size_t Block>
+void test_overlap_add(const char* name, double bound) {
+    std::cout << name << " OverlapAddFilter " << NumTaps << " taps, blocks of " << Block << ":\n";
+    const auto h = random_signal<FP, NumTaps>(3, 1.0 / NumTaps);
+    const auto x = random_signal<FP, 10 * Block>(4, 0.9);
+
+    FirFilter<FP, NumTaps> direct(h);
+    OverlapAddFilter<FP, NumTaps, Block> fast(h);
+    std::array<FP, 10 * Block> ref, got;
+    for (size_t i = 0; i < x.size(); ++i) ref[i] = direct.process(x[i]);
+    for (size_t b = 0; b < 10; ++b) {
+        fast.process(std::span<const FP, Block>(x.data() + b * Block, Block),
+                     std::span<FP, Block>(got.data() + b * Block, Block));
+    }
+    const double err = relative_error(got, ref);
+    std::cout << "    error " << err << "\n";
+    check("matches FirFilter across blocks", err < bound);
+
+    // In place after a reset starts from silence again
+    fast.reset();
+    std::array<FP, Block> block;
+    std::copy_n(x.begin(), Block, block.begin());
+    fast.process(block, block);
+    bool same = true;
+    for (size_t i = 0; i < Block; ++i) same &= block[i] == got[i];
+    check("reset and in place", same);
+}
+
+int main() {
+    std::cout << "Testing Fast Convolution\n";
+    std::cout << "========================\n\n";
+
+    using Q15_16 = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+    using Q0_31 = FixedPoint<32, 31, true, OverflowPolicy::Saturate>;
+    using Q0_15 = FixedPoint<16, 15, true, OverflowPolicy::Saturate>;
+
+    test_sizes<Q15_16, 500, 100>("Q15.16", 4.0, 0.5, 1e-4);
+    test_sizes<Q15_16, 37, 200>("Q15.16", 1.0, 1.0, 1e-4);
+    test_sizes<Q0_31, 1000, 128>("Q0.31", 0.25, 1.0 / 64, 1e-7);
+    test_sizes<Q0_15, 300, 64>("Q0.15", 0.5, 1.0 / 64, 1e-3);
+
+    // Below the crossover fast_convolve is the direct form, bit for bit
+    std::cout << "Crossover:\n";
+    const auto x = random_signal<Q15_16, 40>(9, 1.0);
+    const auto h = random_signal<Q15_16, 9>(10, 1.0);
+    check("small sizes use the direct form", fast_convolve(x, h) == convolve(x, h) &&
+                                             fast_correlate(x, h) == correlate(x, h));
+    check("large sizes use the FFT",
+          use_fft_convolution<Q15_16>(65536, 8192) && !use_fft_convolution<Q15_16>(8192, 8));
+
+    test_overlap_add<Q15_16, 100, 64>("Q15.16", 1e-4);
+    test_overlap_add<Q0_31, 33, 256>("Q0.31", 1e-7);
+    test_overlap_add<Q0_15, 64, 100>("Q0.15", 1e-3);
+
+    std::cout << "\n" << (failures == 0 ? "All fast convolution tests passed!"
+                                         : "Fast convolution tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
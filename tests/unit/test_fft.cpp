@@ -0,0 +1,247 @@
+#include <fixp/dsp.hpp>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::dsp;
+
+using Q0_15 = FixedPoint<16, 15>;
+using Q0_31 = FixedPoint<32, 31>;
+
+// Plans are literal types, so the tables can be built at compile time
+static constexpr FftPlan<Q15_16, 64> constexpr_plan;
+static_assert(constexpr_plan.bit_reversal()[1] == 32);
+static_assert(constexpr_plan.twiddles()[0].real == 1 << 30);
+static_assert(FftPlan<FixedPoint<64, 32>, 8>().twiddles()[0].real == int64_t(1) << 62);
+
+template<typename FP, size_t N>
+std::array<Complex<FP>, N> random_signal(double amplitude, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::array<Complex<FP>, N> x;
+    for (auto& v : x) v = Complex<FP>(FP(dist(gen)), FP(dist(gen)));
+    return x;
+}
+
+// Reference DFT in double precision
+template<typename FP, size_t N>
+std::vector<std::complex<double>> reference_dft(const std::array<Complex<FP>, N>& x) {
+    std::vector<std::complex<double>> out(N);
+    for (size_t k = 0; k < N; ++k) {
+        std::complex<double> acc = 0;
+        for (size_t n = 0; n < N; ++n) {
+            double angle = -2.0 * M_PI * static_cast<double>(k * n % N) / static_cast<double>(N);
+            acc += std::complex<double>(static_cast<double>(x[n].real),
+                                        static_cast<double>(x[n].imag)) *
+                   std::polar(1.0, angle);
+        }
+        out[k] = acc;
+    }
+    return out;
+}
+
+template<typename FP, size_t N>
+double max_error(const std::array<Complex<FP>, N>& x, const std::vector<std::complex<double>>& ref) {
+    double worst = 0.0;
+    for (size_t k = 0; k < N; ++k) {
+        worst = std::max(worst, std::abs(static_cast<double>(x[k].real) - ref[k].real()));
+        worst = std::max(worst, std::abs(static_cast<double>(x[k].imag) - ref[k].imag()));
+    }
+    return worst;
+}
+
+void test_plan() {
+    std::cout << "FftPlan (Q15.16, N=256):\n";
+    constexpr size_t N = 256;
+    static const FftPlan<Q15_16, N> plan;
+
+    auto x = random_signal<Q15_16, N>(0.5, 1);
+    auto ref = reference_dft(x);
+
+    auto y = x;
+    plan.forward(y);
+    check("forward matches DFT", max_error(y, ref) < 2e-3);
+
+    auto z = x;
+    fft_radix2(z);
+    bool same = true;
+    for (size_t k = 0; k < N; ++k) same = same && y[k].real == z[k].real && y[k].imag == z[k].imag;
+    check("fft_radix2 uses the plan", same);
+
+    plan.inverse(y);
+    double roundtrip = 0.0;
+    for (size_t n = 0; n < N; ++n) {
+        roundtrip = std::max(roundtrip, std::abs(static_cast<double>(y[n].real - x[n].real)));
+        roundtrip = std::max(roundtrip, std::abs(static_cast<double>(y[n].imag - x[n].imag)));
+    }
+    check("inverse round trip", roundtrip < 1e-4);
+
+    // A pure tone lands in a single bin
+    std::array<Complex<Q15_16>, N> tone;
+    for (size_t n = 0; n < N; ++n) {
+        double angle = 2.0 * M_PI * 5.0 * static_cast<double>(n) / N;
+        tone[n] = Complex<Q15_16>(Q15_16(0.25 * std::cos(angle)), Q15_16(0.25 * std::sin(angle)));
+    }
+    plan.forward(tone);
+    check("tone bin", std::abs(static_cast<double>(tone[5].real) - 0.25 * N) < 0.05);
+
+    auto small = random_signal<Q15_16, 64>(0.5, 2);
+    auto small_ref = reference_dft(small);
+    constexpr_plan.forward(small);
+    check("constexpr plan", max_error(small, small_ref) < 1e-3);
+}
+
+// Formats without 1.0: the twiddles must still hold W^0 = 1
+void test_fractional_formats() {
+    std::cout << "FftPlan (Q0.15):\n";
+    {
+        // A unit pulse has a flat spectrum
+        constexpr FftPlan<Q0_15, 4> plan;
+        std::array<Complex<Q0_15>, 4> x{};
+        x[0] = Complex<Q0_15>(Q0_15(0.25), Q0_15(0.0));
+        plan.forward(x);
+        bool flat = true;
+        for (const auto& v : x) flat = flat && v.real.raw() == 8192 && v.imag.raw() == 0;
+        check("impulse transforms to a flat spectrum", flat);
+    }
+    {
+        // A constant lands in the DC bin only
+        static const FftPlan<Q0_15, 64> plan;
+        std::array<Complex<Q0_15>, 64> x;
+        x.fill(Complex<Q0_15>(Q0_15(1.0 / 128), Q0_15(-1.0 / 256)));
+        plan.forward(x);
+        bool others_zero = true;
+        for (size_t k = 1; k < x.size(); ++k) {
+            others_zero = others_zero && x[k].real.raw() == 0 && x[k].imag.raw() == 0;
+        }
+        check("DC input lands in bin 0",
+              x[0].real.raw() == 16384 && x[0].imag.raw() == -8192 && others_zero);
+        plan.inverse(x);
+        bool back = true;
+        for (const auto& v : x) back = back && v.real.raw() == 256 && v.imag.raw() == -128;
+        check("inverse restores the constant", back);
+    }
+    {
+        auto x = random_signal<Q0_15, 256>(0.002, 6);
+        auto ref = reference_dft(x);
+        static const FftPlan<Q0_15, 256> plan;
+        plan.forward(x);
+        check("forward matches DFT", max_error(x, ref) < 2e-3);
+    }
+    {
+        // The real transform runs an N/2-point FftPlan inside
+        std::array<Q0_15, 8> pulse{};
+        pulse[0] = Q0_15(0.5);
+        const auto spectrum = rfft(pulse);
+        bool flat = true;
+        for (const auto& v : spectrum) flat = flat && v.real.raw() == 16384 && v.imag.raw() == 0;
+        check("rfft of an impulse is flat", flat);
+    }
+}
+
+// Error of out * 2^exponent against the reference, relative to the largest bin
+template<typename FP, size_t N>
+double relative_error(const std::array<Complex<FP>, N>& x, int exponent,
+                      const std::vector<std::complex<double>>& ref) {
+    double peak = 0.0, worst = 0.0;
+    for (size_t k = 0; k < N; ++k) {
+        std::complex<double> v(std::ldexp(static_cast<double>(x[k].real), exponent),
+                               std::ldexp(static_cast<double>(x[k].imag), exponent));
+        peak = std::max(peak, std::abs(ref[k]));
+        worst = std::max(worst, std::abs(v - ref[k]));
+    }
+    return worst / peak;
+}
+
+template<typename FP, size_t N, FftScaling Scaling>
+void test_radix4(const char* name, double amplitude, double tolerance) {
+    std::cout << name << ":\n";
+    static const Radix4FftPlan<FP, N, Scaling> plan;
+
+    auto x = random_signal<FP, N>(amplitude, 3);
+    auto ref = reference_dft(x);
+    auto y = x;
+    int e = plan.forward(y);
+    check("forward matches DFT", relative_error(y, e, ref) < tolerance);
+
+    if constexpr (Scaling == FftScaling::None) check("exponent is 0", e == 0);
+    if constexpr (Scaling == FftScaling::PerStage) check("exponent is log2(N)", e == plan.log2_size);
+
+    // Inverse on its own input, against the reference IDFT (conjugate, 1/N).
+    // Unscaled, a spectrum as small as the time signal would leave almost no
+    // bits after the 1/N, so use one that uses the format's range.
+    const double spectrum_amplitude = Scaling == FftScaling::None ? amplitude * 64 : amplitude;
+    auto spectrum = random_signal<FP, N>(spectrum_amplitude, 4);
+    std::array<Complex<FP>, N> conj;
+    for (size_t k = 0; k < N; ++k) conj[k] = Complex<FP>(spectrum[k].real, -spectrum[k].imag);
+    auto inv_ref = reference_dft(conj);
+    for (auto& v : inv_ref) v = std::conj(v) / static_cast<double>(N);
+    int ei = plan.inverse(spectrum);
+    check("inverse matches IDFT", relative_error(spectrum, ei, inv_ref) < tolerance);
+}
+
+template<typename FP, size_t N>
+void test_real_fft(const char* name, double amplitude, double tolerance) {
+    std::cout << name << ":\n";
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::array<FP, N> x;
+    std::array<Complex<FP>, N> as_complex;
+    for (size_t n = 0; n < N; ++n) {
+        x[n] = FP(dist(gen));
+        as_complex[n] = Complex<FP>(x[n], FP(0));
+    }
+    auto ref = reference_dft(as_complex);
+
+    std::array<Complex<FP>, N / 2 + 1> spectrum;
+    rfft(x, spectrum);
+    double worst = 0.0, peak = 0.0;
+    for (size_t k = 0; k <= N / 2; ++k) {
+        std::complex<double> v(static_cast<double>(spectrum[k].real),
+                               static_cast<double>(spectrum[k].imag));
+        worst = std::max(worst, std::abs(v - ref[k]));
+        peak = std::max(peak, std::abs(ref[k]));
+    }
+    check("rfft matches DFT", worst / peak < tolerance);
+
+    auto by_value = rfft(x);
+    bool same = true;
+    for (size_t k = 0; k <= N / 2; ++k) {
+        same = same && by_value[k].real == spectrum[k].real && by_value[k].imag == spectrum[k].imag;
+    }
+    check("by-value overload agrees", same);
+
+    std::array<FP, N> y;
+    irfft(spectrum, y);
+    double roundtrip = 0.0;
+    for (size_t n = 0; n < N; ++n) {
+        roundtrip = std::max(roundtrip, std::abs(static_cast<double>(y[n] - x[n])));
+    }
+    check("irfft round trip", roundtrip < tolerance * amplitude);
+}
+
+int main() {
+    std::cout << "Testing FFT\n";
+    std::cout << "===========\n\n";
+
+    test_plan();
+    test_fractional_formats();
+    test_real_fft<Q15_16, 4>("Real FFT Q15.16 N=4", 0.5, 1e-3);
+    test_real_fft<Q15_16, 1024>("Real FFT Q15.16 N=1024", 0.5, 1e-3);
+    test_real_fft<FixedPoint<64, 40>, 512>("Real FFT Q23.40 N=512", 0.5, 1e-6);
+    test_radix4<Q15_16, 1024, FftScaling::None>("Radix-4 Q15.16 N=1024 unscaled", 0.01, 1e-3);
+    test_radix4<Q15_16, 2048, FftScaling::None>("Radix-4 Q15.16 N=2048 unscaled", 0.01, 1e-3);
+    test_radix4<Q15_16, 512, FftScaling::PerStage>("Radix-4 Q15.16 N=512 per-stage", 0.7, 1e-3);
+    test_radix4<Q0_15, 1024, FftScaling::PerStage>("Radix-4 Q0.15 N=1024 per-stage", 0.7, 5e-2);
+    // Full-scale 16-bit input, no headroom cut
+    test_radix4<Q0_15, 4096, FftScaling::BlockFloatingPoint>("Radix-4 Q0.15 N=4096 BFP", 0.99, 1e-2);
+    test_radix4<Q0_15, 2048, FftScaling::BlockFloatingPoint>("Radix-4 Q0.15 N=2048 BFP", 0.99, 1e-2);
+    test_radix4<Q0_31, 1024, FftScaling::BlockFloatingPoint>("Radix-4 Q0.31 N=1024 BFP", 0.99, 1e-6);
+
+    std::cout << "\n" << (failures == 0 ? "All FFT tests passed!" : "FFT tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
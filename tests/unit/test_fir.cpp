@@ -0,0 +1,167 @@
+#include <fixp/dsp.hpp>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::dsp;
+
+// Random raw values with the extremes mixed in; shift scales the range down
+template<typename FP>
+FP random_value(std::mt19937& gen, int shift) {
+    using raw_type = typename FP::raw_type;
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<raw_type>::min(),
+                                                std::numeric_limits<raw_type>::max());
+    switch (gen() % 8) {
+        case 0: return FP::from_raw(static_cast<raw_type>(std::numeric_limits<raw_type>::max() >> shift));
+        case 1: return FP::from_raw(static_cast<raw_type>(std::numeric_limits<raw_type>::min() >> shift));
+        default: return FP::from_raw(static_cast<raw_type>(dist(gen) >> shift));
+    }
+}
+
+// Direct convolution with a 128-bit sum, rounded once
+template<typename FP, size_t NumTaps>
+std::vector<FP> reference_fir(const std::vector<FP>& x, const std::array<FP, NumTaps>& b) {
+    using raw_type = typename FP::raw_type;
+    constexpr int F = FP::fractional_bits;
+    std::vector<FP> y(x.size());
+    for (size_t n = 0; n < x.size(); ++n) {
+        __int128_t acc = 0;
+        for (size_t k = 0; k < NumTaps && k <= n; ++k) {
+            acc += static_cast<__int128_t>(b[k].raw()) * static_cast<__int128_t>(x[n - k].raw());
+        }
+        acc = (acc + (__int128_t(1) << (F - 1))) >> F;
+        if constexpr (FP::overflow_policy == OverflowPolicy::Saturate) {
+            if (acc > std::numeric_limits<raw_type>::max()) acc = std::numeric_limits<raw_type>::max();
+            if (acc < std::numeric_limits<raw_type>::min()) acc = std::numeric_limits<raw_type>::min();
+        }
+        y[n] = FP::from_raw(static_cast<raw_type>(acc));
+    }
+    return y;
+}
+
+template<typename FP>
+bool same(const std::vector<FP>& a, const std::vector<FP>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].raw() != b[i].raw()) return false;
+    }
+    return true;
+}
+
+template<typename FP, size_t NumTaps>
+void test_format(const char* name, int coeff_shift) {
+    std::cout << name << ", " << NumTaps << " taps:\n";
+
+    std::mt19937 gen(NumTaps * 31 + FP::total_bits);
+    std::array<FP, NumTaps> b;
+    for (auto& c : b) c = random_value<FP>(gen, coeff_shift);
+    std::vector<FP> x(1000);
+    for (auto& v : x) v = random_value<FP>(gen, 0);
+    const auto ref = reference_fir(x, b);
+
+    FirFilter<FP, NumTaps> filter(b);
+    std::vector<FP> y(x.size());
+    for (size_t n = 0; n < x.size(); ++n) y[n] = filter.process(x[n]);
+    check("per sample matches reference", same(y, ref));
+
+    // Arbitrary block lengths, including empty blocks, continue seamlessly
+    filter.reset();
+    std::fill(y.begin(), y.end(), FP(0));
+    for (size_t pos = 0; pos < x.size();) {
+        size_t len = std::min<size_t>(gen() % 200, x.size() - pos);
+        filter.process(std::span<const FP>(x).subspan(pos, len), std::span<FP>(y).subspan(pos, len));
+        pos += len;
+    }
+    check("blocks match reference", same(y, ref));
+
+    // In place
+    filter.reset();
+    y = x;
+    filter.process(y, std::span<FP>(y));
+    check("in place matches reference", same(y, ref));
+
+    // The legacy block function carries its history across calls
+    constexpr size_t Block = 250;
+    std::array<FP, NumTaps - 1> state{};
+    std::array<FP, Block> in, out;
+    bool legacy_ok = true;
+    for (size_t pos = 0; pos < x.size(); pos += Block) {
+        std::copy_n(x.begin() + static_cast<std::ptrdiff_t>(pos), Block, in.begin());
+        fir_filter(in, out, b, state);
+        for (size_t i = 0; i < Block; ++i) legacy_ok &= out[i].raw() == ref[pos + i].raw();
+    }
+    check("fir_filter matches reference", legacy_ok);
+}
+
+template<typename FP>
+void test_impulse(const char* name) {
+    std::cout << name << " impulse and moving average:\n";
+
+    std::array<FP, 5> b = {FP(0.5), FP(-0.25), FP(0.125), FP(0.0625), FP(-0.03125)};
+    FirFilter<FP, 5> filter(b);
+    bool impulse_ok = true;
+    for (size_t n = 0; n < 8; ++n) {
+        FP y = filter.process(n == 0 ? FP(0.5) : FP(0));
+        FP expected = n < 5 ? b[n] * FP(0.5) : FP(0);
+        impulse_ok &= y.raw() == expected.raw();
+    }
+    check("impulse response is b * 0.5", impulse_ok);
+    check("coefficients round-trip", filter.coefficients() == b);
+
+    // 3-tap average of 0.125 steps; every value is exact in the format
+    FirFilter<FP, 4> average({FP(0.25), FP(0.25), FP(0.25), FP(0.25)});
+    const double in[] = {0.5, 0.25, 0.75, 0.5, 0.0, -0.5};
+    const double expected[] = {0.125, 0.1875, 0.375, 0.5, 0.375, 0.1875};
+    bool average_ok = true;
+    for (size_t n = 0; n < 6; ++n) {
+        average_ok &= static_cast<double>(average.process(FP(in[n]))) == expected[n];
+    }
+    check("moving average", average_ok);
+}
+
+int main() {
+    std::cout << "Testing FIR Filter\n";
+    std::cout << "==================\n\n";
+
+    using Q15_16 = FixedPoint<32, 16, true, OverflowPolicy::Wrap>;
+    using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+    using Q0_31S = FixedPoint<32, 31, true, OverflowPolicy::Saturate>;
+    using Q0_15 = FixedPoint<16, 15, true, OverflowPolicy::Wrap>;
+    using Q0_15S = FixedPoint<16, 15, true, OverflowPolicy::Saturate>;
+    using Q7_8S = FixedPoint<16, 8, true, OverflowPolicy::Saturate>;
+    using Q0_7S = FixedPoint<8, 7, true, OverflowPolicy::Saturate>;
+    using Q31_32S = FixedPoint<64, 32, true, OverflowPolicy::Saturate>;
+
+    test_format<Q15_16, 128>("Q15.16 Wrap", 0);
+    test_format<Q15_16S, 128>("Q15.16 Saturate", 8);
+    test_format<Q15_16S, 7>("Q15.16 Saturate", 4);
+    // Q0.31 keeps one integer bit of headroom in 64 bits: sum(|b|) < 1
+    test_format<Q0_31S, 128>("Q0.31 Saturate", 7);
+    test_format<Q0_15, 128>("Q0.15 Wrap", 0);
+    test_format<Q0_15S, 128>("Q0.15 Saturate", 0);
+    test_format<Q0_15S, 33>("Q0.15 Saturate", 0);
+    test_format<Q7_8S, 1>("Q7.8 Saturate", 0);
+    test_format<Q0_7S, 16>("Q0.7 Saturate", 0);
+    test_format<Q31_32S, 16>("Q31.32 Saturate", 0);
+
+    test_impulse<Q15_16>("Q15.16");
+    test_impulse<Q0_15S>("Q0.15");
+
+    // Pairs of INT16_MIN products are the one case where 16-bit madd wraps
+    std::cout << "Q0.15 extremes:\n";
+    std::array<Q0_15S, 64> mins;
+    mins.fill(Q0_15S::min());
+    FirFilter<Q0_15S, 64> extreme(mins);
+    std::vector<Q0_15S> x(64, Q0_15S::min());
+    Q0_15S last{};
+    for (auto v : x) last = extreme.process(v);
+    check("all INT16_MIN saturates high", last == Q0_15S::max() &&
+                                           last == reference_fir(x, mins).back());
+
+    std::cout << "\n" << (failures == 0 ? "All FIR tests passed!" : "FIR tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#include <fixp/table.hpp>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+using Q7_8 = FixedPoint<16, 8>;
+using Q3_12 = FixedPoint<16, 12>;
+using Q0_15 = FixedPoint<16, 15>;
+using Q15_16 = FixedPoint<32, 16>;
+using UQ8_8 = FixedPoint<16, 8, false>;
+
+constexpr auto soft_clip = [](double x) {
+    // Cubic soft clipper: x - x^3 / 3 inside [-1, 1], +-2/3 beyond
+    if (x > 1.0) return 2.0 / 3.0;
+    if (x < -1.0) return -2.0 / 3.0;
+    return x - x * x * x / 3.0;
+};
+
+using TanhLinear = FunctionTable<Q3_12, constexpr_math::tanh, 64, Interpolation::Linear>;
+using TanhQuadratic = FunctionTable<Q3_12, constexpr_math::tanh, 64, Interpolation::Quadratic>;
+using TanhCubic = FunctionTable<Q3_12, constexpr_math::tanh, 64, Interpolation::Cubic>;
+
+// Built and evaluated at compile time
+static_assert(TanhCubic::lookup(Q3_12::zero()) == Q3_12::zero());
+static_assert(TanhCubic::lookup(Q3_12::max()).raw() == 4096);
+static_assert(TanhCubic::coefficients.size() == 64 * 4);
+
+// Every input of a 16-bit format against std::tanh
+template<typename Table>
+static double exhaustive_error(const Table& table) {
+    using FP = typename Table::value_type;
+    double worst = 0.0;
+    for (int32_t r = std::numeric_limits<typename FP::raw_type>::min();
+         r <= std::numeric_limits<typename FP::raw_type>::max(); ++r) {
+        const FP x = FP::from_raw(static_cast<typename FP::raw_type>(r));
+        const double ref = std::tanh(static_cast<double>(x));
+        worst = std::max(worst, std::abs(static_cast<double>(table(x)) - ref));
+    }
+    return worst * (1 << FP::fractional_bits);
+}
+
+static void test_accuracy() {
+    std::cout << "Accuracy:\n";
+    constexpr TanhLinear linear;
+    constexpr TanhQuadratic quadratic;
+    constexpr TanhCubic cubic;
+    const double e1 = exhaustive_error(linear);
+    const double e2 = exhaustive_error(quadratic);
+    const double e3 = exhaustive_error(cubic);
+    check("Q3.12 tanh error falls with the interpolation order", e3 < e2 && e2 < e1);
+    check("Q3.12 tanh cubic within 0.6 LSB", e3 < 0.6);
+
+    const auto measured = TanhCubic::measure_error();
+    check("measure_error matches an independent sweep", std::abs(measured.max_lsb - e3) < 1e-6);
+    const double at_worst = std::abs(static_cast<double>(cubic(measured.worst_input)) -
+                                     std::tanh(static_cast<double>(measured.worst_input)));
+    check("measure_error reports its worst input", std::abs(at_worst * 4096 - e3) < 1e-6);
+    check("measure_error in units", measured.max_abs == measured.max_lsb / 4096);
+
+    constexpr FunctionTable<Q7_8, constexpr_math::tanh, 32, Interpolation::Cubic, -8.0, 8.0> q7;
+    check("Q7.8 tanh cubic over [-8, 8]", exhaustive_error(q7) < 0.55);
+    constexpr FunctionTable<Q0_15, constexpr_math::tanh, 64, Interpolation::Quadratic> q0;
+    check("Q0.15 tanh quadratic", exhaustive_error(q0) < 0.6);
+
+    using Sigmoid = FunctionTable<Q15_16, constexpr_math::sigmoid, 1024, Interpolation::Cubic,
+                                  -16.0, 16.0>;
+    check("Q15.16 sigmoid cubic within 0.55 LSB", Sigmoid::measure_error().max_lsb < 0.55);
+    check("Q15.16 sigmoid saturates outside its domain",
+          Sigmoid::lookup(Q15_16(100.0)).raw() == 65536 && Sigmoid::lookup(Q15_16(-100.0)).raw() == 0);
+    check("Q15.16 sigmoid(0) = 0.5", Sigmoid::lookup(Q15_16::zero()).raw() == 32768);
+
+    using Clip = FunctionTable<Q3_12, soft_clip, 128, Interpolation::Cubic, -2.0, 2.0>;
+    check("Soft clipper from a lambda", Clip::measure_error().max_lsb < 0.55);
+    check("Soft clipper is odd", Clip::lookup(Q3_12(0.5)).raw() == -Clip::lookup(Q3_12(-0.5)).raw());
+}
+
+static void test_layout() {
+    std::cout << "Layout:\n";
+    using Exp = FunctionTable<Q15_16, constexpr_math::exp, 2048, Interpolation::Cubic, 0.0, 10.0>;
+    check("Coefficients are 64-byte aligned",
+          reinterpret_cast<uintptr_t>(TanhCubic::coefficients.data()) % 64 == 0 &&
+              reinterpret_cast<uintptr_t>(Exp::coefficients.data()) % 64 == 0);
+    check("Small values use int32 entries",
+          sizeof(TanhCubic::entry_type) == 4 && TanhCubic::simd_eligible);
+    check("Values beyond 30 bits use int64 entries",
+          sizeof(Exp::entry_type) == 8 && !Exp::simd_eligible);
+
+    const auto e = Exp::measure_error();
+    // e^x climbs 22000 LSBs per input step near 10, so the segment position,
+    // good to 2^-32 of the domain, costs about an LSB there
+    check("Q15.16 exp over [0, 10] within 2 LSB", e.max_lsb < 2.0);
+    check("Q15.16 exp clamps to the format", Exp::lookup(Q15_16(20.0)) == Exp::lookup(Q15_16(10.0)));
+
+    constexpr auto saturation = [](double x) { return x / (1.0 + x); };
+    using Unsigned = FunctionTable<UQ8_8, saturation, 64, Interpolation::Cubic, 0.0, 16.0>;
+    check("Unsigned format", Unsigned::measure_error().max_lsb < 0.6 && !Unsigned::simd_eligible);
+}
+
+template<typename Table, typename FP>
+static bool batch_matches(std::mt19937& rng) {
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<typename FP::raw_type>::min(),
+                                                std::numeric_limits<typename FP::raw_type>::max());
+    constexpr Table table;
+    for (size_t n : {0u, 1u, 7u, 8u, 15u, 16u, 17u, 100u, 1001u}) {
+        std::vector<FP> in(n), out(n);
+        for (auto& v : in) v = FP::from_raw(static_cast<typename FP::raw_type>(dist(rng)));
+        if (n > 3) {
+            in[0] = FP::min();
+            in[1] = FP::max();
+            in[2] = FP::from_raw(static_cast<typename FP::raw_type>(Table::lo_raw));
+            in[3] = FP::from_raw(static_cast<typename FP::raw_type>(Table::hi_raw));
+        }
+        batch::lookup(in, table, std::span<FP>(out));
+        for (size_t i = 0; i < n; ++i) {
+            if (out[i] != table(in[i])) return false;
+        }
+    }
+    return true;
+}
+
+static void test_batch() {
+    std::cout << "Batch lookup:\n";
+    std::mt19937 rng(29);
+    check("Q3.12 tanh cubic", batch_matches<TanhCubic, Q3_12>(rng));
+    check("Q3.12 tanh linear", batch_matches<TanhLinear, Q3_12>(rng));
+    check("Q7.8 tanh quadratic over [-4, 6]",
+          batch_matches<FunctionTable<Q7_8, constexpr_math::tanh, 40, Interpolation::Quadratic,
+                                      -4.0, 6.0>, Q7_8>(rng));
+    check("Q15.16 sigmoid cubic",
+          batch_matches<FunctionTable<Q15_16, constexpr_math::sigmoid, 1024,
+                                      Interpolation::Cubic, -16.0, 16.0>, Q15_16>(rng));
+    check("Q15.16 soft clipper full range",
+          batch_matches<FunctionTable<Q15_16, soft_clip, 7, Interpolation::Cubic>, Q15_16>(rng));
+    check("Q15.16 exp (scalar entries)",
+          batch_matches<FunctionTable<Q15_16, constexpr_math::exp, 64, Interpolation::Linear,
+                                      -5.0, 10.0>, Q15_16>(rng));
+    check("Single segment",
+          batch_matches<FunctionTable<Q3_12, soft_clip, 1, Interpolation::Cubic, -1.0, 1.0>,
+                        Q3_12>(rng));
+}
+
+int main() {
+    std::cout << "Testing Function Tables\n";
+    std::cout << "=======================\n\n";
+
+    test_accuracy();
+    test_layout();
+    test_batch();
+
+    std::cout << "\n" << (failures == 0 ? "All function table tests passed!"
+                                        : "Function table tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
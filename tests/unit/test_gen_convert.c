@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <math.h>
+#include "libfixp/gen/q15_16.h"
+#include "libfixp/gen/q0_7.h"
+
+// Counted rather than assert()ed, so NDEBUG builds still fail
+static int failures = 0;
+
+#define CHECK(cond)                                                      \
+    do {                                                                 \
+        if (!(cond)) {                                                   \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);       \
+            failures++;                                                  \
+        }                                                                \
+    } while (0)
+
+int main(void) {
+    // Round trip and both tie rules on Q15.16 (2^-17 is half an LSB)
+    const float in[] = {10.5f, -2.25f, 0x1p-17f, 3 * 0x1p-17f, -0x1p-17f, -3 * 0x1p-17f};
+    q15_16_t q[6];
+
+    q15_16_from_float_array(in, q, 6, 0);
+    CHECK(Q15_16_RAW(q[0]) == 688128);
+    CHECK(Q15_16_RAW(q[1]) == -147456);
+    CHECK(Q15_16_RAW(q[2]) == 1 && Q15_16_RAW(q[3]) == 2);
+    CHECK(Q15_16_RAW(q[4]) == -1 && Q15_16_RAW(q[5]) == -2);
+
+    q15_16_from_float_array(in, q, 6, LIBFIXP_CVT_NEAREST_EVEN);
+    CHECK(Q15_16_RAW(q[2]) == 0 && Q15_16_RAW(q[3]) == 2);
+    CHECK(Q15_16_RAW(q[4]) == 0 && Q15_16_RAW(q[5]) == -2);
+
+    float back[6];
+    q15_16_to_float_array(q, back, 2);
+    CHECK(back[0] == 10.5f && back[1] == -2.25f);
+
+    // Saturation, including NaN and infinities
+    const double wide[] = {40000.0, -40000.0, NAN, INFINITY, -INFINITY, 32767.99999};
+    q15_16_from_double_array(wide, q, 6, LIBFIXP_CVT_SATURATE | LIBFIXP_CVT_NEAREST_EVEN);
+    CHECK(q[0] == Q15_16_MAX && q[1] == Q15_16_MIN);
+    CHECK(Q15_16_RAW(q[2]) == 0);
+    CHECK(q[3] == Q15_16_MAX && q[4] == Q15_16_MIN);
+    CHECK(q[5] == Q15_16_MAX);
+
+    double dback[6];
+    q15_16_to_double_array(q, dback, 2);
+    CHECK(dback[0] == 32768.0 - 0x1p-16 && dback[1] == -32768.0);
+
+    // 8-bit storage saturates to its own range
+    const float small[] = {0.5f, -1.0f, 1.0f, -2.0f};
+    q0_7_t s[4];
+    q0_7_from_float_array(small, s, 4, LIBFIXP_CVT_SATURATE);
+    CHECK(Q0_7_RAW(s[0]) == 64 && Q0_7_RAW(s[1]) == -128);
+    CHECK(s[2] == Q0_7_MAX && s[3] == Q0_7_MIN);
+
+    // Long enough to exercise a vectorized body plus tail
+    float ramp[1003];
+    q15_16_t rq[1003];
+    float rb[1003];
+    for (int i = 0; i < 1003; ++i) ramp[i] = (float)(i - 501) * 0.125f;
+    q15_16_from_float_array(ramp, rq, 1003, LIBFIXP_CVT_SATURATE | LIBFIXP_CVT_NEAREST_EVEN);
+    q15_16_to_float_array(rq, rb, 1003);
+    for (int i = 0; i < 1003; ++i) {
+        CHECK(Q15_16_RAW(rq[i]) == (i - 501) * 8192);
+        CHECK(rb[i] == ramp[i]);
+    }
+
+    printf("%s\n", failures == 0 ? "Generated Array Conversion Tests Passed"
+                                  : "Generated Array Conversion Tests FAILED");
+    return failures == 0 ? 0 : 1;
+}
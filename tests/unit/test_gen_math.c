@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <math.h>
+#include "fixp/gen/q15_16_math.h"
+#include "fixp/gen/q23_8_math.h"
+#include "fixp/gen/q1_30_math.h"
+#include "fixp/gen/q0_15_math.h"
+#include "fixp/gen/q0_7_math.h"
+
+// Counted rather than assert()ed, so NDEBUG builds still fail
+static int failures = 0;
+
+#define CHECK(cond)                                                      \
+    do {                                                                 \
+        if (!(cond)) {                                                   \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);       \
+            failures++;                                                  \
+        }                                                                \
+    } while (0)
+
+// Errors in output LSBs against libm, with the reference clamped to the format range.
+// exp/exp2 are measured relative to 2^-30 of the result so large outputs are not penalized
+// for the precision of the 32-bit storage.
+typedef struct {
+    double sin, cos, atan2, sqrt, exp2, exp, log2, log;
+} errors;
+
+static double clampd(double v, double lo, double hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+static void update(double* worst, double got, double want) {
+    double e = fabs(got - want);
+    if (e > *worst) *worst = e;
+}
+
+#define SWEEP(P, T, FRAC, BITS, ERR)                                                     \
+    do {                                                                                 \
+        const double lsb = ldexp(1.0, -(FRAC));                                          \
+        const double lo = -ldexp(1.0, (BITS) - 1) * lsb;                                 \
+        const double hi = (ldexp(1.0, (BITS) - 1) - 1) * lsb;                            \
+        for (int i = 0; i <= 20000; i++) {                                               \
+            double u = i / 20000.0;                                                      \
+            T r = (T)llround((lo + (hi - lo) * u) / lsb);                                \
+            T q = (T)llround((lo + (hi - lo) * fmod(u * 7.31, 1.0)) / lsb);              \
+            double x = r * lsb, y = q * lsb;                                             \
+            T s, c;                                                                      \
+            P##_sincos(r, &s, &c);                                                       \
+            update(&(ERR).sin, s, clampd(sin(x), lo, hi) / lsb);                         \
+            update(&(ERR).cos, c, clampd(cos(x), lo, hi) / lsb);                         \
+            update(&(ERR).atan2, P##_atan2(q, r), clampd(atan2(y, x), lo, hi) / lsb);    \
+            if (r >= 0) update(&(ERR).sqrt, P##_sqrt(r), clampd(sqrt(x), lo, hi) / lsb); \
+            double e2 = clampd(exp2(x), lo, hi), ee = clampd(exp(x), lo, hi);            \
+            update(&(ERR).exp2, P##_exp2(r) / fmax(1.0, e2 / lsb / ldexp(1.0, 30)),      \
+                   e2 / lsb / fmax(1.0, e2 / lsb / ldexp(1.0, 30)));                     \
+            update(&(ERR).exp, P##_exp(r) / fmax(1.0, ee / lsb / ldexp(1.0, 30)),        \
+                   ee / lsb / fmax(1.0, ee / lsb / ldexp(1.0, 30)));                     \
+            if (r > 0) {                                                                 \
+                update(&(ERR).log2, P##_log2(r), clampd(log2(x), lo, hi) / lsb);         \
+                update(&(ERR).log, P##_log(r), clampd(log(x), lo, hi) / lsb);            \
+            }                                                                            \
+        }                                                                                \
+        printf("%-7s sin %.2f cos %.2f atan2 %.2f sqrt %.2f exp2 %.2f exp %.2f "         \
+               "log2 %.2f log %.2f\n", #P, (ERR).sin, (ERR).cos, (ERR).atan2,            \
+               (ERR).sqrt, (ERR).exp2, (ERR).exp, (ERR).log2, (ERR).log);                \
+    } while (0)
+
+static void check(errors e, double trig, double sqrt_lsb, double expo, double loga) {
+    CHECK(e.sin <= trig && e.cos <= trig && e.atan2 <= trig);
+    CHECK(e.sqrt <= sqrt_lsb);
+    CHECK(e.exp2 <= expo && e.exp <= expo);
+    CHECK(e.log2 <= loga && e.log <= loga);
+}
+
+int main(void) {
+    errors e_q15_16 = {0}, e_q23_8 = {0}, e_q1_30 = {0}, e_q0_15 = {0}, e_q0_7 = {0};
+
+    SWEEP(q15_16, q15_16_t, 16, 32, e_q15_16);
+    check(e_q15_16, 1.0, 0.5, 1.0, 1.0);
+
+    SWEEP(q23_8, q23_8_t, 8, 32, e_q23_8);
+    check(e_q23_8, 1.0, 0.5, 1.0, 1.0);
+
+    // Q30 leaves no guard bits for the polynomials: a couple of LSB
+    SWEEP(q1_30, q1_30_t, 30, 32, e_q1_30);
+    check(e_q1_30, 1.5, 0.5, 2.0, 2.5);
+
+    SWEEP(q0_15, q0_15_t, 15, 16, e_q0_15);
+    check(e_q0_15, 1.0, 0.5, 1.0, 1.0);
+
+    SWEEP(q0_7, q0_7_t, 7, 8, e_q0_7);
+    check(e_q0_7, 1.0, 0.5, 1.0, 1.0);
+
+    // Exact corner cases
+    CHECK(q15_16_exp2(0) == Q15_16_ONE);
+    CHECK(q15_16_log2(Q15_16_ONE) == 0);
+    CHECK(q15_16_pow(2 << 16, 3 << 16) == (8 << 16));
+    CHECK(q15_16_sqrt(4 << 16) == (2 << 16));
+    CHECK(q15_16_exp(20 << 16) == Q15_16_MAX);
+    CHECK(q15_16_exp(-(20 << 16)) == 0);
+    CHECK(q15_16_log(0) == Q15_16_MIN);
+    CHECK(q0_15_cos(0) == Q0_15_MAX);  // 1.0 saturates
+    CHECK(q1_30_sin(1 << 30) == (q1_30_t)llround(sin(1.0) * (1 << 30)));
+
+    printf("%s\n", failures == 0 ? "Generated Math Tests Passed" : "Generated Math Tests FAILED");
+    return failures == 0 ? 0 : 1;
+}
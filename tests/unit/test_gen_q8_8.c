@@ -1,7 +1,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include <math.h>
-#include "fixp/gen/q8_8.h"
+#include "libfixp/gen/q8_8.h"
 
 int main(void) {
     // Q8.8 range: -128.0 to 127.996
@@ -0,0 +1,305 @@
+#include <fixp/linalg.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::linalg;
+
+using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+using Q15_16D = FixedPoint<32, 16, true, OverflowPolicy::Dynamic>;
+using Q0_7S = FixedPoint<8, 7, true, OverflowPolicy::Saturate>;
+using Q3_4 = FixedPoint<8, 4>;
+using Q7_8S = FixedPoint<16, 8, true, OverflowPolicy::Saturate>;
+
+// Raw values of every magnitude, shifted right by a random amount
+template<typename FP>
+std::vector<FP> random_values(std::mt19937& gen, size_t n) {
+    using raw_type = typename FP::raw_type;
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<raw_type>::min(),
+                                                std::numeric_limits<raw_type>::max());
+    std::uniform_int_distribution<int> shift(0, std::numeric_limits<raw_type>::digits);
+    std::vector<FP> v(n);
+    for (auto& x : v) x = FP::from_raw(static_cast<raw_type>(dist(gen) >> shift(gen)));
+    return v;
+}
+
+std::vector<int8_t> random_bytes(std::mt19937& gen, size_t n) {
+    std::uniform_int_distribution<int> dist(-128, 127);
+    std::vector<int8_t> v(n);
+    for (auto& x : v) x = static_cast<int8_t>(dist(gen));
+    // The extremes, where a biased or 16-bit path would go wrong
+    if (n > 1) v[0] = v[n - 1] = -128;
+    return v;
+}
+
+// Exact sum of raw products, rounded once and narrowed per policy
+template<typename FP>
+FP reference_dot(const FP* a, size_t a_step, const FP* b, size_t b_step, size_t n) {
+    using raw_type = typename FP::raw_type;
+    __int128_t acc = 0;
+    for (size_t i = 0; i < n; ++i) {
+        acc += static_cast<__int128_t>(a[i * a_step].raw()) * b[i * b_step].raw();
+    }
+    acc = (acc + (__int128_t(1) << (FP::fractional_bits - 1))) >> FP::fractional_bits;
+    if constexpr (FP::overflow_policy == OverflowPolicy::Saturate) {
+        acc = std::clamp<__int128_t>(acc, std::numeric_limits<raw_type>::min(),
+                                     std::numeric_limits<raw_type>::max());
+    }
+    return FP::from_raw(static_cast<raw_type>(acc));
+}
+
+void test_types() {
+    std::cout << "Vec and Mat:\n";
+    using V = Vec<Q15_16, 3>;
+    using M = Mat<Q15_16, 2, 3>;
+    constexpr V v{{Q15_16(1.5), Q15_16(-2), Q15_16(0.25)}};
+    constexpr M m{{Q15_16(1), Q15_16(2), Q15_16(3), Q15_16(-1), Q15_16(0.5), Q15_16(4)}};
+
+    static_assert(Mat<Q15_16, 3, 3>::identity() * v == v);
+    static_assert(transpose(transpose(m)) == m);
+    constexpr auto mv = m * v;
+    check("Mat * Vec", mv[0] == Q15_16(-1.75) && mv[1] == Q15_16(-1.5));
+    check("Vec arithmetic", v + v == Q15_16(2) * v && v - v == V{} && -(-v) == v);
+
+    constexpr auto mmt = m * transpose(m);
+    check("Mat * Mat", mmt(0, 0) == Q15_16(14) && mmt(0, 1) == Q15_16(12) &&
+                           mmt(1, 0) == mmt(0, 1) && mmt(1, 1) == Q15_16(17.25));
+    check("Mat arithmetic", m + m - m == m);
+
+    std::mt19937 gen(1);
+    Mat<Q15_16S, 7, 5> a;
+    Vec<Q15_16S, 5> x;
+    const auto values = random_values<Q15_16S>(gen, 40);
+    std::copy_n(values.begin(), 35, a.elements.begin());
+    std::copy_n(values.begin() + 35, 5, x.elements.begin());
+    const auto y = a * x;
+    bool ok = true;
+    for (size_t r = 0; r < 7; ++r) {
+        ok = ok && y[r].raw() == reference_dot(&a(r, 0), 1, x.data(), 1, 5).raw();
+    }
+    check("rows rounded once and saturated", ok);
+}
+
+template<typename FP>
+void check_transform(const char* name) {
+    std::mt19937 gen(2);
+    Mat<FP, 4, 4> m;
+    const auto coefficients = random_values<FP>(gen, 16);
+    std::copy(coefficients.begin(), coefficients.end(), m.elements.begin());
+
+    bool ok = true;
+    for (size_t n : {0u, 1u, 2u, 3u, 7u, 64u, 101u}) {
+        const auto values = random_values<FP>(gen, 4 * n);
+        std::vector<Vec<FP, 4>> in(n), out(n);
+        for (size_t i = 0; i < n; ++i) std::copy_n(values.data() + 4 * i, 4, in[i].data());
+        transform(m, in, std::span(out));
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t r = 0; r < 4; ++r) {
+                ok = ok && out[i][r].raw() == reference_dot(&m(r, 0), 1, in[i].data(), 1, 4).raw();
+            }
+        }
+        // In place
+        transform(m, in, std::span(in));
+        ok = ok && in == out;
+    }
+    check(name, ok);
+}
+
+void test_transforms() {
+    std::cout << "4x4 transforms:\n";
+    check_transform<Q15_16>("Q15.16 wrapping matches the exact sums");
+    check_transform<Q15_16S>("Q15.16 saturating matches the exact sums");
+    check_transform<Q7_8S>("Q7.8 saturating matches the exact sums");
+
+    bool ok = true;
+    for (auto policy : {OverflowPolicy::Wrap, OverflowPolicy::Saturate}) {
+        ScopedOverflowPolicy scope(policy);
+        Mat<Q15_16D, 4, 4> m;
+        std::vector<Vec<Q15_16D, 4>> in(9), out(9);
+        for (size_t i = 0; i < 16; ++i) m.elements[i] = Q15_16D(1000.5 * double(i % 5) - 2000);
+        for (size_t i = 0; i < in.size(); ++i) {
+            for (size_t r = 0; r < 4; ++r) in[i][r] = Q15_16D(double(i * 4 + r) * 3.25 - 40);
+        }
+        transform(m, in, std::span(out));
+        for (size_t i = 0; i < in.size(); ++i) ok = ok && out[i] == m * in[i];
+    }
+    check("Dynamic follows the run-time policy", ok);
+
+    using V = Vec<Q15_16, 4>;
+    const V corner{{Q15_16(2), Q15_16(0), Q15_16(0), Q15_16(1)}};
+    const auto moved = translation(Q15_16(10), Q15_16(-3), Q15_16(0)) *
+                       (scaling(Q15_16(1.5), Q15_16(1), Q15_16(1)) * corner);
+    check("scale then translate", moved == V{{Q15_16(13), Q15_16(-3), Q15_16(0), Q15_16(1)}});
+
+    const auto turned = rotation_z(Q15_16(1.5707963267948966)) * corner;
+    const double eps = 1e-3;
+    check("rotation_z turns x toward y", std::abs(double(turned[0])) < eps &&
+                                             std::abs(double(turned[1]) - 2) < eps &&
+                                             turned[3] == Q15_16(1));
+}
+
+std::vector<int32_t> reference_qgemm(const std::vector<int8_t>& x, const std::vector<int8_t>& w,
+                                     size_t m, size_t k, size_t n) {
+    std::vector<int32_t> acc(m * n);
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            int64_t sum = 0;
+            for (size_t kk = 0; kk < k; ++kk) sum += int64_t{x[i * k + kk]} * w[kk * n + j];
+            acc[i * n + j] = static_cast<int32_t>(sum);
+        }
+    }
+    return acc;
+}
+
+// floor(acc * multiplier / 2^(31 + shift) + 1/2), clamped
+int8_t reference_requantize(int32_t acc, Requantization q) {
+    const __int128_t p = static_cast<__int128_t>(acc) * q.multiplier;
+    const __int128_t d = __int128_t(1) << (31 + q.shift);
+    __int128_t r = (2 * p + d) / (2 * d);
+    if ((2 * p + d) % (2 * d) < 0) --r;
+    return static_cast<int8_t>(std::clamp<__int128_t>(r, -128, 127));
+}
+
+void test_qgemm() {
+    std::cout << "Int8 GEMM:\n";
+    std::mt19937 gen(3);
+    bool rows = true, columns = true;
+    const size_t shapes[][3] = {{1, 1, 1},   {1, 3, 17},   {3, 4, 16},  {4, 5, 15},
+                                {5, 64, 33}, {9, 255, 2},  {2, 256, 48}, {6, 257, 31},
+                                {7, 600, 40}, {1, 1024, 100}, {0, 8, 8},  {4, 0, 9}};
+    for (const auto& [m, k, n] : shapes) {
+        const auto x = random_bytes(gen, m * k);
+        const auto w = random_bytes(gen, k * n);
+        std::vector<int8_t> wt(k * n);
+        for (size_t kk = 0; kk < k; ++kk) {
+            for (size_t j = 0; j < n; ++j) wt[j * k + kk] = w[kk * n + j];
+        }
+        const auto expected = reference_qgemm(x, w, m, k, n);
+        std::vector<int32_t> acc(m * n, -1);
+        qgemm(x, m, PackedMatrix::from_rows(w, k, n), acc);
+        rows = rows && acc == expected;
+        std::fill(acc.begin(), acc.end(), -1);
+        qgemm(x, m, PackedMatrix::from_columns(wt, k, n), acc);
+        columns = columns && acc == expected;
+    }
+    check("int32 accumulators, row-major weights", rows);
+    check("int32 accumulators, channel-major weights", columns);
+
+    // All -128: every product is 2^14, the largest magnitude
+    {
+        const size_t m = 4, k = 2048, n = 16;
+        const std::vector<int8_t> x(m * k, -128), w(k * n, -128);
+        std::vector<int32_t> acc(m * n);
+        qgemm(x, m, PackedMatrix::from_rows(w, k, n), acc);
+        check("extreme products", std::all_of(acc.begin(), acc.end(),
+                                              [&](int32_t v) { return v == int32_t{1} << 25; }));
+    }
+
+    const size_t m = 5, k = 300, n = 37;
+    const auto x = random_bytes(gen, m * k);
+    const auto w = random_bytes(gen, k * n);
+    const auto packed = PackedMatrix::from_rows(w, k, n);
+    const auto acc = reference_qgemm(x, w, m, k, n);
+    std::vector<int32_t> bias(n);
+    std::uniform_int_distribution<int32_t> bias_dist(-50000, 50000);
+    for (auto& b : bias) b = bias_dist(gen);
+
+    const Requantization tensor = Requantization::from_scale(1.0 / 300);
+    std::vector<int8_t> y(m * n);
+    qgemm(x, m, packed, {}, std::span(&tensor, 1), std::span(y));
+    bool ok = true;
+    for (size_t i = 0; i < m * n; ++i) ok = ok && y[i] == reference_requantize(acc[i], tensor);
+    check("per-tensor requantization", ok);
+
+    std::vector<Requantization> channels(n);
+    std::uniform_real_distribution<double> scale(1e-4, 2e-2);
+    for (auto& q : channels) q = Requantization::from_scale(scale(gen));
+    qgemm(x, m, packed, bias, channels, std::span(y));
+    ok = true;
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const int32_t sum = acc[i * n + j] + bias[j];
+            ok = ok && y[i * n + j] == reference_requantize(sum, channels[j]);
+        }
+    }
+    check("per-channel requantization with bias", ok);
+
+    std::vector<int8_t> row(n);
+    qgemv(std::span(x).first(k), packed, bias, channels, std::span(row));
+    check("qgemv is the first row", std::equal(row.begin(), row.end(), y.begin()));
+
+    const auto exact = Requantization::from_scale(0x1p-7);
+    const Requantization identity;
+    check("from_scale(2^-7) is exact", exact.multiplier == int32_t{1} << 30 && exact.shift == 6);
+    check("default is the identity", identity.apply(-100) == -100 && identity.apply(127) == 127 &&
+                                         identity.apply(5000) == 127 &&
+                                         identity.apply(-5000) == -128);
+    check("ties round up", exact.apply(64) == 1 && exact.apply(-64) == 0 &&
+                               exact.apply(-65) == -1 && exact.apply(191) == 1);
+}
+
+template<typename FP>
+bool gemm_matches(std::mt19937& gen, size_t m, size_t k, size_t n) {
+    const auto a = random_values<FP>(gen, m * k);
+    const auto b = random_values<FP>(gen, k * n);
+    std::vector<FP> c(m * n);
+    gemm(a, b, std::span(c), m, k, n);
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const FP expected = reference_dot(a.data() + i * k, 1, b.data() + j, n, k);
+            if (c[i * n + j].raw() != expected.raw()) return false;
+        }
+    }
+    return true;
+}
+
+template<typename FP>
+void check_gemm(const char* name) {
+    std::mt19937 gen(4);
+    bool ok = true;
+    const size_t shapes[][3] = {{1, 1, 1}, {3, 7, 5}, {4, 16, 16}, {5, 300, 33}, {2, 513, 70}};
+    for (const auto& [m, k, n] : shapes) ok = ok && gemm_matches<FP>(gen, m, k, n);
+    check(name, ok);
+}
+
+void test_gemm() {
+    std::cout << "FixedPoint GEMM:\n";
+    check_gemm<Q0_7>("Q0.7 wrapping");
+    check_gemm<Q0_7S>("Q0.7 saturating");
+    check_gemm<Q3_4>("Q3.4 wrapping");
+    check_gemm<Q7_8S>("Q7.8 saturating");
+    check_gemm<Q15_16>("Q15.16 wrapping");
+    check_gemm<Q15_16S>("Q15.16 saturating");
+
+    std::mt19937 gen(5);
+    const size_t m = 6, k = 77;
+    const auto a = random_values<Q15_16S>(gen, m * k);
+    const auto x = random_values<Q15_16S>(gen, k);
+    std::vector<Q15_16S> y(m);
+    gemv(a, x, std::span(y));
+    bool ok = true;
+    for (size_t i = 0; i < m; ++i) {
+        ok = ok && y[i] == dot(std::span(a).subspan(i * k, k), x);
+    }
+    check("gemv rows are dot products", ok);
+}
+
+int main() {
+    std::cout << "Testing Linear Algebra\n";
+    std::cout << "======================\n\n";
+
+    test_types();
+    test_transforms();
+    test_qgemm();
+    test_gemm();
+
+    std::cout << "\n" << (failures == 0 ? "All linear algebra tests passed!"
+                                        : "Linear algebra tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "fixp/fixed_point.hpp"
+
+#include <cmath>
+#include <type_traits>
+
+using namespace libfixp;
+
+namespace {
+
+using Q7 = FixedPoint<8, 7>;                                     // Q0.7
+using U4_4 = FixedPoint<8, 4, false>;                            // UQ4.4
+using Q16 = FixedPoint<32, 16>;                                  // Q15.16
+using Q16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+using Q15 = FixedPoint<16, 15>;                                  // Q0.15
+using Q31 = FixedPoint<32, 31>;                                  // Q0.31
+
+// Exact value of a raw integer at F fractional bits; fits a double for <= 53 bits
+template<typename FP>
+double value(FP x) {
+    return std::ldexp(static_cast<double>(x.raw()), -FP::fractional_bits);
+}
+
+} // namespace
+
+TEST_CASE("Mixed-format result types", "[mixed][types]") {
+    STATIC_REQUIRE(std::is_same_v<decltype(Q7() * Q16()), FixedPoint<40, 23>>);
+    STATIC_REQUIRE(std::is_same_v<decltype(Q15() * Q31()), FixedPoint<48, 46>>);
+    STATIC_REQUIRE(std::is_same_v<decltype(U4_4() * Q7()), FixedPoint<16, 11>>);
+    STATIC_REQUIRE(std::is_same_v<decltype(U4_4() * FixedPoint<8, 8, false>()),
+                                  FixedPoint<16, 12, false>>);
+
+    // One more integer bit than the wider operand, the finer fraction
+    STATIC_REQUIRE(std::is_same_v<decltype(Q7() + Q16()), FixedPoint<33, 16>>);
+    STATIC_REQUIRE(std::is_same_v<decltype(U4_4() + FixedPoint<8, 8, false>()),
+                                  FixedPoint<13, 8, false>>);
+    STATIC_REQUIRE(std::is_same_v<decltype(U4_4() - FixedPoint<8, 8, false>()),
+                                  FixedPoint<14, 8, true>>);
+
+    // Q0.7 / Q15.16: up to 2^16 in magnitude, down to 2^-22
+    STATIC_REQUIRE(std::is_same_v<decltype(Q7() / Q16()), FixedPoint<40, 22>>);
+
+    // Saturation is sticky through mixed expressions
+    STATIC_REQUIRE(decltype(Q7() * Q16S())::overflow_policy == OverflowPolicy::Saturate);
+    STATIC_REQUIRE(decltype(Q7() * Q16())::overflow_policy == OverflowPolicy::Wrap);
+
+    // Same-format operators are unchanged
+    STATIC_REQUIRE(std::is_same_v<decltype(Q16() * Q16()), Q16>);
+    STATIC_REQUIRE(std::is_same_v<decltype(Q7() + Q7()), Q7>);
+}
+
+TEST_CASE("Mixed-format arithmetic is exact", "[mixed]") {
+    SECTION("Exhaustive 8-bit products, sums and differences") {
+        for (int a = -128; a < 128; ++a) {
+            for (int b = 0; b < 256; ++b) {
+                const Q7 x = Q7::from_raw(static_cast<int8_t>(a));
+                const U4_4 y = U4_4::from_raw(static_cast<uint8_t>(b));
+                REQUIRE(value(x * y) == value(x) * value(y));
+                REQUIRE(value(y * x) == value(x) * value(y));
+                REQUIRE(value(x + y) == value(x) + value(y));
+                REQUIRE(value(x - y) == value(x) - value(y));
+                REQUIRE(value(y - x) == value(y) - value(x));
+            }
+        }
+    }
+
+    SECTION("Coefficient times sample") {
+        const Q7 c(-0.75);
+        const Q16 x(123.456);
+        const auto p = c * x;
+        REQUIRE(value(p) == value(c) * value(x));
+        REQUIRE(static_cast<double>(fixed_cast<Q16>(p)) == Catch::Approx(-0.75 * 123.456)
+                                                               .epsilon(1e-4));
+    }
+
+    SECTION("Division") {
+        const Q16 a(10.0);
+        const Q7 b(0.25);
+        REQUIRE(value(a / b) == 40.0);
+        REQUIRE(value(b / a) == Catch::Approx(0.025).epsilon(1e-5));
+        // min / -1 needs the extra integer bit
+        const auto q = Q7::min() / FixedPoint<8, 0>(-1);
+        REQUIRE(value(q) == 1.0);
+        REQUIRE((Q16(3.0) / Q7::zero()) == decltype(Q16() / Q7())::max());
+    }
+
+    SECTION("Comparisons across formats") {
+        REQUIRE(Q7(0.5) == Q16(0.5));
+        REQUIRE(Q7(0.5) < Q16(0.5000153));
+        REQUIRE(Q16(-1.0) < Q7(-0.9921875));
+        REQUIRE(U4_4(0.0) > Q7(-0.0078125));
+        REQUIRE(Q15(0.25) != Q31(0.2500001));
+    }
+}
+
+TEST_CASE("fixed_cast", "[mixed][cast]") {
+    SECTION("Widening is exact") {
+        REQUIRE(fixed_cast<Q31>(Q15::from_raw(-12345)).raw() == -12345 * 65536);
+        REQUIRE(fixed_cast<Q16>(Q7::from_raw(-128)) == Q16(-1.0));
+    }
+
+    SECTION("Narrowing rounds to nearest") {
+        REQUIRE(fixed_cast<Q15>(Q31::from_raw(0x00018000)).raw() == 2);   // 1.5 LSB
+        REQUIRE(fixed_cast<Q15>(Q31::from_raw(0x00017FFF)).raw() == 1);
+        REQUIRE(fixed_cast<Q15>(Q31::from_raw(-0x00018000)).raw() == -1); // ties up
+    }
+
+    SECTION("Saturate clamps, Wrap keeps the low bits") {
+        using Q7S = FixedPoint<8, 7, true, OverflowPolicy::Saturate>;
+        REQUIRE(fixed_cast<Q7S>(Q16(1.5)) == Q7S::max());
+        REQUIRE(fixed_cast<Q7S>(Q16(-3.0)) == Q7S::min());
+        REQUIRE(fixed_cast<Q7>(Q16(1.5)).raw() == static_cast<int8_t>(192));
+        using U8S = FixedPoint<8, 4, false, OverflowPolicy::Saturate>;
+        REQUIRE(fixed_cast<U8S>(Q16(-2.0)) == U8S::min());
+        REQUIRE(fixed_cast<U8S>(Q16(100.0)) == U8S::max());
+        REQUIRE(fixed_cast<Q16S>(FixedPoint<64, 16>(1e12)) == Q16S::max());
+    }
+
+    SECTION("Round trip through a full-precision chain") {
+        // y = c0 * x0 + c1 * x1 with one rounding at the end
+        const Q7 c0(0.5), c1(-0.25);
+        const Q16 x0(3.0), x1(-7.5);
+        const Q16 y = fixed_cast<Q16>(c0 * x0 + c1 * x1);
+        REQUIRE(y == Q16(3.375));
+    }
+
+    SECTION("Usable in constant expressions") {
+        constexpr Q15 h = fixed_cast<Q15>(Q7(0.5) * Q7(0.5));
+        STATIC_REQUIRE(h.raw() == 8192);
+    }
+}
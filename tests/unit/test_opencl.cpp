@@ -0,0 +1,174 @@
+// Engine on the first OpenCL device against the CPU; exits 77 (skipped)
+// when the machine has none
+#include <fixp/opencl.hpp>
+#include <fixp/gen/q15_16_cl.h>
+#include <fixp/gen/q7_8_cl.h>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::dsp;
+
+using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+using Q15_16D = FixedPoint<32, 16, true, OverflowPolicy::Dynamic>;
+using Q7_8S = FixedPoint<16, 8, true, OverflowPolicy::Saturate>;
+
+// Chunks this small put several transfers on each queue
+constexpr size_t Chunk = 1000;
+
+template<typename FP>
+std::vector<FP> random_values(std::mt19937& gen, size_t n) {
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<typename FP::raw_type>::min(),
+                                                std::numeric_limits<typename FP::raw_type>::max());
+    std::uniform_int_distribution<int> shift(0, std::numeric_limits<typename FP::raw_type>::digits);
+    std::vector<FP> x(n);
+    for (auto& v : x) v = FP::from_raw(static_cast<typename FP::raw_type>(dist(gen) >> shift(gen)));
+    return x;
+}
+
+template<typename A, typename B>
+bool same(const A& a, const B& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].raw() != b[i].raw()) return false;
+    }
+    return true;
+}
+
+template<typename FP>
+void test_arithmetic(opencl::Context& context, std::string_view source, const char* name) {
+    std::cout << name << " arithmetic:\n";
+    opencl::Engine<FP> engine(context, source, Chunk);
+    std::mt19937 gen(1);
+    const size_t n = 10 * Chunk + 7;
+    const auto a = random_values<FP>(gen, n), b = random_values<FP>(gen, n);
+    const auto c = random_values<FP>(gen, n);
+    std::vector<FP> got(n), expected(n);
+
+    engine.add(a, b, std::span(got));
+    for (size_t i = 0; i < n; ++i) expected[i] = a[i] + b[i];
+    check("add", same(got, expected));
+    engine.sub(a, b, std::span(got));
+    for (size_t i = 0; i < n; ++i) expected[i] = a[i] - b[i];
+    check("sub", same(got, expected));
+    engine.mul(a, b, std::span(got));
+    for (size_t i = 0; i < n; ++i) expected[i] = a[i] * b[i];
+    check("mul", same(got, expected));
+    engine.mul_add(a, b, c, std::span(got));
+    for (size_t i = 0; i < n; ++i) expected[i] = a[i] * b[i] + c[i];
+    check("mul_add", same(got, expected));
+    engine.scale(a, b[0], std::span(got));
+    for (size_t i = 0; i < n; ++i) expected[i] = a[i] * b[0];
+    check("scale", same(got, expected));
+}
+
+void test_conversions(opencl::Context& context) {
+    std::cout << "Float conversions:\n";
+    opencl::Engine<Q15_16> engine(context, q15_16_cl_source, Chunk);
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<float> dist(-40000.0f, 40000.0f);
+    std::vector<float> in(5 * Chunk);
+    for (auto& v : in) v = dist(gen);
+    in[1] = std::numeric_limits<float>::quiet_NaN();
+    in[2] = 0x1p-17f;
+    in[3] = -3 * 0x1p-17f;
+
+    bool ok = true;
+    for (auto rounding : {batch::Rounding::HalfEven, batch::Rounding::HalfAway}) {
+        std::vector<Q15_16> got(in.size()), expected(in.size());
+        engine.from_float(in, std::span(got), rounding);
+        batch::from_float(std::span<const float>(in), std::span(expected), rounding);
+        ok = ok && same(got, expected);
+    }
+    check("from_float", ok);
+
+    const auto values = random_values<Q15_16>(gen, 3 * Chunk + 1);
+    std::vector<float> got(values.size()), expected(values.size());
+    engine.to_float(values, std::span(got));
+    batch::to_float(values, std::span(expected));
+    check("to_float", got == expected);
+}
+
+void test_fft(opencl::Context& context) {
+    std::cout << "Batched FFT:\n";
+    // Three frames per chunk, the last chunk short
+    constexpr size_t N = 256, Frames = 10;
+    opencl::Engine<Q15_16S> engine(context, q15_16_cl_source, 3 * N);
+    static const FftPlan<Q15_16S, N> plan;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-2000.0, 2000.0);
+    std::vector<Complex<Q15_16S>> data(N * Frames);
+    for (auto& x : data) x = Complex<Q15_16S>(Q15_16S(dist(gen)), Q15_16S(dist(gen)));
+
+    auto expected = data;
+    for (bool inverse : {false, true}) {
+        for (size_t f = 0; f < Frames; ++f) {
+            plan.execute(std::span(expected).subspan(f * N).first<N>(), inverse);
+        }
+        engine.fft(plan, std::span(data), inverse);
+        bool match = true;
+        for (size_t i = 0; i < data.size(); ++i) {
+            match = match && data[i].real.raw() == expected[i].real.raw() &&
+                    data[i].imag.raw() == expected[i].imag.raw();
+        }
+        check(inverse ? "inverse, saturating" : "forward, saturating", match);
+    }
+}
+
+void test_policies(opencl::Context& context) {
+    std::cout << "Policies and formats:\n";
+    opencl::Engine<Q15_16D> engine(context, q15_16_cl_source, Chunk);
+    const std::vector<Q15_16D> big(10, Q15_16D::from_raw(std::numeric_limits<int32_t>::max()));
+    std::vector<Q15_16D> got(big.size());
+    {
+        ScopedOverflowPolicy saturate(OverflowPolicy::Saturate);
+        engine.add(big, big, std::span(got));
+    }
+    check("Dynamic follows the run-time policy", got[9] == Q15_16D::max());
+
+    bool threw = false;
+    try {
+        ScopedOverflowPolicy trap(OverflowPolicy::Trap);
+        engine.add(big, big, std::span(got));
+    } catch (const std::domain_error&) {
+        threw = true;
+    }
+    check("Dynamic under Trap throws", threw);
+
+    threw = false;
+    try {
+        opencl::Engine<Q7_8S> mismatched(context, q15_16_cl_source);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check("a program for another format is rejected", threw);
+}
+
+int main() {
+    std::cout << "Testing OpenCL Offload\n";
+    std::cout << "======================\n\n";
+
+    std::optional<opencl::Context> context;
+    try {
+        context.emplace();
+    } catch (const opencl::Error& e) {
+        std::cout << "No OpenCL device (" << e.what() << "); skipping\n";
+        return 77;
+    }
+    std::cout << "Device: " << context->device_name() << "\n\n";
+
+    test_arithmetic<Q15_16>(*context, q15_16_cl_source, "Q15.16 wrapping");
+    test_arithmetic<Q15_16S>(*context, q15_16_cl_source, "Q15.16 saturating");
+    test_arithmetic<Q7_8S>(*context, q7_8_cl_source, "Q7.8 saturating");
+    test_conversions(*context);
+    test_fft(*context);
+    test_policies(*context);
+
+    std::cout << "\n" << (failures == 0 ? "All OpenCL tests passed!" : "OpenCL tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+// The generated OpenCL kernels compiled as C++, one work-item after another,
+// against the CPU arithmetic they must match bit for bit
+#include <fixp/batch.hpp>
+#include <fixp/dsp.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::dsp;
+
+namespace cl_emulation {
+
+using uchar = unsigned char;
+using ushort = unsigned short;
+using uint = unsigned int;
+using std::isnan;
+using std::rint;
+using std::round;
+
+inline size_t work_item = 0;
+inline size_t get_global_id(uint) { return work_item; }
+
+// OpenCL C's char is signed and its long 64 bits
+#define __kernel
+#define __global
+#define char signed char
+#define long int64_t
+#include "q15_16.cl"
+#include "q7_8.cl"
+#include "q0_7.cl"
+#include "q1_30.cl"
+#undef long
+#undef char
+#undef __global
+#undef __kernel
+
+// As Engine launches: whole groups of 64 work-items
+template<typename Kernel, typename... Args>
+void launch(size_t items, Kernel kernel, Args... args) {
+    for (work_item = 0; work_item < (items + 63) / 64 * 64; ++work_item) kernel(args...);
+}
+
+} // namespace cl_emulation
+
+#define FORMAT_KERNELS(P)                                                                     \
+    struct P##_kernels {                                                                      \
+        static constexpr auto add_wrap = cl_emulation::P##_add_wrap;                          \
+        static constexpr auto sub_wrap = cl_emulation::P##_sub_wrap;                          \
+        static constexpr auto mul_wrap = cl_emulation::P##_mul_wrap;                          \
+        static constexpr auto mul_add_wrap = cl_emulation::P##_mul_add_wrap;                  \
+        static constexpr auto scale_wrap = cl_emulation::P##_scale_wrap;                      \
+        static constexpr auto fft_stage_wrap = cl_emulation::P##_fft_stage_wrap;              \
+        static constexpr auto add_sat = cl_emulation::P##_add_sat;                            \
+        static constexpr auto sub_sat = cl_emulation::P##_sub_sat;                            \
+        static constexpr auto mul_sat = cl_emulation::P##_mul_sat;                            \
+        static constexpr auto mul_add_sat = cl_emulation::P##_mul_add_sat;                    \
+        static constexpr auto scale_sat = cl_emulation::P##_scale_sat;                        \
+        static constexpr auto fft_stage_sat = cl_emulation::P##_fft_stage_sat;                \
+        static constexpr auto from_float = cl_emulation::P##_from_float;                      \
+        static constexpr auto to_float = cl_emulation::P##_to_float;                          \
+        static constexpr auto fft_bitrev = cl_emulation::P##_fft_bitrev;                      \
+        static constexpr auto fft_scale = cl_emulation::P##_fft_scale;                        \
+    }
+
+FORMAT_KERNELS(q15_16);
+FORMAT_KERNELS(q7_8);
+FORMAT_KERNELS(q0_7);
+FORMAT_KERNELS(q1_30);
+
+// Random raw values of every magnitude, so that products both saturate and
+// round, with each format's extremes among them
+template<typename Raw>
+std::vector<Raw> random_raws(std::mt19937& gen, size_t n) {
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<Raw>::min(),
+                                                std::numeric_limits<Raw>::max());
+    std::uniform_int_distribution<int> shift(0, std::numeric_limits<Raw>::digits - 1);
+    std::vector<Raw> x(n);
+    for (auto& v : x) v = static_cast<Raw>(dist(gen) >> shift(gen));
+    const Raw edges[] = {std::numeric_limits<Raw>::min(), std::numeric_limits<Raw>::max(), 0, 1,
+                         -1};
+    for (size_t i = 0; i < std::size(edges) && i < n; ++i) x[i * 7 % n] = edges[i];
+    return x;
+}
+
+template<typename FP, typename Kernel>
+bool mul_add_matches(Kernel kernel, const std::vector<typename FP::raw_type>& a,
+                     const std::vector<typename FP::raw_type>& b,
+                     const std::vector<typename FP::raw_type>& c) {
+    // n is not a multiple of 64, so the guard is exercised
+    const auto n = static_cast<unsigned>(a.size());
+    std::vector<typename FP::raw_type> out(n);
+    cl_emulation::launch(n, kernel, a.data(), b.data(), c.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        const FP expected = FP::from_raw(a[i]) * FP::from_raw(b[i]) + FP::from_raw(c[i]);
+        if (out[i] != expected.raw()) return false;
+    }
+    return true;
+}
+
+template<typename FP, typename Op, typename Kernel>
+bool binary_matches(Kernel kernel, Op op, const std::vector<typename FP::raw_type>& a,
+                    const std::vector<typename FP::raw_type>& b) {
+    const auto n = static_cast<unsigned>(a.size());
+    std::vector<typename FP::raw_type> out(n);
+    cl_emulation::launch(n, kernel, a.data(), b.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        if (out[i] != op(FP::from_raw(a[i]), FP::from_raw(b[i])).raw()) return false;
+    }
+    return true;
+}
+
+template<typename FP, typename Kernel>
+bool scale_matches(Kernel kernel, const std::vector<typename FP::raw_type>& a,
+                   typename FP::raw_type s) {
+    const auto n = static_cast<unsigned>(a.size());
+    std::vector<typename FP::raw_type> out(n);
+    cl_emulation::launch(n, kernel, a.data(), s, out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        if (out[i] != (FP::from_raw(a[i]) * FP::from_raw(s)).raw()) return false;
+    }
+    return true;
+}
+
+template<typename FP, typename Kernels>
+bool policy_matches(std::mt19937& gen, bool saturate) {
+    using Raw = typename FP::raw_type;
+    const auto a = random_raws<Raw>(gen, 1001), b = random_raws<Raw>(gen, 1001);
+    const auto c = random_raws<Raw>(gen, 1001);
+    const auto plus = [](FP x, FP y) { return x + y; };
+    const auto minus = [](FP x, FP y) { return x - y; };
+    const auto times = [](FP x, FP y) { return x * y; };
+    if (saturate) {
+        return binary_matches<FP>(Kernels::add_sat, plus, a, b) &&
+               binary_matches<FP>(Kernels::sub_sat, minus, a, b) &&
+               binary_matches<FP>(Kernels::mul_sat, times, a, b) &&
+               mul_add_matches<FP>(Kernels::mul_add_sat, a, b, c) &&
+               scale_matches<FP>(Kernels::scale_sat, a, b[3]) &&
+               scale_matches<FP>(Kernels::scale_sat, a, std::numeric_limits<Raw>::min());
+    }
+    return binary_matches<FP>(Kernels::add_wrap, plus, a, b) &&
+           binary_matches<FP>(Kernels::sub_wrap, minus, a, b) &&
+           binary_matches<FP>(Kernels::mul_wrap, times, a, b) &&
+           mul_add_matches<FP>(Kernels::mul_add_wrap, a, b, c) &&
+           scale_matches<FP>(Kernels::scale_wrap, a, b[3]) &&
+           scale_matches<FP>(Kernels::scale_wrap, a, std::numeric_limits<Raw>::min());
+}
+
+template<typename FP, typename Kernels>
+bool conversions_match(std::mt19937& gen) {
+    using Raw = typename FP::raw_type;
+    const float range = std::ldexp(1.0f, std::numeric_limits<Raw>::digits - FP::fractional_bits);
+    const float lsb = std::ldexp(1.0f, -FP::fractional_bits);
+    std::uniform_real_distribution<float> dist(-1.5f * range, 1.5f * range);
+    std::vector<float> in;
+    for (int i = 0; i < 500; ++i) in.push_back(dist(gen));
+    // Ties, the range limits and the values floats cannot order
+    for (int k = -20; k < 20; ++k) in.push_back((static_cast<float>(k) + 0.5f) * lsb);
+    for (float v : {range, -range, range - lsb, -range - lsb, 0.0f, -0.0f,
+                    std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                    std::numeric_limits<float>::quiet_NaN(), 1e30f, -1e30f}) {
+        in.push_back(v);
+    }
+    const auto n = static_cast<unsigned>(in.size());
+
+    bool ok = true;
+    for (auto rounding : {batch::Rounding::HalfEven, batch::Rounding::HalfAway}) {
+        std::vector<FP> expected(n);
+        batch::from_float(std::span<const float>(in), std::span(expected), rounding);
+        std::vector<Raw> got(n);
+        cl_emulation::launch(n, Kernels::from_float, in.data(),
+                             rounding == batch::Rounding::HalfEven ? 1 : 0, got.data(), n);
+        for (size_t i = 0; i < n; ++i) ok = ok && got[i] == expected[i].raw();
+    }
+
+    const auto raws = random_raws<Raw>(gen, 777);
+    std::vector<FP> values(raws.size());
+    for (size_t i = 0; i < raws.size(); ++i) values[i] = FP::from_raw(raws[i]);
+    std::vector<float> expected(raws.size()), got(raws.size());
+    batch::to_float(values, std::span(expected));
+    cl_emulation::launch(raws.size(), Kernels::to_float, raws.data(), got.data(),
+                         static_cast<unsigned>(raws.size()));
+    return ok && got == expected;
+}
+
+// The passes Engine::fft enqueues, over frames of N interleaved raw pairs
+template<typename FP, size_t N, typename Kernels, typename Stage>
+void emulate_fft(const FftPlan<FP, N>& plan, Stage stage, std::vector<typename FP::raw_type>& data,
+                 bool inverse) {
+    std::vector<int32_t> twiddles;
+    for (const auto& w : plan.twiddles()) {
+        twiddles.push_back(w.real);
+        twiddles.push_back(w.imag);
+    }
+    const auto n = static_cast<unsigned>(N);
+    const auto frames = static_cast<unsigned>(data.size() / (2 * N));
+    cl_emulation::launch(N * frames, Kernels::fft_bitrev, data.data(), plan.bit_reversal().data(),
+                         n, frames);
+    for (unsigned half = 1, stride = n / 2; half < n; half <<= 1, stride >>= 1) {
+        cl_emulation::launch(N / 2 * frames, stage, data.data(), twiddles.data(), n, half, stride,
+                             frames, inverse ? 1 : 0);
+    }
+    if (inverse) {
+        const auto values = static_cast<unsigned>(data.size());
+        cl_emulation::launch(values, Kernels::fft_scale, data.data(),
+                             static_cast<unsigned>(FftPlan<FP, N>::log2_size), values);
+    }
+}
+
+template<typename FP, typename Kernels, typename Stage>
+bool fft_matches(std::mt19937& gen, Stage stage, double amplitude) {
+    constexpr size_t N = 64, Frames = 3;
+    static const FftPlan<FP, N> plan;
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::vector<Complex<FP>> expected(N * Frames);
+    for (auto& x : expected) x = Complex<FP>(FP(dist(gen)), FP(dist(gen)));
+    // The first frame is a pulse, whose spectrum is flat
+    const FP pulse(amplitude);
+    std::fill_n(expected.begin(), N, Complex<FP>());
+    expected[0] = Complex<FP>(pulse, FP(0));
+
+    bool ok = true;
+    for (bool inverse : {false, true}) {
+        std::vector<typename FP::raw_type> data;
+        for (const auto& x : expected) {
+            data.push_back(x.real.raw());
+            data.push_back(x.imag.raw());
+        }
+        for (size_t f = 0; f < Frames; ++f) {
+            plan.execute(std::span(expected).subspan(f * N).template first<N>(), inverse);
+        }
+        emulate_fft<FP, N, Kernels>(plan, stage, data, inverse);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ok = ok && data[2 * i] == expected[i].real.raw() &&
+                 data[2 * i + 1] == expected[i].imag.raw();
+        }
+        for (size_t i = 0; i < N && !inverse; ++i) {
+            ok = ok && data[2 * i] == pulse.raw() && data[2 * i + 1] == 0;
+        }
+    }
+    return ok;
+}
+
+template<int Bits, int Frac, typename Kernels>
+void test_format(const char* name, double fft_amplitude) {
+    std::cout << name << ":\n";
+    using Wrap = FixedPoint<Bits, Frac, true, OverflowPolicy::Wrap>;
+    using Sat = FixedPoint<Bits, Frac, true, OverflowPolicy::Saturate>;
+    std::mt19937 gen(Bits * 100 + Frac);
+    check("wrap arithmetic", policy_matches<Wrap, Kernels>(gen, false));
+    check("saturating arithmetic", policy_matches<Sat, Kernels>(gen, true));
+    check("float conversions", conversions_match<Wrap, Kernels>(gen));
+    check("FFT, wrapping", fft_matches<Wrap, Kernels>(gen, Kernels::fft_stage_wrap, fft_amplitude));
+    // Large enough that the saturating butterflies clip
+    check("FFT, saturating",
+          fft_matches<Sat, Kernels>(gen, Kernels::fft_stage_sat, fft_amplitude * 16));
+}
+
+int main() {
+    std::cout << "Testing Generated OpenCL Kernels\n";
+    std::cout << "================================\n\n";
+
+    test_format<32, 16, q15_16_kernels>("Q15.16", 100.0);
+    test_format<16, 8, q7_8_kernels>("Q7.8", 1.0);
+    test_format<8, 7, q0_7_kernels>("Q0.7", 0.01);
+    test_format<32, 30, q1_30_kernels>("Q1.30", 0.02);
+
+    std::cout << "\n" << (failures == 0 ? "All OpenCL kernel tests passed!"
+                                        : "OpenCL kernel tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
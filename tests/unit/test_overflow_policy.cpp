@@ -0,0 +1,286 @@
+#include <fixp/accumulator.hpp>
+#include <fixp/batch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+using DQ15_16 = FixedPoint<32, 16, true, OverflowPolicy::Dynamic>;
+using Q15_16T = FixedPoint<32, 16, true, OverflowPolicy::Trap>;
+using Q15_16U = FixedPoint<32, 16, true, OverflowPolicy::Undefined>;
+using Q7_8T = FixedPoint<16, 8, true, OverflowPolicy::Trap>;
+using DQ7_8 = FixedPoint<16, 8, true, OverflowPolicy::Dynamic>;
+
+// Constant evaluation treats Dynamic as Trap, so in-range constants work and
+// overflowing ones do not compile
+static_assert(DQ15_16(1.5) + DQ15_16(2.0) == DQ15_16(3.5));
+static_assert(DQ15_16(-1.5) * DQ15_16(2.0) == DQ15_16(-3.0));
+static_assert(Q15_16U(3.0) - Q15_16U(5.0) == Q15_16U(-2.0));
+// Mixed-format results take the stricter policy
+static_assert((Q15_16T(1.0) * Q15_16(2.0)).overflow_policy == OverflowPolicy::Trap);
+static_assert((DQ15_16(1.0) + Q15_16(2.0)).overflow_policy == OverflowPolicy::Dynamic);
+
+// A Trap handler that counts overflows and lets the wrapped result through
+static int trapped = 0;
+static const char* last_operation = "";
+
+static void count_overflow(const char* operation) {
+    ++trapped;
+    last_operation = operation;
+}
+
+// Resets the counter and returns how many overflows f() trapped
+template<typename F>
+int traps(F f) {
+    trapped = 0;
+    f();
+    return trapped;
+}
+
+void test_dynamic_policy() {
+    std::cout << "Dynamic policy:\n";
+    const DQ15_16 big(30000.0);
+    const auto wrap = FixedPoint<32, 16>(30000.0) + FixedPoint<32, 16>(30000.0);
+
+    set_dynamic_overflow_policy(OverflowPolicy::Saturate);
+    check("Saturate clamps", big + big == DQ15_16::max() && -big - big == DQ15_16::min());
+    set_dynamic_overflow_policy(OverflowPolicy::Wrap);
+    check("Wrap wraps", (big + big).raw() == wrap.raw());
+    check("dynamic_overflow_policy reports it", dynamic_overflow_policy() == OverflowPolicy::Wrap);
+
+    {
+        ScopedOverflowPolicy scoped(OverflowPolicy::Saturate);
+        check("ScopedOverflowPolicy overrides the process policy", big + big == DQ15_16::max());
+        {
+            ScopedOverflowPolicy inner(OverflowPolicy::Trap);
+            check("nested scopes stack",
+                  traps([&] { (void)(big + big); }) == 1 && traps([&] { (void)(big * big); }) == 1);
+        }
+        check("scopes restore the outer policy", big + big == DQ15_16::max());
+
+        // Another thread still sees the process-wide Wrap
+        bool other = false;
+        std::thread([&] { other = (big + big).raw() == wrap.raw(); }).join();
+        check("the override is per thread", other);
+    }
+    check("scopes restore the process policy", (big + big).raw() == wrap.raw());
+
+    set_dynamic_overflow_policy(OverflowPolicy::Undefined);
+    check("set_dynamic_overflow_policy ignores static-only policies",
+          dynamic_overflow_policy() == OverflowPolicy::Wrap);
+    set_dynamic_overflow_policy(OverflowPolicy::Saturate);
+}
+
+void test_trap() {
+    std::cout << "Trap policy:\n";
+    const Q15_16T big(30000.0);
+    check("in-range arithmetic does not trap", traps([] {
+              (void)(Q15_16T(100.0) * Q15_16T(-3.0) + Q15_16T(0.5) - Q15_16T(7.0));
+          }) == 0);
+    check("add traps", traps([&] { (void)(big + big); }) == 1 &&
+                       std::strcmp(last_operation, "add") == 0);
+    check("sub traps", traps([&] { (void)(-big - big); }) == 1 &&
+                       std::strcmp(last_operation, "sub") == 0);
+    check("neg traps", traps([] { (void)(-Q15_16T::min()); }) == 1);
+    check("mul traps", traps([&] { (void)(big * big); }) == 1 &&
+                       std::strcmp(last_operation, "mul") == 0);
+    check("a returning handler yields the wrapped result",
+          (big + big).raw() == (Q15_16(30000.0) + Q15_16(30000.0)).raw());
+    check("a tag overrides Trap", traps([&] { (void)add(big, big, saturating); }) == 0 &&
+                                  add(big, big, saturating) == Q15_16T::max());
+    check("16-bit formats trap", traps([] { (void)(Q7_8T(100.0) + Q7_8T(100.0)); }) == 1);
+
+    check("fixed_cast traps",
+          traps([] { (void)fixed_cast<Q7_8T>(Q15_16(1000.0)); }) == 1 &&
+          std::strcmp(last_operation, "fixed_cast") == 0 &&
+          traps([] { (void)fixed_cast<Q7_8T>(Q15_16(100.0)); }) == 0);
+
+    Accumulator<Q7_8T> acc;
+    for (int i = 0; i < 10; ++i) acc.mac(Q7_8T(10.0), Q7_8T(10.0));
+    check("Accumulator::result traps", traps([&] { (void)acc.result(); }) == 1 &&
+                                       std::strcmp(last_operation, "Accumulator") == 0);
+}
+
+void test_division() {
+    std::cout << "Division:\n";
+    using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+    using Q31_32T = FixedPoint<64, 32, true, OverflowPolicy::Trap>;
+    using Q31_32S = FixedPoint<64, 32, true, OverflowPolicy::Saturate>;
+
+    check("in-range quotients do not trap", traps([] {
+              (void)(Q15_16T(1000.0) / Q15_16T(-0.5) + Q31_32T(-7.5) / Q31_32T(2.5));
+          }) == 0 && Q31_32T(-7.5) / Q31_32T(2.5) == Q31_32T(-3.0));
+    check("div traps", traps([] { (void)(Q15_16T(1000.0) / Q15_16T(0.001)); }) == 1 &&
+                       std::strcmp(last_operation, "div") == 0);
+    check("64-bit div traps", traps([] { (void)(Q31_32T(1e6) / Q31_32T(1e-6)); }) == 1 &&
+                              traps([] { (void)(Q31_32T::min() / Q31_32T::from_raw(-1)); }) == 1);
+    check("Saturate clamps quotients",
+          Q15_16S(1000.0) / Q15_16S(0.001) == Q15_16S::max() &&
+          Q15_16S(-1000.0) / Q15_16S(0.001) == Q15_16S::min() &&
+          Q31_32S(1e6) / Q31_32S(-1e-6) == Q31_32S::min() &&
+          Q31_32S::min() / Q31_32S::from_raw(-1) == Q31_32S::max());
+
+    // Wrap keeps the low bits of the double-width quotient
+    const Q15_16 a(1000.0), b(0.001);
+    const auto low = static_cast<std::int32_t>(static_cast<std::uint32_t>(
+        (static_cast<std::int64_t>(a.raw()) << 16) / b.raw()));
+    check("Wrap wraps quotients", (a / b).raw() == low && div(a, b, wrapping).raw() == low);
+    check("a tag overrides the format's policy",
+          div(Q15_16T(1000.0), Q15_16T(0.001), saturating) == Q15_16T::max());
+    {
+        ScopedOverflowPolicy scoped(OverflowPolicy::Trap);
+        check("Dynamic Trap traps quotients",
+              traps([] { (void)(DQ15_16(1000.0) / DQ15_16(0.001)); }) == 1);
+    }
+    check("division by zero is not an overflow",
+          traps([] { (void)(Q15_16T(1.0) / Q15_16T(0.0)); }) == 0 &&
+          Q15_16T(-1.0) / Q15_16T(0.0) == Q15_16T::min());
+}
+
+void test_undefined() {
+    std::cout << "Undefined policy:\n";
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-150.0, 150.0);
+    bool same = true;
+    for (int i = 0; i < 10000; ++i) {
+        const double x = dist(gen), y = dist(gen);
+        const Q15_16U a(x), b(y);
+        same = same && (a + b).raw() == (Q15_16(x) + Q15_16(y)).raw() &&
+               (a - b).raw() == (Q15_16(x) - Q15_16(y)).raw() &&
+               (a * b).raw() == (Q15_16(x) * Q15_16(y)).raw() && (-a).raw() == (-Q15_16(x)).raw();
+    }
+    check("matches Wrap without overflow", same);
+    check("unchecked tag", add(Q15_16(1.0), Q15_16(2.0), unchecked) == Q15_16(3.0));
+}
+
+void test_conversions() {
+    std::cout << "Conversions:\n";
+    using Q7_8 = FixedPoint<16, 8>;
+    using Q31_32 = FixedPoint<64, 32>;
+    using Q31_32T = FixedPoint<64, 32, true, OverflowPolicy::Trap>;
+    using Q31_32S = FixedPoint<64, 32, true, OverflowPolicy::Saturate>;
+    using Q7_8U = FixedPoint<16, 8, true, OverflowPolicy::Undefined>;
+
+    {
+        ScopedOverflowPolicy scoped(OverflowPolicy::Saturate);
+        check("Dynamic Saturate clamps doubles",
+              DQ7_8(300.0) == DQ7_8::max() && DQ7_8(-300.0f) == DQ7_8::min());
+        check("Dynamic Saturate clamps ints",
+              DQ7_8(200) == DQ7_8::max() && DQ7_8(-200) == DQ7_8::min());
+    }
+    {
+        ScopedOverflowPolicy scoped(OverflowPolicy::Wrap);
+        // 300 * 256 = 76800 wraps to 11264; 200 * 256 = 51200 wraps to -14336
+        check("Dynamic Wrap wraps", DQ7_8(300.0).raw() == 11264 && DQ7_8(200).raw() == -14336);
+    }
+    {
+        ScopedOverflowPolicy scoped(OverflowPolicy::Trap);
+        check("Dynamic Trap traps",
+              traps([] { (void)DQ7_8(300.0); }) == 1 &&
+                  std::strcmp(last_operation, "convert") == 0 &&
+                  traps([] { (void)DQ7_8(200); }) == 1 && traps([] { (void)DQ7_8(-128.0); }) == 0);
+    }
+    check("Trap traps on out-of-range values only",
+          traps([] { (void)Q7_8T(127.99); }) == 0 && traps([] { (void)Q7_8T(127.999); }) == 1 &&
+          traps([] { (void)Q7_8T(-128.001); }) == 0 && traps([] { (void)Q7_8T(-128.002); }) == 1);
+    check("the trapped result wraps", Q7_8T(300.0).raw() == 11264);
+
+    // 64-bit storage: the conversion must not rely on an out-of-range cast
+    const auto wrapped = static_cast<int64_t>(static_cast<uint64_t>(1000000000000) << 32);
+    check("64-bit Wrap keeps the low bits", Q31_32(1e12).raw() == wrapped &&
+                                                 Q31_32(-1e12).raw() == -wrapped);
+    check("64-bit Trap traps", traps([] { (void)Q31_32T(1e12); }) == 1 &&
+                               traps([] { (void)Q31_32T(-2147483648.0); }) == 0 &&
+                               traps([] { (void)Q31_32T(2147483648.0); }) == 1);
+    check("64-bit Saturate clamps", Q31_32S::from_raw(Q31_32S(1e30).raw()) == Q31_32S::max() &&
+                                        Q31_32S::from_raw(Q31_32S(-1e30).raw()) == Q31_32S::min());
+    check("infinities wrap to zero", Q31_32(std::numeric_limits<double>::infinity()).raw() == 0);
+    check("NaN converts to zero",
+          Q31_32T(std::nan("")).raw() == 0 && DQ7_8(std::nanf("")).raw() == 0);
+    check("integral doubles beyond 2^52 convert exactly",
+          FixedPoint<64, 0>(4503599627370497.0).raw() == 4503599627370497);
+
+    bool same = true;
+    for (double x = -128.0; x < 128.0; x += 0.37) {
+        same = same && Q7_8U(x).raw() == Q7_8(x).raw() && Q7_8T(x).raw() == Q7_8(x).raw();
+    }
+    check("Undefined and Trap match Wrap in range", same);
+}
+
+// Batch calls on a Dynamic format match the scalar operators of the static
+// format with the same policy, SIMD kernels included
+template<OverflowPolicy P>
+bool batch_matches(const std::vector<DQ15_16>& a, const std::vector<DQ15_16>& b) {
+    using FP = FixedPoint<32, 16, true, P>;
+    const size_t n = a.size();
+    std::vector<DQ15_16> sum(n), diff(n), prod(n), fma(n), scaled(n);
+    batch::add(a, b, std::span(sum));
+    batch::sub(a, b, std::span(diff));
+    batch::mul(a, b, std::span(prod));
+    batch::mul_add(a, b, a, std::span(fma));
+    batch::scale(a, b[3], std::span(scaled));
+    bool same = true;
+    for (size_t i = 0; i < n; ++i) {
+        const FP x = FP::from_raw(a[i].raw()), y = FP::from_raw(b[i].raw());
+        same = same && sum[i].raw() == (x + y).raw() && diff[i].raw() == (x - y).raw() &&
+               prod[i].raw() == (x * y).raw() && fma[i].raw() == (x * y + x).raw() &&
+               scaled[i].raw() == (x * FP::from_raw(b[3].raw())).raw();
+    }
+    return same;
+}
+
+void test_batch() {
+    std::cout << "Batch arithmetic:\n";
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dist(-32000.0, 32000.0);
+    std::vector<DQ15_16> a(1027), b(1027);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = DQ15_16::from_raw(Q15_16(dist(gen)).raw());
+        b[i] = DQ15_16::from_raw(Q15_16(dist(gen) / 1000.0).raw());
+    }
+
+    set_dynamic_overflow_policy(OverflowPolicy::Saturate);
+    check("Saturate", batch_matches<OverflowPolicy::Saturate>(a, b));
+    set_dynamic_overflow_policy(OverflowPolicy::Wrap);
+    check("Wrap", batch_matches<OverflowPolicy::Wrap>(a, b));
+    set_dynamic_overflow_policy(OverflowPolicy::Trap);
+    bool same = false;
+    const int count = traps([&] { same = batch_matches<OverflowPolicy::Trap>(a, b); });
+    check("Trap", same && count > 0);
+    set_dynamic_overflow_policy(OverflowPolicy::Saturate);
+}
+
+int main() {
+    std::cout << "Testing Run-Time Overflow Policies\n";
+    std::cout << "==================================\n\n";
+
+    // The process policy is read from the environment on first use
+    setenv("LIBFIXP_OVERFLOW", "wrap", 1);
+    std::cout << "Environment:\n";
+    check("LIBFIXP_OVERFLOW selects the initial policy",
+          dynamic_overflow_policy() == OverflowPolicy::Wrap);
+
+    set_overflow_handler(count_overflow);
+
+    test_dynamic_policy();
+    test_trap();
+    test_division();
+    test_undefined();
+    test_conversions();
+    test_batch();
+
+    set_overflow_handler(nullptr);
+
+    std::cout << "\n" << (failures == 0 ? "All overflow policy tests passed!"
+                                        : "Overflow policy tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
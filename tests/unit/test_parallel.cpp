@@ -0,0 +1,243 @@
+#include <fixp/parallel.hpp>
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::dsp;
+
+using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+
+template<typename FP>
+std::vector<FP> random_samples(std::mt19937& gen, size_t n, double amplitude) {
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::vector<FP> x(n);
+    for (auto& v : x) v = FP(dist(gen));
+    return x;
+}
+
+template<typename A, typename B>
+bool same(const A& a, const B& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].raw() != b[i].raw()) return false;
+    }
+    return true;
+}
+
+template<typename A, typename B>
+bool same_complex(const A& a, const B& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].real.raw() != b[i].real.raw() || a[i].imag.raw() != b[i].imag.raw()) return false;
+    }
+    return true;
+}
+
+// Every item exactly once, worker indices in range and never two chunks at
+// once on one worker
+template<parallel::Executor E>
+bool covers(E& exec, size_t count, size_t grain) {
+    std::vector<std::atomic<int>> hits(count);
+    std::vector<std::atomic<int>> busy(exec.workers());
+    std::atomic<bool> ok{true};
+    exec.bulk(count, grain, [&](size_t b, size_t e, size_t w) {
+        if (w >= exec.workers() || e <= b || e - b > grain || busy[w].fetch_add(1) != 0) {
+            ok = false;
+            return;
+        }
+        for (size_t i = b; i < e; ++i) hits[i].fetch_add(1);
+        busy[w].fetch_sub(1);
+    });
+    for (auto& h : hits) ok = ok && h.load() == 1;
+    return ok;
+}
+
+void test_executors() {
+    std::cout << "Executors:\n";
+    parallel::ThreadPool pool(4);
+    check("ThreadPool(4) has four workers", pool.workers() == 4);
+    bool all = true;
+    for (size_t count : {0u, 1u, 7u, 100u, 4096u}) {
+        for (size_t grain : {1u, 3u, 64u}) all = all && covers(pool, count, grain);
+    }
+    check("bulk covers every item once", all);
+    bool repeated = true;
+    for (int i = 0; i < 200; ++i) repeated = repeated && covers(pool, 257, 2);
+    check("back-to-back jobs", repeated);
+
+    parallel::SerialExecutor serial;
+    check("SerialExecutor", covers(serial, 1000, 7));
+    parallel::ThreadPool single(1);
+    check("a one-worker pool runs on the caller", covers(single, 1000, 7));
+#if defined(__cpp_lib_execution)
+    parallel::PolicyExecutor seq(std::execution::seq, 3);
+    check("PolicyExecutor", seq.workers() == 3 && covers(seq, 1000, 7));
+#endif
+
+    // A bulk inside a chunk runs on the worker that called it
+    std::atomic<int> inner{0};
+    std::atomic<bool> same_worker{true};
+    pool.bulk(16, 1, [&](size_t, size_t, size_t w) {
+        pool.bulk(10, 3, [&](size_t b, size_t e, size_t w2) {
+            inner += static_cast<int>(e - b);
+            if (w2 != w) same_worker = false;
+        });
+    });
+    check("nested bulk", inner == 160 && same_worker);
+
+    bool thrown = false;
+    try {
+        pool.bulk(1000, 1, [](size_t b, size_t, size_t) {
+            if (b == 500) throw std::runtime_error("chunk 500");
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check("a chunk's exception reaches the caller", thrown && covers(pool, 100, 1));
+}
+
+void test_chunking() {
+    std::cout << "Chunking and scratch:\n";
+    // Small items: whole cache lines and at least 16 KiB
+    const size_t small = parallel::chunk_size(1 << 20, 4, 8);
+    check("four chunks per worker", parallel::chunk_size(1 << 20, 4, 8) == (1 << 20) / 32);
+    check("whole cache lines", small % 16 == 0 && parallel::chunk_size(100000, 4, 64) % 16 == 0);
+    check("at least 16 KiB", parallel::chunk_size(1000, 4, 8) * 4 >= 16 * 1024);
+    check("large items one at a time", parallel::chunk_size(256, 1 << 20, 8) == 8 &&
+                                       parallel::chunk_size(4, 1 << 20, 8) == 1);
+
+    parallel::Scratch<Complex<Q15_16>> scratch(3, 10);
+    bool aligned = true;
+    for (size_t w = 0; w < 3; ++w) {
+        aligned = aligned && reinterpret_cast<uintptr_t>(scratch[w].data()) % 64 == 0 &&
+                  scratch[w].size() == 10;
+    }
+    check("per-worker buffers on their own cache lines", aligned);
+    scratch.resize(2, 4);
+    check("resize never shrinks", scratch.workers() == 3 && scratch.size() == 10);
+}
+
+void test_transforms() {
+    std::cout << "Batched transforms:\n";
+    constexpr size_t N = 256, Frames = 37;
+    parallel::ThreadPool pool(4);
+    std::mt19937 gen(5);
+    const auto real = random_samples<Q15_16>(gen, N * Frames, 10.0);
+    const auto imag = random_samples<Q15_16>(gen, N * Frames, 10.0);
+    std::vector<Complex<Q15_16>> data(N * Frames);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = Complex<Q15_16>(real[i], imag[i]);
+
+    static const FftPlan<Q15_16, N> plan;
+    auto expected = data;
+    for (size_t f = 0; f < Frames; ++f) plan.forward(std::span(expected).subspan(f * N).first<N>());
+    auto got = data;
+    parallel::fft(pool, plan, std::span(got));
+    check("FftPlan forward", same_complex(got, expected));
+    for (size_t f = 0; f < Frames; ++f) plan.inverse(std::span(expected).subspan(f * N).first<N>());
+    parallel::ifft(pool, plan, std::span(got));
+    check("FftPlan inverse", same_complex(got, expected));
+
+    static const Radix4FftPlan<Q15_16, N> radix4;
+    expected = data;
+    std::vector<int> exponents(Frames), got_exponents(Frames);
+    for (size_t f = 0; f < Frames; ++f) {
+        exponents[f] = radix4.forward(std::span(expected).subspan(f * N).first<N>());
+    }
+    got = data;
+    parallel::fft(pool, radix4, std::span(got), std::span(got_exponents));
+    check("Radix4FftPlan with block exponents",
+          same_complex(got, expected) && got_exponents == exponents);
+
+    static const RealFftPlan<Q15_16, N> rplan;
+    constexpr size_t Bins = N / 2 + 1;
+    std::vector<Complex<Q15_16>> spectra(Bins * Frames), reference(Bins * Frames);
+    for (size_t f = 0; f < Frames; ++f) {
+        rplan.forward(std::span(real).subspan(f * N).first<N>(),
+                      std::span(reference).subspan(f * Bins).first<Bins>());
+    }
+    parallel::rfft(pool, rplan, real, std::span(spectra));
+    check("RealFftPlan", same_complex(spectra, reference));
+}
+
+void test_filter_bank() {
+    std::cout << "Filter banks:\n";
+    constexpr size_t Channels = 67, Frames = 256;
+    parallel::ThreadPool pool(4);
+    std::mt19937 gen(9);
+
+    std::array<Q15_16S, 7> taps;
+    for (auto& t : taps) t = Q15_16S(std::uniform_real_distribution<double>(-0.5, 0.5)(gen));
+    using Fir = FirFilter<Q15_16S, 7>;
+    parallel::FilterBank<Fir> planar(Channels, Fir(taps)), interleaved(Channels, Fir(taps));
+    std::vector<Fir> reference(Channels, Fir(taps));
+
+    bool planar_ok = true, interleaved_ok = true;
+    for (int block = 0; block < 3; ++block) {
+        const auto x = random_samples<Q15_16S>(gen, Channels * Frames, 4.0);
+        // Planar reference: channel c at [c * Frames, (c + 1) * Frames)
+        std::vector<Q15_16S> expected(x.size());
+        for (size_t c = 0; c < Channels; ++c) {
+            reference[c].process(std::span(x).subspan(c * Frames, Frames),
+                                 std::span(expected).subspan(c * Frames, Frames));
+        }
+        auto y = x;
+        planar.process(pool, y, std::span(y));
+        planar_ok = planar_ok && same(y, expected);
+
+        // The same samples interleaved
+        std::vector<Q15_16S> xi(x.size()), yi(x.size());
+        for (size_t c = 0; c < Channels; ++c) {
+            for (size_t n = 0; n < Frames; ++n) xi[n * Channels + c] = x[c * Frames + n];
+        }
+        interleaved.process_interleaved(pool, xi, std::span(yi));
+        bool match = true;
+        for (size_t c = 0; c < Channels; ++c) {
+            for (size_t n = 0; n < Frames; ++n) {
+                match = match && yi[n * Channels + c].raw() == expected[c * Frames + n].raw();
+            }
+        }
+        interleaved_ok = interleaved_ok && match;
+    }
+    check("planar FIR bank, state carried across blocks", planar_ok);
+    check("interleaved FIR bank", interleaved_ok);
+
+    // Biquads on the serial executor match the pool
+    using Biquad = BiquadCascade<Q15_16S, 2, 1>;
+    parallel::FilterBank<Biquad> pooled(Channels), serial(Channels);
+    for (size_t c = 0; c < Channels; ++c) {
+        const BiquadCoefficients<Q15_16S> k{Q15_16S(0.2), Q15_16S(0.3), Q15_16S(0.2),
+                                            Q15_16S(-0.02 * static_cast<double>(c % 10)),
+                                            Q15_16S(0.1)};
+        for (auto* bank : {&pooled, &serial}) {
+            bank->channel(c).set_section(0, k);
+            bank->channel(c).set_section(1, k);
+        }
+    }
+    const auto x = random_samples<Q15_16S>(gen, Channels * Frames, 4.0);
+    std::vector<Q15_16S> a(x.size()), b(x.size());
+    parallel::SerialExecutor one;
+    pooled.process(pool, x, std::span(a));
+    serial.process(one, x, std::span(b));
+    check("biquad bank", same(a, b));
+    pooled.reset();
+    pooled.process(pool, x, std::span(b));
+    check("reset", same(a, b));
+}
+
+int main() {
+    std::cout << "Testing Parallel Execution\n";
+    std::cout << "==========================\n\n";
+
+    test_executors();
+    test_chunking();
+    test_transforms();
+    test_filter_bank();
+
+    std::cout << "\n" << (failures == 0 ? "All parallel tests passed!" : "Parallel tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
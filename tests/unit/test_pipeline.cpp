@@ -0,0 +1,178 @@
+#include <fixp/pipeline.hpp>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::dsp;
+
+// Every heap allocation in the program, so run() can be shown to make none
+static size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using Q15_16S = FixedPoint<32, 16, true, OverflowPolicy::Saturate>;
+
+template<typename FP, size_t N>
+std::array<FP, N> random_block(std::mt19937& gen, double amplitude) {
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::array<FP, N> x;
+    for (auto& v : x) v = FP(dist(gen));
+    return x;
+}
+
+template<typename A, typename B>
+bool same(const A& a, const B& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].raw() != b[i].raw()) return false;
+    }
+    return true;
+}
+
+void test_spectrum() {
+    std::cout << "Window, gain, real FFT and magnitude:\n";
+    constexpr size_t N = 256;
+    using Analyzer = Pipeline<N, WindowStage<Window::Hann, Q15_16, N>, GainStage<Q15_16>,
+                              RealFftStage<Q15_16, N>, MagnitudeStage<Q15_16>>;
+    static_assert(Analyzer::output_size == N / 2 + 1);
+    // Window and gain fuse; the FFT cannot run in place, so two arenas
+    static_assert(Analyzer::pass_count == 3);
+    static_assert(Analyzer::arena_bytes == N * sizeof(Q15_16) + (N / 2 + 1) * 2 * sizeof(Q15_16));
+
+    Analyzer analyzer(WindowStage<Window::Hann, Q15_16, N>{}, GainStage<Q15_16>(Q15_16(0.5)),
+                      RealFftStage<Q15_16, N>{}, MagnitudeStage<Q15_16>{});
+    std::mt19937 gen(1);
+    bool matches = true;
+    for (int block = 0; block < 4; ++block) {
+        const auto x = random_block<Q15_16, N>(gen, 20.0);
+
+        const auto& window = window_table<Window::Hann, Q15_16, N>;
+        std::array<Q15_16, N> windowed;
+        for (size_t i = 0; i < N; ++i) windowed[i] = x[i] * window[i] * Q15_16(0.5);
+        const auto spectrum = rfft(windowed);
+        std::array<Q15_16, N / 2 + 1> expected;
+        magnitude(std::span<const Complex<Q15_16>>(spectrum), std::span<Q15_16>(expected));
+
+        std::array<Q15_16, N / 2 + 1> got;
+        analyzer.run(x, got);
+        matches = matches && same(got, expected);
+    }
+    check("matches the stages run one by one", matches);
+}
+
+void test_filters() {
+    std::cout << "FIR, biquad and element-wise stages in place:\n";
+    constexpr size_t N = 64;
+    const std::array<Q15_16S, 5> taps{Q15_16S(0.1), Q15_16S(0.2), Q15_16S(0.4), Q15_16S(0.2),
+                                      Q15_16S(0.1)};
+    const BiquadCoefficients<Q15_16S> lowpass{Q15_16S(0.2), Q15_16S(0.4), Q15_16S(0.2),
+                                              Q15_16S(-0.3), Q15_16S(0.1)};
+    const auto clip = [](Q15_16S x) { return std::clamp(x, Q15_16S(-4.0), Q15_16S(4.0)); };
+
+    using Chain = Pipeline<N, FirStage<Q15_16S, 5>, BiquadStage<Q15_16S, 1>, GainStage<Q15_16S>,
+                           MapStage<Q15_16S, decltype(clip)>>;
+    // The biquad runs in place on the FIR's output; gain and clip fuse
+    static_assert(Chain::pass_count == 3);
+    static_assert(Chain::arena_bytes == N * sizeof(Q15_16S));
+
+    Chain chain(FirStage<Q15_16S, 5>(taps), BiquadStage<Q15_16S, 1>{},
+                GainStage<Q15_16S>(Q15_16S(3.0)), MapStage<Q15_16S, decltype(clip)>(clip));
+    chain.stage<1>().set_section(0, lowpass);
+
+    FirFilter<Q15_16S, 5> fir(taps);
+    BiquadCascade<Q15_16S, 1, 1> biquad;
+    biquad.set_section(0, lowpass);
+
+    std::mt19937 gen(2);
+    bool matches = true;
+    std::vector<std::array<Q15_16S, N>> blocks;
+    for (int block = 0; block < 6; ++block) {
+        auto x = random_block<Q15_16S, N>(gen, 3.0);
+        blocks.push_back(x);
+        std::array<Q15_16S, N> expected;
+        fir.process(x, expected);
+        biquad.process(expected, expected);
+        for (auto& v : expected) v = clip(v * Q15_16S(3.0));
+
+        chain.run_in_place(x);
+        matches = matches && same(x, expected);
+    }
+    check("state carries across blocks", matches);
+
+    // After a reset the chain repeats its first block
+    chain.reset();
+    auto first = blocks[0];
+    chain.run_in_place(first);
+    Chain fresh(FirStage<Q15_16S, 5>(taps), BiquadStage<Q15_16S, 1>{},
+                GainStage<Q15_16S>(Q15_16S(3.0)), MapStage<Q15_16S, decltype(clip)>(clip));
+    fresh.stage<1>().set_section(0, lowpass);
+    auto again = blocks[0];
+    fresh.run_in_place(again);
+    check("reset clears the filter state", same(first, again));
+
+    const size_t before = allocations;
+    for (auto& b : blocks) chain.run_in_place(b);
+    check("run makes no allocations", allocations == before);
+}
+
+void test_complex() {
+    std::cout << "Complex FFT between element-wise stages:\n";
+    constexpr size_t N = 128;
+    const auto to_complex = [](Q15_16 x) { return Complex<Q15_16>(x); };
+    using Chain = Pipeline<N, MapStage<Q15_16, decltype(to_complex)>, FftStage<Q15_16, N>,
+                           MagnitudeStage<Q15_16>>;
+    // The map writes an arena and the FFT transforms it there
+    static_assert(Chain::pass_count == 3);
+    static_assert(Chain::arena_bytes == N * sizeof(Complex<Q15_16>));
+
+    Chain chain(MapStage<Q15_16, decltype(to_complex)>(to_complex), FftStage<Q15_16, N>{},
+                MagnitudeStage<Q15_16>{});
+    std::mt19937 gen(3);
+    const auto x = random_block<Q15_16, N>(gen, 10.0);
+
+    static const FftPlan<Q15_16, N> plan;
+    std::array<Complex<Q15_16>, N> spectrum;
+    for (size_t i = 0; i < N; ++i) spectrum[i] = Complex<Q15_16>(x[i]);
+    plan.forward(spectrum);
+    std::array<Q15_16, N> expected;
+    for (size_t i = 0; i < N; ++i) expected[i] = spectrum[i].magnitude();
+
+    std::array<Q15_16, N> got;
+    chain.run(x, got);
+    check("matches FftPlan and magnitude()", same(got, expected));
+
+    // A single fused pass needs no arena at all
+    using Gains = Pipeline<N, GainStage<Q15_16>, GainStage<Q15_16>>;
+    static_assert(Gains::pass_count == 1 && Gains::arena_bytes == 0);
+    Gains gains(GainStage<Q15_16>(Q15_16(2.0)), GainStage<Q15_16>(Q15_16(0.25)));
+    auto y = x;
+    gains.run_in_place(y);
+    bool halved = true;
+    for (size_t i = 0; i < N; ++i) halved = halved && y[i] == x[i] * Q15_16(2.0) * Q15_16(0.25);
+    check("fused gains", halved);
+}
+
+int main() {
+    std::cout << "Testing DSP Pipelines\n";
+    std::cout << "=====================\n\n";
+
+    test_spectrum();
+    test_filters();
+    test_complex();
+
+    std::cout << "\n" << (failures == 0 ? "All pipeline tests passed!" : "Pipeline tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -17,6 +17,15 @@ int main(void) {
     q16_16_t prod = q16_16_mul(a, b);
     assert(fabs(q16_16_to_double(prod) - 2.0) < 0.0001);
 
+    // Saturating helpers clamp toward the sign of the overflow
+    q16_16_t big = q16_16_from_double(30000.0);
+    assert(Q16_16_RAW(q16_16_add_sat(big, big)) == Q16_16_RAW(Q16_16_MAX));
+    assert(Q16_16_RAW(q16_16_sub_sat(q16_16_neg_sat(big), big)) == Q16_16_RAW(Q16_16_MIN));
+    assert(Q16_16_RAW(q16_16_sub_sat(big, q16_16_neg_sat(big))) == Q16_16_RAW(Q16_16_MAX));
+    assert(Q16_16_RAW(q16_16_mul_sat(big, q16_16_neg_sat(big))) == Q16_16_RAW(Q16_16_MIN));
+    assert(Q16_16_RAW(q16_16_add_sat(big, b)) == Q16_16_RAW(big) + 0x20000);
+    assert(Q16_16_RAW(q16_16_neg_sat(Q16_16_MIN)) == Q16_16_RAW(Q16_16_MAX));
+
     printf("Q16.16 C Tests Passed\n");
     return 0;
 }
@@ -0,0 +1,137 @@
+#include <fixp/fixed_point.hpp>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+template<int T, int F, bool S = true>
+using Sat = FixedPoint<T, F, S, OverflowPolicy::Saturate>;
+
+static_assert(Sat<32, 16>(30000.0) + Sat<32, 16>(30000.0) == Sat<32, 16>::max());
+static_assert(Sat<16, 8>(-100.0) - Sat<16, 8>(100.0) == Sat<16, 8>::min());
+static_assert(-Sat<32, 16>::min() == Sat<32, 16>::max());
+static_assert(add(Q15_16(30000.0), Q15_16(30000.0), saturating) == Q15_16::max());
+static_assert(add(Sat<32, 16>(30000.0), Sat<32, 16>(30000.0), wrapping).raw() < 0);
+static_assert(mul(Q15_16(300.0), Q15_16(300.0), saturating) == Q15_16::max());
+static_assert(neg(Q15_16::min(), saturating) == Q15_16::max());
+
+// Exact results in 128 bits, then clamped or wrapped into FP
+template<typename FP>
+struct Reference {
+    using raw_type = typename FP::raw_type;
+    static constexpr auto lo = static_cast<__int128_t>(FP::min().raw());
+    static constexpr auto hi = static_cast<__int128_t>(FP::max().raw());
+
+    static FP fit(__int128_t v, bool saturate) {
+        if (saturate) return FP::from_raw(static_cast<raw_type>(std::clamp(v, lo, hi)));
+        return FP::from_raw(static_cast<raw_type>(v));
+    }
+
+    static FP add(FP a, FP b, bool s) { return fit(__int128_t(a.raw()) + b.raw(), s); }
+    static FP sub(FP a, FP b, bool s) { return fit(__int128_t(a.raw()) - b.raw(), s); }
+    static FP neg(FP a, bool s) { return fit(-__int128_t(a.raw()), s); }
+    static FP mul(FP a, FP b, bool s) {
+        const __int128_t p = __int128_t(a.raw()) * b.raw();
+        return fit((p + (__int128_t(1) << FP::fractional_bits >> 1)) >> FP::fractional_bits, s);
+    }
+};
+
+// Extremes and their neighbours, then random raw values of every bit width
+template<typename FP>
+std::vector<FP> samples(int count) {
+    using raw_type = typename FP::raw_type;
+    const auto lo = FP::min().raw(), hi = FP::max().raw();
+    std::vector<FP> out{FP::min(), FP::max(), FP::from_raw(0), FP::from_raw(1),
+                        FP::from_raw(static_cast<raw_type>(lo + 1)),
+                        FP::from_raw(static_cast<raw_type>(hi - 1)),
+                        FP::from_raw(static_cast<raw_type>(hi / 2)),
+                        FP::from_raw(static_cast<raw_type>(hi / 2 + 1))};
+    if constexpr (FP::is_signed) out.push_back(FP::from_raw(-1));
+    std::mt19937_64 gen(11);
+    const int bits = FP::total_bits - (FP::is_signed ? 1 : 0);
+    for (int i = 0; i < count; ++i) {
+        const int w = static_cast<int>(gen() % static_cast<uint64_t>(bits)) + 1;
+        const uint64_t raw = w == 64 ? gen() : gen() & ((uint64_t(1) << w) - 1);
+        auto r = static_cast<raw_type>(raw);
+        if (FP::is_signed && gen() % 2 == 0) r = static_cast<raw_type>(-r);
+        out.push_back(FP::from_raw(r));
+    }
+    return out;
+}
+
+template<typename FP>
+void test_pairs(const std::vector<FP>& xs) {
+    using W = FixedPoint<FP::total_bits, FP::fractional_bits, FP::is_signed,
+                         OverflowPolicy::Wrap>;
+    using S = FixedPoint<FP::total_bits, FP::fractional_bits, FP::is_signed,
+                         OverflowPolicy::Saturate>;
+    using RW = Reference<W>;
+    using RS = Reference<S>;
+    bool wrap = true, sat = true, tags = true;
+    for (const FP x : xs) {
+        const W wa = W::from_raw(x.raw());
+        const S sa = S::from_raw(x.raw());
+        if constexpr (FP::is_signed) {
+            wrap = wrap && -wa == RW::neg(wa, false);
+            sat = sat && -sa == RS::neg(sa, true);
+        }
+        for (const FP y : xs) {
+            const W wb = W::from_raw(y.raw());
+            const S sb = S::from_raw(y.raw());
+            wrap = wrap && wa + wb == RW::add(wa, wb, false) && wa - wb == RW::sub(wa, wb, false) &&
+                   wa * wb == RW::mul(wa, wb, false);
+            sat = sat && sa + sb == RS::add(sa, sb, true) && sa - sb == RS::sub(sa, sb, true) &&
+                  sa * sb == RS::mul(sa, sb, true);
+            tags = tags && add(wa, wb, saturating).raw() == (sa + sb).raw() &&
+                   sub(wa, wb, saturating).raw() == (sa - sb).raw() &&
+                   mul(wa, wb, saturating).raw() == (sa * sb).raw() &&
+                   add(sa, sb, wrapping).raw() == (wa + wb).raw() &&
+                   mul(sa, sb, wrapping).raw() == (wa * wb).raw();
+        }
+    }
+    check("Wrap matches modular arithmetic", wrap);
+    check("Saturate matches clamped arithmetic", sat);
+    check("policy tags override the format's policy", tags);
+}
+
+// Every pair of raw values
+template<typename FP>
+void test_exhaustive(const char* name) {
+    std::cout << name << " (exhaustive):\n";
+    std::vector<FP> all;
+    for (auto r = static_cast<int>(FP::min().raw()); r <= static_cast<int>(FP::max().raw()); ++r) {
+        all.push_back(FP::from_raw(static_cast<typename FP::raw_type>(r)));
+    }
+    test_pairs(all);
+}
+
+template<typename FP>
+void test_random(const char* name) {
+    std::cout << name << ":\n";
+    test_pairs(samples<FP>(1000));
+}
+
+int main() {
+    std::cout << "Testing Branch-Free Saturation\n";
+    std::cout << "==============================\n\n";
+
+    test_exhaustive<FixedPoint<8, 7>>("Q0.7");
+    test_exhaustive<FixedPoint<8, 4>>("Q3.4");
+    test_exhaustive<FixedPoint<8, 4, false>>("UQ4.4");
+    test_random<FixedPoint<16, 8>>("Q7.8");
+    test_random<FixedPoint<16, 15>>("Q0.15");
+    test_random<FixedPoint<16, 8, false>>("UQ8.8");
+    test_random<FixedPoint<32, 16>>("Q15.16");
+    test_random<FixedPoint<32, 30>>("Q1.30");
+    test_random<FixedPoint<32, 16, false>>("UQ16.16");
+    test_random<FixedPoint<24, 8>>("Q15.8 (24-bit)");
+    test_random<FixedPoint<64, 32>>("Q31.32");
+    test_random<FixedPoint<64, 60>>("Q3.60");
+
+    std::cout << "\n" << (failures == 0 ? "All saturation tests passed!" : "Saturation tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+#include <fixp/math.hpp>
+#include <fixp/dsp.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+using Q7_8 = FixedPoint<16, 8>;
+using Q0_15 = FixedPoint<16, 15>;
+using Q1_30 = FixedPoint<32, 30>;
+using Q0_31 = FixedPoint<32, 31>;
+using UQ16_16 = FixedPoint<32, 16, false>;
+using Q31_32 = FixedPoint<64, 32>;
+using Q15_48 = FixedPoint<64, 48>;
+using Q7_56 = FixedPoint<64, 56>;
+using Q3_60 = FixedPoint<64, 60>;
+using UQ32_32 = FixedPoint<64, 32, false>;
+
+static_assert(sqrt(Q15_16(4.0)) == Q15_16(2.0));
+static_assert(sqrt_digits(Q15_16(4.0)) == Q15_16(2.0));
+static_assert(rsqrt(Q15_16(4.0)) == Q15_16(0.5));
+static_assert(hypot(Q15_16(3.0), Q15_16(4.0)) == Q15_16(5.0));
+static_assert(fixp::detail::isqrt_newton<3>(~__uint128_t(0)) == __uint128_t(1) << 64);
+
+// Random raw values with a uniformly distributed bit width, so small inputs
+// get as much coverage as large ones
+template<typename FP>
+std::vector<FP> samples(int count) {
+    using raw_type = typename FP::raw_type;
+    std::mt19937_64 gen(5);
+    std::vector<FP> out{FP::from_raw(1), FP::max(), FP::from_raw(0), FP::min()};
+    const int magnitude_bits = FP::total_bits - (FP::is_signed ? 1 : 0);
+    for (int i = 0; i < count; ++i) {
+        const int bits = static_cast<int>(gen() % static_cast<uint64_t>(magnitude_bits)) + 1;
+        const uint64_t raw = bits == 64 ? gen() : gen() & ((uint64_t(1) << bits) - 1);
+        auto r = static_cast<raw_type>(raw);
+        if (FP::is_signed && gen() % 2 == 0) r = static_cast<raw_type>(-r);
+        out.push_back(FP::from_raw(r));
+    }
+    return out;
+}
+
+template<typename FP>
+void test_format(const char* name) {
+    std::cout << name << ":\n";
+    const auto xs = samples<FP>(20000);
+    const long double lsb = std::ldexp(1.0L, -FP::fractional_bits);
+    bool same = true;
+    long double sqrt_err = 0, rsqrt_err = 0, hypot_err = 0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        const FP x = xs[i];
+        const FP y = xs[(i * 7919) % xs.size()];
+        const long double v = value(x);
+        same = same && sqrt(x) == sqrt_digits(x);
+        if (v > 0) {
+            sqrt_err = std::max(sqrt_err,
+                                std::abs(value(sqrt(x)) - clamp_to<FP>(std::sqrt(v))) / lsb);
+            rsqrt_err = std::max(rsqrt_err,
+                                 std::abs(value(rsqrt(x)) - clamp_to<FP>(1 / std::sqrt(v))) / lsb);
+        }
+        // Unsigned 64-bit formats have no double-width sum, so no hypot
+        if constexpr (requires { hypot(x, y); }) {
+            const long double h = clamp_to<FP>(std::hypot(v, value(y)));
+            hypot_err = std::max(hypot_err, std::abs(value(hypot(x, y)) - h) / lsb);
+        }
+    }
+    std::cout << "  max LSB error: sqrt " << static_cast<double>(sqrt_err) << ", rsqrt "
+              << static_cast<double>(rsqrt_err) << ", hypot " << static_cast<double>(hypot_err)
+              << "\n";
+    check("sqrt matches sqrt_digits", same);
+    // long double carries 64 bits, so 64-bit results get a little slack
+    const long double rounded = FP::total_bits < 64 ? 0.5L : 0.51L;
+    check("sqrt rounded to nearest", sqrt_err <= rounded);
+    check("rsqrt within bound", rsqrt_err <= rounded + 0.5L);
+    check("hypot rounded to nearest", hypot_err <= rounded);
+}
+
+// x t^2 against 1 exactly: raw X and result R in Q(F) must satisfy
+// (R - 1)^2 X <= 2^3F <= (R + 1)^2 X, products in 256 bits
+template<typename FP>
+bool rsqrt_within_one_lsb(FP x) {
+    namespace core = libfixp::detail;
+    static_assert(FP::is_signed && 3 * FP::fractional_bits >= 128);
+    const auto X = static_cast<__uint128_t>(x.raw());
+    const auto R = static_cast<__uint128_t>(rsqrt(x).raw());
+    const core::WideWord<__uint128_t> one{__uint128_t(1) << (3 * FP::fractional_bits - 128), 0};
+    const auto above = core::mul_wide((R + 1) * (R + 1), X);
+    const auto below = core::mul_wide((R - 1) * (R - 1), X);
+    const auto less = [](auto a, auto b) { return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo); };
+    // Saturated results only need the true value at or above R - 1
+    const bool saturated = R == static_cast<__uint128_t>(FP::max().raw());
+    return !less(one, below) && (saturated || !less(above, one));
+}
+
+// Small inputs give results near max(), past the 2^-59 the Q63 kernel carries
+template<typename FP>
+void test_rsqrt_small(const char* name) {
+    std::mt19937_64 gen(13);
+    bool ok = true;
+    for (int bits = 1; bits < FP::total_bits; ++bits) {
+        for (int i = 0; i < 2000; ++i) {
+            const uint64_t top = uint64_t(1) << (bits - 1);
+            const auto raw = static_cast<int64_t>(top | (gen() & (top - 1)));
+            ok = ok && rsqrt_within_one_lsb(FP::from_raw(raw));
+        }
+    }
+    check(name, ok);
+}
+
+// The integer kernels against each other over the full operand width
+void test_kernels() {
+    std::cout << "Integer square root kernels:\n";
+    std::mt19937_64 gen(9);
+    bool narrow = true, wide = true;
+    for (int i = 0; i < 100000; ++i) {
+        const int bits = static_cast<int>(gen() % 64) + 1;
+        const uint64_t v = bits == 64 ? gen() : gen() & ((uint64_t(1) << bits) - 1);
+        narrow = narrow && fixp::detail::isqrt_newton<3>(v) == fixp::detail::isqrt_digits(v);
+        const __uint128_t w = (static_cast<__uint128_t>(gen()) << 64 | gen()) >> (gen() % 128);
+        wide = wide && fixp::detail::isqrt_newton<3>(w) == fixp::detail::isqrt_digits(w);
+    }
+    check("64-bit operands", narrow);
+    check("128-bit operands", wide);
+    bool squares = true;
+    for (uint64_t r = (uint64_t(1) << 32) - 1000; r < (uint64_t(1) << 32); ++r) {
+        const __uint128_t sq = static_cast<__uint128_t>(r) * r;
+        squares = squares && fixp::detail::isqrt_newton<3>(sq) == r &&
+                  fixp::detail::isqrt_newton<3>(sq + r) == r &&
+                  fixp::detail::isqrt_newton<3>(sq + r + 1) == r + 1;
+    }
+    check("exact squares and rounding boundaries", squares);
+}
+
+void test_special_values() {
+    std::cout << "Special values:\n";
+    check("sqrt of non-positive values is 0",
+          sqrt(Q15_16(-4.0)) == Q15_16(0.0) && sqrt(Q15_16(0.0)) == Q15_16(0.0));
+    check("rsqrt of non-positive values is max()", rsqrt(Q15_16(0.0)) == Q15_16::max());
+    check("rsqrt saturates for tiny inputs", rsqrt(Q1_30::from_raw(1)) == Q1_30::max() &&
+                                                     rsqrt(Q15_16::from_raw(1)) == Q15_16(256.0));
+    check("sqrt saturates below 1 in Q0.31", sqrt(Q0_31::max()) == Q0_31::max());
+    check("hypot of the most negative values saturates",
+          hypot(Q15_16::min(), Q15_16::min()) == Q15_16::max());
+    check("hypot does not overflow in Q31.32",
+          std::abs(value(hypot(Q31_32(1.5e9), Q31_32(-1e9))) - std::hypot(1.5e9L, 1e9L)) <
+              std::ldexp(1.0L, -32));
+    check("hypot(3, 4) is 5 in Q3.60", hypot(Q3_60(3.0), Q3_60(4.0)) == Q3_60(5.0));
+
+    using C = dsp::Complex<Q15_16>;
+    const std::vector<C> spectrum{C(Q15_16(3.0), Q15_16(-4.0)), C(Q15_16(-200.0), Q15_16(200.0)),
+                                  C(Q15_16(30000.0), Q15_16(30000.0))};
+    std::vector<Q15_16> mags(spectrum.size());
+    dsp::magnitude(std::span<const C>(spectrum), std::span<Q15_16>(mags));
+    check("Complex magnitude", mags[0] == Q15_16(5.0) &&
+                               mags[1] == Q15_16(std::hypot(200.0, 200.0)) &&
+                               mags[2] == Q15_16::max());
+}
+
+int main() {
+    std::cout << "Testing Square Root, Reciprocal Square Root and Hypot\n";
+    std::cout << "=====================================================\n\n";
+
+    test_kernels();
+
+    test_format<Q7_8>("Q7.8");
+    test_format<Q0_15>("Q0.15");
+    test_format<Q15_16>("Q15.16");
+    test_format<UQ16_16>("UQ16.16");
+    test_format<Q1_30>("Q1.30");
+    test_format<Q0_31>("Q0.31");
+    test_format<Q31_32>("Q31.32");
+    test_format<Q3_60>("Q3.60");
+    test_format<UQ32_32>("UQ32.32");
+
+    std::cout << "rsqrt of small inputs, exact check:\n";
+    test_rsqrt_small<Q15_48>("Q15.48 within one LSB");
+    test_rsqrt_small<Q7_56>("Q7.56 within one LSB");
+    test_rsqrt_small<Q3_60>("Q3.60 within one LSB");
+
+    test_special_values();
+
+    std::cout << "\n" << (failures == 0 ? "All sqrt tests passed!" : "Sqrt tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+#ifndef FIXP_TEST_SUPPORT_HPP
+#define FIXP_TEST_SUPPORT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Each unit test is its own program, so this counts the failures of one test
+inline int failures = 0;
+
+inline void check(const char* name, bool passed) {
+    std::cout << "  " << name << ": [" << (passed ? "PASS" : "FAIL") << "]\n";
+    if (!passed) ++failures;
+}
+
+// Exact value of a raw integer
+template<typename FP>
+long double value(FP x) {
+    return std::ldexp(static_cast<long double>(x.raw()), -FP::fractional_bits);
+}
+
+// A reference value saturated to FP's range, as the functions under test are
+template<typename FP>
+long double clamp_to(long double v) {
+    return std::clamp(v, value(FP::min()), value(FP::max()));
+}
+
+#endif // FIXP_TEST_SUPPORT_HPP
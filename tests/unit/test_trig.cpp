@@ -0,0 +1,105 @@
+#include <fixp/math.hpp>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+// Table lookups are usable in constant expressions
+static_assert(sin<Accuracy::Fast>(Q15_16(0.0)) == Q15_16(0.0));
+static_assert(cos<Accuracy::Precise>(Q15_16(0.0)) == Q15_16(1.0));
+
+// Largest |error| against libm over random angles in [lo, hi]
+template<Accuracy A, int TableSize, typename FP>
+double max_lut_error(double lo, double hi) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    double worst = 0.0;
+    for (int i = 0; i < 20000; ++i) {
+        FP angle(dist(gen));
+        double x = static_cast<double>(angle);
+        auto sc = sincos<A, TableSize>(angle);
+        worst = std::max(worst, std::abs(static_cast<double>(sc.sin) - std::sin(x)));
+        worst = std::max(worst, std::abs(static_cast<double>(sc.cos) - std::cos(x)));
+        bool consistent = sc.sin == sin<A, TableSize>(angle) && sc.cos == cos<A, TableSize>(angle);
+        if (!consistent) return 1.0;
+    }
+    return worst;
+}
+
+template<typename FP>
+void test_format(const char* name, double range) {
+    std::cout << name << ":\n";
+    // Interpolation bound plus phase, table and output rounding
+    const double lsb = std::ldexp(1.0, -FP::fractional_bits) + 2e-9;
+    check("fast 256", max_lut_error<Accuracy::Fast, 256, FP>(-range, range) <= 7.6e-5 + lsb);
+    check("fast 1024", max_lut_error<Accuracy::Fast, 1024, FP>(-range, range) <= 4.8e-6 + lsb);
+    check("fast 4096", max_lut_error<Accuracy::Fast, 4096, FP>(-range, range) <= 3.0e-7 + lsb);
+    check("precise 256", max_lut_error<Accuracy::Precise, 256, FP>(-range, range) <= 9.5e-7 + lsb);
+    check("precise 1024",
+          max_lut_error<Accuracy::Precise, 1024, FP>(-range, range) <= 1.6e-8 + lsb);
+    check("precise 4096",
+          max_lut_error<Accuracy::Precise, 4096, FP>(-range, range) <= 2.3e-10 + lsb);
+}
+
+void test_cordic_sincos() {
+    std::cout << "CORDIC sincos (Q15.16):\n";
+    double worst = 0.0;
+    bool consistent = true;
+    // Far outside [-π, π]: reduction is one multiply, so accuracy must hold
+    for (double x = -30000.0; x <= 30000.0; x += 1.37) {
+        Q15_16 angle(x);
+        auto sc = sincos(angle);
+        double a = static_cast<double>(angle);
+        worst = std::max(worst, std::abs(static_cast<double>(sc.sin) - std::sin(a)));
+        worst = std::max(worst, std::abs(static_cast<double>(sc.cos) - std::cos(a)));
+        consistent = consistent && sc.sin == sin(angle) && sc.cos == cos(angle);
+    }
+    check("full circle accuracy", worst < 1e-3);
+    check("sin/cos agree with sincos", consistent);
+}
+
+void test_binary_angle() {
+    std::cout << "BinaryAngle:\n";
+    // One raw unit is 2^-32 turns, so accumulation wraps without reduction
+    BinaryAngle phase = BinaryAngle(0.75) + BinaryAngle(0.5);
+    check("wraps modulo one turn", phase.raw() == (uint32_t(1) << 30));
+
+    static_assert(sin<Q15_16>(BinaryAngle(0.25)) == Q15_16(1.0));
+    Q15_16 radians(-2.5);
+    double turns = static_cast<double>(radians) / (2.0 * M_PI) + 1.0;
+    check("from radians", std::abs(static_cast<double>(to_binary_angle(radians)) - turns) < 1e-9);
+
+    double worst = 0.0;
+    bool consistent = true;
+    BinaryAngle step = BinaryAngle::from_raw(0x01234567);
+    BinaryAngle acc = BinaryAngle::from_raw(0);
+    for (int i = 0; i < 5000; ++i) {
+        acc = acc + step;
+        double x = static_cast<double>(acc.raw()) * (2.0 * M_PI / 4294967296.0);
+        auto sc = sincos<FixedPoint<32, 30>>(acc);
+        worst = std::max(worst, std::abs(static_cast<double>(sc.sin) - std::sin(x)));
+        worst = std::max(worst, std::abs(static_cast<double>(sc.cos) - std::cos(x)));
+        consistent = consistent && sc.sin == sin<FixedPoint<32, 30>>(acc) &&
+                     sc.cos == cos<FixedPoint<32, 30>>(acc);
+    }
+    check("precise accuracy", worst <= 1.6e-8 + 2e-9);
+    check("sin/cos agree with sincos", consistent);
+}
+
+int main() {
+    std::cout << "Testing Table-Driven Trigonometry\n";
+    std::cout << "=================================\n\n";
+
+    test_format<Q15_16>("Q15.16", 1000.0);
+    test_format<FixedPoint<32, 28>>("Q3.28", 7.5);
+    test_format<FixedPoint<32, 31>>("Q0.31", 0.99);
+    test_format<FixedPoint<16, 8>>("Q7.8", 100.0);
+    test_format<FixedPoint<64, 40>>("Q23.40", 1e5);
+    test_cordic_sincos();
+    test_binary_angle();
+
+    std::cout << "\n" << (failures == 0 ? "All trig tests passed!" : "Trig tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,418 @@
+#include <fixp/fixed_point.hpp>
+#include <array>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+
+using Q31_32 = FixedPoint<64, 32>;
+using Q31_32S = FixedPoint<64, 32, true, OverflowPolicy::Saturate>;
+using Q31_32T = FixedPoint<64, 32, true, OverflowPolicy::Trap>;
+using Q3_60 = FixedPoint<64, 60>;
+using Q63_0 = FixedPoint<64, 0>;
+using Q47_16 = FixedPoint<48, 16>;
+using UQ32_32 = FixedPoint<64, 32, false>;
+using UQ32_32S = FixedPoint<64, 32, false, OverflowPolicy::Saturate>;
+using UQ0_64 = FixedPoint<64, 64, false>;
+using Q63_64 = FixedPoint<128, 64>;
+using Q63_64S = FixedPoint<128, 64, true, OverflowPolicy::Saturate>;
+using Q95_32 = FixedPoint<128, 32>;
+using Q63_32 = FixedPoint<96, 32>;
+using UQ48_48S = FixedPoint<96, 48, false, OverflowPolicy::Saturate>;
+using UQ64_64 = FixedPoint<128, 64, false>;
+using UQ0_128S = FixedPoint<128, 128, false, OverflowPolicy::Saturate>;
+
+// Constant evaluation takes the portable paths
+static_assert(Q31_32(1.5) * Q31_32(-2.25) == Q31_32(-3.375));
+static_assert(Q31_32(-1.0) / Q31_32(3.0) == Q31_32::from_raw(-0x55555555));
+static_assert(Q31_32S::max() * Q31_32S::from_raw(int64_t(2) << 32) == Q31_32S::max());
+static_assert(UQ0_64::from_raw(uint64_t(1) << 63) * UQ0_64::from_raw(uint64_t(1) << 63) ==
+              UQ0_64::from_raw(uint64_t(1) << 62));
+static_assert(Q63_64::from_raw(__int128_t(3) << 63) * Q63_64::from_raw(-(__int128_t(9) << 62)) ==
+              Q63_64::from_raw(-(__int128_t(27) << 61)));
+static_assert(Q63_64::from_raw(__int128_t(1) << 100) / Q63_64::from_raw(__int128_t(1) << 70) ==
+              Q63_64::from_raw(__int128_t(1) << 94));
+
+static int trap_count = 0;
+
+static void count_trap(const char*) { ++trap_count; }
+
+// Random raw values with a uniformly distributed bit width, plus the extremes
+template<typename FP>
+std::vector<FP> samples(int count, uint64_t seed) {
+    using raw_type = typename FP::raw_type;
+    using U = detail::unsigned_raw_t<raw_type>;
+    constexpr int W = 8 * sizeof(raw_type);
+    std::mt19937_64 gen(seed);
+    std::vector<FP> out{FP::from_raw(0), FP::from_raw(1), FP::max(), FP::min(),
+                        FP::from_raw(static_cast<raw_type>(FP::max().raw() - 1))};
+    if constexpr (FP::is_signed) {
+        out.push_back(FP::from_raw(-1));
+        out.push_back(FP::from_raw(static_cast<raw_type>(FP::min().raw() + 1)));
+    }
+    const int magnitude_bits = W - (FP::is_signed ? 1 : 0);
+    for (int i = 0; i < count; ++i) {
+        const int bits = static_cast<int>(gen() % static_cast<uint64_t>(magnitude_bits)) + 1;
+        U raw = gen();
+        if constexpr (W > 64) raw = (raw << 64) | gen();
+        if (bits < W) raw &= (U(1) << bits) - 1;
+        auto r = static_cast<raw_type>(raw);
+        if (FP::is_signed && gen() % 2 == 0) r = static_cast<raw_type>(U(0) - raw);
+        out.push_back(FP::from_raw(r));
+    }
+    return out;
+}
+
+//
+// 64-bit formats against the __int128 arithmetic they replace
+//
+
+template<typename FP>
+typename FP::raw_type reference_mul(FP a, FP b) {
+    using wide = std::conditional_t<FP::is_signed, __int128_t, __uint128_t>;
+    wide p = static_cast<wide>(static_cast<wide>(a.raw()) * static_cast<wide>(b.raw()));
+    if constexpr (FP::fractional_bits > 0) {
+        p = (p + (wide(1) << (FP::fractional_bits - 1))) >> FP::fractional_bits;
+    }
+    // The one-word narrowing is unchanged and serves as the reference
+    constexpr OverflowPolicy P = FP::overflow_policy == OverflowPolicy::Saturate
+                                     ? OverflowPolicy::Saturate
+                                     : OverflowPolicy::Wrap;
+    return overflow_cast<typename FP::raw_type, P>(p);
+}
+
+template<typename FP>
+bool reference_mul_overflows(FP a, FP b) {
+    using wide = std::conditional_t<FP::is_signed, __int128_t, __uint128_t>;
+    wide p = static_cast<wide>(static_cast<wide>(a.raw()) * static_cast<wide>(b.raw()));
+    if constexpr (FP::fractional_bits > 0) {
+        p = (p + (wide(1) << (FP::fractional_bits - 1))) >> FP::fractional_bits;
+    }
+    return static_cast<wide>(static_cast<typename FP::raw_type>(p)) != p;
+}
+
+template<typename FP>
+typename FP::raw_type reference_div(FP a, FP b) {
+    using wide = std::conditional_t<FP::is_signed, __int128_t, __uint128_t>;
+    const wide dividend = static_cast<wide>(a.raw()) << FP::fractional_bits;
+    constexpr OverflowPolicy P = FP::overflow_policy == OverflowPolicy::Saturate
+                                     ? OverflowPolicy::Saturate
+                                     : OverflowPolicy::Wrap;
+    return overflow_cast<typename FP::raw_type, P>(static_cast<wide>(dividend / b.raw()));
+}
+
+template<typename FP>
+bool reference_div_overflows(FP a, FP b) {
+    using wide = std::conditional_t<FP::is_signed, __int128_t, __uint128_t>;
+    const wide q = static_cast<wide>((static_cast<wide>(a.raw()) << FP::fractional_bits) / b.raw());
+    return static_cast<wide>(static_cast<typename FP::raw_type>(q)) != q;
+}
+
+template<typename FP>
+void test_word_format(const char* name) {
+    std::cout << name << ":\n";
+    const auto xs = samples<FP>(700, 1);
+    const auto ys = samples<FP>(150, 2);
+    bool products = true;
+    bool quotients = true;
+    int overflows = 0;
+    trap_count = 0;
+    for (const FP a : xs) {
+        for (const FP b : ys) {
+            products = products && (a * b).raw() == reference_mul(a, b);
+            overflows += reference_mul_overflows(a, b) ? 1 : 0;
+            if (b.raw() != 0) {
+                quotients = quotients && (a / b).raw() == reference_div(a, b);
+                overflows += reference_div_overflows(a, b) ? 1 : 0;
+            }
+        }
+    }
+    check("products match the 128-bit reference", products);
+    check("quotients match the 128-bit reference", quotients);
+    check("overflow is reported exactly when the result does not fit",
+          FP::overflow_policy != OverflowPolicy::Trap || trap_count == overflows);
+}
+
+//
+// 128-bit formats against a bit-serial 256-bit reference
+//
+
+using Int256 = std::array<uint64_t, 4>; // two's complement, least significant limb first
+
+static Int256 extend(__int128_t v, bool is_signed) {
+    const auto u = static_cast<__uint128_t>(v);
+    const uint64_t fill = is_signed && v < 0 ? ~uint64_t(0) : 0;
+    return {static_cast<uint64_t>(u), static_cast<uint64_t>(u >> 64), fill, fill};
+}
+
+static Int256 add(const Int256& a, const Int256& b) {
+    Int256 r{};
+    uint64_t carry = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        const uint64_t s = a[i] + carry;
+        const uint64_t c1 = s < carry ? 1 : 0;
+        r[i] = s + b[i];
+        carry = c1 + (r[i] < b[i] ? 1 : 0);
+    }
+    return r;
+}
+
+static Int256 negate(const Int256& a) {
+    Int256 r{};
+    for (size_t i = 0; i < 4; ++i) r[i] = ~a[i];
+    return add(r, Int256{1, 0, 0, 0});
+}
+
+static Int256 shift_left(const Int256& a, int s) {
+    Int256 r = a;
+    for (int k = 0; k < s; ++k) {
+        for (size_t i = 3; i > 0; --i) r[i] = (r[i] << 1) | (r[i - 1] >> 63);
+        r[0] <<= 1;
+    }
+    return r;
+}
+
+static Int256 shift_right(const Int256& a, int s, bool arithmetic) {
+    Int256 r = a;
+    for (int k = 0; k < s; ++k) {
+        const uint64_t top = arithmetic ? r[3] & (uint64_t(1) << 63) : 0;
+        for (size_t i = 0; i < 3; ++i) r[i] = (r[i] >> 1) | (r[i + 1] << 63);
+        r[3] = (r[3] >> 1) | top;
+    }
+    return r;
+}
+
+static bool less(const Int256& a, const Int256& b) {
+    for (size_t i = 4; i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i];
+    }
+    return false;
+}
+
+// a * b modulo 2^256, which is exact for two sign-extended 128-bit values
+static Int256 multiply(const Int256& a, const Int256& b) {
+    Int256 r{};
+    for (int bit = 0; bit < 256; ++bit) {
+        if ((b[static_cast<size_t>(bit / 64)] >> (bit % 64)) & 1) r = add(r, shift_left(a, bit));
+    }
+    return r;
+}
+
+// Restoring long division of unsigned values, d != 0
+static Int256 divide(const Int256& n, const Int256& d) {
+    Int256 q{}, r{};
+    const Int256 neg_d = negate(d);
+    for (int bit = 255; bit >= 0; --bit) {
+        r = shift_left(r, 1);
+        r[0] |= (n[static_cast<size_t>(bit / 64)] >> (bit % 64)) & 1;
+        if (!less(r, d)) {
+            r = add(r, neg_d);
+            q[static_cast<size_t>(bit / 64)] |= uint64_t(1) << (bit % 64);
+        }
+    }
+    return q;
+}
+
+static __int128_t low_word(const Int256& v) {
+    return static_cast<__int128_t>((static_cast<__uint128_t>(v[1]) << 64) | v[0]);
+}
+
+template<typename FP>
+typename FP::raw_type reference_wide_mul(FP a, FP b) {
+    constexpr int F = FP::fractional_bits;
+    Int256 p = multiply(extend(static_cast<__int128_t>(a.raw()), FP::is_signed),
+                        extend(static_cast<__int128_t>(b.raw()), FP::is_signed));
+    if constexpr (F > 0) {
+        p = shift_right(add(p, shift_left(Int256{1, 0, 0, 0}, F - 1)), F, FP::is_signed);
+    }
+    const auto r = static_cast<typename FP::raw_type>(low_word(p));
+    const Int256 back = extend(static_cast<__int128_t>(r), FP::is_signed);
+    if (FP::overflow_policy != OverflowPolicy::Saturate || back == p) return r;
+    return FP::is_signed && (p[3] >> 63) != 0 ? FP::min().raw() : FP::max().raw();
+}
+
+template<typename FP>
+typename FP::raw_type reference_wide_div(FP a, FP b) {
+    const bool negative = FP::is_signed && ((a.raw() < 0) != (b.raw() < 0));
+    Int256 n = extend(static_cast<__int128_t>(a.raw()), FP::is_signed);
+    Int256 d = extend(static_cast<__int128_t>(b.raw()), FP::is_signed);
+    if (FP::is_signed && a.raw() < 0) n = negate(n);
+    if (FP::is_signed && b.raw() < 0) d = negate(d);
+    Int256 q = divide(shift_left(n, FP::fractional_bits), d);
+    if (negative) q = negate(q);
+    const auto r = static_cast<typename FP::raw_type>(low_word(q));
+    const Int256 back = extend(static_cast<__int128_t>(r), FP::is_signed);
+    if (FP::overflow_policy != OverflowPolicy::Saturate || back == q) return r;
+    return negative ? FP::min().raw() : FP::max().raw();
+}
+
+template<typename FP>
+void test_wide_format(const char* name) {
+    std::cout << name << ":\n";
+    const auto xs = samples<FP>(120, 3);
+    const auto ys = samples<FP>(40, 4);
+    bool products = true;
+    bool quotients = true;
+    for (const FP a : xs) {
+        for (const FP b : ys) {
+            products = products && (a * b).raw() == reference_wide_mul(a, b);
+            if (b.raw() != 0) quotients = quotients && (a / b).raw() == reference_wide_div(a, b);
+        }
+    }
+    check("products match the 256-bit reference", products);
+    check("quotients match the 256-bit reference", quotients);
+}
+
+//
+// The two-limb 128-bit type against __int128, which it replaces without one
+//
+
+void test_wide_int() {
+    std::cout << "Two-limb 128-bit integers:\n";
+    using S = detail::WideInt<true>;
+    using U = detail::WideInt<false>;
+    static_assert(sizeof(S) == 16 && std::is_trivially_copyable_v<S>);
+    static_assert((U(1) << 100) / (U(1) << 70) == U(1) << 30);
+    static_assert(S(-7) / S(2) == S(-3) && S(-7) % S(2) == S(-1) && (S(-8) >> 2) == S(-2));
+    static_assert(std::numeric_limits<S>::min() == S::from_limbs(uint64_t(1) << 63, 0));
+    std::mt19937_64 gen(6);
+    bool arithmetic = true, division = true, shifts = true, order = true, floats = true;
+    for (int i = 0; i < 200000; ++i) {
+        const auto a = ((static_cast<__uint128_t>(gen()) << 64) | gen()) >> (gen() % 128);
+        auto b = ((static_cast<__uint128_t>(gen()) << 64) | gen()) >> (gen() % 128);
+        if (i % 8 == 0) b = gen() % 5;
+        const auto sa = static_cast<__int128_t>(a), sb = static_cast<__int128_t>(b);
+        const U ua = a, ub = b;
+        const S wa = sa, wb = sb;
+        const int s = static_cast<int>(gen() % 128);
+        arithmetic = arithmetic && static_cast<__uint128_t>(ua + ub) == a + b &&
+                     static_cast<__uint128_t>(ua - ub) == a - b &&
+                     static_cast<__uint128_t>(ua * ub) == a * b &&
+                     static_cast<__int128_t>(-wa) == static_cast<__int128_t>(0 - a);
+        if (b != 0) {
+            division = division && static_cast<__uint128_t>(ua / ub) == a / b &&
+                       static_cast<__uint128_t>(ua % ub) == a % b;
+            if (sb != -1) {
+                division = division && static_cast<__int128_t>(wa / wb) == sa / sb &&
+                           static_cast<__int128_t>(wa % wb) == sa % sb;
+            }
+        }
+        shifts = shifts && static_cast<__uint128_t>(ua << s) == a << s &&
+                 static_cast<__uint128_t>(ua >> s) == a >> s &&
+                 static_cast<__int128_t>(wa >> s) == sa >> s;
+        order = order && (ua < ub) == (a < b) && (wa < wb) == (sa < sb) && (wa == wb) == (a == b);
+        const auto d = static_cast<double>(sa);
+        floats = floats && static_cast<double>(wa) == d && static_cast<double>(ua) == double(a) &&
+                 static_cast<float>(wa) == static_cast<float>(sa) &&
+                 static_cast<long double>(wa) == static_cast<long double>(sa) &&
+                 static_cast<__int128_t>(S(d)) == static_cast<__int128_t>(d);
+    }
+    check("sums, differences, products and negation wrap as __int128", arithmetic);
+    check("quotients and remainders truncate as __int128", division);
+    check("shifts, arithmetic for the signed form", shifts);
+    check("comparisons", order);
+    check("conversions to and from floating point round as __int128", floats);
+}
+
+//
+// The portable word kernels, which x86-64 builds otherwise never reach
+//
+
+void test_portable_kernels() {
+    std::cout << "Portable kernels:\n";
+    std::mt19937_64 gen(5);
+    const std::vector<uint64_t> edges{0, 1, 2, 3, 0xFFFFFFFF, 0x100000000, 0x8000000000000000,
+                                      0x7FFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF};
+    std::vector<uint64_t> values = edges;
+    for (int i = 0; i < 4000; ++i) values.push_back(gen() >> (gen() % 64));
+
+    bool products = true;
+    bool signed_products = true;
+    for (size_t i = 0; i + 1 < values.size(); ++i) {
+        const uint64_t a = values[i], b = values[values.size() - 1 - i];
+        const __uint128_t p = static_cast<__uint128_t>(a) * b;
+        const auto halves = detail::mul_halves(a, b);
+        products = products && halves.hi == static_cast<uint64_t>(p >> 64) &&
+                   halves.lo == static_cast<uint64_t>(p);
+        // The signed correction on top of the portable 128-bit product
+        const auto sp = static_cast<__uint128_t>(
+            static_cast<__int128_t>(static_cast<int64_t>(a)) * static_cast<int64_t>(b));
+        const __uint128_t sign_a = (a >> 63) != 0 ? ~__uint128_t(0) << 64 : 0;
+        const __uint128_t sign_b = (b >> 63) != 0 ? ~__uint128_t(0) << 64 : 0;
+        const auto wide = detail::mul_wide_signed(sign_a | a, sign_b | b);
+        signed_products = signed_products && static_cast<__uint128_t>(wide.lo) == sp &&
+                          wide.hi == ((sp >> 127) != 0 ? ~__uint128_t(0) : 0);
+    }
+    check("mul_halves matches the 128-bit product", products);
+    check("mul_wide_signed matches the signed product", signed_products);
+
+    bool quotients = true;
+    for (const uint64_t d : values) {
+        if (d == 0) continue;
+        for (int k = 0; k < 8; ++k) {
+            const uint64_t hi = gen() % d, lo = k < 2 ? ~uint64_t(0) * uint64_t(k) : gen();
+            const __uint128_t n = (static_cast<__uint128_t>(hi) << 64) | lo;
+            const auto want = static_cast<uint64_t>(n / d);
+            quotients = quotients && detail::div_halves(hi, lo, d) == want &&
+                        detail::div_wide(hi, lo, d) == want;
+        }
+    }
+    check("div_halves matches the 128-bit quotient", quotients);
+    check("div_wide drops the quotient's high word",
+          detail::div_wide(uint64_t(7), uint64_t(5), uint64_t(3)) ==
+              static_cast<uint64_t>(((__uint128_t(7) << 64) | 5) / 3));
+}
+
+void test_special_values() {
+    std::cout << "Special values:\n";
+    check("division by zero saturates by the dividend sign",
+          Q31_32(2.0) / Q31_32(0.0) == Q31_32::max() &&
+              Q31_32(-2.0) / Q31_32(0.0) == Q31_32::min() &&
+              Q63_64::from_raw(-1) / Q63_64::from_raw(0) == Q63_64::min());
+    check("the most negative value divided by -1 wraps",
+          Q63_0::min() / Q63_0(-1.0) == Q63_0::min());
+    check("saturating products clamp by sign",
+          Q31_32S::min() * Q31_32S::from_raw(int64_t(3) << 32) == Q31_32S::min() &&
+              Q31_32S::min() * Q31_32S::from_raw(-(int64_t(3) << 32)) == Q31_32S::max() &&
+              Q63_64S::max() * Q63_64S::min() == Q63_64S::min() &&
+              UQ0_128S::max() * UQ0_128S::max() == UQ0_128S::from_raw(~__uint128_t(0) - 1));
+    check("products and quotients near the top of the range are exact",
+          Q31_32(40000.5) * Q31_32(50000.25) == Q31_32(2000035000.125) &&
+              Q31_32(2000035000.125) / Q31_32(40000.5) == Q31_32(50000.25));
+}
+
+int main() {
+    std::cout << "Testing Wide Fixed-Point Arithmetic\n";
+    std::cout << "===================================\n\n";
+
+    set_overflow_handler(count_trap);
+    test_word_format<Q31_32>("Q31.32");
+    test_word_format<Q31_32S>("Q31.32 saturating");
+    test_word_format<Q31_32T>("Q31.32 trapping");
+    test_word_format<Q3_60>("Q3.60");
+    test_word_format<Q63_0>("Q63.0");
+    test_word_format<Q47_16>("Q47.16");
+    test_word_format<UQ32_32>("UQ32.32");
+    test_word_format<UQ32_32S>("UQ32.32 saturating");
+    test_word_format<UQ0_64>("UQ0.64");
+    set_overflow_handler(nullptr);
+
+    test_wide_format<Q63_64>("Q63.64");
+    test_wide_format<Q63_64S>("Q63.64 saturating");
+    test_wide_format<Q95_32>("Q95.32");
+    test_wide_format<Q63_32>("Q63.32 in 96 bits");
+    test_wide_format<UQ48_48S>("UQ48.48 saturating in 96 bits");
+    test_wide_format<UQ64_64>("UQ64.64");
+    test_wide_format<UQ0_128S>("UQ0.128 saturating");
+
+    test_wide_int();
+    test_portable_kernels();
+    test_special_values();
+
+    std::cout << "\n" << (failures == 0 ? "All wide arithmetic tests passed!"
+                                        : "Wide arithmetic tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
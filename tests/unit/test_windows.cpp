@@ -0,0 +1,103 @@
+#include <fixp/dsp.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <vector>
+#include "test_support.hpp"
+
+using namespace fixp;
+using namespace fixp::dsp;
+
+static double exact(Window w, size_t n, size_t size) {
+    if (size == 1) return 1.0;
+    const double a = 2.0 * std::numbers::pi * static_cast<double>(n) / static_cast<double>(size - 1);
+    switch (w) {
+        case Window::Hann:    return 0.5 - 0.5 * std::cos(a);
+        case Window::Hamming: return 0.54 - 0.46 * std::cos(a);
+        default:              return 0.42 - 0.5 * std::cos(a) + 0.08 * std::cos(2.0 * a);
+    }
+}
+
+// Every sample within half an LSB (plus slack for the series) of the clamped exact window
+template<Window W, typename FP, size_t N>
+bool matches_exact() {
+    const auto& t = window_table<W, FP, N>;
+    const double lsb = std::ldexp(1.0, -FP::fractional_bits);
+    for (size_t n = 0; n < N; ++n) {
+        double e = exact(W, n, N);
+        e = std::min(e, static_cast<double>(FP::max()));
+        if (std::abs(static_cast<double>(t[n]) - e) > 0.5 * lsb + 1e-12) return false;
+    }
+    return true;
+}
+
+template<Window W, typename FP, size_t N>
+bool symmetric() {
+    const auto& t = window_table<W, FP, N>;
+    for (size_t n = 0; n < N; ++n) {
+        if (t[n].raw() != t[N - 1 - n].raw()) return false;
+    }
+    return true;
+}
+
+// Generated in a constant expression
+using Q31 = FixedPoint<32, 31>;
+using Q15 = FixedPoint<16, 15>;
+using Q16 = FixedPoint<32, 16>;
+static_assert(window_table<Window::Hann, Q15, 9>[0].raw() == 0);
+static_assert(window_table<Window::Hann, Q15, 9>[4] == Q15::max());
+static_assert(window_table<Window::Hann, Q16, 9>[4] == Q16(1.0));
+static_assert(window_table<Window::Hamming, Q16, 5>[0] == Q16(0.08));
+static_assert(hann_window<Q16, 64>()[32].raw() == window_table<Window::Hann, Q16, 64>[32].raw());
+
+template<typename FP>
+bool apply_matches_scalar(std::mt19937& gen) {
+    constexpr size_t N = 203;
+    std::uniform_real_distribution<double> dist(-0.99, 0.99);
+    std::array<FP, N> frame;
+    for (auto& v : frame) v = FP(dist(gen));
+    const auto& w = window_table<Window::Blackman, FP, N>;
+
+    std::array<FP, N> expected;
+    for (size_t i = 0; i < N; ++i) expected[i] = frame[i] * w[i];
+
+    std::array<FP, N> out{};
+    apply_window<FP>(frame, w, out);
+    bool ok = out == expected;
+    apply_window<Window::Blackman>(frame);
+    return ok && frame == expected;
+}
+
+int main() {
+    std::cout << "=== Window Function Tests ===\n\n";
+    std::mt19937 gen(99);
+
+    std::cout << "Against the exact window:\n";
+    check("Hann Q0.31, N=1024", matches_exact<Window::Hann, Q31, 1024>());
+    check("Hamming Q0.31, N=1024", matches_exact<Window::Hamming, Q31, 1024>());
+    check("Blackman Q0.31, N=1024", matches_exact<Window::Blackman, Q31, 1024>());
+    check("Hann Q0.15, N=257", matches_exact<Window::Hann, Q15, 257>());
+    check("Blackman Q15.16, N=100", matches_exact<Window::Blackman, Q16, 100>());
+    check("one-point window", matches_exact<Window::Hann, Q16, 1>());
+
+    std::cout << "\nShape:\n";
+    check("Hann symmetric, even N", symmetric<Window::Hann, Q31, 512>());
+    check("Blackman symmetric, odd N", symmetric<Window::Blackman, Q15, 63>());
+    check("Blackman ends at zero", window_table<Window::Blackman, Q31, 128>[0].raw() == 0);
+
+    std::cout << "\napply_window:\n";
+    check("Q0.31 matches scalar multiply", apply_matches_scalar<Q31>(gen));
+    check("Q0.15 matches scalar multiply", apply_matches_scalar<Q15>(gen));
+    check("Q15.16 matches scalar multiply", apply_matches_scalar<Q16>(gen));
+
+    std::cout << "\n=== Summary ===\n";
+    if (failures == 0) {
+        std::cout << "All tests passed!\n";
+        return 0;
+    }
+    std::cout << failures << " test(s) failed\n";
+    return 1;
+}